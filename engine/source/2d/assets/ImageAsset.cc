@@ -1018,8 +1018,8 @@ void ImageAsset::calculateImage( void )
     if ( !mImageTextureHandle.IsNull() && dStricmp(mImageTextureHandle.getTextureKey(), mImageFile) == 0 )
         TextureManager::refresh( mImageFile );
 
-    // Get image texture.
-    mImageTextureHandle.set( mImageFile, TextureHandle::BitmapTexture, true, getForce16Bit() );
+    // Get image texture.  The pixels may arrive later but the dimensions are known now.
+    mImageTextureHandle.setAsync( mImageFile, TextureHandle::BitmapTexture, true, getForce16Bit() );
 
     // Is the texture valid?
     if ( mImageTextureHandle.IsNull() )
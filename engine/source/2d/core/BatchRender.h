@@ -39,8 +39,8 @@
 #include "graphics/TextureManager.h"
 #endif
 
-#ifndef _HASHTABLE_H
-#include "collection/hashTable.h"
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
 #endif
 
 #ifndef _COLOR_H_
@@ -214,7 +214,7 @@ private:
 
 private:
     typedef Vector<U32> indexVectorType;
-    typedef HashMap<U32, indexVectorType*> textureBatchType;
+    typedef FlatHashMap<U32, indexVectorType*> textureBatchType;
 
     VectorPtr< indexVectorType* > mIndexVectorPool;
     textureBatchType    mTextureBatchMap;
@@ -31,6 +31,10 @@
 #include "2d/scene/SceneRenderObject.h"
 #endif
 
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
 //------------------------------------------------------------------------------  
 
 class SpriteBatchQuery;
@@ -43,9 +47,9 @@ public:
     static const S32                INVALID_SPRITE_PROXY = -1;  
 
 protected:
-    typedef HashMap< U32, SpriteBatchItem* > typeSpriteBatchHash;
-    typedef HashMap< SpriteBatchItem::LogicalPosition, SpriteBatchItem* > typeSpritePositionHash;
-    typedef HashMap< StringTableEntry, SpriteBatchItem* > typeSpriteNameHash;
+    typedef FlatHashMap< U32, SpriteBatchItem* > typeSpriteBatchHash;
+    typedef FlatHashMap< SpriteBatchItem::LogicalPosition, SpriteBatchItem* > typeSpritePositionHash;
+    typedef FlatHashMap< StringTableEntry, SpriteBatchItem* > typeSpriteNameHash;
 
     typeSpriteBatchHash             mSprites;
     typeSpritePositionHash          mSpritePositions;
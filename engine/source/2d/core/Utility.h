@@ -47,6 +47,7 @@
 #define MASK_BITCOUNT                   (32)
 #define DEBUG_MODE_COUNT                (8)
 #define MAX_LAYERS_SUPPORTED            (32)
+#define MAX_GROUPS_SUPPORTED            (32)
 #define CANNOT_RENDER_PROXY_NAME        "CannotRenderProxy"
 #define b2_pi2                          (b2_pi * 2.0f)
 
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "2d/scene/PhysicsWorkerPool.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/atomic.h"
+#include "math/mMathFn.h"
+
+//-----------------------------------------------------------------------------
+
+class PhysicsWorkerThread : public Thread
+{
+public:
+    PhysicsWorkerThread( PhysicsWorkerPool* pPool, const U32 threadIndex ) : Thread( 0, 0, false ), mpPool( pPool ), mThreadIndex( threadIndex ) {}
+
+    virtual void run( void* arg = 0 )
+    {
+        while( !checkForStop() )
+        {
+            // Wait for work.
+            mpPool->mStartSignal.acquire();
+
+            if ( checkForStop() )
+                break;
+
+            mpPool->executeChunks( mThreadIndex );
+            mpPool->mDoneSignal.release();
+        }
+    }
+
+private:
+    PhysicsWorkerPool* mpPool;
+    U32 mThreadIndex;
+};
+
+//-----------------------------------------------------------------------------
+
+PhysicsWorkerPool::PhysicsWorkerPool( const U32 threadCount ) :
+    mStartSignal( 0 ),
+    mDoneSignal( 0 ),
+    mpTask( NULL ),
+    mTaskCount( 0 ),
+    mGrainSize( 1 ),
+    mNextIndex( 0 )
+{
+    // The calling thread is thread zero so only spawn the rest.
+    for( U32 index = 1; index < threadCount; ++index )
+    {
+        PhysicsWorkerThread* pWorker = new PhysicsWorkerThread( this, index );
+        mWorkers.push_back( pWorker );
+        pWorker->start();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+PhysicsWorkerPool::~PhysicsWorkerPool()
+{
+    // Ask the workers to stop and wake them all.
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mWorkers[index]->stop();
+
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mStartSignal.release();
+
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        mWorkers[index]->join();
+        delete mWorkers[index];
+    }
+    mWorkers.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void PhysicsWorkerPool::ParallelFor( b2Task* task, int32 count, int32 grainSize )
+{
+    // Finish if nothing to do.
+    if ( count <= 0 )
+        return;
+
+    const U32 grain = (U32)getMax( grainSize, 1 );
+
+    // Run inline if there are no workers or only a single chunk.
+    if ( mWorkers.size() == 0 || (U32)count <= grain )
+    {
+        task->Execute( 0, count, 0 );
+        return;
+    }
+
+    // Publish the task.
+    mpTask = task;
+    mTaskCount = (U32)count;
+    mGrainSize = grain;
+    dAtomicWrite( mNextIndex, 0 );
+    dMemoryBarrier();
+
+    // Wake the workers and help out.
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mStartSignal.release();
+
+    executeChunks( 0 );
+
+    // Wait for the workers to drain the range.
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mDoneSignal.acquire();
+
+    mpTask = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void PhysicsWorkerPool::executeChunks( const U32 threadIndex )
+{
+    while( true )
+    {
+        // Claim the next chunk.
+        const U32 begin = dFetchAndAdd( mNextIndex, mGrainSize );
+        if ( begin >= mTaskCount )
+            break;
+
+        const U32 end = getMin( begin + mGrainSize, mTaskCount );
+        mpTask->Execute( (int32)begin, (int32)end, (int32)threadIndex );
+    }
+}
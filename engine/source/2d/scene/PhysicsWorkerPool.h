@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _PHYSICS_WORKER_POOL_H_
+#define _PHYSICS_WORKER_POOL_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef BOX2D_H
+#include "box2d/Box2D.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class PhysicsWorkerThread;
+
+//-----------------------------------------------------------------------------
+
+/// Runs Box2D tasks over a fixed set of worker threads.
+/// The thread that calls "ParallelFor" participates as thread index zero and
+/// blocks until the whole range has been executed.
+class PhysicsWorkerPool : public b2TaskExecutor
+{
+    friend class PhysicsWorkerThread;
+
+public:
+    PhysicsWorkerPool( const U32 threadCount );
+    virtual ~PhysicsWorkerPool();
+
+    virtual int32 GetThreadCount() const { return (int32)mWorkers.size() + 1; }
+    virtual void ParallelFor( b2Task* task, int32 count, int32 grainSize );
+
+private:
+    void executeChunks( const U32 threadIndex );
+
+private:
+    Vector<PhysicsWorkerThread*> mWorkers;
+    Semaphore                   mStartSignal;
+    Semaphore                   mDoneSignal;
+
+    b2Task*                     mpTask;
+    U32                         mTaskCount;
+    U32                         mGrainSize;
+    volatile U32                mNextIndex;
+};
+
+#endif // _PHYSICS_WORKER_POOL_H_
@@ -56,6 +56,18 @@
 #include "2d/core/particleSystem.h"
 #endif
 
+#ifndef _CONSOLE_CALLBACK_H_
+#include "console/consoleCallback.h"
+#endif
+
+#ifndef _SCENE_OBJECT_GHOST_H_
+#include "2d/sceneobject/SceneObjectGhost.h"
+#endif
+
+#ifndef _PHYSICS_WORKER_POOL_H_
+#include "2d/scene/PhysicsWorkerPool.h"
+#endif
+
 // Script bindings.
 #include "Scene_ScriptBinding.h"
 
@@ -74,6 +86,16 @@ IMPLEMENT_CONOBJECT(Scene);
 
 static ContactFilter mContactFilter;
 
+// Script callbacks.
+static ConsoleCallback sOnSceneUpdateCallback( "onSceneUpdate" );
+static ConsoleCallback sOnSceneCollisionCallback( "onSceneCollision" );
+static ConsoleCallback sOnSceneEndCollisionCallback( "onSceneEndCollision" );
+static ConsoleCallback sOnCollisionCallback( "onCollision" );
+static ConsoleCallback sOnEndCollisionCallback( "onEndCollision" );
+static ConsoleCallback sOnSceneCollisionsCallback( "onSceneCollisions" );
+static ConsoleCallback sOnAddToSceneCallback( "onAddToScene" );
+static ConsoleCallback sOnRemoveFromSceneCallback( "onRemoveFromScene" );
+
 // Scene counter.
 static U32 sSceneCount = 0;
 static U32 sSceneMasterIndex = 0;
@@ -152,6 +174,14 @@ Scene::Scene() :
     mWorldGravity(0.0f, 0.0f),
     mVelocityIterations(8),
     mPositionIterations(3),
+    mPhysicsThreadCount(0),
+    mParallelCollide(false),
+    mpPhysicsWorkerPool(NULL),
+
+    /// Scene occupancy.
+    mActiveSceneObjectsDirty(false),
+    mEnabledObjectCount(0),
+    mVisibleObjectCount(0),
 
     /// Joint access.
     mJointMasterId(1),
@@ -171,7 +201,8 @@ Scene::Scene() :
     mIsEditorScene(0),
     mUpdateCallback(false),
     mRenderCallback(false),
-    mSceneIndex(0)
+    mSceneIndex(0),
+    mBatchCollisionCallbacks(false)
 {
     // Initialize Taml property names.
     if ( !tamlPropertiesInitialized )
@@ -245,9 +276,14 @@ Scene::Scene() :
 
     // Set Vector Associations.
     VECTOR_SET_ASSOCIATION( mSceneObjects );
+    VECTOR_SET_ASSOCIATION( mTickedSceneObjects );
+    VECTOR_SET_ASSOCIATION( mActiveSceneObjects );
     VECTOR_SET_ASSOCIATION( mDeleteRequests );
     VECTOR_SET_ASSOCIATION( mDeleteRequestsTemp );
     VECTOR_SET_ASSOCIATION( mEndContacts );
+    VECTOR_SET_ASSOCIATION( mBatchedBeginContacts );
+    VECTOR_SET_ASSOCIATION( mBatchedEndContacts );
+    VECTOR_SET_ASSOCIATION( mContactListeners );
       
     // Initialize layer sort mode.
     for ( U32 n = 0; n < MAX_LAYERS_SUPPORTED; ++n )
@@ -307,6 +343,9 @@ bool Scene::onAdd()
     mpGroundBody = mpWorld->CreateBody(&groundBodyDef);
     mpGroundBody->SetAwake( false );
 
+    // Create physics workers.
+    updatePhysicsWorkers();
+
     // Create world query.
     mpWorldQuery = new WorldQuery(this);
 
@@ -343,6 +382,11 @@ void Scene::onRemove()
     mpWorld->DestroyBody( mpGroundBody );
     mpGroundBody = NULL;
 
+    // Delete physics workers.
+    mpWorld->SetTaskExecutor( NULL );
+    delete mpPhysicsWorkerPool;
+    mpPhysicsWorkerPool = NULL;
+
     // Delete physics world and world query.
     delete mpWorldQuery;
     delete mpWorld;
@@ -379,6 +423,122 @@ void Scene::onDeleteNotify( SimObject* object )
 
 //-----------------------------------------------------------------------------
 
+void Scene::setPhysicsThreadCount( const U32 threadCount )
+{
+    // Clamp to the processor count when the platform knows it; extra workers only contend.
+    const U32 processorCount = PlatformSystemInfo.processor.numLogicalProcessors;
+    const U32 clampedThreadCount = processorCount > 0 ? getMin( threadCount, processorCount ) : threadCount;
+
+    // Finish if no change.
+    if ( clampedThreadCount == mPhysicsThreadCount )
+        return;
+
+    mPhysicsThreadCount = clampedThreadCount;
+
+    // Update the workers if the world exists.
+    if ( mpWorld != NULL )
+        updatePhysicsWorkers();
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::setParallelCollide( const bool parallelCollide )
+{
+    mParallelCollide = parallelCollide;
+
+    // Update the world if it exists.
+    if ( mpWorld != NULL )
+        mpWorld->SetParallelNarrowPhase( mParallelCollide );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Scene::restorePhysicsSnapshot( const b2WorldSnapshot& snapshot )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_RestorePhysicsSnapshot);
+
+    // Restore the world.
+    if ( !mpWorld->RestoreSnapshot( snapshot ) )
+    {
+        Con::warnf( "Scene::restorePhysicsSnapshot() - The snapshot does not match the current bodies, fixtures or joints." );
+        return false;
+    }
+
+    // Contacts from the last step may no longer exist.
+    mBeginContacts.clear();
+    mEndContacts.clear();
+    mBatchedBeginContacts.clear();
+    mBatchedEndContacts.clear();
+
+    // Bring the scene objects up to date with their bodies.
+    for ( S32 index = 0; index < mSceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = mSceneObjects[index];
+
+        pSceneObject->resetTickSpatials();
+
+        // Skip if not gathering contacts.
+        if ( pSceneObject->mpCurrentContacts == NULL )
+            continue;
+
+        // Gather the restored touching contacts.
+        pSceneObject->mpCurrentContacts->clear();
+        for ( b2ContactEdge* pContactEdge = pSceneObject->getBody()->GetContactList(); pContactEdge != NULL; pContactEdge = pContactEdge->next )
+        {
+            b2Contact* pContact = pContactEdge->contact;
+            if ( !pContact->IsTouching() )
+                continue;
+
+            // Fetch fixtures.
+            b2Fixture* pFixtureA = pContact->GetFixtureA();
+            b2Fixture* pFixtureB = pContact->GetFixtureB();
+
+            // Fetch physics proxies.
+            PhysicsProxy* pPhysicsProxyA = static_cast<PhysicsProxy*>(pFixtureA->GetBody()->GetUserData());
+            PhysicsProxy* pPhysicsProxyB = static_cast<PhysicsProxy*>(pFixtureB->GetBody()->GetUserData());
+
+            // Ignore stuff that's not a scene object.
+            if (    pPhysicsProxyA->getPhysicsProxyType() != PhysicsProxy::PHYSIC_PROXY_SCENEOBJECT ||
+                    pPhysicsProxyB->getPhysicsProxyType() != PhysicsProxy::PHYSIC_PROXY_SCENEOBJECT )
+            {
+                    continue;
+            }
+
+            TickContact tickContact;
+            tickContact.initialize( pContact, static_cast<SceneObject*>(pPhysicsProxyA), static_cast<SceneObject*>(pPhysicsProxyB), pFixtureA, pFixtureB );
+            pSceneObject->mpCurrentContacts->push_back( tickContact );
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::updatePhysicsWorkers( void )
+{
+    // Sanity!
+    AssertFatal( !mpWorld->IsLocked(), "Scene::updatePhysicsWorkers() - Cannot change physics threads during a world step." );
+
+    // Release any existing workers.
+    mpWorld->SetTaskExecutor( NULL );
+    delete mpPhysicsWorkerPool;
+    mpPhysicsWorkerPool = NULL;
+
+    // Create workers if requested.  A single thread still uses the island solver
+    // so its results can be compared against more threads.
+    if ( mPhysicsThreadCount > 0 )
+    {
+        mpPhysicsWorkerPool = new PhysicsWorkerPool( mPhysicsThreadCount );
+        mpWorld->SetTaskExecutor( mpPhysicsWorkerPool );
+    }
+
+    mpWorld->SetParallelNarrowPhase( mParallelCollide );
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::initPersistFields()
 {
     // Call Parent.
@@ -388,6 +548,8 @@ void Scene::initPersistFields()
     addProtectedField("Gravity", TypeVector2, Offset(mWorldGravity, Scene), &setGravity, &getGravity, &writeGravity, "" );
     addField("VelocityIterations", TypeS32, Offset(mVelocityIterations, Scene), &writeVelocityIterations, "" );
     addField("PositionIterations", TypeS32, Offset(mPositionIterations, Scene), &writePositionIterations, "" );
+    addProtectedField("PhysicsThreads", TypeS32, Offset(mPhysicsThreadCount, Scene), &setPhysicsThreadCount, &defaultProtectedGetFn, &writePhysicsThreadCount, "The number of threads used to solve physics islands.  Zero uses the serial solver and the count is clamped to the processor count." );
+    addProtectedField("ParallelCollide", TypeBool, Offset(mParallelCollide, Scene), &setParallelCollide, &defaultProtectedGetFn, &writeParallelCollide, "Whether contact manifolds are also updated on the physics threads or not." );
 
     // Layer sort modes.
     char buffer[64];
@@ -402,6 +564,7 @@ void Scene::initPersistFields()
     // Callbacks.
     addField("UpdateCallback", TypeBool, Offset(mUpdateCallback, Scene), &writeUpdateCallback, "");
     addField("RenderCallback", TypeBool, Offset(mRenderCallback, Scene), &writeRenderCallback, "");
+    addField("BatchCollisionCallbacks", TypeBool, Offset(mBatchCollisionCallbacks, Scene), &writeBatchCollisionCallbacks, "Whether collision callbacks are delivered once per tick as a batch or not.");
 }
 
 //-----------------------------------------------------------------------------
@@ -625,11 +788,10 @@ void Scene::dispatchBeginContactCallbacks( void )
         if ( sceneObjectACallback && sceneObjectBCallback )
         {
             // Yes, so does the scene handle the collision callback?
-            Namespace* pNamespace = getNamespace();
-            if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneCollision" ) ) != NULL )
+            if ( sOnSceneCollisionCallback.isDefined( this ) )
             {
                 // Yes, so perform script callback on the Scene.
-                Con::executef( this, 4, "onSceneCollision",
+                sOnSceneCollisionCallback.executef( this, 3,
                     pSceneObjectABuffer,
                     pSceneObjectBBuffer,
                     pMiscInfoBuffer );
@@ -646,10 +808,10 @@ void Scene::dispatchBeginContactCallbacks( void )
         if ( sceneObjectACallback )
         {
             // Yes, so does it handle the collision callback?
-            if ( pSceneObjectA->isMethod("onCollision") )            
+            if ( sOnCollisionCallback.isDefined( pSceneObjectA ) )
             {
                 // Yes, so perform the script callback on it.
-                Con::executef( pSceneObjectA, 3, "onCollision",
+                sOnCollisionCallback.executef( pSceneObjectA, 2,
                     pSceneObjectBBuffer,
                     pMiscInfoBuffer );
             }
@@ -665,10 +827,10 @@ void Scene::dispatchBeginContactCallbacks( void )
         if ( sceneObjectBCallback )
         {
             // Yes, so does it handle the collision callback?
-            if ( pSceneObjectB->isMethod("onCollision") )            
+            if ( sOnCollisionCallback.isDefined( pSceneObjectB ) )
             {
                 // Yes, so perform the script callback on it.
-                Con::executef( pSceneObjectB, 3, "onCollision",
+                sOnCollisionCallback.executef( pSceneObjectB, 2,
                     pSceneObjectABuffer,
                     pMiscInfoBuffer );
             }
@@ -743,11 +905,10 @@ void Scene::dispatchEndContactCallbacks( void )
         if ( sceneObjectACallback && sceneObjectBCallback )
         {
             // Yes, so does the scene handle the collision callback?
-            Namespace* pNamespace = getNamespace();
-            if ( pNamespace != NULL && pNamespace->lookup( StringTable->insert( "onSceneEndCollision" ) ) != NULL )
+            if ( sOnSceneEndCollisionCallback.isDefined( this ) )
             {
                 // Yes, so does the scene handle the collision callback?
-                Con::executef( this, 4, "onSceneEndCollision",
+                sOnSceneEndCollisionCallback.executef( this, 3,
                     pSceneObjectABuffer,
                     pSceneObjectBBuffer,
                     pMiscInfoBuffer );
@@ -764,10 +925,10 @@ void Scene::dispatchEndContactCallbacks( void )
         if ( sceneObjectACallback )
         {
             // Yes, so does it handle the collision callback?
-            if ( pSceneObjectA->isMethod("onEndCollision") )            
+            if ( sOnEndCollisionCallback.isDefined( pSceneObjectA ) )
             {
                 // Yes, so perform the script callback on it.
-                Con::executef( pSceneObjectA, 3, "onEndCollision",
+                sOnEndCollisionCallback.executef( pSceneObjectA, 2,
                     pSceneObjectBBuffer,
                     pMiscInfoBuffer );
             }
@@ -783,10 +944,10 @@ void Scene::dispatchEndContactCallbacks( void )
         if ( sceneObjectBCallback )
         {
             // Yes, so does it handle the collision callback?
-            if ( pSceneObjectB->isMethod("onEndCollision") )            
+            if ( sOnEndCollisionCallback.isDefined( pSceneObjectB ) )
             {
                 // Yes, so perform the script callback on it.
-                Con::executef( pSceneObjectB, 3, "onEndCollision",
+                sOnEndCollisionCallback.executef( pSceneObjectB, 2,
                     pSceneObjectABuffer,
                     pMiscInfoBuffer );
             }
@@ -802,6 +963,134 @@ void Scene::dispatchEndContactCallbacks( void )
 
 //-----------------------------------------------------------------------------
 
+bool Scene::batchContact( const TickContact& tickContact, typeBatchedContactVector& batchedContacts )
+{
+    // Fetch scene objects.
+    SceneObject* pSceneObjectA = tickContact.mpSceneObjectA;
+    SceneObject* pSceneObjectB = tickContact.mpSceneObjectB;
+
+    // Skip if either object is being deleted.
+    if ( pSceneObjectA->isBeingDeleted() || pSceneObjectB->isBeingDeleted() )
+        return false;
+
+    // Skip if both objects don't have collision callback active.
+    if ( !pSceneObjectA->getCollisionCallback() && !pSceneObjectB->getCollisionCallback() )
+        return false;
+
+    batchedContacts.increment();
+    BatchedContact& batchedContact = batchedContacts.last();
+
+    batchedContact.mpSceneObjectA = pSceneObjectA;
+    batchedContact.mpSceneObjectB = pSceneObjectB;
+    batchedContact.mSceneObjectIdA = pSceneObjectA->getId();
+    batchedContact.mSceneObjectIdB = pSceneObjectB->getId();
+    batchedContact.mShapeIndexA = pSceneObjectA->getCollisionShapeIndex( tickContact.mpFixtureA );
+    batchedContact.mShapeIndexB = pSceneObjectB->getCollisionShapeIndex( tickContact.mpFixtureB );
+    batchedContact.mPointCount = tickContact.mPointCount;
+    batchedContact.mNormal = tickContact.mWorldManifold.normal;
+
+    // Sanity!
+    AssertFatal( batchedContact.mShapeIndexA >= 0, "Scene::batchContact() - Cannot find shape index reported on physics proxy of a fixture." );
+    AssertFatal( batchedContact.mShapeIndexB >= 0, "Scene::batchContact() - Cannot find shape index reported on physics proxy of a fixture." );
+
+    for ( U32 n = 0; n < b2_maxManifoldPoints; ++n )
+    {
+        batchedContact.mPoints[n] = tickContact.mWorldManifold.points[n];
+        batchedContact.mNormalImpulses[n] = tickContact.mNormalImpulses[n];
+        batchedContact.mTangentImpulses[n] = tickContact.mTangentImpulses[n];
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::dispatchBatchedContactCallbacks( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_DispatchBatchedContactCallbacks);
+
+    // Finish if no contacts.
+    if ( mBeginContacts.size() == 0 && mEndContacts.size() == 0 )
+        return;
+
+    // Pack the end contacts.
+    mBatchedEndContacts.reserve( mEndContacts.size() );
+    for ( typeContactVector::iterator contactItr = mEndContacts.begin(); contactItr != mEndContacts.end(); ++contactItr )
+    {
+        batchContact( *contactItr, mBatchedEndContacts );
+    }
+
+    // Pack the begin contacts.
+    mBatchedBeginContacts.reserve( mBeginContacts.size() );
+    for ( typeContactHash::iterator contactItr = mBeginContacts.begin(); contactItr != mBeginContacts.end(); ++contactItr )
+    {
+        batchContact( contactItr->value, mBatchedBeginContacts );
+    }
+
+    // Finish if no contacts require a callback.
+    if ( mBatchedBeginContacts.size() == 0 && mBatchedEndContacts.size() == 0 )
+        return;
+
+    // Notify the native listeners.
+    for ( typeContactListenerVector::iterator listenerItr = mContactListeners.begin(); listenerItr != mContactListeners.end(); ++listenerItr )
+    {
+        (*listenerItr)->onSceneContacts( this, mBatchedBeginContacts, mBatchedEndContacts );
+    }
+
+    // Format contact counts.
+    char* pBeginCountBuffer = Con::getArgBuffer( 16 );
+    char* pEndCountBuffer = Con::getArgBuffer( 16 );
+    dSprintf( pBeginCountBuffer, 16, "%d", mBatchedBeginContacts.size() );
+    dSprintf( pEndCountBuffer, 16, "%d", mBatchedEndContacts.size() );
+
+    // Does the scene handle the collision callback?
+    if ( sOnSceneCollisionsCallback.isDefined( this ) )
+    {
+        // Yes, so perform script callback on the Scene.
+        sOnSceneCollisionsCallback.executef( this, 2, pBeginCountBuffer, pEndCountBuffer );
+    }
+    else
+    {
+        // No, so call it on its behaviors.
+        const char* args[4] = { "onSceneCollisions", this->getIdString(), pBeginCountBuffer, pEndCountBuffer };
+        callOnBehaviors( 4, args );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::addContactListener( SceneContactListener* pListener )
+{
+    // Sanity!
+    AssertFatal( pListener != NULL, "Scene::addContactListener() - Cannot add a NULL listener." );
+
+    // Ignore if already added.
+    for ( typeContactListenerVector::iterator listenerItr = mContactListeners.begin(); listenerItr != mContactListeners.end(); ++listenerItr )
+    {
+        if ( *listenerItr == pListener )
+            return;
+    }
+
+    mContactListeners.push_back( pListener );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeContactListener( SceneContactListener* pListener )
+{
+    for ( typeContactListenerVector::iterator listenerItr = mContactListeners.begin(); listenerItr != mContactListeners.end(); ++listenerItr )
+    {
+        if ( *listenerItr != pListener )
+            continue;
+
+        mContactListeners.erase( listenerItr );
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 void Scene::processTick( void )
 {
     // Debug Profiling.
@@ -832,51 +1121,34 @@ void Scene::processTick( void )
     // Finish if scene is paused.
     if ( !getScenePause() )
     {
-        // Reset object stats.
-        U32 objectsEnabled = 0;
-        U32 objectsVisible = 0;
-        U32 objectsAwake   = 0;
-
         // Fetch if a "normal" i.e. non-editor scene.
         const bool isNormalScene = !getIsEditorScene();
 
         // Update scene time.
         mSceneTime += Tickable::smTickSec;
 
-        // Clear ticked scene objects.
-        mTickedSceneObjects.clear();
-
-        // Iterate scene objects.
-        for( S32 n = 0; n < mSceneObjects.size(); ++n )
+        // Take a copy of the active objects as objects can be enabled, disabled or deleted during the tick.
+        compactActiveSceneObjects();
+        if ( isNormalScene )
         {
-            // Fetch scene object.
-            SceneObject* pSceneObject = mSceneObjects[n];
-
-            // Update awake/asleep counts.
-            if ( pSceneObject->getAwake() )
-                objectsAwake++;
-
-            // Update visible.
-            if ( pSceneObject->getVisible() )
-                objectsVisible++;
-
-            // Push scene object if it's eligible for ticking.
-            if ( pSceneObject->isEnabled() )
+            mTickedSceneObjects = mActiveSceneObjects;
+        }
+        else
+        {
+            // Only objects marked as allowing editor ticks are ticked in an editor scene.
+            mTickedSceneObjects.clear();
+            for( S32 n = 0; n < mActiveSceneObjects.size(); ++n )
             {
-                // Update enabled.
-                objectsEnabled++;
-
-                // Add to ticked objects if object is not being deleted and this is a "normal" scene or
-                // the object is marked as allowing editor ticks.
-                if ( !pSceneObject->isBeingDeleted() && (isNormalScene || pSceneObject->getIsEditorTickAllowed() )  )
-                    mTickedSceneObjects.push_back( pSceneObject );
+                if ( mActiveSceneObjects[n]->getIsEditorTickAllowed() )
+                    mTickedSceneObjects.push_back( mActiveSceneObjects[n] );
             }
         }
 
         // Update object stats.
-        mDebugStats.objectsEnabled = objectsEnabled;
-        mDebugStats.objectsVisible = objectsVisible;
-        mDebugStats.objectsAwake   = objectsAwake;
+        // NOTE:- The ground body is the only body in the world that isn't a scene object.
+        mDebugStats.objectsEnabled = mEnabledObjectCount;
+        mDebugStats.objectsVisible = mVisibleObjectCount;
+        mDebugStats.objectsAwake   = (U32)mpWorld->GetAwakeBodyCount() - (mpGroundBody->IsAwake() ? 1 : 0);
 
         // Debug Status Reference.
         DebugStats* pDebugStats = &mDebugStats;
@@ -935,6 +1207,8 @@ void Scene::processTick( void )
         // Reset contacts.
         mBeginContacts.clear();
         mEndContacts.clear();
+        mBatchedBeginContacts.clear();
+        mBatchedEndContacts.clear();
 
         // Only step the physics if a "normal" scene.
         if ( isNormalScene )
@@ -983,15 +1257,22 @@ void Scene::processTick( void )
             // Debug Profiling.
             PROFILE_SCOPE(Scene_OnSceneUpdatetCallback);
 
-            Con::executef( this, 1, "onSceneUpdate" );
+            sOnSceneUpdateCallback.execute( this );
         }
 
         // Only dispatch contacts if a "normal" scene.
         if ( isNormalScene )
         {
             // Dispatch contacts callbacks.
-            dispatchEndContactCallbacks();
-            dispatchBeginContactCallbacks();
+            if ( mBatchCollisionCallbacks )
+            {
+                dispatchBatchedContactCallbacks();
+            }
+            else
+            {
+                dispatchEndContactCallbacks();
+                dispatchBeginContactCallbacks();
+            }
         }
 
         // Clear ticked scene objects.
@@ -1016,20 +1297,13 @@ void Scene::interpolateTick( F32 timeDelta )
 	// Interpolate scene objects.
     // ****************************************************
 
-	// Fetch the scene object count.
-	const S32 sceneObjectCount = mSceneObjects.size();
-
-    // Iterate scene objects.
-    for( S32 n = 0; n < sceneObjectCount; ++n )
+    // Iterate active scene objects.
+    compactActiveSceneObjects();
+    for( S32 n = 0; n < mActiveSceneObjects.size(); ++n )
     {
-        // Fetch scene object.
-        SceneObject* pSceneObject = mSceneObjects[n];
-
-        // Skip interpolation of scene object if it's not eligible.
-        if ( !pSceneObject->isEnabled() || pSceneObject->isBeingDeleted() )
-            continue;
-
-        pSceneObject->interpolateObject( timeDelta );
+        SceneObject* pSceneObject = mActiveSceneObjects[n];
+        if ( pSceneObject != NULL )
+            pSceneObject->interpolateObject( timeDelta );
     }
 }
 
@@ -1372,11 +1646,15 @@ void Scene::clearScene( bool deleteObjects )
 {
     while( mSceneObjects.size() > 0 )
     {
-        // Fetch first scene object.
-        SceneObject* pSceneObject = mSceneObjects[0];
+        // Fetch last scene object.
+        // NOTE:- Removing the last object doesn't move any other object.
+        SceneObject* pSceneObject = mSceneObjects.last();
+
+        // Detach from the scene.
+        detachSceneObject( pSceneObject );
 
-        // Remove Object from Scene.
-        removeFromScene( pSceneObject );
+        // Perform callback.
+        sOnRemoveFromSceneCallback.executef( pSceneObject, 1, getIdString() );
 
         // Queue Object for deletion.
         if ( deleteObjects )
@@ -1409,14 +1687,6 @@ void Scene::addToScene( SceneObject* pSceneObject )
     if ( pCurrentScene == this )
         return;
 
-#if defined(TORQUE_DEBUG)
-    // Sanity!
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
-    {
-        AssertFatal( mSceneObjects[n] != pSceneObject, "A scene object has become corrupt." );
-    }
-#endif
-
     // Check that object is not already in a scene.
     if ( pCurrentScene )
     {
@@ -1424,16 +1694,13 @@ void Scene::addToScene( SceneObject* pSceneObject )
         pCurrentScene->removeFromScene( pSceneObject );
     }
 
-    // Add scene object.
-    mSceneObjects.push_back( pSceneObject );
-
-    // Register with the scene.
-    pSceneObject->OnRegisterScene( this );
+    // Attach to the scene.
+    attachSceneObject( pSceneObject );
 
     // Perform callback only if properly added to the simulation.
     if ( pSceneObject->isProperlyAdded() )
     {
-        Con::executef(pSceneObject, 2, "onAddToScene", getIdString());
+        sOnAddToSceneCallback.executef( pSceneObject, 1, getIdString() );
     }
     else
     {
@@ -1449,13 +1716,130 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
     if ( pSceneObject == NULL )
         return;
 
-    // Check if object is actually in a scene.
-    if ( !pSceneObject->getScene() )
+    // Check if object is actually in this scene.
+    if ( pSceneObject->getScene() != this )
     {
-        Con::warnf("Scene::removeFromScene() - Object '%s' is not in a scene!.", pSceneObject->getIdString());
+        Con::warnf("Scene::removeFromScene() - Object '%s' is not in this scene!.", pSceneObject->getIdString());
         return;
     }
 
+    // Detach from the scene.
+    detachSceneObject( pSceneObject );
+
+    // Perform callback.
+    sOnRemoveFromSceneCallback.executef( pSceneObject, 1, getIdString() );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::addToScene( const typeSceneObjectVector& sceneObjects )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_AddToSceneBulk);
+
+    // Reserve the scene occupancy up-front.
+    mSceneObjects.reserve( mSceneObjects.size() + sceneObjects.size() );
+    mActiveSceneObjects.reserve( mActiveSceneObjects.size() + sceneObjects.size() );
+
+    U32 unregisteredCount = 0;
+
+    for ( S32 n = 0; n < sceneObjects.size(); ++n )
+    {
+        // Fetch scene object.
+        SceneObject* pSceneObject = sceneObjects[n];
+
+        // Ignore if invalid or already in the scene.
+        if ( pSceneObject == NULL || pSceneObject->getScene() == this )
+            continue;
+
+        // Remove from any current scene.
+        if ( pSceneObject->getScene() )
+            pSceneObject->getScene()->removeFromScene( pSceneObject );
+
+        // Attach to the scene.
+        attachSceneObject( pSceneObject );
+
+        // Perform callback only if properly added to the simulation.
+        if ( !pSceneObject->isProperlyAdded() )
+            unregisteredCount++;
+        else
+            sOnAddToSceneCallback.executef( pSceneObject, 1, getIdString() );
+    }
+
+    // Warn once for any objects that could not receive the callback.
+    if ( unregisteredCount > 0 )
+        Con::warnf("Scene::addToScene() - %d scene object(s) added to scene but not registered with the simulation.  No 'onAddToScene' can be performed!  Use Target scene.", unregisteredCount);
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeFromScene( const typeSceneObjectVector& sceneObjects, const bool deleteObjects )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(Scene_RemoveFromSceneBulk);
+
+    for ( S32 n = 0; n < sceneObjects.size(); ++n )
+    {
+        // Fetch scene object.
+        SceneObject* pSceneObject = sceneObjects[n];
+
+        // Ignore if invalid or not in this scene.
+        if ( pSceneObject == NULL || pSceneObject->getScene() != this )
+            continue;
+
+        // Detach from the scene.
+        detachSceneObject( pSceneObject );
+
+        // Perform callback.
+        sOnRemoveFromSceneCallback.executef( pSceneObject, 1, getIdString() );
+
+        // Queue Object for deletion.
+        if ( deleteObjects )
+            pSceneObject->safeDelete();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::attachSceneObject( SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->mSceneIndex == -1, "Scene::attachSceneObject() - A scene object has become corrupt." );
+
+    // Add scene object.
+    pSceneObject->mSceneIndex = mSceneObjects.size();
+    mSceneObjects.push_back( pSceneObject );
+
+    // Register with the scene.
+    pSceneObject->OnRegisterScene( this );
+
+    // Track the object state.
+    if ( pSceneObject->isEnabled() )
+    {
+        mEnabledObjectCount++;
+
+        if ( !pSceneObject->isBeingDeleted() )
+            addActiveSceneObject( pSceneObject );
+    }
+
+    if ( pSceneObject->getVisible() )
+        mVisibleObjectCount++;
+
+    // Index the object by layer and group.
+    addIndexedSceneObject( mLayerSceneObjects[pSceneObject->getSceneLayer()], pSceneObject, &SceneObject::mSceneLayerIndex );
+    addIndexedSceneObject( mGroupSceneObjects[pSceneObject->getSceneGroup()], pSceneObject, &SceneObject::mSceneGroupIndex );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::detachSceneObject( SceneObject* pSceneObject )
+{
+    // Fetch the scene index.
+    const S32 sceneIndex = pSceneObject->mSceneIndex;
+
+    // Sanity!
+    AssertFatal( sceneIndex >= 0 && sceneIndex < mSceneObjects.size() && mSceneObjects[sceneIndex] == pSceneObject, "Scene::detachSceneObject() - A scene object has become corrupt." );
+
     // Remove as debug-object if set.
     if ( pSceneObject == getDebugSceneObject() )
         setDebugSceneObject( NULL );
@@ -1472,21 +1856,164 @@ void Scene::removeFromScene( SceneObject* pSceneObject )
         (dynamic_cast<SceneWindow*>(mAttachedSceneWindows[i]))->removeFromInputEventPick(pSceneObject);
     }
 
+    // Stop tracking the object state.
+    if ( pSceneObject->isEnabled() )
+        mEnabledObjectCount--;
+
+    if ( pSceneObject->getVisible() )
+        mVisibleObjectCount--;
+
+    removeActiveSceneObject( pSceneObject );
+    removeIndexedSceneObject( mLayerSceneObjects[pSceneObject->getSceneLayer()], pSceneObject, &SceneObject::mSceneLayerIndex );
+    removeIndexedSceneObject( mGroupSceneObjects[pSceneObject->getSceneGroup()], pSceneObject, &SceneObject::mSceneGroupIndex );
+
     // Unregister from scene.
     pSceneObject->OnUnregisterScene( this );
 
-    // Find scene object and remove it quickly.
-    for ( S32 n = 0; n < mSceneObjects.size(); ++n )
+    // Move the last scene object into the vacated slot.
+    SceneObject* pLastSceneObject = mSceneObjects.last();
+    mSceneObjects[sceneIndex] = pLastSceneObject;
+    pLastSceneObject->mSceneIndex = sceneIndex;
+    mSceneObjects.pop_back();
+
+    pSceneObject->mSceneIndex = -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::onSceneObjectEnabled( SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->getScene() == this, "Scene::onSceneObjectEnabled() - Object is not in this scene." );
+
+    if ( pSceneObject->isEnabled() )
     {
-        if ( mSceneObjects[n] == pSceneObject )
-        {
-            mSceneObjects.erase_fast( n );
-            break;
-        }
+        mEnabledObjectCount++;
+
+        if ( !pSceneObject->isBeingDeleted() )
+            addActiveSceneObject( pSceneObject );
+    }
+    else
+    {
+        mEnabledObjectCount--;
+        removeActiveSceneObject( pSceneObject );
     }
+}
 
-    // Perform callback.
-    Con::executef( pSceneObject, 2, "onRemoveFromScene", getIdString() );
+//-----------------------------------------------------------------------------
+
+void Scene::onSceneObjectVisible( SceneObject* pSceneObject )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->getScene() == this, "Scene::onSceneObjectVisible() - Object is not in this scene." );
+
+    if ( pSceneObject->getVisible() )
+        mVisibleObjectCount++;
+    else
+        mVisibleObjectCount--;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::addIndexedSceneObject( typeSceneObjectVector& objects, SceneObject* pSceneObject, S32 SceneObject::* pObjectIndex )
+{
+    // Ignore if already indexed.
+    if ( pSceneObject->*pObjectIndex != -1 )
+        return;
+
+    pSceneObject->*pObjectIndex = objects.size();
+    objects.push_back( pSceneObject );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeIndexedSceneObject( typeSceneObjectVector& objects, SceneObject* pSceneObject, S32 SceneObject::* pObjectIndex )
+{
+    // Ignore if not indexed.
+    const S32 objectIndex = pSceneObject->*pObjectIndex;
+    if ( objectIndex == -1 )
+        return;
+
+    // Sanity!
+    AssertFatal( objectIndex < objects.size() && objects[objectIndex] == pSceneObject, "Scene::removeIndexedSceneObject() - A scene object has become corrupt." );
+
+    // Move the last object into the vacated slot.
+    SceneObject* pLastSceneObject = objects.last();
+    objects[objectIndex] = pLastSceneObject;
+    pLastSceneObject->*pObjectIndex = objectIndex;
+    objects.pop_back();
+
+    pSceneObject->*pObjectIndex = -1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::addActiveSceneObject( SceneObject* pSceneObject )
+{
+    addIndexedSceneObject( mActiveSceneObjects, pSceneObject, &SceneObject::mActiveSceneIndex );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::removeActiveSceneObject( SceneObject* pSceneObject )
+{
+    // Ignore if not active.
+    const S32 objectIndex = pSceneObject->mActiveSceneIndex;
+    if ( objectIndex == -1 )
+        return;
+
+    // Sanity!
+    AssertFatal( objectIndex < mActiveSceneObjects.size() && mActiveSceneObjects[objectIndex] == pSceneObject, "Scene::removeActiveSceneObject() - A scene object has become corrupt." );
+
+    // Leave a hole rather than move another object so the tick order is kept.
+    mActiveSceneObjects[objectIndex] = NULL;
+    pSceneObject->mActiveSceneIndex = -1;
+    mActiveSceneObjectsDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::compactActiveSceneObjects( void )
+{
+    // Finish if nothing has been removed.
+    if ( !mActiveSceneObjectsDirty )
+        return;
+
+    S32 activeCount = 0;
+    for( S32 n = 0; n < mActiveSceneObjects.size(); ++n )
+    {
+        SceneObject* pSceneObject = mActiveSceneObjects[n];
+        if ( pSceneObject == NULL )
+            continue;
+
+        pSceneObject->mActiveSceneIndex = activeCount;
+        mActiveSceneObjects[activeCount++] = pSceneObject;
+    }
+
+    mActiveSceneObjects.setSize( activeCount );
+    mActiveSceneObjectsDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::onSceneObjectLayerChanged( SceneObject* pSceneObject, const U32 oldSceneLayer )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->getScene() == this, "Scene::onSceneObjectLayerChanged() - Object is not in this scene." );
+
+    removeIndexedSceneObject( mLayerSceneObjects[oldSceneLayer], pSceneObject, &SceneObject::mSceneLayerIndex );
+    addIndexedSceneObject( mLayerSceneObjects[pSceneObject->getSceneLayer()], pSceneObject, &SceneObject::mSceneLayerIndex );
+}
+
+//-----------------------------------------------------------------------------
+
+void Scene::onSceneObjectGroupChanged( SceneObject* pSceneObject, const U32 oldSceneGroup )
+{
+    // Sanity!
+    AssertFatal( pSceneObject->getScene() == this, "Scene::onSceneObjectGroupChanged() - Object is not in this scene." );
+
+    removeIndexedSceneObject( mGroupSceneObjects[oldSceneGroup], pSceneObject, &SceneObject::mSceneGroupIndex );
+    addIndexedSceneObject( mGroupSceneObjects[pSceneObject->getSceneGroup()], pSceneObject, &SceneObject::mSceneGroupIndex );
 }
 
 //-----------------------------------------------------------------------------
@@ -1517,31 +2044,28 @@ U32 Scene::getSceneObjects( typeSceneObjectVector& objects ) const
 
 U32 Scene::getSceneObjects( typeSceneObjectVector& objects, const U32 sceneLayer ) const
 {
-    // No objects if scene is empty!
-    if ( getSceneObjectCount() == 0 )
+    // No objects if the layer is invalid.
+    if ( sceneLayer >= MAX_LAYERS_SUPPORTED )
         return 0;
 
-    // Reset object count.
-    U32 count = 0;
+    // Merge with the layer objects.
+    objects.merge( mLayerSceneObjects[sceneLayer] );
 
-    // Iterate scene objects.
-    for( S32 n = 0; n < mSceneObjects.size(); ++n )
-    {
-        // Fetch scene object.
-        SceneObject* pSceneObject = mSceneObjects[n];
+    return mLayerSceneObjects[sceneLayer].size();
+}
 
-        // Skip if not the correct layer.
-        if ( pSceneObject->getSceneLayer() != sceneLayer )
-            continue;
+//-----------------------------------------------------------------------------
 
-        // Add to objects.
-        objects.push_back( pSceneObject );
+U32 Scene::getSceneGroupObjects( typeSceneObjectVector& objects, const U32 sceneGroup ) const
+{
+    // No objects if the group is invalid.
+    if ( sceneGroup >= MAX_GROUPS_SUPPORTED )
+        return 0;
 
-        // Increase count.
-        count++;
-    }
+    // Merge with the group objects.
+    objects.merge( mGroupSceneObjects[sceneGroup] );
 
-    return count;
+    return mGroupSceneObjects[sceneGroup].size();
 }
 
 //-----------------------------------------------------------------------------
@@ -1598,7 +2122,7 @@ U32 Scene::findJointId( b2Joint* pJoint )
     AssertFatal( pJoint != NULL, "Joint cannot be NULL." );
 
     // Find joint.
-    typeReverseJointHash::iterator itr = mReverseJoints.find( (U32)pJoint );
+    typeReverseJointHash::iterator itr = mReverseJoints.find( pJoint );
 
     if ( itr == mReverseJoints.end() )
     {
@@ -1629,7 +2153,7 @@ U32 Scene::createJoint( b2JointDef* pJointDef )
     AssertFatal( itr != mJoints.end(), "Joint already in hash table." );
 
     // Insert reverse joint.
-    mReverseJoints.insert( (U32)pJoint, jointId );
+    mReverseJoints.insert( pJoint, jointId );
 
     return jointId;
 }
@@ -3533,6 +4057,9 @@ void Scene::addDeleteRequest( SceneObject* pSceneObject )
 
     // Flag Delete in Progress.
     pSceneObject->mBeingSafeDeleted = true;
+
+    // Objects being deleted are no longer ticked.
+    removeActiveSceneObject( pSceneObject );
 }
 
 
@@ -3660,7 +4187,7 @@ void Scene::SayGoodbye( b2Joint* pJoint )
 
     // Remove joint references.
     mJoints.erase( jointId );
-    mReverseJoints.erase( (U32)pJoint );
+    mReverseJoints.erase( pJoint );
 }
 
 //-----------------------------------------------------------------------------
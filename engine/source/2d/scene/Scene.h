@@ -51,8 +51,8 @@
 #include "2d/scene/DebugDraw.h"
 #endif
 
-#ifndef _HASHTABLE_H
-#include "collection/hashTable.h"
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
 #endif
 
 #ifndef _BATCH_RENDER_H_
@@ -79,6 +79,7 @@ extern EnumTable jointTypeTable;
 
 class SceneObject;
 class SceneWindow;
+class PhysicsWorkerPool;
 
 ///-----------------------------------------------------------------------------
 
@@ -153,6 +154,36 @@ struct TickContact
 
 ///-----------------------------------------------------------------------------
 
+/// A compact contact record delivered by batched collision callbacks.
+/// The scene object pointers are only valid during dispatch whereas the Ids remain valid for script.
+struct BatchedContact
+{
+    SceneObject*    mpSceneObjectA;
+    SceneObject*    mpSceneObjectB;
+    SimObjectId     mSceneObjectIdA;
+    SimObjectId     mSceneObjectIdB;
+    S32             mShapeIndexA;
+    S32             mShapeIndexB;
+    U32             mPointCount;
+    b2Vec2          mNormal;
+    b2Vec2          mPoints[b2_maxManifoldPoints];
+    F32             mNormalImpulses[b2_maxManifoldPoints];
+    F32             mTangentImpulses[b2_maxManifoldPoints];
+};
+
+///-----------------------------------------------------------------------------
+
+/// Receives all the contacts for a tick in a single call when a scene batches its collision callbacks.
+class SceneContactListener
+{
+public:
+    virtual ~SceneContactListener() {}
+
+    virtual void onSceneContacts( Scene* pScene, const Vector<BatchedContact>& beginContacts, const Vector<BatchedContact>& endContacts ) = 0;
+};
+
+///-----------------------------------------------------------------------------
+
 class Scene :
     public BehaviorComponent,
     public TamlChildren,
@@ -162,11 +193,13 @@ class Scene :
     public virtual Tickable
 {
 public:
-    typedef HashMap<U32, b2Joint*>              typeJointHash;
-    typedef HashMap<U32, U32>                   typeReverseJointHash;
+    typedef FlatHashMap<U32, b2Joint*>          typeJointHash;
+    typedef FlatHashMap<b2Joint*, U32>          typeReverseJointHash;
     typedef Vector<tDeleteRequest>              typeDeleteVector;
     typedef Vector<TickContact>                 typeContactVector;
-    typedef HashMap<b2Contact*, TickContact>    typeContactHash;
+    typedef FlatHashMap<b2Contact*, TickContact> typeContactHash;
+    typedef Vector<BatchedContact>              typeBatchedContactVector;
+    typedef Vector<SceneContactListener*>       typeContactListenerVector;
 
     /// Scene Debug Options.
     enum DebugOption
@@ -212,10 +245,27 @@ private:
     b2BlockAllocator            mBlockAllocator;
     b2Body*                     mpGroundBody;
 
+    /// Multithreaded physics.  A thread count of zero uses the serial solver.
+    U32                         mPhysicsThreadCount;
+    bool                        mParallelCollide;
+    PhysicsWorkerPool*          mpPhysicsWorkerPool;
+
     /// Scene occupancy.
     typeSceneObjectVector       mSceneObjects;
     typeSceneObjectVector       mTickedSceneObjects;
 
+    /// Active objects (enabled and not being deleted) and object state counts.
+    /// These are maintained as objects change state so ticking does not scan the whole scene.
+    /// Removed objects leave a NULL slot that is compacted away once per tick to keep the tick order.
+    typeSceneObjectVector       mActiveSceneObjects;
+    bool                        mActiveSceneObjectsDirty;
+    U32                         mEnabledObjectCount;
+    U32                         mVisibleObjectCount;
+
+    /// Objects indexed by scene layer and scene group.
+    typeSceneObjectVector       mLayerSceneObjects[MAX_LAYERS_SUPPORTED];
+    typeSceneObjectVector       mGroupSceneObjects[MAX_GROUPS_SUPPORTED];
+
     /// Joint access.
     typeJointHash               mJoints;
     typeReverseJointHash        mReverseJoints;
@@ -257,11 +307,35 @@ private:
     typeContactVector           mEndContacts;
     U32                         mSceneIndex;
 
+    /// Batched collision callbacks.
+    bool                        mBatchCollisionCallbacks;
+    typeBatchedContactVector    mBatchedBeginContacts;
+    typeBatchedContactVector    mBatchedEndContacts;
+    typeContactListenerVector   mContactListeners;
+
 private:   
     /// Contacts.
     void                        forwardContacts( void );
+
+    /// Multithreaded physics.
+    void                        updatePhysicsWorkers( void );
+
+    /// Scene occupancy.
+    void                        attachSceneObject( SceneObject* pSceneObject );
+    void                        detachSceneObject( SceneObject* pSceneObject );
+
+    /// Indexed objects.
+    static void                 addIndexedSceneObject( typeSceneObjectVector& objects, SceneObject* pSceneObject, S32 SceneObject::* pObjectIndex );
+    static void                 removeIndexedSceneObject( typeSceneObjectVector& objects, SceneObject* pSceneObject, S32 SceneObject::* pObjectIndex );
+
+    /// Active objects.
+    void                        addActiveSceneObject( SceneObject* pSceneObject );
+    void                        removeActiveSceneObject( SceneObject* pSceneObject );
+    void                        compactActiveSceneObjects( void );
     void                        dispatchBeginContactCallbacks( void );
     void                        dispatchEndContactCallbacks( void );
+    void                        dispatchBatchedContactCallbacks( void );
+    bool                        batchContact( const TickContact& tickContact, typeBatchedContactVector& batchedContacts );
 
     /// Joint definition.
     struct CommonJointDefinition
@@ -309,6 +383,14 @@ public:
     const typeContactHash&  getBeginContacts( void ) const              { return mBeginContacts; }
     const typeContactVector& getEndContacts( void ) const               { return mEndContacts; }
 
+    /// Batched collision callbacks.
+    inline void             setBatchCollisionCallbacks( const bool batch ) { mBatchCollisionCallbacks = batch; }
+    inline bool             getBatchCollisionCallbacks( void ) const    { return mBatchCollisionCallbacks; }
+    const typeBatchedContactVector& getBatchedBeginContacts( void ) const { return mBatchedBeginContacts; }
+    const typeBatchedContactVector& getBatchedEndContacts( void ) const { return mBatchedEndContacts; }
+    void                    addContactListener( SceneContactListener* pListener );
+    void                    removeContactListener( SceneContactListener* pListener );
+
     /// Integration.
     virtual void            processTick();
     virtual void            interpolateTick( F32 delta );
@@ -329,17 +411,37 @@ public:
     inline S32              getVelocityIterations( void ) const         { return mVelocityIterations; }
     inline void             setPositionIterations( const S32 iterations ) { mPositionIterations = iterations; }
     inline S32              getPositionIterations( void ) const         { return mPositionIterations; }
+    void                    setPhysicsThreadCount( const U32 threadCount );
+    inline U32              getPhysicsThreadCount( void ) const         { return mPhysicsThreadCount; }
+    void                    setParallelCollide( const bool parallelCollide );
+    inline bool             getParallelCollide( void ) const            { return mParallelCollide; }
+
+    /// Physics snapshots.
+    inline void             savePhysicsSnapshot( b2WorldSnapshot& snapshot ) const { mpWorld->SaveSnapshot( &snapshot ); }
+    bool                    restorePhysicsSnapshot( const b2WorldSnapshot& snapshot );
 
     /// Scene occupancy.
     void                    clearScene( bool deleteObjects = true );
     void                    addToScene( SceneObject* pSceneObject );
     void                    removeFromScene( SceneObject* pSceneObject );
+    void                    addToScene( const typeSceneObjectVector& sceneObjects );
+    void                    removeFromScene( const typeSceneObjectVector& sceneObjects, const bool deleteObjects = false );
 
     inline typeSceneObjectVectorConstRef getSceneObjects( void ) const  { return mSceneObjects; }
     inline U32              getSceneObjectCount( void ) const           { return mSceneObjects.size(); }
     SceneObject*            getSceneObject( const U32 objectIndex ) const;
     U32                     getSceneObjects( typeSceneObjectVector& objects ) const;
     U32                     getSceneObjects( typeSceneObjectVector& objects, const U32 sceneLayer ) const;
+    U32                     getSceneGroupObjects( typeSceneObjectVector& objects, const U32 sceneGroup ) const;
+    inline typeSceneObjectVectorConstRef getLayerSceneObjects( const U32 sceneLayer ) const { AssertFatal( sceneLayer < MAX_LAYERS_SUPPORTED, "Scene::getLayerSceneObjects() - Invalid layer." ); return mLayerSceneObjects[sceneLayer]; }
+    inline typeSceneObjectVectorConstRef getGroupSceneObjects( const U32 sceneGroup ) const { AssertFatal( sceneGroup < MAX_GROUPS_SUPPORTED, "Scene::getGroupSceneObjects() - Invalid group." ); return mGroupSceneObjects[sceneGroup]; }
+    void                    onSceneObjectLayerChanged( SceneObject* pSceneObject, const U32 oldSceneLayer );
+    void                    onSceneObjectGroupChanged( SceneObject* pSceneObject, const U32 oldSceneGroup );
+
+    /// Active objects.
+    inline typeSceneObjectVectorConstRef getActiveSceneObjects( void ) { compactActiveSceneObjects(); return mActiveSceneObjects; }
+    void                    onSceneObjectEnabled( SceneObject* pSceneObject );
+    void                    onSceneObjectVisible( SceneObject* pSceneObject );
 
     void                    mergeScene( const Scene* pScene );
 
@@ -666,6 +768,10 @@ protected:
     static bool writeGravity( void* obj, StringTableEntry pFieldName )              { return Vector2(static_cast<Scene*>(obj)->getGravity()).notEqual( Vector2::getZero() ); }
     static bool writeVelocityIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getVelocityIterations() != 8; }
     static bool writePositionIterations( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getPositionIterations() != 3; }
+    static bool setPhysicsThreadCount( void* obj, const char* data )                { static_cast<Scene*>(obj)->setPhysicsThreadCount( (U32)getMax( dAtoi(data), 0 ) ); return false; }
+    static bool writePhysicsThreadCount( void* obj, StringTableEntry pFieldName )   { return static_cast<Scene*>(obj)->getPhysicsThreadCount() != 0; }
+    static bool setParallelCollide( void* obj, const char* data )                   { static_cast<Scene*>(obj)->setParallelCollide( dAtob(data) ); return false; }
+    static bool writeParallelCollide( void* obj, StringTableEntry pFieldName )      { return static_cast<Scene*>(obj)->getParallelCollide(); }
 
     static bool writeLayerSortMode( void* obj, StringTableEntry pFieldName )
     {
@@ -700,6 +806,7 @@ protected:
     // Callbacks.
     static bool writeUpdateCallback( void* obj, StringTableEntry pFieldName )       { return static_cast<Scene*>(obj)->getUpdateCallback(); }
     static bool writeRenderCallback( void* obj, StringTableEntry pFieldName )       { return static_cast<Scene*>(obj)->getRenderCallback(); }
+    static bool writeBatchCollisionCallbacks( void* obj, StringTableEntry pFieldName ) { return static_cast<Scene*>(obj)->getBatchCollisionCallbacks(); }
 
 public:
     static SimObjectPtr<Scene> LoadingScene;
@@ -100,6 +100,40 @@ ConsoleMethod(Scene, getPositionIterations, S32, 2, 2,  "() Gets the number of p
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Scene, setPhysicsThreads, void, 3, 3, "(int threadCount) Sets the number of threads used to solve physics islands.\n"
+                                                            "@param threadCount The number of threads including the stepping thread.  Zero uses the serial solver.  Clamped to the processor count.\n"
+                                                            "@return No return value.")
+{
+    object->setPhysicsThreadCount( (U32)getMax( dAtoi(argv[2]), 0 ) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getPhysicsThreads, S32, 2, 2,  "() Gets the number of threads used to solve physics islands.\n"
+                                                            "@return The number of threads used to solve physics islands.  Zero is the serial solver." )
+{
+    return (S32)object->getPhysicsThreadCount();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, setParallelCollide, void, 3, 3, "(bool status) Sets whether contact manifolds are also updated on the physics threads or not.\n"
+                                                            "This only has an effect when physics threads are in use.\n"
+                                                            "@return No return value.")
+{
+    object->setParallelCollide( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getParallelCollide, bool, 2, 2, "() Gets whether contact manifolds are also updated on the physics threads or not.\n"
+                                                            "@return Whether contact manifolds are also updated on the physics threads or not." )
+{
+    return object->getParallelCollide();
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, add, void, 3, 3,   "(sceneObject) Add the SceneObject to the scene.\n"
                                         "@param sceneObject The SceneObject to add to the scene.\n"
                                         "@return No return value.")
@@ -143,6 +177,76 @@ ConsoleMethod(Scene, remove, void, 3, 3,    "(sceneObject) Remove the SceneObjec
 
 //-----------------------------------------------------------------------------
 
+static void findSceneObjectList( const char* pObjectList, typeSceneObjectVector& sceneObjects, const char* pMethodName )
+{
+    // Walk the list directly as fetching each unit by index would rescan the list.
+    char objectName[256];
+    while ( *pObjectList != 0 )
+    {
+        // Skip separators.
+        if ( *pObjectList == ' ' || *pObjectList == '\t' || *pObjectList == '\n' )
+        {
+            pObjectList++;
+            continue;
+        }
+
+        // Copy the object name.
+        U32 nameLength = 0;
+        while ( *pObjectList != 0 && *pObjectList != ' ' && *pObjectList != '\t' && *pObjectList != '\n' )
+        {
+            if ( nameLength < sizeof(objectName) - 1 )
+                objectName[nameLength++] = *pObjectList;
+
+            pObjectList++;
+        }
+        objectName[nameLength] = 0;
+
+        // Find the specified object.
+        SceneObject* pSceneObject = dynamic_cast<SceneObject*>( Sim::findObject( objectName ) );
+
+        // Did we find the object?
+        if ( !pSceneObject )
+        {
+            // No, so warn.
+            Con::warnf("Scene::%s() - Could not find the specified object '%s'.", pMethodName, objectName );
+            continue;
+        }
+
+        sceneObjects.push_back( pSceneObject );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, addObjects, void, 3, 3,    "(sceneObjectList) Add many SceneObjects to the scene in one call.\n"
+                                                "@param sceneObjectList A space-separated list of SceneObjects to add to the scene.\n"
+                                                "@return No return value.")
+{
+    // Find the specified objects.
+    typeSceneObjectVector sceneObjects;
+    findSceneObjectList( argv[2], sceneObjects, "addObjects" );
+
+    // Add to Scene.
+    object->addToScene( sceneObjects );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, removeObjects, void, 3, 4, "(sceneObjectList, [deleteObjects]) Remove many SceneObjects from the scene in one call.\n"
+                                                "@param sceneObjectList A space-separated list of SceneObjects to remove from the scene.\n"
+                                                "@param deleteObjects A boolean flag that sets whether to delete the objects as well as remove them from the scene (default is false).\n"
+                                                "@return No return value.")
+{
+    // Find the specified objects.
+    typeSceneObjectVector sceneObjects;
+    findSceneObjectList( argv[2], sceneObjects, "removeObjects" );
+
+    // Remove from Scene.
+    object->removeFromScene( sceneObjects, argc >= 4 ? dAtob( argv[3] ) : false );
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, clear, void, 2, 3, "([deleteObjects]) Clear the scene of all scene objects.\n"
                                         "@param deleteObjects A boolean flag that sets whether to delete the objects as well as remove them from the scene (default is true).\n"
                                         "@return No return value.")
@@ -209,14 +313,10 @@ ConsoleMethod(Scene, getObject, S32, 3, 3,  "(sceneObjectIndex) Gets the scene o
 
 //-----------------------------------------------------------------------------
 
-ConsoleMethod(Scene, getSceneObjectList, const char*, 2, 2, "() Gets the Scene Object-List.\n"
-                                                            "@return Returns a string with a list of object IDs")
+static const char* formatSceneObjectList( typeSceneObjectVectorConstRef objList, const char* pMethodName )
 {
-    // Scene Object-List.
-    Vector<SceneObject*> objList;
-
     // Finish here if there are no scene objects.
-    U32 objCount = object->getSceneObjects( objList );
+    const U32 objCount = objList.size();
     if( objCount == 0 )
         return NULL;
 
@@ -239,7 +339,7 @@ ConsoleMethod(Scene, getSceneObjectList, const char*, 2, 2, "() Gets the Scene O
         if ( bufferCount >= maxBufferSize )
         {
             // Warn.
-            Con::warnf("Scene::getSceneObjectList() - Not enough space to return all %d objects!", objList.size());
+            Con::warnf("Scene::%s() - Not enough space to return all %d objects!", pMethodName, objList.size());
             break;
         }
     }
@@ -250,6 +350,52 @@ ConsoleMethod(Scene, getSceneObjectList, const char*, 2, 2, "() Gets the Scene O
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Scene, getSceneObjectList, const char*, 2, 2, "() Gets the Scene Object-List.\n"
+                                                            "@return Returns a string with a list of object IDs")
+{
+    return formatSceneObjectList( object->getSceneObjects(), "getSceneObjectList" );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getLayerObjectList, const char*, 3, 3, "(sceneLayer) Gets the objects in the specified scene layer.\n"
+                                                            "@param sceneLayer The scene layer (0-31).\n"
+                                                            "@return Returns a string with a list of object IDs")
+{
+    // Fetch the layer.
+    const U32 sceneLayer = dAtoi(argv[2]);
+
+    // Sanity!
+    if ( sceneLayer >= MAX_LAYERS_SUPPORTED )
+    {
+        Con::warnf("Scene::getLayerObjectList() - Invalid scene layer '%d' (0-31).", sceneLayer);
+        return NULL;
+    }
+
+    return formatSceneObjectList( object->getLayerSceneObjects( sceneLayer ), "getLayerObjectList" );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getGroupObjectList, const char*, 3, 3, "(sceneGroup) Gets the objects in the specified scene group.\n"
+                                                            "@param sceneGroup The scene group (0-31).\n"
+                                                            "@return Returns a string with a list of object IDs")
+{
+    // Fetch the group.
+    const U32 sceneGroup = dAtoi(argv[2]);
+
+    // Sanity!
+    if ( sceneGroup >= MAX_GROUPS_SUPPORTED )
+    {
+        Con::warnf("Scene::getGroupObjectList() - Invalid scene group '%d' (0-31).", sceneGroup);
+        return NULL;
+    }
+
+    return formatSceneObjectList( object->getGroupSceneObjects( sceneGroup ), "getGroupObjectList" );
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, mergeScene, void, 3, 3,    "(scene) Merges the specified scene into this scene by cloning the scenes contents.")
 {
     // Find the specified scene.
@@ -3069,6 +3215,141 @@ ConsoleMethod(Scene, getBatchingEnabled, bool, 2, 2,    "() Gets whether render
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(Scene, setBatchCollisionCallbacks, void, 3, 3,    "( bool batch ) Sets whether collision callbacks are batched or not.\n"
+                                                                "When batched, the scene performs a single 'onSceneCollisions(beginCount, endCount)' callback per tick instead of "
+                                                                "'onSceneCollision', 'onCollision' and their end variants per contact.  The contacts can then be read with "
+                                                                "'getBeginContact()' and 'getEndContact()' until the next tick.\n"
+                                                                "@param batch Whether collision callbacks are batched or not.\n"
+                                                                "@return No return value.\n" )
+{
+    object->setBatchCollisionCallbacks( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getBatchCollisionCallbacks, bool, 2, 2,    "() Gets whether collision callbacks are batched or not.\n"
+                                                                "@return Whether collision callbacks are batched or not.\n" )
+{
+    return object->getBatchCollisionCallbacks();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, setReplicationScene, void, 2, 3,  "([bool status]) Sets whether this scene receives the scene objects replicated from the server.\n"
+                                                        "Only one scene receives replicated scene objects so this replaces any previous scene.\n"
+                                                        "@param status Whether this scene receives replicated scene objects or not.  Defaults to true.\n"
+                                                        "@return No return value.\n" )
+{
+    const bool status = argc > 2 ? dAtob(argv[2]) : true;
+
+    if ( status )
+        SceneObjectGhost::setClientScene( object );
+    else if ( SceneObjectGhost::getClientScene() == object )
+        SceneObjectGhost::setClientScene( NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getReplicationScene, bool, 2, 2,  "() Gets whether this scene receives the scene objects replicated from the server.\n"
+                                                        "@return Whether this scene receives replicated scene objects or not.\n" )
+{
+    return SceneObjectGhost::getClientScene() == object;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getBeginContactCount, S32, 2, 2,  "() Gets the number of batched begin contacts for the last tick.\n"
+                                                        "@return The number of batched begin contacts for the last tick.\n" )
+{
+    return object->getBatchedBeginContacts().size();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getBeginContact, const char*, 3, 3,   "(contactIndex) Gets the batched begin contact at the specified index.\n"
+                                                            "@param contactIndex The index of the batched begin contact.\n"
+                                                            "@return The contact as 'sceneObjectA sceneObjectB shapeIndexA shapeIndexB normalX normalY' followed by "
+                                                            "'pointX pointY normalImpulse tangentImpulse' for each contact point or an empty string if the index is invalid.\n" )
+{
+    // Fetch contact index.
+    const S32 contactIndex = dAtoi(argv[2]);
+
+    // Fetch batched contacts.
+    const Scene::typeBatchedContactVector& batchedContacts = object->getBatchedBeginContacts();
+
+    // Is the contact index valid?
+    if ( contactIndex < 0 || contactIndex >= batchedContacts.size() )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::getBeginContact() - Invalid contact index '%d'.", contactIndex );
+        return StringTable->EmptyString;
+    }
+
+    // Fetch contact.
+    const BatchedContact& contact = batchedContacts[contactIndex];
+
+    // Format contact.
+    // NOTE: dSprintf returns the untruncated length so stop appending once the buffer is full.
+    const S32 bufferSize = 256;
+    char* pBuffer = Con::getReturnBuffer(bufferSize);
+    S32 bufferLength = dSprintf( pBuffer, bufferSize, "%d %d %d %d %0.4f %0.4f",
+        contact.mSceneObjectIdA, contact.mSceneObjectIdB,
+        contact.mShapeIndexA, contact.mShapeIndexB,
+        contact.mNormal.x, contact.mNormal.y );
+
+    for ( U32 n = 0; n < contact.mPointCount && bufferLength >= 0 && bufferLength < bufferSize; ++n )
+    {
+        bufferLength += dSprintf( pBuffer + bufferLength, bufferSize - bufferLength, " %0.4f %0.4f %0.4f %0.4f",
+            contact.mPoints[n].x, contact.mPoints[n].y,
+            contact.mNormalImpulses[n],
+            contact.mTangentImpulses[n] );
+    }
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getEndContactCount, S32, 2, 2,    "() Gets the number of batched end contacts for the last tick.\n"
+                                                        "@return The number of batched end contacts for the last tick.\n" )
+{
+    return object->getBatchedEndContacts().size();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(Scene, getEndContact, const char*, 3, 3, "(contactIndex) Gets the batched end contact at the specified index.\n"
+                                                        "@param contactIndex The index of the batched end contact.\n"
+                                                        "@return The contact as 'sceneObjectA sceneObjectB shapeIndexA shapeIndexB' or an empty string if the index is invalid.\n" )
+{
+    // Fetch contact index.
+    const S32 contactIndex = dAtoi(argv[2]);
+
+    // Fetch batched contacts.
+    const Scene::typeBatchedContactVector& batchedContacts = object->getBatchedEndContacts();
+
+    // Is the contact index valid?
+    if ( contactIndex < 0 || contactIndex >= batchedContacts.size() )
+    {
+        // No, so warn.
+        Con::warnf( "Scene::getEndContact() - Invalid contact index '%d'.", contactIndex );
+        return StringTable->EmptyString;
+    }
+
+    // Fetch contact.
+    const BatchedContact& contact = batchedContacts[contactIndex];
+
+    // Format contact.
+    char* pBuffer = Con::getReturnBuffer(64);
+    dSprintf( pBuffer, 64, "%d %d %d %d",
+        contact.mSceneObjectIdA, contact.mSceneObjectIdB,
+        contact.mShapeIndexA, contact.mShapeIndexB );
+
+    return pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(Scene, setIsEditorScene, void, 3, 3, "() Sets whether this is an editor scene\n"
                                                             "@return No return value.")
 {
@@ -60,6 +60,10 @@
 #include "2d/sceneobject/SceneObjectRotateToEvent.h"
 #endif
 
+#ifndef _SCENE_OBJECT_GHOST_H_
+#include "2d/sceneobject/SceneObjectGhost.h"
+#endif
+
 #ifndef _RENDER_PROXY_H_
 #include "2d/core/RenderProxy.h"
 #endif
@@ -68,6 +72,14 @@
 #include "string/stringUnit.h"
 #endif
 
+#ifndef _CONSOLE_CALLBACK_H_
+#include "console/consoleCallback.h"
+#endif
+
+#ifndef _INLINEVECTOR_H_
+#include "collection/inlineVector.h"
+#endif
+
 // Script bindings.
 #include "SceneObject_ScriptBinding.h"
 
@@ -84,6 +96,11 @@ IMPLEMENT_CONOBJECT(SceneObject);
 static U32 sGlobalSceneObjectCount = 0;
 static U32 sSceneObjectMasterSerialId = 0;
 
+// Script callbacks.
+static ConsoleCallback sOnUpdateCallback( "onUpdate" );
+static ConsoleCallback sOnWakeCallback( "onWake" );
+static ConsoleCallback sOnSleepCallback( "onSleep" );
+
 // Collision shape property names.
 static bool collisionShapePropertiesInitialized = false;
 
@@ -111,6 +128,8 @@ static StringTableEntry edgeTypeName;
 SceneObject::SceneObject() :
     /// Scene.
     mpScene(NULL),
+    mSceneIndex(-1),
+    mActiveSceneIndex(-1),
     mpTargetScene(NULL),
 
     /// Lifetime.
@@ -121,10 +140,12 @@ SceneObject::SceneObject() :
     mSceneLayer(0),
     mSceneLayerMask(BIT(mSceneLayer)),
     mSceneLayerDepth(0.0f),
+    mSceneLayerIndex(-1),
 
     /// Scene groups.
     mSceneGroup(0),
     mSceneGroupMask(BIT(mSceneGroup)),
+    mSceneGroupIndex(-1),
 
     /// Area.
     mWorldProxyId(-1),
@@ -183,6 +204,9 @@ SceneObject::SceneObject() :
     mBeingSafeDeleted(false),
     mSafeDeleteReady(true),
 
+    /// Replication.
+    mpReplicationGhost(NULL),
+
     /// Miscellaneous.
     mBatchIsolated(false),
     mSerialiseKey(0),
@@ -268,6 +292,9 @@ SceneObject::SceneObject() :
 
 SceneObject::~SceneObject()
 {
+    // Stop replicating.
+    setReplicated( false );
+
     // Are we in a Scene?
     if ( mpScene )
     {
@@ -330,7 +357,7 @@ void SceneObject::initPersistFields()
     addProtectedField("GravityScale", TypeF32, NULL, &setGravityScale, &getGravityScale, &writeGravityScale, "");
 
     /// Render visibility.
-    addField("Visible", TypeBool, Offset(mVisible, SceneObject), &writeVisible, "");
+    addProtectedField("Visible", TypeBool, Offset(mVisible, SceneObject), &setVisible, &defaultProtectedGetFn, &writeVisible, "");
 
     /// Render blending.
     addField("BlendMode", TypeBool, Offset(mBlendMode, SceneObject), &writeBlendMode, "");
@@ -391,6 +418,9 @@ void SceneObject::onRemove()
     // Detach Any GUI Control.
     detachGui();
 
+    // Stop replicating.
+    setReplicated( false );
+
     // Remove from Scene.
     if ( getScene() )
         getScene()->removeFromScene( this );
@@ -662,11 +692,15 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
     // Notify components.
     notifyComponentsUpdate();
 
+    // Flag any replicated state that changed.
+    if ( mpReplicationGhost != NULL )
+        mpReplicationGhost->updateState();
+
     // Script "onUpdate".
     if ( mUpdateCallback )
     {
         PROFILE_SCOPE(SceneObject_onUpdateCallback);
-        Con::executef(this, 1, "onUpdate");
+        sOnUpdateCallback.execute( this );
     }
 
     // Are we using the sleeping callback?
@@ -685,9 +719,9 @@ void SceneObject::postIntegrate(const F32 totalTime, const F32 elapsedTime, Debu
 
             // Perform the appropriate callback.
             if ( currentAwakeState )
-                Con::executef(this, 1, "onWake");
+                sOnWakeCallback.execute( this );
             else
-                Con::executef(this, 1, "onSleep");
+                sOnSleepCallback.execute( this );
         }
     }
 }
@@ -857,8 +891,69 @@ void SceneObject::unpackUpdate(NetConnection * conn, BitStream *stream)
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::setReplicated( const bool replicated )
+{
+    // Finish if no change.
+    if ( replicated == getReplicated() )
+        return;
+
+    if ( replicated )
+    {
+        // Create the ghost.
+        mpReplicationGhost = new SceneObjectGhost( this );
+
+        if ( !mpReplicationGhost->registerObject() )
+        {
+            // Warn.
+            Con::warnf( "SceneObject::setReplicated() - Could not register the replication ghost." );
+
+            delete mpReplicationGhost;
+            mpReplicationGhost = NULL;
+        }
+    }
+    else
+    {
+        // Delete the ghost.
+        mpReplicationGhost->deleteObject();
+        mpReplicationGhost = NULL;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::setReplicatedTransform( const Vector2& position, const F32 angle )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObject_SetReplicatedTransform);
+
+    if ( !mpScene )
+    {
+        mBodyDefinition.position = position;
+        mBodyDefinition.angle = angle;
+        return;
+    }
+
+    mpBody->SetTransform( position, angle );
+
+    // Update the world proxy but keep the pre-tick spatials so that
+    // the object is interpolated to the new transform.
+    CoreMath::mCalculateAABB( getLocalSizedOOBB(), getTransform(), &mCurrentAABB );
+
+    b2AABB tickAABB;
+    tickAABB.Combine( mPreTickAABB, mCurrentAABB );
+    mpScene->getWorldQuery()->update( this, tickAABB, position - mPreTickPosition );
+
+    // Flag spatial dirty.
+    mSpatialDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::setEnabled( const bool enabled )
 {
+    // Fetch the current state.
+    const bool wasEnabled = isEnabled();
+
     // Call parent.
     Parent::setEnabled( enabled );
 
@@ -866,11 +961,30 @@ void SceneObject::setEnabled( const bool enabled )
     if ( mpScene )
     {
         mpBody->SetActive( enabled );
+
+        // Keep the scene active list current.
+        if ( wasEnabled != isEnabled() )
+            mpScene->onSceneObjectEnabled( this );
     }
 }
 
 //-----------------------------------------------------------------------------
 
+void SceneObject::setVisible( const bool status )
+{
+    // Finish if no change.
+    if ( mVisible == status )
+        return;
+
+    mVisible = status;
+
+    // Keep the scene visible count current.
+    if ( mpScene )
+        mpScene->onSceneObjectVisible( this );
+}
+
+//-----------------------------------------------------------------------------
+
 void SceneObject::setLifetime( const F32 lifetime )
 {
     // Debug Profiling.
@@ -925,11 +1039,22 @@ void SceneObject::setSceneLayer( const U32 sceneLayer )
         return;
     }
 
+    // Finish if no change.
+    if ( mSceneLayer == sceneLayer )
+        return;
+
+    // Fetch the current layer.
+    const U32 oldSceneLayer = mSceneLayer;
+
     // Set Layer.
     mSceneLayer = sceneLayer;
 
     // Set Layer Mask.
     mSceneLayerMask = BIT( mSceneLayer );
+
+    // Keep the scene layer index current.
+    if ( mpScene )
+        mpScene->onSceneObjectLayerChanged( this, oldSceneLayer );
 }
 
 //-----------------------------------------------------------------------------
@@ -1145,17 +1270,28 @@ bool SceneObject::setSceneLayerDepthBackward( void )
 void SceneObject::setSceneGroup( const U32 sceneGroup )
 {
     // Check Group.
-    if ( sceneGroup > 31 )
+    if ( sceneGroup > (MAX_GROUPS_SUPPORTED-1) )
     {
         Con::warnf("SceneObject::setSceneGroup() - Invalid scene group '%d' (0-31).", sceneGroup);
         return;
     }
 
+    // Finish if no change.
+    if ( mSceneGroup == sceneGroup )
+        return;
+
+    // Fetch the current group.
+    const U32 oldSceneGroup = mSceneGroup;
+
     // Set Group.
     mSceneGroup = sceneGroup;
 
     // Set Group Mask.
     mSceneGroupMask = BIT( mSceneGroup );
+
+    // Keep the scene group index current.
+    if ( mpScene )
+        mpScene->onSceneObjectGroupChanged( this, oldSceneGroup );
 }
 
 //-----------------------------------------------------------------------------
@@ -3676,7 +3812,7 @@ void SceneObject::onTamlCustomRead( const TamlCustomNodes& customNodes )
         else if ( shapeName == chainTypeName )
         {
             // Yes, so ready fields.
-            Vector<b2Vec2> points;
+            InlineVector<b2Vec2, b2_maxPolygonVertices * 2> points;
             bool hasAdjacentStartPoint = false;
             bool hasAdjacentEndPoint = false;
             b2Vec2 adjacentStartPoint;
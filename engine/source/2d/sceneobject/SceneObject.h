@@ -69,6 +69,10 @@
 
 //-----------------------------------------------------------------------------
 
+class SceneObjectGhost;
+
+//-----------------------------------------------------------------------------
+
 struct tDestroyNotification
 {
     SceneObject*    mpSceneObject;
@@ -117,6 +121,8 @@ public:
 protected:
     /// Scene.
     SimObjectPtr<Scene>  mpScene;
+    S32                  mSceneIndex;
+    S32                  mActiveSceneIndex;
 
     /// Target Scene.
     /// NOTE:   Unfortunately this is required as the scene can be set via a field which
@@ -133,10 +139,12 @@ protected:
     U32                     mSceneLayer;
     U32                     mSceneLayerMask;
     F32                     mSceneLayerDepth;
+    S32                     mSceneLayerIndex;
 
     /// Scene groups.
     U32                     mSceneGroup;
     U32                     mSceneGroupMask;
+    S32                     mSceneGroupIndex;
 
     /// Area.
     Vector2                 mSize;
@@ -211,6 +219,9 @@ protected:
     /// Destroy notifications.
     typeDestroyNotificationVector mDestroyNotifyList;
 
+    /// Replication.
+    SceneObjectGhost*       mpReplicationGhost;
+
     /// Miscellaneous.
     bool                    mBatchIsolated;
     U32                     mSerialiseKey;
@@ -277,6 +288,12 @@ public:
     virtual U32             packUpdate(NetConnection * conn, U32 mask, BitStream *stream);
     virtual void            unpackUpdate(NetConnection * conn, BitStream *stream);
 
+    /// Replication.
+    void                    setReplicated( const bool replicated );
+    inline bool             getReplicated( void ) const                 { return mpReplicationGhost != NULL; }
+    inline SceneObjectGhost* getReplicationGhost( void ) const          { return mpReplicationGhost; }
+    void                    setReplicatedTransform( const Vector2& position, const F32 angle );
+
     /// Scene.
     inline Scene* const     getScene( void ) const                      { return mpScene; }
     inline F32              getSceneTime( void ) const                  { if ( mpScene ) return mpScene->getSceneTime(); else return 0.0f; }
@@ -477,7 +494,7 @@ public:
     Vector2                 getEdgeCollisionShapeAdjacentEnd( const U32 shapeIndex ) const;
 
     /// Render visibility.
-    inline void             setVisible( const bool status )             { mVisible = status; }
+    void                    setVisible( const bool status );
     inline bool             getVisible(void) const                      { return mVisible; }
 
     /// Render blending.
@@ -688,6 +705,7 @@ protected:
     static bool             writeGravityScale( void* obj, StringTableEntry pFieldName ) { return mNotEqual(static_cast<SceneObject*>(obj)->getGravityScale(), 1.0f); }
 
     /// Render visibility.
+    static bool             setVisible(void* obj, const char* data)     { static_cast<SceneObject*>(obj)->setVisible(dAtob(data)); return false; }
     static bool             writeVisible( void* obj, StringTableEntry pFieldName ) { return static_cast<SceneObject*>(obj)->getVisible() == false; }
 
     /// Render blending.
@@ -0,0 +1,657 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_OBJECT_GHOST_H_
+#include "2d/sceneobject/SceneObjectGhost.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _SPRITE_PROXY_BASE_H_
+#include "2d/core/SpriteProxyBase.h"
+#endif
+
+#ifndef _NETCONNECTION_H_
+#include "network/netConnection.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+// Debug Profiling.
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+IMPLEMENT_CO_NETOBJECT_V1(SceneObjectGhost);
+
+//-----------------------------------------------------------------------------
+
+SimObjectPtr<Scene> SceneObjectGhost::smClientScene = NULL;
+
+//-----------------------------------------------------------------------------
+
+static S32 quantizeValue( const F32 value, const F32 scale, const U32 bits )
+{
+    // Clamp well inside the signed range of the bits.
+    const F32 limit = F32( (1 << (bits-2)) - 1 );
+    return S32( mRound( mClampF( value * scale, -limit, limit ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+static void writeQuantized( BitStream* pStream, const S32 value, const S32* pBase, const U32 deltaBits, const U32 bits )
+{
+    // Write a delta if there's a base and the delta is small enough.
+    if ( pBase != NULL )
+    {
+        const S32 delta = value - *pBase;
+        const S32 deltaLimit = 1 << (deltaBits-1);
+
+        if ( pStream->writeFlag( delta > -deltaLimit && delta < deltaLimit ) )
+        {
+            pStream->writeSignedInt( delta, deltaBits );
+            return;
+        }
+    }
+
+    pStream->writeSignedInt( value, bits );
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 readQuantized( BitStream* pStream, const S32* pBase, const U32 deltaBits, const U32 bits )
+{
+    if ( pBase != NULL && pStream->readFlag() )
+        return *pBase + pStream->readSignedInt( deltaBits );
+
+    return pStream->readSignedInt( bits );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectGhost::SceneObjectGhost() :
+    mSceneObjectClass( StringTable->EmptyString ),
+    mSize( Vector2::getOne() ),
+    mSceneLayer( 0 ),
+    mImageAssetId( StringTable->EmptyString ),
+    mAnimationAssetId( StringTable->EmptyString )
+{
+    dMemset( &mState, 0, sizeof(mState) );
+    dMemset( mHistoryValid, 0, sizeof(mHistoryValid) );
+
+    VECTOR_SET_ASSOCIATION( mBaselines );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectGhost::SceneObjectGhost( SceneObject* pSceneObject ) :
+    mpSceneObject( pSceneObject ),
+    mSceneObjectClass( StringTable->EmptyString ),
+    mSize( Vector2::getOne() ),
+    mSceneLayer( 0 ),
+    mImageAssetId( StringTable->EmptyString ),
+    mAnimationAssetId( StringTable->EmptyString )
+{
+    // Sanity!
+    AssertFatal( pSceneObject != NULL, "SceneObjectGhost::SceneObjectGhost() - Invalid scene object." );
+
+    dMemset( &mState, 0, sizeof(mState) );
+    dMemset( mHistoryValid, 0, sizeof(mHistoryValid) );
+
+    VECTOR_SET_ASSOCIATION( mBaselines );
+
+    // Ghost to all connections.
+    mNetFlags.set( Ghostable | ScopeAlways );
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectGhost::~SceneObjectGhost()
+{
+    // Delete the connection baselines.
+    for ( S32 i = 0; i < mBaselines.size(); ++i )
+        delete mBaselines[i];
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneObjectGhost::onAdd()
+{
+    if ( isServerObject() )
+    {
+        // Finish if there's no scene object to replicate.
+        if ( mpSceneObject.isNull() )
+            return false;
+
+        // Sample the initial state.
+        captureState( mState );
+    }
+
+    // Call parent.
+    if ( !Parent::onAdd() )
+        return false;
+
+    if ( isClientObject() )
+    {
+        // Create the client scene object and warp it to the initial state.
+        createSceneObject();
+        applyState( StateMask, true );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::onRemove()
+{
+    // Delete the client scene object.
+    if ( isClientObject() && mpSceneObject )
+        mpSceneObject->safeDelete();
+
+    // Call parent.
+    Parent::onRemove();
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::updateState( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectGhost_UpdateState);
+
+    // Finish if there's no scene object.
+    if ( mpSceneObject.isNull() )
+        return;
+
+    ReplicatedState state;
+    captureState( state );
+
+    // Flag the state that changed.
+    const U32 mask = getStateChanges( mState, state );
+
+    mState = state;
+
+    if ( mask != 0 )
+        setMaskBits( mask );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneObjectGhost::getStateChanges( const ReplicatedState& from, const ReplicatedState& to )
+{
+    U32 mask = 0;
+
+    if ( to.mPosition[0] != from.mPosition[0] || to.mPosition[1] != from.mPosition[1] )
+        mask |= PositionMask;
+
+    if ( to.mAngle != from.mAngle )
+        mask |= AngleMask;
+
+    if (    to.mLinearVelocity[0] != from.mLinearVelocity[0] ||
+            to.mLinearVelocity[1] != from.mLinearVelocity[1] ||
+            to.mAngularVelocity != from.mAngularVelocity )
+        mask |= VelocityMask;
+
+    if ( to.mFrame != from.mFrame )
+        mask |= FrameMask;
+
+    if ( to.mVisible != from.mVisible )
+        mask |= VisibilityMask;
+
+    return mask;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::captureState( ReplicatedState& state ) const
+{
+    const SceneObject* pSceneObject = mpSceneObject;
+
+    // Position.
+    const Vector2 position = pSceneObject->getPosition();
+    state.mPosition[0] = quantizeValue( position.x, (F32)PositionScale, 32 );
+    state.mPosition[1] = quantizeValue( position.y, (F32)PositionScale, 32 );
+
+    // Angle.
+    F32 angle = mFmod( pSceneObject->getAngle(), M_2PI_F );
+    if ( angle < 0.0f )
+        angle += M_2PI_F;
+    state.mAngle = U32( mRound( angle * ( F32(1 << AngleBits) / M_2PI_F ) ) ) & ((1 << AngleBits) - 1);
+
+    // Velocity.
+    const Vector2 linearVelocity = pSceneObject->getLinearVelocity();
+    state.mLinearVelocity[0] = quantizeValue( linearVelocity.x, (F32)VelocityScale, VelocityBits );
+    state.mLinearVelocity[1] = quantizeValue( linearVelocity.y, (F32)VelocityScale, VelocityBits );
+    state.mAngularVelocity = quantizeValue( pSceneObject->getAngularVelocity(), (F32)VelocityScale, VelocityBits );
+
+    // Frame.  Only static sprites are replicated as animations play on the client.
+    const SpriteProxyBase* pSprite = dynamic_cast<const SpriteProxyBase*>( pSceneObject );
+    state.mFrame = pSprite != NULL && pSprite->isStaticMode() ? getMin( pSprite->getImageFrame(), U32((1 << FrameBits) - 1) ) : 0;
+
+    // Visibility.
+    state.mVisible = pSceneObject->getVisible();
+}
+
+//-----------------------------------------------------------------------------
+
+SceneObjectGhost::ConnectionBaseline* SceneObjectGhost::findBaseline( NetConnection* pConnection )
+{
+    for ( S32 i = 0; i < mBaselines.size(); )
+    {
+        ConnectionBaseline* pBaseline = mBaselines[i];
+
+        // Remove baselines of deleted connections.
+        if ( pBaseline->mConnection.isNull() )
+        {
+            delete pBaseline;
+            mBaselines.erase_fast( i );
+            continue;
+        }
+
+        if ( pBaseline->mConnection == pConnection )
+            return pBaseline;
+
+        ++i;
+    }
+
+    // Create a baseline.
+    ConnectionBaseline* pBaseline = new ConnectionBaseline();
+    pBaseline->mConnection = pConnection;
+    pBaseline->mNextSequence = 0;
+    pBaseline->mAcknowledged = false;
+    pBaseline->mAcknowledgedSequence = 0;
+    mBaselines.push_back( pBaseline );
+
+    return pBaseline;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 SceneObjectGhost::packUpdate( NetConnection* pConnection, U32 mask, BitStream* pStream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectGhost_PackUpdate);
+
+    ConnectionBaseline* pBaseline = findBaseline( pConnection );
+
+    // Initial update?
+    if ( pStream->writeFlag( mask & InitialMask ) )
+    {
+        const SceneObject* pSceneObject = mpSceneObject;
+        const SpriteProxyBase* pSprite = dynamic_cast<const SpriteProxyBase*>( pSceneObject );
+
+        pStream->writeString( pSceneObject->getClassName() );
+        pStream->write( pSceneObject->getSize().x );
+        pStream->write( pSceneObject->getSize().y );
+        pStream->writeInt( pSceneObject->getSceneLayer(), 5 );
+
+        if ( pStream->writeFlag( pSprite != NULL ) )
+        {
+            pStream->writeString( pSprite->getImage() );
+            pStream->writeString( pSprite->isStaticMode() ? StringTable->EmptyString : pSprite->getAnimation() );
+        }
+
+        // The ghost is new on this connection so any previous baseline is invalid.
+        pBaseline->mAcknowledged = false;
+        pBaseline->mPending.clear();
+    }
+
+    // Write the state sequence.
+    const U32 sequence = pBaseline->mNextSequence++;
+    pStream->writeInt( sequence & (StateHistorySize-1), StateSequenceBits );
+
+    // Only delta-encode against an acknowledged state still held by the client.
+    const bool delta = pBaseline->mAcknowledged && (sequence - pBaseline->mAcknowledgedSequence) < StateHistorySize;
+
+    PendingState pending;
+    pending.mUpdateSequence = pConnection->getGhostUpdateSequence();
+    pending.mSequence = sequence;
+
+    // The state the client will hold for this sequence.
+    ReplicatedState& sentState = pending.mState;
+    const ReplicatedState* pBaseState = NULL;
+    U32 stateMask = StateMask;
+
+    if ( pStream->writeFlag( delta ) )
+    {
+        pStream->writeInt( pBaseline->mAcknowledgedSequence & (StateHistorySize-1), StateSequenceBits );
+
+        // Only send what changed, anything else is the acknowledged state.  That includes
+        // changes only sent in updates which are not acknowledged yet, as their dirty bits
+        // were cleared when they were sent.
+        pBaseState = &pBaseline->mAcknowledgedState;
+        sentState = *pBaseState;
+        stateMask = ( mask & StateMask ) | getStateChanges( *pBaseState, mState );
+    }
+
+    // Position.
+    if ( pStream->writeFlag( stateMask & PositionMask ) )
+    {
+        writeQuantized( pStream, mState.mPosition[0], pBaseState ? &pBaseState->mPosition[0] : NULL, PositionDeltaBits, 32 );
+        writeQuantized( pStream, mState.mPosition[1], pBaseState ? &pBaseState->mPosition[1] : NULL, PositionDeltaBits, 32 );
+        sentState.mPosition[0] = mState.mPosition[0];
+        sentState.mPosition[1] = mState.mPosition[1];
+    }
+
+    // Angle.
+    if ( pStream->writeFlag( stateMask & AngleMask ) )
+    {
+        pStream->writeInt( mState.mAngle, AngleBits );
+        sentState.mAngle = mState.mAngle;
+    }
+
+    // Velocity.
+    if ( pStream->writeFlag( stateMask & VelocityMask ) )
+    {
+        writeQuantized( pStream, mState.mLinearVelocity[0], pBaseState ? &pBaseState->mLinearVelocity[0] : NULL, VelocityDeltaBits, VelocityBits );
+        writeQuantized( pStream, mState.mLinearVelocity[1], pBaseState ? &pBaseState->mLinearVelocity[1] : NULL, VelocityDeltaBits, VelocityBits );
+        writeQuantized( pStream, mState.mAngularVelocity, pBaseState ? &pBaseState->mAngularVelocity : NULL, VelocityDeltaBits, VelocityBits );
+        sentState.mLinearVelocity[0] = mState.mLinearVelocity[0];
+        sentState.mLinearVelocity[1] = mState.mLinearVelocity[1];
+        sentState.mAngularVelocity = mState.mAngularVelocity;
+    }
+
+    // Frame.
+    if ( pStream->writeFlag( stateMask & FrameMask ) )
+    {
+        pStream->writeInt( mState.mFrame, FrameBits );
+        sentState.mFrame = mState.mFrame;
+    }
+
+    // Visibility.
+    if ( pStream->writeFlag( stateMask & VisibilityMask ) )
+    {
+        pStream->writeFlag( mState.mVisible );
+        sentState.mVisible = mState.mVisible;
+    }
+
+    if ( pending.mUpdateSequence != 0 )
+    {
+        // Wait for the packet to be acknowledged.
+        pBaseline->mPending.push_back( pending );
+    }
+    else
+    {
+        // Not sent in a ghost packet (ghost always event) so delivery is guaranteed.
+        pBaseline->mAcknowledged = true;
+        pBaseline->mAcknowledgedSequence = sequence;
+        pBaseline->mAcknowledgedState = sentState;
+        pBaseline->mPending.clear();
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::onGhostUpdateNotify( NetConnection* pConnection, U32 sequence, bool received )
+{
+    ConnectionBaseline* pBaseline = findBaseline( pConnection );
+
+    // Find the pending state.
+    for ( S32 i = 0; i < pBaseline->mPending.size(); ++i )
+    {
+        const PendingState& pending = pBaseline->mPending[i];
+
+        if ( pending.mUpdateSequence != sequence )
+            continue;
+
+        if ( received )
+        {
+            // The client has this state now.
+            pBaseline->mAcknowledged = true;
+            pBaseline->mAcknowledgedSequence = pending.mSequence;
+            pBaseline->mAcknowledgedState = pending.mState;
+
+            // Notifies arrive in order so any earlier pending states are stale.
+            while ( i-- >= 0 )
+                pBaseline->mPending.pop_front();
+        }
+        else
+        {
+            pBaseline->mPending.erase( i );
+        }
+
+        return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::unpackUpdate( NetConnection* pConnection, BitStream* pStream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(SceneObjectGhost_UnpackUpdate);
+
+    // Initial update?
+    if ( pStream->readFlag() )
+    {
+        char buffer[256];
+
+        pStream->readString( buffer );
+        mSceneObjectClass = StringTable->insert( buffer );
+        pStream->read( &mSize.x );
+        pStream->read( &mSize.y );
+        mSceneLayer = pStream->readInt( 5 );
+
+        if ( pStream->readFlag() )
+        {
+            pStream->readString( buffer );
+            mImageAssetId = StringTable->insert( buffer );
+            pStream->readString( buffer );
+            mAnimationAssetId = StringTable->insert( buffer );
+        }
+
+        // Any previous states are invalid.
+        dMemset( mHistoryValid, 0, sizeof(mHistoryValid) );
+    }
+
+    const U32 sequence = pStream->readInt( StateSequenceBits );
+
+    // Fetch the base state.
+    ReplicatedState state = mState;
+    const ReplicatedState* pBaseState = NULL;
+    bool validBase = true;
+
+    if ( pStream->readFlag() )
+    {
+        const U32 baseSequence = pStream->readInt( StateSequenceBits );
+        validBase = mHistoryValid[baseSequence];
+        pBaseState = &mHistory[baseSequence];
+        state = *pBaseState;
+    }
+
+    U32 stateMask = 0;
+
+    // Position.
+    if ( pStream->readFlag() )
+    {
+        state.mPosition[0] = readQuantized( pStream, pBaseState ? &pBaseState->mPosition[0] : NULL, PositionDeltaBits, 32 );
+        state.mPosition[1] = readQuantized( pStream, pBaseState ? &pBaseState->mPosition[1] : NULL, PositionDeltaBits, 32 );
+        stateMask |= PositionMask;
+    }
+
+    // Angle.
+    if ( pStream->readFlag() )
+    {
+        state.mAngle = pStream->readInt( AngleBits );
+        stateMask |= AngleMask;
+    }
+
+    // Velocity.
+    if ( pStream->readFlag() )
+    {
+        state.mLinearVelocity[0] = readQuantized( pStream, pBaseState ? &pBaseState->mLinearVelocity[0] : NULL, VelocityDeltaBits, VelocityBits );
+        state.mLinearVelocity[1] = readQuantized( pStream, pBaseState ? &pBaseState->mLinearVelocity[1] : NULL, VelocityDeltaBits, VelocityBits );
+        state.mAngularVelocity = readQuantized( pStream, pBaseState ? &pBaseState->mAngularVelocity : NULL, VelocityDeltaBits, VelocityBits );
+        stateMask |= VelocityMask;
+    }
+
+    // Frame.
+    if ( pStream->readFlag() )
+    {
+        state.mFrame = pStream->readInt( FrameBits );
+        stateMask |= FrameMask;
+    }
+
+    // Visibility.
+    if ( pStream->readFlag() )
+    {
+        state.mVisible = pStream->readFlag();
+        stateMask |= VisibilityMask;
+    }
+
+    // The server only references states we acknowledged.
+    if ( !validBase )
+    {
+        NetConnection::setLastError( "Invalid packet." );
+        return;
+    }
+
+    // Keep the state for later deltas.
+    mHistory[sequence] = state;
+    mHistoryValid[sequence] = true;
+
+    // Apply the state.
+    mState = state;
+
+    if ( isProperlyAdded() )
+        applyState( stateMask, false );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::createSceneObject( void )
+{
+    // Create the scene object.
+    ConsoleObject* pConsoleObject = ConsoleObject::create( mSceneObjectClass );
+    SceneObject* pSceneObject = dynamic_cast<SceneObject*>( pConsoleObject );
+
+    if ( pSceneObject == NULL )
+    {
+        // Warn.
+        Con::warnf( "SceneObjectGhost::createSceneObject() - '%s' is not a scene object type.", mSceneObjectClass );
+        delete pConsoleObject;
+        return;
+    }
+
+    // Configure the scene object.  The server simulates it so it's only moved here.
+    pSceneObject->setSize( mSize );
+    pSceneObject->setSceneLayer( mSceneLayer );
+    pSceneObject->setBodyType( b2_kinematicBody );
+
+    SpriteProxyBase* pSprite = dynamic_cast<SpriteProxyBase*>( pSceneObject );
+
+    if ( pSprite != NULL )
+    {
+        if ( mAnimationAssetId != StringTable->EmptyString )
+            pSprite->setAnimation( mAnimationAssetId );
+        else if ( mImageAssetId != StringTable->EmptyString )
+            pSprite->setImage( mImageAssetId, mState.mFrame );
+    }
+
+    if ( !pSceneObject->registerObject() )
+    {
+        // Warn.
+        Con::warnf( "SceneObjectGhost::createSceneObject() - Could not register '%s' scene object.", mSceneObjectClass );
+        delete pSceneObject;
+        return;
+    }
+
+    // Add to the client scene.
+    if ( smClientScene )
+        smClientScene->addToScene( pSceneObject );
+
+    mpSceneObject = pSceneObject;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::applyState( const U32 mask, const bool warp )
+{
+    SceneObject* pSceneObject = mpSceneObject;
+
+    // Finish if there's no scene object.
+    if ( pSceneObject == NULL )
+        return;
+
+    // Transform.
+    if ( mask & (PositionMask | AngleMask) )
+    {
+        const Vector2 position( mState.mPosition[0] / (F32)PositionScale, mState.mPosition[1] / (F32)PositionScale );
+        const F32 angle = mState.mAngle * ( M_2PI_F / F32(1 << AngleBits) );
+
+        if ( warp )
+        {
+            pSceneObject->setPosition( position );
+            pSceneObject->setAngle( angle );
+        }
+        else
+        {
+            // Move without resetting the tick spatials so the object is interpolated.
+            pSceneObject->setReplicatedTransform( position, angle );
+        }
+    }
+
+    // Velocity.
+    if ( mask & VelocityMask )
+    {
+        pSceneObject->setLinearVelocity( Vector2( mState.mLinearVelocity[0] / (F32)VelocityScale, mState.mLinearVelocity[1] / (F32)VelocityScale ) );
+        pSceneObject->setAngularVelocity( mState.mAngularVelocity / (F32)VelocityScale );
+    }
+
+    // Frame.
+    if ( mask & FrameMask )
+    {
+        SpriteProxyBase* pSprite = dynamic_cast<SpriteProxyBase*>( pSceneObject );
+
+        if ( pSprite != NULL && pSprite->isStaticMode() && pSprite->getImageFrame() != mState.mFrame )
+            pSprite->setImageFrame( mState.mFrame );
+    }
+
+    // Visibility.
+    if ( mask & VisibilityMask )
+        pSceneObject->setVisible( mState.mVisible );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObjectGhost::setClientScene( Scene* pScene )
+{
+    smClientScene = pScene;
+}
+
+//-----------------------------------------------------------------------------
+
+Scene* SceneObjectGhost::getClientScene( void )
+{
+    return smClientScene;
+}
@@ -0,0 +1,169 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCENE_OBJECT_GHOST_H_
+#define _SCENE_OBJECT_GHOST_H_
+
+#ifndef _NETOBJECT_H_
+#include "network/netObject.h"
+#endif
+
+#ifndef _SIM_OBJECT_PTR_H_
+#include "sim/simObjectPtr.h"
+#endif
+
+#ifndef _VECTOR2_H_
+#include "2d/core/Vector2.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class Scene;
+class SceneObject;
+
+//-----------------------------------------------------------------------------
+
+/// Replicates a server scene object to the clients.
+///
+/// A scene object cannot be a net object itself so a replicated scene object
+/// owns one of these which is ghosted in its place.  The ghost samples the
+/// quantized state of its scene object each tick and only flags the parts that
+/// changed.  Updates are delta-encoded against the last state each connection
+/// acknowledged; the client keeps a short history of the states it received
+/// so it can decode any update that references one of them.
+///
+/// On the client the ghost creates a scene object of the same class in the
+/// client scene (see setClientScene()) and applies the updates to it so that
+/// the usual scene object interpolation smooths the motion between ticks.
+class SceneObjectGhost : public NetObject
+{
+private:
+    typedef NetObject Parent;
+
+public:
+    enum ReplicationMasks
+    {
+        InitialMask     = BIT(0),
+        PositionMask    = BIT(1),
+        AngleMask       = BIT(2),
+        VelocityMask    = BIT(3),
+        FrameMask       = BIT(4),
+        VisibilityMask  = BIT(5),
+
+        StateMask       = PositionMask | AngleMask | VelocityMask | FrameMask | VisibilityMask
+    };
+
+    enum ReplicationConstants
+    {
+        StateHistorySize    = 16,   ///< Number of received states the client keeps.
+        StateSequenceBits   = 4,    ///< Bits used to send a state sequence.
+        PositionScale       = 256,  ///< Quantization steps per world unit.
+        VelocityScale       = 64,   ///< Quantization steps per unit (or radian) per second.
+        AngleBits           = 12,
+        FrameBits           = 16,
+        PositionDeltaBits   = 12,
+        VelocityDeltaBits   = 10,
+        VelocityBits        = 24
+    };
+
+    /// Quantized replicated state.
+    struct ReplicatedState
+    {
+        S32     mPosition[2];
+        U32     mAngle;
+        S32     mLinearVelocity[2];
+        S32     mAngularVelocity;
+        U32     mFrame;
+        bool    mVisible;
+    };
+
+private:
+    /// An update sent to a connection but not yet acknowledged.
+    struct PendingState
+    {
+        U32             mUpdateSequence;
+        U32             mSequence;
+        ReplicatedState mState;
+    };
+
+    /// The delta baseline of a connection.
+    struct ConnectionBaseline
+    {
+        SimObjectPtr<NetConnection> mConnection;
+        U32                 mNextSequence;
+        bool                mAcknowledged;
+        U32                 mAcknowledgedSequence;
+        ReplicatedState     mAcknowledgedState;
+        Vector<PendingState> mPending;
+    };
+
+    typedef Vector<ConnectionBaseline*> typeBaselineVector;
+
+    SimObjectPtr<SceneObject>   mpSceneObject;
+    ReplicatedState             mState;
+
+    /// Server.
+    typeBaselineVector          mBaselines;
+
+    /// Client.
+    StringTableEntry            mSceneObjectClass;
+    Vector2                     mSize;
+    U32                         mSceneLayer;
+    StringTableEntry            mImageAssetId;
+    StringTableEntry            mAnimationAssetId;
+    bool                        mHistoryValid[StateHistorySize];
+    ReplicatedState             mHistory[StateHistorySize];
+
+    static SimObjectPtr<Scene>  smClientScene;
+
+    ConnectionBaseline*     findBaseline( NetConnection* pConnection );
+    void                    captureState( ReplicatedState& state ) const;
+    static U32              getStateChanges( const ReplicatedState& from, const ReplicatedState& to );
+    void                    createSceneObject( void );
+    void                    applyState( const U32 mask, const bool warp );
+
+public:
+    SceneObjectGhost();
+    SceneObjectGhost( SceneObject* pSceneObject );
+    virtual ~SceneObjectGhost();
+
+    virtual bool            onAdd();
+    virtual void            onRemove();
+
+    inline SceneObject*     getSceneObject( void ) const { return mpSceneObject; }
+
+    /// Flags any state that changed since the last tick.
+    void                    updateState( void );
+
+    /// Networking.
+    virtual U32             packUpdate( NetConnection* pConnection, U32 mask, BitStream* pStream );
+    virtual void            unpackUpdate( NetConnection* pConnection, BitStream* pStream );
+    virtual void            onGhostUpdateNotify( NetConnection* pConnection, U32 sequence, bool received );
+
+    /// The scene that receives the replicated scene objects on the client.
+    static void             setClientScene( Scene* pScene );
+    static Scene*           getClientScene( void );
+
+    DECLARE_CONOBJECT( SceneObjectGhost );
+};
+
+#endif // _SCENE_OBJECT_GHOST_H_
@@ -3719,6 +3719,24 @@ ConsoleMethod(SceneObject, getPickingAllowed, bool, 2, 2,   "() - Gets whether p
 
 //-----------------------------------------------------------------------------
 
+ConsoleMethod(SceneObject, setReplicated, void, 3, 3,   "(bool replicated) - Sets whether the object is replicated to the clients or not.\n"
+                                                        "Replicated objects are ghosted to all connections and created in the client replication scene (see Scene::setReplicationScene()).\n"
+                                                        "@param replicated Whether the object is replicated or not.\n"
+                                                        "@return No return Value.")
+{
+    object->setReplicated( dAtob(argv[2]) );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(SceneObject, getReplicated, bool, 2, 2,   "() - Gets whether the object is replicated to the clients or not.\n"
+                                                        "@return Whether the object is replicated or not.")
+{
+    return object->getReplicated();
+}
+
+//-----------------------------------------------------------------------------
+
 ConsoleMethod(SceneObject, safeDelete, void, 2, 2, "() - Safely deletes object.\n"
                                                                  "@return No return Value.")
 {
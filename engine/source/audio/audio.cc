@@ -28,6 +28,7 @@
 #include "game/gameConnection.h"
 #include "io/fileStream.h"
 #include "audio/audioStreamSourceFactory.h"
+#include "audio/audioThread.h"
 
 #ifdef TORQUE_OS_IOS
 #include "platformiOS/SoundEngine.h"
@@ -334,6 +335,11 @@ static bool cullSource(U32 *index, F32 volume)
          (*itr2)->mHandle |= AUDIOHANDLE_INACTIVE_BIT;
          AssertFatal(!mStreamingCulledList.findImage(mHandle[best]), "cullSource: image already in culled list");
          AssertFatal(!mStreamingInactiveList.findImage(mHandle[best]), "cullSource: image should no be in inactive list");
+
+         // take the stream back from the audio thread and unqueue its buffers before freeing them
+         AudioThread::detachStream(*itr2);
+         alSourceStop(mSource[best]);
+         alSourcei(mSource[best], AL_BUFFER, AL_NONE);
          (*itr2)->freeStream();
          (*itr2)->mCullTime = Platform::getRealMilliseconds();
          mStreamingCulledList.push_back(*itr2);
@@ -404,6 +410,10 @@ bool alxIsValidHandle(AUDIOHANDLE handle)
       if(mHandle[idx] & AUDIOHANDLE_INACTIVE_BIT)
          return(true);
 
+      // so are sources waiting for their buffers
+      if(mHandle[idx] & AUDIOHANDLE_LOADING_BIT)
+         return(true);
+
       // if it is active but not playing then it has stopped...
       ALint state = AL_STOPPED;
       alGetSourcei(mSource[idx], AL_SOURCE_STATE, &state);
@@ -431,6 +441,10 @@ bool alxIsPlaying(AUDIOHANDLE handle)
    if(idx == MAX_AUDIOSOURCES)
       return(false);
 
+   // played sources waiting for their buffers start as soon as they arrive
+   if((mHandle[idx] & (AUDIOHANDLE_LOADING_BIT | AUDIOHANDLE_INACTIVE_BIT)) == AUDIOHANDLE_LOADING_BIT)
+      return(true);
+
    ALint state = 0;
    alGetSourcei(mSource[idx], AL_SOURCE_STATE, &state);
    return(state == AL_PLAYING);
@@ -510,7 +524,8 @@ static void alxSourceEnvironment(ALuint source, AudioStreamSource * image)
 // - all the settings are cached by openAL (miles version), so no worries setting them here
 static void alxSourcePlay(ALuint source, Resource<AudioBuffer> buffer, const Audio::Description& desc, const MatrixF *transform)
 {
-   alSourcei(source, AL_BUFFER, buffer->getALBuffer());
+   // buffers still loading on the audio thread are attached by alxLoadingUpdate()
+   alSourcei(source, AL_BUFFER, buffer->isLoading() ? AL_NONE : buffer->getALBuffer());
    alSourcef(source, AL_GAIN, Audio::linearToDB(desc.mVolume * mAudioChannelVolumes[desc.mVolumeChannel] * mMasterVolume));
    alSourcei(source, AL_LOOPING, desc.mIsLooping ? AL_TRUE : AL_FALSE);
    alSourcef(source, AL_PITCH, 1.f);
@@ -630,6 +645,29 @@ static void alxSourcePlay(AudioStreamSource *streamSource)
 */
 }
 
+//--------------------------------------------------------------------------
+// - start reading a buffer on the audio thread so that it does not stall its first play
+static void alxRequestBuffer(Resource<AudioBuffer> &buffer)
+{
+   if(buffer->isLoading() || buffer->isLoaded())
+      return;
+
+   // otherwise it is read when first attached to a source
+   AudioThread::queueLoad(buffer);
+}
+
+//--------------------------------------------------------------------------
+// - open a stream and hand it to the audio thread, streams start playing once
+//   their first buffers are queued
+static void alxStartStream(AudioStreamSource *streamSource)
+{
+   if(!streamSource->bIsValid && !streamSource->initStream())
+      return;
+
+   if(!AudioThread::attachStream(streamSource))
+      AudioThread::refillStream(streamSource);
+}
+
 //--------------------------------------------------------------------------
 AUDIOHANDLE alxCreateSource(const Audio::Description& desc,
                             const char *filename,
@@ -692,6 +730,8 @@ AUDIOHANDLE alxCreateSource(const Audio::Description& desc,
          if(!(bool)buffer)
             return(NULL_AUDIOHANDLE);
 
+         alxRequestBuffer(buffer);
+
          // create the inactive looping image
          LoopingImage * image = createLoopingImage();
 
@@ -766,6 +806,8 @@ AUDIOHANDLE alxCreateSource(const Audio::Description& desc,
         buffer = AudioBuffer::find(filename);
         if((bool)buffer == false)
             return NULL_AUDIOHANDLE;
+
+        alxRequestBuffer(buffer);
     }
 
    // init the source (created inactive) and store needed values
@@ -891,8 +933,27 @@ AUDIOHANDLE alxPlay(AUDIOHANDLE handle)
          // make sure the streaming image also clears it's inactive bit
          StreamingList::iterator itr2 = mStreamingList.findImage(handle);
          if(itr2)
+         {
             (*itr2)->mHandle &= ~(AUDIOHANDLE_INACTIVE_BIT | AUDIOHANDLE_LOADING_BIT);
 
+            // keep the source until the stream has started
+            mHandle[index] |= AUDIOHANDLE_LOADING_BIT;
+            alxStartStream(*itr2);
+            return(handle);
+         }
+
+         // wait for a buffer that is still loading on the audio thread
+         if(bool(mBuffer[index]))
+         {
+            ALint buffer = AL_NONE;
+            alGetSourcei(mSource[index], AL_BUFFER, &buffer);
+            if(buffer == AL_NONE)
+            {
+               mHandle[index] |= AUDIOHANDLE_LOADING_BIT;
+               return(handle);
+            }
+         }
+
          alSourcePlay(mSource[index]);
 
          return(handle);
@@ -1001,6 +1062,11 @@ void alxUnPause( AUDIOHANDLE handle )
 //--------------------------------------------------------------------------
 void alxStop(AUDIOHANDLE handle)
 {
+   // take a stream back from the audio thread before its source is stopped
+   StreamingList::iterator stream = mStreamingList.findImage(handle);
+   if(stream)
+      AudioThread::detachStream(*stream);
+
    U32 index = alxFindIndex(handle);
 
    // stop it
@@ -1073,7 +1139,7 @@ void alxStop(AUDIOHANDLE handle)
 
       // remove it
       (*itr2)->freeStream();
-      delete(*itr2);
+      AudioThread::deleteStream(*itr2);
       mStreamingList.erase_fast(itr2);
    }
 }
@@ -1816,7 +1882,11 @@ void alxStreamingUpdate()
       if((*itr)->mHandle & AUDIOHANDLE_INACTIVE_BIT)
          continue;
 
-      (*itr)->updateBuffers();
+      // streams on the audio thread are refilled there
+      if(dAtomicRead((*itr)->mThreadState) != AudioStreamSource::ThreadDetached)
+         continue;
+
+      AudioThread::refillStream(*itr);
    }
 
    static StreamingList culledList;
@@ -1873,7 +1943,7 @@ void alxStreamingUpdate()
                tmp = mStreamingList.findImage((*itr)->mHandle);
                if(tmp)
                {
-                  delete(*tmp);
+                  AudioThread::deleteStream(*tmp);
                   mStreamingList.erase_fast(tmp);
                }
 
@@ -1923,6 +1993,22 @@ void alxCloseHandles()
       if(state == AL_PLAYING)
          continue;
 
+      // a stream that ran dry is restarted when it is refilled, a finished
+      // one is taken back from the audio thread before its source is reused
+      if(mHandle[i] & AUDIOHANDLE_STREAMING_BIT)
+      {
+         StreamingList::iterator itr = mStreamingList.findImage(mHandle[i]);
+         if(itr)
+         {
+            if(AudioThread::isStreamPlaying(*itr))
+               continue;
+
+            AudioThread::detachStream(*itr);
+            alSourcei(mSource[i], AL_BUFFER, AL_NONE);
+            (*itr)->freeStream();
+         }
+      }
+
       if(!(mHandle[i] & AUDIOHANDLE_INACTIVE_BIT))
       {
          // should be playing? must have encounted an error.. remove
@@ -2112,6 +2198,42 @@ void alxUpdateMaxDistance()
    }
 }
 
+//--------------------------------------------------------------------------
+// Called every frame to start sources whose buffers arrived from the audio thread
+//--------------------------------------------------------------------------
+void alxLoadingUpdate()
+{
+   AudioThread::processCompleted();
+
+   for(U32 i = 0; i < mNumSources; i++)
+   {
+      if(!(mHandle[i] & AUDIOHANDLE_LOADING_BIT) || (mHandle[i] & AUDIOHANDLE_INACTIVE_BIT))
+         continue;
+
+      // streams hold their source until they start or fail to open
+      if(mHandle[i] & AUDIOHANDLE_STREAMING_BIT)
+      {
+         StreamingList::iterator itr = mStreamingList.findImage(mHandle[i]);
+
+         ALint state = AL_INITIAL;
+         alGetSourcei(mSource[i], AL_SOURCE_STATE, &state);
+         if(!itr || !AudioThread::isStreamPlaying(*itr) || state != AL_INITIAL)
+            mHandle[i] &= ~AUDIOHANDLE_LOADING_BIT;
+         continue;
+      }
+
+      if(bool(mBuffer[i]) && mBuffer[i]->isLoading())
+         continue;
+
+      mHandle[i] &= ~AUDIOHANDLE_LOADING_BIT;
+      if(!bool(mBuffer[i]))
+         continue;
+
+      alSourcei(mSource[i], AL_BUFFER, mBuffer[i]->getALBuffer());
+      alSourcePlay(mSource[i]);
+   }
+}
+
 //--------------------------------------------------------------------------
 // Called to update alx system
 //--------------------------------------------------------------------------
@@ -2505,6 +2627,9 @@ bool OpenALInit()
    alDistanceModel(AL_INVERSE_DISTANCE);
    alListenerf(AL_GAIN_LINEAR, 1.f);
 
+   // stream refills and buffer loads run on the audio thread
+   AudioThread::startup();
+
    return true;
 }
 
@@ -2513,6 +2638,9 @@ void OpenALShutdown()
 {
    alxStopAll();
 
+   // join the audio thread while the context is still current
+   AudioThread::shutdown();
+
    //if(mInitialized)
    {
       alxEnvironmentDestroy();
@@ -25,6 +25,7 @@
 #include "io/stream.h"
 #include "console/console.h"
 #include "memory/frameAllocator.h"
+#include "audio/audioThread.h"
 
 #ifndef _MMATH_H_
 #include "math/mMath.h"
@@ -104,7 +105,7 @@ AudioBuffer::AudioBuffer(StringTableEntry filename)
    AssertFatal(StringTable->lookup(filename), "AudioBuffer:: filename is not a string table entry");
 
    mFilename = filename;
-   mLoading = false;
+   mLoading = 0;
    malBuffer = 0;
 }
 
@@ -175,6 +176,10 @@ ALuint AudioBuffer::getALBuffer()
    if (!alcGetCurrentContext())
       return 0;
 
+   // wait for a load on the audio thread to finish
+   if (isLoading())
+      AudioThread::waitForLoad(this);
+
    // clear the error state
    alGetError();
 
@@ -221,10 +226,49 @@ ALuint AudioBuffer::getALBuffer()
    return 0;
 }
 
+//-----------------------------------------------------------------
+bool AudioBuffer::isLoaded()
+{
+   return !isLoading() && malBuffer && alIsBuffer(malBuffer);
+}
+
+/*!   Create the alBuffer and read a WAV file into it.  This is used
+      by the audio thread so it does not touch the resource manager.
+*/
+bool AudioBuffer::loadWAV(Stream &stream)
+{
+   // alGetError() is not used on the audio thread, its state is shared with the game thread
+   malBuffer = 0;
+   alGenBuffers(1, &malBuffer);
+   if(malBuffer == 0 || !alIsBuffer(malBuffer))
+   {
+      malBuffer = 0;
+      return false;
+   }
+
+   if(readWAV(stream))
+      return true;
+
+   alDeleteBuffers(1, &malBuffer);
+   malBuffer = 0;
+   return false;
+}
+
 /*!   The Read a WAV file from the given ResourceObject and initialize
       an alBuffer with it.
 */
 bool AudioBuffer::readWAV(ResourceObject *obj)
+{
+   Stream *stream = ResourceManager->openStream(obj);
+   if (!stream)
+      return false;
+
+   bool result = readWAV(*stream);
+   ResourceManager->closeStream(stream);
+   return result;
+}
+
+bool AudioBuffer::readWAV(Stream &stream)
 {
    WAVChunkHdr chunkHdr;
    WAVFmtExHdr fmtExHdr;
@@ -238,32 +282,28 @@ bool AudioBuffer::readWAV(ResourceObject *obj)
    ALsizei freq   = 22050;
    ALboolean loop = AL_FALSE;
 
-   Stream *stream = ResourceManager->openStream(obj);
-   if (!stream)
-      return false;
-
-   stream->read(4, &fileHdr.id[0]);
-   stream->read(&fileHdr.size);
-   stream->read(4, &fileHdr.type[0]);
+   stream.read(4, &fileHdr.id[0]);
+   stream.read(&fileHdr.size);
+   stream.read(4, &fileHdr.type[0]);
 
    fileHdr.size=((fileHdr.size+1)&~1)-4;
 
-   stream->read(4, &chunkHdr.id[0]);
-   stream->read(&chunkHdr.size);
+   stream.read(4, &chunkHdr.id[0]);
+   stream.read(&chunkHdr.size);
    // unread chunk data rounded up to nearest WORD
    S32 chunkRemaining = chunkHdr.size + (chunkHdr.size&1);
 
-   while ((fileHdr.size!=0) && (stream->getStatus() != Stream::EOS))
+   while ((fileHdr.size!=0) && (stream.getStatus() != Stream::EOS))
    {
       // WAV Format header
       if (!dStrncmp((const char*)chunkHdr.id,"fmt ",4))
       {
-         stream->read(&fmtHdr.format);
-         stream->read(&fmtHdr.channels);
-         stream->read(&fmtHdr.samplesPerSec);
-         stream->read(&fmtHdr.bytesPerSec);
-         stream->read(&fmtHdr.blockAlign);
-         stream->read(&fmtHdr.bitsPerSample);
+         stream.read(&fmtHdr.format);
+         stream.read(&fmtHdr.channels);
+         stream.read(&fmtHdr.samplesPerSec);
+         stream.read(&fmtHdr.bytesPerSec);
+         stream.read(&fmtHdr.blockAlign);
+         stream.read(&fmtHdr.bitsPerSample);
 
          if (fmtHdr.format==0x0001)
          {
@@ -275,7 +315,7 @@ bool AudioBuffer::readWAV(ResourceObject *obj)
          }
          else
          {
-            stream->read(sizeof(WAVFmtExHdr), &fmtExHdr);
+            stream.read(sizeof(WAVFmtExHdr), &fmtExHdr);
             chunkRemaining -= sizeof(WAVFmtExHdr);
          }
       }
@@ -288,7 +328,7 @@ bool AudioBuffer::readWAV(ResourceObject *obj)
             data=new char[chunkHdr.size];
             if (data)
             {
-               stream->read(chunkHdr.size, data);
+               stream.read(chunkHdr.size, data);
 #if defined(TORQUE_BIG_ENDIAN)
                // need to endian-flip the 16-bit data.
                if (fmtHdr.bitsPerSample==16) // !!!TBD we don't handle stereo, so may be RL flipped.
@@ -325,7 +365,7 @@ bool AudioBuffer::readWAV(ResourceObject *obj)
       {
          // this struct read is NOT endian safe but it is ok because
          // we are only testing the loops field against ZERO
-         stream->read(sizeof(WAVSmplHdr), &smplHdr);
+         stream.read(sizeof(WAVSmplHdr), &smplHdr);
          loop = (smplHdr.loops ? AL_TRUE : AL_FALSE);
          chunkRemaining -= sizeof(WAVSmplHdr);
       }
@@ -338,25 +378,28 @@ bool AudioBuffer::readWAV(ResourceObject *obj)
       while (chunkRemaining > 0)
       {
          S32 readSize = getMin(1024, chunkRemaining);
-         stream->read(readSize, buffer);
+         stream.read(readSize, buffer);
          chunkRemaining -= readSize;
       }
 
       fileHdr.size-=(((chunkHdr.size+1)&~1)+8);
 
       // read next chunk header...
-      stream->read(4, &chunkHdr.id[0]);
-      stream->read(&chunkHdr.size);
+      stream.read(4, &chunkHdr.id[0]);
+      stream.read(&chunkHdr.size);
       // unread chunk data rounded up to nearest WORD
       chunkRemaining = chunkHdr.size + (chunkHdr.size&1);
    }
 
-   ResourceManager->closeStream(stream);
    if (data)
    {
       alBufferData(malBuffer, format, data, size, freq);
       delete [] data;
-      return (alGetError() == AL_NO_ERROR);
+
+      // check what was stored rather than alGetError() as this also runs on the audio thread
+      ALint storedSize = -1;
+      alGetBufferi(malBuffer, AL_SIZE, &storedSize);
+      return (storedSize == size);
    }
 
    return false;
@@ -32,6 +32,9 @@
 #ifndef _RESMANAGER_H_
 #include "io/resource/resourceManager.h"
 #endif
+#ifndef _PLATFORM_THREADS_ATOMIC_H_
+#include "platform/threads/atomic.h"
+#endif
 
 //--------------------------------------------------------------------------
 
@@ -41,17 +44,20 @@ class AudioBuffer: public ResourceInstance
 
 private:
    StringTableEntry  mFilename;
-   bool              mLoading;
+   volatile U32      mLoading;
    ALuint            malBuffer;
 
    bool readRIFFchunk(Stream &s, const char *seekLabel, U32 *size);
    bool readWAV(ResourceObject *obj);
+   bool readWAV(Stream &stream);
+   bool loadWAV(Stream &stream);
 
 public:
    AudioBuffer(StringTableEntry filename);
    ~AudioBuffer();
    ALuint getALBuffer();
-   bool isLoading() {return(mLoading);}
+   bool isLoading() {return(dAtomicRead(mLoading) != 0);}
+   bool isLoaded();
 
    static Resource<AudioBuffer> find(const char *filename);
    static ResourceInstance* construct(Stream& stream);
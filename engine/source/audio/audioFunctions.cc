@@ -42,6 +42,10 @@
 #include "audio/audioAsset.h"
 #endif
 
+#ifndef _AUDIO_THREAD_H_
+#include "audio/audioThread.h"
+#endif
+
 #ifdef TORQUE_OS_IOS
 #include "platformiOS/iOSStreamSource.h"
 #endif
@@ -679,6 +683,15 @@ ConsoleFunction(alxGetStreamDuration, F32, 2, 2, "( handle ) Use the alxGetStrea
    return alxGetStreamDuration( handle );
 }
 
+//-----------------------------------------------
+ConsoleFunction(alxGetStreamUnderruns, S32, 1, 1, "() Use the alxGetStreamUnderruns function to get the number of times a playing stream ran out of queued audio.\n"
+                                                                "Streams are refilled on the audio thread unless $pref::Audio::threaded is false when the driver is initialized.\n"
+                                                                "@return Returns the number of underruns since the engine started.\n"
+                                                                "@sa alxGetStreamPosition")
+{
+   return AudioThread::getUnderrunCount();
+}
+
 #ifdef TORQUE_OS_IOS
 ConsoleFunction(startiOSAudioStream, S32, 2, 2,  "(audio-assetId) - Play the audio asset Id.\n"
                                                     "@param audio-assetId The asset Id to play.  This *must* be an MP3 to work correctly.\n"
@@ -51,6 +51,17 @@
 class AudioStreamSource
 {
     public:
+        /// Which thread refills the stream, see AudioThread.
+        enum ThreadState
+        {
+            ThreadDetached,
+            ThreadAttached,
+            ThreadRefilling,
+            ThreadReading,
+        };
+
+        AudioStreamSource() : mThreadState(ThreadDetached) {}
+
         //need this because subclasses are deleted through base pointer
         virtual ~AudioStreamSource() {}
         virtual bool initStream() = 0;
@@ -60,6 +71,8 @@ class AudioStreamSource
       virtual F32 getTotalTime() = 0;
         //void clear();
 
+        const char* getFilename() const { return mFilename; }
+
         AUDIOHANDLE             mHandle;
         ALuint				    mSource;
 
@@ -75,6 +88,8 @@ class AudioStreamSource
         bool					bFinishedPlaying;
         bool					bIsValid;
 
+        volatile U32            mThreadState;
+
 #ifdef TORQUE_OS_LINUX
                 void checkPosition();
 #endif
@@ -0,0 +1,422 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "audio/audioThread.h"
+#include "audio/audioStreamSource.h"
+#include "io/fileStream.h"
+#include "console/console.h"
+
+//-----------------------------------------------------------------------------
+
+AudioThread* AudioThread::smAudioThread = NULL;
+U32 AudioThread::smPendingLoads = 0;
+volatile U32 AudioThread::smUnderrunCount = 0;
+
+//-----------------------------------------------------------------------------
+
+AudioThread::AudioThread( const U32 updatePeriod ) :
+    Thread( 0, 0, false ),
+    mUpdatePeriod( updatePeriod ),
+    mLoadSemaphore( 0 ),
+    mLoadHead( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+bool AudioThread::startup( void )
+{
+    // Finish if already started.
+    if ( isRunning() )
+        return true;
+
+    if ( !Con::getBoolVariable( "$pref::Audio::threaded", true ) )
+        return false;
+
+    // Refill often enough that a stream never waits long for its processed buffers.
+    const U32 updatePeriod = (U32)mClamp( Con::getIntVariable( "$pref::Audio::threadUpdatePeriod", DefaultUpdatePeriod ), 1, 100 );
+
+    smAudioThread = new AudioThread( updatePeriod );
+    smAudioThread->start();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::shutdown( void )
+{
+    // Finish if not started.
+    if ( !isRunning() )
+        return;
+
+    AudioThread* pThread = smAudioThread;
+    pThread->stop();
+    pThread->join();
+
+    // Finish any commands the worker did not get to on this thread.
+    pThread->processCommands();
+
+    // Hand back loads that were never started.  Their buffers are read on demand instead.
+    AudioLoadRequest* pRequest;
+    while( (pRequest = pThread->popLoad()) != NULL )
+    {
+        dAtomicWrite( pRequest->mBuffer->mLoading, 0 );
+        delete pRequest;
+        --smPendingLoads;
+    }
+
+    pThread->releaseCompleted();
+
+    // Anything still attached goes back to the game thread.
+    for( S32 index = 0; index < pThread->mStreams.size(); ++index )
+        dAtomicWrite( pThread->mStreams[index]->mThreadState, AudioStreamSource::ThreadDetached );
+
+    smAudioThread = NULL;
+    delete pThread;
+
+    AssertFatal( smPendingLoads == 0, "AudioThread::shutdown() - Loads were not collected." );
+}
+
+//-----------------------------------------------------------------------------
+
+bool AudioThread::attachStream( AudioStreamSource* pStream )
+{
+    if ( !isRunning() || !pStream->bIsValid )
+        return false;
+
+    // Finish if already attached.
+    if ( dAtomicRead( pStream->mThreadState ) != AudioStreamSource::ThreadDetached )
+        return true;
+
+    // Only loose files are streamed in the background as zipped resources share their archive stream.
+    ResourceObject* pResource = ResourceManager->find( pStream->getFilename() );
+    if ( pResource == NULL || (pResource->flags & ResourceObject::File) == 0 )
+        return false;
+
+    // The worker may refill the stream as soon as it sees the command.
+    dAtomicWrite( pStream->mThreadState, AudioStreamSource::ThreadAttached );
+
+    Command command = { AttachStream, pStream, NULL };
+    smAudioThread->post( command );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::detachStream( AudioStreamSource* pStream )
+{
+    if ( dAtomicRead( pStream->mThreadState ) == AudioStreamSource::ThreadDetached )
+        return;
+
+    // Wait for a refill in progress to finish.
+    while( !dCompareAndSwap( pStream->mThreadState, AudioStreamSource::ThreadAttached, AudioStreamSource::ThreadDetached ) )
+        Platform::sleep( 0 );
+
+    if ( !isRunning() )
+        return;
+
+    Command command = { DetachStream, pStream, NULL };
+    smAudioThread->post( command );
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::deleteStream( AudioStreamSource* pStream )
+{
+    detachStream( pStream );
+
+    if ( !isRunning() )
+    {
+        delete pStream;
+        return;
+    }
+
+    Command command = { DeleteStream, pStream, NULL };
+    smAudioThread->post( command );
+}
+
+//-----------------------------------------------------------------------------
+
+bool AudioThread::isStreamPlaying( AudioStreamSource* pStream )
+{
+    // Only the game thread attaches and detaches streams so a detached one is not touched by the worker.
+    if ( dAtomicRead( pStream->mThreadState ) == AudioStreamSource::ThreadDetached )
+        return pStream->bIsValid && !pStream->bFinishedPlaying;
+
+    // Keep the worker off the stream while reading, waiting for a refill in progress to finish.
+    while( !dCompareAndSwap( pStream->mThreadState, AudioStreamSource::ThreadAttached, AudioStreamSource::ThreadReading ) )
+        Platform::sleep( 0 );
+
+    const bool playing = pStream->bIsValid && !pStream->bFinishedPlaying;
+
+    dAtomicWrite( pStream->mThreadState, AudioStreamSource::ThreadAttached );
+
+    return playing;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AudioThread::queueLoad( const Resource<AudioBuffer>& buffer )
+{
+    if ( !isRunning() )
+        return false;
+
+    // Only loose WAV files are read in the background.
+    const char* pFileName = buffer->mFilename;
+    const S32 length = dStrlen( pFileName );
+    if ( length < 4 || dStricmp( pFileName + length - 4, ".wav" ) != 0 )
+        return false;
+
+    ResourceObject* pResource = ResourceManager->find( pFileName );
+    if ( pResource == NULL || (pResource->flags & ResourceObject::File) == 0 )
+        return false;
+
+    AudioLoadRequest* pRequest = new AudioLoadRequest;
+    pRequest->mBuffer = buffer;
+    Platform::makeFullPathName( pResource->name, pRequest->mFilePath, sizeof(pRequest->mFilePath), pResource->path );
+
+    dAtomicWrite( pRequest->mBuffer->mLoading, 1 );
+    ++smPendingLoads;
+
+    Command command = { LoadBuffer, NULL, pRequest };
+    smAudioThread->post( command );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::processCompleted( void )
+{
+    if ( !isRunning() )
+        return;
+
+    smAudioThread->releaseCompleted();
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::finishLoads( void )
+{
+    while( isRunning() && smPendingLoads > 0 )
+    {
+        processCompleted();
+
+        if ( smPendingLoads > 0 )
+            Platform::sleep( 1 );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::waitForLoad( AudioBuffer* pBuffer )
+{
+    // Every finished load releases the semaphore, so wake up and check again until this one is among them.
+    while( isRunning() && pBuffer->isLoading() )
+        smAudioThread->mLoadSemaphore.acquire();
+}
+
+//-----------------------------------------------------------------------------
+
+bool AudioThread::refillStream( AudioStreamSource* pStream )
+{
+    if ( !pStream->bIsValid )
+        return false;
+
+    pStream->updateBuffers();
+
+    if ( pStream->bFinishedPlaying )
+        return false;
+
+    ALint state = AL_STOPPED;
+    alGetSourcei( pStream->mSource, AL_SOURCE_STATE, &state );
+    if ( state == AL_PLAYING || state == AL_PAUSED )
+        return false;
+
+    // Stopped with nothing left to play means the stream has reached its end.
+    ALint queued = 0;
+    ALint processed = 0;
+    alGetSourcei( pStream->mSource, AL_BUFFERS_QUEUED, &queued );
+    alGetSourcei( pStream->mSource, AL_BUFFERS_PROCESSED, &processed );
+    if ( queued <= processed )
+        return false;
+
+    // Streams start once their first buffers are queued.
+    alSourcePlay( pStream->mSource );
+
+    if ( state != AL_STOPPED )
+        return false;
+
+    // A stream that stopped with fresh buffers queued ran dry before it was refilled.
+    dFetchAndAdd( smUnderrunCount, 1 );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::run( void* arg )
+{
+    while( !checkForStop() )
+    {
+        processCommands();
+        refillStreams();
+
+        // Read one buffer per pass so that a long file cannot starve the streams.
+        AudioLoadRequest* pRequest = popLoad();
+        if ( pRequest != NULL )
+        {
+            load( pRequest );
+
+            mCompletedMutex.lock();
+            mCompleted.push_back( pRequest );
+            mCompletedMutex.unlock();
+
+            mLoadSemaphore.release();
+            continue;
+        }
+
+        Platform::sleep( mUpdatePeriod );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::post( const Command& command )
+{
+    // The worker drains the ring every pass so it is only ever full briefly.
+    while( !mCommands.push( command ) )
+        Platform::sleep( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::processCommands( void )
+{
+    Command command;
+    while( mCommands.pop( command ) )
+    {
+        switch( command.mType )
+        {
+        case AttachStream:
+            mStreams.push_back( command.mpStream );
+            break;
+
+        case DetachStream:
+            removeStream( command.mpStream );
+            break;
+
+        case DeleteStream:
+            removeStream( command.mpStream );
+            delete command.mpStream;
+            break;
+
+        case LoadBuffer:
+            mLoads.push_back( command.mpRequest );
+            break;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::removeStream( AudioStreamSource* pStream )
+{
+    for( S32 index = 0; index < mStreams.size(); ++index )
+    {
+        if ( mStreams[index] == pStream )
+        {
+            mStreams.erase_fast( index );
+            return;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::refillStreams( void )
+{
+    for( S32 index = 0; index < mStreams.size(); ++index )
+    {
+        AudioStreamSource* pStream = mStreams[index];
+
+        // Skip streams that the game thread has taken back.
+        if ( !dCompareAndSwap( pStream->mThreadState, AudioStreamSource::ThreadAttached, AudioStreamSource::ThreadRefilling ) )
+            continue;
+
+        refillStream( pStream );
+
+        dAtomicWrite( pStream->mThreadState, AudioStreamSource::ThreadAttached );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+AudioLoadRequest* AudioThread::popLoad( void )
+{
+    if ( mLoadHead >= (U32)mLoads.size() )
+        return NULL;
+
+    AudioLoadRequest* pRequest = mLoads[mLoadHead++];
+
+    // Reset the queue once drained so it does not grow.
+    if ( mLoadHead == (U32)mLoads.size() )
+    {
+        mLoads.clear();
+        mLoadHead = 0;
+    }
+
+    return pRequest;
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::load( AudioLoadRequest* pRequest )
+{
+    AudioBuffer* pBuffer = pRequest->mBuffer;
+
+    // A failed load leaves the buffer empty so that it is read again on demand.
+    FileStream stream;
+    if ( stream.open( pRequest->mFilePath, FileStream::Read ) )
+    {
+        pBuffer->loadWAV( stream );
+        stream.close();
+    }
+
+    dAtomicWrite( pBuffer->mLoading, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void AudioThread::releaseCompleted( void )
+{
+    // Buffer references are released on the game thread as the resource manager is not thread safe.
+    mCompletedMutex.lock();
+    for( S32 index = 0; index < mCompleted.size(); ++index )
+    {
+        delete mCompleted[index];
+        --smPendingLoads;
+    }
+    mCompleted.clear();
+    mCompletedMutex.unlock();
+}
@@ -0,0 +1,218 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _AUDIO_THREAD_H_
+#define _AUDIO_THREAD_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_ATOMIC_H_
+#include "platform/threads/atomic.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _AUDIOBUFFER_H_
+#include "audio/audioBuffer.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class AudioStreamSource;
+
+//-----------------------------------------------------------------------------
+
+/// Bounded single-producer/single-consumer ring.
+///
+/// One thread pushes and one other thread pops without either taking a lock.
+template<class T, U32 Capacity> class AudioRing
+{
+public:
+    AudioRing() : mHead( 0 ), mTail( 0 ) {}
+
+    bool push( const T& item );
+    bool pop( T& item );
+    inline U32 size( void ) { return dAtomicRead( mHead ) - dAtomicRead( mTail ); }
+
+private:
+    T               mItems[Capacity];
+    volatile U32    mHead;
+    volatile U32    mTail;
+};
+
+//-----------------------------------------------------------------------------
+
+/// A single background AudioBuffer load.
+///
+/// The game thread resolves the file and holds a reference to the buffer while the
+/// audio thread reads it.  The request is handed back to the game thread to be released.
+struct AudioLoadRequest
+{
+    AudioLoadRequest()
+    {
+        mFilePath[0] = 0;
+    }
+
+    Resource<AudioBuffer>   mBuffer;
+    char                    mFilePath[1024];
+};
+
+//-----------------------------------------------------------------------------
+
+/// Worker thread that owns streaming buffer refills and AudioBuffer loading.
+///
+/// The game thread talks to the worker through a lock-free command ring.  An attached
+/// stream is refilled only by the worker until the game thread detaches it again, which
+/// waits at most for the stream's own refill to finish.  Streams are deleted on the worker
+/// as it may still hold them until it reads the commands posted before the delete.
+/// Completed loads are collected on the game thread by processCompleted().
+class AudioThread : public Thread
+{
+public:
+    /// Start the worker if it is enabled by $pref::Audio::threaded.
+    static bool startup( void );
+    static void shutdown( void );
+    static inline bool isRunning( void ) { return smAudioThread != NULL; }
+
+    /// Hand a stream to the worker.  Returns false if the stream must be refilled on the game thread.
+    static bool attachStream( AudioStreamSource* pStream );
+    static void detachStream( AudioStreamSource* pStream );
+    static void deleteStream( AudioStreamSource* pStream );
+
+    /// Returns true if a stream is valid and has not finished, without racing a refill on the worker.
+    static bool isStreamPlaying( AudioStreamSource* pStream );
+
+    /// Queue a buffer to be read on the worker.  Returns false if it must be read on the game thread.
+    static bool queueLoad( const Resource<AudioBuffer>& buffer );
+    static void processCompleted( void );
+    static void finishLoads( void );
+
+    /// Block until the worker has finished reading a buffer.
+    static void waitForLoad( AudioBuffer* pBuffer );
+    static inline U32 getPendingLoadCount( void ) { return smPendingLoads; }
+
+    /// Refill a stream and restart it if it ran dry.  Returns true if the stream underran.
+    static bool refillStream( AudioStreamSource* pStream );
+    static inline U32 getUnderrunCount( void ) { return dAtomicRead( smUnderrunCount ); }
+
+private:
+    enum CommandType
+    {
+        AttachStream,
+        DetachStream,
+        DeleteStream,
+        LoadBuffer,
+    };
+
+    struct Command
+    {
+        CommandType         mType;
+        AudioStreamSource*  mpStream;
+        AudioLoadRequest*   mpRequest;
+    };
+
+    enum
+    {
+        CommandCapacity = 256,
+        DefaultUpdatePeriod = 10,
+    };
+
+    AudioThread( const U32 updatePeriod );
+
+    virtual void run( void* arg = 0 );
+
+    void post( const Command& command );
+    void processCommands( void );
+    void removeStream( AudioStreamSource* pStream );
+    void refillStreams( void );
+    AudioLoadRequest* popLoad( void );
+    static void load( AudioLoadRequest* pRequest );
+    void releaseCompleted( void );
+
+private:
+    static AudioThread*                 smAudioThread;
+    static U32                          smPendingLoads;
+    static volatile U32                 smUnderrunCount;
+
+    U32                                 mUpdatePeriod;
+
+    AudioRing<Command, CommandCapacity> mCommands;
+
+    Mutex                               mCompletedMutex;
+    Vector<AudioLoadRequest*>           mCompleted;
+
+    /// Released once for every load the worker finishes.
+    Semaphore                           mLoadSemaphore;
+
+    /// Worker only.
+    Vector<AudioStreamSource*>          mStreams;
+    Vector<AudioLoadRequest*>           mLoads;
+    U32                                 mLoadHead;
+};
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 Capacity> inline bool AudioRing<T, Capacity>::push( const T& item )
+{
+    const U32 head = mHead;
+    if ( head - dAtomicRead( mTail ) == Capacity )
+        return false;
+
+    mItems[head % Capacity] = item;
+
+    // Publish to the consumer.
+    dAtomicWrite( mHead, head + 1 );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 Capacity> inline bool AudioRing<T, Capacity>::pop( T& item )
+{
+    const U32 tail = mTail;
+    if ( dAtomicRead( mHead ) == tail )
+        return false;
+
+    item = mItems[tail % Capacity];
+
+    // Hand the slot back to the producer.
+    dAtomicWrite( mTail, tail + 1 );
+    return true;
+}
+
+#endif // _AUDIO_THREAD_H_
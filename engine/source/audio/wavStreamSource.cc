@@ -158,9 +158,8 @@ bool WavStreamSource::initStream() {
 
    bFinished = false;
 
-   char   data[BUFFERSIZE];
-
-   alSourceStop(mSource);
+   // rewind rather than stop so the source reports AL_INITIAL until it first plays
+   alSourceRewind(mSource);
    alSourcei(mSource, AL_BUFFER, 0);
 
     stream = ResourceManager->openStream(mFilename);
@@ -202,31 +201,9 @@ bool WavStreamSource::initStream() {
 
         bBuffersAllocated = true;
 
-        int numBuffers = 0;
-        for(int loop = 0; loop < NUMBUFFERS; loop++)
-        {
-            ALuint DataToRead = (DataLeft > BUFFERSIZE) ? BUFFERSIZE : DataLeft;
-
-            if (DataToRead == DataLeft)
-                bFinished = AL_TRUE;
-            stream->read(DataToRead, data);
-            DataLeft -= DataToRead;
-            alBufferData(mBufferList[loop], format, data, DataToRead, freq);	
-            if ((error = alGetError()) != AL_NO_ERROR) {
-                return false;
-            }
-            ++numBuffers;
-            if(bFinished)
-                break;
-        }
-
-        // Queue the buffers on the source
-        alSourceQueueBuffers(mSource, numBuffers, mBufferList);
-        if ((error = alGetError()) != AL_NO_ERROR) {
-            return false;
-        }
-
-        buffersinqueue = numBuffers;
+        // The buffers are filled and queued by updateBuffers() so that opening
+        // a stream does not read any audio.
+        buffersinqueue = 0;
         alSourcei(mSource, AL_LOOPING, AL_FALSE);
         bReady = true;
     }
@@ -243,8 +220,6 @@ bool WavStreamSource::updateBuffers() {
 
     ALint			processed;
     ALuint			BufferID;
-    ALint			error;
-    char data[BUFFERSIZE];
 
     // don't do anything if buffer isn't initialized
     if(!bIsValid)
@@ -254,8 +229,17 @@ bool WavStreamSource::updateBuffers() {
         resetStream();
     }
 
-    // reset AL error code
-    alGetError();
+    // Refills can run on the audio thread, so results are checked directly instead of
+    // with alGetError() whose state is shared with the game thread.
+
+    // Queue the buffers that have not been used yet
+    while (!bFinished && buffersinqueue < NUMBUFFERS)
+    {
+        if (!queueBuffer(mBufferList[buffersinqueue]))
+            return false;
+
+        buffersinqueue++;
+    }
 
     // Get status
     alGetSourcei(mSource, AL_BUFFERS_PROCESSED, &processed);
@@ -266,35 +250,17 @@ bool WavStreamSource::updateBuffers() {
 
         while (processed)
         {
+            BufferID = 0;
             alSourceUnqueueBuffers(mSource, 1, &BufferID);
-            if ((error = alGetError()) != AL_NO_ERROR)
+            if (BufferID == 0)
                 return false;
 
             if (!bFinished)
             {
-                ALuint DataToRead = (DataLeft > BUFFERSIZE) ? BUFFERSIZE : DataLeft;
-
-                if (DataToRead == DataLeft) {
-                    bFinished = AL_TRUE;
-                }
-                    
-                stream->read(DataToRead, data);
-                DataLeft -= DataToRead;
-                    
-                alBufferData(BufferID, format, data, DataToRead, freq);
-                if ((error = alGetError()) != AL_NO_ERROR)
-                    return false;
-
-                // Queue buffer
-                alSourceQueueBuffers(mSource, 1, &BufferID);
-                if ((error = alGetError()) != AL_NO_ERROR)
+                if (!queueBuffer(BufferID))
                     return false;
 
                 processed--;
-
-                if(bFinished && mDescription.mIsLooping) {
-                    resetStream();
-                }
             }
             else
             {
@@ -313,8 +279,44 @@ bool WavStreamSource::updateBuffers() {
     return AL_TRUE;
 }
 
+bool WavStreamSource::queueBuffer(ALuint BufferID) {
+    char data[BUFFERSIZE];
+
+    ALuint DataToRead = (DataLeft > BUFFERSIZE) ? BUFFERSIZE : DataLeft;
+
+    if (DataToRead == DataLeft) {
+        bFinished = AL_TRUE;
+    }
+
+    stream->read(DataToRead, data);
+    DataLeft -= DataToRead;
+
+    alBufferData(BufferID, format, data, DataToRead, freq);
+
+    ALint size = -1;
+    alGetBufferi(BufferID, AL_SIZE, &size);
+    if (size != (ALint)DataToRead)
+        return false;
+
+    // Queue buffer
+    ALint queued = 0;
+    ALint queuedAfter = 0;
+    alGetSourcei(mSource, AL_BUFFERS_QUEUED, &queued);
+    alSourceQueueBuffers(mSource, 1, &BufferID);
+    alGetSourcei(mSource, AL_BUFFERS_QUEUED, &queuedAfter);
+    if (queuedAfter != queued + 1)
+        return false;
+
+    if(bFinished && mDescription.mIsLooping) {
+        resetStream();
+    }
+
+    return true;
+}
+
 void WavStreamSource::freeStream() {
     bReady = false;
+    bIsValid = false;
 
     
     if(stream != NULL)
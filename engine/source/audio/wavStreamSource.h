@@ -61,6 +61,7 @@ class WavStreamSource: public AudioStreamSource
 
         void clear();
         void resetStream();
+        bool queueBuffer(ALuint BufferID);
 };
 
 #endif // _AUDIOSTREAMSOURCE_H_
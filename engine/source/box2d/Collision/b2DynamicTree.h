@@ -125,6 +125,8 @@ public:
 
 private:
 
+	friend class b2World;
+
 	int32 AllocateNode();
 	void FreeNode(int32 node);
 
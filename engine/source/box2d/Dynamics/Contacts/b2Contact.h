@@ -146,6 +146,7 @@ public:
 
 protected:
 	friend class b2ContactManager;
+	friend class b2ContactUpdateTask;
 	friend class b2World;
 	friend class b2ContactSolver;
 	friend class b2Body;
@@ -189,6 +190,14 @@ protected:
 
 	void Update(b2ContactListener* listener);
 
+	// Update the manifold and return whether the shapes are touching. This only
+	// changes the contact so it may be called concurrently for different contacts.
+	bool UpdateManifold(b2Manifold* oldManifold);
+
+	// Finish an update by waking the bodies, setting the touching flag and
+	// calling the listener.
+	void FinishUpdate(b2ContactListener* listener, const b2Manifold* oldManifold, bool touching);
+
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
 
@@ -217,6 +226,9 @@ protected:
 	float32 m_restitution;
 
 	float32 m_tangentSpeed;
+
+	// Creation order, used to match contacts when restoring a world snapshot.
+	uint32 m_serial;
 };
 
 inline b2Manifold* b2Contact::GetManifold()
@@ -110,6 +110,9 @@ protected:
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
 
+	void GetSolverState(float32* state) const;
+	void SetSolverState(const float32* state);
+
 	float32 m_frequencyHz;
 	float32 m_dampingRatio;
 	float32 m_bias;
@@ -122,10 +122,16 @@ void b2FrictionJoint::InitVelocityConstraints(const b2SolverData& data)
 		m_angularImpulse = 0.0f;
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 void b2FrictionJoint::SolveVelocityConstraints(const b2SolverData& data)
@@ -179,10 +185,16 @@ void b2FrictionJoint::SolveVelocityConstraints(const b2SolverData& data)
 		wB += iB * b2Cross(m_rB, impulse);
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 bool b2FrictionJoint::SolvePositionConstraints(const b2SolverData& data)
@@ -212,6 +224,20 @@ float32 b2FrictionJoint::GetReactionTorque(float32 inv_dt) const
 	return inv_dt * m_angularImpulse;
 }
 
+void b2FrictionJoint::GetSolverState(float32* state) const
+{
+	state[0] = m_linearImpulse.x;
+	state[1] = m_linearImpulse.y;
+	state[2] = m_angularImpulse;
+}
+
+void b2FrictionJoint::SetSolverState(const float32* state)
+{
+	m_linearImpulse.x = state[0];
+	m_linearImpulse.y = state[1];
+	m_angularImpulse = state[2];
+}
+
 void b2FrictionJoint::SetMaxForce(float32 force)
 {
 	b2Assert(b2IsValid(force) && force >= 0.0f);
@@ -92,6 +92,9 @@ protected:
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
 
+	void GetSolverState(float32* state) const;
+	void SetSolverState(const float32* state);
+
 	b2Vec2 m_localAnchorA;
 	b2Vec2 m_localAnchorB;
 
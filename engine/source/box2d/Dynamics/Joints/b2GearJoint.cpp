@@ -222,14 +222,26 @@ void b2GearJoint::InitVelocityConstraints(const b2SolverData& data)
 		m_impulse = 0.0f;
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
-	data.velocities[m_indexC].v = vC;
-	data.velocities[m_indexC].w = wC;
-	data.velocities[m_indexD].v = vD;
-	data.velocities[m_indexD].w = wD;
+	if (m_mA != 0.0f || m_iA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_mB != 0.0f || m_iB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
+	if (m_mC != 0.0f || m_iC != 0.0f)
+	{
+		data.velocities[m_indexC].v = vC;
+		data.velocities[m_indexC].w = wC;
+	}
+	if (m_mD != 0.0f || m_iD != 0.0f)
+	{
+		data.velocities[m_indexD].v = vD;
+		data.velocities[m_indexD].w = wD;
+	}
 }
 
 void b2GearJoint::SolveVelocityConstraints(const b2SolverData& data)
@@ -258,14 +270,26 @@ void b2GearJoint::SolveVelocityConstraints(const b2SolverData& data)
 	vD -= (m_mD * impulse) * m_JvBD;
 	wD -= m_iD * impulse * m_JwD;
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
-	data.velocities[m_indexC].v = vC;
-	data.velocities[m_indexC].w = wC;
-	data.velocities[m_indexD].v = vD;
-	data.velocities[m_indexD].w = wD;
+	if (m_mA != 0.0f || m_iA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_mB != 0.0f || m_iB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
+	if (m_mC != 0.0f || m_iC != 0.0f)
+	{
+		data.velocities[m_indexC].v = vC;
+		data.velocities[m_indexC].w = wC;
+	}
+	if (m_mD != 0.0f || m_iD != 0.0f)
+	{
+		data.velocities[m_indexD].v = vD;
+		data.velocities[m_indexD].w = wD;
+	}
 }
 
 bool b2GearJoint::SolvePositionConstraints(const b2SolverData& data)
@@ -354,14 +378,26 @@ bool b2GearJoint::SolvePositionConstraints(const b2SolverData& data)
 	cD -= m_mD * impulse * JvBD;
 	aD -= m_iD * impulse * JwD;
 
-	data.positions[m_indexA].c = cA;
-	data.positions[m_indexA].a = aA;
-	data.positions[m_indexB].c = cB;
-	data.positions[m_indexB].a = aB;
-	data.positions[m_indexC].c = cC;
-	data.positions[m_indexC].a = aC;
-	data.positions[m_indexD].c = cD;
-	data.positions[m_indexD].a = aD;
+	if (m_mA != 0.0f || m_iA != 0.0f)
+	{
+		data.positions[m_indexA].c = cA;
+		data.positions[m_indexA].a = aA;
+	}
+	if (m_mB != 0.0f || m_iB != 0.0f)
+	{
+		data.positions[m_indexB].c = cB;
+		data.positions[m_indexB].a = aB;
+	}
+	if (m_mC != 0.0f || m_iC != 0.0f)
+	{
+		data.positions[m_indexC].c = cC;
+		data.positions[m_indexC].a = aC;
+	}
+	if (m_mD != 0.0f || m_iD != 0.0f)
+	{
+		data.positions[m_indexD].c = cD;
+		data.positions[m_indexD].a = aD;
+	}
 
 	// TODO_ERIN not implemented
 	return linearError < b2_linearSlop;
@@ -389,6 +425,16 @@ float32 b2GearJoint::GetReactionTorque(float32 inv_dt) const
 	return inv_dt * L;
 }
 
+void b2GearJoint::GetSolverState(float32* state) const
+{
+	state[0] = m_impulse;
+}
+
+void b2GearJoint::SetSolverState(const float32* state)
+{
+	m_impulse = state[0];
+}
+
 void b2GearJoint::SetRatio(float32 ratio)
 {
 	b2Assert(b2IsValid(ratio));
@@ -84,6 +84,9 @@ protected:
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
 
+	void GetSolverState(float32* state) const;
+	void SetSolverState(const float32* state);
+
 	b2Joint* m_joint1;
 	b2Joint* m_joint2;
 
@@ -42,6 +42,9 @@ enum b2JointType
 	e_motorJoint
 };
 
+/// The number of values a joint keeps between steps. See b2Joint::GetSolverState.
+#define b2_maxJointSolverState	5
+
 enum b2LimitState
 {
 	e_inactiveLimit,
@@ -165,8 +168,15 @@ protected:
 	virtual void SolveVelocityConstraints(const b2SolverData& data) = 0;
 
 	// This returns true if the position errors are within tolerance.
+	// Solvers must not write back the state of a body with zero inverse mass and
+	// inertia as static bodies may be shared with islands solved concurrently.
 	virtual bool SolvePositionConstraints(const b2SolverData& data) = 0;
 
+	// Get or set the accumulated impulses and limit state that carry over between
+	// steps. This uses at most b2_maxJointSolverState values.
+	virtual void GetSolverState(float32* state) const { B2_NOT_USED(state); }
+	virtual void SetSolverState(const float32* state) { B2_NOT_USED(state); }
+
 	b2JointType m_type;
 	b2Joint* m_prev;
 	b2Joint* m_next;
@@ -101,6 +101,9 @@ protected:
 	void SolveVelocityConstraints(const b2SolverData& data);
 	bool SolvePositionConstraints(const b2SolverData& data);
 
+	void GetSolverState(float32* state) const;
+	void SetSolverState(const float32* state);
+
 	// Solver shared
 	b2Vec2 m_linearOffset;
 	float32 m_angularOffset;
@@ -216,6 +216,18 @@ float32 b2MouseJoint::GetReactionTorque(float32 inv_dt) const
 	return inv_dt * 0.0f;
 }
 
+void b2MouseJoint::GetSolverState(float32* state) const
+{
+	state[0] = m_impulse.x;
+	state[1] = m_impulse.y;
+}
+
+void b2MouseJoint::SetSolverState(const float32* state)
+{
+	m_impulse.x = state[0];
+	m_impulse.y = state[1];
+}
+
 void b2MouseJoint::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	m_targetA -= newOrigin;
@@ -154,10 +154,16 @@ void b2PulleyJoint::InitVelocityConstraints(const b2SolverData& data)
 		m_impulse = 0.0f;
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 void b2PulleyJoint::SolveVelocityConstraints(const b2SolverData& data)
@@ -181,10 +187,16 @@ void b2PulleyJoint::SolveVelocityConstraints(const b2SolverData& data)
 	vB += m_invMassB * PB;
 	wB += m_invIB * b2Cross(m_rB, PB);
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 bool b2PulleyJoint::SolvePositionConstraints(const b2SolverData& data)
@@ -251,10 +263,16 @@ bool b2PulleyJoint::SolvePositionConstraints(const b2SolverData& data)
 	cB += m_invMassB * PB;
 	aB += m_invIB * b2Cross(rB, PB);
 
-	data.positions[m_indexA].c = cA;
-	data.positions[m_indexA].a = aA;
-	data.positions[m_indexB].c = cB;
-	data.positions[m_indexB].a = aB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.positions[m_indexA].c = cA;
+		data.positions[m_indexA].a = aA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.positions[m_indexB].c = cB;
+		data.positions[m_indexB].a = aB;
+	}
 
 	return linearError < b2_linearSlop;
 }
@@ -281,6 +299,16 @@ float32 b2PulleyJoint::GetReactionTorque(float32 inv_dt) const
 	return 0.0f;
 }
 
+void b2PulleyJoint::GetSolverState(float32* state) const
+{
+	state[0] = m_impulse;
+}
+
+void b2PulleyJoint::SetSolverState(const float32* state)
+{
+	m_impulse = state[0];
+}
+
 b2Vec2 b2PulleyJoint::GetGroundAnchorA() const
 {
 	return m_groundAnchorA;
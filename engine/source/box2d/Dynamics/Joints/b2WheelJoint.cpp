@@ -207,10 +207,16 @@ void b2WheelJoint::InitVelocityConstraints(const b2SolverData& data)
 		m_motorImpulse = 0.0f;
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 void b2WheelJoint::SolveVelocityConstraints(const b2SolverData& data)
@@ -271,10 +277,16 @@ void b2WheelJoint::SolveVelocityConstraints(const b2SolverData& data)
 		wB += iB * LB;
 	}
 
-	data.velocities[m_indexA].v = vA;
-	data.velocities[m_indexA].w = wA;
-	data.velocities[m_indexB].v = vB;
-	data.velocities[m_indexB].w = wB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.velocities[m_indexA].v = vA;
+		data.velocities[m_indexA].w = wA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.velocities[m_indexB].v = vB;
+		data.velocities[m_indexB].w = wB;
+	}
 }
 
 bool b2WheelJoint::SolvePositionConstraints(const b2SolverData& data)
@@ -318,10 +330,16 @@ bool b2WheelJoint::SolvePositionConstraints(const b2SolverData& data)
 	cB += m_invMassB * P;
 	aB += m_invIB * LB;
 
-	data.positions[m_indexA].c = cA;
-	data.positions[m_indexA].a = aA;
-	data.positions[m_indexB].c = cB;
-	data.positions[m_indexB].a = aB;
+	if (m_invMassA != 0.0f || m_invIA != 0.0f)
+	{
+		data.positions[m_indexA].c = cA;
+		data.positions[m_indexA].a = aA;
+	}
+	if (m_invMassB != 0.0f || m_invIB != 0.0f)
+	{
+		data.positions[m_indexB].c = cB;
+		data.positions[m_indexB].a = aB;
+	}
 
 	return b2Abs(C) <= b2_linearSlop;
 }
@@ -346,6 +364,20 @@ float32 b2WheelJoint::GetReactionTorque(float32 inv_dt) const
 	return inv_dt * m_motorImpulse;
 }
 
+void b2WheelJoint::GetSolverState(float32* state) const
+{
+	state[0] = m_impulse;
+	state[1] = m_motorImpulse;
+	state[2] = m_springImpulse;
+}
+
+void b2WheelJoint::SetSolverState(const float32* state)
+{
+	m_impulse = state[0];
+	m_motorImpulse = state[1];
+	m_springImpulse = state[2];
+}
+
 float32 b2WheelJoint::GetJointTranslation() const
 {
 	b2Body* bA = m_bodyA;
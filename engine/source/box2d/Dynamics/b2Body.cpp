@@ -110,6 +110,33 @@ b2Body::~b2Body()
 	// shapes and joints are destroyed in b2World::Destroy
 }
 
+void b2Body::SetAwake(bool flag)
+{
+	if (flag)
+	{
+		if ((m_flags & e_awakeFlag) == 0)
+		{
+			m_flags |= e_awakeFlag;
+			m_sleepTime = 0.0f;
+			++m_world->m_awakeBodyCount;
+		}
+	}
+	else
+	{
+		if (m_flags & e_awakeFlag)
+		{
+			--m_world->m_awakeBodyCount;
+		}
+
+		m_flags &= ~e_awakeFlag;
+		m_sleepTime = 0.0f;
+		m_linearVelocity.SetZero();
+		m_angularVelocity = 0.0f;
+		m_force.SetZero();
+		m_torque = 0.0f;
+	}
+}
+
 void b2Body::SetType(b2BodyType type)
 {
 	b2Assert(m_world->IsLocked() == false);
@@ -123,6 +150,8 @@ void b2Body::SetType(b2BodyType type)
 		return;
 	}
 
+	++m_world->m_structureRevision;
+
 	m_type = type;
 
 	ResetMassData();
@@ -186,6 +215,7 @@ b2Fixture* b2Body::CreateFixture(const b2FixtureDef* def)
 	fixture->m_next = m_fixtureList;
 	m_fixtureList = fixture;
 	++m_fixtureCount;
+	++m_world->m_structureRevision;
 
 	fixture->m_body = this;
 
@@ -273,6 +303,7 @@ void b2Body::DestroyFixture(b2Fixture* fixture)
 	allocator->Free(fixture, sizeof(b2Fixture));
 
 	--m_fixtureCount;
+	++m_world->m_structureRevision;
 
 	// Reset the mass data.
 	ResetMassData();
@@ -462,6 +493,8 @@ void b2Body::SetActive(bool flag)
 		return;
 	}
 
+	++m_world->m_structureRevision;
+
 	if (flag)
 	{
 		m_flags |= e_activeFlag;
@@ -21,6 +21,7 @@
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 #include <Box2D/Dynamics/Contacts/b2Contact.h>
+#include <Box2D/Common/b2StackAllocator.h>
 
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
@@ -29,6 +30,7 @@ b2ContactManager::b2ContactManager()
 {
 	m_contactList = NULL;
 	m_contactCount = 0;
+	m_contactSerial = 0;
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
@@ -36,16 +38,19 @@ b2ContactManager::b2ContactManager()
 
 void b2ContactManager::Destroy(b2Contact* c)
 {
-	b2Fixture* fixtureA = c->GetFixtureA();
-	b2Fixture* fixtureB = c->GetFixtureB();
-	b2Body* bodyA = fixtureA->GetBody();
-	b2Body* bodyB = fixtureB->GetBody();
-
 	if (m_contactListener && c->IsTouching())
 	{
 		m_contactListener->EndContact(c);
 	}
 
+	Remove(c);
+}
+
+void b2ContactManager::Remove(b2Contact* c)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
+
 	// Remove from the world.
 	if (c->m_prev)
 	{
@@ -102,71 +107,151 @@ void b2ContactManager::Destroy(b2Contact* c)
 // This is the top level collision call for the time step. Here
 // all the narrow phase collision is processed for the world
 // contact list.
+// Filter the contact and destroy it if it should no longer exist.
+// Returns true if the contact persists and needs an update.
+bool b2ContactManager::PrepareUpdate(b2Contact* c)
+{
+	b2Fixture* fixtureA = c->GetFixtureA();
+	b2Fixture* fixtureB = c->GetFixtureB();
+	int32 indexA = c->GetChildIndexA();
+	int32 indexB = c->GetChildIndexB();
+	b2Body* bodyA = fixtureA->GetBody();
+	b2Body* bodyB = fixtureB->GetBody();
+	 
+	// Is this contact flagged for filtering?
+	if (c->m_flags & b2Contact::e_filterFlag)
+	{
+		// Should these bodies collide?
+		if (bodyB->ShouldCollide(bodyA) == false)
+		{
+			Destroy(c);
+			return false;
+		}
+
+		// Check user filtering.
+		if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+		{
+			Destroy(c);
+			return false;
+		}
+
+		// Clear the filtering flag.
+		c->m_flags &= ~b2Contact::e_filterFlag;
+	}
+
+	bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+	bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+	// At least one body must be awake and it must be dynamic or kinematic.
+	if (activeA == false && activeB == false)
+	{
+		return false;
+	}
+
+	int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+	int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+	bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+
+	// Here we destroy contacts that cease to overlap in the broad-phase.
+	if (overlap == false)
+	{
+		Destroy(c);
+		return false;
+	}
+
+	// The contact persists.
+	return true;
+}
+
 void b2ContactManager::Collide()
 {
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
 	{
-		b2Fixture* fixtureA = c->GetFixtureA();
-		b2Fixture* fixtureB = c->GetFixtureB();
-		int32 indexA = c->GetChildIndexA();
-		int32 indexB = c->GetChildIndexB();
-		b2Body* bodyA = fixtureA->GetBody();
-		b2Body* bodyB = fixtureB->GetBody();
-		 
-		// Is this contact flagged for filtering?
-		if (c->m_flags & b2Contact::e_filterFlag)
+		b2Contact* next = c->GetNext();
+
+		if (PrepareUpdate(c))
 		{
-			// Should these bodies collide?
-			if (bodyB->ShouldCollide(bodyA) == false)
-			{
-				b2Contact* cNuke = c;
-				c = cNuke->GetNext();
-				Destroy(cNuke);
-				continue;
-			}
+			c->Update(m_contactListener);
+		}
+
+		c = next;
+	}
+}
 
-			// Check user filtering.
-			if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+// Updates the manifolds of solid contacts. Sensors are updated afterwards
+// as their overlap test uses shared distance statistics.
+class b2ContactUpdateTask : public b2Task
+{
+public:
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		B2_NOT_USED(threadIndex);
+
+		for (int32 i = begin; i < end; ++i)
+		{
+			b2Contact* c = contacts[i];
+			if (c->GetFixtureA()->IsSensor() || c->GetFixtureB()->IsSensor())
 			{
-				b2Contact* cNuke = c;
-				c = cNuke->GetNext();
-				Destroy(cNuke);
 				continue;
 			}
 
-			// Clear the filtering flag.
-			c->m_flags &= ~b2Contact::e_filterFlag;
+			touching[i] = c->UpdateManifold(oldManifolds + i);
 		}
+	}
+
+	b2Contact** contacts;
+	b2Manifold* oldManifolds;
+	bool* touching;
+};
 
-		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
-		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+void b2ContactManager::CollideParallel(b2TaskExecutor* executor, b2StackAllocator* allocator)
+{
+	// Gather the awake contacts that persist.
+	b2Contact** contacts = (b2Contact**)allocator->Allocate(m_contactCount * sizeof(b2Contact*));
+	int32 count = 0;
 
-		// At least one body must be awake and it must be dynamic or kinematic.
-		if (activeA == false && activeB == false)
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		b2Contact* next = c->GetNext();
+
+		if (PrepareUpdate(c))
 		{
-			c = c->GetNext();
-			continue;
+			contacts[count++] = c;
 		}
 
-		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
-		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
-		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+		c = next;
+	}
+
+	// Update the manifolds.
+	b2Manifold* oldManifolds = (b2Manifold*)allocator->Allocate(count * sizeof(b2Manifold));
+	bool* touching = (bool*)allocator->Allocate(count * sizeof(bool));
 
-		// Here we destroy contacts that cease to overlap in the broad-phase.
-		if (overlap == false)
+	b2ContactUpdateTask task;
+	task.contacts = contacts;
+	task.oldManifolds = oldManifolds;
+	task.touching = touching;
+	executor->ParallelFor(&task, count, 64);
+
+	// Finish the updates in list order.
+	for (int32 i = 0; i < count; ++i)
+	{
+		c = contacts[i];
+		if (c->GetFixtureA()->IsSensor() || c->GetFixtureB()->IsSensor())
 		{
-			b2Contact* cNuke = c;
-			c = cNuke->GetNext();
-			Destroy(cNuke);
-			continue;
+			c->Update(m_contactListener);
+		}
+		else
+		{
+			c->FinishUpdate(m_contactListener, oldManifolds + i, touching[i]);
 		}
-
-		// The contact persists.
-		c->Update(m_contactListener);
-		c = c->GetNext();
 	}
+
+	allocator->Free(touching);
+	allocator->Free(oldManifolds);
+	allocator->Free(contacts);
 }
 
 void b2ContactManager::FindNewContacts()
@@ -250,6 +335,22 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	bodyA = fixtureA->GetBody();
 	bodyB = fixtureB->GetBody();
 
+	c->m_serial = m_contactSerial++;
+	Insert(c);
+
+	// Wake up the bodies
+	if (fixtureA->IsSensor() == false && fixtureB->IsSensor() == false)
+	{
+		bodyA->SetAwake(true);
+		bodyB->SetAwake(true);
+	}
+}
+
+void b2ContactManager::Insert(b2Contact* c)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
+
 	// Insert into the world.
 	c->m_prev = NULL;
 	c->m_next = m_contactList;
@@ -285,12 +386,70 @@ void b2ContactManager::AddPair(void* proxyUserDataA, void* proxyUserDataB)
 	}
 	bodyB->m_contactList = &c->m_nodeB;
 
-	// Wake up the bodies
-	if (fixtureA->IsSensor() == false && fixtureB->IsSensor() == false)
+	++m_contactCount;
+}
+
+// Link an edge into a body contact list, which is in descending creation order.
+void b2ContactManager::InsertEdge(b2Body* body, b2ContactEdge* edge)
+{
+	uint32 serial = edge->contact->m_serial;
+
+	b2ContactEdge* prev = NULL;
+	b2ContactEdge* next = body->m_contactList;
+	while (next && next->contact->m_serial > serial)
 	{
-		bodyA->SetAwake(true);
-		bodyB->SetAwake(true);
+		prev = next;
+		next = next->next;
+	}
+
+	edge->prev = prev;
+	edge->next = next;
+
+	if (next)
+	{
+		next->prev = edge;
+	}
+
+	if (prev)
+	{
+		prev->next = edge;
+	}
+	else
+	{
+		body->m_contactList = edge;
 	}
+}
+
+void b2ContactManager::InsertAfter(b2Contact* c, b2Contact* prev)
+{
+	b2Body* bodyA = c->GetFixtureA()->GetBody();
+	b2Body* bodyB = c->GetFixtureB()->GetBody();
+
+	// Insert into the world.
+	c->m_prev = prev;
+	c->m_next = prev ? prev->m_next : m_contactList;
+	if (c->m_next)
+	{
+		c->m_next->m_prev = c;
+	}
+
+	if (prev)
+	{
+		prev->m_next = c;
+	}
+	else
+	{
+		m_contactList = c;
+	}
+
+	// Connect to the bodies.
+	c->m_nodeA.contact = c;
+	c->m_nodeA.other = bodyB;
+	InsertEdge(bodyA, &c->m_nodeA);
+
+	c->m_nodeB.contact = c;
+	c->m_nodeB.other = bodyA;
+	InsertEdge(bodyB, &c->m_nodeB);
 
 	++m_contactCount;
 }
@@ -22,9 +22,13 @@
 #include <Box2D/Collision/b2BroadPhase.h>
 
 class b2Contact;
+class b2Body;
 class b2ContactFilter;
+struct b2ContactEdge;
 class b2ContactListener;
 class b2BlockAllocator;
+class b2StackAllocator;
+class b2TaskExecutor;
 
 // Delegate of b2World.
 class b2ContactManager
@@ -39,11 +43,28 @@ public:
 
 	void Destroy(b2Contact* c);
 
+	// Link a contact into the world and body lists, or unlink and free it, without
+	// calling the listener or waking the bodies.
+	void Insert(b2Contact* c);
+	void Remove(b2Contact* c);
+
+	// Link a contact after prev in the world list, or at the head if prev is NULL.
+	// It is placed in the body lists by its creation serial.
+	void InsertAfter(b2Contact* c, b2Contact* prev);
+	void InsertEdge(b2Body* body, b2ContactEdge* edge);
+
 	void Collide();
+
+	// Collide with the contact manifolds updated on the task executor. Filtering,
+	// destruction and listener callbacks stay on the calling thread in list order.
+	void CollideParallel(b2TaskExecutor* executor, b2StackAllocator* allocator);
+
+	bool PrepareUpdate(b2Contact* c);
             
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
+	uint32 m_contactSerial;
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
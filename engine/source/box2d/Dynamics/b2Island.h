@@ -28,6 +28,7 @@ class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
 struct b2ContactVelocityConstraint;
+struct b2ContactImpulse;
 struct b2Profile;
 
 /// This is an internal class.
@@ -36,6 +37,15 @@ class b2Island
 public:
 	b2Island(int32 bodyCapacity, int32 contactCapacity, int32 jointCapacity,
 			b2StackAllocator* allocator, b2ContactListener* listener);
+
+	/// Construct an island over bodies, contacts and joints gathered by the world. The
+	/// body state is shared with other islands solved at the same time and is indexed by
+	/// each body's island index. Static bodies may appear in several islands so their state
+	/// is never written back and sleeping is left to the world. Contact impulses are
+	/// written to the impulse array instead of being reported.
+	b2Island(b2Body** bodies, int32 bodyCount, b2Contact** contacts, int32 contactCount,
+			b2Joint** joints, int32 jointCount, b2Position* positions, b2Velocity* velocities,
+			b2StackAllocator* allocator, b2ContactImpulse* impulses);
 	~b2Island();
 
 	void Clear()
@@ -73,6 +83,10 @@ public:
 
 	b2StackAllocator* m_allocator;
 	b2ContactListener* m_listener;
+	b2ContactImpulse* m_impulses;
+
+	bool m_sharedState;
+	bool m_sleepRequested;
 
 	b2Body** m_bodies;
 	b2Contact** m_contacts;
@@ -17,6 +17,7 @@
 */
 
 #include <Box2D/Dynamics/b2World.h>
+#include <Box2D/Dynamics/b2WorldSnapshot.h>
 #include <Box2D/Dynamics/b2Body.h>
 #include <Box2D/Dynamics/b2Fixture.h>
 #include <Box2D/Dynamics/b2Island.h>
@@ -43,6 +44,7 @@ b2World::b2World(const b2Vec2& gravity)
 	m_jointList = NULL;
 
 	m_bodyCount = 0;
+	m_awakeBodyCount = 0;
 	m_jointCount = 0;
 
 	m_warmStarting = true;
@@ -60,6 +62,13 @@ b2World::b2World(const b2Vec2& gravity)
 
 	m_contactManager.m_allocator = &m_blockAllocator;
 
+	m_taskExecutor = NULL;
+	m_threadStackAllocators = NULL;
+	m_threadStackAllocatorCount = 0;
+	m_parallelNarrowPhase = false;
+
+	m_structureRevision = 0;
+
 	memset(&m_profile, 0, sizeof(b2Profile));
 }
 
@@ -82,6 +91,43 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	SetTaskExecutor(NULL);
+}
+
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	// Release the thread stack allocators.
+	for (int32 i = 0; i < m_threadStackAllocatorCount; ++i)
+	{
+		m_threadStackAllocators[i].~b2StackAllocator();
+	}
+	b2Free(m_threadStackAllocators);
+	m_threadStackAllocators = NULL;
+	m_threadStackAllocatorCount = 0;
+
+	m_taskExecutor = executor;
+	if (executor == NULL)
+	{
+		return;
+	}
+
+	// The stepping thread uses the world stack allocator.
+	m_threadStackAllocatorCount = b2Max(executor->GetThreadCount() - 1, 0);
+	if (m_threadStackAllocatorCount > 0)
+	{
+		m_threadStackAllocators = (b2StackAllocator*)b2Alloc(m_threadStackAllocatorCount * sizeof(b2StackAllocator));
+		for (int32 i = 0; i < m_threadStackAllocatorCount; ++i)
+		{
+			new (m_threadStackAllocators + i) b2StackAllocator;
+		}
+	}
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -124,6 +170,12 @@ b2Body* b2World::CreateBody(const b2BodyDef* def)
 	}
 	m_bodyList = b;
 	++m_bodyCount;
+	++m_structureRevision;
+
+	if (b->IsAwake())
+	{
+		++m_awakeBodyCount;
+	}
 
 	return b;
 }
@@ -205,6 +257,12 @@ void b2World::DestroyBody(b2Body* b)
 	}
 
 	--m_bodyCount;
+	++m_structureRevision;
+	if (b->IsAwake())
+	{
+		--m_awakeBodyCount;
+	}
+
 	b->~b2Body();
 	m_blockAllocator.Free(b, sizeof(b2Body));
 }
@@ -228,6 +286,7 @@ b2Joint* b2World::CreateJoint(const b2JointDef* def)
 	}
 	m_jointList = j;
 	++m_jointCount;
+	++m_structureRevision;
 
 	// Connect to the bodies' doubly linked lists.
 	j->m_edgeA.joint = j;
@@ -345,6 +404,7 @@ void b2World::DestroyJoint(b2Joint* j)
 
 	b2Assert(m_jointCount > 0);
 	--m_jointCount;
+	++m_structureRevision;
 
 	// If the joint prevents collisions, then flag any contacts for filtering.
 	if (collideConnected == false)
@@ -573,6 +633,350 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 }
 
+// An island gathered for solving on the task executor. The bodies, contacts
+// and joints are ranges of the arrays built by b2World::SolveParallel.
+struct b2IslandRange
+{
+	int32 bodyStart;
+	int32 bodyCount;
+	int32 contactStart;
+	int32 contactCount;
+	int32 jointStart;
+	int32 jointCount;
+	bool sleepRequested;
+	b2Profile profile;
+};
+
+// Solves island ranges using the stack allocator of the executing thread.
+class b2IslandSolveTask : public b2Task
+{
+public:
+	void Execute(int32 begin, int32 end, int32 threadIndex)
+	{
+		b2Assert(0 <= threadIndex && threadIndex <= threadStackAllocatorCount);
+		b2StackAllocator* allocator = threadIndex == 0 ? stackAllocator : threadStackAllocators + threadIndex - 1;
+
+		for (int32 i = begin; i < end; ++i)
+		{
+			b2IslandRange* range = islands + i;
+			b2ContactImpulse* rangeImpulses = impulses ? impulses + range->contactStart : NULL;
+
+			b2Island island(bodies + range->bodyStart, range->bodyCount,
+							contacts + range->contactStart, range->contactCount,
+							joints + range->jointStart, range->jointCount,
+							positions, velocities, allocator, rangeImpulses);
+
+			island.Solve(&range->profile, *step, gravity, allowSleep);
+			range->sleepRequested = island.m_sleepRequested;
+		}
+	}
+
+	const b2TimeStep* step;
+	b2Vec2 gravity;
+	bool allowSleep;
+
+	b2IslandRange* islands;
+	b2Body** bodies;
+	b2Contact** contacts;
+	b2Joint** joints;
+	b2Position* positions;
+	b2Velocity* velocities;
+	b2ContactImpulse* impulses;
+
+	b2StackAllocator* stackAllocator;
+	b2StackAllocator* threadStackAllocators;
+	int32 threadStackAllocatorCount;
+};
+
+// Build all the islands first and then solve them on the task executor.
+// Islands are built in the same order as Solve and their results are applied
+// in that order so the outcome does not depend on the number of threads.
+// Every body gets a unique island index into state shared by all the islands.
+// A static body can be part of several islands so its state is written once
+// here and the solvers only ever store back the unchanged values.
+void b2World::SolveParallel(const b2TimeStep& step)
+{
+	m_profile.solveInit = 0.0f;
+	m_profile.solveVelocity = 0.0f;
+	m_profile.solvePosition = 0.0f;
+
+	// Clear all the island flags and indices.
+	for (b2Body* b = m_bodyList; b; b = b->m_next)
+	{
+		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_islandIndex = -1;
+	}
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
+	{
+		c->m_flags &= ~b2Contact::e_islandFlag;
+	}
+	for (b2Joint* j = m_jointList; j; j = j->m_next)
+	{
+		j->m_islandFlag = false;
+	}
+
+	// Size for the worst case. Static bodies can be added once per contact or joint.
+	int32 contactCapacity = m_contactManager.m_contactCount;
+	int32 bodyCapacity = m_bodyCount + contactCapacity + m_jointCount;
+	b2ContactListener* listener = m_contactManager.m_contactListener;
+
+	b2IslandRange* islands = (b2IslandRange*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2IslandRange));
+	b2Body** bodies = (b2Body**)m_stackAllocator.Allocate(bodyCapacity * sizeof(b2Body*));
+	b2Contact** contacts = (b2Contact**)m_stackAllocator.Allocate(contactCapacity * sizeof(b2Contact*));
+	b2Joint** joints = (b2Joint**)m_stackAllocator.Allocate(m_jointCount * sizeof(b2Joint*));
+	b2Position* positions = (b2Position*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Position));
+	b2Velocity* velocities = (b2Velocity*)m_stackAllocator.Allocate(m_bodyCount * sizeof(b2Velocity));
+	b2ContactImpulse* impulses = listener ? (b2ContactImpulse*)m_stackAllocator.Allocate(contactCapacity * sizeof(b2ContactImpulse)) : NULL;
+
+	int32 islandCount = 0;
+	int32 bodyCount = 0;
+	int32 contactCount = 0;
+	int32 jointCount = 0;
+	int32 stateCount = 0;
+
+	// Build all awake islands.
+	int32 stackSize = m_bodyCount;
+	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
+	{
+		if (seed->m_flags & b2Body::e_islandFlag)
+		{
+			continue;
+		}
+
+		if (seed->IsAwake() == false || seed->IsActive() == false)
+		{
+			continue;
+		}
+
+		// The seed can be dynamic or kinematic.
+		if (seed->GetType() == b2_staticBody)
+		{
+			continue;
+		}
+
+		b2IslandRange* range = islands + islandCount++;
+		range->bodyStart = bodyCount;
+		range->contactStart = contactCount;
+		range->jointStart = jointCount;
+		range->sleepRequested = false;
+
+		// Reset stack.
+		int32 stackCount = 0;
+		stack[stackCount++] = seed;
+		seed->m_flags |= b2Body::e_islandFlag;
+
+		// Perform a depth first search (DFS) on the constraint graph.
+		while (stackCount > 0)
+		{
+			// Grab the next body off the stack and add it to the island.
+			b2Body* b = stack[--stackCount];
+			b2Assert(b->IsActive() == true);
+			b2Assert(bodyCount < bodyCapacity);
+			bodies[bodyCount++] = b;
+
+			// Give the body its state the first time it is seen.
+			if (b->m_islandIndex == -1)
+			{
+				b->m_islandIndex = stateCount++;
+
+				// Static body state is shared and never changes.
+				if (b->GetType() == b2_staticBody)
+				{
+					b->m_sweep.c0 = b->m_sweep.c;
+					b->m_sweep.a0 = b->m_sweep.a;
+					positions[b->m_islandIndex].c = b->m_sweep.c;
+					positions[b->m_islandIndex].a = b->m_sweep.a;
+					velocities[b->m_islandIndex].v = b->m_linearVelocity;
+					velocities[b->m_islandIndex].w = b->m_angularVelocity;
+				}
+			}
+
+			// Make sure the body is awake.
+			b->SetAwake(true);
+
+			// To keep islands as small as possible, we don't
+			// propagate islands across static bodies.
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Search all contacts connected to this body.
+			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
+			{
+				b2Contact* contact = ce->contact;
+
+				// Has this contact already been added to an island?
+				if (contact->m_flags & b2Contact::e_islandFlag)
+				{
+					continue;
+				}
+
+				// Is this contact solid and touching?
+				if (contact->IsEnabled() == false ||
+					contact->IsTouching() == false)
+				{
+					continue;
+				}
+
+				// Skip sensors.
+				bool sensorA = contact->m_fixtureA->m_isSensor;
+				bool sensorB = contact->m_fixtureB->m_isSensor;
+				if (sensorA || sensorB)
+				{
+					continue;
+				}
+
+				contacts[contactCount++] = contact;
+				contact->m_flags |= b2Contact::e_islandFlag;
+
+				b2Body* other = ce->other;
+
+				// Was the other body already added to this island?
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+
+			// Search all joints connect to this body.
+			for (b2JointEdge* je = b->m_jointList; je; je = je->next)
+			{
+				if (je->joint->m_islandFlag == true)
+				{
+					continue;
+				}
+
+				b2Body* other = je->other;
+
+				// Don't simulate joints connected to inactive bodies.
+				if (other->IsActive() == false)
+				{
+					continue;
+				}
+
+				joints[jointCount++] = je->joint;
+				je->joint->m_islandFlag = true;
+
+				if (other->m_flags & b2Body::e_islandFlag)
+				{
+					continue;
+				}
+
+				b2Assert(stackCount < stackSize);
+				stack[stackCount++] = other;
+				other->m_flags |= b2Body::e_islandFlag;
+			}
+		}
+
+		range->bodyCount = bodyCount - range->bodyStart;
+		range->contactCount = contactCount - range->contactStart;
+		range->jointCount = jointCount - range->jointStart;
+
+		// Allow static bodies to participate in other islands.
+		for (int32 i = range->bodyStart; i < bodyCount; ++i)
+		{
+			b2Body* b = bodies[i];
+			if (b->GetType() == b2_staticBody)
+			{
+				b->m_flags &= ~b2Body::e_islandFlag;
+			}
+		}
+	}
+
+	m_stackAllocator.Free(stack);
+
+	// Solve the islands.
+	b2IslandSolveTask task;
+	task.step = &step;
+	task.gravity = m_gravity;
+	task.allowSleep = m_allowSleep;
+	task.islands = islands;
+	task.bodies = bodies;
+	task.contacts = contacts;
+	task.joints = joints;
+	task.positions = positions;
+	task.velocities = velocities;
+	task.impulses = impulses;
+	task.stackAllocator = &m_stackAllocator;
+	task.threadStackAllocators = m_threadStackAllocators;
+	task.threadStackAllocatorCount = m_threadStackAllocatorCount;
+	m_taskExecutor->ParallelFor(&task, islandCount, 1);
+
+	// Report impulses and sleep islands in the order they were built.
+	for (int32 i = 0; i < islandCount; ++i)
+	{
+		const b2IslandRange* range = islands + i;
+		m_profile.solveInit += range->profile.solveInit;
+		m_profile.solveVelocity += range->profile.solveVelocity;
+		m_profile.solvePosition += range->profile.solvePosition;
+
+		if (listener)
+		{
+			for (int32 j = range->contactStart; j < range->contactStart + range->contactCount; ++j)
+			{
+				listener->PostSolve(contacts[j], impulses + j);
+			}
+		}
+
+		// A static body ends up awake or asleep like the last island that used it.
+		for (int32 j = range->bodyStart; j < range->bodyStart + range->bodyCount; ++j)
+		{
+			b2Body* b = bodies[j];
+			if (range->sleepRequested)
+			{
+				b->SetAwake(false);
+			}
+			else if (b->GetType() == b2_staticBody)
+			{
+				b->SetAwake(true);
+			}
+		}
+	}
+
+	// Warning: the order should reverse the allocation order.
+	if (impulses)
+	{
+		m_stackAllocator.Free(impulses);
+	}
+	m_stackAllocator.Free(velocities);
+	m_stackAllocator.Free(positions);
+	m_stackAllocator.Free(joints);
+	m_stackAllocator.Free(contacts);
+	m_stackAllocator.Free(bodies);
+	m_stackAllocator.Free(islands);
+
+	{
+		b2Timer timer;
+		// Synchronize fixtures, check for out of range bodies.
+		for (b2Body* b = m_bodyList; b; b = b->GetNext())
+		{
+			// If a body was not in an island then it did not move.
+			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			{
+				continue;
+			}
+
+			if (b->GetType() == b2_staticBody)
+			{
+				continue;
+			}
+
+			// Update fixtures (for broad-phase).
+			b->SynchronizeFixtures();
+		}
+
+		// Look for new contacts.
+		m_contactManager.FindNewContacts();
+		m_profile.broadphase = timer.GetMilliseconds();
+	}
+}
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
@@ -927,7 +1331,14 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	// Update contacts. This is where some contacts are destroyed.
 	{
 		b2Timer timer;
-		m_contactManager.Collide();
+		if (m_taskExecutor && m_parallelNarrowPhase)
+		{
+			m_contactManager.CollideParallel(m_taskExecutor, &m_stackAllocator);
+		}
+		else
+		{
+			m_contactManager.Collide();
+		}
 		m_profile.collide = timer.GetMilliseconds();
 	}
 
@@ -935,7 +1346,14 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	if (m_stepComplete && step.dt > 0.0f)
 	{
 		b2Timer timer;
-		Solve(step);
+		if (m_taskExecutor)
+		{
+			SolveParallel(step);
+		}
+		else
+		{
+			Solve(step);
+		}
 		m_profile.solve = timer.GetMilliseconds();
 	}
 
@@ -1256,6 +1674,228 @@ float32 b2World::GetTreeQuality() const
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
 
+void b2World::SaveSnapshot(b2WorldSnapshot* snapshot) const
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	snapshot->m_world = this;
+	snapshot->m_revision = m_structureRevision;
+	snapshot->m_worldFlags = m_flags & e_newFixture;
+	snapshot->m_inv_dt0 = m_inv_dt0;
+
+	const b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+
+	// Bodies and their fixture proxies.
+	b2WorldSnapshot::Reserve(&snapshot->m_bodies, &snapshot->m_bodyCapacity, m_bodyCount);
+	b2WorldSnapshot::Reserve(&snapshot->m_proxies, &snapshot->m_proxyCapacity, broadPhase.m_proxyCount);
+	snapshot->m_bodyCount = m_bodyCount;
+
+	int32 proxyCount = 0;
+	b2BodySnapshot* bodyState = snapshot->m_bodies;
+	for (b2Body* b = m_bodyList; b; b = b->m_next, ++bodyState)
+	{
+		bodyState->xf = b->m_xf;
+		bodyState->sweep = b->m_sweep;
+		bodyState->linearVelocity = b->m_linearVelocity;
+		bodyState->angularVelocity = b->m_angularVelocity;
+		bodyState->force = b->m_force;
+		bodyState->torque = b->m_torque;
+		bodyState->sleepTime = b->m_sleepTime;
+		bodyState->awake = b->IsAwake();
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				snapshot->m_proxies[proxyCount++] = f->m_proxies[i].aabb;
+			}
+		}
+	}
+	b2Assert(proxyCount == broadPhase.m_proxyCount);
+	snapshot->m_proxyCount = proxyCount;
+
+	// Contacts in list order.
+	b2WorldSnapshot::Reserve(&snapshot->m_contacts, &snapshot->m_contactCapacity, m_contactManager.m_contactCount);
+	snapshot->m_contactCount = m_contactManager.m_contactCount;
+
+	b2ContactSnapshot* contactState = snapshot->m_contacts;
+	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next, ++contactState)
+	{
+		contactState->fixtureA = c->m_fixtureA;
+		contactState->fixtureB = c->m_fixtureB;
+		contactState->indexA = c->m_indexA;
+		contactState->indexB = c->m_indexB;
+		contactState->serial = c->m_serial;
+		contactState->flags = c->m_flags;
+		contactState->manifold = c->m_manifold;
+		contactState->toiCount = c->m_toiCount;
+		contactState->toi = c->m_toi;
+		contactState->friction = c->m_friction;
+		contactState->restitution = c->m_restitution;
+		contactState->tangentSpeed = c->m_tangentSpeed;
+	}
+
+	// Joints.
+	b2WorldSnapshot::Reserve(&snapshot->m_joints, &snapshot->m_jointCapacity, m_jointCount);
+	snapshot->m_jointCount = m_jointCount;
+
+	b2JointSnapshot* jointState = snapshot->m_joints;
+	for (b2Joint* j = m_jointList; j; j = j->m_next, ++jointState)
+	{
+		j->GetSolverState(jointState->state);
+	}
+
+	// The broad-phase tree decides the order new contacts are found in so it is kept whole.
+	const b2DynamicTree& tree = broadPhase.m_tree;
+	b2WorldSnapshot::Reserve(&snapshot->m_treeNodes, &snapshot->m_treeNodeBufferCapacity, tree.m_nodeCapacity);
+	memcpy(snapshot->m_treeNodes, tree.m_nodes, tree.m_nodeCapacity * sizeof(b2TreeNode));
+	snapshot->m_treeNodeCapacity = tree.m_nodeCapacity;
+	snapshot->m_treeNodeCount = tree.m_nodeCount;
+	snapshot->m_treeRoot = tree.m_root;
+	snapshot->m_treeFreeList = tree.m_freeList;
+	snapshot->m_treePath = tree.m_path;
+	snapshot->m_treeInsertionCount = tree.m_insertionCount;
+
+	snapshot->m_moveCount = broadPhase.m_moveCount;
+	if (broadPhase.m_moveCount > 0)
+	{
+		b2WorldSnapshot::Reserve(&snapshot->m_moveBuffer, &snapshot->m_moveCapacity, broadPhase.m_moveCount);
+		memcpy(snapshot->m_moveBuffer, broadPhase.m_moveBuffer, broadPhase.m_moveCount * sizeof(int32));
+	}
+}
+
+bool b2World::RestoreSnapshot(const b2WorldSnapshot& snapshot)
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return false;
+	}
+
+	// The snapshot must come from this world with the same bodies, fixtures and joints.
+	if (snapshot.m_world != this || snapshot.m_revision != m_structureRevision)
+	{
+		return false;
+	}
+
+	m_flags = (m_flags & ~e_newFixture) | snapshot.m_worldFlags;
+	m_inv_dt0 = snapshot.m_inv_dt0;
+
+	b2BroadPhase& broadPhase = m_contactManager.m_broadPhase;
+
+	// Bodies and their fixture proxies.
+	int32 proxyCount = 0;
+	m_awakeBodyCount = 0;
+	const b2BodySnapshot* bodyState = snapshot.m_bodies;
+	for (b2Body* b = m_bodyList; b; b = b->m_next, ++bodyState)
+	{
+		b->m_xf = bodyState->xf;
+		b->m_sweep = bodyState->sweep;
+		b->m_linearVelocity = bodyState->linearVelocity;
+		b->m_angularVelocity = bodyState->angularVelocity;
+		b->m_force = bodyState->force;
+		b->m_torque = bodyState->torque;
+		b->m_sleepTime = bodyState->sleepTime;
+
+		if (bodyState->awake)
+		{
+			b->m_flags |= b2Body::e_awakeFlag;
+			++m_awakeBodyCount;
+		}
+		else
+		{
+			b->m_flags &= ~b2Body::e_awakeFlag;
+		}
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				f->m_proxies[i].aabb = snapshot.m_proxies[proxyCount++];
+			}
+		}
+	}
+	b2Assert(proxyCount == snapshot.m_proxyCount);
+
+	// Contacts. New contacts go to the head of the list so the list and the
+	// snapshot are both in descending creation order. Walk them together, freeing
+	// contacts that are not in the snapshot and recreating those destroyed since.
+	b2Contact* prev = NULL;
+	b2Contact* c = m_contactManager.m_contactList;
+	for (int32 i = 0; i < snapshot.m_contactCount; ++i)
+	{
+		const b2ContactSnapshot* contactState = snapshot.m_contacts + i;
+
+		while (c && (c->m_serial > contactState->serial ||
+			(c->m_serial == contactState->serial && (c->m_fixtureA != contactState->fixtureA || c->m_fixtureB != contactState->fixtureB ||
+			c->m_indexA != contactState->indexA || c->m_indexB != contactState->indexB))))
+		{
+			b2Contact* next = c->m_next;
+			m_contactManager.Remove(c);
+			c = next;
+		}
+
+		if (c && c->m_serial == contactState->serial)
+		{
+			prev = c;
+			c = c->m_next;
+		}
+		else
+		{
+			b2Contact* created = b2Contact::Create(contactState->fixtureA, contactState->indexA, contactState->fixtureB, contactState->indexB, &m_blockAllocator);
+			created->m_serial = contactState->serial;
+			m_contactManager.InsertAfter(created, prev);
+			prev = created;
+		}
+
+		prev->m_flags = contactState->flags;
+		prev->m_manifold = contactState->manifold;
+		prev->m_toiCount = contactState->toiCount;
+		prev->m_toi = contactState->toi;
+		prev->m_friction = contactState->friction;
+		prev->m_restitution = contactState->restitution;
+		prev->m_tangentSpeed = contactState->tangentSpeed;
+	}
+
+	while (c)
+	{
+		b2Contact* next = c->m_next;
+		m_contactManager.Remove(c);
+		c = next;
+	}
+	b2Assert(m_contactManager.m_contactCount == snapshot.m_contactCount);
+
+	// Joints.
+	const b2JointSnapshot* jointState = snapshot.m_joints;
+	for (b2Joint* j = m_jointList; j; j = j->m_next, ++jointState)
+	{
+		j->SetSolverState(jointState->state);
+	}
+
+	// Broad-phase.
+	b2DynamicTree& tree = broadPhase.m_tree;
+	b2Assert(tree.m_nodeCapacity == snapshot.m_treeNodeCapacity);
+	memcpy(tree.m_nodes, snapshot.m_treeNodes, snapshot.m_treeNodeCapacity * sizeof(b2TreeNode));
+	tree.m_nodeCount = snapshot.m_treeNodeCount;
+	tree.m_root = snapshot.m_treeRoot;
+	tree.m_freeList = snapshot.m_treeFreeList;
+	tree.m_path = snapshot.m_treePath;
+	tree.m_insertionCount = snapshot.m_treeInsertionCount;
+
+	b2Assert(snapshot.m_moveCount <= broadPhase.m_moveCapacity);
+	if (snapshot.m_moveCount > 0)
+	{
+		memcpy(broadPhase.m_moveBuffer, snapshot.m_moveBuffer, snapshot.m_moveCount * sizeof(int32));
+	}
+	broadPhase.m_moveCount = snapshot.m_moveCount;
+
+	return true;
+}
+
 void b2World::ShiftOrigin(const b2Vec2& newOrigin)
 {
 	b2Assert((m_flags & e_locked) == 0);
@@ -1264,6 +1904,8 @@ void b2World::ShiftOrigin(const b2Vec2& newOrigin)
 		return;
 	}
 
+	++m_structureRevision;
+
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
 		b->m_xf.p -= newOrigin;
@@ -34,6 +34,7 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+class b2WorldSnapshot;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -61,6 +62,32 @@ public:
 	/// remain in scope.
 	void SetContactListener(b2ContactListener* listener);
 
+	/// Register a task executor to solve independent islands on several threads.
+	/// Pass NULL to solve on the stepping thread only. The executor is owned by you
+	/// and must remain in scope.
+	/// @warning This function is locked during callbacks.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+	b2TaskExecutor* GetTaskExecutor() const { return m_taskExecutor; }
+
+	/// Enable/disable updating contact manifolds on the task executor threads.
+	/// Contacts that become active because a body woke during the update are
+	/// then updated on the following step.
+	void SetParallelNarrowPhase(bool flag) { m_parallelNarrowPhase = flag; }
+	bool GetParallelNarrowPhase() const { return m_parallelNarrowPhase; }
+
+	/// Save the simulation state into a snapshot. Restoring the snapshot and
+	/// stepping again reproduces the same results.
+	/// @warning This function is locked during callbacks.
+	void SaveSnapshot(b2WorldSnapshot* snapshot) const;
+
+	/// Restore the simulation state from a snapshot. No contact callbacks are
+	/// made. This fails if bodies, fixtures or joints were created or destroyed,
+	/// bodies were activated, deactivated or changed type, or the origin was
+	/// shifted since the snapshot was saved.
+	/// @return true if the snapshot was restored.
+	/// @warning This function is locked during callbacks.
+	bool RestoreSnapshot(const b2WorldSnapshot& snapshot);
+
 	/// Register a routine for debug drawing. The debug draw functions are called
 	/// inside with b2World::DrawDebugData method. The debug draw object is owned
 	/// by you and must remain in scope.
@@ -163,6 +190,9 @@ public:
 	/// Get the number of bodies.
 	int32 GetBodyCount() const;
 
+	/// Get the number of awake bodies. This is maintained as bodies wake and sleep.
+	int32 GetAwakeBodyCount() const;
+
 	/// Get the number of joints.
 	int32 GetJointCount() const;
 
@@ -225,6 +255,7 @@ private:
 	friend class b2Controller;
 
 	void Solve(const b2TimeStep& step);
+	void SolveParallel(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
 	void DrawJoint(b2Joint* joint);
@@ -233,6 +264,12 @@ private:
 	b2BlockAllocator m_blockAllocator;
 	b2StackAllocator m_stackAllocator;
 
+	// Task executor threads other than the stepping thread each need a stack allocator.
+	b2TaskExecutor* m_taskExecutor;
+	b2StackAllocator* m_threadStackAllocators;
+	int32 m_threadStackAllocatorCount;
+	bool m_parallelNarrowPhase;
+
 	int32 m_flags;
 
 	b2ContactManager m_contactManager;
@@ -241,8 +278,12 @@ private:
 	b2Joint* m_jointList;
 
 	int32 m_bodyCount;
+	int32 m_awakeBodyCount;
 	int32 m_jointCount;
 
+	// Changed whenever bodies, fixtures or joints change in a way that snapshots cannot restore.
+	uint32 m_structureRevision;
+
 	b2Vec2 m_gravity;
 	bool m_allowSleep;
 
@@ -298,6 +339,11 @@ inline int32 b2World::GetBodyCount() const
 	return m_bodyCount;
 }
 
+inline int32 b2World::GetAwakeBodyCount() const
+{
+	return m_awakeBodyCount;
+}
+
 inline int32 b2World::GetJointCount() const
 {
 	return m_jointCount;
@@ -152,4 +152,33 @@ public:
 									const b2Vec2& normal, float32 fraction) = 0;
 };
 
+/// A range of step work that may be split across threads.
+/// See b2TaskExecutor.
+class b2Task
+{
+public:
+	virtual ~b2Task() {}
+
+	/// Process the items in [begin, end). This is called concurrently for disjoint ranges.
+	/// @param threadIndex the executing thread, from zero to the executor thread count less one.
+	virtual void Execute(int32 begin, int32 end, int32 threadIndex) = 0;
+};
+
+/// Implement this class to let the world solve islands and update contacts on
+/// several threads. The results do not depend on the number of threads.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	virtual ~b2TaskExecutor() {}
+
+	/// Get the number of threads that execute tasks, including the stepping thread.
+	virtual int32 GetThreadCount() const = 0;
+
+	/// Execute the task over [0, count) in ranges of at most grainSize items and
+	/// return once every item has been processed. The stepping thread must use
+	/// thread index zero.
+	virtual void ParallelFor(b2Task* task, int32 count, int32 grainSize) = 0;
+};
+
 #endif
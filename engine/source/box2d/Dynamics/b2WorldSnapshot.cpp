@@ -0,0 +1,82 @@
+/*
+* Copyright (c) 2006-2013 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#include <Box2D/Dynamics/b2WorldSnapshot.h>
+
+b2WorldSnapshot::b2WorldSnapshot()
+{
+	m_world = NULL;
+	m_revision = 0;
+	m_worldFlags = 0;
+	m_inv_dt0 = 0.0f;
+
+	m_bodies = NULL;
+	m_bodyCount = 0;
+	m_bodyCapacity = 0;
+
+	m_contacts = NULL;
+	m_contactCount = 0;
+	m_contactCapacity = 0;
+
+	m_joints = NULL;
+	m_jointCount = 0;
+	m_jointCapacity = 0;
+
+	m_proxies = NULL;
+	m_proxyCount = 0;
+	m_proxyCapacity = 0;
+
+	m_treeNodes = NULL;
+	m_treeNodeCapacity = 0;
+	m_treeNodeBufferCapacity = 0;
+	m_treeNodeCount = 0;
+	m_treeRoot = b2_nullNode;
+	m_treeFreeList = b2_nullNode;
+	m_treePath = 0;
+	m_treeInsertionCount = 0;
+
+	m_moveBuffer = NULL;
+	m_moveCount = 0;
+	m_moveCapacity = 0;
+}
+
+b2WorldSnapshot::~b2WorldSnapshot()
+{
+	b2Free(m_bodies);
+	b2Free(m_contacts);
+	b2Free(m_joints);
+	b2Free(m_proxies);
+	b2Free(m_treeNodes);
+	b2Free(m_moveBuffer);
+}
+
+int32 b2WorldSnapshot::GetSize() const
+{
+	if (m_world == NULL)
+	{
+		return 0;
+	}
+
+	return m_bodyCount * sizeof(b2BodySnapshot) +
+		m_contactCount * sizeof(b2ContactSnapshot) +
+		m_jointCount * sizeof(b2JointSnapshot) +
+		m_proxyCount * sizeof(b2AABB) +
+		m_treeNodeCapacity * sizeof(b2TreeNode) +
+		m_moveCount * sizeof(int32);
+}
@@ -0,0 +1,145 @@
+/*
+* Copyright (c) 2006-2013 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+#ifndef B2_WORLD_SNAPSHOT_H
+#define B2_WORLD_SNAPSHOT_H
+
+#include <Box2D/Common/b2Math.h>
+#include <Box2D/Collision/b2Collision.h>
+#include <Box2D/Collision/b2DynamicTree.h>
+#include <Box2D/Dynamics/Joints/b2Joint.h>
+
+class b2Fixture;
+class b2World;
+
+/// The saved simulation state of a body.
+struct b2BodySnapshot
+{
+	b2Transform xf;
+	b2Sweep sweep;
+	b2Vec2 linearVelocity;
+	float32 angularVelocity;
+	b2Vec2 force;
+	float32 torque;
+	float32 sleepTime;
+	bool awake;
+};
+
+/// The saved state of a contact, including the manifold impulses used for warm starting.
+struct b2ContactSnapshot
+{
+	b2Fixture* fixtureA;
+	b2Fixture* fixtureB;
+	int32 indexA;
+	int32 indexB;
+	uint32 serial;
+	uint32 flags;
+	b2Manifold manifold;
+	int32 toiCount;
+	float32 toi;
+	float32 friction;
+	float32 restitution;
+	float32 tangentSpeed;
+};
+
+/// The saved solver state of a joint.
+struct b2JointSnapshot
+{
+	float32 state[b2_maxJointSolverState];
+};
+
+/// A compact copy of the simulation state of a world. This holds body motion
+/// and sleep state, contacts and their impulses, joint impulses and the
+/// broad-phase so that restoring it and stepping again reproduces the original
+/// steps exactly. It does not hold bodies, fixtures or joints themselves so a
+/// snapshot can only be restored while those are unchanged.
+/// The buffers are kept between saves so saving every step does not allocate.
+/// @see b2World::SaveSnapshot, b2World::RestoreSnapshot
+class b2WorldSnapshot
+{
+public:
+	b2WorldSnapshot();
+	~b2WorldSnapshot();
+
+	/// Does this hold a saved state?
+	bool IsValid() const { return m_world != NULL; }
+
+	/// Forget the saved state. The buffers are kept for the next save.
+	void Clear() { m_world = NULL; }
+
+	/// Get the number of bytes of saved state.
+	int32 GetSize() const;
+
+private:
+
+	friend class b2World;
+
+	b2WorldSnapshot(const b2WorldSnapshot&);
+	b2WorldSnapshot& operator=(const b2WorldSnapshot&);
+
+	// Make sure a buffer can hold count items. The contents are not kept.
+	template <typename T>
+	static void Reserve(T** buffer, int32* capacity, int32 count)
+	{
+		if (count <= *capacity)
+		{
+			return;
+		}
+
+		b2Free(*buffer);
+		*capacity = b2Max(count, 2 * *capacity);
+		*buffer = (T*)b2Alloc(*capacity * sizeof(T));
+	}
+
+	const b2World* m_world;
+	uint32 m_revision;
+	int32 m_worldFlags;
+	float32 m_inv_dt0;
+
+	b2BodySnapshot* m_bodies;
+	int32 m_bodyCount;
+	int32 m_bodyCapacity;
+
+	b2ContactSnapshot* m_contacts;
+	int32 m_contactCount;
+	int32 m_contactCapacity;
+
+	b2JointSnapshot* m_joints;
+	int32 m_jointCount;
+	int32 m_jointCapacity;
+
+	b2AABB* m_proxies;
+	int32 m_proxyCount;
+	int32 m_proxyCapacity;
+
+	b2TreeNode* m_treeNodes;
+	int32 m_treeNodeCapacity;
+	int32 m_treeNodeBufferCapacity;
+	int32 m_treeNodeCount;
+	int32 m_treeRoot;
+	int32 m_treeFreeList;
+	uint32 m_treePath;
+	int32 m_treeInsertionCount;
+
+	int32* m_moveBuffer;
+	int32 m_moveCount;
+	int32 m_moveCapacity;
+};
+
+#endif
@@ -0,0 +1,601 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _FLATHASHMAP_H_
+#define _FLATHASHMAP_H_
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+namespace FlatHash
+{
+   /// Scrambles a hash so that its low bits can be used to pick a slot.
+   inline U32 mix(U32 hash)
+   {
+      hash ^= hash >> 16;
+      hash *= 0x85ebca6b;
+      hash ^= hash >> 13;
+      hash *= 0xc2b2ae35;
+      hash ^= hash >> 16;
+      return hash;
+   }
+
+   /// Integer keys are normally sequential ids so the low bits are used as
+   /// they are, folding in the high bits for keys that only differ there.
+   /// This also keeps ids below 65536 in order when the map is iterated.
+   inline U32 slotHash(U32 key) { return key ^ (key >> 16); }
+   inline U32 slotHash(S32 key) { return slotHash((U32)key); }
+
+   /// Pointers, strings and everything else have poorly distributed low bits
+   /// so their Hash::hash() is mixed first.
+   template<typename Key>
+   inline U32 slotHash(const Key& key) { return mix(Hash::hash(key)); }
+};
+
+//-----------------------------------------------------------------------------
+/// An open-addressing hash map with unique keys.
+///
+/// Entries live in a single flat array of slots probed linearly using Robin
+/// Hood ordering: an inserted entry takes the slot of any entry that is
+/// closer to its own home slot.  This keeps probe sequences short at high
+/// load factors, allows erasure without tombstones and means lookups and
+/// iteration walk contiguous memory instead of chasing a heap node per entry.
+///
+/// The interface matches HashMap so the two can be swapped in place, with
+/// the following differences:
+///
+/// - Inserting or erasing moves entries, so pointers, references and
+///   iterators into the map are invalidated by any insert or erase.  Collect
+///   keys first when entries need erasing while iterating.
+/// - clear() keeps the slot storage so maps that are refilled every frame
+///   do not reallocate.  Use compact() to release it.
+///
+/// Keys are hashed with FlatHash::slotHash() and compared with
+/// tKeyCompare::equals() like HashTable.
+/// @ingroup UtilContainers
+template<typename Key, typename Value>
+class FlatHashMap
+{
+public:
+   struct Pair {
+      Key  key;
+      Value value;
+      Pair() {}
+      Pair(Key k,Value v): key(k), value(v) {}
+   };
+
+private:
+   enum Constants
+   {
+      MinimumCapacity    = 16,
+      MaxLoadNumerator   = 7,    ///< Grow once the map is 7/8ths full.
+      MaxLoadDenominator = 8,
+      MaxProbeDistance   = 255    ///< Probe distances are stored in a byte.
+   };
+
+   /// Slot index used by end() so that it stays valid when the map grows.
+   static const U32 InvalidIndex = 0xFFFFFFFF;
+
+   /// Probe distance plus one for each slot; zero marks an empty slot.
+   U8*   mDistances;
+   Pair* mSlots;
+   U32   mCapacity;                    ///< Number of slots, always a power of two.
+   U32   mSize;                        ///< Number of keys in the map
+
+   U32 _home(const Key& key) const;
+   U32 _find(const Key& key) const;
+   U32 _next(U32 index) const;
+   bool _insert(const Key& key, const Value& value, U32& index);
+   void _erase(U32 index);
+   void _rehash(U32 capacity);
+   void _destroy();
+
+public:
+   // iterator support
+   template<typename U, typename M>
+   class _Iterator {
+      friend class FlatHashMap;
+      M* mMap;
+      U32 mIndex;
+   public:
+      typedef U  ValueType;
+      typedef U* Pointer;
+      typedef U& Reference;
+
+      _Iterator()
+      {
+         mMap = 0;
+         mIndex = 0;
+      }
+
+      _Iterator(M* map,U32 index)
+      {
+         mMap = map;
+         mIndex = index;
+      }
+
+      _Iterator& operator++()
+      {
+         mIndex = mMap->_next(mIndex + 1);
+         return *this;
+      }
+
+      _Iterator operator++(int)
+      {
+         _Iterator itr(*this);
+         ++(*this);
+         return itr;
+      }
+
+      Value getValue() {
+         if ( mIndex != InvalidIndex ) {
+            return mMap->mSlots[mIndex].value;
+         }
+         return (Value)(0);
+      }
+
+      bool operator==(const _Iterator& b) const
+      {
+         return mMap == b.mMap && mIndex == b.mIndex;
+      }
+
+      bool operator!=(const _Iterator& b) const
+      {
+         return !(*this == b);
+      }
+
+      U* operator->() const
+      {
+         return &mMap->mSlots[mIndex];
+      }
+
+      U& operator*() const
+      {
+         return mMap->mSlots[mIndex];
+      }
+   };
+
+   // Types
+   typedef Pair        ValueType;
+   typedef Pair&       Reference;
+   typedef const Pair& ConstReference;
+   typedef S32         DifferenceType;
+   typedef U32         SizeType;
+
+   typedef _Iterator<Pair,FlatHashMap>  iterator;
+   typedef _Iterator<const Pair,const FlatHashMap>  const_iterator;
+
+   // Initialization
+   FlatHashMap();
+   ~FlatHashMap();
+   FlatHashMap(const FlatHashMap& p);
+
+   // Management
+   U32  size() const;                  ///< Return the number of elements
+   U32  capacity() const;              ///< Return the number of slots
+   U32  memSize() const;               ///< Return the bytes used by the slot storage
+   void clear();                       ///< Empty the map but keep the slot storage
+   void compact();                     ///< Shrink the slot storage to fit the current size
+   void reserve(U32 size);             ///< Make room for the given number of elements
+   bool isEmpty() const;               ///< Returns true if the map is empty
+   F32  averageProbeDistance() const;  ///< Returns the average distance of an entry from its home slot
+
+   // Insert & erase elements
+   iterator insert(const Key& key, const Value&); // Documented below...
+   void erase(iterator);               ///< Erase the given entry
+   void erase(const Key& key);         ///< Erase the key from the map
+
+   // Lookup
+   iterator find(const Key&);          ///< Find entry for the given key
+   const_iterator find(const Key&) const;    ///< Find entry for the given key
+   bool contains(const Key& key) const
+   {
+      return _find(key) != InvalidIndex;
+   }
+
+   // Forward iterator access
+   iterator       begin();             ///< iterator to first element
+   const_iterator begin() const;       ///< iterator to first element
+   iterator       end();               ///< iterator to last element + 1
+   const_iterator end() const;         ///< iterator to last element + 1
+
+   // operators
+   Value& operator[](const Key&);      ///< Index using the given key. If the key is not currently in the map it is added.
+   void operator=(const FlatHashMap& p);
+};
+
+
+template<typename Key, typename Value> FlatHashMap<Key,Value>::FlatHashMap()
+{
+   mDistances = NULL;
+   mSlots = NULL;
+   mCapacity = 0;
+   mSize = 0;
+}
+
+template<typename Key, typename Value> FlatHashMap<Key,Value>::FlatHashMap(const FlatHashMap& p)
+{
+   mDistances = NULL;
+   mSlots = NULL;
+   mCapacity = 0;
+   mSize = 0;
+   *this = p;
+}
+
+template<typename Key, typename Value> FlatHashMap<Key,Value>::~FlatHashMap()
+{
+   _destroy();
+}
+
+
+//-----------------------------------------------------------------------------
+
+template<typename Key, typename Value>
+inline U32 FlatHashMap<Key,Value>::_home(const Key& key) const
+{
+   return FlatHash::slotHash(key) & (mCapacity - 1);
+}
+
+template<typename Key, typename Value>
+U32 FlatHashMap<Key,Value>::_find(const Key& key) const
+{
+   if (!mSize)
+      return InvalidIndex;
+
+   const U32 mask = mCapacity - 1;
+   U32 index = _home(key);
+
+   // Stop as soon as an entry is closer to home than the key would be.
+   for (U32 distance = 1; mDistances[index] >= distance; distance++)
+   {
+      if ( tKeyCompare::equals<Key>( mSlots[index].key, key ) )
+         return index;
+      index = (index + 1) & mask;
+   }
+
+   return InvalidIndex;
+}
+
+template<typename Key, typename Value>
+inline U32 FlatHashMap<Key,Value>::_next(U32 index) const
+{
+   while (index < mCapacity && !mDistances[index])
+      index++;
+   return index < mCapacity ? index : InvalidIndex;
+}
+
+/// Inserts the key unless it is already present.  The slot holding the key is
+/// returned in <i>index</i> in either case.
+template<typename Key, typename Value>
+bool FlatHashMap<Key,Value>::_insert(const Key& key, const Value& value, U32& index)
+{
+   index = _find(key);
+   if (index != InvalidIndex)
+      return false;
+
+   if ((mSize + 1) * MaxLoadDenominator > mCapacity * MaxLoadNumerator)
+      _rehash(mCapacity ? mCapacity * 2 : MinimumCapacity);
+
+   const U32 mask = mCapacity - 1;
+   Pair entry(key,value);
+   U32 distance = 1;
+   U32 slot = _home(key);
+   index = InvalidIndex;
+
+   for (;;)
+   {
+      if (!mDistances[slot])
+      {
+         constructInPlace(&mSlots[slot], &entry);
+         mDistances[slot] = (U8)distance;
+         mSize++;
+         if (index == InvalidIndex)
+            index = slot;
+         return true;
+      }
+
+      // Take the slot from a richer entry and carry on inserting that instead.
+      if (mDistances[slot] < distance)
+      {
+         Pair displaced = mSlots[slot];
+         const U32 displacedDistance = mDistances[slot];
+         mSlots[slot] = entry;
+         mDistances[slot] = (U8)distance;
+         entry = displaced;
+         distance = displacedDistance;
+         if (index == InvalidIndex)
+            index = slot;
+      }
+
+      slot = (slot + 1) & mask;
+      distance++;
+
+      // A pathological hash; spread things out and start again.
+      if (distance > MaxProbeDistance)
+      {
+         _rehash(mCapacity * 2);
+         U32 unused;
+         _insert(entry.key, entry.value, unused);
+         index = _find(key);
+         return true;
+      }
+   }
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::_erase(U32 index)
+{
+   const U32 mask = mCapacity - 1;
+
+   // Shift the following entries back a slot until one is already home.
+   U32 next = (index + 1) & mask;
+   while (mDistances[next] > 1)
+   {
+      mSlots[index] = mSlots[next];
+      mDistances[index] = mDistances[next] - 1;
+      index = next;
+      next = (next + 1) & mask;
+   }
+
+   destructInPlace(&mSlots[index]);
+   mDistances[index] = 0;
+   mSize--;
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::_rehash(U32 capacity)
+{
+   U8* distances = mDistances;
+   Pair* slots = mSlots;
+   const U32 oldCapacity = mCapacity;
+
+   mCapacity = capacity;
+
+   // Slots and distances share one allocation.
+   mSlots = (Pair*)dMalloc(capacity * (sizeof(Pair) + sizeof(U8)));
+   mDistances = (U8*)(mSlots + capacity);
+   dMemset(mDistances, 0, capacity);
+   mSize = 0;
+
+   for (U32 index = 0; index < oldCapacity; index++)
+   {
+      if (!distances[index])
+         continue;
+
+      U32 unused;
+      _insert(slots[index].key, slots[index].value, unused);
+      destructInPlace(&slots[index]);
+   }
+
+   dFree(slots);
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::_destroy()
+{
+   for (U32 index = 0; index < mCapacity; index++)
+      if (mDistances[index])
+         destructInPlace(&mSlots[index]);
+
+   dFree(mSlots);
+   mSlots = NULL;
+   mDistances = NULL;
+   mCapacity = 0;
+   mSize = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// management
+
+template<typename Key, typename Value>
+inline U32 FlatHashMap<Key,Value>::size() const
+{
+   return mSize;
+}
+
+template<typename Key, typename Value>
+inline U32 FlatHashMap<Key,Value>::capacity() const
+{
+   return mCapacity;
+}
+
+template<typename Key, typename Value>
+inline U32 FlatHashMap<Key,Value>::memSize() const
+{
+   return mCapacity * (sizeof(Pair) + sizeof(U8));
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::clear()
+{
+   if (!mSize)
+      return;
+
+   for (U32 index = 0; index < mCapacity; index++)
+      if (mDistances[index])
+         destructInPlace(&mSlots[index]);
+
+   dMemset(mDistances, 0, mCapacity);
+   mSize = 0;
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::compact()
+{
+   if (!mSize)
+   {
+      _destroy();
+      return;
+   }
+
+   U32 capacity = MinimumCapacity;
+   while (mSize * MaxLoadDenominator > capacity * MaxLoadNumerator)
+      capacity <<= 1;
+
+   if (capacity < mCapacity)
+      _rehash(capacity);
+}
+
+/// Make room for an estimated number of elements.
+/// Normally this function is used to avoid rehashing when the number of
+/// elements that will be inserted is known in advance.
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::reserve(U32 size)
+{
+   U32 capacity = mCapacity ? mCapacity : (U32)MinimumCapacity;
+   while (size * MaxLoadDenominator > capacity * MaxLoadNumerator)
+      capacity <<= 1;
+
+   if (capacity > mCapacity)
+      _rehash(capacity);
+}
+
+template<typename Key, typename Value>
+inline bool FlatHashMap<Key,Value>::isEmpty() const
+{
+   return mSize == 0;
+}
+
+template<typename Key, typename Value>
+F32 FlatHashMap<Key,Value>::averageProbeDistance() const
+{
+   if (!mSize)
+      return 0.0f;
+
+   U32 total = 0;
+   for (U32 index = 0; index < mCapacity; index++)
+      if (mDistances[index])
+         total += mDistances[index] - 1;
+   return F32(total) / mSize;
+}
+
+
+//-----------------------------------------------------------------------------
+// add & remove elements
+
+/// Insert the key value pair but don't allow duplicates.
+/// If the key already exists in the map the function will fail and return end().
+template<typename Key, typename Value>
+typename FlatHashMap<Key,Value>::iterator FlatHashMap<Key,Value>::insert(const Key& key, const Value& x)
+{
+   U32 index;
+   if (!_insert(key, x, index))
+      return end();
+   return iterator(this,index);
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::erase(iterator node)
+{
+   AssertFatal(node.mMap == this && node.mIndex < mCapacity && mDistances[node.mIndex], "FlatHashMap::erase() - Invalid iterator.");
+   _erase(node.mIndex);
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::erase(const Key& key)
+{
+   const U32 index = _find(key);
+   if (index != InvalidIndex)
+      _erase(index);
+}
+
+
+//-----------------------------------------------------------------------------
+// lookup
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::iterator FlatHashMap<Key,Value>::find(const Key& key)
+{
+   return iterator(this,_find(key));
+}
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::const_iterator FlatHashMap<Key,Value>::find(const Key& key) const
+{
+   return const_iterator(this,_find(key));
+}
+
+
+//-----------------------------------------------------------------------------
+// iterator access
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::iterator FlatHashMap<Key,Value>::begin()
+{
+   return iterator(this,mSize ? _next(0) : InvalidIndex);
+}
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::const_iterator FlatHashMap<Key,Value>::begin() const
+{
+   return const_iterator(this,mSize ? _next(0) : InvalidIndex);
+}
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::iterator FlatHashMap<Key,Value>::end()
+{
+   return iterator(this,InvalidIndex);
+}
+
+template<typename Key, typename Value>
+inline typename FlatHashMap<Key,Value>::const_iterator FlatHashMap<Key,Value>::end() const
+{
+   return const_iterator(this,InvalidIndex);
+}
+
+
+//-----------------------------------------------------------------------------
+// operators
+
+template<typename Key, typename Value>
+inline Value& FlatHashMap<Key,Value>::operator[](const Key& key)
+{
+   U32 index;
+   _insert(key, Value(), index);
+   return mSlots[index].value;
+}
+
+template<typename Key, typename Value>
+void FlatHashMap<Key,Value>::operator=(const FlatHashMap& p)
+{
+   if (this == &p)
+      return;
+
+   _destroy();
+   if (!p.mSize)
+      return;
+
+   _rehash(p.mCapacity);
+   for (U32 index = 0; index < p.mCapacity; index++)
+   {
+      if (p.mDistances[index])
+      {
+         constructInPlace(&mSlots[index], &p.mSlots[index]);
+         mDistances[index] = p.mDistances[index];
+      }
+   }
+   mSize = p.mSize;
+}
+
+#endif // _FLATHASHMAP_H_
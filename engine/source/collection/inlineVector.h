@@ -0,0 +1,358 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _INLINEVECTOR_H_
+#define _INLINEVECTOR_H_
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+//-----------------------------------------------------------------------------
+/// A dynamic array that keeps its first <i>InlineCount</i> elements inside
+/// the object itself.
+///
+/// Small, short-lived lists (contact lists, per-frame pick results and the
+/// like) never touch the heap.  Once the inline storage is exhausted the
+/// elements are relocated to heap storage that grows geometrically just
+/// like Vector<T>.  The same restrictions as Vector<T> apply; elements are
+/// relocated bitwise so they must not hold pointers into themselves.
+/// Unlike Vector<T>, elements are destructed when they are removed and
+/// when the vector itself is destroyed.
+template<class T, U32 InlineCount>
+class InlineVector
+{
+  protected:
+   /// Inline element storage.  The unused members only exist to give the
+   /// storage the strictest fundamental alignment.
+   union InlineStorage
+   {
+      U8          mBytes[InlineCount * sizeof(T)];
+      F64         mAlignDouble;
+      U64         mAlignInteger;
+      void*       mAlignPointer;
+      long double mAlignLongDouble;
+   };
+
+   U32           mElementCount;
+   U32           mArraySize;
+   T*            mArray;
+   InlineStorage mInline;
+
+   T*   inlineAddress() const { return (T*)mInline.mBytes; }
+   void grow(U32 count);
+   void relocate(U32 capacity);
+   void destructElements(U32 start, U32 end);
+
+  public:
+   InlineVector();
+   InlineVector(const InlineVector&);
+   ~InlineVector();
+
+   InlineVector& operator=(const InlineVector& p);
+
+   /// @name STL interface
+   /// @{
+
+   typedef T        value_type;
+   typedef T&       reference;
+   typedef const T& const_reference;
+
+   typedef T*       iterator;
+   typedef const T* const_iterator;
+   typedef S32      difference_type;
+   typedef U32      size_type;
+
+   iterator       begin()       { return mArray; }
+   const_iterator begin() const { return mArray; }
+   iterator       end()         { return mArray + mElementCount; }
+   const_iterator end() const   { return mArray + mElementCount; }
+
+   S32  size() const     { return (S32)mElementCount; }
+   bool empty() const    { return mElementCount == 0; }
+   U32  capacity() const { return mArraySize; }
+   bool contains(const T&) const;
+
+   T&       operator[](U32 index);
+   const T& operator[](U32 index) const;
+
+   void push_back(const T&);
+   void pop_back();
+   void reserve(U32);
+
+   /// @}
+
+   /// @name Extended interface
+   /// @{
+
+   T*   address() const { return mArray; }
+   bool isInline() const { return mArray == inlineAddress(); }
+   U32  setSize(U32);
+   void increment(U32 = 1);
+   void decrement(U32 = 1);
+   void erase(U32);
+   void erase_fast(U32);
+   void clear();
+   void compact();
+   T&   first();
+   T&   last();
+   const T& first() const;
+   const T& last() const;
+
+   /// @}
+};
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 InlineCount> inline InlineVector<T, InlineCount>::InlineVector()
+{
+   mElementCount = 0;
+   mArraySize    = InlineCount;
+   mArray        = inlineAddress();
+}
+
+template<class T, U32 InlineCount> inline InlineVector<T, InlineCount>::InlineVector(const InlineVector& p)
+{
+   mElementCount = 0;
+   mArraySize    = InlineCount;
+   mArray        = inlineAddress();
+   *this = p;
+}
+
+template<class T, U32 InlineCount> inline InlineVector<T, InlineCount>::~InlineVector()
+{
+   destructElements(0, mElementCount);
+
+   if (!isInline())
+      dFree(mArray);
+}
+
+template<class T, U32 InlineCount> inline InlineVector<T, InlineCount>& InlineVector<T, InlineCount>::operator=(const InlineVector& p)
+{
+   if (this == &p)
+      return *this;
+
+   clear();
+
+   if (p.mElementCount > mArraySize)
+      relocate(VectorGrowCapacity(0, p.mElementCount));
+
+   for (U32 index = 0; index < p.mElementCount; ++index)
+      constructInPlace(&mArray[index], &p.mArray[index]);
+   mElementCount = p.mElementCount;
+
+   return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::relocate(U32 capacity)
+{
+   AssertFatal(capacity >= mElementCount, "InlineVector<T>::relocate - capacity is smaller than the element count.");
+
+   if (capacity <= InlineCount)
+   {
+      // Move back into the inline storage.
+      if (!isInline())
+      {
+         if (mElementCount)
+            dMemcpy(inlineAddress(), mArray, mElementCount * sizeof(T));
+         dFree(mArray);
+         mArray = inlineAddress();
+      }
+
+      mArraySize = InlineCount;
+      return;
+   }
+
+   if (isInline())
+   {
+      T* pArray = (T*)dMalloc(capacity * sizeof(T));
+      if (mElementCount)
+         dMemcpy(pArray, mArray, mElementCount * sizeof(T));
+      mArray = pArray;
+   }
+   else
+   {
+      mArray = (T*)dRealloc(mArray, capacity * sizeof(T));
+   }
+
+   mArraySize = capacity;
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::destructElements(U32 start, U32 end)
+{
+   for (U32 index = start; index < end; ++index)
+      destructInPlace(&mArray[index]);
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::grow(U32 count)
+{
+   relocate(VectorGrowCapacity(mArraySize, count));
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::reserve(U32 size)
+{
+   if (size > mArraySize)
+      relocate(((size + VectorBlockSize - 1) / VectorBlockSize) * VectorBlockSize);
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::compact()
+{
+   if (isInline())
+      return;
+
+   relocate(mElementCount <= InlineCount ? InlineCount : ((mElementCount + VectorBlockSize - 1) / VectorBlockSize) * VectorBlockSize);
+}
+
+//-----------------------------------------------------------------------------
+
+template<class T, U32 InlineCount> inline bool InlineVector<T, InlineCount>::contains(const T& x) const
+{
+   for (const_iterator itr = begin(); itr != end(); ++itr)
+   {
+      if (*itr == x)
+         return true;
+   }
+
+   return false;
+}
+
+template<class T, U32 InlineCount> inline T& InlineVector<T, InlineCount>::operator[](U32 index)
+{
+   AssertFatal(index < mElementCount, "InlineVector<T>::operator[] - out of bounds array access!");
+   return mArray[index];
+}
+
+template<class T, U32 InlineCount> inline const T& InlineVector<T, InlineCount>::operator[](U32 index) const
+{
+   AssertFatal(index < mElementCount, "InlineVector<T>::operator[] - out of bounds array access!");
+   return mArray[index];
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::push_back(const T& x)
+{
+   if (mElementCount == mArraySize)
+      grow(mElementCount + 1);
+
+   constructInPlace(&mArray[mElementCount++], &x);
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::pop_back()
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::pop_back - cannot pop the back of a zero-length vector.");
+   decrement();
+}
+
+template<class T, U32 InlineCount> inline U32 InlineVector<T, InlineCount>::setSize(U32 size)
+{
+   if (size > mArraySize)
+      grow(size);
+
+   if (size < mElementCount)
+   {
+      destructElements(size, mElementCount);
+      mElementCount = size;
+   }
+   else
+   {
+      while (mElementCount < size)
+         constructInPlace(&mArray[mElementCount++]);
+   }
+
+   return mElementCount;
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::increment(U32 delta)
+{
+   const U32 count = mElementCount;
+   if (count + delta > mArraySize)
+      grow(count + delta);
+
+   mElementCount += delta;
+   for (U32 index = count; index < mElementCount; ++index)
+      constructInPlace(&mArray[index]);
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::decrement(U32 delta)
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::decrement - cannot decrement zero-length vector.");
+
+   const U32 count = mElementCount;
+   mElementCount = mElementCount > delta ? mElementCount - delta : 0;
+
+   destructElements(mElementCount, count);
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::clear()
+{
+   destructElements(0, mElementCount);
+   mElementCount = 0;
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::erase(U32 index)
+{
+   AssertFatal(index < mElementCount, "InlineVector<T>::erase - out of bounds index!");
+
+   destructInPlace(&mArray[index]);
+   if (index < (mElementCount - 1))
+      dMemmove(&mArray[index], &mArray[index + 1], (mElementCount - index - 1) * sizeof(T));
+
+   mElementCount--;
+}
+
+template<class T, U32 InlineCount> inline void InlineVector<T, InlineCount>::erase_fast(U32 index)
+{
+   AssertFatal(index < mElementCount, "InlineVector<T>::erase_fast - out of bounds index.");
+
+   // CAUTION: this does NOT maintain list order.
+   destructInPlace(&mArray[index]);
+   if (index < (mElementCount - 1))
+      dMemcpy(&mArray[index], &mArray[mElementCount - 1], sizeof(T));
+   mElementCount--;
+}
+
+template<class T, U32 InlineCount> inline T& InlineVector<T, InlineCount>::first()
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::first - Error, no first element of a zero sized array!");
+   return mArray[0];
+}
+
+template<class T, U32 InlineCount> inline const T& InlineVector<T, InlineCount>::first() const
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::first - Error, no first element of a zero sized array! (const)");
+   return mArray[0];
+}
+
+template<class T, U32 InlineCount> inline T& InlineVector<T, InlineCount>::last()
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::last - Error, no last element of a zero sized array!");
+   return mArray[mElementCount - 1];
+}
+
+template<class T, U32 InlineCount> inline const T& InlineVector<T, InlineCount>::last() const
+{
+   AssertFatal(mElementCount != 0, "InlineVector<T>::last - Error, no last element of a zero sized array! (const)");
+   return mArray[mElementCount - 1];
+}
+
+#endif // _INLINEVECTOR_H_
@@ -24,17 +24,51 @@
 
 //-----------------------------------------------------------------------------
 
+U32 VectorGrowCapacity(U32 capacity, U32 newCount)
+{
+   // Grow by half of the current capacity so that a run of push_back() calls
+   // costs O(log n) reallocations rather than one every VectorBlockSize elements.
+   U32 target = capacity + (capacity >> 1);
+   if (target < newCount || target < capacity)
+      target = newCount;
+
+   return ((target + VectorBlockSize - 1) / VectorBlockSize) * VectorBlockSize;
+}
+
+//-----------------------------------------------------------------------------
+
+static inline U32 VectorTargetCapacity(const U32 capacity, const U32 newCount, const bool exactFit)
+{
+   if (exactFit)
+      return ((newCount + VectorBlockSize - 1) / VectorBlockSize) * VectorBlockSize;
+
+   return VectorGrowCapacity(capacity, newCount);
+}
+
+//-----------------------------------------------------------------------------
+
 #ifdef TORQUE_DEBUG
 
-bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize,
+bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, bool exactFit,
                   const char* fileName,
                   const U32   lineNum)
 {
    if (newCount > 0) {
-      U32 blocks = newCount / VectorBlockSize;
-      if (newCount % VectorBlockSize)
-         blocks++;
-      S32 mem_size = blocks * VectorBlockSize * elemSize;
+      const U32 currentSize = *arrayPtr != NULL ? *aSize : 0;
+
+      // Storage is only ever given back on an explicit compaction.
+      if (newCount <= currentSize && !exactFit) {
+         *aCount = newCount;
+         return true;
+      }
+
+      const U32 newSize = VectorTargetCapacity(currentSize, newCount, exactFit);
+      if (newSize == currentSize) {
+         *aCount = newCount;
+         return true;
+      }
+
+      S32 mem_size = newSize * elemSize;
 
       const char* pUseFileName = fileName != NULL ? fileName : __FILE__;
       U32 useLineNum           = fileName != NULL ? lineNum  : __LINE__;
@@ -49,7 +83,7 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
       }
 
       *aCount = newCount;
-      *aSize = blocks * VectorBlockSize;
+      *aSize = newSize;
       return true;
    }
 
@@ -65,19 +99,32 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
 
 #else
 
-bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize )
+bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, bool exactFit )
 {
    if (newCount > 0)
    {
-      U32 blocks = newCount / VectorBlockSize;
-      if (newCount % VectorBlockSize)
-         blocks++;
-      S32 mem_size = blocks * VectorBlockSize * elemSize;
+      const U32 currentSize = *arrayPtr != NULL ? *aSize : 0;
+
+      // Storage is only ever given back on an explicit compaction.
+      if (newCount <= currentSize && !exactFit)
+      {
+         *aCount = newCount;
+         return true;
+      }
+
+      const U32 newSize = VectorTargetCapacity(currentSize, newCount, exactFit);
+      if (newSize == currentSize)
+      {
+         *aCount = newCount;
+         return true;
+      }
+
+      S32 mem_size = newSize * elemSize;
       *arrayPtr = *arrayPtr ? dRealloc(*arrayPtr,mem_size) :
          dMalloc(mem_size);
 
       *aCount = newCount;
-      *aSize = blocks * VectorBlockSize;
+      *aSize = newSize;
       return true;
    }
 
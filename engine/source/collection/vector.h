@@ -33,12 +33,19 @@
 /// Size of memory blocks to allocate at a time for vectors.
 const static S32 VectorBlockSize = 16;
 
+/// Returns the capacity a vector currently holding <i>capacity</i> elements
+/// should grow to so that it can hold <i>newCount</i> elements.
+extern U32 VectorGrowCapacity(U32 capacity, U32 newCount);
+
+/// Resizes vector storage.  Growth is geometric unless <i>exactFit</i> is set,
+/// and storage is only ever shrunk when <i>exactFit</i> is set or the new
+/// count is zero.
 #ifdef TORQUE_DEBUG
-extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize,
+extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, bool exactFit,
                          const char* fileName,
                          const U32   lineNum);
 #else
-extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize);
+extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize, bool exactFit);
 #endif
 
 /// Use the following macro to bind a vector to a particular line
@@ -57,6 +64,10 @@ extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount,
 /// of the array can be avoided by pre-allocating space using the
 /// reserve() method.
 ///
+/// Capacity grows geometrically and is never given back when elements
+/// are removed; call compact() to trim the storage to fit.  Elements are
+/// relocated bitwise when the storage moves.
+///
 /// <b>***WARNING***</b>
 ///
 /// This template does not initialize, construct or destruct any of
@@ -79,7 +90,7 @@ class Vector
    U32         mLineAssociation;
 #endif
 
-   bool  resize(U32); // resizes, but does no construction/destruction
+   bool  resize(U32, bool exactFit = false); // resizes, but does no construction/destruction
    void  destroy(U32 start, U32 end);   ///< Destructs elements from <i>start</i> to <i>end-1</i>
    void  construct(U32 start, U32 end); ///< Constructs elements from <i>start</i> to <i>end-1</i>
    void  construct(U32 start, U32 end, const T* array);
@@ -240,8 +251,10 @@ template<class T> inline Vector<T>::Vector(const Vector& p)
    mLineAssociation = p.mLineAssociation;
 #endif
 
-   mArray = 0;
-   resize(p.mElementCount);
+   mArray        = 0;
+   mElementCount = 0;
+   mArraySize    = 0;
+   resize(p.mElementCount, true);
    if (p.mElementCount)
       dMemcpy(mArray,p.mArray,mElementCount * sizeof(value_type));
 }
@@ -370,7 +383,7 @@ template<class T> inline void Vector<T>::erase_fast(U32 index)
    //   size of the vector.
    // Assert: index >= 0 && index < mElementCount
    if (index < (mElementCount - 1))
-      dMemmove(&mArray[index], &mArray[mElementCount - 1], sizeof(value_type));
+      dMemcpy(&mArray[index], &mArray[mElementCount - 1], sizeof(value_type));
    decrement();
 }
 
@@ -405,7 +418,7 @@ template<class T> inline void Vector<T>::clear()
 
 template<class T> inline void Vector<T>::compact()
 {
-   resize(mElementCount);
+   resize(mElementCount, true);
 }
 
 typedef int (QSORT_CALLBACK *qsort_compare_func)(const void *, const void *);
@@ -596,7 +609,7 @@ template<class T> inline void Vector<T>::reserve(U32 size)
       return;
 
    const U32 ec = mElementCount;
-   if (resize(size))
+   if (resize(size, true))
       mElementCount = ec;
 }
 
@@ -614,13 +627,13 @@ template<class T> inline void Vector<T>::set(void * addr, U32 sz)
 
 //-----------------------------------------------------------------------------
 
-template<class T> inline bool Vector<T>::resize(U32 ecount)
+template<class T> inline bool Vector<T>::resize(U32 ecount, bool exactFit)
 {
 #ifdef TORQUE_DEBUG
-   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T),
+   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T), exactFit,
                        mFileAssociation, mLineAssociation);
 #else
-   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T));
+   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T), exactFit);
 #endif
 }
 
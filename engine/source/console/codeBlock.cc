@@ -471,6 +471,35 @@ bool CodeBlock::read(StringTableEntry fileName, Stream &st)
 
 
 bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, const char *script)
+{
+   // Parse before opening the output so a syntax error never leaves a truncated DSO behind.
+   if(!parseScript(fileName, script))
+      return false;
+
+   FileStream st;
+   if(!ResourceManager->openFileForWrite(st, codeFileName)) 
+   {
+      consoleAllocReset();
+      return false;
+   }
+
+   writeCompiled(st);
+   st.close();
+
+   return true;
+}
+
+bool CodeBlock::compile(Stream &st, StringTableEntry fileName, const char *script)
+{
+   if(!parseScript(fileName, script))
+      return false;
+
+   writeCompiled(st);
+
+   return true;
+}
+
+bool CodeBlock::parseScript(StringTableEntry fileName, const char *script)
 {
    gSyntaxError = false;
 
@@ -495,9 +524,11 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
       return false;
    }   
 
-   FileStream st;
-   if(!ResourceManager->openFileForWrite(st, codeFileName)) 
-      return false;
+   return true;
+}
+
+void CodeBlock::writeCompiled(Stream &st)
+{
    st.write(DSO_VERSION);
 
    // Reset all our value tables...
@@ -559,9 +590,6 @@ bool CodeBlock::compile(const char *codeFileName, StringTableEntry fileName, con
    getIdentTable().write(st);
 
    consoleAllocReset();
-   st.close();
-
-   return true;
 }
 
 const char *CodeBlock::compileExec(StringTableEntry fileName, const char *string, bool noCalls, int setFrame)
@@ -37,6 +37,9 @@ class CodeBlock
 private:
    static CodeBlock* smCodeBlockList;
    static CodeBlock* smCurrentCodeBlock;
+
+   bool parseScript(StringTableEntry fileName, const char *script);
+   void writeCompiled(Stream &st);
    
 public:
    static U32                       smBreakLineCount;
@@ -107,6 +110,10 @@ public:
    bool read(StringTableEntry fileName, Stream &st);
    bool compile(const char *dsoName, StringTableEntry fileName, const char *script);
 
+   /// Compiles a script and writes the resulting DSO image, including its version
+   /// header, to the current position of the given stream.
+   bool compile(Stream &st, StringTableEntry fileName, const char *script);
+
    void incRefCount();
    void decRefCount();
 
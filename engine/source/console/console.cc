@@ -33,6 +33,7 @@
 #include "debug/telnetDebugger.h"
 #include "sim/simBase.h"
 #include "console/compiler.h"
+#include "console/scriptBundle.h"
 #include "string/stringStack.h"
 #include "component/dynamicConsoleMethodComponent.h"
 #include "memory/safeDelete.h"
@@ -301,6 +302,7 @@ void shutdown()
    active = false;
 
    consoleLogFile.close();
+   ScriptBundle::unloadAll();
    Namespace::shutdown();
 
    SAFE_DELETE( sLogMutex );
@@ -0,0 +1,166 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "console/consoleCallback.h"
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+#ifndef _AST_H_
+#include "console/ast.h"
+#endif
+
+#ifndef _STRINGSTACK_H_
+#include "string/stringStack.h"
+#endif
+
+#ifndef _DYNAMIC_CONSOLEMETHOD_COMPONENT_H_
+#include "component/dynamicConsoleMethodComponent.h"
+#endif
+
+#include <stdarg.h>
+
+//-----------------------------------------------------------------------------
+
+extern StringStack STR;
+
+//-----------------------------------------------------------------------------
+
+ConsoleCallback::ConsoleCallback( const char* pMethodName ) :
+    mpMethodName( pMethodName ),
+    mMethodName( NULL ),
+    mCacheSequence( 0 )
+{
+    // Sanity!
+    AssertFatal( pMethodName != NULL && *pMethodName != 0, "ConsoleCallback() - Invalid method name." );
+}
+
+//-----------------------------------------------------------------------------
+
+StringTableEntry ConsoleCallback::getMethodName( void )
+{
+    // The string table may not exist during static initialization so insert on first use.
+    if ( mMethodName == NULL )
+        mMethodName = StringTable->insert( mpMethodName );
+
+    return mMethodName;
+}
+
+//-----------------------------------------------------------------------------
+
+Namespace::Entry* ConsoleCallback::resolve( Namespace* pNamespace )
+{
+    if ( pNamespace == NULL )
+        return NULL;
+
+    // Drop every resolved entry if any function or package has changed.
+    if ( mCacheSequence != Namespace::mCacheSequence )
+    {
+        mEntries.clear();
+        mCacheSequence = Namespace::mCacheSequence;
+    }
+
+    // Use the entry resolved for this namespace if there is one.
+    typeEntryHash::iterator entryItr = mEntries.find( pNamespace );
+    if ( entryItr != mEntries.end() )
+        return entryItr->value;
+
+    // Resolve and keep it, including a missing method.
+    Namespace::Entry* pEntry = pNamespace->lookup( getMethodName() );
+    mEntries.insert( pNamespace, pEntry );
+
+    return pEntry;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ConsoleCallback::isDefined( SimObject* pObject )
+{
+    return resolve( pObject->getNamespace() ) != NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* ConsoleCallback::execute( SimObject* pObject, S32 argc, const char** argv )
+{
+    // Sanity!
+    AssertFatal( argc >= 0 && argc <= MaxArguments, "ConsoleCallback::execute() - Invalid argument count." );
+
+    // Build the argument frame in the same layout Con::execute() uses.
+    const char* args[MaxArguments+2];
+    args[0] = getMethodName();
+    args[1] = pObject->getIdString();
+    for ( S32 index = 0; index < argc; ++index )
+        args[index+2] = argv[index];
+
+    // Let any dynamic console method component handle the call first.
+    DynamicConsoleMethodComponent* pComponent = dynamic_cast<DynamicConsoleMethodComponent*>( pObject );
+    if ( pComponent != NULL )
+    {
+        args[1] = args[0];
+        pComponent->callMethodArgList( argc+2, args, false );
+        args[1] = pObject->getIdString();
+    }
+
+    Namespace::Entry* pEntry = resolve( pObject->getNamespace() );
+
+    // Finish if the method is not defined.
+    if ( pEntry == NULL )
+    {
+        // Clean up arg buffers, if any.
+        STR.clearFunctionOffset();
+        return "";
+    }
+
+    pObject->pushScriptCallbackGuard();
+
+    SimObject* pSavedThis = gEvalState.thisObject;
+    gEvalState.thisObject = pObject;
+    const char* pResult = pEntry->execute( argc+2, args, &gEvalState );
+    gEvalState.thisObject = pSavedThis;
+
+    pObject->popScriptCallbackGuard();
+
+    // Reset the function offset so the stack doesn't continue to grow unnecessarily.
+    STR.clearFunctionOffset();
+
+    return pResult;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* ConsoleCallback::executef( SimObject* pObject, S32 argc, ... )
+{
+    // Sanity!
+    AssertFatal( argc >= 0 && argc <= MaxArguments, "ConsoleCallback::executef() - Invalid argument count." );
+
+    const char* argv[MaxArguments];
+
+    va_list args;
+    va_start( args, argc );
+    for( S32 index = 0; index < argc; ++index )
+        argv[index] = va_arg( args, const char* );
+    va_end( args );
+
+    return execute( pObject, argc, argv );
+}
@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONSOLE_CALLBACK_H_
+#define _CONSOLE_CALLBACK_H_
+
+#ifndef _CONSOLEINTERNAL_H_
+#include "console/consoleInternal.h"
+#endif
+
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
+class SimObject;
+
+//-----------------------------------------------------------------------------
+
+/// A handle to a named script callback that caches its namespace lookup.
+///
+/// Con::executef() inserts the method name into the string table, looks it up in
+/// the object namespace and formats the object id on every call.  A callback handle
+/// resolves its entry once per namespace it is used against and keeps each result,
+/// so callbacks alternating between object types don't evict each other.  All results
+/// are dropped when any function or package has changed since, which is tracked by
+/// Namespace::mCacheSequence.
+///
+/// Handles are intended to be declared once per call-site, typically as statics.
+/// The method name is inserted into the string table on first use so handles are
+/// safe to construct during static initialization.
+class ConsoleCallback
+{
+public:
+    enum
+    {
+        MaxArguments = 16,
+    };
+
+private:
+    typedef FlatHashMap<Namespace*, Namespace::Entry*> typeEntryHash;
+
+    const char*         mpMethodName;
+    StringTableEntry    mMethodName;
+    typeEntryHash       mEntries;
+    U32                 mCacheSequence;
+
+    Namespace::Entry* resolve( Namespace* pNamespace );
+
+public:
+    ConsoleCallback( const char* pMethodName );
+
+    StringTableEntry getMethodName( void );
+
+    /// The number of namespaces the callback currently has a resolved entry for.
+    U32 getResolvedCount( void ) const { return mEntries.size(); }
+
+    /// Whether the object namespace defines the callback method.
+    bool isDefined( SimObject* pObject );
+
+    /// Executes the callback on the object.
+    /// @param argc The number of arguments excluding the method name and "%this".
+    /// @param argv The arguments excluding the method name and "%this".
+    /// @return The script return value or an empty string if the method is not defined.
+    const char* execute( SimObject* pObject, S32 argc = 0, const char** argv = NULL );
+
+    /// Executes the callback on the object with the arguments passed as strings.
+    /// @param argc The number of arguments that follow.
+    const char* executef( SimObject* pObject, S32 argc, ... );
+};
+
+#endif // _CONSOLE_CALLBACK_H_
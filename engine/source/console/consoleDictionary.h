@@ -160,6 +160,7 @@ public:
     void setState(ExprEvalState *state, Dictionary* ref=NULL);
     void remove(Entry *);
     void reset();
+    inline bool ownsHashTable() const { return hashTable->owner == this; }
 
     void exportVariables(const char *varString, const char *fileName, bool append);
     void deleteVariables(const char *varString);
@@ -38,7 +38,16 @@ extern ExprEvalState gEvalState;
 
 void ExprEvalState::pushFrame(StringTableEntry frameName, Namespace *ns)
 {
-   Dictionary *newFrame = new Dictionary(this);
+   Dictionary *newFrame;
+   if(framePool.size())
+   {
+      newFrame = framePool.last();
+      framePool.pop_back();
+   }
+   else
+   {
+      newFrame = new Dictionary(this);
+   }
    newFrame->scopeName = frameName;
    newFrame->scopeNamespace = ns;
    stack.push_back(newFrame);
@@ -48,7 +57,20 @@ void ExprEvalState::popFrame()
 {
    Dictionary *last = stack.last();
    stack.pop_back();
-   delete last;
+
+   // Frame references share another frame's variables so they can't be reused.
+   if(!last->ownsHashTable() || framePool.size() >= MaxPooledFrames)
+   {
+      delete last;
+      return;
+   }
+
+   last->reset();
+   last->scopeName = NULL;
+   last->scopeNamespace = NULL;
+   last->code = NULL;
+   last->ip = 0;
+   framePool.push_back(last);
 }
 
 void ExprEvalState::pushFrameRef(S32 stackIndex)
@@ -61,6 +83,7 @@ void ExprEvalState::pushFrameRef(S32 stackIndex)
 ExprEvalState::ExprEvalState()
 {
    VECTOR_SET_ASSOCIATION(stack);
+   VECTOR_SET_ASSOCIATION(framePool);
    globalVars.setState(this);
    thisObject = NULL;
    traceOn = false;
@@ -70,6 +93,9 @@ ExprEvalState::~ExprEvalState()
 {
    while(stack.size())
       popFrame();
+
+   for(S32 i = 0; i < framePool.size(); i++)
+      delete framePool[i];
 }
 
 ConsoleFunction(backtrace, void, 1, 1, "() Use the backtrace function to print the current callstack to the console. This is used to trace functions called from withing functions and can help discover what functions were called (and not yet exited) before the current point in your scripts.\n"
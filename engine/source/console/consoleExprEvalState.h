@@ -63,6 +63,11 @@ public:
     void pushFrame(StringTableEntry frameName, Namespace *ns);
     void popFrame();
 
+    /// Frames popped off the stack are kept here and reused by pushFrame()
+    /// so that script calls don't allocate a new dictionary every time.
+    Vector<Dictionary *> framePool;
+    enum { MaxPooledFrames = 64 };
+
     /// Puts a reference to an existing stack frame
     /// on the top of the stack.
     void pushFrameRef(S32 stackIndex);
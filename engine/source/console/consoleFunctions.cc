@@ -27,6 +27,7 @@
 #include "io/resource/resourceManager.h"
 #include "io/fileStream.h"
 #include "console/compiler.h"
+#include "console/scriptBundle.h"
 #include "platform/event.h"
 #include "game/gameInterface.h"
 #include "platform/platformInput.h"
@@ -1178,6 +1179,37 @@ ConsoleFunction(exec, bool, 2, 4, "( fileName [ , nocalls [ , journalScript ] ]
    }
 #endif //TORQUE_ALLOW_JOURNALING
 
+   // If a loaded script bundle holds this script then run it straight from the bundle.
+   if(compiled)
+   {
+      Stream *bundleStream = ScriptBundle::openScript(scriptFileName);
+      if(bundleStream)
+      {
+         F32 st1 = (F32)Platform::getRealMilliseconds();
+
+         CodeBlock *code = new CodeBlock;
+         const bool readOk = code->read(scriptFileName, *bundleStream);
+         ScriptBundle::closeScript(bundleStream);
+
+         if(readOk)
+         {
+            code->exec(0, scriptFileName, NULL, 0, NULL, noCalls, NULL, 0);
+
+            F32 et1 = (F32)Platform::getRealMilliseconds();
+
+            if ( scriptExecutionEcho )
+               Con::printf("Loaded bundled script %s. Took %.0f ms", scriptFileName, et1 - st1);
+
+            execDepth--;
+            return true;
+         }
+
+         // Fall back to the script or its DSO.
+         Con::warnf("exec: Could not read bundled script %s, loading it normally.", scriptFileName);
+         delete code;
+      }
+   }
+
    // Ok, we let's try to load and compile the script.
    ResourceObject *rScr = ResourceManager->find(scriptFileName);
    ResourceObject *rCom = NULL;
@@ -0,0 +1,412 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "console/scriptBundle.h"
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _CONSOLEINTERNAL_H_
+#include "console/consoleInternal.h"
+#endif
+
+#ifndef _CODEBLOCK_H_
+#include "console/codeBlock.h"
+#endif
+
+#ifndef _RESMANAGER_H_
+#include "io/resource/resourceManager.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCRIPT_BUNDLE_SIGNATURE     (U32('T') | (U32('S') << 8) | (U32('B') << 16) | (U32('D') << 24))
+
+Vector<ScriptBundle*> ScriptBundle::smLoadedBundles;
+
+//-----------------------------------------------------------------------------
+
+ScriptBundle::ScriptBundle( StringTableEntry bundleFile ) :
+    mBundleFile( bundleFile ),
+    mpBuffer( NULL ),
+    mBufferSize( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+ScriptBundle::~ScriptBundle()
+{
+    if ( mpBuffer != NULL )
+        dFree( mpBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
+StringTableEntry ScriptBundle::getScriptKey( const char* pScriptFile )
+{
+    return StringTable->insert( Platform::stripBasePath( pScriptFile ) );
+}
+
+//-----------------------------------------------------------------------------
+
+S32 ScriptBundle::build( const char* pBundleFile, const char* pScriptExpressions, U32& totalScripts )
+{
+    totalScripts = 0;
+
+    FileStream bundleStream;
+    if ( !ResourceManager->openFileForWrite( bundleStream, pBundleFile ) )
+    {
+        Con::warnf( "ScriptBundle::build() - Could not open bundle file '%s' for write.", pBundleFile );
+        return -1;
+    }
+
+    // Write the header.  The directory offset and entry count are patched once all scripts are written.
+    bundleStream.write( (U32)SCRIPT_BUNDLE_SIGNATURE );
+    bundleStream.write( (U32)DSO_VERSION );
+    bundleStream.write( (U32)0 );
+    bundleStream.write( (U32)0 );
+
+    Vector<StringTableEntry> scriptKeys;
+    Vector<Entry> scriptEntries;
+
+    S32 failedScripts = 0;
+    const char* pMatch = NULL;
+    ResourceObject* pResource = NULL;
+
+    while ( (pResource = ResourceManager->findMatchMultiExprs( pScriptExpressions, &pMatch, pResource )) != NULL )
+    {
+        // The match is a shared buffer so take a copy before doing any more resource work.
+        char scriptFile[1024];
+        dStrncpy( scriptFile, pMatch, sizeof(scriptFile) );
+        scriptFile[sizeof(scriptFile)-1] = 0;
+
+        // Never bundle the bundle.
+        if ( dStricmp( scriptFile, pBundleFile ) == 0 )
+            continue;
+
+        totalScripts++;
+
+        Stream* pScriptStream = ResourceManager->openStream( scriptFile );
+        if ( pScriptStream == NULL )
+        {
+            Con::warnf( "ScriptBundle::build() - Could not open script '%s'.", scriptFile );
+            failedScripts++;
+            continue;
+        }
+
+        const U32 scriptSize = ResourceManager->getSize( scriptFile );
+        char* pScript = new char[scriptSize+1];
+        pScriptStream->read( scriptSize, pScript );
+        pScript[scriptSize] = 0;
+        ResourceManager->closeStream( pScriptStream );
+
+        Entry entry;
+        entry.mOffset = bundleStream.getPosition();
+
+        CodeBlock* pCodeBlock = new CodeBlock();
+        const bool compiled = pCodeBlock->compile( bundleStream, StringTable->insert( scriptFile ), pScript );
+        delete pCodeBlock;
+        delete [] pScript;
+
+        if ( !compiled )
+        {
+            Con::warnf( "ScriptBundle::build() - Failed to compile script '%s'.", scriptFile );
+            bundleStream.setPosition( entry.mOffset );
+            failedScripts++;
+            continue;
+        }
+
+        entry.mSize = bundleStream.getPosition() - entry.mOffset;
+
+        scriptKeys.push_back( getScriptKey( scriptFile ) );
+        scriptEntries.push_back( entry );
+    }
+
+    // Write the directory.
+    const U32 directoryOffset = bundleStream.getPosition();
+    for ( S32 index = 0; index < scriptKeys.size(); ++index )
+    {
+        bundleStream.writeLongString( 1024, scriptKeys[index] );
+        bundleStream.write( scriptEntries[index].mOffset );
+        bundleStream.write( scriptEntries[index].mSize );
+    }
+
+    // Patch the header.
+    bundleStream.setPosition( sizeof(U32) * 2 );
+    bundleStream.write( (U32)scriptKeys.size() );
+    bundleStream.write( directoryOffset );
+    bundleStream.close();
+
+    return failedScripts;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptBundle::readBundle( void )
+{
+    FileStream fileStream;
+    if ( !fileStream.open( mBundleFile, FileStream::Read ) )
+    {
+        Con::warnf( "ScriptBundle::load() - Could not open bundle file '%s'.", mBundleFile );
+        return false;
+    }
+
+    // Read the whole bundle in one go.
+    // Scripts edited after this are compiled from source instead.
+    if ( !Platform::getFileTimes( mBundleFile, NULL, &mModifyTime ) )
+    {
+        Con::warnf( "ScriptBundle::load() - Could not read the modification time of '%s'.", mBundleFile );
+        return false;
+    }
+
+    mBufferSize = fileStream.getStreamSize();
+    mpBuffer = (U8*)dMalloc( mBufferSize );
+    const bool readOk = fileStream.read( mBufferSize, mpBuffer );
+    fileStream.close();
+
+    if ( !readOk )
+    {
+        Con::warnf( "ScriptBundle::load() - Could not read bundle file '%s'.", mBundleFile );
+        return false;
+    }
+
+    MemStream stream( mBufferSize, mpBuffer, true, false );
+
+    U32 signature, version, entryCount, directoryOffset;
+    stream.read( &signature );
+    stream.read( &version );
+    stream.read( &entryCount );
+    stream.read( &directoryOffset );
+
+    if ( signature != SCRIPT_BUNDLE_SIGNATURE )
+    {
+        Con::warnf( "ScriptBundle::load() - '%s' is not a script bundle.", mBundleFile );
+        return false;
+    }
+
+    if ( version != DSO_VERSION )
+    {
+        Con::warnf( "ScriptBundle::load() - Found an old script bundle (%s, ver %d < %d), ignoring.", mBundleFile, version, DSO_VERSION );
+        return false;
+    }
+
+    if ( directoryOffset > mBufferSize || !stream.setPosition( directoryOffset ) )
+    {
+        Con::warnf( "ScriptBundle::load() - Script bundle '%s' is corrupt.", mBundleFile );
+        return false;
+    }
+
+    char scriptKey[1024];
+    for ( U32 index = 0; index < entryCount; ++index )
+    {
+        Entry entry;
+        stream.readLongString( sizeof(scriptKey)-1, scriptKey );
+        stream.read( &entry.mOffset );
+        stream.read( &entry.mSize );
+        entry.mTimeChecked = false;
+        entry.mStale = false;
+
+        if ( entry.mOffset + entry.mSize > directoryOffset )
+        {
+            Con::warnf( "ScriptBundle::load() - Script bundle '%s' is corrupt.", mBundleFile );
+            return false;
+        }
+
+        mEntries.insert( StringTable->insert( scriptKey ), entry );
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptBundle::load( const char* pBundleFile )
+{
+    StringTableEntry bundleFile = StringTable->insert( pBundleFile );
+
+    // Reloading a bundle replaces the previous copy.
+    unload( bundleFile );
+
+    ScriptBundle* pBundle = new ScriptBundle( bundleFile );
+
+    if ( !pBundle->readBundle() )
+    {
+        delete pBundle;
+        return false;
+    }
+
+    smLoadedBundles.push_back( pBundle );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ScriptBundle::unload( const char* pBundleFile )
+{
+    StringTableEntry bundleFile = StringTable->insert( pBundleFile );
+
+    for ( S32 index = 0; index < smLoadedBundles.size(); ++index )
+    {
+        if ( smLoadedBundles[index]->mBundleFile != bundleFile )
+            continue;
+
+        delete smLoadedBundles[index];
+        smLoadedBundles.erase( index );
+        return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptBundle::unloadAll( void )
+{
+    for ( S32 index = 0; index < smLoadedBundles.size(); ++index )
+        delete smLoadedBundles[index];
+
+    smLoadedBundles.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+Stream* ScriptBundle::openScript( StringTableEntry scriptFile )
+{
+    // Finish if no bundles are loaded.
+    if ( smLoadedBundles.size() == 0 )
+        return NULL;
+
+    StringTableEntry scriptKey = getScriptKey( scriptFile );
+
+    // Checking the script sources costs a file stat per script so it is only done on request.
+    const bool checkTimes = Con::getBoolVariable( "Scripts::checkBundleTimes" );
+
+    // Search the most recently loaded bundles first.
+    for ( S32 index = smLoadedBundles.size()-1; index >= 0; --index )
+    {
+        ScriptBundle* pBundle = smLoadedBundles[index];
+
+        typeEntryHash::iterator entryItr = pBundle->mEntries.find( scriptKey );
+        if ( entryItr == pBundle->mEntries.end() )
+            continue;
+
+        Entry& entry = entryItr->value;
+
+        // A script edited since the bundle was built must not be overridden by the bundle.
+        if ( checkTimes && !entry.mTimeChecked )
+        {
+            FileTime scriptModifyTime;
+            entry.mStale = Platform::getFileTimes( scriptFile, NULL, &scriptModifyTime ) && Platform::compareFileTimes( scriptModifyTime, pBundle->mModifyTime ) > 0;
+            entry.mTimeChecked = true;
+
+            if ( entry.mStale )
+                Con::warnf( "ScriptBundle::openScript() - Script '%s' is newer than bundle '%s', skipping the bundle.", scriptFile, pBundle->mBundleFile );
+        }
+
+        if ( entry.mStale )
+            continue;
+
+        MemStream* pStream = new MemStream( entry.mSize, pBundle->mpBuffer + entry.mOffset, true, false );
+
+        // Try the older bundles if this copy was compiled by another DSO version.
+        U32 version;
+        if ( !pStream->read( &version ) || version != DSO_VERSION )
+        {
+            delete pStream;
+            continue;
+        }
+
+        return pStream;
+    }
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+void ScriptBundle::closeScript( Stream* pStream )
+{
+    delete pStream;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( buildScriptBundle, const char*, 3, 3,   "(bundleFile, scriptExpressions) - Compiles all scripts matching the expressions into a single script bundle.\n"
+                                                        "@param bundleFile The bundle file to write.\n"
+                                                        "@param scriptExpressions One or more tab-separated file expressions such as \"^MyModule/*.cs\".\n"
+                                                        "@return The number of failed scripts followed by the total number of scripts or \"-1 0\" if the bundle could not be written." )
+{
+    char bundleFile[1024];
+    char scriptExpressions[1024];
+    Con::expandPath( bundleFile, sizeof(bundleFile), argv[1] );
+    Con::expandPath( scriptExpressions, sizeof(scriptExpressions), argv[2] );
+
+    U32 totalScripts;
+    const S32 failedScripts = ScriptBundle::build( bundleFile, scriptExpressions, totalScripts );
+
+    char* pResult = Con::getReturnBuffer(32);
+    dSprintf( pResult, 32, "%d %d", failedScripts, totalScripts );
+    return pResult;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( loadScriptBundle, bool, 2, 2,  "(bundleFile) - Loads a script bundle so that exec() of any script it contains is served from the bundle.\n"
+                                                "Set $Scripts::checkBundleTimes during development so that scripts edited since the bundle was built are compiled instead.\n"
+                                                "@param bundleFile The bundle file to load.\n"
+                                                "@return Whether the bundle was loaded or not." )
+{
+    char bundleFile[1024];
+    Con::expandPath( bundleFile, sizeof(bundleFile), argv[1] );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    if ( !ScriptBundle::load( bundleFile ) )
+        return false;
+
+    Con::printf( "Loaded script bundle %s. Took %d ms", bundleFile, Platform::getRealMilliseconds() - startTime );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( unloadScriptBundle, bool, 2, 2,    "(bundleFile) - Unloads a previously loaded script bundle.\n"
+                                                    "@param bundleFile The bundle file to unload.\n"
+                                                    "@return Whether the bundle was unloaded or not." )
+{
+    char bundleFile[1024];
+    Con::expandPath( bundleFile, sizeof(bundleFile), argv[1] );
+
+    return ScriptBundle::unload( bundleFile );
+}
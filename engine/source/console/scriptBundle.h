@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SCRIPT_BUNDLE_H_
+#define _SCRIPT_BUNDLE_H_
+
+#ifndef _HASHTABLE_H
+#include "collection/hashTable.h"
+#endif
+
+#ifndef _STRINGTABLE_H_
+#include "string/stringTable.h"
+#endif
+
+class Stream;
+
+//-----------------------------------------------------------------------------
+
+/// A script bundle is a single file holding the compiled DSO images of many scripts.
+///
+/// Loading a bundle reads the whole file into memory with a single read.  From then
+/// on, any exec() of a script contained in the bundle is served directly from that
+/// memory, skipping the per-file resource lookups, file-time checks and stream opens
+/// that loading individual DSOs incurs.
+///
+/// Bundles are keyed by the script path relative to the main.cs directory so a bundle
+/// built on one machine can be loaded on another.
+class ScriptBundle
+{
+private:
+    struct Entry
+    {
+        U32 mOffset;
+        U32 mSize;
+        bool mTimeChecked;
+        bool mStale;
+    };
+
+    typedef HashMap<StringTableEntry, Entry> typeEntryHash;
+
+    StringTableEntry    mBundleFile;
+    FileTime            mModifyTime;
+    U8*                 mpBuffer;
+    U32                 mBufferSize;
+    typeEntryHash       mEntries;
+
+    static Vector<ScriptBundle*> smLoadedBundles;
+
+private:
+    ScriptBundle( StringTableEntry bundleFile );
+    ~ScriptBundle();
+
+    bool readBundle( void );
+
+    static StringTableEntry getScriptKey( const char* pScriptFile );
+
+public:
+    /// Compiles all scripts matching the tab-separated expressions into a single bundle file.
+    /// @return The number of scripts that failed to compile or -1 if the bundle could not be written.
+    static S32 build( const char* pBundleFile, const char* pScriptExpressions, U32& totalScripts );
+
+    static bool load( const char* pBundleFile );
+    static bool unload( const char* pBundleFile );
+    static void unloadAll( void );
+    static U32 getLoadedCount( void ) { return (U32)smLoadedBundles.size(); }
+
+    /// Opens a read stream on a bundled script positioned just after its DSO version.
+    /// Bundles whose copy of the script has a stale DSO version are skipped in favour of older bundles.
+    /// When $Scripts::checkBundleTimes is set, a copy older than the script source is skipped too;
+    /// the source is only checked the first time each bundled script is opened.
+    /// @return The stream or NULL if no loaded bundle holds a usable copy of the script.
+    static Stream* openScript( StringTableEntry scriptFile );
+    static void closeScript( Stream* pStream );
+};
+
+#endif // _SCRIPT_BUNDLE_H_
@@ -54,6 +54,7 @@
 #include "game/version.h"
 #include "debug/profiler.h"
 #include "network/serverQuery.h"
+#include "messaging/dispatcher.h"
 #include "game/defaultGame.h"
 #include "platform/nativeDialogs/msgBox.h"
 #include "platform/nativeDialogs/fileDialog.h"
@@ -457,6 +458,12 @@ void DefaultGame::mainLoop( void )
          PROFILE_END();
          PROFILE_START(GameProcessEvents);
     Game->processEvents(); // process all non-sim posted events.
+         PROFILE_END();
+         PROFILE_START(DispatcherProcessMain);
+   Dispatcher::processPostedMessages(); // messages posted from other threads.
+         PROFILE_END();
+         PROFILE_START(NetFlushMain);
+   Net::flush();        // send all queued packets
          PROFILE_END();
          PROFILE_END();
     
@@ -609,6 +616,9 @@ iPhoneProfilerStart("SERVER_PROC");
     // Milliseconds between audio updates.
     const U32 AudioUpdatePeriod = 125;
 
+   // Sounds whose buffers were loaded on the audio thread start on the next frame.
+   alxLoadingUpdate();
+
    // alxUpdate is somewhat expensive and does not need to be updated constantly,
    // though it does need to be updated in real time
    static U32 lastAudioUpdate = 0;
@@ -637,6 +647,10 @@ iPhoneProfilerStart("GL_RENDER");
       if(gFrameSkip && gFrameCount % gFrameSkip)
          preRenderOnly = true;
 
+      PROFILE_START(TextureUploads);
+      TextureManager::processAsyncLoads();
+      PROFILE_END();
+
       PROFILE_START(RenderFrame);
       Canvas->renderFrame(preRenderOnly);
       PROFILE_END();
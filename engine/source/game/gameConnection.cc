@@ -33,8 +33,9 @@
 
 #define ControlRequestTime 5000
 
-const U32 GameConnection::CurrentProtocolVersion = 12;
+const U32 GameConnection::CurrentProtocolVersion = 13;
 const U32 GameConnection::MinRequiredProtocolVersion = 12;
+const U32 GameConnection::StringCompressionProtocolVersion = 13;
 
 //----------------------------------------------------------------------------
 
@@ -181,6 +182,10 @@ void GameConnection::writeConnectAccept(BitStream *stream)
 {
    Parent::writeConnectAccept(stream);
    stream->write(getProtocolVersion());
+
+   // older clients do not expect anything after the protocol version
+   if(getProtocolVersion() >= StringCompressionProtocolVersion)
+      writeStringCompressionAccept(stream);
 }
 
 bool GameConnection::readConnectAccept(BitStream *stream, const char **errorString)
@@ -195,6 +200,9 @@ bool GameConnection::readConnectAccept(BitStream *stream, const char **errorStri
       *errorString = "CHR_PROTOCOL"; // this should never happen unless someone is faking us out.
       return false;
    }
+
+   if(protocolVersion >= StringCompressionProtocolVersion)
+      readStringCompressionAccept(stream);
    return true;
 }
 
@@ -209,6 +217,9 @@ void GameConnection::writeConnectRequest(BitStream *stream)
    stream->write(mConnectArgc);
    for(U32 i = 0; i < mConnectArgc; i++)
       stream->writeString(mConnectArgv[i]);
+
+   // written last so that older servers, which stop reading before it, still accept us
+   writeStringCompressionRequest(stream);
 }
 
 bool GameConnection::readConnectRequest(BitStream *stream, const char **errorString)
@@ -266,6 +277,10 @@ bool GameConnection::readConnectRequest(BitStream *stream, const char **errorStr
       mConnectArgv[i] = dStrdup(argString);
       connectArgv[i + 3] = mConnectArgv[i];
    }
+
+   if(currentProtocol >= StringCompressionProtocolVersion)
+      readStringCompressionRequest(stream);
+
    connectArgv[0] = "onConnectRequest";
    char buffer[256];
    Net::addressToString(getNetAddress(), buffer);
@@ -103,6 +103,9 @@ public:
    /// @{
    static const U32 CurrentProtocolVersion;
    static const U32 MinRequiredProtocolVersion;
+
+   /// First protocol version that negotiates string compression when connecting.
+   static const U32 StringCompressionProtocolVersion;
    /// @}
 
    /// Configuration
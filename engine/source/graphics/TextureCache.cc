@@ -0,0 +1,660 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "graphics/TextureCache.h"
+#include "graphics/gBitmap.h"
+#include "io/fileStream.h"
+#include "platform/threads/atomic.h"
+#include "platform/threads/thread.h"
+#include "platform/threads/mutex.h"
+#include "platform/threads/semaphore.h"
+#include "collection/vector.h"
+#include "console/console.h"
+#include "console/consoleTypes.h"
+#include "memory/safeDelete.h"
+
+//-----------------------------------------------------------------------------
+
+static const U32 csTextureCacheSignature = 0x43543254; // "T2TC"
+static const U32 csTextureCacheVersion = 2;
+
+/// Bytes written by GBitmap::write() besides the texels.
+static const U32 csBitmapStreamOverhead = (6 + GBitmap::c_maxMipLevels) * sizeof(U32);
+
+/// Decoded bitmaps waiting to be written are dropped beyond this.
+static const U32 csTextureCacheMaxPendingBytes = 64 << 20;
+
+/// Room for the padded texels decoded from around 2GB of compressed source images.
+static const S32 csTextureCacheDefaultMaxMB = 6144;
+
+static bool sgTextureCacheEnabled = false;
+static bool sgTextureCacheResolved = false;
+static char sgTextureCacheDirectory[1024];
+static S32 sgTextureCacheMaxMB = csTextureCacheDefaultMaxMB;
+
+/// An entry in the cache directory, for least-recently-used eviction.
+struct TextureCacheEntry
+{
+    U32 mNameHigh;
+    U32 mNameLow;
+    U32 mSize;
+    U32 mLastUse;
+};
+
+/// The entries in the cache directory.  Entries left by earlier runs count as unused.
+static Mutex* sgpTextureCacheIndexMutex = NULL;
+static Vector<TextureCacheEntry> sgTextureCacheIndex;
+static U64 sgTextureCacheBytes = 0;
+static U32 sgTextureCacheUseClock = 0;
+
+/// Metrics, updated from any thread.
+static volatile U32 sgTextureCacheHits = 0;
+static volatile U32 sgTextureCacheMisses = 0;
+static volatile U32 sgTextureCacheHitKB = 0;
+static volatile U32 sgTextureCacheMissKB = 0;
+static volatile U32 sgTextureCacheHitMS = 0;
+static volatile U32 sgTextureCacheMissMS = 0;
+
+//-----------------------------------------------------------------------------
+
+/// A decoded bitmap waiting to be written to the cache.
+struct TextureCacheWrite
+{
+    char        mSourcePath[1024];
+    GBitmap*    mpBitmap;
+    U32         mBitmapWidth;
+    U32         mBitmapHeight;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Writes cache entries in the background so that a store never waits on the disk.
+class TextureCacheWriter : public Thread
+{
+public:
+    TextureCacheWriter() : Thread( 0, 0, false ), mPendingHead( 0 ), mPendingSignal( 0 ), mPendingBytes( 0 ), mOutstanding( 0 ) {}
+
+    virtual ~TextureCacheWriter()
+    {
+        // Drop anything that was never written.
+        TextureCacheWrite* pWrite;
+        while( (pWrite = popPending()) != NULL )
+            finishWrite( pWrite );
+    }
+
+    virtual void run( void* arg = 0 )
+    {
+        while( !checkForStop() )
+        {
+            // Wait for work.
+            mPendingSignal.acquire();
+
+            if ( checkForStop() )
+                break;
+
+            TextureCacheWrite* pWrite = popPending();
+            if ( pWrite == NULL )
+                continue;
+
+            TextureCache::write( pWrite->mSourcePath, pWrite->mpBitmap, pWrite->mBitmapWidth, pWrite->mBitmapHeight );
+            finishWrite( pWrite );
+        }
+    }
+
+    void post( const char* pSourcePath, const GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight )
+    {
+        // Drop the store rather than queue without bound if the disk cannot keep up.
+        if ( dAtomicRead( mPendingBytes ) + pBitmap->byteSize > csTextureCacheMaxPendingBytes )
+            return;
+
+        TextureCacheWrite* pWrite = new TextureCacheWrite();
+        dStrcpy( pWrite->mSourcePath, pSourcePath );
+        pWrite->mpBitmap = new GBitmap( *pBitmap );
+        pWrite->mBitmapWidth = bitmapWidth;
+        pWrite->mBitmapHeight = bitmapHeight;
+
+        dFetchAndAdd( mPendingBytes, pBitmap->byteSize );
+        dFetchAndAdd( mOutstanding, 1 );
+
+        mPendingMutex.lock();
+        mPending.push_back( pWrite );
+        mPendingMutex.unlock();
+
+        mPendingSignal.release();
+    }
+
+    void shutdown( void )
+    {
+        stop();
+        mPendingSignal.release();
+        join();
+    }
+
+    inline bool isIdle( void ) { return dAtomicRead( mOutstanding ) == 0; }
+
+private:
+    TextureCacheWrite* popPending( void )
+    {
+        TextureCacheWrite* pWrite = NULL;
+
+        mPendingMutex.lock();
+        if ( mPendingHead < (U32)mPending.size() )
+        {
+            pWrite = mPending[mPendingHead++];
+
+            // Reset the queue once drained so it does not grow.
+            if ( mPendingHead == (U32)mPending.size() )
+            {
+                mPending.clear();
+                mPendingHead = 0;
+            }
+        }
+        mPendingMutex.unlock();
+
+        return pWrite;
+    }
+
+    void finishWrite( TextureCacheWrite* pWrite )
+    {
+        dFetchAndAdd( mPendingBytes, (U32)0 - pWrite->mpBitmap->byteSize );
+        delete pWrite->mpBitmap;
+        delete pWrite;
+        dFetchAndAdd( mOutstanding, (U32)-1 );
+    }
+
+private:
+    Mutex                       mPendingMutex;
+    Vector<TextureCacheWrite*>  mPending;
+    U32                         mPendingHead;
+    Semaphore                   mPendingSignal;
+    volatile U32                mPendingBytes;
+    volatile U32                mOutstanding;
+};
+
+static TextureCacheWriter* sgpTextureCacheWriter = NULL;
+
+//-----------------------------------------------------------------------------
+
+/// Parse the name hashes out of a cache file name.
+static bool parseCacheFileName( const char* pFileName, U32& nameHigh, U32& nameLow )
+{
+    const char* pExtension = dStrrchr( pFileName, '.' );
+    if ( pExtension == NULL || pExtension - pFileName != 16 || dStricmp( pExtension, ".texcache" ) != 0 )
+        return false;
+
+    return dSscanf( pFileName, "%8x%8x", &nameHigh, &nameLow ) == 2;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Find an entry in the index.  The index mutex must be held.
+static S32 findCacheEntry( const U32 nameHigh, const U32 nameLow )
+{
+    for( S32 index = 0; index < sgTextureCacheIndex.size(); ++index )
+    {
+        if ( sgTextureCacheIndex[index].mNameHigh == nameHigh && sgTextureCacheIndex[index].mNameLow == nameLow )
+            return index;
+    }
+
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Add or refresh an entry in the index.  The index mutex must be held.
+static void touchCacheEntry( const U32 nameHigh, const U32 nameLow, const U32 size )
+{
+    S32 index = findCacheEntry( nameHigh, nameLow );
+    if ( index < 0 )
+    {
+        TextureCacheEntry entry = { nameHigh, nameLow, 0, 0 };
+        sgTextureCacheIndex.push_back( entry );
+        index = sgTextureCacheIndex.size() - 1;
+    }
+
+    TextureCacheEntry& entry = sgTextureCacheIndex[index];
+    sgTextureCacheBytes += (U64)size - (U64)entry.mSize;
+    entry.mSize = size;
+    entry.mLastUse = ++sgTextureCacheUseClock;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Remove an entry from the index.  The index mutex must be held.
+static void removeCacheEntry( const U32 nameHigh, const U32 nameLow )
+{
+    const S32 index = findCacheEntry( nameHigh, nameLow );
+    if ( index < 0 )
+        return;
+
+    sgTextureCacheBytes -= sgTextureCacheIndex[index].mSize;
+    sgTextureCacheIndex.erase_fast( index );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::create( void )
+{
+    Con::addVariable( "$pref::OpenGL::textureCache", TypeBool, &sgTextureCacheEnabled );
+    Con::addVariable( "$pref::OpenGL::textureCacheMaxMB", TypeS32, &sgTextureCacheMaxMB );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::destroy( void )
+{
+    if ( sgpTextureCacheWriter != NULL )
+    {
+        sgpTextureCacheWriter->shutdown();
+        SAFE_DELETE( sgpTextureCacheWriter );
+    }
+
+    SAFE_DELETE( sgpTextureCacheIndexMutex );
+    sgTextureCacheIndex.clear();
+    sgTextureCacheBytes = 0;
+    sgTextureCacheResolved = false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureCache::isEnabled( void )
+{
+    // Finish if disabled.
+    if ( !sgTextureCacheEnabled )
+        return false;
+
+    // Resolve the location on first use, after the game has named itself.
+    if ( !sgTextureCacheResolved )
+    {
+        const char* pCachePath = Con::getVariable( "$pref::OpenGL::textureCachePath" );
+        if ( pCachePath == NULL || *pCachePath == 0 )
+            pCachePath = Platform::getPrefsPath( "textureCache" );
+
+        if ( pCachePath == NULL )
+        {
+            Con::warnf( "TextureCache::isEnabled() - Could not resolve the texture cache location, the cache is disabled." );
+            sgTextureCacheEnabled = false;
+            return false;
+        }
+
+        Platform::makeFullPathName( pCachePath, sgTextureCacheDirectory, sizeof(sgTextureCacheDirectory) );
+
+        // Index what earlier runs left behind so it counts towards the limit.
+        Vector<Platform::FileInfo> files;
+        Platform::dumpPath( sgTextureCacheDirectory, files, 0 );
+        for( S32 index = 0; index < files.size(); ++index )
+        {
+            U32 nameHigh, nameLow;
+            if ( !parseCacheFileName( files[index].pFileName, nameHigh, nameLow ) )
+                continue;
+
+            TextureCacheEntry entry = { nameHigh, nameLow, files[index].fileSize, 0 };
+            sgTextureCacheIndex.push_back( entry );
+            sgTextureCacheBytes += files[index].fileSize;
+        }
+
+        sgpTextureCacheIndexMutex = new Mutex();
+        sgpTextureCacheWriter = new TextureCacheWriter();
+        sgpTextureCacheWriter->start();
+        sgTextureCacheResolved = true;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::getCacheFileName( const char* pSourcePath, U32& nameHigh, U32& nameLow )
+{
+    // Name the entry after two FNV-1a hashes of the source path.
+    nameLow = 2166136261u;
+    nameHigh = 84696351u;
+    for ( const U8* pChar = (const U8*)pSourcePath; *pChar != 0; ++pChar )
+    {
+        nameLow = ( nameLow ^ *pChar ) * 16777619u;
+        nameHigh = ( nameHigh ^ *pChar ) * 16777619u;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::getCacheFilePath( const U32 nameHigh, const U32 nameLow, char* pCachePath, const U32 cachePathSize )
+{
+    // Sanity!
+    AssertFatal( sgTextureCacheResolved, "TextureCache::getCacheFilePath() - Cache location has not been resolved." );
+
+    dSprintf( pCachePath, cachePathSize, "%s/%08x%08x.texcache", sgTextureCacheDirectory, nameHigh, nameLow );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureCache::canStore( const GBitmap* pBitmap )
+{
+    return pBitmap->getFormat() != GBitmap::Palettized && pBitmap->getFormat() <= GBitmap::Luminance;
+}
+
+//-----------------------------------------------------------------------------
+
+GBitmap* TextureCache::load( const char* pSourcePath, U32& bitmapWidth, U32& bitmapHeight )
+{
+    // Finish if the cache was never resolved.
+    if ( !sgTextureCacheResolved )
+        return NULL;
+
+    // Fetch the source stamp.
+    const S32 sourceSize = Platform::getFileSize( pSourcePath );
+    FileTime sourceModifyTime;
+    if ( sourceSize < 0 || !Platform::getFileTimes( pSourcePath, NULL, &sourceModifyTime ) )
+        return NULL;
+
+    U32 nameHigh, nameLow;
+    char cachePath[1024];
+    getCacheFileName( pSourcePath, nameHigh, nameLow );
+    getCacheFilePath( nameHigh, nameLow, cachePath, sizeof(cachePath) );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    FileStream stream;
+    if ( !stream.open( cachePath, FileStream::Read ) )
+        return NULL;
+
+    // Check the header.
+    U32 signature = 0;
+    U32 version = 0;
+    stream.read( &signature );
+    stream.read( &version );
+    if ( signature != csTextureCacheSignature || version != csTextureCacheVersion )
+        return NULL;
+
+    U32 cachedSourceSize = 0;
+    FileTime cachedModifyTime;
+    char cachedSourcePath[1024];
+    U32 bitmapByteSize = 0;
+    stream.read( &cachedSourceSize );
+    stream.read( sizeof(FileTime), &cachedModifyTime );
+    stream.readLongString( sizeof(cachedSourcePath) - 1, cachedSourcePath );
+    stream.read( &bitmapWidth );
+    stream.read( &bitmapHeight );
+    stream.read( &bitmapByteSize );
+
+    if ( stream.getStatus() != Stream::Ok )
+        return NULL;
+
+    // Is the entry for this version of the source?
+    if ( cachedSourceSize != (U32)sourceSize ||
+         dMemcmp( &cachedModifyTime, &sourceModifyTime, sizeof(FileTime) ) != 0 ||
+         dStrcmp( cachedSourcePath, pSourcePath ) != 0 )
+        return NULL;
+
+    // Reject truncated entries before allocating anything.
+    if ( stream.getStreamSize() - stream.getPosition() != csBitmapStreamOverhead + bitmapByteSize )
+        return NULL;
+
+    // The texels must be the padded source.
+    GBitmap* pBitmap = new GBitmap();
+    if ( !pBitmap->read( stream ) ||
+         !isPow2( pBitmap->getWidth() ) || !isPow2( pBitmap->getHeight() ) ||
+         bitmapWidth == 0 || bitmapWidth > pBitmap->getWidth() ||
+         bitmapHeight == 0 || bitmapHeight > pBitmap->getHeight() )
+    {
+        delete pBitmap;
+        return NULL;
+    }
+
+    // Mark the entry as recently used.
+    sgpTextureCacheIndexMutex->lock();
+    touchCacheEntry( nameHigh, nameLow, stream.getStreamSize() );
+    sgpTextureCacheIndexMutex->unlock();
+
+    // Adjust metrics.
+    dFetchAndAdd( sgTextureCacheHits, 1 );
+    dFetchAndAdd( sgTextureCacheHitKB, pBitmap->byteSize >> 10 );
+    dFetchAndAdd( sgTextureCacheHitMS, Platform::getRealMilliseconds() - startTime );
+
+    return pBitmap;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::store( const char* pSourcePath, const GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight, const U32 decodeTimeMS )
+{
+    // Sanity!
+    AssertFatal( !canStore( pBitmap ) || ( isPow2( pBitmap->getWidth() ) && isPow2( pBitmap->getHeight() ) ), "TextureCache::store() - Bitmap has not been padded." );
+
+    // Adjust metrics.
+    dFetchAndAdd( sgTextureCacheMisses, 1 );
+    dFetchAndAdd( sgTextureCacheMissKB, pBitmap->byteSize >> 10 );
+    dFetchAndAdd( sgTextureCacheMissMS, decodeTimeMS );
+
+    // Paletted and compressed bitmaps are not cached.
+    if ( !canStore( pBitmap ) )
+        return;
+
+    // Finish if the cache was never resolved.
+    if ( sgpTextureCacheWriter == NULL )
+        return;
+
+    sgpTextureCacheWriter->post( pSourcePath, pBitmap, bitmapWidth, bitmapHeight );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::write( const char* pSourcePath, const GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight )
+{
+    // Fetch the source stamp.
+    const S32 sourceSize = Platform::getFileSize( pSourcePath );
+    FileTime sourceModifyTime;
+    if ( sourceSize < 0 || !Platform::getFileTimes( pSourcePath, NULL, &sourceModifyTime ) )
+        return;
+
+    U32 nameHigh, nameLow;
+    char cachePath[1024];
+    getCacheFileName( pSourcePath, nameHigh, nameLow );
+    getCacheFilePath( nameHigh, nameLow, cachePath, sizeof(cachePath) );
+
+    // Write to a file private to this thread and move it into place once complete.
+    char tempPath[1024];
+    dSprintf( tempPath, sizeof(tempPath), "%s.%x.tmp", cachePath, ThreadManager::getCurrentThreadId() );
+
+    if ( !Platform::createPath( tempPath ) )
+        return;
+
+    FileStream stream;
+    if ( !stream.open( tempPath, FileStream::Write ) )
+        return;
+
+    stream.write( csTextureCacheSignature );
+    stream.write( csTextureCacheVersion );
+    stream.write( (U32)sourceSize );
+    stream.write( sizeof(FileTime), &sourceModifyTime );
+    stream.writeLongString( 1023, pSourcePath );
+    stream.write( bitmapWidth );
+    stream.write( bitmapHeight );
+    stream.write( pBitmap->byteSize );
+    const bool written = pBitmap->write( stream ) && stream.getStatus() == Stream::Ok;
+    const U32 entrySize = stream.getPosition();
+    stream.close();
+
+    if ( written )
+    {
+        Platform::fileDelete( cachePath );
+        if ( Platform::fileRename( tempPath, cachePath ) )
+        {
+            sgpTextureCacheIndexMutex->lock();
+            touchCacheEntry( nameHigh, nameLow, entrySize );
+            evict( nameHigh, nameLow );
+            sgpTextureCacheIndexMutex->unlock();
+            return;
+        }
+    }
+
+    Platform::fileDelete( tempPath );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::evict( const U32 keepHigh, const U32 keepLow )
+{
+    const U64 maxBytes = (U64)getMax( sgTextureCacheMaxMB, 0 ) << 20;
+
+    // Remove the least recently used entries until the cache fits, always keeping the newest.
+    while ( sgTextureCacheBytes > maxBytes )
+    {
+        S32 oldest = -1;
+        for( S32 index = 0; index < sgTextureCacheIndex.size(); ++index )
+        {
+            const TextureCacheEntry& entry = sgTextureCacheIndex[index];
+            if ( entry.mNameHigh == keepHigh && entry.mNameLow == keepLow )
+                continue;
+
+            if ( oldest < 0 || entry.mLastUse < sgTextureCacheIndex[oldest].mLastUse )
+                oldest = index;
+        }
+
+        if ( oldest < 0 )
+            break;
+
+        const TextureCacheEntry entry = sgTextureCacheIndex[oldest];
+        char cachePath[1024];
+        getCacheFilePath( entry.mNameHigh, entry.mNameLow, cachePath, sizeof(cachePath) );
+        Platform::fileDelete( cachePath );
+        removeCacheEntry( entry.mNameHigh, entry.mNameLow );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::flush( void )
+{
+    if ( sgpTextureCacheWriter == NULL )
+        return;
+
+    while ( !sgpTextureCacheWriter->isIdle() )
+        Platform::sleep( 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::remove( const char* pSourcePath )
+{
+    // Finish if the cache was never resolved, the index mutex only exists once it is.
+    if ( !sgTextureCacheResolved )
+        return;
+
+    U32 nameHigh, nameLow;
+    char cachePath[1024];
+    getCacheFileName( pSourcePath, nameHigh, nameLow );
+    getCacheFilePath( nameHigh, nameLow, cachePath, sizeof(cachePath) );
+
+    Platform::fileDelete( cachePath );
+
+    sgpTextureCacheIndexMutex->lock();
+    removeCacheEntry( nameHigh, nameLow );
+    sgpTextureCacheIndexMutex->unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::purge( void )
+{
+    // Finish if there is no cache.
+    if ( !isEnabled() )
+        return;
+
+    // Let queued writes land first so they are purged too.
+    flush();
+
+    Vector<Platform::FileInfo> files;
+    if ( !Platform::dumpPath( sgTextureCacheDirectory, files, 0 ) )
+        return;
+
+    U32 removed = 0;
+    for( S32 index = 0; index < files.size(); ++index )
+    {
+        // Only remove cache entries and abandoned temporary files.
+        const char* pExtension = dStrrchr( files[index].pFileName, '.' );
+        if ( pExtension == NULL || ( dStricmp( pExtension, ".texcache" ) != 0 && dStricmp( pExtension, ".tmp" ) != 0 ) )
+            continue;
+
+        char filePath[1024];
+        dSprintf( filePath, sizeof(filePath), "%s/%s", files[index].pFullPath, files[index].pFileName );
+        if ( Platform::fileDelete( filePath ) )
+            removed++;
+    }
+
+    sgpTextureCacheIndexMutex->lock();
+    sgTextureCacheIndex.clear();
+    sgTextureCacheBytes = 0;
+    sgpTextureCacheIndexMutex->unlock();
+
+    Con::printf( "TextureCache::purge() - Removed %d entries from '%s'.", removed, sgTextureCacheDirectory );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureCache::dumpMetrics( void )
+{
+    const U32 hits = dAtomicRead( sgTextureCacheHits );
+    const U32 misses = dAtomicRead( sgTextureCacheMisses );
+    const U32 hitKB = dAtomicRead( sgTextureCacheHitKB );
+    const U32 missKB = dAtomicRead( sgTextureCacheMissKB );
+    const U32 hitMS = dAtomicRead( sgTextureCacheHitMS );
+    const U32 missMS = dAtomicRead( sgTextureCacheMissMS );
+
+    // Estimate what the hits would have cost to decode at the observed miss rate.
+    const F32 decodeMSPerKB = missKB > 0 ? (F32)missMS / (F32)missKB : 0.0f;
+    const F32 estimatedDecodeMS = decodeMSPerKB * (F32)hitKB;
+
+    Con::printSeparator();
+    Con::printf( "Texture cache metrics (%s):", sgTextureCacheEnabled ? ( sgTextureCacheResolved ? sgTextureCacheDirectory : "unresolved" ) : "disabled" );
+    Con::printf( "Hits: %d, Loaded: %dKB in %dms", hits, hitKB, hitMS );
+    Con::printf( "Misses: %d, Decoded: %dKB in %dms", misses, missKB, missMS );
+
+    if ( sgTextureCacheResolved )
+    {
+        sgpTextureCacheIndexMutex->lock();
+        const U32 entryCount = sgTextureCacheIndex.size();
+        const U32 sizeKB = (U32)( sgTextureCacheBytes >> 10 );
+        sgpTextureCacheIndexMutex->unlock();
+
+        Con::printf( "Entries: %d, Size: %dKB of %dMB", entryCount, sizeKB, sgTextureCacheMaxMB );
+    }
+
+    Con::printf( "Estimated decode time saved: %gms", getMax( estimatedDecodeMS - (F32)hitMS, 0.0f ) );
+    Con::printSeparator();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( purgeTextureCache, void, 1, 1, "() Remove every entry from the on-disk texture cache.\n"
+                                                "@return No return value.")
+{
+    TextureCache::purge();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( dumpTextureCacheMetrics, void, 1, 1, "() Dump the texture cache hit/miss counts, load times and the estimated decode time saved.\n"
+                                                      "@return No return value.")
+{
+    TextureCache::dumpMetrics();
+}
@@ -0,0 +1,93 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class GBitmap;
+
+//-----------------------------------------------------------------------------
+
+/// An on-disk cache of decoded texture bitmaps.
+///
+/// Each loose source image maps to a cache file holding the texels ready for upload, already
+/// padded to a power-of-two, in the GBitmap stream format.  The entry records the dimensions
+/// of the source image and is stamped with the source's size and modification time.  A hit is
+/// a single sequential read with no decompression or padding.  A stale or damaged entry is a
+/// miss and is simply overwritten by the next store.
+///
+/// The cache is off unless "$pref::OpenGL::textureCache" is set.  Entries are written by a
+/// background thread and the least recently used are evicted once the cache grows past
+/// "$pref::OpenGL::textureCacheMaxMB".  The default leaves room for the padded texels of a
+/// couple of gigabytes of source images.
+///
+/// isEnabled() must be called from the main thread before any other use as it resolves
+/// the cache location.  After that load(), store() and remove() may be called from any
+/// thread.  They do nothing while the cache is disabled or unresolved.
+class TextureCache
+{
+    friend class TextureCacheWriter;
+
+public:
+    static void create( void );
+    static void destroy( void );
+
+    static bool isEnabled( void );
+
+    /// Can the bitmap be stored?  Paletted and compressed bitmaps are not cached.
+    static bool canStore( const GBitmap* pBitmap );
+
+    /// Load the cached, power-of-two bitmap for a source file or NULL on a miss.
+    /// The dimensions of the source image are returned alongside it.
+    static GBitmap* load( const char* pSourcePath, U32& bitmapWidth, U32& bitmapHeight );
+
+    /// Queue a freshly decoded bitmap, padded to a power-of-two, to be stored along with the dimensions of
+    /// the source image, noting how long the decode took for the metrics.  The bitmap is copied so the caller
+    /// keeps ownership.
+    static void store( const char* pSourcePath, const GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight, const U32 decodeTimeMS );
+
+    /// Wait for queued stores to be written.
+    static void flush( void );
+
+    /// Remove the entry for a source file.
+    static void remove( const char* pSourcePath );
+
+    /// Remove every entry.
+    static void purge( void );
+
+    static void dumpMetrics( void );
+
+private:
+    static void write( const char* pSourcePath, const GBitmap* pBitmap, const U32 bitmapWidth, const U32 bitmapHeight );
+    static void evict( const U32 keepHigh, const U32 keepLow );
+
+    static void getCacheFileName( const char* pSourcePath, U32& nameHigh, U32& nameLow );
+    static void getCacheFilePath( const U32 nameHigh, const U32 nameLow, char* pCachePath, const U32 cachePathSize );
+};
+
+#endif // _TEXTURE_CACHE_H_
@@ -65,6 +65,23 @@ bool TextureHandle::set( const char* pTextureKey, TextureHandleType type, bool c
 
 //-----------------------------------------------------------------------------
 
+bool TextureHandle::setAsync( const char* pTextureKey, TextureHandleType type, bool clampToEdge, bool force16Bit ) 
+{
+    // Sanity!
+    AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
+
+    TextureObject* newObject = TextureManager::loadTextureAsync(pTextureKey, type, clampToEdge, force16Bit );
+    if (newObject != object)
+    {
+        unlock();
+        object = newObject;
+        lock();
+    }
+    return (object != NULL);
+}
+
+//-----------------------------------------------------------------------------
+
 bool TextureHandle::set( const char* pTextureKey, GBitmap *bmp, TextureHandleType type, bool clampToEdge ) 
 {
     // Sanity!
@@ -126,7 +143,14 @@ const GBitmap* TextureHandle::getBitmap( void ) const
 
 U32 TextureHandle::getGLName( void ) const
 {
-    return object == NULL ? 0 : object->mGLTextureName;
+    return object == NULL ? 0 : object->getGLTextureName();
+}
+
+//-----------------------------------------------------------------------------
+
+bool TextureHandle::isLoadPending( void ) const
+{
+    return object != NULL && object->isLoadPending();
 }
 
 //-----------------------------------------------------------------------------
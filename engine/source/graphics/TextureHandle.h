@@ -154,6 +154,10 @@ public:
 
     bool set(const char* pTextureKey, TextureHandleType type = BitmapTexture, bool clampToEdge = false, bool force16Bit = false );
 
+    /// Same as set() except that the bitmap is read and decoded in the background when possible.
+    /// The dimensions are available immediately but the texture binds a placeholder until isLoadPending() clears.
+    bool setAsync(const char* pTextureKey, TextureHandleType type = BitmapTexture, bool clampToEdge = false, bool force16Bit = false );
+
     bool set(const char* pTextureKey, GBitmap *bmp, TextureHandleType type, bool clampToEdge = false);
 
     bool operator==( const TextureHandle& handle ) const { return handle.object == object; }
@@ -177,6 +181,7 @@ public:
     GBitmap* getBitmap( void );
     const GBitmap* getBitmap( void ) const;
     U32 getGLName( void ) const;
+    bool isLoadPending( void ) const;
 
 private:
     void lock( void );
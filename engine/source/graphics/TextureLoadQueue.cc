@@ -0,0 +1,260 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "graphics/TextureLoadQueue.h"
+#include "graphics/TextureManager.h"
+#include "graphics/TextureCache.h"
+#include "graphics/gBitmap.h"
+#include "platform/threads/thread.h"
+#include "io/fileStream.h"
+
+//-----------------------------------------------------------------------------
+
+class TextureLoadThread : public Thread
+{
+public:
+    TextureLoadThread( TextureLoadQueue* pQueue ) : Thread( 0, 0, false ), mpQueue( pQueue ) {}
+
+    virtual void run( void* arg = 0 )
+    {
+        while( !checkForStop() )
+        {
+            // Wait for work.
+            mpQueue->mPendingSignal.acquire();
+
+            if ( checkForStop() )
+                break;
+
+            TextureLoadRequest* pRequest = mpQueue->popPending();
+            if ( pRequest == NULL )
+                continue;
+
+            TextureLoadQueue::decode( pRequest );
+            mpQueue->pushCompleted( pRequest );
+        }
+    }
+
+private:
+    TextureLoadQueue* mpQueue;
+};
+
+//-----------------------------------------------------------------------------
+
+TextureLoadQueue::TextureLoadQueue() :
+    mPendingHead( 0 ),
+    mPendingSignal( 0 ),
+    mCompletedHead( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+TextureLoadQueue::~TextureLoadQueue()
+{
+    stop();
+
+    AssertFatal( mCompletedHead == (U32)mCompleted.size(), "TextureLoadQueue::~TextureLoadQueue() - Completed requests were not collected." );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureLoadQueue::start( const U32 workerCount )
+{
+    // Finish if already started.
+    if ( isStarted() )
+        return;
+
+    for( U32 index = 0; index < getMax( workerCount, (U32)1 ); ++index )
+    {
+        TextureLoadThread* pWorker = new TextureLoadThread( this );
+        mWorkers.push_back( pWorker );
+        pWorker->start();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureLoadQueue::stop( void )
+{
+    // Finish if not started.
+    if ( !isStarted() )
+        return;
+
+    // Ask the workers to stop and wake them all.
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mWorkers[index]->stop();
+
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+        mPendingSignal.release();
+
+    for( S32 index = 0; index < mWorkers.size(); ++index )
+    {
+        mWorkers[index]->join();
+        delete mWorkers[index];
+    }
+    mWorkers.clear();
+
+    // Hand back anything that was never started as failed.
+    TextureLoadRequest* pRequest;
+    while( (pRequest = popPending()) != NULL )
+        pushCompleted( pRequest );
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureLoadQueue::post( TextureLoadRequest* pRequest )
+{
+    // Sanity!
+    AssertFatal( isStarted(), "TextureLoadQueue::post() - Queue has not been started." );
+
+    mPendingMutex.lock();
+    mPending.push_back( pRequest );
+    mPendingMutex.unlock();
+
+    mPendingSignal.release();
+}
+
+//-----------------------------------------------------------------------------
+
+TextureLoadRequest* TextureLoadQueue::popPending( void )
+{
+    TextureLoadRequest* pRequest = NULL;
+
+    mPendingMutex.lock();
+    if ( mPendingHead < (U32)mPending.size() )
+    {
+        pRequest = mPending[mPendingHead++];
+
+        // Reset the queue once drained so it does not grow.
+        if ( mPendingHead == (U32)mPending.size() )
+        {
+            mPending.clear();
+            mPendingHead = 0;
+        }
+    }
+    mPendingMutex.unlock();
+
+    return pRequest;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureLoadQueue::pushCompleted( TextureLoadRequest* pRequest )
+{
+    mCompletedMutex.lock();
+    mCompleted.push_back( pRequest );
+    mCompletedMutex.unlock();
+}
+
+//-----------------------------------------------------------------------------
+
+TextureLoadRequest* TextureLoadQueue::popCompleted( void )
+{
+    TextureLoadRequest* pRequest = NULL;
+
+    mCompletedMutex.lock();
+    if ( mCompletedHead < (U32)mCompleted.size() )
+    {
+        pRequest = mCompleted[mCompletedHead++];
+
+        // Reset the queue once drained so it does not grow.
+        if ( mCompletedHead == (U32)mCompleted.size() )
+        {
+            mCompleted.clear();
+            mCompletedHead = 0;
+        }
+    }
+    mCompletedMutex.unlock();
+
+    return pRequest;
+}
+
+//-----------------------------------------------------------------------------
+
+void TextureLoadQueue::decode( TextureLoadRequest* pRequest )
+{
+    // Try the processed texture cache first, its entries are already padded.
+    U32 bitmapWidth, bitmapHeight;
+    GBitmap* pBitmap = pRequest->mUseCache ? TextureCache::load( pRequest->mFilePath, bitmapWidth, bitmapHeight ) : NULL;
+
+    if ( pBitmap == NULL )
+    {
+        const U32 startTime = Platform::getRealMilliseconds();
+
+        GBitmap* pSourceBitmap = decodeSource( pRequest );
+        if ( pSourceBitmap == NULL )
+            return;
+
+        bitmapWidth = pSourceBitmap->getWidth();
+        bitmapHeight = pSourceBitmap->getHeight();
+
+        // Pad here so the main thread only has to upload.
+        pBitmap = TextureManager::createPowerOfTwoBitmap( pSourceBitmap );
+        if ( pBitmap != pSourceBitmap )
+            delete pSourceBitmap;
+
+        // Cache the padded result for next time.
+        if ( pRequest->mUseCache )
+            TextureCache::store( pRequest->mFilePath, pBitmap, bitmapWidth, bitmapHeight, Platform::getRealMilliseconds() - startTime );
+    }
+
+    pBitmap->mForce16Bit = pRequest->mForce16Bit;
+
+    pRequest->mBitmapWidth = bitmapWidth;
+    pRequest->mBitmapHeight = bitmapHeight;
+    pRequest->mpBitmap = pBitmap;
+}
+
+//-----------------------------------------------------------------------------
+
+GBitmap* TextureLoadQueue::decodeSource( TextureLoadRequest* pRequest )
+{
+    FileStream stream;
+    if ( !stream.open( pRequest->mFilePath, FileStream::Read ) )
+        return NULL;
+
+    GBitmap* pBitmap = new GBitmap();
+
+    bool loaded;
+    if ( pRequest->mSourceFormat == TextureLoadRequest::JPEG )
+    {
+        loaded = pBitmap->readJPEG( stream );
+    }
+    else
+    {
+#ifdef USE_APPLE_OPTIMIZED_PNGS
+        loaded = pBitmap->readPNGiPhone( stream );
+#else
+        loaded = pBitmap->readPNG( stream );
+#endif
+    }
+
+    stream.close();
+
+    if ( !loaded )
+    {
+        delete pBitmap;
+        return NULL;
+    }
+
+    return pBitmap;
+}
@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _TEXTURE_LOAD_QUEUE_H_
+#define _TEXTURE_LOAD_QUEUE_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+#include "platform/threads/mutex.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+class GBitmap;
+class TextureObject;
+class TextureLoadThread;
+
+//-----------------------------------------------------------------------------
+
+/// A single background texture load.
+///
+/// The main thread fills in the source and the texture object then posts the request.
+/// A worker reads and decodes the file and pads it to a power-of-two and the main thread
+/// later uploads the result.  Only the main thread ever touches the texture object.
+struct TextureLoadRequest
+{
+    enum SourceFormat
+    {
+        PNG,
+        JPEG,
+    };
+
+    TextureLoadRequest() :
+        mpTextureObject( NULL ),
+        mSourceFormat( PNG ),
+        mForce16Bit( false ),
+        mUseCache( false ),
+        mpBitmap( NULL ),
+        mBitmapWidth( 0 ),
+        mBitmapHeight( 0 )
+    {
+        mFilePath[0] = 0;
+    }
+
+    /// Main thread only.  Cleared if the texture is released before the load finishes.
+    TextureObject*  mpTextureObject;
+
+    /// Set by the main thread before posting.
+    char            mFilePath[1024];
+    SourceFormat    mSourceFormat;
+    bool            mForce16Bit;
+    bool            mUseCache;
+
+    /// Set by the worker.  The bitmap is NULL if the load failed.
+    GBitmap*        mpBitmap;
+    U32             mBitmapWidth;
+    U32             mBitmapHeight;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Worker threads that service texture load requests.
+///
+/// Requests are picked up in the order they were posted but may complete out of order
+/// when there is more than one worker.  Completed requests are collected by the main thread.
+/// Stopping the queue joins the workers and hands back any unstarted requests as failed.
+class TextureLoadQueue
+{
+    friend class TextureLoadThread;
+
+public:
+    TextureLoadQueue();
+    ~TextureLoadQueue();
+
+    void start( const U32 workerCount );
+    void stop( void );
+    inline bool isStarted( void ) const { return mWorkers.size() > 0; }
+
+    void post( TextureLoadRequest* pRequest );
+    TextureLoadRequest* popCompleted( void );
+
+    static void decode( TextureLoadRequest* pRequest );
+
+private:
+    static GBitmap* decodeSource( TextureLoadRequest* pRequest );
+
+    TextureLoadRequest* popPending( void );
+    void pushCompleted( TextureLoadRequest* pRequest );
+
+private:
+    Vector<TextureLoadThread*>      mWorkers;
+
+    Mutex                           mPendingMutex;
+    Vector<TextureLoadRequest*>     mPending;
+    U32                             mPendingHead;
+    Semaphore                       mPendingSignal;
+
+    Mutex                           mCompletedMutex;
+    Vector<TextureLoadRequest*>     mCompleted;
+    U32                             mCompletedHead;
+};
+
+#endif // _TEXTURE_LOAD_QUEUE_H_
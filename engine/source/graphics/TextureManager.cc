@@ -21,13 +21,17 @@
 //-----------------------------------------------------------------------------
 
 #include "graphics/TextureManager.h"
+#include "graphics/TextureLoadQueue.h"
+#include "graphics/TextureCache.h"
 
 #include "platform/platformAssert.h"
 #include "platform/platformGL.h"
 #include "platform/platform.h"
 #include "collection/vector.h"
 #include "io/resource/resourceManager.h"
+#include "io/fileStream.h"
 #include "graphics/gBitmap.h"
+#include "debug/profiler.h"
 #include "console/console.h"
 #include "console/consoleInternal.h"
 #include "console/consoleTypes.h"
@@ -47,6 +51,16 @@ S32 TextureManager::mBitmapResidentSize = 0;
 S32 TextureManager::mTextureResidentSize = 0;
 S32 TextureManager::mTextureResidentWasteSize = 0;
 S32 TextureManager::mTextureResidentCount = 0;
+bool TextureManager::mAsyncTextureLoading = true;
+S32 TextureManager::mAsyncTextureLoadThreads = 2;
+S32 TextureManager::mAsyncTextureUploadBudget = 4;
+S32 TextureManager::mAsyncTextureQueueDepth = 0;
+GLuint TextureObject::mPlaceholderGLTextureName = 0;
+
+static TextureLoadQueue* sgpTextureLoadQueue = NULL;
+
+// Defined in bitmapPng.cc.
+extern bool sgForcePalletedPNGsTo16Bit;
 
 //---------------------------------------------------------------------------------------------------------------------
 
@@ -159,6 +173,14 @@ void TextureManager::create()
     Con::addVariable("$pref::OpenGL::force16BitTexture", TypeBool, &TextureManager::mForce16BitTexture);
     Con::addVariable("$pref::OpenGL::allowTextureCompression", TypeBool, &TextureManager::mAllowTextureCompression);
     Con::addVariable("$pref::OpenGL::disableTextureSubImageUpdates", TypeBool, &TextureManager::mDisableTextureSubImageUpdates);
+    Con::addVariable("$pref::OpenGL::asyncTextureLoading", TypeBool, &TextureManager::mAsyncTextureLoading);
+    Con::addVariable("$pref::OpenGL::textureLoadThreads", TypeS32, &TextureManager::mAsyncTextureLoadThreads);
+    Con::addVariable("$pref::OpenGL::textureUploadBudget", TypeS32, &TextureManager::mAsyncTextureUploadBudget);
+
+    // Bound here so that bitmaps can be decoded off the main thread without console lookups.
+    Con::addVariable("$pref::iPhone::ForcePalletedPNGsTo16Bit", TypeBool, &sgForcePalletedPNGsTo16Bit);
+
+    TextureCache::create();
 
     // Flag as alive.
     mManagerState = Alive;
@@ -170,6 +192,33 @@ void TextureManager::destroy()
 {
     AssertISV(mManagerState != NotInitialized, "TextureManager::destroy - nothing to destroy!");
 
+    // Stop background loading and discard anything still outstanding.
+    if ( sgpTextureLoadQueue != NULL )
+    {
+        sgpTextureLoadQueue->stop();
+
+        TextureLoadRequest* pRequest;
+        while( (pRequest = sgpTextureLoadQueue->popCompleted()) != NULL )
+        {
+            if ( pRequest->mpTextureObject != NULL )
+                pRequest->mpTextureObject->mpLoadRequest = NULL;
+
+            SAFE_DELETE( pRequest->mpBitmap );
+            delete pRequest;
+        }
+
+        SAFE_DELETE( sgpTextureLoadQueue );
+    }
+    mAsyncTextureQueueDepth = 0;
+
+    // Stop the texture cache writer, dropping anything not yet written.
+    TextureCache::destroy();
+
+    // Destroy the placeholder texture.
+    if ( mDGLRender && TextureObject::mPlaceholderGLTextureName != 0 )
+        glDeleteTextures(1, &TextureObject::mPlaceholderGLTextureName);
+    TextureObject::mPlaceholderGLTextureName = 0;
+
     // Destroy the texture dictionary.
     TextureDictionary::destroy();
 
@@ -203,22 +252,30 @@ void TextureManager::killManager()
     TextureObject* probe = TextureDictionary::TextureObjectChain;
     while (probe) 
     {
+        // Textures still loading in the background have nothing resident yet.
         if (probe->mGLTextureName != 0)
         {
             deleteNames.push_back(probe->mGLTextureName);
+        
+            // Adjust metrics.
+            mTextureResidentCount--;
+            mTextureResidentSize -= probe->mTextureResidentSize;
+            probe->mTextureResidentSize = 0;
+            mTextureResidentWasteSize -= probe->mTextureResidentWasteSize;
+            probe->mTextureResidentWasteSize = 0;
         }
         probe->mGLTextureName = 0;
-        
-        // Adjust metrics.
-        mTextureResidentCount--;
-        mTextureResidentSize -= probe->mTextureResidentSize;
-        probe->mTextureResidentSize = 0;
-        mTextureResidentWasteSize -= probe->mTextureResidentWasteSize;
-        probe->mTextureResidentWasteSize = 0;
 
         probe = probe->next;
     }
 
+    // The placeholder is recreated on resurrection if needed.
+    if ( TextureObject::mPlaceholderGLTextureName != 0 )
+    {
+        deleteNames.push_back(TextureObject::mPlaceholderGLTextureName);
+        TextureObject::mPlaceholderGLTextureName = 0;
+    }
+
     // Delete all textures.
     glDeleteTextures(deleteNames.size(), deleteNames.address());
 }
@@ -237,10 +294,21 @@ void TextureManager::resurrectManager( void )
     // Post begin resurrection event.
     postTextureEvent(BeginResurrection);
 
+    // Recreate the placeholder if background loads are outstanding.
+    if ( mAsyncTextureQueueDepth > 0 )
+        createPlaceholderTexture();
+
     // Resurrect textures.
     TextureObject* probe = TextureDictionary::TextureObjectChain;
     while (probe) 
     {
+        // Skip textures still loading in the background, they are uploaded when finalized.
+        if ( probe->mpLoadRequest != NULL )
+        {
+            probe = probe->next;
+            continue;
+        }
+
         switch( probe->mHandleType )
         {
             case TextureHandle::BitmapTexture:
@@ -249,13 +317,14 @@ void TextureManager::resurrectManager( void )
                     AssertISV( probe->mTextureKey != NULL && probe->mTextureKey != StringTable->EmptyString, "Encountered a bitmap texture that didn't specify its bitmap." );
 
                     // Load the bitmap.
-                    GBitmap* pBitmap = loadBitmap( probe->mTextureKey );
+                    U32 bitmapWidth, bitmapHeight;
+                    GBitmap* pBitmap = loadBitmap( probe->mTextureKey, true, false, &bitmapWidth, &bitmapHeight );
 
                     // Sanity!
                     AssertISV(pBitmap != NULL, "Error resurrecting the texture cache.\n""Possible cause: a bitmap was deleted during the course of gameplay.");
 
                     // Register texture.
-                    TextureObject* pTextureObject = registerTexture(probe->mTextureKey, pBitmap, probe->mHandleType, probe->mClamp);
+                    TextureObject* pTextureObject = registerTexture(probe->mTextureKey, pBitmap, probe->mHandleType, probe->mClamp, bitmapWidth, bitmapHeight);
 
                     // Sanity!
                     AssertFatal(pTextureObject == probe, "A new texture was returned during resurrection.");
@@ -363,6 +432,10 @@ GBitmap* TextureManager::createPowerOfTwoBitmap(GBitmap* pBitmap)
 
 void TextureManager::freeTexture( TextureObject* pTextureObject )
 {
+    // Abandon any background load, the worker result is discarded when collected.
+    if ( pTextureObject->mpLoadRequest != NULL )
+        cancelAsyncLoad( pTextureObject );
+
     if((mDGLRender || mManagerState == Resurrecting) && pTextureObject->mGLTextureName)
     {
         glDeleteTextures(1, (const GLuint*)&pTextureObject->mGLTextureName);
@@ -537,45 +610,26 @@ U16* TextureManager::create16BitBitmap( GBitmap *pDL, U8 *in_source8, GBitmap::B
 {
     //PUAP -Mat make 16 bit
     U16 *texture_data = new U16[width * height];
-    U16 *dest = texture_data;
-    U32 *source = (U32*)in_source8;
-    //since the pointer is 4 bytes, multiply by the number of bytes per pixel over 4
+    //the source is walked as 32-bit words, multiply by the number of bytes per pixel over 4
     U32 spanInBytes = (U32)((width * height) * (pDL->bytesPerPixel / 4.0f));
-    U32 *source_end = source + spanInBytes;
 
+    // The conversions go through the GBitmap kernel hooks so they pick up the
+    // vectorized versions where the processor supports them.
     switch (alpha_info) {
         case GBitmap::Alpha: //ALPHA_TRANSPARENT:
-            while (source != source_end) {
-                U32 color = *source++;
-                *dest++ = ((color & 0xF8) << 8) | ((color & 0xF800) >> 5) | ((color & 0xF80000) >> 18) | (color >> 31);
-            }
+            bitmapConvertRGBA_to_5551( in_source8, texture_data, spanInBytes );
             *GLformat = GL_RGBA;
             *GLdata_type = GL_UNSIGNED_SHORT_5_5_5_1;
             break;
             case GBitmap::RGBA://ALPHA_BLEND
-            while (source != source_end) {
-                U32 color = *source++;
-                *dest++ = ((color & 0xF0) << 8) | ((color & 0xF000) >> 4) | ((color & 0xF00000) >> 16) | ((color & 0xF0000000) >> 28);
-            }
+            bitmapConvertRGBA_to_4444( in_source8, texture_data, spanInBytes );
             *GLformat = GL_RGBA;
             *GLdata_type = GL_UNSIGNED_SHORT_4_4_4_4;
         break;
 
         default://ALPHA_NONE
-            U8 *source8 = (U8*)source;
-            //32 bytes per address, snce we are casting to U8 we need 4 times as many
-            U8 *end8 = source8 + (U32)(spanInBytes*4);
-            while (source8 < end8) {
-                U16 red = (U16)*source8;
-                source8++;
-                U16 green = (U16)*source8;
-                source8++;
-                U16 blue = (U16)*source8;
-                source8++;
-                //now color should be == RR GG BB 00
-                *dest = ((red & 0xF8) << 8) | ((green & 0xFC) << 3) | ((blue & 0xF8) >> 3);
-                dest++;
-            }
+            //3 bytes per pixel, rounding up to cover a partial trailing pixel
+            bitmapConvertRGB_to_565( in_source8, texture_data, (spanInBytes * 4 + 2) / 3 );
             *GLformat = GL_RGB;
             *GLdata_type = GL_UNSIGNED_SHORT_5_6_5;
         break;
@@ -705,15 +759,20 @@ void TextureManager::refresh( const char *textureName )
     if ( pTextureObject->getHandleType() == TextureHandle::BitmapKeepTexture )
         return;
 
+    // Reload immediately rather than waiting on any background load.
+    if ( pTextureObject->mpLoadRequest != NULL )
+        cancelAsyncLoad( pTextureObject );
+
     // Load the bitmap.
-    GBitmap* pBitmap = loadBitmap( pTextureObject->mTextureKey );
+    U32 bitmapWidth, bitmapHeight;
+    GBitmap* pBitmap = loadBitmap( pTextureObject->mTextureKey, true, false, &bitmapWidth, &bitmapHeight );
 
     // Finish if bitmap could not be loaded.
     if ( pBitmap == NULL )
         return;
 
     // Register texture.
-    TextureObject* pNewTextureObject = registerTexture(pTextureObject->mTextureKey, pBitmap, pTextureObject->mHandleType, pTextureObject->mClamp);
+    TextureObject* pNewTextureObject = registerTexture(pTextureObject->mTextureKey, pBitmap, pTextureObject->mHandleType, pTextureObject->mClamp, bitmapWidth, bitmapHeight);
 
     // Sanity!
     AssertFatal(pNewTextureObject == pTextureObject, "A new texture was returned during refresh.");
@@ -752,7 +811,7 @@ void TextureManager::createGLName( TextureObject* pTextureObject )
 
 //--------------------------------------------------------------------------------------------------------------------
 
-TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge)
+TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge, U32 bitmapWidth, U32 bitmapHeight)
 {
     // Sanity!
     AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
@@ -811,9 +870,19 @@ TextureObject* TextureManager::registerTexture(const char* pTextureKey, GBitmap*
         mBitmapResidentSize += pTextureObject->mBitmapResidentSize;
     }
 
+    // Without source dimensions the bitmap is the source image, otherwise it is already padded.
+    if ( bitmapWidth == 0 || bitmapHeight == 0 )
+    {
+        bitmapWidth  = pNewBitmap->getWidth();
+        bitmapHeight = pNewBitmap->getHeight();
+    }
+
+    // Sanity!
+    AssertFatal( pTextureObject->mHandleType != TextureHandle::BitmapKeepTexture || ( bitmapWidth == pNewBitmap->getWidth() && bitmapHeight == pNewBitmap->getHeight() ), "Kept bitmaps cannot be padded." );
+
     pTextureObject->mpBitmap           = pNewBitmap;
-    pTextureObject->mBitmapWidth       = pNewBitmap->getWidth();
-    pTextureObject->mBitmapHeight      = pNewBitmap->getHeight();
+    pTextureObject->mBitmapWidth       = bitmapWidth;
+    pTextureObject->mBitmapHeight      = bitmapHeight;
     pTextureObject->mTextureWidth      = getNextPow2(pNewBitmap->getWidth());
     pTextureObject->mTextureHeight     = getNextPow2(pNewBitmap->getHeight());
     pTextureObject->mClamp             = clampToEdge;
@@ -850,18 +919,28 @@ TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandl
 
     TextureObject *ret = TextureDictionary::find(textureKey, type, clampToEdge);
 
+    // Callers expect a usable texture so wait for any background load of it.
+    if ( ret != NULL && ret->isLoadPending() && !finishAsyncLoad( ret ) )
+        return NULL;
+
     GBitmap *bmp = NULL;
 
+    // Bitmaps that are not kept can arrive already padded.
+    U32 bitmapWidth = 0;
+    U32 bitmapHeight = 0;
+    U32* pBitmapWidth = type == TextureHandle::BitmapKeepTexture ? NULL : &bitmapWidth;
+    U32* pBitmapHeight = type == TextureHandle::BitmapKeepTexture ? NULL : &bitmapHeight;
+
     if( ret == NULL )
     {
         // Ok, no hit - is it in the current dir? If so then let's grab it
         // and use it.
-        bmp = loadBitmap(textureKey, false);
+        bmp = loadBitmap(textureKey, false, false, pBitmapWidth, pBitmapHeight);
 
         if(bmp)
         {
             bmp->mForce16Bit = force16Bit;
-            return registerTexture(textureKey, bmp, type, clampToEdge);
+            return registerTexture(textureKey, bmp, type, clampToEdge, bitmapWidth, bitmapHeight);
         }
     }
 
@@ -874,7 +953,7 @@ TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandl
         return NULL;
 
     // Ok, no success so let's try actually loading a texture.
-    bmp = loadBitmap(textureKey);
+    bmp = loadBitmap(textureKey, true, false, pBitmapWidth, pBitmapHeight);
 
     if(!bmp)
     {
@@ -883,12 +962,299 @@ TextureObject *TextureManager::loadTexture(const char* pTextureKey, TextureHandl
     }
     bmp->mForce16Bit = force16Bit;
 
-    return registerTexture(textureKey, bmp, type, clampToEdge);
+    return registerTexture(textureKey, bmp, type, clampToEdge, bitmapWidth, bitmapHeight);
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+TextureObject* TextureManager::loadTextureAsync( const char* pTextureKey, TextureHandle::TextureHandleType type, bool clampToEdge, bool force16Bit )
+{
+    // Sanity!
+    AssertISV( type != TextureHandle::InvalidTexture, "Invalid texture type." );
+
+    // Finish if texture key is invalid.
+    if( pTextureKey == NULL || *pTextureKey == 0)
+        return NULL;
+
+    // Only bitmaps that are not kept can be loaded in the background.
+    if ( !mAsyncTextureLoading || type != TextureHandle::BitmapTexture || !mDGLRender || mManagerState != Alive )
+        return loadTexture( pTextureKey, type, clampToEdge, false, force16Bit );
+
+    // Fetch texture key.
+    StringTableEntry textureKey = StringTable->insert(pTextureKey);
+
+    // Finish if already loaded or loading.
+    TextureObject* pTextureObject = TextureDictionary::find(textureKey, type, clampToEdge);
+    if ( pTextureObject != NULL )
+        return pTextureObject;
+
+    // Load immediately if the source cannot be read in the background.
+    U32 bitmapWidth, bitmapHeight;
+    TextureLoadRequest* pRequest = new TextureLoadRequest();
+    if ( !findAsyncSource( textureKey, pRequest, bitmapWidth, bitmapHeight ) )
+    {
+        delete pRequest;
+        return loadTexture( textureKey, type, clampToEdge, false, force16Bit );
+    }
+    pRequest->mForce16Bit = force16Bit;
+
+    // Create the texture object now so that its dimensions are available immediately.
+    pTextureObject = new TextureObject();
+    pTextureObject->mTextureKey        = textureKey;
+    pTextureObject->mHandleType        = type;
+    pTextureObject->mBitmapWidth       = bitmapWidth;
+    pTextureObject->mBitmapHeight      = bitmapHeight;
+    pTextureObject->mTextureWidth      = getNextPow2(bitmapWidth);
+    pTextureObject->mTextureHeight     = getNextPow2(bitmapHeight);
+    pTextureObject->mClamp             = clampToEdge;
+    pTextureObject->mpLoadRequest      = pRequest;
+    pRequest->mpTextureObject          = pTextureObject;
+    TextureDictionary::insert(pTextureObject);
+
+    // Make sure there is something to bind in the meantime.
+    createPlaceholderTexture();
+
+    // Start the workers on first use.
+    if ( sgpTextureLoadQueue == NULL )
+        sgpTextureLoadQueue = new TextureLoadQueue();
+
+    sgpTextureLoadQueue->start( mAsyncTextureLoadThreads );
+    sgpTextureLoadQueue->post( pRequest );
+    mAsyncTextureQueueDepth++;
+
+    return pTextureObject;
 }
 
 //--------------------------------------------------------------------------------------------------------------------
 
-GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool nocompression )
+bool TextureManager::findAsyncSource( const char* pTextureKey, TextureLoadRequest* pRequest, U32& bitmapWidth, U32& bitmapHeight )
+{
+    char fileNameBuffer[512];
+    Platform::makeFullPathName( pTextureKey, fileNameBuffer, 512 );
+
+    // Loop through the supported extensions to find the file, as loadBitmap() does.
+    U32 len = dStrlen(fileNameBuffer);
+    for (U32 i = 0; i < EXT_ARRAY_SIZE; i++)
+    {
+        dStrcpy(fileNameBuffer + len, extArray[i]);
+        ResourceObject* pResource = ResourceManager->find(fileNameBuffer);
+        if ( pResource == NULL )
+            continue;
+
+        // Only loose files are read in the background as zipped resources share their archive stream.
+        if ( (pResource->flags & ResourceObject::File) == 0 )
+            return false;
+
+        // Only formats with reentrant decoders.
+        const char* pExtension = dStrrchr( pResource->name, '.' );
+        if ( pExtension == NULL )
+            return false;
+
+        if ( dStricmp( pExtension, ".png" ) == 0 )
+            pRequest->mSourceFormat = TextureLoadRequest::PNG;
+        else if ( dStricmp( pExtension, ".jpg" ) == 0 || dStricmp( pExtension, ".jpeg" ) == 0 )
+            pRequest->mSourceFormat = TextureLoadRequest::JPEG;
+        else
+            return false;
+
+        Platform::makeFullPathName( pResource->name, pRequest->mFilePath, sizeof(pRequest->mFilePath), pResource->path );
+        pRequest->mUseCache = TextureCache::isEnabled();
+
+        // Read the dimensions now, they are needed before the pixels arrive.
+        FileStream stream;
+        if ( !stream.open( pRequest->mFilePath, FileStream::Read ) )
+            return false;
+
+        const bool dimensionsRead = pRequest->mSourceFormat == TextureLoadRequest::PNG ?
+            GBitmap::readPNGDimensions( stream, bitmapWidth, bitmapHeight ) :
+            GBitmap::readJPEGDimensions( stream, bitmapWidth, bitmapHeight );
+
+        stream.close();
+
+        // Leave oversized bitmaps for loadBitmap() to report.
+        return dimensionsRead && bitmapWidth <= MaximumProductSupportedTextureWidth && bitmapHeight <= MaximumProductSupportedTextureHeight;
+    }
+
+    return false;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::createPlaceholderTexture( void )
+{
+    // Finish if not appropriate or already created.
+    if ( !mDGLRender || TextureObject::mPlaceholderGLTextureName != 0 )
+        return;
+
+    // A single transparent texel so that pending textures draw nothing.
+    const U8 texel[4] = { 0, 0, 0, 0 };
+
+    glGenTextures(1, &TextureObject::mPlaceholderGLTextureName);
+    glBindTexture(GL_TEXTURE_2D, TextureObject::mPlaceholderGLTextureName);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::cancelAsyncLoad( TextureObject* pTextureObject )
+{
+    // Sanity!
+    AssertFatal( pTextureObject->mpLoadRequest != NULL, "TextureManager::cancelAsyncLoad() - Texture is not loading." );
+
+    // Detach the request, it is discarded when the worker hands it back.
+    pTextureObject->mpLoadRequest->mpTextureObject = NULL;
+    pTextureObject->mpLoadRequest = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::finalizeAsyncLoad( TextureLoadRequest* pRequest )
+{
+    mAsyncTextureQueueDepth--;
+
+    TextureObject* pTextureObject = pRequest->mpTextureObject;
+
+    // Discard the result if the texture was released or reloaded in the meantime.
+    if ( pTextureObject == NULL )
+    {
+        SAFE_DELETE( pRequest->mpBitmap );
+        delete pRequest;
+        return;
+    }
+
+    pTextureObject->mpLoadRequest = NULL;
+
+    if ( pRequest->mpBitmap == NULL )
+    {
+        Con::warnf( "TextureManager::finalizeAsyncLoad() - Could not load texture '%s'.", pTextureObject->mTextureKey );
+        delete pRequest;
+        return;
+    }
+
+    // The header should always agree with the decoded bitmap.
+    if ( pRequest->mBitmapWidth != pTextureObject->mBitmapWidth || pRequest->mBitmapHeight != pTextureObject->mBitmapHeight )
+    {
+        Con::warnf( "TextureManager::finalizeAsyncLoad() - Texture '%s' decoded as (%d-%d) but its header reported (%d-%d).",
+            pTextureObject->mTextureKey,
+            pRequest->mBitmapWidth, pRequest->mBitmapHeight,
+            pTextureObject->mBitmapWidth, pTextureObject->mBitmapHeight );
+
+        pTextureObject->mBitmapWidth   = pRequest->mBitmapWidth;
+        pTextureObject->mBitmapHeight  = pRequest->mBitmapHeight;
+        pTextureObject->mTextureWidth  = pRequest->mpBitmap->getWidth();
+        pTextureObject->mTextureHeight = pRequest->mpBitmap->getHeight();
+    }
+
+    // Upload the already padded bitmap.
+    pTextureObject->mpBitmap = pRequest->mpBitmap;
+    createGLName( pTextureObject );
+
+    // Delete bitmap as this is never a kept texture.
+    delete pTextureObject->mpBitmap;
+    pTextureObject->mpBitmap = NULL;
+
+    delete pRequest;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+bool TextureManager::finishAsyncLoad( TextureObject* pTextureObject )
+{
+    // Sanity!
+    AssertFatal( pTextureObject->mpLoadRequest != NULL, "TextureManager::finishAsyncLoad() - Texture is not loading." );
+
+    // Fail if the result cannot be uploaded now.
+    if ( sgpTextureLoadQueue == NULL || !mDGLRender || mManagerState != Alive )
+    {
+        Con::warnf( "TextureManager::finishAsyncLoad() - Cannot wait for texture '%s' to load.", pTextureObject->mTextureKey );
+        return false;
+    }
+
+    // Finalize completed loads in order until this one has been handed back.
+    while( pTextureObject->mpLoadRequest != NULL )
+    {
+        TextureLoadRequest* pRequest = sgpTextureLoadQueue->popCompleted();
+
+        if ( pRequest == NULL )
+        {
+            Platform::sleep( 1 );
+            continue;
+        }
+
+        finalizeAsyncLoad( pRequest );
+    }
+
+    // A failed decode leaves the texture without a name.
+    return pTextureObject->mGLTextureName != 0;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::processAsyncLoads( void )
+{
+    // Finish if nothing is outstanding or we cannot upload.
+    if ( mAsyncTextureQueueDepth == 0 || sgpTextureLoadQueue == NULL || !mDGLRender || mManagerState != Alive )
+        return;
+
+    // Debug Profiling.
+    PROFILE_SCOPE(TextureManager_ProcessAsyncLoads);
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    TextureLoadRequest* pRequest;
+    while( (pRequest = sgpTextureLoadQueue->popCompleted()) != NULL )
+    {
+        finalizeAsyncLoad( pRequest );
+
+        // Stop once the budget is spent, at least one texture is always uploaded.
+        if ( (S32)(Platform::getRealMilliseconds() - startTime) >= mAsyncTextureUploadBudget )
+            break;
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+void TextureManager::finishAsyncLoads( void )
+{
+    // Finish if nothing is outstanding or we cannot upload.
+    if ( mAsyncTextureQueueDepth == 0 || sgpTextureLoadQueue == NULL || !mDGLRender || mManagerState != Alive )
+        return;
+
+    while( mAsyncTextureQueueDepth > 0 )
+    {
+        TextureLoadRequest* pRequest = sgpTextureLoadQueue->popCompleted();
+
+        if ( pRequest == NULL )
+        {
+            Platform::sleep( 1 );
+            continue;
+        }
+
+        finalizeAsyncLoad( pRequest );
+    }
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+ConsoleFunction( getTextureLoadQueueDepth, S32, 1, 1, "() Gets the number of textures requested for background loading that have not yet been uploaded.\n"
+                                                      "@return The number of outstanding background texture loads.")
+{
+    return TextureManager::getAsyncQueueDepth();
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+ConsoleFunction( finishTextureLoads, void, 1, 1, "() Blocks until all outstanding background texture loads have been uploaded.\n"
+                                                 "@return No return value.")
+{
+    TextureManager::finishAsyncLoads();
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
+GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool nocompression, U32* pBitmapWidth, U32* pBitmapHeight )
 {
     char fileNameBuffer[512];
     Platform::makeFullPathName( pTextureKey, fileNameBuffer, 512 );
@@ -906,9 +1272,15 @@ GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool
 #endif
         dStrcpy(fileNameBuffer + len, extArray[i]);
 
-        bmp = (GBitmap*)ResourceManager->loadInstance(fileNameBuffer);
+        bmp = loadResourceBitmap(fileNameBuffer, pBitmapWidth, pBitmapHeight);
+        if ( bmp == NULL )
+            continue;
+
+        // Check the source dimensions as the bitmap may be padded.
+        const U32 bitmapWidth = pBitmapWidth != NULL ? *pBitmapWidth : bmp->getWidth();
+        const U32 bitmapHeight = pBitmapHeight != NULL ? *pBitmapHeight : bmp->getHeight();
 
-        if ( bmp != NULL && (bmp->getWidth() > MaximumProductSupportedTextureWidth || bmp->getHeight() > MaximumProductSupportedTextureHeight) )
+        if ( bitmapWidth > MaximumProductSupportedTextureWidth || bitmapHeight > MaximumProductSupportedTextureHeight )
         {
             Con::warnf( "TextureManager::loadBitmap() - Cannot load bitmap '%s' as its dimensions exceed the maximum product-supported texture dimension.", fileNameBuffer );
             delete bmp;
@@ -921,6 +1293,76 @@ GBitmap *TextureManager::loadBitmap( const char* pTextureKey, bool recurse, bool
 
 //--------------------------------------------------------------------------------------------------------------------
 
+GBitmap* TextureManager::loadResourceBitmap( const char* pFileName, U32* pBitmapWidth, U32* pBitmapHeight )
+{
+    GBitmap* pBitmap = NULL;
+    U32 bitmapWidth = 0;
+    U32 bitmapHeight = 0;
+
+    // Only loose files are cached.
+    ResourceObject* pResource = TextureCache::isEnabled() ? ResourceManager->find( pFileName ) : NULL;
+    if ( pResource == NULL || (pResource->flags & ResourceObject::File) == 0 )
+    {
+        pBitmap = (GBitmap*)ResourceManager->loadInstance( pFileName );
+    }
+    else
+    {
+        char sourcePath[1024];
+        Platform::makeFullPathName( pResource->name, sourcePath, sizeof(sourcePath), pResource->path );
+
+        pBitmap = TextureCache::load( sourcePath, bitmapWidth, bitmapHeight );
+
+        if ( pBitmap == NULL )
+        {
+            // Decode, pad and queue the result to be cached for next time.  The write happens off this thread.
+            const U32 startTime = Platform::getRealMilliseconds();
+            GBitmap* pSourceBitmap = (GBitmap*)ResourceManager->loadInstance( pResource );
+            if ( pSourceBitmap != NULL && TextureCache::canStore( pSourceBitmap ) )
+            {
+                pBitmap = createPowerOfTwoBitmap( pSourceBitmap );
+                bitmapWidth = pSourceBitmap->getWidth();
+                bitmapHeight = pSourceBitmap->getHeight();
+                TextureCache::store( sourcePath, pBitmap, bitmapWidth, bitmapHeight, Platform::getRealMilliseconds() - startTime );
+
+                // Hand back the source if the caller needs it.
+                if ( pBitmapWidth == NULL && pBitmap != pSourceBitmap )
+                {
+                    delete pBitmap;
+                    pBitmap = pSourceBitmap;
+                }
+                else if ( pBitmap != pSourceBitmap )
+                {
+                    delete pSourceBitmap;
+                }
+            }
+            else
+            {
+                pBitmap = pSourceBitmap;
+                bitmapWidth = bitmapHeight = 0;
+            }
+        }
+        else if ( pBitmapWidth == NULL && ( bitmapWidth != pBitmap->getWidth() || bitmapHeight != pBitmap->getHeight() ) )
+        {
+            // The caller needs the source so crop off the padding.
+            GBitmap* pSourceBitmap = new GBitmap( bitmapWidth, bitmapHeight, false, pBitmap->getFormat() );
+            pSourceBitmap->copyRect( pBitmap, RectI( 0, 0, bitmapWidth, bitmapHeight ), Point2I( 0, 0 ) );
+            delete pBitmap;
+            pBitmap = pSourceBitmap;
+        }
+    }
+
+    // Bitmaps that did not come through the cache are the source.
+    if ( pBitmap != NULL && pBitmapWidth != NULL )
+    {
+        *pBitmapWidth  = bitmapWidth != 0 ? bitmapWidth : pBitmap->getWidth();
+        *pBitmapHeight = bitmapHeight != 0 ? bitmapHeight : pBitmap->getHeight();
+    }
+
+    return pBitmap;
+}
+
+//--------------------------------------------------------------------------------------------------------------------
+
 ConsoleFunction( dumpTextureManagerMetrics, void, 1, 1, "() Dump the texture manager metrics." )
 {
     return TextureManager::dumpMetrics();
@@ -977,12 +1419,13 @@ void TextureManager::dumpMetrics( void )
 
     // Info.
     Con::printf( "Metrics Totals:" );
-    Con::printf( "TextureCount: %d, TextureSize: %d, TextureWasteSize: %d, BitmapSize: %d, ResidentFraction: %g",
+    Con::printf( "TextureCount: %d, TextureSize: %d, TextureWasteSize: %d, BitmapSize: %d, ResidentFraction: %g, AsyncQueueDepth: %d",
         mTextureResidentCount,
         mTextureResidentSize,
         mTextureResidentWasteSize,
         mBitmapResidentSize,
-        getResidentFraction() );
+        getResidentFraction(),
+        mAsyncTextureQueueDepth );
 
     Con::printBlankLine();
     Con::printSeparator();
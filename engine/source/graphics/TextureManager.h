@@ -45,10 +45,13 @@
 #define MaximumProductSupportedTextureWidth 2048
 #define MaximumProductSupportedTextureHeight MaximumProductSupportedTextureWidth
 
+struct TextureLoadRequest;
+
 class TextureManager
 {
    friend class TextureHandle;
    friend class TextureDictionary;
+   friend class TextureLoadQueue;
 
 public:
     /// Texture manager event codes.
@@ -80,6 +83,10 @@ private:
     static bool mForce16BitTexture;
     static bool mAllowTextureCompression;
     static bool mDisableTextureSubImageUpdates;
+    static bool mAsyncTextureLoading;
+    static S32 mAsyncTextureLoadThreads;
+    static S32 mAsyncTextureUploadBudget;
+    static S32 mAsyncTextureQueueDepth;
 
 public:
     static bool mDGLRender;
@@ -99,6 +106,16 @@ public:
     static S32 getTextureResidentWasteSize( void ) { return mTextureResidentWasteSize; }
     static S32 getTextureResidentCount( void ) { return mTextureResidentCount; }
 
+    /// Asynchronous loading.
+    /// Finalize completed background loads, uploading for at most the per-frame budget.
+    static void processAsyncLoads( void );
+    /// Block until every outstanding background load has been uploaded.
+    static void finishAsyncLoads( void );
+    /// Loads that have been requested but not yet uploaded.
+    static S32 getAsyncQueueDepth( void ) { return mAsyncTextureQueueDepth; }
+    static S32 getAsyncUploadBudget( void ) { return mAsyncTextureUploadBudget; }
+    static void setAsyncUploadBudget( const S32 budgetMS ) { mAsyncTextureUploadBudget = budgetMS; }
+
     static U32  registerEventCallback(TextureEventCallback, void *userData);
     static void unregisterEventCallback(const U32 callbackKey);
 
@@ -110,12 +127,22 @@ private:
     static void postTextureEvent(const TextureEventCode eventCode);
 
     static void createGLName( TextureObject* pTextureObject );
-    static TextureObject* registerTexture(const char *textureName, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge);
+    static TextureObject* registerTexture(const char *textureName, GBitmap* pNewBitmap, TextureHandle::TextureHandleType type, bool clampToEdge, U32 bitmapWidth = 0, U32 bitmapHeight = 0);
     static TextureObject* loadTexture(const char *textureName, TextureHandle::TextureHandleType type, bool clampToEdge, bool checkOnly = false, bool force16Bit = false );
+    static TextureObject* loadTextureAsync(const char *textureName, TextureHandle::TextureHandleType type, bool clampToEdge, bool force16Bit = false );
     static void freeTexture( TextureObject* pTextureObject );
     static void refresh(TextureObject* pTextureObject);
 
-    static GBitmap* loadBitmap(const char *textureName, bool recurse = true, bool nocompression = false);
+    static bool findAsyncSource( const char* pTextureKey, TextureLoadRequest* pRequest, U32& bitmapWidth, U32& bitmapHeight );
+    static void finalizeAsyncLoad( TextureLoadRequest* pRequest );
+    static bool finishAsyncLoad( TextureObject* pTextureObject );
+    static void cancelAsyncLoad( TextureObject* pTextureObject );
+    static void createPlaceholderTexture( void );
+
+    /// Passing the bitmap dimensions allows a bitmap already padded to a power-of-two to be returned,
+    /// with the dimensions of the source image returned through them.
+    static GBitmap* loadBitmap(const char *textureName, bool recurse = true, bool nocompression = false, U32* pBitmapWidth = NULL, U32* pBitmapHeight = NULL);
+    static GBitmap* loadResourceBitmap( const char* pFileName, U32* pBitmapWidth, U32* pBitmapHeight );
     static GBitmap* createPowerOfTwoBitmap( GBitmap* pBitmap );
     static U16* create16BitBitmap( GBitmap *pDL, U8 *in_source8, GBitmap::BitmapFormat alpha_info, GLint *GLformat, GLint *GLdata_type, U32 width, U32 height );
     static void getSourceDestByteFormat(GBitmap *pBitmap, U32 *sourceFormat, U32 *destFormat, U32 *byteFormat, U32* texelSize);
@@ -43,6 +43,7 @@
 //-----------------------------------------------------------------------------
 
 class GBitmap;
+struct TextureLoadRequest;
 
 //------------------------------------------------------------------------------
 
@@ -74,6 +75,10 @@ private:
 
     TextureHandle::TextureHandleType mHandleType;
 
+    /// Outstanding asynchronous load, if any.  Until it is finalized the texture binds the placeholder.
+    TextureLoadRequest* mpLoadRequest;
+    static GLuint       mPlaceholderGLTextureName;
+
 public:
     TextureObject() :
         next( NULL ), prev( NULL ), hashNext( NULL ),
@@ -90,12 +95,14 @@ public:
         mBitmapHeight( 0 ),
         mFilter( GL_NEAREST ),
         mClamp( false ),
-        mHandleType( TextureHandle::InvalidTexture )
+        mHandleType( TextureHandle::InvalidTexture ),
+        mpLoadRequest( NULL )
     {
     }
 
     inline StringTableEntry getTextureKey( void ) { return mTextureKey; }
-    inline GLuint getGLTextureName( void ) { return mGLTextureName; }
+    inline GLuint getGLTextureName( void ) { return mpLoadRequest == NULL ? mGLTextureName : mPlaceholderGLTextureName; }
+    inline bool isLoadPending( void ) const { return mpLoadRequest != NULL; }
     inline const GBitmap* getBitmap( void ) { return mpBitmap; }
     inline U32 getTextureWidth( void ) { return mTextureWidth; }
     inline U32 getTextureHeight( void ) { return mTextureHeight; }
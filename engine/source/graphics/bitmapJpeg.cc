@@ -148,6 +148,63 @@ bool GBitmap::readJPEG(Stream &stream)
 }
 
 
+//--------------------------------------------------------------------------
+bool GBitmap::readJPEGDimensions(Stream& stream, U32& width, U32& height)
+{
+   U8 marker[4];
+
+   // Start of image.
+   if (!stream.read(2, marker) || marker[0] != 0xFF || marker[1] != 0xD8)
+      return false;
+
+   // Walk the marker segments until we reach a start-of-frame.
+   for (;;)
+   {
+      if (!stream.read(2, marker) || marker[0] != 0xFF)
+         return false;
+
+      // Skip fill bytes.
+      while (marker[1] == 0xFF)
+      {
+         if (!stream.read(1, marker + 1))
+            return false;
+      }
+
+      // Stand-alone markers carry no length.
+      if ((marker[1] >= 0xD0 && marker[1] <= 0xD7) || marker[1] == 0x01)
+         continue;
+
+      // End of image or start of scan without a frame header.
+      if (marker[1] == 0xD9 || marker[1] == 0xDA)
+         return false;
+
+      if (!stream.read(2, marker + 2))
+         return false;
+
+      const U32 segmentLength = (marker[2] << 8) | marker[3];
+      if (segmentLength < 2)
+         return false;
+
+      // SOF0-SOF15 excluding DHT, JPG and DAC.
+      const bool startOfFrame = marker[1] >= 0xC0 && marker[1] <= 0xCF &&
+                                marker[1] != 0xC4 && marker[1] != 0xC8 && marker[1] != 0xCC;
+      if (startOfFrame)
+      {
+         U8 frame[5];
+         if (!stream.read(sizeof(frame), frame))
+            return false;
+
+         height = (frame[1] << 8) | frame[2];
+         width  = (frame[3] << 8) | frame[4];
+         return width != 0 && height != 0;
+      }
+
+      if (!stream.setPosition(stream.getPosition() + segmentLength - 2))
+         return false;
+   }
+}
+
+
 //--------------------------------------------------------------------------
 bool GBitmap::writeJPEG(Stream& stream) const
 {
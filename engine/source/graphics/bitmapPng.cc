@@ -29,7 +29,6 @@
 
 
 //-Mat used when checking for palleted textures
-#include "console/console.h"
 bool sgForcePalletedPNGsTo16Bit= false;
 
 
@@ -46,40 +45,37 @@ bool sgForcePalletedPNGsTo16Bit= false;
 // Our chunk signatures...
 
 static const U32 csgMaxRowPointers = (1 << GBitmap::c_maxMipLevels) - 1; ///< 2^11 = 2048, 12 mip levels (see c_maxMipLievels)
-static png_bytep sRowPointers[csgMaxRowPointers];
-
-//-------------------------------------- Instead of using the user_ptr,
-//                                        we use a global pointer, we
-//                                        need to ensure that only one thread
-//                                        at once may be using the variable.
-//                                       NOTE: Removed mutex for g_varAccess.
-//                                        may have to re-thread safe this.
-static Stream* sg_pStream = NULL;
 
 //-------------------------------------- Replacement I/O for standard LIBPng
 //                                        functions.  we don't wanna use
-//                                        FILE*'s...
-static void pngReadDataFn(png_structp  /*png_ptr*/,
+//                                        FILE*'s...  The stream travels in
+//                                        the io_ptr so that bitmaps can be
+//                                        decoded on several threads at once.
+static void pngReadDataFn(png_structp  png_ptr,
                           png_bytep   data,
                           png_size_t  length)
 {
-   AssertFatal(sg_pStream != NULL, "No stream?");
+   Stream* pStream = (Stream*)png_get_io_ptr(png_ptr);
+   AssertFatal(pStream != NULL, "No stream?");
 
    bool success;
-   success = sg_pStream->read(length, data);
-    
-   AssertFatal(success, "PNG read catastrophic error!");
+   success = pStream->read(length, data);
+
+   // A truncated stream unwinds through the setjmp in readPNG.
+   if (!success)
+      png_error(png_ptr, "PNG read catastrophic error!");
 }
 
 
 //--------------------------------------
-static void pngWriteDataFn(png_structp /*png_ptr*/,
+static void pngWriteDataFn(png_structp png_ptr,
                            png_bytep   data,
                            png_size_t  length)
 {
-   AssertFatal(sg_pStream != NULL, "No stream?");
+   Stream* pStream = (Stream*)png_get_io_ptr(png_ptr);
+   AssertFatal(pStream != NULL, "No stream?");
 
-   sg_pStream->write(length, data);
+   pStream->write(length, data);
 }
 
 
@@ -100,6 +96,18 @@ static void pngFreeFn(png_structp /*png_ptr*/, png_voidp /*mem*/)
 //   dFree(mem);
 }
 
+//-------------------------------------- The frame allocator belongs to the
+//                                        main thread so reads use the heap.
+static png_voidp pngHeapMallocFn(png_structp /*png_ptr*/, png_size_t size)
+{
+   return (png_voidp)dMalloc(size);
+}
+
+static void pngHeapFreeFn(png_structp /*png_ptr*/, png_voidp mem)
+{
+   dFree(mem);
+}
+
 
 //--------------------------------------
 static void pngFatalErrorFn(png_structp     /*png_ptr*/,
@@ -109,6 +117,16 @@ static void pngFatalErrorFn(png_structp     /*png_ptr*/,
 }
 
 
+//-------------------------------------- Reads may run on a loader thread so
+//                                        errors only warn; libpng then jumps
+//                                        back to readPNG which fails cleanly.
+static void pngReadErrorFn(png_structp     /*png_ptr*/,
+                           png_const_charp pMessage)
+{
+   AssertWarn(false, avar("Error reading PNG file:\n %s", pMessage));
+}
+
+
 //--------------------------------------
 static void pngWarningFn(png_structp, png_const_charp pMessage)
 {
@@ -131,35 +149,29 @@ bool GBitmap::readPNG(Stream& io_rStream)
       return false;
    }
 
-   U32 prevWaterMark = FrameAllocator::getWaterMark();
-
 #if defined(PNG_USER_MEM_SUPPORTED)
    png_structp png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING,
                                                 NULL,
-                                                pngFatalErrorFn,
+                                                pngReadErrorFn,
                                                 pngWarningFn,
                                                 NULL,
-                                                pngMallocFn,
-                                                pngFreeFn);
+                                                pngHeapMallocFn,
+                                                pngHeapFreeFn);
 #else
    png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING,
                                                 NULL,
-                                                pngFatalErrorFn,
+                                                pngReadErrorFn,
                                                 pngWarningFn);
 #endif
 
    if (png_ptr == NULL) 
-   {
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
-   }
 
    png_infop info_ptr = png_create_info_struct(png_ptr);
    if (info_ptr == NULL) {
       png_destroy_read_struct(&png_ptr,
                               (png_infopp)NULL,
                               (png_infopp)NULL);
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
    }
 
@@ -168,12 +180,22 @@ bool GBitmap::readPNG(Stream& io_rStream)
       png_destroy_read_struct(&png_ptr,
                               &info_ptr,
                               (png_infopp)NULL);
-      FrameAllocator::setWaterMark(prevWaterMark);
       return false;
    }
 
-   sg_pStream = &io_rStream;
-   png_set_read_fn(png_ptr, NULL, pngReadDataFn);
+   // The row pointers are sized for the tallest image we accept and are
+   //  allocated before the setjmp so the error branch can always free them.
+   png_bytep* rowPointers = new png_bytep[csgMaxRowPointers];
+
+   if (setjmp(png_jmpbuf(png_ptr)))
+   {
+      png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
+      delete [] rowPointers;
+      deleteImage();
+      return false;
+   }
+
+   png_set_read_fn(png_ptr, &io_rStream, pngReadDataFn);
 
    // Read off the info on the image.
    png_set_sig_bytes(png_ptr, cs_headerBytesChecked);
@@ -266,7 +288,6 @@ bool GBitmap::readPNG(Stream& io_rStream)
 
    // Set up the row pointers...
    AssertISV(height <= csgMaxRowPointers, "Error, cannot load pngs taller than 2048 pixels!");
-   png_bytep* rowPointers = sRowPointers;
    U8* pBase = (U8*)getBits();
    for (U32 i = 0; i < height; i++)
       rowPointers[i] = pBase + (i * rowBytes);
@@ -280,7 +301,7 @@ bool GBitmap::readPNG(Stream& io_rStream)
    png_read_end(png_ptr, NULL);
    png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
 
-   sg_pStream = NULL;
+   delete [] rowPointers;
 
    // Ok, the image is read in, now we need to finish up the initialization,
    //  which means: setting up the detailing members, init'ing the palette
@@ -288,12 +309,11 @@ bool GBitmap::readPNG(Stream& io_rStream)
    //
    // actually, all of that was handled by allocateBitmap, so we're outta here
    //
-   FrameAllocator::setWaterMark(prevWaterMark);
 
     //
    //-Mat if all palleted images are to be converted, set mForce16bit
+   //     The preference is bound by the texture manager so no console lookup happens here.
    if( color_type == PNG_COLOR_TYPE_PALETTE ) {
-       sgForcePalletedPNGsTo16Bit = dAtob( Con::getVariable("$pref::iPhone::ForcePalletedPNGsTo16Bit") );
        if( sgForcePalletedPNGsTo16Bit ) {
            mForce16Bit = true;
        }
@@ -302,6 +322,31 @@ bool GBitmap::readPNG(Stream& io_rStream)
 }
 
 
+//--------------------------------------------------------------------------
+bool GBitmap::readPNGDimensions(Stream& io_rStream, U32& width, U32& height)
+{
+   // The signature is followed by the IHDR chunk: length, type, width and height (big-endian).
+   static const U32 cs_headerBytesChecked = 8;
+   static const U32 cs_ihdrBytes = 16;
+
+   U8 header[cs_headerBytesChecked + cs_ihdrBytes];
+   if (!io_rStream.read(sizeof(header), header))
+      return false;
+
+   if (png_check_sig(header, cs_headerBytesChecked) == 0)
+      return false;
+
+   const U8* pIHDR = header + cs_headerBytesChecked;
+   if (dStrncmp((const char*)pIHDR + 4, "IHDR", 4) != 0)
+      return false;
+
+   width  = ((U32)pIHDR[8]  << 24) | ((U32)pIHDR[9]  << 16) | ((U32)pIHDR[10] << 8) | (U32)pIHDR[11];
+   height = ((U32)pIHDR[12] << 24) | ((U32)pIHDR[13] << 16) | ((U32)pIHDR[14] << 8) | (U32)pIHDR[15];
+
+   return width != 0 && height != 0;
+}
+
+
 //--------------------------------------------------------------------------
 bool GBitmap::_writePNG(Stream&   stream,
                         const U32 compressionLevel,
@@ -343,8 +388,7 @@ bool GBitmap::_writePNG(Stream&   stream,
       return false;
    }
 
-   sg_pStream = &stream;
-   png_set_write_fn(png_ptr, NULL, pngWriteDataFn, pngFlushDataFn);
+   png_set_write_fn(png_ptr, &stream, pngWriteDataFn, pngFlushDataFn);
 
    // Set the compression level, image filters, and compression strategy...
    png_set_compression_strategy( png_ptr, strategy );
@@ -23,6 +23,8 @@
 #include "math/mPoint.h"
 #include "graphics/TextureManager.h"
 #include "graphics/dgl.h"
+#include "graphics/dglDrawList.h"
+#include "graphics/dglTextLayout.h"
 #include "graphics/color.h"
 #include "math/mPoint.h"
 #include "math/mRect.h"
@@ -39,6 +41,7 @@ ColorI sg_bitmapModulation(255, 255, 255, 255);
 ColorI sg_textAnchorColor(255, 255, 255, 255);
 ColorI sg_stackColor(255, 255, 255, 255);
 RectI sgCurrentClipRect;
+DGLDrawList* sgDrawList = NULL;
 
 } // namespace {}
 
@@ -74,6 +77,25 @@ void dglSetTextAnchorColor(const ColorF& in_rColor)
    sg_textAnchorColor = c;
 }
 
+void dglGetTextAnchorColor(ColorI* color)
+{
+   *color = sg_textAnchorColor;
+}
+
+//--------------------------------------------------------------------------
+void dglSetDrawList(DGLDrawList* list)
+{
+   sgDrawList = list;
+
+   if (list != NULL)
+      list->setClipRect(sgCurrentClipRect);
+}
+
+DGLDrawList* dglGetDrawList()
+{
+   return sgDrawList;
+}
+
 
 //--------------------------------------------------------------------------
 void dglDrawBitmapStretchSR(TextureObject* texture,
@@ -89,27 +111,6 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
    AssertFatal(srcRect.isValidRect() == true,
                "GSurface::drawBitmapStretchSR: routines assume normal rects");
 
-   glDisable(GL_LIGHTING);
-
-   glEnable(GL_TEXTURE_2D);
-   glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
-   //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-   if (bSilhouette)
-   {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
-   
-      ColorF kModulationColor;
-      dglGetBitmapModulation(&kModulationColor);
-      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
-   }
-   else
-   {
-      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   }
-   glEnable(GL_BLEND);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
    F32 texLeft   = F32(srcRect.point.x)                    / F32(texture->getTextureWidth());
    F32 texRight  = F32(srcRect.point.x + srcRect.extent.x) / F32(texture->getTextureWidth());
    F32 texTop    = F32(srcRect.point.y)                    / F32(texture->getTextureHeight());
@@ -167,6 +168,48 @@ void dglDrawBitmapStretchSR(TextureObject* texture,
       texBottom = temp;
    }
 
+   if (sgDrawList != NULL)
+   {
+      if (!bSilhouette)
+      {
+         DGLDrawList::Vertex quad[4];
+         quad[0].set(scrPoints[0].x, scrPoints[0].y, texLeft, texTop, sg_bitmapModulation);
+         quad[1].set(scrPoints[1].x, scrPoints[1].y, texRight, texTop, sg_bitmapModulation);
+         quad[2].set(scrPoints[3].x, scrPoints[3].y, texRight, texBottom, sg_bitmapModulation);
+         quad[3].set(scrPoints[2].x, scrPoints[2].y, texLeft, texBottom, sg_bitmapModulation);
+         sgDrawList->addQuads(texture, quad, 4);
+         return;
+      }
+
+      // Silhouettes need their own texture environment, so draw everything recorded
+      // so far and then this directly.  The list can't be replayed after that.
+      sgDrawList->submitPending();
+      sgDrawList->setVolatile();
+   }
+
+   DGLDrawList::flushStream();
+
+   glDisable(GL_LIGHTING);
+
+   glEnable(GL_TEXTURE_2D);
+   glBindTexture(GL_TEXTURE_2D, texture->getGLTextureName());
+   //glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+   if (bSilhouette)
+   {
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_BLEND);
+   
+      ColorF kModulationColor;
+      dglGetBitmapModulation(&kModulationColor);
+      glTexEnvfv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_COLOR, kModulationColor.address());
+   }
+   else
+   {
+      glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+   }
+   glEnable(GL_BLEND);
+   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
    glColor4ub(sg_bitmapModulation.red,
              sg_bitmapModulation.green,
              sg_bitmapModulation.blue,
@@ -305,79 +348,14 @@ U32 dglDrawText(GFont*   font,
    return dglDrawTextN(font, ptDraw, in_string, dStrlen((const UTF8 *) in_string), colorTable, maxColorIndex, rot);
 }
 
-struct TextVertex
-{
-   Point2F p;
-   Point2F t;
-   ColorI c;
-    TextVertex() { set( 0.0f, 0.0f, 0.0f, 0.0f, ColorI(0, 0, 0) ); }
-   void set(F32 x, F32 y, F32 tx, F32 ty, ColorI color)
-   {
-      p.x = x;
-      p.y = y;
-      t.x = tx;
-      t.y = ty;
-      c = color;
-   }
-};
+// Glyph vertices share the draw list layout so recorded text can be appended as is.
+typedef DGLTextLayout::Vertex TextVertex;
 
 //------------------------------------------------------------------------------
 
-U32 dglDrawTextN(GFont*          font,
-                 const Point2I&  ptDraw,
-                 const UTF8*     in_string,
-                 U32             n,
-                 const ColorI*   colorTable,
-                 const U32       maxColorIndex,
-                 F32             rot)
-{
-   PROFILE_START(DrawText_UTF8);
-   
-   U32 len = dStrlen(in_string) + 1;
-   FrameTemp<UTF16> ubuf(len);
-   convertUTF8toUTF16(in_string, ubuf, len);
-   U32 tmp = dglDrawTextN(font, ptDraw, ubuf, n, colorTable, maxColorIndex, rot);
-
-   PROFILE_END();
-
-   return tmp;
-}
-
-//-----------------------------------------------------------------------------
-
-#ifdef TORQUE_OS_IOS
-U32 dglDrawTextN(GFont*          font,
-                 const Point2I&  ptDraw,
-                 const UTF16*    in_string,
-                 U32             n,
-                 const ColorI*   colorTable,
-                 const U32       maxColorIndex,
-                 F32             rot)
-
+static void drawTextRuns(const TextVertex* vert, const Vector<DGLTextLayout::Run>& runs)
 {
-   // return on zero length strings
-   if( n < 1 )
-      return ptDraw.x;
-   PROFILE_START(DrawText);
-
-   MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
-   Point3F offset( ptDraw.x, ptDraw.y, 0.0 );
-   Point3F points[4];
-
-   U32 nCharCount = 0;
-
-   Point2I     pt;
-   UTF16       c;
-   pt.x                 = 0;
-
-   ColorI                  currentColor;
-   S32                     currentPt = 0;
-
-   TextureObject *lastTexture = NULL;
-
-   currentColor      = sg_bitmapModulation;
-
-   FrameTemp<TextVertex> vert(4*n);
+   DGLDrawList::flushStream();
 
    glDisable(GL_LIGHTING);
 
@@ -386,184 +364,133 @@ U32 dglDrawTextN(GFont*          font,
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glEnable(GL_BLEND);
 
-   //Luma: Optimise by setting states once before inner loop
    glEnableClientState ( GL_VERTEX_ARRAY );
    glEnableClientState ( GL_COLOR_ARRAY );
    glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
-   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
-   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
-   glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
 
-   // first build the point, color, and coord arrays
-   U32 i;
+#ifndef TORQUE_OS_IOS
+   if (runs.size() > 0)
+   {
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].point) );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].color) );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].texCoord) );
+   }
+#endif
 
-   for(i = 0,c = in_string[i];in_string[i] && i < n;i++,c = in_string[i])
+   // The layout groups glyphs by font sheet so each sheet is a single draw.
+   for (S32 i = 0; i < runs.size(); i++)
    {
-      nCharCount++;
-      if(nCharCount > n)
-          break;
-
-      // We have to do a little dance here since \t = 0x9, \n = 0xa, and \r = 0xd
-      if ((c >=  1 && c <=  7) ||
-         (c >= 11 && c <= 12) ||
-         (c == 14))
-      {
-         // Color code
-         if (colorTable)
-         {
-            static U8 remap[15] =
-            {
-               0x0, // 0 special null terminator
-               0x0, // 1 ascii start-of-heading??
-               0x1, 
-               0x2, 
-               0x3, 
-               0x4, 
-               0x5, 
-               0x6, 
-               0x0, // 8 special backspace
-               0x0, // 9 special tab
-               0x0, // a special \n
-               0x7, 
-               0x8,
-               0x0, // a special \r
-               0x9 
-            };
-
-            U8 remapped = remap[c];
-            // Ignore if the color is greater than the specified max index:
-            if ( remapped <= maxColorIndex )
-            {
-               const ColorI &clr = colorTable[remapped];
-               sg_bitmapModulation = clr;
-               currentColor = clr;
-            }
-         }
-         continue;
-      }
+      const DGLTextLayout::Run& run = runs[i];
+      glBindTexture(GL_TEXTURE_2D, run.mpTexture->getGLTextureName());
 
-      // reset color?
-      if ( c == 15 )
+#ifdef TORQUE_OS_IOS
+      // There are no quads on ES so split each one into two triangles.
+      const U32 triCount = run.mCount / 4 * 6;
+      FrameTemp<TextVertex> tris(triCount);
+      TextVertex* pTri = tris;
+      for (U32 q = run.mStart; q < run.mStart + run.mCount; q += 4)
       {
-         currentColor = sg_textAnchorColor;
-         sg_bitmapModulation = sg_textAnchorColor;
-         continue;
+         *pTri++ = vert[q];
+         *pTri++ = vert[q + 1];
+         *pTri++ = vert[q + 2];
+         *pTri++ = vert[q];
+         *pTri++ = vert[q + 2];
+         *pTri++ = vert[q + 3];
       }
 
-      // push color:
-      if ( c == 16 )
-      {
-         sg_stackColor = sg_bitmapModulation;
-         continue;
-      }
+      glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(tris[0].point) );
+      glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(tris[0].color) );
+      glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(tris[0].texCoord) );
+      glDrawArrays( GL_TRIANGLES, 0, triCount );
+#else
+      glDrawArrays( GL_QUADS, run.mStart, run.mCount );
+#endif
+   }
 
-      // pop color:
-      if ( c == 17 )
-      {
-         currentColor = sg_stackColor;
-         sg_bitmapModulation = sg_stackColor;
-         continue;
-      }
+   glDisableClientState ( GL_VERTEX_ARRAY );
+   glDisableClientState ( GL_COLOR_ARRAY );
+   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
 
-      // Tab character
-      if ( c == dT('\t') ) 
-      {
-          const PlatformFont::CharInfo &ci = font->getCharInfo( dT(' ') );
-          pt.x += ci.xIncrement * GFont::TabWidthInSpaces;
-          continue;
-      }
+   glDisable(GL_BLEND);
+   glDisable(GL_TEXTURE_2D);
+}
 
-      if( !font->isValidChar( c ) )  
-         continue;
+//------------------------------------------------------------------------------
 
-      const PlatformFont::CharInfo &ci = font->getCharInfo(c);
+static void drawTextLayout(const DGLTextLayout& layout, const Point2I& ptDraw, F32 rot)
+{
+   const Vector<TextVertex>& vertices = layout.getVertices();
+   const Vector<DGLTextLayout::Run>& runs = layout.getRuns();
 
-      if(ci.bitmapIndex == -1)
-      {
-         pt.x += ci.xOrigin + ci.xIncrement;
-         continue;
-      }
+   // Layouts are built at the origin so unrotated text can be drawn in place.
+   if (sgDrawList == NULL && rot == 0.0f)
+   {
+      glMatrixMode(GL_MODELVIEW);
+      glPushMatrix();
+      glTranslatef((F32)ptDraw.x, (F32)ptDraw.y, 0.0f);
+      drawTextRuns(vertices.address(), runs);
+      glPopMatrix();
+      return;
+   }
 
-      TextureObject *newObj = font->getTextureHandle(ci.bitmapIndex);
-      if(newObj != lastTexture)
-      {
-         if(currentPt)
-         {
-            glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-
-            //Luma:	More optimal rendering
-            for (S32 i=0; i<currentPt; i+=4) 
-            {
-                glDrawArrays(GL_TRIANGLE_STRIP, i, 4);
-            }
-            currentPt = 0;
-         }
-         lastTexture = newObj;
-      }
-      if(ci.width != 0 && ci.height != 0)
-      {
-         pt.y = font->getBaseline() - ci.yOrigin;
-         pt.x += ci.xOrigin;
+   if (vertices.size() == 0)
+   {
+      if (sgDrawList == NULL)
+         drawTextRuns(NULL, runs);
+      return;
+   }
 
-         F32 texLeft   = F32(ci.xOffset)             / F32(lastTexture->getTextureWidth());
-         F32 texRight  = F32(ci.xOffset + ci.width)  / F32(lastTexture->getTextureWidth());
-         F32 texTop    = F32(ci.yOffset)             / F32(lastTexture->getTextureHeight());
-         F32 texBottom = F32(ci.yOffset + ci.height) / F32(lastTexture->getTextureHeight());
+   // Rotated and recorded text needs the final screen positions.
+   MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
+   Point3F offset( (F32)ptDraw.x, (F32)ptDraw.y, 0.0f );
 
-         F32 screenLeft   = pt.x;
-         F32 screenRight  = pt.x + ci.width;
-         F32 screenTop    = pt.y;
-         F32 screenBottom = pt.y + ci.height;
+   FrameTemp<TextVertex> vert(vertices.size());
+   for (S32 i = 0; i < vertices.size(); i++)
+   {
+      vert[i] = vertices[i];
 
-         points[0] = Point3F(screenLeft, screenTop, 0.0);
-         points[1] = Point3F(screenRight,  screenTop, 0.0);
-         points[2] = Point3F( screenLeft,  screenBottom, 0.0);
-         points[3] = Point3F( screenRight, screenBottom, 0.0);
+      Point3F point(vertices[i].point.x, vertices[i].point.y, 0.0f);
+      if (rot != 0.0f)
+         rotMatrix.mulP(point);
+      point += offset;
+      vert[i].point.set(point.x, point.y);
+   }
 
-         for( int i=0; i<4; i++ )
-         {
-            rotMatrix.mulP( points[i] );
-            points[i] += offset;
-         }
-         vert[currentPt++].set(points[0].x, points[0].y, texLeft, texTop, currentColor);
-         vert[currentPt++].set(points[1].x, points[1].y, texRight, texTop, currentColor);
-         vert[currentPt++].set(points[2].x, points[2].y, texLeft, texBottom, currentColor);
-         vert[currentPt++].set(points[3].x, points[3].y, texRight, texBottom, currentColor);
-         pt.x += ci.xIncrement - ci.xOrigin;
-      }
-      else
-         pt.x += ci.xIncrement;
+   if (sgDrawList != NULL)
+   {
+      for (S32 i = 0; i < runs.size(); i++)
+         sgDrawList->addQuads(runs[i].mpTexture, &vert[runs[i].mStart], runs[i].mCount);
    }
-   if(currentPt)
+   else
    {
-       //Luma:	More optimal rendering
-       glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-       for (S32 i=0; i<currentPt; i+=4) 
-       {
-            glDrawArrays(GL_TRIANGLE_STRIP, i, 4);
-       }
+      drawTextRuns(vert, runs);
    }
+}
 
-   glDisableClientState ( GL_VERTEX_ARRAY );
-   glDisableClientState ( GL_COLOR_ARRAY );
-   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
-
-   glDisable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
+//------------------------------------------------------------------------------
 
-   pt.x += ptDraw.x; // DAW: Account for the fact that we removed the drawing point from the text start at the beginning.
+static inline DGLTextLayout::ColorState getTextColorState()
+{
+   DGLTextLayout::ColorState colors;
+   colors.mModulation = sg_bitmapModulation;
+   colors.mAnchor = sg_textAnchorColor;
+   colors.mStack = sg_stackColor;
+   return colors;
+}
 
-   AssertFatal(pt.x >= ptDraw.x, "How did this happen?");
-   PROFILE_END();
+//------------------------------------------------------------------------------
 
-   return pt.x - ptDraw.x;
+static inline void setTextColorState(const DGLTextLayout::ColorState& colors)
+{
+   sg_bitmapModulation = colors.mModulation;
+   sg_stackColor = colors.mStack;
 }
 
-#else
+//------------------------------------------------------------------------------
 
 U32 dglDrawTextN(GFont*          font,
                  const Point2I&  ptDraw,
-                 const UTF16*    in_string,
+                 const UTF8*     in_string,
                  U32             n,
                  const ColorI*   colorTable,
                  const U32       maxColorIndex,
@@ -574,204 +501,53 @@ U32 dglDrawTextN(GFont*          font,
       return ptDraw.x;
    PROFILE_START(DrawText);
 
-   MatrixF rotMatrix( EulerF( 0.0, 0.0, mDegToRad( rot ) ) );
-   Point3F offset( (F32)ptDraw.x, (F32)ptDraw.y, 0.0f );
-   Point3F points[4];
-
-   U32 nCharCount = 0;
-
-   Point2I     pt;
-   UTF16       c;
-   pt.x                 = 0;
-
-   ColorI                  currentColor;
-   S32                     currentPt = 0;
-
-   TextureObject *lastTexture = NULL;
-
-   currentColor      = sg_bitmapModulation;
-
-   FrameTemp<TextVertex> vert(4*n);
+   // Cached layouts skip the UTF16 conversion too.
+   const DGLTextLayout& layout = DGLTextLayoutCache::getLayout(font, in_string, n, colorTable, maxColorIndex, getTextColorState());
+   drawTextLayout(layout, ptDraw, rot);
+   setTextColorState(layout.getEndColors());
 
-   glDisable(GL_LIGHTING);
-
-   glEnable(GL_TEXTURE_2D);
-   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-   glEnable(GL_BLEND);
-
-   glEnableClientState ( GL_VERTEX_ARRAY );
-   glVertexPointer     ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].p) );
-
-   glEnableClientState ( GL_COLOR_ARRAY );
-   glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(TextVertex), &(vert[0].c) );
-
-   glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
-   glTexCoordPointer   ( 2, GL_FLOAT, sizeof(TextVertex), &(vert[0].t) );
-
-   // first build the point, color, and coord arrays
-   U32 i;
-
-   for(i = 0,c = in_string[i];in_string[i] && i < n;i++,c = in_string[i])
-   {
-      nCharCount++;
-      if(nCharCount > n)
-          break;
-
-      // We have to do a little dance here since \t = 0x9, \n = 0xa, and \r = 0xd
-      if ((c >=  1 && c <=  7) ||
-         (c >= 11 && c <= 12) ||
-         (c == 14))
-      {
-         // Color code
-         if (colorTable)
-         {
-            static U8 remap[15] =
-            {
-               0x0, // 0 special null terminator
-               0x0, // 1 ascii start-of-heading??
-               0x1, 
-               0x2, 
-               0x3, 
-               0x4, 
-               0x5, 
-               0x6, 
-               0x0, // 8 special backspace
-               0x0, // 9 special tab
-               0x0, // a special \n
-               0x7, 
-               0x8,
-               0x0, // a special \r
-               0x9 
-            };
-
-            U8 remapped = remap[c];
-            // Ignore if the color is greater than the specified max index:
-            if ( remapped <= maxColorIndex )
-            {
-               const ColorI &clr = colorTable[remapped];
-               sg_bitmapModulation = clr;
-               currentColor = clr;
-            }
-         }
-         continue;
-      }
-
-      // reset color?
-      if ( c == 15 )
-      {
-         currentColor = sg_textAnchorColor;
-         sg_bitmapModulation = sg_textAnchorColor;
-         continue;
-      }
-
-      // push color:
-      if ( c == 16 )
-      {
-         sg_stackColor = sg_bitmapModulation;
-         continue;
-      }
-
-      // pop color:
-      if ( c == 17 )
-      {
-         currentColor = sg_stackColor;
-         sg_bitmapModulation = sg_stackColor;
-         continue;
-      }
-
-      // Tab character
-      if ( c == dT('\t') ) 
-      {
-          const PlatformFont::CharInfo &ci = font->getCharInfo( dT(' ') );
-          pt.x += ci.xIncrement * GFont::TabWidthInSpaces;
-          continue;
-      }
-
-      if( !font->isValidChar( c ) )  
-         continue;
-
-      const PlatformFont::CharInfo &ci = font->getCharInfo(c);
-
-      if(ci.bitmapIndex == -1)
-      {
-         pt.x += ci.xOrigin + ci.xIncrement;
-         continue;
-      }
-
-      TextureObject *newObj = font->getTextureHandle(ci.bitmapIndex);
-      if(newObj != lastTexture)
-      {
-         if(currentPt)
-         {
-            glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-            glDrawArrays( GL_QUADS, 0, currentPt );
-            currentPt = 0;
-         }
-         lastTexture = newObj;
-      }
-      if(ci.width != 0 && ci.height != 0)
-      {
-         pt.y = font->getBaseline() - ci.yOrigin;
-         pt.x += ci.xOrigin;
-
-         F32 texLeft   = F32(ci.xOffset)             / F32(lastTexture->getTextureWidth());
-         F32 texRight  = F32(ci.xOffset + ci.width)  / F32(lastTexture->getTextureWidth());
-         F32 texTop    = F32(ci.yOffset)             / F32(lastTexture->getTextureHeight());
-         F32 texBottom = F32(ci.yOffset + ci.height) / F32(lastTexture->getTextureHeight());
-
-         F32 screenLeft   = (F32)pt.x;
-         F32 screenRight  = (F32)(pt.x + ci.width);
-         F32 screenTop    = (F32)pt.y;
-         F32 screenBottom = (F32)(pt.y + ci.height);
-
-         points[0] = Point3F(screenLeft, screenBottom, 0.0);
-         points[1] = Point3F(screenRight,  screenBottom, 0.0);
-         points[2] = Point3F( screenRight,  screenTop, 0.0);
-         points[3] = Point3F( screenLeft, screenTop, 0.0);
-
-         for( int i=0; i<4; i++ )
-         {
-            rotMatrix.mulP( points[i] );
-            points[i] += offset;
-         }
+   PROFILE_END();
 
-         vert[currentPt++].set(points[0].x, points[0].y, texLeft, texBottom, currentColor);
-         vert[currentPt++].set(points[1].x, points[1].y, texRight, texBottom, currentColor);
-         vert[currentPt++].set(points[2].x, points[2].y, texRight, texTop, currentColor);
-         vert[currentPt++].set(points[3].x, points[3].y, texLeft, texTop, currentColor);
-         pt.x += ci.xIncrement - ci.xOrigin;
-      }
-      else
-         pt.x += ci.xIncrement;
-   }
-   if(currentPt)
-   {
-      glBindTexture(GL_TEXTURE_2D, lastTexture->getGLTextureName());
-      glDrawArrays( GL_QUADS, 0, currentPt );
-   }
+   return layout.getAdvance();
+}
 
-   glDisableClientState ( GL_VERTEX_ARRAY );
-   glDisableClientState ( GL_COLOR_ARRAY );
-   glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+//------------------------------------------------------------------------------
 
-   glDisable(GL_BLEND);
-   glDisable(GL_TEXTURE_2D);
+U32 dglDrawTextN(GFont*          font,
+                 const Point2I&  ptDraw,
+                 const UTF16*    in_string,
+                 U32             n,
+                 const ColorI*   colorTable,
+                 const U32       maxColorIndex,
+                 F32             rot)
+{
+   // return on zero length strings
+   if( n < 1 )
+      return ptDraw.x;
+   PROFILE_START(DrawText);
 
-   pt.x += ptDraw.x; // DAW: Account for the fact that we removed the drawing point from the text start at the beginning.
+   const DGLTextLayout& layout = DGLTextLayoutCache::getLayout(font, in_string, n, colorTable, maxColorIndex, getTextColorState());
+   drawTextLayout(layout, ptDraw, rot);
+   setTextColorState(layout.getEndColors());
 
-   AssertFatal(pt.x >= ptDraw.x, "How did this happen?");
    PROFILE_END();
 
-   return pt.x - ptDraw.x;
+   return layout.getAdvance();
 }
-#endif
 
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
 // Drawing primitives
 
 void dglDrawLine(S32 x1, S32 y1, S32 x2, S32 y2, const ColorI &color)
 {
+   if (sgDrawList != NULL)
+   {
+      sgDrawList->addLine(Point2I(x1, y1), Point2I(x2, y2), color, 1.0f);
+      return;
+   }
+
+   DGLDrawList::flushStream();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -804,6 +580,19 @@ void dglDrawLine(const Point2I &startPt, const Point2I &endPt, const ColorI &col
 
 void dglDrawRect(const Point2I &upperL, const Point2I &lowerR, const ColorI &color, const float &lineWidth)
 {
+   if (sgDrawList != NULL)
+   {
+      const Point2I upperR(lowerR.x, upperL.y);
+      const Point2I lowerL(upperL.x, lowerR.y);
+      sgDrawList->addLine(upperL, upperR, color, lineWidth);
+      sgDrawList->addLine(upperR, lowerR, color, lineWidth);
+      sgDrawList->addLine(lowerR, lowerL, color, lineWidth);
+      sgDrawList->addLine(lowerL, upperL, color, lineWidth);
+      return;
+   }
+
+   DGLDrawList::flushStream();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -845,6 +634,14 @@ void dglDrawRect(const RectI &rect, const ColorI &color, const float &lineWidth)
 
 void dglDrawRectFill(const Point2I &upperL, const Point2I &lowerR, const ColorI &color)
 {
+   if (sgDrawList != NULL)
+   {
+      sgDrawList->addRectFill(upperL, lowerR, color);
+      return;
+   }
+
+   DGLDrawList::flushStream();
+
    glEnable(GL_BLEND);
    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
    glDisable(GL_TEXTURE_2D);
@@ -1134,6 +931,9 @@ void dglSetClipRect(const RectI &clipRect)
               clipRect.extent.x, clipRect.extent.y);
 
    sgCurrentClipRect = clipRect;
+
+   if (sgDrawList != NULL)
+      sgDrawList->setClipRect(clipRect);
 }
 
 const RectI& dglGetClipRect()
@@ -31,6 +31,7 @@
 #endif
 
 class TextureObject;
+class DGLDrawList;
 class GFont;
 class MatrixF;
 class RectI;
@@ -84,6 +85,21 @@ void dglClearBitmapModulation();
 //  SetBMod sets the text anchor to the modulation color
 /// Sets the anchor color for text coloring, useful when mixing text colors
 void dglSetTextAnchorColor(const ColorF&);
+/// Gets the anchor color for text coloring
+void dglGetTextAnchorColor(ColorI*);
+
+/// @defgroup dgl_draw_list Draw Lists
+/// Bitmap, text, line and rectangle drawing can be recorded into a draw list instead of
+/// going to GL.  Recorded lists are drawn by submitting them to the shared draw stream.
+/// @see DGLDrawList
+/// @{
+
+/// Directs drawing into a draw list, or back to GL when NULL
+void dglSetDrawList(DGLDrawList* list);
+/// Gets the draw list drawing is being recorded into, if any
+DGLDrawList* dglGetDrawList();
+
+/// @}
 
 /// @defgroup dgl_bitmap_draw Bitmap Drawing Functions
 /// These functions allow you to draw a bitmap.
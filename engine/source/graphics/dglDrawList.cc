@@ -0,0 +1,356 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "graphics/dglDrawList.h"
+#include "graphics/dgl.h"
+#include "math/mMathFn.h"
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+DGLDrawList DGLDrawList::smStream;
+
+//-----------------------------------------------------------------------------
+
+DGLDrawList::DGLDrawList() :
+    mPending( 0 ),
+    mSealed( false ),
+    mVolatile( false )
+{
+    mClipRect.set( 0, 0, 0, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::clear( void )
+{
+    mVertices.clear();
+    mBatches.clear();
+
+    // Release the textures the batches referenced.
+    if ( mTextures.size() > 0 )
+        mTextures.decrement( mTextures.size() );
+
+    mPending = 0;
+    mSealed = false;
+    mVolatile = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::addQuads( TextureObject* pTexture, const Vertex* pVertices, const U32 vertexCount )
+{
+    AssertFatal( vertexCount % 4 == 0, "DGLDrawList::addQuads() - Quads need four vertices each." );
+
+    if ( vertexCount == 0 )
+        return;
+
+    // Find the bounds of the quads.
+    Point2F minPoint = pVertices[0].point;
+    Point2F maxPoint = pVertices[0].point;
+    for ( U32 index = 1; index < vertexCount; ++index )
+    {
+        const Point2F& point = pVertices[index].point;
+        minPoint.x = getMin( minPoint.x, point.x );
+        minPoint.y = getMin( minPoint.y, point.y );
+        maxPoint.x = getMax( maxPoint.x, point.x );
+        maxPoint.y = getMax( maxPoint.y, point.y );
+    }
+
+    // Split each quad into two triangles.
+    Vertex* pDestination = allocate( pTexture, GL_TRIANGLES, 0.0f, RectF( minPoint, maxPoint - minPoint ), vertexCount / 4 * 6 );
+    for ( U32 index = 0; index < vertexCount; index += 4 )
+    {
+        const Vertex* pQuad = pVertices + index;
+        *pDestination++ = pQuad[0];
+        *pDestination++ = pQuad[1];
+        *pDestination++ = pQuad[2];
+        *pDestination++ = pQuad[0];
+        *pDestination++ = pQuad[2];
+        *pDestination++ = pQuad[3];
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::addRectFill( const Point2I& upperL, const Point2I& lowerR, const ColorI& color )
+{
+    Vertex quad[4];
+    quad[0].set( (F32)upperL.x, (F32)upperL.y, 0.0f, 0.0f, color );
+    quad[1].set( (F32)lowerR.x, (F32)upperL.y, 0.0f, 0.0f, color );
+    quad[2].set( (F32)lowerR.x, (F32)lowerR.y, 0.0f, 0.0f, color );
+    quad[3].set( (F32)upperL.x, (F32)lowerR.y, 0.0f, 0.0f, color );
+    addQuads( NULL, quad, 4 );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::addLine( const Point2I& start, const Point2I& end, const ColorI& color, const F32 lineWidth )
+{
+    // A one pixel line through pixel centers covers the pixels from its start up to but
+    // not including its end.  When it is axis aligned that is exactly a thin rectangle,
+    // which can then share a batch with the fills around it.
+    if ( lineWidth == 1.0f && ( start.x == end.x || start.y == end.y ) )
+    {
+        if ( start == end )
+            return;
+
+        Point2I upperL;
+        Point2I lowerR;
+        if ( start.y == end.y )
+        {
+            upperL.set( start.x < end.x ? start.x : end.x + 1, start.y );
+            lowerR.set( start.x < end.x ? end.x : start.x + 1, start.y + 1 );
+        }
+        else
+        {
+            upperL.set( start.x, start.y < end.y ? start.y : end.y + 1 );
+            lowerR.set( start.x + 1, start.y < end.y ? end.y : start.y + 1 );
+        }
+
+        addRectFill( upperL, lowerR, color );
+        return;
+    }
+
+    // Wide lines may bleed past their end points.
+    const F32 extent = lineWidth * 0.5f + 1.0f;
+    const Point2F minPoint( (F32)getMin( start.x, end.x ) - extent, (F32)getMin( start.y, end.y ) - extent );
+    const Point2F maxPoint( (F32)getMax( start.x, end.x ) + extent, (F32)getMax( start.y, end.y ) + extent );
+
+    Vertex* pDestination = allocate( NULL, GL_LINES, lineWidth, RectF( minPoint, maxPoint - minPoint ), 2 );
+    pDestination[0].set( (F32)start.x + 0.5f, (F32)start.y + 0.5f, 0.0f, 0.0f, color );
+    pDestination[1].set( (F32)end.x + 0.5f, (F32)end.y + 0.5f, 0.0f, 0.0f, color );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 DGLDrawList::submitPending( void )
+{
+    submit( mPending, mBatches.size() );
+
+    // Keep later primitives out of the batches already handed over.
+    mPending = mBatches.size();
+    mSealed = true;
+
+    return mPending;
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::submit( const U32 firstBatch, const U32 endBatch ) const
+{
+    AssertFatal( this != &smStream, "DGLDrawList::submit() - The draw stream cannot be submitted to itself." );
+    AssertFatal( firstBatch <= endBatch && endBatch <= (U32)mBatches.size(), "DGLDrawList::submit() - Invalid batch range." );
+
+    for ( U32 index = firstBatch; index < endBatch; ++index )
+        smStream.append( *this, mBatches[index] );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::render( void ) const
+{
+    if ( isEmpty() )
+        return;
+
+    PROFILE_START(DGLDrawList_Render);
+
+    // Batches are in screen space and carry their own clipping so draw against the whole window.
+    const RectI clipRect = dglGetClipRect();
+    const Point2I windowSize = Platform::getWindowSize();
+    dglSetClipRect( RectI( 0, 0, windowSize.x, windowSize.y ) );
+
+    glDisable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    glEnableClientState ( GL_VERTEX_ARRAY );
+    glVertexPointer     ( 2, GL_FLOAT, sizeof(Vertex), &(mVertices.address()->point) );
+
+    glEnableClientState ( GL_COLOR_ARRAY );
+    glColorPointer      ( 4, GL_UNSIGNED_BYTE, sizeof(Vertex), &(mVertices.address()->color) );
+
+    glEnableClientState ( GL_TEXTURE_COORD_ARRAY );
+    glTexCoordPointer   ( 2, GL_FLOAT, sizeof(Vertex), &(mVertices.address()->texCoord) );
+
+    TextureObject* pBoundTexture = NULL;
+    bool texturing = false;
+    bool scissoring = false;
+
+    for ( S32 index = 0; index < mBatches.size(); ++index )
+    {
+        const Batch& batch = mBatches[index];
+
+        // Texture.
+        if ( batch.mpTexture != NULL )
+        {
+            if ( !texturing )
+            {
+                glEnable(GL_TEXTURE_2D);
+                texturing = true;
+            }
+
+            if ( batch.mpTexture != pBoundTexture )
+            {
+                glBindTexture(GL_TEXTURE_2D, batch.mpTexture->getGLTextureName());
+                pBoundTexture = batch.mpTexture;
+            }
+        }
+        else if ( texturing )
+        {
+            glDisable(GL_TEXTURE_2D);
+            texturing = false;
+        }
+
+        // Clipping.
+        if ( batch.mClipped )
+        {
+            if ( !scissoring )
+            {
+                glEnable(GL_SCISSOR_TEST);
+                scissoring = true;
+            }
+
+            glScissor( batch.mClipRect.point.x, windowSize.y - ( batch.mClipRect.point.y + batch.mClipRect.extent.y ),
+                       batch.mClipRect.extent.x, batch.mClipRect.extent.y );
+        }
+        else if ( scissoring )
+        {
+            glDisable(GL_SCISSOR_TEST);
+            scissoring = false;
+        }
+
+        if ( batch.mPrimitive == GL_LINES )
+            glLineWidth( batch.mLineWidth );
+
+        glDrawArrays( batch.mPrimitive, batch.mStart, batch.mCount );
+    }
+
+    glDisableClientState ( GL_VERTEX_ARRAY );
+    glDisableClientState ( GL_COLOR_ARRAY );
+    glDisableClientState ( GL_TEXTURE_COORD_ARRAY );
+
+    if ( scissoring )
+        glDisable(GL_SCISSOR_TEST);
+
+    glLineWidth( 1.0f );
+    glDisable(GL_BLEND);
+    glDisable(GL_TEXTURE_2D);
+
+    dglSetClipRect( clipRect );
+
+    PROFILE_END();
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::flushStream( void )
+{
+    if ( smStream.isEmpty() )
+        return;
+
+    smStream.render();
+    smStream.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+DGLDrawList::Vertex* DGLDrawList::allocate( TextureObject* pTexture, const U32 primitive, const F32 lineWidth, const RectF& bounds, const U32 vertexCount )
+{
+    // Anything entirely inside the clip rectangle does not need it.
+    const bool clipped =
+        bounds.point.x < (F32)mClipRect.point.x ||
+        bounds.point.y < (F32)mClipRect.point.y ||
+        bounds.point.x + bounds.extent.x > (F32)( mClipRect.point.x + mClipRect.extent.x ) ||
+        bounds.point.y + bounds.extent.y > (F32)( mClipRect.point.y + mClipRect.extent.y );
+
+    // Extend the last batch if the state matches.
+    Batch* pBatch = ( mBatches.size() > 0 && !mSealed ) ? &mBatches.last() : NULL;
+    if ( pBatch == NULL ||
+         pBatch->mpTexture != pTexture ||
+         pBatch->mPrimitive != primitive ||
+         pBatch->mLineWidth != lineWidth ||
+         ( pBatch->mClipped ? pBatch->mClipRect != mClipRect : clipped ) )
+    {
+        lockTexture( pTexture );
+
+        mBatches.increment();
+        pBatch = &mBatches.last();
+        pBatch->mpTexture = pTexture;
+        pBatch->mPrimitive = primitive;
+        pBatch->mLineWidth = lineWidth;
+        pBatch->mClipped = clipped;
+        pBatch->mClipRect = mClipRect;
+        pBatch->mStart = mVertices.size();
+        pBatch->mCount = 0;
+        mSealed = false;
+    }
+
+    const U32 start = mVertices.size();
+    mVertices.setSize( start + vertexCount );
+    pBatch->mCount += vertexCount;
+
+    return mVertices.address() + start;
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::append( const DGLDrawList& source, const Batch& batch )
+{
+    // The stream does not hold texture references; the submitting lists do until it is flushed.
+    Batch* pLast = mBatches.size() > 0 ? &mBatches.last() : NULL;
+    if ( pLast != NULL &&
+         pLast->mpTexture == batch.mpTexture &&
+         pLast->mPrimitive == batch.mPrimitive &&
+         pLast->mLineWidth == batch.mLineWidth &&
+         pLast->mClipped == batch.mClipped &&
+         ( !batch.mClipped || pLast->mClipRect == batch.mClipRect ) )
+    {
+        pLast->mCount += batch.mCount;
+    }
+    else
+    {
+        mBatches.push_back( batch );
+        mBatches.last().mStart = mVertices.size();
+    }
+
+    const U32 start = mVertices.size();
+    mVertices.setSize( start + batch.mCount );
+    dMemcpy( mVertices.address() + start, source.mVertices.address() + batch.mStart, batch.mCount * sizeof(Vertex) );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLDrawList::lockTexture( TextureObject* pTexture )
+{
+    if ( pTexture == NULL )
+        return;
+
+    for ( S32 index = mTextures.size() - 1; index >= 0; --index )
+    {
+        if ( (TextureObject*)mTextures[index] == pTexture )
+            return;
+    }
+
+    mTextures.push_back( TextureHandle( pTexture ) );
+}
@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _DGL_DRAW_LIST_H_
+#define _DGL_DRAW_LIST_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+#ifndef _MPOINT_H_
+#include "math/mPoint.h"
+#endif
+
+#ifndef _MRECT_H_
+#include "math/mRect.h"
+#endif
+
+#ifndef _COLOR_H_
+#include "graphics/color.h"
+#endif
+
+#ifndef _TEXTURE_MANAGER_H_
+#include "graphics/TextureManager.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A recorded run of 2D drawing.
+///
+/// While a draw list is installed with dglSetDrawList() the dgl bitmap, text, line and
+/// rectangle primitives append screen-space vertices here instead of drawing.  Vertices
+/// are grouped into batches that share a texture, a primitive type and a clip rectangle.
+/// A primitive that lies entirely inside the clip rectangle it was recorded against is
+/// stored unclipped so that it can merge with neighbouring batches from other lists.
+///
+/// Recorded batches reach the screen by being submitted to the shared draw stream, which
+/// merges compatible batches across lists and draws them with one call per batch when it
+/// is flushed.  Anything that draws with GL directly must flush the stream first.
+class DGLDrawList
+{
+public:
+    struct Vertex
+    {
+        Point2F point;
+        Point2F texCoord;
+        ColorI  color;
+
+        Vertex() { set( 0.0f, 0.0f, 0.0f, 0.0f, ColorI(0, 0, 0) ); }
+        inline void set( const F32 x, const F32 y, const F32 u, const F32 v, const ColorI& vertexColor )
+        {
+            point.x = x;
+            point.y = y;
+            texCoord.x = u;
+            texCoord.y = v;
+            color = vertexColor;
+        }
+    };
+
+    struct Batch
+    {
+        TextureObject*  mpTexture;
+        U32             mPrimitive;
+        F32             mLineWidth;
+        bool            mClipped;
+        RectI           mClipRect;
+        U32             mStart;
+        U32             mCount;
+    };
+
+public:
+    DGLDrawList();
+
+    void clear( void );
+    inline bool isEmpty( void ) const { return mBatches.size() == 0; }
+    inline U32 getBatchCount( void ) const { return mBatches.size(); }
+    inline U32 getVertexCount( void ) const { return mVertices.size(); }
+
+    /// Set when something was drawn that could not be recorded.  The list still drew
+    /// correctly but must not be replayed.
+    inline bool isVolatile( void ) const { return mVolatile; }
+    inline void setVolatile( void ) { mVolatile = true; }
+
+    /// The clip rectangle subsequent primitives are recorded against.
+    inline void setClipRect( const RectI& clipRect ) { mClipRect = clipRect; }
+
+    /// Appends quads given as four vertices each in perimeter order.
+    void addQuads( TextureObject* pTexture, const Vertex* pVertices, const U32 vertexCount );
+    void addRectFill( const Point2I& upperL, const Point2I& lowerR, const ColorI& color );
+    void addLine( const Point2I& start, const Point2I& end, const ColorI& color, const F32 lineWidth );
+
+    /// Submits the batches recorded since the last call and returns the batch count.
+    /// Primitives recorded afterwards start a new batch.
+    U32 submitPending( void );
+
+    /// Submits a range of batches to the draw stream.
+    void submit( const U32 firstBatch, const U32 endBatch ) const;
+
+    /// Draws the whole list immediately.
+    void render( void ) const;
+
+    /// Draws and clears the shared draw stream.
+    static void flushStream( void );
+    static inline bool isStreamEmpty( void ) { return smStream.isEmpty(); }
+
+private:
+    Vertex* allocate( TextureObject* pTexture, const U32 primitive, const F32 lineWidth, const RectF& bounds, const U32 vertexCount );
+    void append( const DGLDrawList& source, const Batch& batch );
+    void lockTexture( TextureObject* pTexture );
+
+private:
+    Vector<Vertex>          mVertices;
+    Vector<Batch>           mBatches;
+    Vector<TextureHandle>   mTextures;
+    RectI                   mClipRect;
+    U32                     mPending;
+    bool                    mSealed;
+    bool                    mVolatile;
+
+    static DGLDrawList      smStream;
+};
+
+#endif // _DGL_DRAW_LIST_H_
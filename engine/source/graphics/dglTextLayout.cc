@@ -0,0 +1,502 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "graphics/dglTextLayout.h"
+#include "graphics/gFont.h"
+#include "collection/flatHashMap.h"
+#include "memory/frameAllocator.h"
+#include "string/unicode.h"
+#include "debug/profiler.h"
+
+//-----------------------------------------------------------------------------
+
+namespace
+{
+    /// Maps the color codes 1-14 onto color table indices.
+    const U8 sgColorRemap[15] =
+    {
+        0x0, // 0 special null terminator
+        0x0, // 1 ascii start-of-heading??
+        0x1,
+        0x2,
+        0x3,
+        0x4,
+        0x5,
+        0x6,
+        0x0, // 8 special backspace
+        0x0, // 9 special tab
+        0x0, // a special \n
+        0x7,
+        0x8,
+        0x0, // a special \r
+        0x9
+    };
+
+    enum { MaxColorTableSize = 10 };
+
+    /// We have to do a little dance here since \t = 0x9, \n = 0xa, and \r = 0xd
+    inline bool isColorCode( const U32 c )
+    {
+        return ( c >= 1 && c <= 7 ) || ( c >= 11 && c <= 12 ) || ( c == 14 );
+    }
+
+    //-------------------------------------------------------------------------
+
+    struct LayoutKey
+    {
+        const GFont*                mpFont;
+        const U8*                   mpString;
+        U32                         mByteCount;
+        bool                        mUTF8;
+        U32                         mLength;
+        DGLTextLayout::ColorState   mColors;
+        ColorI                      mColorTable[MaxColorTableSize];
+        U32                         mColorCount;
+        U32                         mHash;
+    };
+
+    struct CachedLayout
+    {
+        LayoutKey       mKey;
+        Vector<U8>      mString;
+        DGLTextLayout   mLayout;
+    };
+
+    Vector<CachedLayout*>   sgLayouts;
+    FlatHashMap<U32, U32>   sgLayoutIndex;
+    U32                     sgVertexCount = 0;
+    DGLTextLayout           sgScratchLayout;
+    Vector<U32>             sgGlyphRuns;
+    Vector<DGLTextLayout::Vertex> sgScratchVertices;
+
+    bool                    sgEnabled = true;
+    U32                     sgHitCount = 0;
+    U32                     sgMissCount = 0;
+
+    //-------------------------------------------------------------------------
+
+    inline U32 hashValue( const U32 hash, const U32 value )
+    {
+        return ( hash ^ value ) * 16777619u;
+    }
+
+    inline U32 hashColor( const U32 hash, const ColorI& color )
+    {
+        return hashValue( hash, ( (U32)color.red << 24 ) | ( (U32)color.green << 16 ) | ( (U32)color.blue << 8 ) | (U32)color.alpha );
+    }
+
+    /// Fills in the key for up to charLimit characters of the string.
+    /// @return False if the string is too long to be cached.
+    template<class T>
+    bool makeKey( LayoutKey& key, const GFont* pFont, const T* pString, const U32 charLimit, const ColorI* pColorTable, const U32 maxColorIndex )
+    {
+        // Only the color table entries the string uses are part of the key.
+        U32 hash = 2166136261u;
+        S32 maxColor = -1;
+        U32 count;
+        for ( count = 0; count < charLimit && pString[count]; ++count )
+        {
+            if ( count == DGLTextLayoutCache::MaxStringLength )
+                return false;
+
+            const U32 c = (U32)pString[count];
+            hash = hashValue( hash, c );
+
+            if ( pColorTable != NULL && isColorCode( c ) && sgColorRemap[c] <= maxColorIndex )
+                maxColor = getMax( maxColor, (S32)sgColorRemap[c] );
+        }
+
+        key.mpFont = pFont;
+        key.mpString = (const U8*)pString;
+        key.mByteCount = count * sizeof(T);
+        key.mColorCount = (U32)( maxColor + 1 );
+        for ( U32 index = 0; index < key.mColorCount; ++index )
+        {
+            key.mColorTable[index] = pColorTable[index];
+            hash = hashColor( hash, pColorTable[index] );
+        }
+
+        hash = hashValue( hash, (U32)(dsize_t)pFont );
+        hash = hashValue( hash, key.mLength );
+        hash = hashColor( hash, key.mColors.mModulation );
+        hash = hashColor( hash, key.mColors.mAnchor );
+        hash = hashColor( hash, key.mColors.mStack );
+        key.mHash = hashValue( hash, key.mUTF8 ? 1 : 0 );
+
+        return true;
+    }
+
+    bool keysMatch( const LayoutKey& a, const LayoutKey& b )
+    {
+        if ( a.mHash != b.mHash ||
+             a.mpFont != b.mpFont ||
+             a.mUTF8 != b.mUTF8 ||
+             a.mLength != b.mLength ||
+             a.mByteCount != b.mByteCount ||
+             a.mColorCount != b.mColorCount ||
+             !( a.mColors == b.mColors ) )
+            return false;
+
+        for ( U32 index = 0; index < a.mColorCount; ++index )
+        {
+            if ( a.mColorTable[index] != b.mColorTable[index] )
+                return false;
+        }
+
+        return dMemcmp( a.mpString, b.mpString, a.mByteCount ) == 0;
+    }
+
+    //-------------------------------------------------------------------------
+
+    void buildLayout( DGLTextLayout& layout, GFont* pFont, const UTF16* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors )
+    {
+        layout.build( pFont, pString, n, pColorTable, maxColorIndex, colors );
+    }
+
+    void buildLayout( DGLTextLayout& layout, GFont* pFont, const UTF8* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors )
+    {
+        PROFILE_START(DrawText_UTF8);
+
+        U32 len = dStrlen(pString) + 1;
+        FrameTemp<UTF16> ubuf(len);
+        convertUTF8toUTF16(pString, ubuf, len);
+        layout.build( pFont, ubuf, n, pColorTable, maxColorIndex, colors );
+
+        PROFILE_END();
+    }
+
+    //-------------------------------------------------------------------------
+
+    template<class T>
+    const DGLTextLayout& getCachedLayout( GFont* pFont, const T* pString, const U32 n, const U32 charLimit, const bool utf8, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors )
+    {
+        LayoutKey key;
+        key.mUTF8 = utf8;
+        key.mLength = utf8 ? n : 0;
+        key.mColors = colors;
+
+        if ( !sgEnabled || !makeKey( key, pFont, pString, charLimit, pColorTable, maxColorIndex ) )
+        {
+            buildLayout( sgScratchLayout, pFont, pString, n, pColorTable, maxColorIndex, colors );
+            return sgScratchLayout;
+        }
+
+        // Hit?
+        FlatHashMap<U32, U32>::iterator itr = sgLayoutIndex.find( key.mHash );
+        CachedLayout* pCached = NULL;
+        if ( itr != sgLayoutIndex.end() )
+        {
+            pCached = sgLayouts[itr->value];
+            if ( keysMatch( pCached->mKey, key ) )
+            {
+                sgHitCount++;
+                return pCached->mLayout;
+            }
+
+            // A different string with the same hash gives up its slot.
+            sgVertexCount -= pCached->mLayout.getVertices().size();
+        }
+        else
+        {
+            // Start over once the cache is full.
+            if ( (U32)sgLayouts.size() >= DGLTextLayoutCache::MaxLayouts || sgVertexCount >= DGLTextLayoutCache::MaxVertices )
+                DGLTextLayoutCache::clear();
+
+            pCached = new CachedLayout;
+            sgLayoutIndex.insert( key.mHash, sgLayouts.size() );
+            sgLayouts.push_back( pCached );
+        }
+
+        sgMissCount++;
+
+        pCached->mString.setSize( key.mByteCount );
+        if ( key.mByteCount > 0 )
+            dMemcpy( pCached->mString.address(), key.mpString, key.mByteCount );
+        pCached->mKey = key;
+        pCached->mKey.mpString = pCached->mString.address();
+
+        buildLayout( pCached->mLayout, pFont, pString, n, pColorTable, maxColorIndex, colors );
+        sgVertexCount += pCached->mLayout.getVertices().size();
+
+        return pCached->mLayout;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+DGLTextLayout::DGLTextLayout() :
+    mAdvance( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLTextLayout::clear( void )
+{
+    mVertices.clear();
+    mRuns.clear();
+    mAdvance = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLTextLayout::build( GFont* pFont, const UTF16* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const ColorState& colors )
+{
+    PROFILE_SCOPE(DGLTextLayout_Build);
+
+    clear();
+    sgGlyphRuns.clear();
+
+    ColorState state = colors;
+    S32 x = 0;
+    S32 sheetIndex = -1;
+    U32 runIndex = 0;
+
+    for ( U32 index = 0; index < n && pString[index]; ++index )
+    {
+        const UTF16 c = pString[index];
+
+        // Color code
+        if ( isColorCode( c ) )
+        {
+            if ( pColorTable != NULL )
+            {
+                // Ignore if the color is greater than the specified max index:
+                const U8 remapped = sgColorRemap[c];
+                if ( remapped <= maxColorIndex )
+                    state.mModulation = pColorTable[remapped];
+            }
+            continue;
+        }
+
+        // reset color?
+        if ( c == 15 )
+        {
+            state.mModulation = state.mAnchor;
+            continue;
+        }
+
+        // push color:
+        if ( c == 16 )
+        {
+            state.mStack = state.mModulation;
+            continue;
+        }
+
+        // pop color:
+        if ( c == 17 )
+        {
+            state.mModulation = state.mStack;
+            continue;
+        }
+
+        // Tab character
+        if ( c == dT('\t') )
+        {
+            const PlatformFont::CharInfo& ci = pFont->getCharInfo( dT(' ') );
+            x += ci.xIncrement * GFont::TabWidthInSpaces;
+            continue;
+        }
+
+        if ( !pFont->isValidChar( c ) )
+            continue;
+
+        const PlatformFont::CharInfo& ci = pFont->getCharInfo( c );
+
+        if ( ci.bitmapIndex == -1 )
+        {
+            x += ci.xOrigin + ci.xIncrement;
+            continue;
+        }
+
+        if ( ci.width == 0 || ci.height == 0 )
+        {
+            x += ci.xIncrement;
+            continue;
+        }
+
+        // Find the run for the glyph's sheet.
+        if ( ci.bitmapIndex != sheetIndex )
+        {
+            sheetIndex = ci.bitmapIndex;
+            TextureObject* pSheet = pFont->getTextureHandle( sheetIndex );
+
+            for ( runIndex = 0; runIndex < (U32)mRuns.size(); ++runIndex )
+            {
+                if ( mRuns[runIndex].mpTexture == pSheet )
+                    break;
+            }
+
+            if ( runIndex == (U32)mRuns.size() )
+            {
+                mRuns.increment();
+                mRuns.last().mpTexture = pSheet;
+                mRuns.last().mStart = 0;
+                mRuns.last().mCount = 0;
+            }
+        }
+
+        Run& run = mRuns[runIndex];
+
+        const F32 texLeft   = F32(ci.xOffset)             / F32(run.mpTexture->getTextureWidth());
+        const F32 texRight  = F32(ci.xOffset + ci.width)  / F32(run.mpTexture->getTextureWidth());
+        const F32 texTop    = F32(ci.yOffset)             / F32(run.mpTexture->getTextureHeight());
+        const F32 texBottom = F32(ci.yOffset + ci.height) / F32(run.mpTexture->getTextureHeight());
+
+        const F32 screenLeft   = (F32)( x + ci.xOrigin );
+        const F32 screenRight  = (F32)( x + ci.xOrigin + ci.width );
+        const F32 screenTop    = (F32)( (S32)pFont->getBaseline() - ci.yOrigin );
+        const F32 screenBottom = (F32)( (S32)pFont->getBaseline() - ci.yOrigin + ci.height );
+
+        mVertices.increment( 4 );
+        Vertex* pQuad = mVertices.end() - 4;
+        pQuad[0].set( screenLeft,  screenBottom, texLeft,  texBottom, state.mModulation );
+        pQuad[1].set( screenRight, screenBottom, texRight, texBottom, state.mModulation );
+        pQuad[2].set( screenRight, screenTop,    texRight, texTop,    state.mModulation );
+        pQuad[3].set( screenLeft,  screenTop,    texLeft,  texTop,    state.mModulation );
+
+        run.mCount += 4;
+        sgGlyphRuns.push_back( runIndex );
+
+        x += ci.xIncrement;
+    }
+
+    // Group the glyphs by sheet so that each sheet is a single draw.
+    if ( mRuns.size() > 1 )
+    {
+        U32 start = 0;
+        for ( S32 index = 0; index < mRuns.size(); ++index )
+        {
+            mRuns[index].mStart = start;
+            start += mRuns[index].mCount;
+            mRuns[index].mCount = 0;
+        }
+
+        sgScratchVertices = mVertices;
+        for ( S32 glyph = 0; glyph < sgGlyphRuns.size(); ++glyph )
+        {
+            Run& run = mRuns[sgGlyphRuns[glyph]];
+            dMemcpy( mVertices.address() + run.mStart + run.mCount, sgScratchVertices.address() + glyph * 4, sizeof(Vertex) * 4 );
+            run.mCount += 4;
+        }
+    }
+
+    AssertFatal( x >= 0, "DGLTextLayout::build() - How did this happen?" );
+
+    mAdvance = x;
+    mEndColors = state;
+}
+
+//-----------------------------------------------------------------------------
+
+const DGLTextLayout& DGLTextLayoutCache::getLayout( GFont* pFont, const UTF16* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors )
+{
+    return getCachedLayout( pFont, pString, n, n, false, pColorTable, maxColorIndex, colors );
+}
+
+//-----------------------------------------------------------------------------
+
+const DGLTextLayout& DGLTextLayoutCache::getLayout( GFont* pFont, const UTF8* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors )
+{
+    // The whole string is converted so the whole string is the key.
+    return getCachedLayout( pFont, pString, n, U32_MAX, true, pColorTable, maxColorIndex, colors );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLTextLayoutCache::purgeFont( const GFont* pFont )
+{
+    S32 kept = 0;
+    for ( S32 index = 0; index < sgLayouts.size(); ++index )
+    {
+        CachedLayout* pCached = sgLayouts[index];
+        if ( pCached->mKey.mpFont == pFont )
+        {
+            sgVertexCount -= pCached->mLayout.getVertices().size();
+            delete pCached;
+        }
+        else
+        {
+            sgLayouts[kept++] = pCached;
+        }
+    }
+
+    if ( kept == sgLayouts.size() )
+        return;
+
+    sgLayouts.setSize( kept );
+
+    // Indices have moved.
+    sgLayoutIndex.clear();
+    for ( S32 index = 0; index < sgLayouts.size(); ++index )
+        sgLayoutIndex.insert( sgLayouts[index]->mKey.mHash, index );
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLTextLayoutCache::clear( void )
+{
+    for ( S32 index = 0; index < sgLayouts.size(); ++index )
+        delete sgLayouts[index];
+
+    sgLayouts.clear();
+    sgLayoutIndex.clear();
+    sgVertexCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void DGLTextLayoutCache::setEnabled( const bool enabled )
+{
+    sgEnabled = enabled;
+
+    if ( !enabled )
+        clear();
+}
+
+//-----------------------------------------------------------------------------
+
+bool DGLTextLayoutCache::getEnabled( void )
+{
+    return sgEnabled;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 DGLTextLayoutCache::getLayoutCount( void )
+{
+    return sgLayouts.size();
+}
+
+//-----------------------------------------------------------------------------
+
+U32 DGLTextLayoutCache::getHitCount( void )
+{
+    return sgHitCount;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 DGLTextLayoutCache::getMissCount( void )
+{
+    return sgMissCount;
+}
@@ -0,0 +1,125 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _DGL_TEXT_LAYOUT_H_
+#define _DGL_TEXT_LAYOUT_H_
+
+#ifndef _DGL_DRAW_LIST_H_
+#include "graphics/dglDrawList.h"
+#endif
+
+class GFont;
+
+//-----------------------------------------------------------------------------
+
+/// The glyph quads of a string laid out at the origin.
+///
+/// Quads are in perimeter order and grouped by font sheet so that each sheet can be
+/// drawn with a single call.  Color codes are resolved while laying out, so a layout
+/// depends on the colors in effect when it was built as well as on the string.
+class DGLTextLayout
+{
+public:
+    typedef DGLDrawList::Vertex Vertex;
+
+    /// The dgl text colors a layout reads and changes.
+    struct ColorState
+    {
+        ColorI mModulation;
+        ColorI mAnchor;
+        ColorI mStack;
+
+        inline bool operator==( const ColorState& colors ) const { return mModulation == colors.mModulation && mAnchor == colors.mAnchor && mStack == colors.mStack; }
+    };
+
+    /// A range of vertices that use the same font sheet.
+    struct Run
+    {
+        TextureObject*  mpTexture;
+        U32             mStart;
+        U32             mCount;
+    };
+
+public:
+    DGLTextLayout();
+
+    void clear( void );
+
+    /// Lays out up to n characters of the string.
+    void build( GFont* pFont, const UTF16* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const ColorState& colors );
+
+    inline const Vector<Vertex>& getVertices( void ) const { return mVertices; }
+    inline const Vector<Run>& getRuns( void ) const { return mRuns; }
+
+    /// The horizontal distance the text advances the pen.
+    inline S32 getAdvance( void ) const { return mAdvance; }
+
+    /// The colors in effect after the text.
+    inline const ColorState& getEndColors( void ) const { return mEndColors; }
+
+private:
+    Vector<Vertex>  mVertices;
+    Vector<Run>     mRuns;
+    S32             mAdvance;
+    ColorState      mEndColors;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Layouts of recently drawn strings.
+///
+/// Layouts are keyed by font, string, length and the colors they depend on, so text
+/// that is drawn the same way every frame is only laid out once.  The cache is emptied
+/// when it fills up and a font drops its layouts when it is destroyed or its sheets are
+/// rebuilt.
+class DGLTextLayoutCache
+{
+public:
+    enum Limits
+    {
+        MaxLayouts          = 2048,     ///< Layouts held before the cache is emptied.
+        MaxVertices         = 262144,   ///< Vertices held before the cache is emptied.
+        MaxStringLength     = 1024,     ///< Longer strings are laid out every time.
+    };
+
+    /// Returns the layout of the string, building it on a miss.  The layout stays valid
+    /// until the next call.
+    static const DGLTextLayout& getLayout( GFont* pFont, const UTF16* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors );
+
+    /// Returns the layout of UTF8 text.  The text is only converted on a miss.
+    static const DGLTextLayout& getLayout( GFont* pFont, const UTF8* pString, const U32 n, const ColorI* pColorTable, const U32 maxColorIndex, const DGLTextLayout::ColorState& colors );
+
+    /// Drops the layouts that use the font.
+    static void purgeFont( const GFont* pFont );
+
+    static void clear( void );
+
+    /// When disabled every string is laid out each time it is drawn.
+    static void setEnabled( const bool enabled );
+    static bool getEnabled( void );
+
+    static U32 getLayoutCount( void );
+    static U32 getHitCount( void );
+    static U32 getMissCount( void );
+};
+
+#endif // _DGL_TEXT_LAYOUT_H_
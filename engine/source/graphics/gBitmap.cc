@@ -326,7 +326,7 @@ void bitmapExtrudeRGB_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWid
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
          src++;
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
-         src += 4;
+         src++;
 
          src += stride;   // skip
       }
@@ -385,7 +385,7 @@ void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 srcHeight, U32 srcWi
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
          src++;
          *dst++ = (U32(*src) + U32(src[stride]) + 1) >> 1;
-         src += 5;
+         src++;
 
          src += stride;   // skip
       }
@@ -409,7 +409,7 @@ void GBitmap::extrudeMipLevels(bool clearBorders)
       case RGB5551:
       {
          for(U32 i = 1; i < numMipLevels; i++)
-            bitmapExtrude5551(getBits(i - 1), getWritableBits(i), getHeight(i), getWidth(i));
+            bitmapExtrude5551(getBits(i - 1), getWritableBits(i), getHeight(i-1), getWidth(i-1));
          break;
       }
 
@@ -531,9 +531,45 @@ void bitmapConvertRGB_to_5551_c(U8 *src, U32 pixels)
    }
 }
 
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_5551_c(const U8 *src, U16 *dst, U32 pixels)
+{
+   const U32 *source = (const U32 *)src;
+   for(U32 j = 0; j < pixels; j++)
+   {
+      U32 color = *source++;
+      *dst++ = ((color & 0xF8) << 8) | ((color & 0xF800) >> 5) | ((color & 0xF80000) >> 18) | (color >> 31);
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_4444_c(const U8 *src, U16 *dst, U32 pixels)
+{
+   const U32 *source = (const U32 *)src;
+   for(U32 j = 0; j < pixels; j++)
+   {
+      U32 color = *source++;
+      *dst++ = ((color & 0xF0) << 8) | ((color & 0xF000) >> 4) | ((color & 0xF00000) >> 16) | ((color & 0xF0000000) >> 28);
+   }
+}
 
+//--------------------------------------------------------------------------
+void bitmapConvertRGB_to_565_c(const U8 *src, U16 *dst, U32 pixels)
+{
+   for(U32 j = 0; j < pixels; j++)
+   {
+      U32 r = src[0];
+      U32 g = src[1];
+      U32 b = src[2];
+      *dst++ = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | ((b & 0xF8) >> 3);
+      src += 3;
+   }
+}
 
 void (*bitmapConvertRGB_to_5551)(U8 *src, U32 pixels) = bitmapConvertRGB_to_5551_c;
+void (*bitmapConvertRGBA_to_5551)(const U8 *src, U16 *dst, U32 pixels) = bitmapConvertRGBA_to_5551_c;
+void (*bitmapConvertRGBA_to_4444)(const U8 *src, U16 *dst, U32 pixels) = bitmapConvertRGBA_to_4444_c;
+void (*bitmapConvertRGB_to_565)(const U8 *src, U16 *dst, U32 pixels) = bitmapConvertRGB_to_565_c;
 
 
 //--------------------------------------------------------------------------
@@ -157,6 +157,10 @@ class GBitmap: public ResourceInstance
    bool writePNG(Stream& io_rStream, const bool compressHard = false) const;
    bool writePNGUncompressed(Stream& io_rStream) const;
 
+   /// Read only the image dimensions from a stream without decoding any pixels.
+   static bool readJPEGDimensions(Stream& io_rStream, U32& width, U32& height);  // located in bitmapJpeg.cc
+   static bool readPNGDimensions(Stream& io_rStream, U32& width, U32& height);   // located in bitmapPng.cc
+
    bool readMSBmp(Stream& io_rStream);             // located in bitmapMS.cc
    bool writeMSBmp(Stream& io_rStream) const;      // located in bitmapMS.cc
 
@@ -248,11 +252,33 @@ inline const U8* GBitmap::getAddress(const S32 in_x, const S32 in_y, const U32 m
 }
 
 
+//------------------------------------------------------------------------------
+// Pixel kernels.  The extrude functions take the dimensions of the source mip
+// and write the next level down.  The C versions are installed by default and
+// are the reference the platform optimized versions must match bit for bit.
+
 extern void (*bitmapExtrude5551)(const void *srcMip, void *mip, U32 height, U32 width);
 extern void (*bitmapExtrudeRGB)(const void *srcMip, void *mip, U32 height, U32 width);
+extern void (*bitmapExtrudeRGBA)(const void *srcMip, void *mip, U32 height, U32 width);
 extern void (*bitmapConvertRGB_to_5551)(U8 *src, U32 pixels);
 extern void (*bitmapExtrudePaletted)(const void *srcMip, void *mip, U32 height, U32 width);
 
+// 16-bit texture conversions used by TextureManager::create16BitBitmap().
+extern void (*bitmapConvertRGBA_to_5551)(const U8 *src, U16 *dst, U32 pixels);
+extern void (*bitmapConvertRGBA_to_4444)(const U8 *src, U16 *dst, U32 pixels);
+extern void (*bitmapConvertRGB_to_565)(const U8 *src, U16 *dst, U32 pixels);
+
+void bitmapExtrude5551_c(const void *srcMip, void *mip, U32 height, U32 width);
 void bitmapExtrudeRGB_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapExtrudeRGBA_c(const void *srcMip, void *mip, U32 height, U32 width);
+void bitmapConvertRGB_to_5551_c(U8 *src, U32 pixels);
+void bitmapConvertRGBA_to_5551_c(const U8 *src, U16 *dst, U32 pixels);
+void bitmapConvertRGBA_to_4444_c(const U8 *src, U16 *dst, U32 pixels);
+void bitmapConvertRGB_to_565_c(const U8 *src, U16 *dst, U32 pixels);
+
+// Install the vectorized kernels.  Each returns false when the instruction set
+// was not available to the compiler for this build.
+bool bitmapInstallLibrary_SSE2();
+bool bitmapInstallLibrary_NEON();
 
 #endif //_GBITMAP_H_
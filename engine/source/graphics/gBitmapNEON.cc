@@ -0,0 +1,313 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "graphics/gBitmap.h"
+
+// NEON is part of the baseline for the ARM targets we ship, so the kernels
+// are enabled whenever the compiler exposes the intrinsics.  This file is not
+// yet part of the iOS project; add it there once BitmapKernelTests has passed
+// on a device.
+#if defined(TORQUE_CPU_ARM) && defined(TORQUE_LITTLE_ENDIAN) && (defined(__ARM_NEON__) || defined(__ARM_NEON))
+#define TORQUE_BITMAP_NEON
+#endif
+
+#if defined(TORQUE_BITMAP_NEON)
+
+#include <arm_neon.h>
+
+//--------------------------------------------------------------------------
+void bitmapExtrude5551_neon(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrude5551_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U16 *src = (const U16 *) srcMip;
+   U16 *dst = (U16 *) mip;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   const uint16x8_t mask = vdupq_n_u16(0x1F);
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U16 *row0 = src;
+      const U16 *row1 = src + srcWidth;
+      U32 x = 0;
+
+      for(; x + 4 <= width; x += 4)
+      {
+         uint16x8_t a = vld1q_u16(row0);
+         uint16x8_t c = vld1q_u16(row1);
+
+         // Pairwise widening adds give the horizontal sums, one field at a time.
+         uint32x4_t r = vaddq_u32(vpaddlq_u16(vshrq_n_u16(a, 11)), vpaddlq_u16(vshrq_n_u16(c, 11)));
+         uint32x4_t g = vaddq_u32(vpaddlq_u16(vandq_u16(vshrq_n_u16(a, 6), mask)), vpaddlq_u16(vandq_u16(vshrq_n_u16(c, 6), mask)));
+         uint32x4_t b = vaddq_u32(vpaddlq_u16(vandq_u16(vshrq_n_u16(a, 1), mask)), vpaddlq_u16(vandq_u16(vshrq_n_u16(c, 1), mask)));
+
+         uint32x4_t result = vorrq_u32(vshlq_n_u32(vshrq_n_u32(r, 2), 11),
+                             vorrq_u32(vshlq_n_u32(vshrq_n_u32(g, 2), 6),
+                                       vshlq_n_u32(vshrq_n_u32(b, 2), 1)));
+         vst1_u16(dst, vmovn_u32(result));
+
+         row0 += 8;
+         row1 += 8;
+         dst  += 4;
+      }
+
+      for(; x < width; x++)
+      {
+         U32 a = row0[0];
+         U32 b = row0[1];
+         U32 c = row1[0];
+         U32 d = row1[1];
+         *dst++ = (((  (a >> 11) + (b >> 11) + (c >> 11) + (d >> 11)) >> 2) << 11) |
+                  ((( ((a >> 6) & 0x1F) + ((b >> 6) & 0x1F) + ((c >> 6) & 0x1F) + ((d >> 6) & 0x1F)) >> 2) << 6) |
+                  ((( ((a >> 1) & 0x1F) + ((b >> 1) & 0x1F) + ((c >> 1) & 0x1F) + ((d >> 1) & 0x1F)) >> 2) << 1);
+         row0 += 2;
+         row1 += 2;
+      }
+
+      src = row0 + srcWidth;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGB_neon(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrudeRGB_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+   U32 stride = srcWidth * 3;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U8 *row0 = src;
+      const U8 *row1 = src + stride;
+      U32 x = 0;
+
+      for(; x + 8 <= width; x += 8)
+      {
+         uint8x16x3_t a = vld3q_u8(row0);
+         uint8x16x3_t c = vld3q_u8(row1);
+         uint8x8x3_t out;
+
+         // (sum + 2) >> 2 is exactly the rounding narrow shift.
+         out.val[0] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[0]), vpaddlq_u8(c.val[0])), 2);
+         out.val[1] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[1]), vpaddlq_u8(c.val[1])), 2);
+         out.val[2] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[2]), vpaddlq_u8(c.val[2])), 2);
+         vst3_u8(dst, out);
+
+         row0 += 48;
+         row1 += 48;
+         dst  += 24;
+      }
+
+      for(; x < width; x++)
+      {
+         *dst++ = (U32(row0[0]) + U32(row0[3]) + U32(row1[0]) + U32(row1[3]) + 2) >> 2;
+         *dst++ = (U32(row0[1]) + U32(row0[4]) + U32(row1[1]) + U32(row1[4]) + 2) >> 2;
+         *dst++ = (U32(row0[2]) + U32(row0[5]) + U32(row1[2]) + U32(row1[5]) + 2) >> 2;
+         row0 += 6;
+         row1 += 6;
+      }
+
+      src = row0 + stride;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGBA_neon(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrudeRGBA_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+   U32 stride = srcWidth * 4;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U8 *row0 = src;
+      const U8 *row1 = src + stride;
+      U32 x = 0;
+
+      for(; x + 8 <= width; x += 8)
+      {
+         uint8x16x4_t a = vld4q_u8(row0);
+         uint8x16x4_t c = vld4q_u8(row1);
+         uint8x8x4_t out;
+
+         out.val[0] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[0]), vpaddlq_u8(c.val[0])), 2);
+         out.val[1] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[1]), vpaddlq_u8(c.val[1])), 2);
+         out.val[2] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[2]), vpaddlq_u8(c.val[2])), 2);
+         out.val[3] = vrshrn_n_u16(vaddq_u16(vpaddlq_u8(a.val[3]), vpaddlq_u8(c.val[3])), 2);
+         vst4_u8(dst, out);
+
+         row0 += 64;
+         row1 += 64;
+         dst  += 32;
+      }
+
+      for(; x < width; x++)
+      {
+         *dst++ = (U32(row0[0]) + U32(row0[4]) + U32(row1[0]) + U32(row1[4]) + 2) >> 2;
+         *dst++ = (U32(row0[1]) + U32(row0[5]) + U32(row1[1]) + U32(row1[5]) + 2) >> 2;
+         *dst++ = (U32(row0[2]) + U32(row0[6]) + U32(row1[2]) + U32(row1[6]) + 2) >> 2;
+         *dst++ = (U32(row0[3]) + U32(row0[7]) + U32(row1[3]) + U32(row1[7]) + 2) >> 2;
+         row0 += 8;
+         row1 += 8;
+      }
+
+      src = row0 + stride;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+// Eight pixels of separated channels to RGB5551.
+static inline uint16x8_t channelsTo5551(uint8x8_t r, uint8x8_t g, uint8x8_t b, uint16x8_t alpha)
+{
+   const uint8x8_t mask = vdup_n_u8(0xF8);
+   uint16x8_t result = vshll_n_u8(vand_u8(r, mask), 8);
+   result = vorrq_u16(result, vshll_n_u8(vand_u8(g, mask), 3));
+   result = vorrq_u16(result, vmovl_u8(vshr_n_u8(vand_u8(b, mask), 2)));
+   return vorrq_u16(result, alpha);
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGB_to_5551_neon(U8 *src, U32 pixels)
+{
+   // Converts in place.  Each group is loaded before its store, and the
+   // store never reaches the bytes the next group reads.
+   U16 *dst = (U16 *)src;
+   const uint16x8_t alpha = vdupq_n_u16(1);
+   U32 j = 0;
+
+   for(; j + 8 <= pixels; j += 8)
+   {
+      uint8x8x3_t rgb = vld3_u8(src);
+      vst1q_u16(dst, channelsTo5551(rgb.val[0], rgb.val[1], rgb.val[2], alpha));
+      src += 24;
+      dst += 8;
+   }
+
+   for(; j < pixels; j++)
+   {
+      U32 r = src[0] >> 3;
+      U32 g = src[1] >> 3;
+      U32 b = src[2] >> 3;
+      *dst++ = (b << 1) | (g << 6) | (r << 11) | 1;
+      src += 3;
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_5551_neon(const U8 *src, U16 *dst, U32 pixels)
+{
+   U32 j = 0;
+   for(; j + 8 <= pixels; j += 8)
+   {
+      uint8x8x4_t rgba = vld4_u8(src);
+      uint16x8_t alpha = vmovl_u8(vshr_n_u8(rgba.val[3], 7));
+      vst1q_u16(dst, channelsTo5551(rgba.val[0], rgba.val[1], rgba.val[2], alpha));
+      src += 32;
+      dst += 8;
+   }
+
+   bitmapConvertRGBA_to_5551_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_4444_neon(const U8 *src, U16 *dst, U32 pixels)
+{
+   const uint8x8_t mask = vdup_n_u8(0xF0);
+   U32 j = 0;
+   for(; j + 8 <= pixels; j += 8)
+   {
+      uint8x8x4_t rgba = vld4_u8(src);
+      uint16x8_t result = vshll_n_u8(vand_u8(rgba.val[0], mask), 8);
+      result = vorrq_u16(result, vshll_n_u8(vand_u8(rgba.val[1], mask), 4));
+      result = vorrq_u16(result, vmovl_u8(vand_u8(rgba.val[2], mask)));
+      result = vorrq_u16(result, vmovl_u8(vshr_n_u8(rgba.val[3], 4)));
+      vst1q_u16(dst, result);
+      src += 32;
+      dst += 8;
+   }
+
+   bitmapConvertRGBA_to_4444_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGB_to_565_neon(const U8 *src, U16 *dst, U32 pixels)
+{
+   U32 j = 0;
+   for(; j + 8 <= pixels; j += 8)
+   {
+      uint8x8x3_t rgb = vld3_u8(src);
+      uint16x8_t result = vshll_n_u8(vand_u8(rgb.val[0], vdup_n_u8(0xF8)), 8);
+      result = vorrq_u16(result, vshll_n_u8(vand_u8(rgb.val[1], vdup_n_u8(0xFC)), 3));
+      result = vorrq_u16(result, vmovl_u8(vshr_n_u8(rgb.val[2], 3)));
+      vst1q_u16(dst, result);
+      src += 24;
+      dst += 8;
+   }
+
+   bitmapConvertRGB_to_565_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+bool bitmapInstallLibrary_NEON()
+{
+   bitmapExtrude5551         = bitmapExtrude5551_neon;
+   bitmapExtrudeRGB          = bitmapExtrudeRGB_neon;
+   bitmapExtrudeRGBA         = bitmapExtrudeRGBA_neon;
+   bitmapConvertRGB_to_5551  = bitmapConvertRGB_to_5551_neon;
+   bitmapConvertRGBA_to_5551 = bitmapConvertRGBA_to_5551_neon;
+   bitmapConvertRGBA_to_4444 = bitmapConvertRGBA_to_4444_neon;
+   bitmapConvertRGB_to_565   = bitmapConvertRGB_to_565_neon;
+   return true;
+}
+
+#else
+
+//--------------------------------------------------------------------------
+bool bitmapInstallLibrary_NEON()
+{
+   return false;
+}
+
+#endif // TORQUE_BITMAP_NEON
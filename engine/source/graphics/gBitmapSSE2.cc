@@ -0,0 +1,400 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "graphics/gBitmap.h"
+
+// The SSE2 kernels are only built when the compiler is allowed to emit SSE2.
+// Whether the processor actually has it is checked at startup by the caller
+// of bitmapInstallLibrary_SSE2().
+#if defined(TORQUE_CPU_X86) && (defined(TORQUE_COMPILER_VISUALC) || defined(__SSE2__))
+#define TORQUE_BITMAP_SSE2
+#endif
+
+#if defined(TORQUE_BITMAP_SSE2)
+
+#include <emmintrin.h>
+
+//--------------------------------------------------------------------------
+// Pack two vectors of 32-bit values in [0, 0xFFFF] into one vector of 16-bit
+// values.  _mm_packs_epi32 saturates signed, so bias into the signed range.
+static inline __m128i packU32ToU16(__m128i lo, __m128i hi)
+{
+   const __m128i bias32 = _mm_set1_epi32(0x8000);
+   const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+   return _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(lo, bias32), _mm_sub_epi32(hi, bias32)), bias16);
+}
+
+//--------------------------------------------------------------------------
+// Spread four packed 24-bit pixels into the low three bytes of each 32-bit
+// lane.  Reads 16 bytes from src.
+static inline __m128i expandRGB(const U8 *src)
+{
+   const __m128i lane0 = _mm_set_epi32(0, 0, 0, -1);
+   const __m128i lane1 = _mm_set_epi32(0, 0, -1, 0);
+   const __m128i lane2 = _mm_set_epi32(0, -1, 0, 0);
+   const __m128i lane3 = _mm_set_epi32(-1, 0, 0, 0);
+
+   __m128i v = _mm_loadu_si128((const __m128i *)src);
+   __m128i x = _mm_and_si128(v, lane0);
+   x = _mm_or_si128(x, _mm_and_si128(_mm_slli_si128(v, 1), lane1));
+   x = _mm_or_si128(x, _mm_and_si128(_mm_slli_si128(v, 2), lane2));
+   x = _mm_or_si128(x, _mm_and_si128(_mm_slli_si128(v, 3), lane3));
+   return x;
+}
+
+//--------------------------------------------------------------------------
+// 0xRRGGBB (little endian lanes) to the in-place RGB5551 layout used by
+// bitmapConvertRGB_to_5551_c().
+static inline __m128i lanesTo5551(__m128i c, __m128i alpha)
+{
+   __m128i r = _mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF8)), 8);
+   __m128i g = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF800)), 5);
+   __m128i b = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF80000)), 18);
+   return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, alpha));
+}
+
+static inline __m128i lanesTo4444(__m128i c)
+{
+   __m128i r = _mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF0)), 8);
+   __m128i g = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF000)), 4);
+   __m128i b = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF00000)), 16);
+   __m128i a = _mm_srli_epi32(c, 28);
+   return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+static inline __m128i lanesTo565(__m128i c)
+{
+   __m128i r = _mm_slli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF8)), 8);
+   __m128i g = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xFC00)), 5);
+   __m128i b = _mm_srli_epi32(_mm_and_si128(c, _mm_set1_epi32(0xF80000)), 19);
+   return _mm_or_si128(_mm_or_si128(r, g), b);
+}
+
+//--------------------------------------------------------------------------
+// One 5-bit field of eight RGB5551 pixels from two rows, box filtered down to
+// four pixels and shifted back into place.
+static inline __m128i extrude5551Field(__m128i a0, __m128i a1, __m128i c0, __m128i c1, int shift)
+{
+   const __m128i mask = _mm_set1_epi16(0x1F);
+   const __m128i ones = _mm_set1_epi16(1);
+   const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+
+   // Vertical sums of the field, then madd with 1 adds neighboring pairs into 32-bit lanes.
+   __m128i s0 = _mm_add_epi16(_mm_and_si128(_mm_srl_epi16(a0, shiftCount), mask), _mm_and_si128(_mm_srl_epi16(c0, shiftCount), mask));
+   __m128i s1 = _mm_add_epi16(_mm_and_si128(_mm_srl_epi16(a1, shiftCount), mask), _mm_and_si128(_mm_srl_epi16(c1, shiftCount), mask));
+   s0 = _mm_sll_epi32(_mm_srli_epi32(_mm_madd_epi16(s0, ones), 2), shiftCount);
+   s1 = _mm_sll_epi32(_mm_srli_epi32(_mm_madd_epi16(s1, ones), 2), shiftCount);
+   return packU32ToU16(s0, s1);
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrude5551_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrude5551_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U16 *src = (const U16 *) srcMip;
+   U16 *dst = (U16 *) mip;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U16 *row0 = src;
+      const U16 *row1 = src + srcWidth;
+      U32 x = 0;
+
+      for(; x + 8 <= width; x += 8)
+      {
+         __m128i a0 = _mm_loadu_si128((const __m128i *)row0);
+         __m128i a1 = _mm_loadu_si128((const __m128i *)(row0 + 8));
+         __m128i c0 = _mm_loadu_si128((const __m128i *)row1);
+         __m128i c1 = _mm_loadu_si128((const __m128i *)(row1 + 8));
+
+         __m128i result = _mm_or_si128(extrude5551Field(a0, a1, c0, c1, 11),
+                          _mm_or_si128(extrude5551Field(a0, a1, c0, c1, 6),
+                                       extrude5551Field(a0, a1, c0, c1, 1)));
+         _mm_storeu_si128((__m128i *)dst, result);
+
+         row0 += 16;
+         row1 += 16;
+         dst  += 8;
+      }
+
+      for(; x < width; x++)
+      {
+         U32 a = row0[0];
+         U32 b = row0[1];
+         U32 c = row1[0];
+         U32 d = row1[1];
+         *dst++ = (((  (a >> 11) + (b >> 11) + (c >> 11) + (d >> 11)) >> 2) << 11) |
+                  ((( ((a >> 6) & 0x1F) + ((b >> 6) & 0x1F) + ((c >> 6) & 0x1F) + ((d >> 6) & 0x1F)) >> 2) << 6) |
+                  ((( ((a >> 1) & 0x1F) + ((b >> 1) & 0x1F) + ((c >> 1) & 0x1F) + ((d >> 1) & 0x1F)) >> 2) << 1);
+         row0 += 2;
+         row1 += 2;
+      }
+
+      src = row0 + srcWidth;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGB_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrudeRGB_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+   U32 stride = srcWidth * 3;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i two  = _mm_set1_epi16(2);
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U8 *row0 = src;
+      const U8 *row1 = src + stride;
+      U32 x = 0;
+
+      // Each group reads 8 bytes past every pixel pair and writes 4 bytes per
+      // 3 byte output pixel, so stop while at least one pixel is left over for
+      // the scalar loop to finish the row.
+      for(; x + 4 < width; x += 4)
+      {
+         __m128i pair01 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)row0), _mm_loadl_epi64((const __m128i *)(row0 + 6)));
+         __m128i pair23 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(row0 + 12)), _mm_loadl_epi64((const __m128i *)(row0 + 18)));
+         __m128i next01 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)row1), _mm_loadl_epi64((const __m128i *)(row1 + 6)));
+         __m128i next23 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(row1 + 12)), _mm_loadl_epi64((const __m128i *)(row1 + 18)));
+
+         // Vertical sums: words 0-2 are the left pixel of a pair, words 3-5 the right.
+         __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(pair01, zero), _mm_unpacklo_epi8(next01, zero));
+         __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(pair01, zero), _mm_unpackhi_epi8(next01, zero));
+         __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(pair23, zero), _mm_unpacklo_epi8(next23, zero));
+         __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(pair23, zero), _mm_unpackhi_epi8(next23, zero));
+
+         s0 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(s0, _mm_srli_si128(s0, 6)), two), 2);
+         s1 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(s1, _mm_srli_si128(s1, 6)), two), 2);
+         s2 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(s2, _mm_srli_si128(s2, 6)), two), 2);
+         s3 = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(s3, _mm_srli_si128(s3, 6)), two), 2);
+
+         __m128i out01 = _mm_packus_epi16(s0, s1);
+         __m128i out23 = _mm_packus_epi16(s2, s3);
+         *((U32 *)(dst + 0)) = (U32)_mm_cvtsi128_si32(out01);
+         *((U32 *)(dst + 3)) = (U32)_mm_cvtsi128_si32(_mm_srli_si128(out01, 8));
+         *((U32 *)(dst + 6)) = (U32)_mm_cvtsi128_si32(out23);
+         *((U32 *)(dst + 9)) = (U32)_mm_cvtsi128_si32(_mm_srli_si128(out23, 8));
+
+         row0 += 24;
+         row1 += 24;
+         dst  += 12;
+      }
+
+      for(; x < width; x++)
+      {
+         *dst++ = (U32(row0[0]) + U32(row0[3]) + U32(row1[0]) + U32(row1[3]) + 2) >> 2;
+         *dst++ = (U32(row0[1]) + U32(row0[4]) + U32(row1[1]) + U32(row1[4]) + 2) >> 2;
+         *dst++ = (U32(row0[2]) + U32(row0[5]) + U32(row1[2]) + U32(row1[5]) + 2) >> 2;
+         row0 += 6;
+         row1 += 6;
+      }
+
+      src = row0 + stride;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapExtrudeRGBA_sse2(const void *srcMip, void *mip, U32 srcHeight, U32 srcWidth)
+{
+   if (srcHeight == 1 || srcWidth == 1)
+   {
+      bitmapExtrudeRGBA_c(srcMip, mip, srcHeight, srcWidth);
+      return;
+   }
+
+   const U8 *src = (const U8 *) srcMip;
+   U8 *dst = (U8 *) mip;
+   U32 stride = srcWidth * 4;
+   U32 width  = srcWidth  >> 1;
+   U32 height = srcHeight >> 1;
+
+   const __m128i zero = _mm_setzero_si128();
+   const __m128i two  = _mm_set1_epi16(2);
+
+   for(U32 y = 0; y < height; y++)
+   {
+      const U8 *row0 = src;
+      const U8 *row1 = src + stride;
+      U32 x = 0;
+
+      for(; x + 4 <= width; x += 4)
+      {
+         __m128i a = _mm_loadu_si128((const __m128i *)row0);
+         __m128i b = _mm_loadu_si128((const __m128i *)(row0 + 16));
+         __m128i c = _mm_loadu_si128((const __m128i *)row1);
+         __m128i d = _mm_loadu_si128((const __m128i *)(row1 + 16));
+
+         // Vertical sums of source pixels 0-1, 2-3, 4-5 and 6-7.
+         __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(c, zero));
+         __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(c, zero));
+         __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(d, zero));
+         __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(d, zero));
+
+         // Horizontal sums: regroup so the left and right pixel of each pair line up.
+         __m128i q0 = _mm_add_epi16(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+         __m128i q1 = _mm_add_epi16(_mm_unpacklo_epi64(s45, s67), _mm_unpackhi_epi64(s45, s67));
+         q0 = _mm_srli_epi16(_mm_add_epi16(q0, two), 2);
+         q1 = _mm_srli_epi16(_mm_add_epi16(q1, two), 2);
+
+         _mm_storeu_si128((__m128i *)dst, _mm_packus_epi16(q0, q1));
+
+         row0 += 32;
+         row1 += 32;
+         dst  += 16;
+      }
+
+      for(; x < width; x++)
+      {
+         *dst++ = (U32(row0[0]) + U32(row0[4]) + U32(row1[0]) + U32(row1[4]) + 2) >> 2;
+         *dst++ = (U32(row0[1]) + U32(row0[5]) + U32(row1[1]) + U32(row1[5]) + 2) >> 2;
+         *dst++ = (U32(row0[2]) + U32(row0[6]) + U32(row1[2]) + U32(row1[6]) + 2) >> 2;
+         *dst++ = (U32(row0[3]) + U32(row0[7]) + U32(row1[3]) + U32(row1[7]) + 2) >> 2;
+         row0 += 8;
+         row1 += 8;
+      }
+
+      src = row0 + stride;   // skip
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGB_to_5551_sse2(U8 *src, U32 pixels)
+{
+   // Converts in place.  Both loads of a group happen before its store, and
+   // the store never reaches the bytes the next group reads.
+   U16 *dst = (U16 *)src;
+   const __m128i alpha = _mm_set1_epi32(1);
+   U32 j = 0;
+
+   // expandRGB() reads 16 bytes for 12 bytes of pixels.
+   for(; j + 10 <= pixels; j += 8)
+   {
+      __m128i lo = lanesTo5551(expandRGB(src), alpha);
+      __m128i hi = lanesTo5551(expandRGB(src + 12), alpha);
+      _mm_storeu_si128((__m128i *)dst, packU32ToU16(lo, hi));
+      src += 24;
+      dst += 8;
+   }
+
+   for(; j < pixels; j++)
+   {
+      U32 r = src[0] >> 3;
+      U32 g = src[1] >> 3;
+      U32 b = src[2] >> 3;
+      *dst++ = (b << 1) | (g << 6) | (r << 11) | 1;
+      src += 3;
+   }
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_5551_sse2(const U8 *src, U16 *dst, U32 pixels)
+{
+   U32 j = 0;
+   for(; j + 8 <= pixels; j += 8)
+   {
+      __m128i lo = _mm_loadu_si128((const __m128i *)src);
+      __m128i hi = _mm_loadu_si128((const __m128i *)(src + 16));
+      lo = lanesTo5551(lo, _mm_srli_epi32(lo, 31));
+      hi = lanesTo5551(hi, _mm_srli_epi32(hi, 31));
+      _mm_storeu_si128((__m128i *)dst, packU32ToU16(lo, hi));
+      src += 32;
+      dst += 8;
+   }
+
+   bitmapConvertRGBA_to_5551_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGBA_to_4444_sse2(const U8 *src, U16 *dst, U32 pixels)
+{
+   U32 j = 0;
+   for(; j + 8 <= pixels; j += 8)
+   {
+      __m128i lo = lanesTo4444(_mm_loadu_si128((const __m128i *)src));
+      __m128i hi = lanesTo4444(_mm_loadu_si128((const __m128i *)(src + 16)));
+      _mm_storeu_si128((__m128i *)dst, packU32ToU16(lo, hi));
+      src += 32;
+      dst += 8;
+   }
+
+   bitmapConvertRGBA_to_4444_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+void bitmapConvertRGB_to_565_sse2(const U8 *src, U16 *dst, U32 pixels)
+{
+   U32 j = 0;
+
+   // expandRGB() reads 16 bytes for 12 bytes of pixels.
+   for(; j + 10 <= pixels; j += 8)
+   {
+      __m128i lo = lanesTo565(expandRGB(src));
+      __m128i hi = lanesTo565(expandRGB(src + 12));
+      _mm_storeu_si128((__m128i *)dst, packU32ToU16(lo, hi));
+      src += 24;
+      dst += 8;
+   }
+
+   bitmapConvertRGB_to_565_c(src, dst, pixels - j);
+}
+
+//--------------------------------------------------------------------------
+bool bitmapInstallLibrary_SSE2()
+{
+   bitmapExtrude5551         = bitmapExtrude5551_sse2;
+   bitmapExtrudeRGB          = bitmapExtrudeRGB_sse2;
+   bitmapExtrudeRGBA         = bitmapExtrudeRGBA_sse2;
+   bitmapConvertRGB_to_5551  = bitmapConvertRGB_to_5551_sse2;
+   bitmapConvertRGBA_to_5551 = bitmapConvertRGBA_to_5551_sse2;
+   bitmapConvertRGBA_to_4444 = bitmapConvertRGBA_to_4444_sse2;
+   bitmapConvertRGB_to_565   = bitmapConvertRGB_to_565_sse2;
+   return true;
+}
+
+#else
+
+//--------------------------------------------------------------------------
+bool bitmapInstallLibrary_SSE2()
+{
+   return false;
+}
+
+#endif // TORQUE_BITMAP_SSE2
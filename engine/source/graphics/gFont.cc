@@ -31,6 +31,7 @@
 #include "string/findMatch.h"
 #include "graphics/TextureManager.h"
 #include "graphics/gFont.h"
+#include "graphics/dglTextLayout.h"
 #include "memory/safeDelete.h"
 #include "memory/frameAllocator.h"
 #include "string/unicode.h"
@@ -463,6 +464,8 @@ GFont::GFont()
 
 GFont::~GFont()
 {
+   // Cached text layouts point at our sheets.
+   DGLTextLayoutCache::purgeFont(this);
    
    // Need to stop this for now!
    mNeedSave = false; 
@@ -1183,6 +1186,7 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    // Wipe our texture sheets.
    mCurSheet = mCurX = mCurY = 0;
    mTextureSheets.clear();
+   DGLTextLayoutCache::purgeFont(this);
 
    //  Now, load the font strip.
    GBitmap *strip = GBitmap::load(fileName);
@@ -113,6 +113,7 @@ void GuiButtonBaseCtrl::initPersistFields()
 void GuiButtonBaseCtrl::setText(const char *text)
 {
    mButtonText = StringTable->insert(text);
+   setUpdate();
 }
 
 void GuiButtonBaseCtrl::setStateOn( bool bStateOn )
@@ -164,6 +165,9 @@ void GuiButtonBaseCtrl::acceleratorKeyPress(U32)
 
    if (mProfile->mTabable)
       setFirstResponder();
+
+   //update
+   setUpdate();
 }
 
 //---------------------------------------------------------------------------
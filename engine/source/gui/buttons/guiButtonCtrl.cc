@@ -95,3 +95,8 @@ void GuiButtonCtrl::onRender(Point2I      offset,
    renderChildControls( offset, updateRect);
 }
 
+bool GuiButtonCtrl::canCacheRender() const
+{
+   return getClassRep() == getStaticClassRep();
+}
+
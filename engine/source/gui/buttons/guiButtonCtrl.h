@@ -37,6 +37,7 @@ public:
    GuiButtonCtrl();
    bool onWake();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool canCacheRender() const;
 };
 
 #endif //_GUI_BUTTON_CTRL_H
@@ -162,6 +162,11 @@ void GuiCheckBoxCtrl::onRender(Point2I offset, const RectI &updateRect)
    renderChildControls(offset, updateRect);
 }
 
+bool GuiCheckBoxCtrl::canCacheRender() const
+{
+   return getClassRep() == getStaticClassRep();
+}
+
 ConsoleMethod(GuiCheckBoxCtrl, setStateOn, void, 3, 3, "(state) Sets the control as active and updates siblings of the same group."
               "@param state This argument may be a boolean value or an integer."
               "state < 0: Parent::setStateOn(false), obj::setActive(false)\n"
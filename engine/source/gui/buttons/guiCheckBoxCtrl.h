@@ -46,6 +46,7 @@ public:
    virtual void onMouseUp(const GuiEvent& event);
    virtual void onAction();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool canCacheRender() const;
    bool onWake();
 
    static void initPersistFields();
@@ -218,9 +218,19 @@ void GuiArrayCtrl::onRender(Point2I offset, const RectI &updateRect)
    //save the original for clipping the row headers
    RectI origClipRect = clipRect;
 
-   for (j = 0; j < mSize.y; j++)
+   //rows and columns are a fixed size, so work out the visible range directly
+   //rather than walking every row of a large list each frame
+   if (mCellSize.x <= 0 || mCellSize.y <= 0)
+      return;
+
+   S32 firstRow = getMax(0, (updateRect.point.y - offset.y) / mCellSize.y);
+   S32 lastRow = getMin(mSize.y, (updateRect.point.y + updateRect.extent.y - offset.y) / mCellSize.y + 1);
+   S32 firstCol = getMax(0, (updateRect.point.x - offset.x) / mCellSize.x);
+   S32 lastCol = getMin(mSize.x, (updateRect.point.x + updateRect.extent.x - offset.x) / mCellSize.x + 1);
+
+   for (j = firstRow; j < lastRow; j++)
    {
-      //skip until we get to a visible row
+      //skip the row above the update rect that the rounding may have let in
       if ((j + 1) * mCellSize.y + offset.y < updateRect.point.y)
          continue;
 
@@ -247,7 +257,7 @@ void GuiArrayCtrl::onRender(Point2I offset, const RectI &updateRect)
       }
 
       //render the cells for the row
-      for (i = 0; i < mSize.x; i++)
+      for (i = firstCol; i < lastCol; i++)
       {
          //skip past columns off the left edge
          if ((i + 1) * mCellSize.x + offset.x < updateRect.point.x)
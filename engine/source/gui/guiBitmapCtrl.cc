@@ -165,6 +165,7 @@ void GuiBitmapCtrl::setBitmap(const TextureHandle &handle, bool resize)
       Point2I extent = getParent()->getExtent();
       parentResized(extent,extent);
    }
+   setUpdate();
 }
 
 
@@ -233,6 +234,11 @@ void GuiBitmapCtrl::onRender(Point2I offset, const RectI &updateRect)
    renderChildControls(offset, updateRect);
 }
 
+bool GuiBitmapCtrl::canCacheRender() const
+{
+   return getClassRep() == getStaticClassRep();
+}
+
 void GuiBitmapCtrl::setValue(S32 x, S32 y)
 {
    if (mTextureHandle)
@@ -248,14 +254,18 @@ void GuiBitmapCtrl::setValue(S32 x, S32 y)
     while (y < 0)
         y += 256;
     startPoint.y = y % 256;
+
+    setUpdate();
 }
 
 //Luma:	ability to specify source rect for image UVs
 void GuiBitmapCtrl::setSourceRect(U32 x, U32 y, U32 width, U32 height) 
 { 
     mSourceRect.set(x, y, width, height); 
+    setUpdate();
 } 
 void GuiBitmapCtrl::setUseSourceRect(bool bUse)
 {
     mUseSourceRect = bUse;
+    setUpdate();
 }
\ No newline at end of file
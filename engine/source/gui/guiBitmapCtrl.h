@@ -72,6 +72,7 @@ public:
    void setUseSourceRect(bool bUse);
 
    void onRender(Point2I offset, const RectI &updateRect);
+   bool canCacheRender() const;
    void setValue(S32 x, S32 y);
 };
 
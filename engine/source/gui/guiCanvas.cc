@@ -24,6 +24,8 @@
 #include "console/consoleInternal.h"
 #include "debug/profiler.h"
 #include "graphics/dgl.h"
+#include "graphics/dglDrawList.h"
+#include "graphics/TextureManager.h"
 #include "platform/event.h"
 #include "platform/platform.h"
 #include "platform/platformVideo.h"
@@ -342,6 +344,50 @@ ConsoleMethod(GuiCanvas, getUseBackgroundColor, bool, 2, 2, "Gets whether the ca
     return object->getUseBackgroundColor();
 }
 
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(GuiCanvas, setUseDrawLists, void, 3, 3, "Sets whether controls that allow it replay cached draw lists instead of rendering every frame.\n"
+                                                      "@param useDrawLists Whether to use draw lists or not.\n"
+                                                      "@return No return value." )
+{
+    // Fetch flag.
+    const bool useDrawLists = dAtob(argv[2]);
+
+    // Set the flag.
+    object->setUseDrawLists( useDrawLists );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(GuiCanvas, getUseDrawLists, bool, 2, 2, "Gets whether the canvas uses draw lists or not.\n"
+                                                      "@return Whether the canvas uses draw lists or not." )
+{
+    // Get the flag.
+    return object->getUseDrawLists();
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(GuiCanvas, setUseDirtyRegions, void, 3, 3, "Sets whether the canvas only repaints its dirty regions.\n"
+                                                         "@param useDirtyRegions Whether to use dirty regions or not.\n"
+                                                         "@return No return value." )
+{
+    // Fetch flag.
+    const bool useDirtyRegions = dAtob(argv[2]);
+
+    // Set the flag.
+    object->setUseDirtyRegions( useDirtyRegions );
+}
+
+//-----------------------------------------------------------------------------
+
+ConsoleMethod(GuiCanvas, getUseDirtyRegions, bool, 2, 2, "Gets whether the canvas only repaints its dirty regions.\n"
+                                                         "@return Whether the canvas uses dirty regions or not." )
+{
+    // Get the flag.
+    return object->getUseDirtyRegions();
+}
+
 
 ConsoleFunction( createCanvas, bool, 2, 2, "( WindowTitle ) Use the createCanvas function to initialize the canvas.\n"
                                                                 "@return Returns true on success, false on failure.\n"
@@ -408,6 +454,15 @@ ConsoleFunction(screenShot, void, 3, 3, "(string file, string format)"
 }
 
 
+//------------------------------------------------------------------------------
+
+static void textureEventCallback(const TextureManager::TextureEventCode eventCode, void *userData)
+{
+   // The frame copy is a raw GL texture so it has to be released with the context.
+   if (eventCode == TextureManager::BeginZombification)
+      static_cast<GuiCanvas*>(userData)->releaseFrameCopy();
+}
+
 GuiCanvas::GuiCanvas()
 {
 #ifdef TORQUE_OS_IOS
@@ -460,10 +515,21 @@ GuiCanvas::GuiCanvas()
     /// Background color.
     mBackgroundColor.set( 0.0f, 0.0f, 0.0f, 0.0f );
     mUseBackgroundColor = true;
+
+   mUseDrawLists = false;
+   mUseDirtyRegions = false;
+   mFrameCopyTexture = 0;
+   mFrameCopySize.set(0, 0);
+   mFrameCopyTextureSize.set(0, 0);
+   mFrameCopyValid = false;
+   mTextureEventKey = TextureManager::registerEventCallback(textureEventCallback, this);
 }
 
 GuiCanvas::~GuiCanvas()
 {
+   TextureManager::unregisterEventCallback(mTextureEventKey);
+   releaseFrameCopy();
+
    if(Canvas == this)
       Canvas = 0;
 }
@@ -479,6 +545,10 @@ void GuiCanvas::initPersistFields()
     // Physics.
     addField("UseBackgroundColor", TypeBool, Offset(mUseBackgroundColor, GuiCanvas), "" );
     addField("BackgroundColor", TypeColorF, Offset(mBackgroundColor, GuiCanvas), "" );
+
+    // Retained rendering.
+    addField("UseDrawLists", TypeBool, Offset(mUseDrawLists, GuiCanvas), "" );
+    addField("UseDirtyRegions", TypeBool, Offset(mUseDirtyRegions, GuiCanvas), "" );
 }
 
 //------------------------------------------------------------------------------
@@ -1555,9 +1625,25 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    if(preRenderOnly)
       return;
 
-   // for now, just always reset the update regions - this is a
-   // fix for FSAA on ATI cards
-   resetUpdateRegions();
+   GuiControl::smUseDrawLists = mUseDrawLists;
+
+   // The back buffer is undefined after a swap so partial repaints
+   // start from a copy of the last frame.
+   const bool useDirtyRegions = mUseDirtyRegions && !mRenderFront && prepareFrameCopy(size);
+   if(!useDirtyRegions)
+      releaseFrameCopy();
+
+   const bool partialRepaint = useDirtyRegions && mFrameCopyValid;
+   if(partialRepaint)
+   {
+      addVolatileUpdateRegions(this, Point2I(0, 0));
+   }
+   else
+   {
+      // for now, just always reset the update regions - this is a
+      // fix for FSAA on ATI cards
+      resetUpdateRegions();
+   }
 
 // Moved this below object integration for performance reasons. -JDD
 //   // finish the gl render so we don't get too far ahead of ourselves
@@ -1606,11 +1692,17 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    buildUpdateUnion(&updateUnion);
    if (updateUnion.intersect(screenRect))
    {
+      if(partialRepaint)
+         restoreFrameCopy();
+
     // Clear the background color if requested.
     if ( mUseBackgroundColor )
     {
         glClearColor( mBackgroundColor.red, mBackgroundColor.green, mBackgroundColor.blue, mBackgroundColor.alpha );
+        glScissor( updateUnion.point.x, size.y - (updateUnion.point.y + updateUnion.extent.y), updateUnion.extent.x, updateUnion.extent.y );
+        glEnable( GL_SCISSOR_TEST );
         glClear(GL_COLOR_BUFFER_BIT);	
+        glDisable( GL_SCISSOR_TEST );
     }
 
       //render the dialogs
@@ -1620,8 +1712,13 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          GuiControl *contentCtrl = static_cast<GuiControl*>(*i);
          dglSetClipRect(updateUnion);
          glDisable( GL_CULL_FACE );
-         contentCtrl->onRender(contentCtrl->getPosition(), updateUnion);
+         contentCtrl->renderControl(contentCtrl->getPosition(), updateUnion);
       }
+      DGLDrawList::flushStream();
+
+      // The tooltip and cursor are drawn after the copy so they never end up in it.
+      if(useDirtyRegions)
+         captureFrameCopy(updateUnion);
 
       // Tooltip resource
       if(bool(mMouseControl))
@@ -1694,6 +1791,10 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          mouseCursor->render(pos);
       }
    }
+   else if(partialRepaint)
+   {
+      restoreFrameCopy();
+   }
 
    PROFILE_END();
 
@@ -1769,6 +1870,138 @@ void GuiCanvas::addUpdateRegion(Point2I pos, Point2I ext)
    }
 }
 
+//------------------------------------------------------------------------------
+
+void GuiCanvas::addVolatileUpdateRegions(GuiControl* pControl, const Point2I& offset)
+{
+   for(iterator i = pControl->begin(); i != pControl->end(); i++)
+   {
+      GuiControl *ctrl = static_cast<GuiControl *>(*i);
+      if(!ctrl->isVisible())
+         continue;
+
+      // Children are clipped to their parent so a volatile control covers them.
+      const Point2I position = offset + ctrl->getPosition();
+      if(!ctrl->canCacheRender())
+         addUpdateRegion(position, ctrl->getExtent());
+      else
+         addVolatileUpdateRegions(ctrl, position);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool GuiCanvas::prepareFrameCopy(const Point2I& size)
+{
+   if(mFrameCopyTexture != 0 && mFrameCopySize == size)
+      return true;
+
+   releaseFrameCopy();
+
+   const Point2I textureSize(getNextPow2(size.x), getNextPow2(size.y));
+
+   GLint maxTextureSize = 0;
+   glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+   if(textureSize.x > maxTextureSize || textureSize.y > maxTextureSize)
+      return false;
+
+   GLuint textureName = 0;
+   glGenTextures(1, &textureName);
+   glBindTexture(GL_TEXTURE_2D, textureName);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureSize.x, textureSize.y, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+   glBindTexture(GL_TEXTURE_2D, 0);
+
+   mFrameCopyTexture = textureName;
+   mFrameCopySize = size;
+   mFrameCopyTextureSize = textureSize;
+   mFrameCopyValid = false;
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void GuiCanvas::releaseFrameCopy()
+{
+   if(mFrameCopyTexture != 0)
+   {
+      GLuint textureName = mFrameCopyTexture;
+      glDeleteTextures(1, &textureName);
+   }
+
+   mFrameCopyTexture = 0;
+   mFrameCopySize.set(0, 0);
+   mFrameCopyTextureSize.set(0, 0);
+   mFrameCopyValid = false;
+}
+
+//------------------------------------------------------------------------------
+
+void GuiCanvas::restoreFrameCopy()
+{
+   dglSetClipRect(RectI(0, 0, mFrameCopySize.x, mFrameCopySize.y));
+
+   glDisable(GL_BLEND);
+   glDisable(GL_LIGHTING);
+   glEnable(GL_TEXTURE_2D);
+   glBindTexture(GL_TEXTURE_2D, mFrameCopyTexture);
+   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+
+   // GL rows run bottom up so the top of the window is the last copied row.
+   const GLfloat width = (GLfloat)mFrameCopySize.x;
+   const GLfloat height = (GLfloat)mFrameCopySize.y;
+   const GLfloat u = width / (GLfloat)mFrameCopyTextureSize.x;
+   const GLfloat v = height / (GLfloat)mFrameCopyTextureSize.y;
+
+   const GLfloat vertices[] = {
+      0.0f,  0.0f,
+      width, 0.0f,
+      0.0f,  height,
+      width, height,
+   };
+   const GLfloat texVerts[] = {
+      0.0f, v,
+      u,    v,
+      0.0f, 0.0f,
+      u,    0.0f,
+   };
+
+   glDisableClientState(GL_COLOR_ARRAY);
+   glEnableClientState(GL_VERTEX_ARRAY);
+   glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+   glVertexPointer(2, GL_FLOAT, 0, vertices);
+   glTexCoordPointer(2, GL_FLOAT, 0, texVerts);
+   glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+   glDisableClientState(GL_VERTEX_ARRAY);
+   glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+   glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+   glBindTexture(GL_TEXTURE_2D, 0);
+   glDisable(GL_TEXTURE_2D);
+}
+
+//------------------------------------------------------------------------------
+
+void GuiCanvas::captureFrameCopy(const RectI& rect)
+{
+#ifndef TORQUE_OS_IOS
+   glReadBuffer(GL_BACK);
+#endif
+
+   // Window coordinates have their origin at the bottom left.
+   const S32 y = mFrameCopySize.y - (rect.point.y + rect.extent.y);
+
+   glBindTexture(GL_TEXTURE_2D, mFrameCopyTexture);
+   glCopyTexSubImage2D(GL_TEXTURE_2D, 0, rect.point.x, y, rect.point.x, y, rect.extent.x, rect.extent.y);
+   glBindTexture(GL_TEXTURE_2D, 0);
+
+   mFrameCopyValid = true;
+}
+
+//------------------------------------------------------------------------------
+
 void GuiCanvas::resetUpdateRegions()
 {
    //DEBUG - get surface width and height
@@ -72,6 +72,14 @@
 /// screen will be painted normally. If you are making an animated GuiControl
 /// you need to add your control to the dirty areas of the canvas.
 ///
+/// By default the whole canvas is still repainted every frame. Setting
+/// UseDirtyRegions keeps a copy of the last frame in a texture so that only
+/// the dirty areas are repainted. Controls that cannot report their own changes
+/// (see GuiControl::canCacheRender()) are treated as dirty every frame.
+///
+/// Setting UseDrawLists lets audited controls record their rendering once and
+/// replay it until they are marked dirty with GuiControl::setUpdate().
+///
 class GuiCanvas : public GuiControl
 {
 
@@ -91,6 +99,27 @@ protected:
    RectI      mOldUpdateRects[2];
    RectI      mCurUpdateRect;
    F32        rLastFrameTime;
+
+   bool       mUseDrawLists;          ///< Replay cached draw lists for controls that allow it.
+   bool       mUseDirtyRegions;       ///< Only repaint the dirty areas of the canvas.
+   U32        mFrameCopyTexture;      ///< Copy of the last frame used to restore the clean areas.
+   Point2I    mFrameCopySize;         ///< Window size the frame copy was created for.
+   Point2I    mFrameCopyTextureSize;  ///< Power of two size of the frame copy texture.
+   bool       mFrameCopyValid;        ///< True once the frame copy holds a complete frame.
+   U32        mTextureEventKey;
+
+   /// Marks the areas of controls that cannot be cached as dirty.
+   void addVolatileUpdateRegions(GuiControl* pControl, const Point2I& offset);
+
+   /// Makes sure the frame copy matches the window size.
+   /// @return False if the frame copy cannot be used.
+   bool prepareFrameCopy(const Point2I& size);
+
+   /// Draws the frame copy over the whole window.
+   void restoreFrameCopy();
+
+   /// Copies an area of the back buffer into the frame copy.
+   void captureFrameCopy(const RectI& rect);
    /// @}
 
    /// @name Cursor Properties
@@ -179,6 +208,15 @@ public:
     inline void             setUseBackgroundColor( const bool useBackgroundColor ) { mUseBackgroundColor = useBackgroundColor; }
     inline bool             getUseBackgroundColor( void ) const         { return mUseBackgroundColor; }
 
+    /// Retained rendering.
+    inline void             setUseDrawLists( const bool useDrawLists )  { mUseDrawLists = useDrawLists; resetUpdateRegions(); }
+    inline bool             getUseDrawLists( void ) const               { return mUseDrawLists; }
+    inline void             setUseDirtyRegions( const bool useDirtyRegions ) { mUseDirtyRegions = useDirtyRegions; resetUpdateRegions(); }
+    inline bool             getUseDirtyRegions( void ) const            { return mUseDirtyRegions; }
+
+    /// Releases the frame copy used by dirty region rendering.
+    void                    releaseFrameCopy( void );
+
    /// @name Rendering methods
    ///
    /// @{
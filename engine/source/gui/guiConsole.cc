@@ -34,6 +34,7 @@ GuiConsole::GuiConsole()
    mBounds.extent.set(64, 64);
    mCellSize.set(1, 1);
    mSize.set(1, 0);
+   mMeasuredEntries = 0;
 }
 
 bool GuiConsole::onWake()
@@ -44,6 +45,9 @@ bool GuiConsole::onWake()
    //get the font
    mFont = mProfile->mFont;
 
+   // The font may have changed so measure everything again.
+   mMeasuredEntries = 0;
+
    return true;
 }
 
@@ -89,8 +93,11 @@ void GuiConsole::onPreRender()
       if(parent)
          scrolled = parent->isScrolledToBottom();
 
-      //find the max cell width for the new entries
-      S32 newMax = getMaxWidth(0, size - 1);
+      //find the max cell width for the new entries, the log only grows until it is cleared
+      if(size < mMeasuredEntries)
+         mMeasuredEntries = 0;
+      S32 newMax = getMaxWidth(mMeasuredEntries, size - 1);
+      mMeasuredEntries = size;
       if(newMax > mCellSize.x)
          mCellSize.set(newMax, mFont->getHeight());
 
@@ -34,6 +34,9 @@ class GuiConsole : public GuiArrayCtrl
 
       Resource<GFont> mFont;
 
+      /// Number of log entries already included in the cell width.
+      U32 mMeasuredEntries;
+
       S32 getMaxWidth(S32 startIndex, S32 endIndex);
 
    public:
@@ -51,6 +51,7 @@ GuiControl *GuiControl::smCurResponder = NULL;
 GuiEditCtrl *GuiControl::smEditorHandle = NULL;
 
 bool GuiControl::smDesignTime = false;
+bool GuiControl::smUseDrawLists = false;
 
 GuiControl::GuiControl()
 {
@@ -81,6 +82,12 @@ GuiControl::GuiControl()
    mTooltipWidth		= 250;
    mIsContainer         = false;
 
+   mDrawListOffset.set(0, 0);
+   mDrawListUpdateRect.set(0, 0, 0, 0);
+   mDrawListProfileRevision = 0;
+   mDrawListValid       = false;
+   mDrawListRecording   = false;
+
    mNSLinkMask = LinkSuperClassName | LinkClassName;
 }
 
@@ -289,6 +296,14 @@ void GuiControl::inspectPreApply()
    }
 }
 
+void GuiControl::onStaticModified(const char* slotName, const char* newValue)
+{
+   Parent::onStaticModified(slotName, newValue);
+
+   // Fields can change what onRender() draws without going through setUpdate().
+   invalidateDrawList();
+}
+
 void GuiControl::inspectPostApply()
 {
    // Shhhhhhh, you don't want to wake the canvas!
@@ -615,7 +630,99 @@ bool GuiControl::renderTooltip(Point2I cursorPos, const char* tipText )
     return true;
 }
 
+void GuiControl::renderControl(Point2I offset, const RectI &updateRect)
+{
+   if (!smUseDrawLists || !canCacheRender())
+   {
+      // Anything queued so far has to reach the screen before this draws.
+      DGLDrawList::flushStream();
+      onRender(offset, updateRect);
+      return;
+   }
+
+   ColorI modulation;
+   ColorI anchorColor;
+   dglGetBitmapModulation(&modulation);
+   dglGetTextAnchorColor(&anchorColor);
+   const U32 profileRevision = mProfile ? mProfile->mRevision : 0;
+
+   // Replay the recording if nothing it depended on has changed.
+   if (mDrawListValid && offset == mDrawListOffset && updateRect == mDrawListUpdateRect &&
+       modulation == mDrawListModulation[0] && anchorColor == mDrawListAnchorColor[0] &&
+       profileRevision == mDrawListProfileRevision)
+   {
+      U32 batch = 0;
+      for (S32 i = 0; i < mDrawListChildren.size(); i++)
+      {
+         const DrawListChildren &children = mDrawListChildren[i];
+         mDrawList.submit(batch, children.mBatch);
+         renderChildren(children.mOffset, children.mUpdateRect);
+         batch = children.mBatch;
+      }
+      mDrawList.submit(batch, mDrawList.getBatchCount());
+
+      dglSetBitmapModulation(mDrawListModulation[1]);
+      dglSetTextAnchorColor(mDrawListAnchorColor[1]);
+      return;
+   }
+
+   // Record onRender() and queue what it drew.  A setUpdate() from within onRender()
+   // leaves the recording invalid.
+   mDrawList.clear();
+   mDrawListChildren.clear();
+   mDrawListValid = true;
+
+   mDrawListRecording = true;
+   dglSetDrawList(&mDrawList);
+   onRender(offset, updateRect);
+   dglSetDrawList(NULL);
+   mDrawListRecording = false;
+
+   mDrawList.submitPending();
+
+   mDrawListOffset = offset;
+   mDrawListUpdateRect = updateRect;
+   mDrawListModulation[0] = modulation;
+   mDrawListAnchorColor[0] = anchorColor;
+   mDrawListProfileRevision = profileRevision;
+   dglGetBitmapModulation(&mDrawListModulation[1]);
+   dglGetTextAnchorColor(&mDrawListAnchorColor[1]);
+
+   if (mDrawList.isVolatile())
+      mDrawListValid = false;
+}
+
+bool GuiControl::canCacheRender() const
+{
+   // Only a plain GuiControl; derived classes draw differently and have to opt in.
+   return getClassRep() == getStaticClassRep();
+}
+
 void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
+{
+   if (mDrawListRecording)
+   {
+      // Queue what has been recorded so far and remember where the children go.
+      // They record into their own draw lists.
+      DrawListChildren children;
+      children.mBatch = mDrawList.submitPending();
+      children.mOffset = offset;
+      children.mUpdateRect = updateRect;
+      mDrawListChildren.push_back(children);
+
+      dglSetDrawList(NULL);
+      renderChildren(offset, updateRect);
+      dglSetDrawList(&mDrawList);
+      return;
+   }
+
+   renderChildren(offset, updateRect);
+
+   // The caller may go on to draw with GL directly.
+   DGLDrawList::flushStream();
+}
+
+void GuiControl::renderChildren(Point2I offset, const RectI &updateRect)
 {
    // offset is the upper-left corner of this control in screen coordinates
    // updateRect is the intersection rectangle in screen coords of the control
@@ -642,7 +749,7 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
          {
             dglSetClipRect(childClip);
             glDisable(GL_CULL_FACE);
-            ctrl->onRender(childPosition, childClip);
+            ctrl->renderControl(childPosition, childClip);
          }
       }
       size_cpy = objectList.size(); //	CHRIS: i know its wierd but the size of the list changes sometimes during execution of this loop
@@ -656,6 +763,8 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
 
 void GuiControl::setUpdateRegion(Point2I pos, Point2I ext)
 {
+   invalidateDrawList();
+
    Point2I upos = localToGlobalCoord(pos);
    GuiCanvas *root = getRoot();
    if (root)
@@ -831,6 +940,12 @@ void GuiControl::onSleep()
    if( isMethod("onSleep") )
       Con::executef(this, 1, "onSleep");
 
+   // Release the draw list and the textures it holds.  Anything it queued is drawn first.
+   DGLDrawList::flushStream();
+   mDrawList.clear();
+   mDrawListChildren.clear();
+   mDrawListValid = false;
+
    // Set Flag
    mAwake = false;
 }
@@ -846,6 +961,7 @@ void GuiControl::setControlProfile(GuiControlProfile *prof)
    if(mAwake)
       mProfile->incRefCount();
 
+   setUpdate();
 }
 
 void GuiControl::onPreRender()
@@ -51,6 +51,9 @@
 #ifndef _LANG_H_
 #include "gui/language/lang.h"
 #endif
+#ifndef _DGL_DRAW_LIST_H_
+#include "graphics/dglDrawList.h"
+#endif
 class GuiCanvas;
 class GuiEditCtrl;
 
@@ -168,6 +171,35 @@ protected:
 
     /// @}
 
+    /// @name Retained Rendering
+    /// A control that can cache its rendering records what its onRender() draws and
+    /// replays it every frame until setUpdate() is called or it moves.  Child controls
+    /// are not part of the recording; the points where onRender() renders them are.
+    /// @{
+
+    struct DrawListChildren
+    {
+        U32     mBatch;         ///< Batches recorded before the children were rendered.
+        Point2I mOffset;
+        RectI   mUpdateRect;
+    };
+
+    DGLDrawList                 mDrawList;
+    Vector<DrawListChildren>    mDrawListChildren;
+    Point2I                     mDrawListOffset;
+    RectI                       mDrawListUpdateRect;
+    ColorI                      mDrawListModulation[2];     ///< Bitmap modulation before and after onRender().
+    ColorI                      mDrawListAnchorColor[2];    ///< Text anchor color before and after onRender().
+    U32                         mDrawListProfileRevision;   ///< Revision of the profile at the time of recording.
+    bool                        mDrawListValid;
+    bool                        mDrawListRecording;
+
+    static bool smUseDrawLists; ///< Set by the canvas while it renders with draw lists.
+
+    /// Renders the children with no draw list bookkeeping.
+    void renderChildren(Point2I offset, const RectI &updateRect);
+    /// @}
+
     /// @name Console
     /// The console variable collection of functions allows a console variable to be bound to the GUI control.
     ///
@@ -388,6 +420,19 @@ public:
     /// @param   updateRect   The screen area this control has drawing access to
     void renderChildControls(Point2I offset, const RectI &updateRect);
 
+    /// Renders this control, replaying its recorded draw list when it is still valid
+    /// @param   offset   The location this control is to begin rendering
+    /// @param   updateRect   The screen area this control has drawing access to
+    void renderControl(Point2I offset, const RectI &updateRect);
+
+    /// Returns true if onRender() only draws through dgl and every change to what it
+    /// draws calls setUpdate().  Such controls can be replayed from a draw list and
+    /// are left alone by dirty region repaints.  Derived classes must opt in themselves.
+    virtual bool canCacheRender() const;
+
+    /// Discards the recorded draw list so that the next frame calls onRender()
+    inline void invalidateDrawList() { mDrawListValid = false; }
+
     /// Sets the area (local coordinates) this control wants refreshed each frame
     /// @param   pos   UpperLeft point on rectangle of refresh area
     /// @param   ext   Extent of update rect
@@ -663,6 +708,7 @@ public:
 
     void inspectPostApply();
     void inspectPreApply();
+    virtual void onStaticModified(const char* slotName, const char* newValue = NULL);
 };
 /// @}
 
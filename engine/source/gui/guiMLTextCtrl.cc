@@ -266,7 +266,12 @@ void GuiMLTextCtrl::drawAtomText(bool sel, U32 start, U32 end, Atom *atom, Line
    {
       drawPoint.y += atom->baseLine + 2;
       Point2I p2 = drawPoint;
-      p2.x += font->getStrNWidthPrecise(tmp, end - atom->textStart);
+
+      // Whole atoms were already measured by reflow().
+      if(start == atom->textStart && end == atom->textStart + atom->len && !atom->isClipped)
+         p2.x += atom->width;
+      else
+         p2.x += font->getStrNWidthPrecise(tmp, end - atom->textStart);
       dglDrawLine(drawPoint, p2, color);
    }
 }
@@ -227,6 +227,11 @@ void GuiTextCtrl::onRender(Point2I offset, const RectI &updateRect)
     renderChildControls(offset, updateRect);
 }
 
+bool GuiTextCtrl::canCacheRender() const
+{
+    return getClassRep() == getStaticClassRep();
+}
+
 // -=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=- //
 
 const char *GuiTextCtrl::getScriptValue()
@@ -83,6 +83,7 @@ public:
    //rendering methods
    void onPreRender();
    void onRender(Point2I offset, const RectI &updateRect);
+   bool canCacheRender() const;
    void displayText( S32 xOffset, S32 yOffset );
 
    //Console methods
@@ -78,6 +78,8 @@ GuiTextListCtrl::GuiTextListCtrl()
    mColumnOffsets.push_back(0);
    mFitParentWidth = true;
    mClipColumnText = false;
+   mMaxRowWidth = 1;
+   mRowWidthDirty = false;
 }
 
 void GuiTextListCtrl::initPersistFields()
@@ -303,10 +305,21 @@ bool GuiTextListCtrl::onWake()
    if(!Parent::onWake())
       return false;
 
+   // The font may have changed while we were asleep.
+   mRowWidthDirty = true;
    setSize(mSize);
    return true;
 }
 
+void GuiTextListCtrl::onStaticModified(const char* slotName, const char* newValue)
+{
+   Parent::onStaticModified(slotName, newValue);
+
+   // New column offsets change every row's width.
+   if(!dStricmp(slotName, "columns"))
+      mRowWidthDirty = true;
+}
+
 U32 GuiTextListCtrl::getSelectedId()
 {
    if (mSelectedCell.y == -1)
@@ -405,6 +418,31 @@ U32 GuiTextListCtrl::getRowWidth(Entry *row)
    return width;
 }
 
+void GuiTextListCtrl::addRowWidth(Entry *row)
+{
+   if ( mRowWidthDirty )
+      return;
+
+   // Without a font we can't measure, so pick it up on the next full scan.
+   if ( !bool( mFont ) )
+   {
+      mRowWidthDirty = true;
+      return;
+   }
+
+   mMaxRowWidth = getMax( mMaxRowWidth, (S32)getRowWidth( row ) );
+}
+
+void GuiTextListCtrl::removeRowWidth(Entry *row)
+{
+   if ( mRowWidthDirty )
+      return;
+
+   // Only losing the widest row can shrink the cells.
+   if ( !bool( mFont ) || (S32)getRowWidth( row ) >= mMaxRowWidth )
+      mRowWidthDirty = true;
+}
+
 void GuiTextListCtrl::insertEntry(U32 id, const char *text, S32 index)
 {
    Entry e;
@@ -421,6 +459,7 @@ void GuiTextListCtrl::insertEntry(U32 id, const char *text, S32 index)
       mList.insert(index);
       mList[index] = e;
    }
+   addRowWidth(&e);
    setSize(Point2I(1, mList.size()));
 }
 
@@ -431,6 +470,7 @@ void GuiTextListCtrl::addEntry(U32 id, const char *text)
    e.id = id;
    e.active = true;
    mList.push_back(e);
+   addRowWidth(&e);
    setSize(Point2I(1, mList.size()));
 }
 
@@ -441,8 +481,10 @@ void GuiTextListCtrl::setEntry(U32 id, const char *text)
       addEntry(id, text);
    else
    {
+      removeRowWidth(&mList[e]);
       dFree(mList[e].text);
       mList[e].text = dStrdup(text);
+      addRowWidth(&mList[e]);
 
       // Still have to call this to make sure cells are wide enough for new values:
       setSize( Point2I( 1, mList.size() ) );
@@ -508,16 +550,21 @@ void GuiTextListCtrl::setSize(Point2I newSize)
       }
       else
       {
-         // Find the maximum width cell:
-         S32 maxWidth = 1;
-         for ( U32 i = 0; i < (U32)mList.size(); i++ )
+         // Find the maximum width cell, only rescanning the rows when the
+         // running maximum can't be trusted:
+         if ( mRowWidthDirty )
          {
-            U32 rWidth = getRowWidth( &mList[i] );
-            if ( rWidth > (U32)maxWidth )
-               maxWidth = rWidth;
+            mMaxRowWidth = 1;
+            for ( U32 i = 0; i < (U32)mList.size(); i++ )
+            {
+               U32 rWidth = getRowWidth( &mList[i] );
+               if ( rWidth > (U32)mMaxRowWidth )
+                  mMaxRowWidth = rWidth;
+            }
+            mRowWidthDirty = false;
          }
 
-         mCellSize.x = maxWidth + 8;
+         mCellSize.x = mMaxRowWidth + 8;
       }
 
       mCellSize.y = mFont->getHeight() + 2;
@@ -529,8 +576,15 @@ void GuiTextListCtrl::setSize(Point2I newSize)
 
 void GuiTextListCtrl::clear()
 {
-   while (mList.size())
-      removeEntry(mList[0].id);
+   // Free everything in one pass rather than removing (and re-laying out)
+   // one row at a time.
+   for ( U32 i = 0; i < (U32)mList.size(); i++ )
+      dFree( mList[i].text );
+
+   mList.clear();
+   mMaxRowWidth = 1;
+   mRowWidthDirty = false;
+   setSize( Point2I( 1, 0 ) );
 
    mMouseOverCell.set( -1, -1 );
    setSelectedCell(Point2I(-1, -1));
@@ -570,6 +624,7 @@ void GuiTextListCtrl::removeEntryByIndex(S32 index)
 {
    if(index < 0 || index >= mList.size())
       return;
+   removeRowWidth(&mList[index]);
    dFree(mList[index].text);
    mList.erase(index);
 
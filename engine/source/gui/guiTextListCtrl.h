@@ -59,7 +59,14 @@ class GuiTextListCtrl : public GuiArrayCtrl
    bool  mFitParentWidth;
    bool  mClipColumnText;
 
+   /// Widest row measured so far.  Rows are measured once as they are added
+   /// so populating a long list doesn't rescan every row on each insert.
+   S32   mMaxRowWidth;
+   bool  mRowWidthDirty;
+
    U32 getRowWidth(Entry *row);
+   void addRowWidth(Entry *row);
+   void removeRowWidth(Entry *row);
    void onCellSelected(Point2I cell);
 
   public:
@@ -71,6 +78,8 @@ class GuiTextListCtrl : public GuiArrayCtrl
    virtual void setCellSize( const Point2I &size ){ mCellSize = size; }
    virtual void getCellSize(       Point2I &size ){ size = mCellSize; }
 
+   virtual void onStaticModified(const char* slotName, const char* newValue = NULL);
+
    const char *getScriptValue();
    void setScriptValue(const char *value);
 
@@ -103,8 +112,8 @@ class GuiTextListCtrl : public GuiArrayCtrl
 
    void setSize(Point2I newSize);
    void onRemove();
-   void addColumnOffset(S32 offset) { mColumnOffsets.push_back(offset); }
-   void clearColumnOffsets() { mColumnOffsets.clear(); }
+   void addColumnOffset(S32 offset) { mColumnOffsets.push_back(offset); mRowWidthDirty = true; }
+   void clearColumnOffsets() { mColumnOffsets.clear(); mRowWidthDirty = true; }
 };
 
 #endif //_GUI_TEXTLIST_CTRL_H
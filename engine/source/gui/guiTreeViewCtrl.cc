@@ -358,6 +358,7 @@ GuiTreeViewCtrl::GuiTreeViewCtrl()
 
    mItemFreeList  =  NULL;
    mRoot          =  NULL;
+   mLastInserted  =  NULL;
    mInstantGroup  =  0;
    mItemCount     =  0;
    mSelectedItem  =  0;
@@ -546,6 +547,9 @@ void GuiTreeViewCtrl::destroyItem(Item * item)
    // remove from vector
    mItems[item->mId-1] = 0;
 
+   if( item == mLastInserted )
+      mLastInserted = NULL;
+
    // set as root free item
    item->mNext = mItemFreeList;
    mItemFreeList = item;
@@ -585,6 +589,7 @@ void GuiTreeViewCtrl::destroyTree()
 
    //
    mRoot          = NULL;
+   mLastInserted  = NULL;
    mItemFreeList  = NULL;
    mItemCount     = 0;
    mSelectedItem  = 0;
@@ -618,7 +623,12 @@ void GuiTreeViewCtrl::buildItem( Item* item, U32 tabLevel, bool bForceFullUpdate
 
    if ( mProfile != NULL && !mProfile->mFont.isNull() )
    {
-      S32 width = ( tabLevel + 1 ) * mTabSize + item->getDisplayTextWidth(mProfile->mFont);
+      // Script items are measured when their text is set, so only inspector
+      // items (whose text follows their object's name) need measuring here.
+      if ( item->isInspectorData() || item->mDataRenderWidth <= 0 )
+         item->mDataRenderWidth = item->getDisplayTextWidth(mProfile->mFont);
+
+      S32 width = ( tabLevel + 1 ) * mTabSize + item->mDataRenderWidth;
       if ( mProfile->mBitmapArrayRects.size() > 0 )
          width += mProfile->mBitmapArrayRects[0].extent.x;
       
@@ -775,6 +785,14 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
    pNewItem->setNormalImage( (S8)normalImage );
    pNewItem->setExpandedImage( (S8)expandedImage );
 
+   // Scripts usually fill a branch in order, so the item we appended last is
+   // normally the tail we want; check it's still live and last in its list.
+   Item * pLastInserted = NULL;
+   if( mLastInserted != NULL && mLastInserted->mNext == NULL &&
+       mLastInserted->mId > 0 && mLastInserted->mId <= mItems.size() &&
+       mItems[mLastInserted->mId-1] == mLastInserted )
+      pLastInserted = mLastInserted;
+
    // root level?
    if(parentId == 0)
    {
@@ -782,6 +800,8 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
       if( mRoot != NULL )
       {
          Item * pTreeTraverse = mRoot;
+         if( pLastInserted != NULL && pLastInserted->mParent == NULL )
+            pTreeTraverse = pLastInserted;
          while( pTreeTraverse != NULL && pTreeTraverse->mNext != NULL )
             pTreeTraverse = pTreeTraverse->mNext;
 
@@ -801,6 +821,8 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
       if( pParentItem != NULL && pParentItem->mChild)
       {
          Item * pTreeTraverse = pParentItem->mChild;
+         if( pLastInserted != NULL && pLastInserted->mParent == pParentItem )
+            pTreeTraverse = pLastInserted;
          while( pTreeTraverse != NULL && pTreeTraverse->mNext != NULL )
             pTreeTraverse = pTreeTraverse->mNext;
 
@@ -816,10 +838,10 @@ S32 GuiTreeViewCtrl::insertItem(S32 parentId, const char * text, const char * va
          mFlags.set(RebuildVisible);
    }
 
-   //
-   if(mFlags.test(RebuildVisible))
-      buildVisibleTree();
+   mLastInserted = pNewItem;
 
+   // The visible rows are rebuilt lazily (see validateVisibleTree) so
+   // populating a large tree doesn't rebuild it after every insert.
    return pNewItem->mId;
 }
 
@@ -1182,7 +1204,7 @@ void GuiTreeViewCtrl::onPreRender()
 
    mTicksPassed++;
 
-   if( mTicksPassed > mTreeRefreshInterval ) 
+   if( mTicksPassed > mTreeRefreshInterval || mFlags.test( RebuildVisible ) )
    {
       // Update every render in case new objects are added
       buildVisibleTree();
@@ -1194,8 +1216,18 @@ void GuiTreeViewCtrl::onPreRender()
 
 //------------------------------------------------------------------------------
 
+void GuiTreeViewCtrl::validateVisibleTree()
+{
+   if( mFlags.test( RebuildVisible ) )
+      buildVisibleTree();
+}
+
+//------------------------------------------------------------------------------
+
 bool GuiTreeViewCtrl::hitTest(const Point2I & pnt, Item* & item, BitSet32 & flags)
 {
+   // Make sure the rows we index into are current.
+   validateVisibleTree();
 
    // Initialize some things.
    const Point2I pos = globalToLocalCoord(pnt);
@@ -1704,6 +1736,30 @@ bool GuiTreeViewCtrl::setItemExpanded(S32 itemId, bool expand)
 
       item->setExpanded(false);
    }
+
+   mFlags.set(RebuildVisible);
+   return(true);
+}
+
+bool GuiTreeViewCtrl::setItemVirtualParent(S32 itemId, bool virtualParent)
+{
+   Item * item = getItem(itemId);
+   if(!item)
+   {
+      Con::errorf(ConsoleLogEntry::General, "GuiTreeViewCtrl::setItemVirtualParent: invalid item id!");
+      return(false);
+   }
+
+   if(item->isInspectorData())
+   {
+      Con::errorf(ConsoleLogEntry::General, "GuiTreeViewCtrl::setItemVirtualParent: item %d is inspector data!", itemId);
+      return(false);
+   }
+
+   item->setVirtualParent(virtualParent);
+
+   // The expand button may have appeared or gone away.
+   mFlags.set(RebuildVisible);
    return(true);
 }
 
@@ -1770,13 +1826,17 @@ bool GuiTreeViewCtrl::editItem( S32 itemId, const char* newText, const char* new
       return false;
    }
 
+   // Copy before handing the strings over, the item measures its text as
+   // soon as it's set.
    delete [] item->getText();
-   item->setText (new char[dStrlen( newText ) + 1]);
-   dStrcpy( item->getText(), newText );
+   char *tmp = new char[dStrlen( newText ) + 1];
+   dStrcpy( tmp, newText );
+   item->setText( tmp );
 
    delete [] item->getValue();
-   item->setValue( new char[dStrlen( newValue ) + 1] );
-   dStrcpy( item->getValue(), newValue );
+   tmp = new char[dStrlen( newValue ) + 1];
+   dStrcpy( tmp, newValue );
+   item->setValue( tmp );
 
    // Update the widths and such:
    buildVisibleTree();
@@ -2864,7 +2924,12 @@ void GuiTreeViewCtrl::onMouseDown(const GuiEvent & event)
    {
       item->setExpanded(!item->isExpanded());
       if( !item->isInspectorData() && item->mState.test(Item::VirtualParent) )
-         onVirtualParentExpand(item);
+      {
+         if( item->isExpanded() )
+            onVirtualParentExpand(item);
+         else
+            onVirtualParentCollapse(item);
+      }
       scrollVisible(item);
    }
 }
@@ -3459,7 +3524,15 @@ bool GuiTreeViewCtrl::onVirtualParentBuild(Item *item, bool bForceFullUpdate)
 
 bool GuiTreeViewCtrl::onVirtualParentExpand(Item *item)
 {
-   // Do nothing...
+   // Script items flagged as virtual parents get their children on demand,
+   // the first time they're opened, so a large tree need only create the
+   // branches somebody actually looks at.
+   if( !item->isInspectorData() && item->mChild == NULL )
+   {
+      Con::executef(this, 2, "onVirtualParentExpand", Con::getIntArg(item->mId));
+      mFlags.set(RebuildVisible);
+   }
+
    return true;
 }
 
@@ -3648,6 +3721,13 @@ ConsoleMethod(GuiTreeViewCtrl, expandItem, bool, 3, 4, "(TreeItemId item, [bool
    return(object->setItemExpanded(id, expand));
 }
 
+ConsoleMethod(GuiTreeViewCtrl, setItemVirtualParent, bool, 4, 4, "(TreeItemId item, bool virtualParent) Flags an item as a virtual parent.\n"
+              "A virtual parent shows an expand button before it has any children and calls onVirtualParentExpand(%item) the first time it is opened, so its children can be inserted on demand.\n"
+              "@return Returns true on success, false if the item is invalid.")
+{
+   return object->setItemVirtualParent(dAtoi(argv[2]), dAtob(argv[3]));
+}
+
 // Make the given item visible.
 ConsoleMethod(GuiTreeViewCtrl, scrollVisible, void, 3, 3, "(TreeItemId item) Make the given item visible.\n"
               "@param ID of the desired item.\n"
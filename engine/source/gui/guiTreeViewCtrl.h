@@ -245,6 +245,9 @@ public:
                                              ///  item ids and do some other clever
                                              ///  things.
       Item *                  mRoot;
+      Item *                  mLastInserted; ///< Tail of the sibling list we last
+                                             ///  appended to, so building a long
+                                             ///  list doesn't walk it every insert.
       S32                     mInstantGroup;
       S32                     mMaxWidth;
       S32                     mSelectedItem;
@@ -299,6 +302,9 @@ protected:
 
       bool hitTest(const Point2I & pnt, Item* & item, BitSet32 & flags);
 
+      /// Rebuild the visible rows if an insert has flagged them stale.
+      void validateVisibleTree();
+
       virtual bool onVirtualParentBuild(Item *item, bool bForceFullUpdate = false);
       virtual bool onVirtualParentExpand(Item *item);
       virtual bool onVirtualParentCollapse(Item *item);
@@ -325,6 +331,7 @@ protected:
       /// Sets the flag of the item with the matching itemId.
       bool setItemSelected(S32 itemId, bool select);
       bool setItemExpanded(S32 itemId, bool expand);
+      bool setItemVirtualParent(S32 itemId, bool virtualParent);
       bool setItemValue(S32 itemId, StringTableEntry Value);
 
       const char * getItemText(S32 itemId);
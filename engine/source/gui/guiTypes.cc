@@ -29,6 +29,7 @@
 #include "graphics/gFont.h"
 #include "graphics/dgl.h"
 #include "gui/guiTypes.h"
+#include "gui/guiCanvas.h"
 #include "graphics/gBitmap.h"
 #include "graphics/TextureManager.h"
 
@@ -138,6 +139,7 @@ GuiControlProfile::GuiControlProfile(void) :
    mFontColorSEL(mFontColors[ColorSEL])
 {
     mRefCount = 0;
+    mRevision = 0;
     mBitmapArrayRects.clear();
     mMouseOverSelected = false;
     
@@ -276,6 +278,18 @@ bool GuiControlProfile::onAdd()
    return true;
 }
 
+void GuiControlProfile::onStaticModified(const char* slotName, const char* newValue)
+{
+   Parent::onStaticModified(slotName, newValue);
+
+   // Controls replaying a draw list compare this against the revision they recorded with.
+   mRevision++;
+
+   // Controls using this profile are not marked dirty, so repaint everything.
+   if (Canvas)
+      Canvas->resetUpdateRegions();
+}
+
 S32 GuiControlProfile::constructBitmapArray()
 {
    if(mBitmapArrayRects.size())
@@ -106,6 +106,7 @@ private:
 
 public:
    S32  mRefCount;                                 ///< Used to determine if any controls are using this profile
+   U32  mRevision;                                 ///< Incremented whenever a field is changed so that cached control rendering is recorded again
    bool mTabable;                                  ///< True if this object is accessable from using the tab key
 
    static StringTableEntry  sFontCacheDirectory;
@@ -183,6 +184,7 @@ public:
    ~GuiControlProfile();
    static void initPersistFields();
    bool onAdd();
+   virtual void onStaticModified(const char* slotName, const char* newValue = NULL);
 
    /// This method creates an array of bitmaps from one single bitmap with
    /// seperator color. The seperator color is whatever color is in pixel 0,0
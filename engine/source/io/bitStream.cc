@@ -28,6 +28,8 @@
 #include "math/mathIO.h"
 #include "platform/event.h"
 #include "console/consoleObject.h"
+#include "io/huffmanProcessor.h"
+#include "network/connectionStringDictionary.h"
 
 static BitStream gPacketStream(NULL, 0);
 static U8 gPacketBuffer[MaxPacketDataSize];
@@ -86,58 +88,13 @@ void ResizeBitStream::validate()
 }
 
 
-class HuffmanProcessor
-{
-   static const U32 csm_charFreqs[256];
-   bool   m_tablesBuilt;
-
-   void buildTables();
-
-   struct HuffNode {
-      U32 pop;
-
-      S16 index0;
-      S16 index1;
-   };
-   struct HuffLeaf {
-      U32 pop;
-
-      U8  numBits;
-      U8  symbol;
-      U32 code;   // no code should be longer than 32 bits.
-   };
-   // We have to be a bit careful with these, mSince they are pointers...
-   struct HuffWrap {
-      HuffNode* pNode;
-      HuffLeaf* pLeaf;
-
-     public:
-      HuffWrap() : pNode(NULL), pLeaf(NULL) { }
-
-      void set(HuffLeaf* in_leaf) { pNode = NULL; pLeaf = in_leaf; }
-      void set(HuffNode* in_node) { pLeaf = NULL; pNode = in_node; }
-
-      U32 getPop() { if (pNode) return pNode->pop; else return pLeaf->pop; }
-   };
-
-   Vector<HuffNode> m_huffNodes;
-   Vector<HuffLeaf> m_huffLeaves;
-
-   S16 determineIndex(HuffWrap&);
-
-   void generateCodes(BitStream&, S32, S32);
-
-  public:
-   HuffmanProcessor() : m_tablesBuilt(false) { }
-
-   static HuffmanProcessor g_huffProcessor;
-
-   bool readHuffBuffer(BitStream* pStream, char* out_pBuffer);
-   bool writeHuffBuffer(BitStream* pStream, const char* out_pBuffer, S32 maxLen);
-};
-
 HuffmanProcessor HuffmanProcessor::g_huffProcessor;
 
+HuffmanProcessor::HuffmanProcessor(const U32 *charFreqs) : m_tablesBuilt(false)
+{
+   dMemcpy(m_charFreqs, charFreqs ? charFreqs : csm_charFreqs, sizeof(m_charFreqs));
+}
+
 void BitStream::setBuffer(void *bufPtr, S32 size, S32 maxSize)
 {
    dataPtr = (U8 *) bufPtr;
@@ -584,25 +541,48 @@ void InfiniteBitStream::writeToStream(Stream &s)
 
 void BitStream::readString(char buf[256])
 {
+   HuffmanProcessor *huffman = &HuffmanProcessor::g_huffProcessor;
+
+   // strings the other side sent before may come from the dictionary
+   if(mStringDictionary)
+   {
+      if(mStringDictionary->readString(this, buf, &huffman))
+         return;
+   }
+
    if(stringBuffer)
    {
       if(readFlag())
       {
          S32 offset = readInt(8);
-         HuffmanProcessor::g_huffProcessor.readHuffBuffer(this, stringBuffer + offset);
+         huffman->readHuffBuffer(this, stringBuffer + offset);
          dStrcpy(buf, stringBuffer);
+         if(mStringDictionary)
+            mStringDictionary->readStringDone(buf);
          return;
       }
    }
-   HuffmanProcessor::g_huffProcessor.readHuffBuffer(this, buf);
+   huffman->readHuffBuffer(this, buf);
    if(stringBuffer)
       dStrcpy(stringBuffer, buf);
+   if(mStringDictionary)
+      mStringDictionary->readStringDone(buf);
 }
 
 void BitStream::writeString(const char *string, S32 maxLen)
 {
    if(!string)
       string = "";
+
+   HuffmanProcessor *huffman = &HuffmanProcessor::g_huffProcessor;
+
+   // strings the other side already has are sent as a dictionary index
+   if(mStringDictionary)
+   {
+      if(mStringDictionary->writeString(this, string, maxLen, &huffman))
+         return;
+   }
+
    if(stringBuffer)
    {
       S32 j;
@@ -614,11 +594,34 @@ void BitStream::writeString(const char *string, S32 maxLen)
       if(writeFlag(j > 2))
       {
          writeInt(j, 8);
-         HuffmanProcessor::g_huffProcessor.writeHuffBuffer(this, string + j, maxLen - j);
+         huffman->writeHuffBuffer(this, string + j, maxLen - j);
          return;
       }
    }
-   HuffmanProcessor::g_huffProcessor.writeHuffBuffer(this, string, maxLen);
+   huffman->writeHuffBuffer(this, string, maxLen);
+}
+
+void BitStream::writeVarU32(U32 value)
+{
+   // seven bits at a time, low bits first
+   while(writeFlag(value > 0x7F))
+   {
+      writeInt(value & 0x7F, 7);
+      value >>= 7;
+   }
+   writeInt(value, 7);
+}
+
+U32 BitStream::readVarU32()
+{
+   U32 value = 0;
+   U32 shift = 0;
+   while(readFlag() && shift < 28)
+   {
+      value |= U32(readInt(7)) << shift;
+      shift += 7;
+   }
+   return value | (U32(readInt(7)) << shift);
 }
 
 void HuffmanProcessor::buildTables()
@@ -636,7 +639,7 @@ void HuffmanProcessor::buildTables()
    for (i = 0; i < 256; i++) {
       HuffLeaf& rLeaf = m_huffLeaves[i];
 
-      rLeaf.pop    = csm_charFreqs[i] + 1;
+      rLeaf.pop    = m_charFreqs[i] + 1;
       rLeaf.symbol = U8(i);
 
       dMemset(&rLeaf.code, 0, sizeof(rLeaf.code));
@@ -46,6 +46,7 @@
 class Point3F;
 class MatrixF;
 class HuffmanProcessor;
+class ConnectionStringDictionary;
 
 class BitStream : public Stream
 {
@@ -57,6 +58,7 @@ protected:
    S32  maxReadBitNum;
    S32  maxWriteBitNum;
    char *stringBuffer;
+   ConnectionStringDictionary *mStringDictionary;
    bool mCompressRelative;
    Point3F mCompressPoint;
 
@@ -74,10 +76,15 @@ public:
    S32  getCurPos() const;
    void setCurPos(const U32);
 
-   BitStream(void *bufPtr, S32 bufSize, S32 maxWriteSize = -1) { setBuffer(bufPtr, bufSize,maxWriteSize); stringBuffer = NULL; }
+   BitStream(void *bufPtr, S32 bufSize, S32 maxWriteSize = -1) { setBuffer(bufPtr, bufSize,maxWriteSize); stringBuffer = NULL; mStringDictionary = NULL; }
    void clear();
 
    void setStringBuffer(char buffer[256]);
+
+   /// Sets the connection dictionary used to compress the strings read and
+   /// written with readString() and writeString(), or NULL for none.
+   void setStringDictionary(ConnectionStringDictionary *dictionary) { mStringDictionary = dictionary; }
+
    void writeInt(S32 value, S32 bitCount);
    S32  readInt(S32 bitCount);
 
@@ -126,6 +133,20 @@ public:
    void writeSignedInt(S32 value, S32 bitCount);
    S32  readSignedInt(S32 bitCount);
 
+   /// Writes an unsigned integer seven bits at a time, so small values take
+   /// fewer bits.  Values below 128 take 8 bits and the worst case is 40 bits.
+   void writeVarU32(U32 value);
+   U32  readVarU32();
+
+   /// Writes a signed integer with writeVarU32() after zigzag encoding it, so
+   /// that small negative values are as cheap as small positive ones.
+   void writeVarS32(S32 value) { writeVarU32(zigZagEncode(value)); }
+   S32  readVarS32()           { return zigZagDecode(readVarU32()); }
+
+   /// Maps signed integers to unsigned ones by magnitude: 0, -1, 1, -2, 2...
+   static U32 zigZagEncode(S32 value) { return (U32(value) << 1) ^ U32(value >> 31); }
+   static S32 zigZagDecode(U32 value) { return S32(value >> 1) ^ -S32(value & 1); }
+
    void writeRangedU32(U32 value, U32 rangeStart, U32 rangeEnd);
    U32  readRangedU32(U32 rangeStart, U32 rangeEnd);
    
@@ -193,6 +214,9 @@ public:
    bool isFull() { return bitNum > (bufSize << 3); }
    bool isValid() { return !error; }
 
+   /// Number of bits that can still be written before the stream is full.
+   S32  getBitSpaceAvailable() { return (bufSize << 3) - bitNum; }
+
    bool _read (const U32 size,void* d);
    bool _write(const U32 size,const void* d);
 
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _HUFFMANPROCESSOR_H_
+#define _HUFFMANPROCESSOR_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+class BitStream;
+
+/// Huffman coder used by BitStream::writeString() and BitStream::readString().
+///
+/// The shared processor uses a fixed character frequency table.  Other
+/// processors can be built from any frequency table, which is how the
+/// connection string dictionary adapts the coding to a connection's traffic.
+class HuffmanProcessor
+{
+   static const U32 csm_charFreqs[256];
+   U32    m_charFreqs[256];
+   bool   m_tablesBuilt;
+
+   void buildTables();
+
+   struct HuffNode {
+      U32 pop;
+
+      S16 index0;
+      S16 index1;
+   };
+   struct HuffLeaf {
+      U32 pop;
+
+      U8  numBits;
+      U8  symbol;
+      U32 code;   // no code should be longer than 32 bits.
+   };
+   // We have to be a bit careful with these, mSince they are pointers...
+   struct HuffWrap {
+      HuffNode* pNode;
+      HuffLeaf* pLeaf;
+
+     public:
+      HuffWrap() : pNode(NULL), pLeaf(NULL) { }
+
+      void set(HuffLeaf* in_leaf) { pNode = NULL; pLeaf = in_leaf; }
+      void set(HuffNode* in_node) { pLeaf = NULL; pNode = in_node; }
+
+      U32 getPop() { if (pNode) return pNode->pop; else return pLeaf->pop; }
+   };
+
+   Vector<HuffNode> m_huffNodes;
+   Vector<HuffLeaf> m_huffLeaves;
+
+   S16 determineIndex(HuffWrap&);
+
+   void generateCodes(BitStream&, S32, S32);
+
+  public:
+   /// @param  charFreqs   Character frequencies, or NULL for the default table.
+   HuffmanProcessor(const U32 *charFreqs = NULL);
+
+   static HuffmanProcessor g_huffProcessor;
+
+   bool readHuffBuffer(BitStream* pStream, char* out_pBuffer);
+   bool writeHuffBuffer(BitStream* pStream, const char* out_pBuffer, S32 maxLen);
+};
+
+#endif //_HUFFMANPROCESSOR_H_
@@ -34,6 +34,7 @@
 #include "io/zip/compressor.h"
 #include "io/zip/zipTempStream.h"
 #include "io/zip/zipStatFilter.h"
+#include "io/zip/zipSubStream.h"
 
 #ifdef TORQUE_ZIP_AES
 #include "core/zipAESCryptStream.h"
@@ -58,7 +59,8 @@ ZipArchive::ZipArchive()
 
    mFilename = NULL;
 
-   mRoot = NULL;
+   mImage = NULL;
+   mImageSize = 0;
 }
 
 ZipArchive::~ZipArchive()
@@ -72,12 +74,7 @@ ZipArchive::~ZipArchive()
 
 bool ZipArchive::readCentralDirectory()
 {
-   mEntries.clear();
-   SAFE_DELETE(mRoot);
-   mRoot = new ZipEntry;
-   mRoot->mName = StringTable->EmptyString;
-   mRoot->mIsDirectory = true;
-   mRoot->mCD.setFilename("");
+   clearEntries();
 
    if(! mEOCD.findInStream(mStream))
       return false;
@@ -96,6 +93,9 @@ bool ZipArchive::readCentralDirectory()
    if(! mStream->setPosition(mEOCD.mCDOffset))
       return false;
 
+   mEntries.reserve(mEOCD.mNumEntriesInThisCD);
+   mPathIndex.reserve(mEOCD.mNumEntriesInThisCD);
+
    for(S32 i = 0;i < mEOCD.mNumEntriesInThisCD;++i)
    {
       ZipEntry *ze = new ZipEntry;
@@ -116,6 +116,81 @@ bool ZipArchive::readCentralDirectory()
 
 //////////////////////////////////////////////////////////////////////////
 
+U32 ZipArchive::hashPath(const char *path)
+{
+   // FNV-1a over the path with '\\' read as '/', so lookups needn't copy
+   // and normalize the path first.
+   U32 hash = 2166136261u;
+   for(const char *ptr = path;*ptr;++ptr)
+   {
+      hash ^= (U8)(*ptr == '\\' ? '/' : *ptr);
+      hash *= 16777619u;
+   }
+
+   return hash;
+}
+
+bool ZipArchive::pathsEqual(const char *a, const char *b)
+{
+   for(;*a && *b;++a, ++b)
+   {
+      if(*a != *b && (*a == '\\' ? '/' : *a) != (*b == '\\' ? '/' : *b))
+         return false;
+   }
+
+   return *a == *b;
+}
+
+void ZipArchive::indexEntry(ZipEntry *ze)
+{
+   ze->mPathHash = hashPath(ze->mCD.mFilename);
+
+   // Entries whose paths share a hash are chained off the same slot.
+   ZipEntry *&head = mPathIndex[ze->mPathHash];
+   ze->mNextInIndex = head;
+   head = ze;
+}
+
+void ZipArchive::unindexEntry(ZipEntry *ze)
+{
+   PathIndex::iterator itr = mPathIndex.find(ze->mPathHash);
+   if(itr == mPathIndex.end())
+      return;
+
+   ZipEntry **link = &itr->value;
+   while(*link && *link != ze)
+      link = &(*link)->mNextInIndex;
+
+   if(*link)
+      *link = ze->mNextInIndex;
+
+   if(itr->value == NULL)
+      mPathIndex.erase(itr);
+
+   ze->mNextInIndex = NULL;
+}
+
+void ZipArchive::clearEntries()
+{
+   // Directories only live in the index, so it is the index that owns the
+   // entries.
+   for(PathIndex::iterator itr = mPathIndex.begin();itr != mPathIndex.end();++itr)
+   {
+      ZipEntry *ze = itr->value;
+      while(ze)
+      {
+         ZipEntry *next = ze->mNextInIndex;
+         delete ze;
+         ze = next;
+      }
+   }
+
+   mPathIndex.clear();
+   mEntries.clear();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 void ZipArchive::insertEntry(ZipEntry *ze)
 {
    char path[1024];
@@ -128,69 +203,50 @@ void ZipArchive::insertEntry(ZipEntry *ze)
          path[i] = '/';
    }
 
-   ZipEntry *root = mRoot;
-
+   // Add any directories leading up to the entry
    char *ptr = path, *slash = NULL;
-   do
+   while((slash = dStrchr(ptr, '/')) != NULL)
    {
-   	slash = dStrchr(ptr, '/');
-      if(slash)
+      *slash = 0;
+
+      if(findZipEntry(path) == NULL)
       {
-         // Add the directory
-         *slash = 0;
+         ZipEntry *newEntry = new ZipEntry;
+         newEntry->mName = StringTable->insert(ptr, true);
+         newEntry->mIsDirectory = true;
+         newEntry->mCD.setFilename(path);
 
-         ZipEntry *newEntry;
-         if((newEntry = root->mChildren.retrieve(ptr)) == NULL)
-         {
-            newEntry = new ZipEntry;
-            newEntry->mParent = root;
-            newEntry->mName = StringTable->insert(ptr, true);
-            newEntry->mIsDirectory = true;
-            newEntry->mCD.setFilename(path);
+         indexEntry(newEntry);
+      }
 
-            root->mChildren.insert(newEntry, ptr);
-         }
+      *slash = '/';
+      ptr = slash + 1;
+   }
 
-         root = newEntry;
-         
-         *slash = '/';
-         ptr = slash + 1;
-      }
-      else
-      {
-         // Add the file.
-         if(*ptr)
-         {
-            ze->mIsDirectory = false;
-            ze->mName = StringTable->insert(ptr, true);
-            ze->mParent = root;
-            root->mChildren.insert(ze, ptr);
-            mEntries.push_back(ze);
-         }
-         else
-         {
-            // [tom, 2/6/2007] If ptr is empty, this was a directory entry. Since
-            // we created a new entry for it above, we need to delete the old
-            // pointer otherwise it will leak as it won't have got inserted.
+   // Add the file.
+   if(*ptr)
+   {
+      ze->mIsDirectory = false;
+      ze->mName = StringTable->insert(ptr, true);
+      indexEntry(ze);
+      mEntries.push_back(ze);
+   }
+   else
+   {
+      // [tom, 2/6/2007] If ptr is empty, this was a directory entry. Since
+      // we created a new entry for it above, we need to delete the old
+      // pointer otherwise it will leak as it won't have got inserted.
 
-            delete ze;
-         }
-      }
-   } while(slash);
+      delete ze;
+   }
 }
 
 void ZipArchive::removeEntry(ZipEntry *ze)
 {
-   if(ze == mRoot)
-   {
-      // [tom, 2/1/2007] We don't want to remove the root as it should always
-      // be removed through closeArchive()
-      AssertFatal(0, "ZipArchive::removeEntry - Attempting to remove the root");
-      return;
-   }
-
-   // Can't iterate the hash table, so we can't do this safely
+   // Other entries' paths lead through directories, so they stay put
    AssertFatal(!ze->mIsDirectory, "ZipArchive::removeEntry - Cannot remove a directory");
+   if(ze->mIsDirectory)
+      return;
 
    // See if we have a temporary file for this entry
    VectorPtr<ZipTempStream *>::iterator i;
@@ -205,7 +261,7 @@ void ZipArchive::removeEntry(ZipEntry *ze)
       }
    }
    
-   // Remove from the tree
+   // Remove from the file list
    VectorPtr<ZipEntry *>::iterator j;
    for(j = mEntries.begin();j != mEntries.end();++j)
    {
@@ -216,10 +272,8 @@ void ZipArchive::removeEntry(ZipEntry *ze)
       }
    }
 
-   // [tom, 2/2/2007] This must be last, as ze is no longer valid once it's
-   // removed from the parent.
-   ZipEntry *z = ze->mParent->mChildren.remove(ze->mName);
-   delete z;
+   unindexEntry(ze);
+   delete ze;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -232,44 +286,16 @@ CentralDir *ZipArchive::findFileInfo(const char *filename)
 
 ZipArchive::ZipEntry *ZipArchive::findZipEntry(const char *filename)
 {
-   char path[1024];
-   dStrncpy(path, filename, sizeof(path));
-   path[sizeof(path) - 1] = 0;
+   PathIndex::iterator itr = mPathIndex.find(hashPath(filename));
+   if(itr == mPathIndex.end())
+      return NULL;
 
-   for(U32 i = 0;i < dStrlen(path);++i)
+   for(ZipEntry *ze = itr->value;ze;ze = ze->mNextInIndex)
    {
-      if(path[i] == '\\')
-         path[i] = '/';
+      if(pathsEqual(ze->mCD.mFilename, filename))
+         return ze;
    }
 
-   ZipEntry *root = mRoot;
-
-   char *ptr = path, *slash = NULL;
-   do
-   {
-      slash = dStrchr(ptr, '/');
-      if(slash)
-      {
-         // Find the directory
-         *slash = 0;
-
-         ZipEntry *newEntry;
-         if((newEntry = root->mChildren.retrieve(ptr)) == NULL)
-            return NULL;
-
-         root = newEntry;
-
-         ptr = slash + 1;
-      }
-      else
-      {
-         // Find the file
-         ZipEntry *ze;
-         if((ze = root->mChildren.retrieve(ptr)) != NULL)
-            return ze;
-      }
-   } while(slash);
-
    return NULL;
 }
 
@@ -555,19 +581,20 @@ bool ZipArchive::openArchive(Stream *stream, AccessMode mode /* = Read */)
    {
       bool ret = readCentralDirectory();
       if(mode == Read)
+      {
+         // Nothing will change underneath us, so keep the archive in memory
+         // if the project asked for it. If not, files are read from the
+         // stream as usual.
+         if(ret)
+            readImage();
+
          return ret;
+      }
 
       return true;
    }
    else
-   {
-      mEntries.clear();
-      SAFE_DELETE(mRoot);
-      mRoot = new ZipEntry;
-      mRoot->mName = StringTable->EmptyString;
-      mRoot->mIsDirectory = true;
-      mRoot->mCD.setFilename("");
-   }
+      clearEntries();
 
    return true;
 }
@@ -596,8 +623,35 @@ void ZipArchive::closeArchive()
    mStream = NULL;
 
    SAFE_FREE(mFilename);
-   SAFE_DELETE(mRoot);
-   mEntries.clear();
+   SAFE_FREE(mImage);
+   mImageSize = 0;
+   clearEntries();
+}
+
+bool ZipArchive::readImage()
+{
+   SAFE_FREE(mImage);
+   mImageSize = 0;
+
+   // Off unless the project opts in, as the image costs the archive's full size in memory.
+   U32 maxSize = (U32)getMax(Con::getIntVariable("$Pref::Zip::MaxImageSize", DefaultMaxImageSize), 0);
+   if(maxSize == 0)
+      return false;
+
+   U32 size = mStream->getStreamSize();
+   if(size == 0 || size > maxSize)
+      return false;
+
+   U8 *image = (U8 *)dMalloc(size);
+   if(! mStream->setPosition(0) || ! mStream->read(size, image))
+   {
+      dFree(image);
+      return false;
+   }
+
+   mImage = image;
+   mImageSize = size;
+   return true;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -675,6 +729,14 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    if((fileCD->mInternalFlags & (CDFileDeleted | CDFileOpen)) != 0)
       return NULL;
 
+   // Files in a resident archive are read straight out of memory
+   if(mImage && (fileCD->mInternalFlags & CDFileDirty) == 0 && (fileCD->mFlags & Encrypted) == 0)
+   {
+      Stream *residentStream = openResidentFile(fileCD);
+      if(residentStream)
+         return residentStream;
+   }
+
    Stream *stream = mStream;
 
    if(fileCD->mInternalFlags & CDFileDirty)
@@ -721,6 +783,10 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
             Con::errorf("ZipArchive::openFile - %s: Could not read local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename);
          return NULL;
       }
+
+      // Small deflated files are inflated in one go rather than streamed
+      if((fileCD->mFlags & Encrypted) == 0 && fileCD->mCompressMethod == Deflated && fileCD->mUncompressedSize <= MaxInflateSize)
+         return inflateFile(fileCD, mStream);
    }
 
    Stream *attachTo = stream;
@@ -760,6 +826,82 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    return comp->createReadStream(fileCD, attachTo);
 }
 
+Stream *ZipArchive::openResidentFile(const CentralDir *fileCD)
+{
+   // The local header's filename and extra field needn't match the central
+   // directory's, so find the file data from the local header itself.
+   const U32 localHeaderSize = 30;
+   const U32 localHeaderSignature = 0x04034b50;
+
+   U32 headOffset = fileCD->mLocalHeadOffset;
+   if(headOffset > mImageSize || mImageSize - headOffset < localHeaderSize)
+      return NULL;
+
+   const U8 *header = mImage + headOffset;
+   U32 signature = header[0] | (header[1] << 8) | (header[2] << 16) | (header[3] << 24);
+   if(signature != localHeaderSignature)
+      return NULL;
+
+   U32 dataOffset = headOffset + localHeaderSize + (header[26] | (header[27] << 8)) + (header[28] | (header[29] << 8));
+   if(dataOffset > mImageSize || mImageSize - dataOffset < fileCD->mCompressedSize)
+      return NULL;
+
+   const U8 *data = mImage + dataOffset;
+
+   if(fileCD->mCompressMethod == Stored)
+   {
+      ZipMemRStream *memStream = new ZipMemRStream;
+      memStream->attachStream(mStream);
+      memStream->setBuffer(data, fileCD->mCompressedSize);
+      return memStream;
+   }
+
+   if(fileCD->mCompressMethod == Deflated && fileCD->mUncompressedSize <= MaxInflateSize)
+   {
+      ZipMemRStream *memStream = new ZipMemRStream;
+      memStream->attachStream(mStream);
+      if(memStream->inflateBuffer(data, fileCD->mCompressedSize, fileCD->mUncompressedSize))
+         return memStream;
+
+      if(isVerbose())
+         Con::errorf("ZipArchive::openFile - %s: Could not inflate file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename);
+
+      delete memStream;
+   }
+
+   return NULL;
+}
+
+Stream *ZipArchive::inflateFile(const CentralDir *fileCD, Stream *stream)
+{
+   // The stream is positioned at the file data
+   U8 *compressed = (U8 *)dMalloc(getMax(fileCD->mCompressedSize, (U32)1));
+   if(! stream->read(fileCD->mCompressedSize, compressed))
+   {
+      if(isVerbose())
+         Con::errorf("ZipArchive::openFile - %s: Could not read file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename);
+
+      dFree(compressed);
+      return NULL;
+   }
+
+   ZipMemRStream *memStream = new ZipMemRStream;
+   memStream->attachStream(stream);
+   bool ret = memStream->inflateBuffer(compressed, fileCD->mCompressedSize, fileCD->mUncompressedSize);
+   dFree(compressed);
+
+   if(! ret)
+   {
+      if(isVerbose())
+         Con::errorf("ZipArchive::openFile - %s: Could not inflate file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename);
+
+      delete memStream;
+      return NULL;
+   }
+
+   return memStream;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 bool ZipArchive::addFile(const char *filename, const char *pathInZip, bool replace /* = true */)
@@ -26,7 +26,7 @@
 
 #include "io/fileStream.h"
 
-#include "collection/simpleHashTable.h"
+#include "collection/flatHashMap.h"
 #include "collection/vector.h"
 
 #ifndef _ZIPARCHIVE_H_
@@ -279,44 +279,69 @@ public:
 protected:
    struct ZipEntry
    {
-      ZipEntry *mParent;
-      
       StringTableEntry mName;
 
       bool mIsDirectory;
       CentralDir mCD;
-      
-      SimpleHashTable<struct ZipEntry> mChildren;
+
+      U32 mPathHash;             ///< Hash of the full path, see hashPath()
+      ZipEntry *mNextInIndex;    ///< Next entry whose path has the same hash
 
       ZipEntry()
       {
          mName = "";
          mIsDirectory = false;
+         mPathHash = 0;
+         mNextInIndex = NULL;
       }
    };
 
+   typedef FlatHashMap<U32, ZipEntry *> PathIndex;
+
    Stream *mStream;
    FileStream *mDiskStream;
    AccessMode mMode;
 
    EndOfCentralDir mEOCD;
 
-   // mRoot forms a tree of entries for fast queries given a file path
+   // mPathIndex maps the full path of every file and directory to its entry
    // mEntries allows easy iteration of the entire file list
-   ZipEntry *mRoot;
+   PathIndex mPathIndex;
    VectorPtr<ZipEntry *> mEntries;
 
+   // In Read mode the archive can be kept in memory, if the project opts in
+   // and it's small enough, so that files are served without seeking and
+   // reading the disk stream.
+   U8 *mImage;
+   U32 mImageSize;
+
+   enum
+   {
+      DefaultMaxImageSize = 0,                  ///< Archives are only kept in memory when $Pref::Zip::MaxImageSize is set
+      MaxInflateSize = 256 * 1024               ///< Deflated files up to this size are inflated in one go
+   };
+
    const char *mFilename;
 
    VectorPtr<ZipTempStream *> mTempFiles;
 
    bool readCentralDirectory();
+   bool readImage();
 
    void insertEntry(ZipEntry *ze);
    void removeEntry(ZipEntry *ze);
+   void clearEntries();
+
+   static U32 hashPath(const char *path);
+   static bool pathsEqual(const char *a, const char *b);
+   void indexEntry(ZipEntry *ze);
+   void unindexEntry(ZipEntry *ze);
    
    ZipEntry *findZipEntry(const char *filename);
 
+   Stream *openResidentFile(const CentralDir *fileCD);
+   Stream *inflateFile(const CentralDir *fileCD, Stream *stream);
+
    Stream *createNewFile(const char *filename, Compressor *method);
    Stream *createNewFile(const char *filename, const char *method)
    {
@@ -547,6 +572,18 @@ public:
    //////////////////////////////////////////////////////////////////////////
    U32 numEntries() const                             { return mEntries.size(); }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// @brief Determine if the archive is held in memory
+   ///
+   /// Archives opened for Read that are no larger than $Pref::Zip::MaxImageSize
+   /// bytes are read into memory when they are opened. Stored files are then
+   /// read straight from that image rather than the disk. The preference is
+   /// 0 by default, which leaves every archive on disk.
+   ///
+   /// @returns true if the archive is held in memory
+   //////////////////////////////////////////////////////////////////////////
+   bool isResident() const                            { return mImage != NULL; }
+
    //////////////////////////////////////////////////////////////////////////
    /// Get a central directory entry
    //////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,8 @@ const U32 ZipSubRStream::csm_inputBufferSize = 4096;
 const U32 ZipSubWStream::csm_streamCaps      = U32(Stream::StreamWrite);
 const U32 ZipSubWStream::csm_bufferSize      = (2048 * 1024);
 
+const U32 ZipMemRStream::csm_streamCaps      = U32(Stream::StreamRead) | U32(Stream::StreamPosition);
+
 //--------------------------------------------------------------------------
 //--------------------------------------
 //
@@ -468,3 +470,187 @@ U32 ZipSubWStream::getStreamSize()
    return 0;
 }
 
+//--------------------------------------------------------------------------
+//--------------------------------------
+//
+ZipMemRStream::ZipMemRStream()
+ : m_pStream(NULL),
+   m_pBuffer(NULL),
+   m_pOwnedBuffer(NULL),
+   m_bufferSize(0),
+   m_currentPosition(0)
+{
+   //
+}
+
+//--------------------------------------
+ZipMemRStream::~ZipMemRStream()
+{
+   detachStream();
+}
+
+//--------------------------------------
+void ZipMemRStream::freeBuffer()
+{
+   if (m_pOwnedBuffer != NULL)
+   {
+      dFree(m_pOwnedBuffer);
+      m_pOwnedBuffer = NULL;
+   }
+
+   m_pBuffer         = NULL;
+   m_bufferSize      = 0;
+   m_currentPosition = 0;
+}
+
+//--------------------------------------
+bool ZipMemRStream::attachStream(Stream* io_pSlaveStream)
+{
+   AssertFatal(io_pSlaveStream != NULL, "NULL Slave stream?");
+   AssertFatal(m_pStream == NULL,       "Already attached!");
+
+   m_pStream = io_pSlaveStream;
+   freeBuffer();
+
+   setStatus(EOS);
+   return true;
+}
+
+//--------------------------------------
+void ZipMemRStream::detachStream()
+{
+   freeBuffer();
+
+   m_pStream = NULL;
+   setStatus(Closed);
+}
+
+//--------------------------------------
+Stream* ZipMemRStream::getStream()
+{
+   return m_pStream;
+}
+
+//--------------------------------------
+void ZipMemRStream::setBuffer(const U8* in_pBuffer, const U32 in_size)
+{
+   AssertFatal(m_pStream != NULL, "stream not attached!");
+
+   freeBuffer();
+   m_pBuffer    = in_pBuffer;
+   m_bufferSize = in_size;
+
+   setStatus(m_bufferSize != 0 ? Ok : EOS);
+}
+
+//--------------------------------------
+bool ZipMemRStream::inflateBuffer(const U8* in_pCompressed, const U32 in_compressedSize, const U32 in_uncompressedSize)
+{
+   AssertFatal(m_pStream != NULL, "stream not attached!");
+
+   freeBuffer();
+   if (in_uncompressedSize == 0)
+   {
+      setStatus(EOS);
+      return true;
+   }
+
+   m_pOwnedBuffer = (U8*)dMalloc(in_uncompressedSize);
+
+   // The whole file is in memory, so a single inflate call does the lot.
+   z_stream_s zipStream;
+   zipStream.zalloc    = Z_NULL;
+   zipStream.zfree     = Z_NULL;
+   zipStream.opaque    = Z_NULL;
+   zipStream.next_in   = const_cast<U8*>(in_pCompressed);
+   zipStream.avail_in  = in_compressedSize;
+   zipStream.next_out  = m_pOwnedBuffer;
+   zipStream.avail_out = in_uncompressedSize;
+
+   if (inflateInit2(&zipStream, -MAX_WBITS) != Z_OK)
+   {
+      freeBuffer();
+      setStatus(IOError);
+      return false;
+   }
+
+   S32 result = inflate(&zipStream, Z_FINISH);
+   inflateEnd(&zipStream);
+
+   if (result != Z_STREAM_END || zipStream.total_out != in_uncompressedSize)
+   {
+      freeBuffer();
+      setStatus(IOError);
+      return false;
+   }
+
+   m_pBuffer    = m_pOwnedBuffer;
+   m_bufferSize = in_uncompressedSize;
+
+   setStatus(Ok);
+   return true;
+}
+
+//--------------------------------------
+bool ZipMemRStream::_read(const U32 in_numBytes, void* out_pBuffer)
+{
+   if (in_numBytes == 0)
+      return true;
+
+   AssertFatal(out_pBuffer != NULL, "NULL output buffer");
+   if (getStatus() == Closed) {
+      AssertFatal(false, "Attempted read from closed stream");
+      return false;
+   }
+
+   U32 actualSize = m_bufferSize - m_currentPosition;
+   if (actualSize > in_numBytes)
+      actualSize = in_numBytes;
+   if (actualSize != 0)
+   {
+      dMemcpy(out_pBuffer, m_pBuffer + m_currentPosition, actualSize);
+      m_currentPosition += actualSize;
+   }
+
+   if (actualSize < in_numBytes)
+   {
+      setStatus(EOS);
+      return false;
+   }
+
+   setStatus(m_currentPosition < m_bufferSize ? Ok : EOS);
+   return true;
+}
+
+//--------------------------------------
+bool ZipMemRStream::hasCapability(const Capability in_cap) const
+{
+   return (csm_streamCaps & U32(in_cap)) != 0;
+}
+
+//--------------------------------------
+U32 ZipMemRStream::getPosition() const
+{
+   return m_currentPosition;
+}
+
+//--------------------------------------
+bool ZipMemRStream::setPosition(const U32 in_newPosition)
+{
+   if (in_newPosition > m_bufferSize)
+   {
+      m_currentPosition = m_bufferSize;
+      setStatus(EOS);
+      return false;
+   }
+
+   m_currentPosition = in_newPosition;
+   setStatus(m_currentPosition < m_bufferSize ? Ok : EOS);
+   return true;
+}
+
+//--------------------------------------
+U32 ZipMemRStream::getStreamSize()
+{
+   return m_bufferSize;
+}
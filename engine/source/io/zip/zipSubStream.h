@@ -111,4 +111,51 @@ class ZipSubWStream : public FilterStream
    U32  getStreamSize();
 };
 
+/// Reads a file that is held entirely in memory, either as a view into a
+/// resident archive image (stored files) or as a buffer the file was
+/// inflated into in one go.  The slave stream is attached only so that the
+/// stream is closed like any other zip filter; it is never read from.
+class ZipMemRStream : public FilterStream
+{
+   typedef FilterStream Parent;
+   static const U32 csm_streamCaps;
+
+   Stream*   m_pStream;
+   const U8* m_pBuffer;
+   U8*       m_pOwnedBuffer;
+   U32       m_bufferSize;
+   U32       m_currentPosition;
+
+   void freeBuffer();
+
+  public:
+   ZipMemRStream();
+   virtual ~ZipMemRStream();
+
+   // Overrides of NFilterStream
+  public:
+   bool    attachStream(Stream* io_pSlaveStream);
+   void    detachStream();
+   Stream* getStream();
+
+   /// Reads from memory owned by somebody else, which must outlive the stream.
+   void setBuffer(const U8* in_pBuffer, const U32 in_size);
+
+   /// Inflates raw deflate data into a buffer owned by the stream.
+   bool inflateBuffer(const U8* in_pCompressed, const U32 in_compressedSize, const U32 in_uncompressedSize);
+
+   /// The whole file, for callers that would otherwise read it all anyway.
+   const U8* getBuffer() const { return m_pBuffer; }
+
+  protected:
+   bool _read(const U32 in_numBytes,  void* out_pBuffer);
+  public:
+   bool hasCapability(const Capability) const;
+
+   U32  getPosition() const;
+   bool setPosition(const U32 in_newPosition);
+
+   U32  getStreamSize();
+};
+
 #endif //_ZIPSUBSTREAM_H_
@@ -35,8 +35,10 @@
 
 #include "messaging/dispatcher.h"
 #include "platform/threads/mutex.h"
+#include "platform/threads/atomic.h"
 #include "collection/simpleHashTable.h"
 #include "memory/safeDelete.h"
+#include "debug/profiler.h"
 
 namespace Dispatcher
 {
@@ -73,6 +75,93 @@ void IMessageListener::onRemoveFromQueue(StringTableEntry queue)
    }
 }
 
+//////////////////////////////////////////////////////////////////////////
+// MessageQueue Methods
+//////////////////////////////////////////////////////////////////////////
+
+MessageQueue::MessageQueue() : mQueueName(""), mPostHead(0), mPostTail(0)
+{
+   mPosted = new PostedMessage[PostedMessageCapacity];
+   for(U32 i = 0;i < PostedMessageCapacity;i++)
+   {
+      mPosted[i].mSequence = i;
+      mPosted[i].mEvent = NULL;
+      mPosted[i].mData = NULL;
+   }
+}
+
+MessageQueue::~MessageQueue()
+{
+   char *event, *data;
+   while(popPostedMessage(event, data))
+      dFree(event);
+
+   delete [] mPosted;
+}
+
+bool MessageQueue::postMessage(const char* event, const char* data)
+{
+   if(data == NULL)
+      data = "";
+
+   // Copy the message before claiming a slot so the slot is published as soon as it is claimed.
+   const U32 eventSize = dStrlen(event) + 1;
+   const U32 dataSize = dStrlen(data) + 1;
+   char *buffer = (char *)dMalloc(eventSize + dataSize);
+   dMemcpy(buffer, event, eventSize);
+   dMemcpy(buffer + eventSize, data, dataSize);
+
+   // [Bounded MPSC ring] Each slot carries a sequence number. A slot is free for
+   // position "pos" when its sequence equals "pos", and holds a message for the
+   // consumer when its sequence equals "pos + 1".
+   PostedMessage *slot;
+   U32 pos = dAtomicRead(mPostHead);
+   for(;;)
+   {
+      slot = &mPosted[pos & (PostedMessageCapacity - 1)];
+      const S32 difference = (S32)(dAtomicRead(slot->mSequence) - pos);
+
+      if(difference == 0)
+      {
+         if(dCompareAndSwap(mPostHead, pos, pos + 1))
+            break;
+      }
+      else if(difference < 0)
+      {
+         // The ring is full.
+         dFree(buffer);
+         return false;
+      }
+
+      // Another producer claimed the slot first.
+      pos = dAtomicRead(mPostHead);
+   }
+
+   slot->mEvent = buffer;
+   slot->mData = buffer + eventSize;
+
+   // Publish to the consumer.
+   dAtomicWrite(slot->mSequence, pos + 1);
+   return true;
+}
+
+bool MessageQueue::popPostedMessage(char *&event, char *&data)
+{
+   PostedMessage &slot = mPosted[mPostTail & (PostedMessageCapacity - 1)];
+   if(dAtomicRead(slot.mSequence) != mPostTail + 1)
+      return false;
+
+   event = slot.mEvent;
+   data = slot.mData;
+   slot.mEvent = NULL;
+   slot.mData = NULL;
+
+   // Hand the slot back to the producers for the next lap around the ring.
+   dAtomicWrite(slot.mSequence, mPostTail + PostedMessageCapacity);
+   ++mPostTail;
+   return true;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Global State
 //////////////////////////////////////////////////////////////////////////
@@ -85,9 +174,25 @@ static struct _DispatchData
    void *mMutex;
    SimpleHashTable<MessageQueue> mQueues;
 
+   /// All registered queues, used to drain posted messages.
+   VectorPtr<MessageQueue *> mQueueList;
+
+   /// Number of posted messages waiting across all queues.
+   volatile U32 mPostedCount;
+
+   /// Changed whenever a queue is unregistered so that queue handles can be found again.
+   volatile U32 mQueueSequence;
+
+   /// Changed whenever a listener or queue is unregistered so that posted
+   /// message dispatch can tell its copy of the listeners is out of date.
+   volatile U32 mListenerSequence;
+
    _DispatchData()
    {
       mMutex = Mutex::createMutex();
+      mPostedCount = 0;
+      mQueueSequence = 0;
+      mListenerSequence = 0;
    }
 
    ~_DispatchData()
@@ -95,6 +200,7 @@ static struct _DispatchData
       if(Mutex::lockMutex( mMutex ) )
       {
          mQueues.clearTables();
+         mQueueList.clear();
 
          Mutex::unlockMutex( mMutex );
       }
@@ -130,6 +236,7 @@ void registerMessageQueue(const char *name)
       MessageQueue *queue = new MessageQueue;
       queue->mQueueName = StringTable->insert(name);
       gDispatchData.mQueues.insert(queue, name);
+      gDispatchData.mQueueList.push_back(queue);
 
       Mutex::unlockMutex( gDispatchData.mMutex );
    }
@@ -144,12 +251,27 @@ void unregisterMessageQueue(const char *name)
       if(queue == NULL)
          return;
 
+      for(S32 i = 0;i < gDispatchData.mQueueList.size();i++)
+      {
+         if(gDispatchData.mQueueList[i] == queue)
+         {
+            gDispatchData.mQueueList.erase(gDispatchData.mQueueList.begin() + i);
+            break;
+         }
+      }
+
       // Tell the listeners about it
       for(S32 i = 0;i < queue->mListeners.size();i++)
       {
          queue->mListeners[i]->onRemoveFromQueue(name);
       }
 
+      // Posted messages that are discarded with the queue are no longer pending.
+      dFetchAndAdd(gDispatchData.mPostedCount, queue->mPostTail - dAtomicRead(queue->mPostHead));
+
+      dFetchAndAdd(gDispatchData.mQueueSequence, 1);
+      dFetchAndAdd(gDispatchData.mListenerSequence, 1);
+
       delete queue;
    }
 }
@@ -206,6 +328,7 @@ void unregisterMessageListener(const char *queue, IMessageListener *listener)
       {
          listener->onRemoveFromQueue(StringTable->insert(queue));
          q->mListeners.erase(i);
+         dFetchAndAdd(gDispatchData.mListenerSequence, 1);
          return;
       }
    }
@@ -232,6 +355,18 @@ bool dispatchMessage(const char *queue, const char *msg, const char *data)
    return q->dispatchMessage(msg, data);
 }
 
+bool dispatchMessage(MessageQueue *queue, const char *msg, const char *data)
+{
+   AssertFatal(queue != NULL, "Dispatcher::dispatchMessage - Invalid queue handle.");
+
+   MutexHandle mh;
+
+   if(! mh.lock(gDispatchData.mMutex, true))
+      return true;
+
+   return queue->dispatchMessage(msg, data);
+}
+
 
 bool dispatchMessageObject(const char *queue, Message *msg)
 {
@@ -240,18 +375,34 @@ bool dispatchMessageObject(const char *queue, Message *msg)
    if(msg == NULL)
       return true;
 
-   msg->addReference();
-
    if(! mh.lock(gDispatchData.mMutex, true))
-   {
-      msg->freeReference();
       return true;
-   }
 
    MessageQueue *q = gDispatchData.mQueues.retrieve(queue);
    if(q == NULL)
    {
       Con::errorf("Dispatcher::dispatchMessage - Attempting to dispatch to unknown queue '%s'", queue);
+      msg->addReference();
+      msg->freeReference();
+      return true;
+   }
+
+   return dispatchMessageObject(q, msg);
+}
+
+bool dispatchMessageObject(MessageQueue *q, Message *msg)
+{
+   AssertFatal(q != NULL, "Dispatcher::dispatchMessageObject - Invalid queue handle.");
+
+   MutexHandle mh;
+
+   if(msg == NULL)
+      return true;
+
+   msg->addReference();
+
+   if(! mh.lock(gDispatchData.mMutex, true))
+   {
       msg->freeReference();
       return true;
    }
@@ -278,6 +429,154 @@ bool dispatchMessageObject(const char *queue, Message *msg)
    return bResult;
 }
 
+MessageQueue *findMessageQueue(const char *name)
+{
+   MutexHandle mh;
+
+   if(! mh.lock(gDispatchData.mMutex, true))
+      return NULL;
+
+   return gDispatchData.mQueues.retrieve(name);
+}
+
+U32 getQueueSequence()
+{
+   return dAtomicRead(gDispatchData.mQueueSequence);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Posted Messages
+//////////////////////////////////////////////////////////////////////////
+
+bool postMessage(MessageQueue *queue, const char *msg, const char *data)
+{
+   AssertFatal(queue != NULL, "Dispatcher::postMessage - Invalid queue handle.");
+
+   // Posting may happen on any thread so failures are left to the caller to report.
+   if(! queue->postMessage(msg, data))
+      return false;
+
+   dFetchAndAdd(gDispatchData.mPostedCount, 1);
+   return true;
+}
+
+bool postMessage(const char *queue, const char *msg, const char *data)
+{
+   MessageQueue *q = findMessageQueue(queue);
+   if(q == NULL)
+      return false;
+
+   return postMessage(q, msg, data);
+}
+
+/// A posted message taken off its queue, waiting to be dispatched.
+struct PendingMessage
+{
+   StringTableEntry mQueueName;
+   char *mEvent;
+   char *mData;
+};
+
+static bool isListenerRegistered(StringTableEntry queue, IMessageListener *listener)
+{
+   MutexHandle mh;
+
+   if(! mh.lock(gDispatchData.mMutex, true))
+      return false;
+
+   MessageQueue *q = gDispatchData.mQueues.retrieve(queue);
+   if(q == NULL)
+      return false;
+
+   for(S32 i = 0;i < q->mListeners.size();i++)
+   {
+      if(q->mListeners[i] == listener)
+         return true;
+   }
+
+   return false;
+}
+
+static bool dispatchPendingMessage(const PendingMessage &message)
+{
+   VectorPtr<IMessageListener *> listeners;
+   U32 sequence;
+
+   // Copy the listeners so that none of them are called with the mutex held.
+   {
+      MutexHandle mh;
+
+      if(! mh.lock(gDispatchData.mMutex, true))
+         return false;
+
+      MessageQueue *q = gDispatchData.mQueues.retrieve(message.mQueueName);
+      if(q == NULL)
+         return false;
+
+      listeners = q->mListeners;
+      sequence = dAtomicRead(gDispatchData.mListenerSequence);
+   }
+
+   for(S32 i = 0;i < listeners.size();i++)
+   {
+      // An earlier listener may have removed this one, or the queue.
+      if(dAtomicRead(gDispatchData.mListenerSequence) != sequence && !isListenerRegistered(message.mQueueName, listeners[i]))
+         continue;
+
+      if(! listeners[i]->onMessageReceived(message.mQueueName, message.mEvent, message.mData))
+         break;
+   }
+
+   return true;
+}
+
+U32 processPostedMessages()
+{
+   // Nothing posted since the last call so avoid taking the mutex.
+   if(dAtomicRead(gDispatchData.mPostedCount) == 0)
+      return 0;
+
+   PROFILE_SCOPE(Dispatcher_ProcessPostedMessages);
+
+   // Take everything posted so far off the queues. Messages posted by the
+   // listeners below are left for the next call.
+   Vector<PendingMessage> pending;
+   {
+      MutexHandle mh;
+
+      if(! mh.lock(gDispatchData.mMutex, true))
+         return 0;
+
+      for(S32 i = 0;i < gDispatchData.mQueueList.size();i++)
+      {
+         MessageQueue *q = gDispatchData.mQueueList[i];
+
+         // Only take what was posted before we started so that busy
+         // producers cannot keep us holding the mutex.
+         U32 count = dAtomicRead(q->mPostHead) - q->mPostTail;
+
+         PendingMessage message;
+         message.mQueueName = q->mQueueName;
+         while(count-- > 0 && q->popPostedMessage(message.mEvent, message.mData))
+         {
+            dFetchAndAdd(gDispatchData.mPostedCount, (U32)-1);
+            pending.push_back(message);
+         }
+      }
+   }
+
+   U32 dispatched = 0;
+   for(S32 i = 0;i < pending.size();i++)
+   {
+      if(dispatchPendingMessage(pending[i]))
+         ++dispatched;
+
+      dFree(pending[i].mEvent);
+   }
+
+   return dispatched;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Internal Functions
 //////////////////////////////////////////////////////////////////////////
@@ -369,6 +668,15 @@ ConsoleFunction(dispatchMessage, bool, 3, 4, "(queueName, event, data) Dispatche
    return dispatchMessage(argv[1], argv[2], argc > 3 ? argv[3] : "" );
 }
 
+ConsoleFunction(postMessage, bool, 3, 4, "(queueName, event, data) Posts a message to given message queue to be dispatched on the next frame\n"
+                "@param queueName The queue to post to\n"
+                "@param event The message you are passing\n"
+                "@param data Data\n"
+                "@return Returns true on success and false otherwise")
+{
+   return postMessage(argv[1], argv[2], argc > 3 ? argv[3] : "" );
+}
+
 ConsoleFunction(dispatchMessageObject, bool, 3, 3, "(queueName, message) Dispatches a message object to the given queue\n"
                 "@param queueName The name of the queue to dispatch object to\n"
                 "@param message The message object\n")
@@ -122,20 +122,57 @@ public:
    virtual void onRemoveFromQueue(StringTableEntry queue);
 };
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Internal class for tracking messages posted to a queue
+///
+/// The event and data strings are stored in a single allocation owned
+/// by the slot until the message has been dispatched.
+//////////////////////////////////////////////////////////////////////////
+struct PostedMessage
+{
+   volatile U32 mSequence;
+   char *mEvent;
+   char *mData;
+};
+
 //////////////////////////////////////////////////////////////////////////
 /// @brief Internal class for tracking message queues
+///
+/// Each queue owns a bounded ring of posted messages. Any number of threads
+/// may post to the ring without taking the dispatcher mutex; the ring is
+/// drained on the main thread by processPostedMessages().
 //////////////////////////////////////////////////////////////////////////
 struct MessageQueue
 {
+   /// Number of messages that can be waiting in the posted ring. Must be a power of two.
+   enum { PostedMessageCapacity = 1024 };
+
    StringTableEntry mQueueName;
    VectorPtr<IMessageListener *> mListeners;
 
-   MessageQueue() : mQueueName("")
-   {
-   }
+   PostedMessage *mPosted;
+   volatile U32 mPostHead;
+   U32 mPostTail;
+
+   MessageQueue();
+   ~MessageQueue();
 
    bool isEmpty()    { return mListeners.size() == 0; }
 
+   //////////////////////////////////////////////////////////////////////////
+   /// @brief Post a message to the ring. Safe to call from any thread.
+   /// @return false if the ring is full
+   //////////////////////////////////////////////////////////////////////////
+   bool postMessage(const char* event, const char* data);
+
+   //////////////////////////////////////////////////////////////////////////
+   /// @brief Remove the oldest posted message from the ring. Main thread only.
+   ///
+   /// The event and data must be released with dFree(event) once dispatched.
+   /// @return false if the ring is empty
+   //////////////////////////////////////////////////////////////////////////
+   bool popPostedMessage(char *&event, char *&data);
+
    bool dispatchMessage(const char* event, const char* data)
    {
       for(VectorPtr<IMessageListener *>::iterator i = mListeners.begin();i != mListeners.end();i++)
@@ -234,6 +271,97 @@ extern bool dispatchMessage(const char *queue, const char *msg, const char *data
 //////////////////////////////////////////////////////////////////////////
 extern bool dispatchMessageObject(const char *queue, Message *msg);
 
+//////////////////////////////////////////////////////////////////////////
+/// @brief Find a message queue so that it can be referenced without name lookups
+///
+/// The returned handle remains valid until the queue is unregistered. Code
+/// that keeps a handle while others may unregister the queue by name should
+/// remember getQueueSequence() when finding it and find it again once the
+/// sequence has changed.
+/// 
+/// @param name The name of the message queue
+/// @return The message queue, or NULL if it is not registered
+/// @see dispatchMessage(), dispatchMessageObject(), postMessage(), getQueueSequence()
+//////////////////////////////////////////////////////////////////////////
+extern MessageQueue *findMessageQueue(const char *name);
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Get a number that changes whenever a message queue is unregistered
+///
+/// @return The current queue sequence
+/// @see findMessageQueue()
+//////////////////////////////////////////////////////////////////////////
+extern U32 getQueueSequence();
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Dispatch a message to a queue handle
+/// 
+/// @param queue Queue handle returned by findMessageQueue()
+/// @param msg Message to dispatch
+/// @param data Data for message
+/// @return true for success, false for failure
+/// @see findMessageQueue()
+//////////////////////////////////////////////////////////////////////////
+extern bool dispatchMessage(MessageQueue *queue, const char *msg, const char *data);
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Dispatch a message object to a queue handle
+/// 
+/// @param queue Queue handle returned by findMessageQueue()
+/// @param msg Message to dispatch
+/// @return true for success, false for failure
+/// @see findMessageQueue()
+//////////////////////////////////////////////////////////////////////////
+extern bool dispatchMessageObject(MessageQueue *queue, Message *msg);
+
+// @}
+
+/// @name Posted Messages
+// @{
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Post a message to a queue from any thread
+///
+/// The message is copied and dispatched on the main thread by the next
+/// call to processPostedMessages(). Posting does not take the dispatcher
+/// mutex. Queues must not be unregistered while other threads are posting
+/// to them.
+/// 
+/// @param queue Queue handle returned by findMessageQueue()
+/// @param msg Message to post
+/// @param data Data for message
+/// @return true for success, false if the queue is full
+/// @see processPostedMessages()
+//////////////////////////////////////////////////////////////////////////
+extern bool postMessage(MessageQueue *queue, const char *msg, const char *data);
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Post a message to a named queue from any thread
+///
+/// This looks up the queue under the dispatcher mutex. Use the
+/// handle version from worker threads that post frequently.
+/// 
+/// @param queue Name of the queue to post the message to
+/// @param msg Message to post
+/// @param data Data for message
+/// @return true for success, false if the queue is unknown or full
+/// @see processPostedMessages()
+//////////////////////////////////////////////////////////////////////////
+extern bool postMessage(const char *queue, const char *msg, const char *data);
+
+//////////////////////////////////////////////////////////////////////////
+/// @brief Dispatch all posted messages. Must be called from the main thread.
+///
+/// The posted messages are taken from their queues under the dispatcher
+/// mutex and dispatched after it is released, so listeners are free to
+/// post, dispatch, register and unregister. Messages they post are
+/// dispatched by the next call.
+///
+/// @return The number of messages dispatched
+/// @see postMessage()
+//////////////////////////////////////////////////////////////////////////
+extern U32 processPostedMessages();
+
 // @}
 
 //////////////////////////////////////////////////////////////////////////
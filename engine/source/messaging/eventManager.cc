@@ -61,7 +61,7 @@ bool EventManagerListener::onMessageReceived( StringTableEntry queue, const char
 //-----------------------------------------------------------------------------
 // Constructor
 //-----------------------------------------------------------------------------
-EventManager::EventManager() : mQueue( NULL )
+EventManager::EventManager() : mQueue( NULL ), mQueueHandle( NULL ), mQueueSequence( 0 )
 {
    addEventManager( this );
 }
@@ -99,15 +99,41 @@ void EventManager::setMessageQueue( const char* queue )
       Dispatcher::unregisterMessageQueue( mQueue );
    }
 
+   mQueueHandle = NULL;
+
    // Register the new queue.
    if( queue && *queue )
    {
       Dispatcher::registerMessageQueue( queue );
       Dispatcher::registerMessageListener( queue, &mListener );
       mQueue = StringTable->insert( queue );
+      mQueueSequence = Dispatcher::getQueueSequence();
+      mQueueHandle = Dispatcher::findMessageQueue( queue );
    }
 }
 
+//-----------------------------------------------------------------------------
+/// Gets the handle of the message queue.
+/// 
+/// The queue may have been unregistered by name elsewhere, so the handle is
+/// found again whenever any queue has been unregistered since it was found.
+/// 
+/// @return The queue handle, or NULL if the queue is not registered.
+//-----------------------------------------------------------------------------
+Dispatcher::MessageQueue* EventManager::getQueueHandle()
+{
+   if( !mQueue || !*mQueue )
+      return NULL;
+
+   const U32 sequence = Dispatcher::getQueueSequence();
+   if( mQueueHandle && sequence == mQueueSequence )
+      return mQueueHandle;
+
+   mQueueSequence = sequence;
+   mQueueHandle = Dispatcher::findMessageQueue( mQueue );
+   return mQueueHandle;
+}
+
 //-----------------------------------------------------------------------------
 /// Determines whether or not an event is registered with the EventManager.
 /// 
@@ -208,7 +234,27 @@ void EventManager::unregisterEvent( const char* event )
 //-----------------------------------------------------------------------------
 bool EventManager::postEvent( const char* event, const char* data )
 {
-   return Dispatcher::dispatchMessage( mQueue, event, data );
+   Dispatcher::MessageQueue* queue = getQueueHandle();
+   if( !queue )
+      return Dispatcher::dispatchMessage( mQueue, event, data );
+
+   return Dispatcher::dispatchMessage( queue, event, data );
+}
+
+//-----------------------------------------------------------------------------
+/// Queue an event to be posted on the main thread.
+/// 
+/// @param event The event to queue.
+/// @param data Various data associated with the event.
+/// @return Whether or not the event was queued successfully.
+//-----------------------------------------------------------------------------
+bool EventManager::queueEvent( const char* event, const char* data )
+{
+   Dispatcher::MessageQueue* queue = getQueueHandle();
+   if( !queue )
+      return false;
+
+   return Dispatcher::postMessage( queue, event, data );
 }
 
 //-----------------------------------------------------------------------------
@@ -376,6 +422,15 @@ ConsoleMethod( EventManager, postEvent, bool, 3, 4, "( String event, String data
    return object->postEvent( argv[2], argc > 3 ? argv[3] : "" );
 }
 
+ConsoleMethod( EventManager, queueEvent, bool, 3, 4, "( String event, String data )\n"
+              "Queue an event to be triggered when posted messages are next processed.\n"
+              "@param event The event to trigger.\n"
+              "@param data The data associated with the event.\n"
+              "@return Whether or not the event was queued successfully." )
+{
+   return object->queueEvent( argv[2], argc > 3 ? argv[3] : "" );
+}
+
 ConsoleMethod( EventManager, subscribe, bool, 4, 5, "( SimObject listener, String event, String callback )\n\n"
               "Subscribe a listener to an event.\n"
               "@param listener The listener to subscribe.\n"
@@ -92,6 +92,10 @@ class EventManager : public SimObject
 private:
    /// The name of the message queue.
    StringTableEntry mQueue;
+   /// The message queue handle, avoids looking the queue up by name for each event.
+   Dispatcher::MessageQueue* mQueueHandle;
+   /// The dispatcher queue sequence when mQueueHandle was found.
+   U32 mQueueSequence;
    /// Registered events.
    Vector<StringTableEntry> mEvents;
 
@@ -101,6 +105,9 @@ private:
    /// List of all EventManagers.
    static Vector<EventManager*> smEventManagers;
 
+   /// Gets the message queue handle, finding it again if any queue was unregistered since.
+   Dispatcher::MessageQueue* getQueueHandle();
+
 public:
    DECLARE_CONOBJECT( EventManager );
 
@@ -137,6 +144,8 @@ public:
 
    /// Triggers an event.
    bool postEvent( const char* eventName, const char* data );
+   /// Queues an event to be triggered on the main thread. Safe to call from any thread.
+   bool queueEvent( const char* eventName, const char* data );
    /// Adds a subscription to an event.
    bool subscribe( SimObject *callbackObj, const char* event, const char* callback = NULL );
    /// Remove a subscriber from an event.
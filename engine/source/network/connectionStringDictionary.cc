@@ -0,0 +1,399 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "network/connectionStringDictionary.h"
+#include "io/bitStream.h"
+#include "io/huffmanProcessor.h"
+#include "math/mMathFn.h"
+
+//--------------------------------------------------------------------
+
+ConnectionStringDictionary::ConnectionStringDictionary()
+{
+   for(U32 i = 0; i < EntryCount; i++)
+   {
+      mEntries[i].string = NULL;
+      mEntries[i].length = 0;
+      mEntries[i].hash = 0;
+      mEntries[i].lastUse = 0;
+      mEntries[i].nextHash = -1;
+      mEntries[i].state = EntryEmpty;
+      mHashTable[i] = -1;
+      mRemoteStrings[i] = NULL;
+   }
+   mUseStamp = 0;
+
+   dMemset(mCharCounts, 0, sizeof(mCharCounts));
+   dMemset(mModelLevels, 0, sizeof(mModelLevels));
+   mLiteralCharCount = 0;
+   mSendModels[0] = mSendModels[1] = NULL;
+   mSendModel = -1;
+   mBuiltModel = -1;
+   mBuiltModelInFlight = false;
+
+   mRemoteAssignment = -1;
+   mReceiveModels[0] = mReceiveModels[1] = NULL;
+   mReceiveModel = -1;
+   dMemset(mReceiveLevels, 0, sizeof(mReceiveLevels));
+}
+
+ConnectionStringDictionary::~ConnectionStringDictionary()
+{
+   for(U32 i = 0; i < EntryCount; i++)
+   {
+      dFree(mEntries[i].string);
+      dFree(mRemoteStrings[i]);
+   }
+   for(U32 i = 0; i < 2; i++)
+   {
+      delete mSendModels[i];
+      delete mReceiveModels[i];
+   }
+}
+
+//--------------------------------------------------------------------
+
+U32 ConnectionStringDictionary::hashString(const char *string, U32 length)
+{
+   // FNV-1a
+   U32 hash = 2166136261u;
+   for(U32 i = 0; i < length; i++)
+   {
+      hash ^= U8(string[i]);
+      hash *= 16777619u;
+   }
+   return hash;
+}
+
+S32 ConnectionStringDictionary::findEntry(const char *string, U32 length, U32 hash)
+{
+   for(S32 walk = mHashTable[hash % EntryCount]; walk != -1; walk = mEntries[walk].nextHash)
+   {
+      Entry &entry = mEntries[walk];
+      if(entry.hash == hash && entry.length == length && !dStrncmp(entry.string, string, length))
+         return walk;
+   }
+   return -1;
+}
+
+S32 ConnectionStringDictionary::allocEntry()
+{
+   // take an empty slot if there is one, otherwise the least recently used
+   // confirmed one.  Pending slots are never recycled since the packet that
+   // assigned them may still arrive.
+   S32 best = -1;
+   for(S32 i = 0; i < EntryCount; i++)
+   {
+      const Entry &entry = mEntries[i];
+      if(entry.state == EntryEmpty)
+         return i;
+      if(entry.state == EntryConfirmed && (best == -1 || entry.lastUse < mEntries[best].lastUse))
+         best = i;
+   }
+   if(best != -1)
+      freeEntry(best);
+   return best;
+}
+
+void ConnectionStringDictionary::freeEntry(S32 index)
+{
+   Entry &entry = mEntries[index];
+   if(entry.state == EntryEmpty)
+      return;
+
+   S16 *walk = &mHashTable[entry.hash % EntryCount];
+   while(*walk != index)
+      walk = &mEntries[*walk].nextHash;
+   *walk = entry.nextHash;
+
+   dFree(entry.string);
+   entry.string = NULL;
+   entry.nextHash = -1;
+   entry.state = EntryEmpty;
+}
+
+//--------------------------------------------------------------------
+
+HuffmanProcessor *ConnectionStringDictionary::createModel(const U8 *levels)
+{
+   // each level is a power of two frequency, zero for unused characters
+   U32 freqs[256];
+   for(U32 i = 0; i < 256; i++)
+      freqs[i] = levels[i] ? (1 << (levels[i] + 1)) : 0;
+   return new HuffmanProcessor(freqs);
+}
+
+void ConnectionStringDictionary::buildModel()
+{
+   U32 maxCount = 0;
+   for(U32 i = 0; i < 256; i++)
+      maxCount = getMax(maxCount, mCharCounts[i]);
+   if(!maxCount)
+      return;
+
+   // quantize the counts to a log scale so the table is cheap to send
+   for(U32 i = 0; i < 256; i++)
+   {
+      if(!mCharCounts[i])
+      {
+         mModelLevels[i] = 0;
+         continue;
+      }
+      U32 scaled = U32((U64(mCharCounts[i]) << 14) / maxCount);
+      U8 level = 1;
+      while(scaled > 1 && level < (1 << ModelLevelBitSize) - 1)
+      {
+         scaled >>= 1;
+         level++;
+      }
+      mModelLevels[i] = level;
+   }
+
+   // halve the counts so the next model follows changes in the traffic
+   for(U32 i = 0; i < 256; i++)
+      mCharCounts[i] >>= 1;
+   mLiteralCharCount = 0;
+
+   mBuiltModel = mSendModel == 0 ? 1 : 0;
+   delete mSendModels[mBuiltModel];
+   mSendModels[mBuiltModel] = createModel(mModelLevels);
+   mBuiltModelInFlight = false;
+}
+
+U32 ConnectionStringDictionary::getModelBitSize()
+{
+   U32 size = 256 + 1;
+   for(U32 i = 0; i < 256; i++)
+      if(mModelLevels[i])
+         size += ModelLevelBitSize;
+   return size;
+}
+
+//--------------------------------------------------------------------
+
+void ConnectionStringDictionary::writePacketHeader(BitStream *stream)
+{
+   PacketRecord record;
+   record.slotCount = 0;
+   record.modelSent = false;
+
+   if(stream->writeFlag(mSendModel != -1))
+      stream->writeInt(mSendModel, 1);
+
+   if(mBuiltModel == -1 && mLiteralCharCount >= ModelRebuildCharCount)
+      buildModel();
+
+   // the table is resent until a packet carrying it is acknowledged; leave
+   // it for a later packet if this one is already short on space.
+   bool sendModel = mBuiltModel != -1 && !mBuiltModelInFlight &&
+                    stream->getBitSpaceAvailable() > S32(getModelBitSize() * 2);
+   if(stream->writeFlag(sendModel))
+   {
+      stream->writeInt(mBuiltModel, 1);
+      for(U32 i = 0; i < 256; i++)
+         if(stream->writeFlag(mModelLevels[i] != 0))
+            stream->writeInt(mModelLevels[i], ModelLevelBitSize);
+      mBuiltModelInFlight = true;
+      record.modelSent = true;
+   }
+
+   mPacketRecords.push_back(record);
+}
+
+bool ConnectionStringDictionary::writeString(BitStream *stream, const char *string, S32 maxLen, HuffmanProcessor **huffman)
+{
+   U32 length = getMin(dStrlen(string), U32(getMin(maxLen, 255)));
+   U32 hash = hashString(string, length);
+   S32 index = findEntry(string, length, hash);
+
+   if(index != -1 && mEntries[index].state == EntryConfirmed)
+   {
+      stream->writeFlag(true);
+      stream->writeInt(index, EntryBitSize);
+      mEntries[index].lastUse = ++mUseStamp;
+      return true;
+   }
+   stream->writeFlag(false);
+
+   // hand out a slot for strings worth remembering
+   PacketRecord *record = mPacketRecords.empty() ? NULL : &mPacketRecords.last();
+   if(index == -1 && length >= MinEntryLength && record && record->slotCount < MaxAssignmentsPerPacket)
+      index = allocEntry();
+   else
+      index = -1;
+
+   if(stream->writeFlag(index != -1))
+   {
+      Entry &entry = mEntries[index];
+      entry.string = (char *) dMalloc(length + 1);
+      dMemcpy(entry.string, string, length);
+      entry.string[length] = 0;
+      entry.length = length;
+      entry.hash = hash;
+      entry.lastUse = ++mUseStamp;
+      entry.state = EntryPending;
+      entry.nextHash = mHashTable[hash % EntryCount];
+      mHashTable[hash % EntryCount] = index;
+
+      record->slots[record->slotCount++] = U8(index);
+      stream->writeInt(index, EntryBitSize);
+   }
+
+   for(U32 i = 0; i < length; i++)
+      mCharCounts[U8(string[i])]++;
+   mLiteralCharCount += length;
+
+   if(mSendModel != -1)
+      *huffman = mSendModels[mSendModel];
+   return false;
+}
+
+void ConnectionStringDictionary::packetReceived()
+{
+   if(mPacketRecords.empty())
+      return;
+
+   PacketRecord &record = mPacketRecords.front();
+   for(U32 i = 0; i < record.slotCount; i++)
+      mEntries[record.slots[i]].state = EntryConfirmed;
+
+   if(record.modelSent)
+   {
+      mSendModel = mBuiltModel;
+      mBuiltModel = -1;
+      mBuiltModelInFlight = false;
+   }
+   mPacketRecords.pop_front();
+}
+
+void ConnectionStringDictionary::packetDropped()
+{
+   if(mPacketRecords.empty())
+      return;
+
+   PacketRecord &record = mPacketRecords.front();
+   for(U32 i = 0; i < record.slotCount; i++)
+      freeEntry(record.slots[i]);
+
+   if(record.modelSent)
+      mBuiltModelInFlight = false;
+   mPacketRecords.pop_front();
+}
+
+//--------------------------------------------------------------------
+
+void ConnectionStringDictionary::readPacketHeader(BitStream *stream)
+{
+   mReceiveModel = stream->readFlag() ? stream->readInt(1) : -1;
+
+   if(stream->readFlag())
+   {
+      S32 slot = stream->readInt(1);
+      U8 *levels = mReceiveLevels[slot];
+      for(U32 i = 0; i < 256; i++)
+         levels[i] = stream->readFlag() ? U8(stream->readInt(ModelLevelBitSize)) : 0;
+
+      delete mReceiveModels[slot];
+      mReceiveModels[slot] = createModel(levels);
+   }
+
+   if(mReceiveModel != -1 && !mReceiveModels[mReceiveModel])
+      mReceiveModel = -1;
+}
+
+bool ConnectionStringDictionary::readString(BitStream *stream, char buf[256], HuffmanProcessor **huffman)
+{
+   mRemoteAssignment = -1;
+   if(stream->readFlag())
+   {
+      const char *string = mRemoteStrings[stream->readInt(EntryBitSize)];
+      dStrcpy(buf, string ? string : "");
+      return true;
+   }
+   if(stream->readFlag())
+      mRemoteAssignment = stream->readInt(EntryBitSize);
+
+   if(mReceiveModel != -1)
+      *huffman = mReceiveModels[mReceiveModel];
+   return false;
+}
+
+void ConnectionStringDictionary::readStringDone(const char *buf)
+{
+   if(mRemoteAssignment == -1)
+      return;
+
+   dFree(mRemoteStrings[mRemoteAssignment]);
+   mRemoteStrings[mRemoteAssignment] = dStrdup(buf);
+   mRemoteAssignment = -1;
+}
+
+//--------------------------------------------------------------------
+
+void ConnectionStringDictionary::writeDemoStartBlock(ResizeBitStream *stream)
+{
+   // a demo only ever reads, so the receiving side is all we need
+   for(U32 i = 0; i < EntryCount; i++)
+   {
+      if(stream->writeFlag(mRemoteStrings[i] != NULL))
+      {
+         stream->writeString(mRemoteStrings[i]);
+         stream->validate();
+      }
+   }
+   for(U32 slot = 0; slot < 2; slot++)
+   {
+      if(stream->writeFlag(mReceiveModels[slot] != NULL))
+      {
+         for(U32 i = 0; i < 256; i++)
+            stream->writeInt(mReceiveLevels[slot][i], ModelLevelBitSize);
+         stream->validate();
+      }
+   }
+}
+
+void ConnectionStringDictionary::readDemoStartBlock(BitStream *stream)
+{
+   char buffer[256];
+   for(U32 i = 0; i < EntryCount; i++)
+   {
+      dFree(mRemoteStrings[i]);
+      mRemoteStrings[i] = NULL;
+      if(stream->readFlag())
+      {
+         stream->readString(buffer);
+         mRemoteStrings[i] = dStrdup(buffer);
+      }
+   }
+   for(U32 slot = 0; slot < 2; slot++)
+   {
+      delete mReceiveModels[slot];
+      mReceiveModels[slot] = NULL;
+      if(stream->readFlag())
+      {
+         for(U32 i = 0; i < 256; i++)
+            mReceiveLevels[slot][i] = U8(stream->readInt(ModelLevelBitSize));
+         mReceiveModels[slot] = createModel(mReceiveLevels[slot]);
+      }
+   }
+}
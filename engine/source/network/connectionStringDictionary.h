@@ -0,0 +1,156 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONNECTIONSTRINGDICTIONARY_H_
+#define _CONNECTIONSTRINGDICTIONARY_H_
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+#ifndef _VECTOR_H_
+#include "collection/vector.h"
+#endif
+
+class BitStream;
+class ResizeBitStream;
+class HuffmanProcessor;
+
+/// Per connection compression of the strings written with BitStream::writeString().
+///
+/// Strings that are sent repeatedly (commands, identifiers, chat lines) are
+/// assigned a slot the first time they are sent as a literal.  Once the packet
+/// carrying the assignment has been acknowledged, the string is sent as an
+/// 8 bit slot index instead.  Slots are recycled least recently used first.
+///
+/// The literals themselves are Huffman coded.  The sender counts the characters
+/// it sends and, every so often, builds a coder tuned to the connection's own
+/// traffic.  The coder table travels in a packet header, and the sender starts
+/// using it only once that packet has been acknowledged, so both sides always
+/// agree on which coder a packet uses.
+///
+/// Because everything is keyed off packet acknowledgements, the sender must
+/// call writePacketHeader() for each packet, followed by exactly one of
+/// packetReceived() or packetDropped() in send order.  The receiver calls
+/// readPacketHeader() for each packet it processes.
+class ConnectionStringDictionary
+{
+public:
+   enum Constants {
+      EntryCount = 256,
+      EntryBitSize = 8,
+      MinEntryLength = 4,           ///< Shorter strings are cheaper to send as literals.
+      MaxAssignmentsPerPacket = 32, ///< New slots handed out in a single packet.
+      ModelLevelBitSize = 4,        ///< Bits per character in a sent coder table.
+      ModelRebuildCharCount = 4096, ///< Literal characters sent between coder rebuilds.
+   };
+
+private:
+   enum EntryState {
+      EntryEmpty,
+      EntryPending,     ///< Assigned in a packet that has not been acknowledged yet.
+      EntryConfirmed,   ///< The other side has this string.
+   };
+
+   struct Entry {
+      char *string;
+      U32 length;
+      U32 hash;
+      U32 lastUse;
+      S16 nextHash;
+      U8  state;
+   };
+
+   struct PacketRecord {
+      U8  slots[MaxAssignmentsPerPacket];
+      U32 slotCount;
+      bool modelSent;
+   };
+
+   // sending side
+   Entry mEntries[EntryCount];
+   S16 mHashTable[EntryCount];
+   U32 mUseStamp;
+   Vector<PacketRecord> mPacketRecords;
+
+   U32 mCharCounts[256];
+   U32 mLiteralCharCount;
+   U8  mModelLevels[256];
+   HuffmanProcessor *mSendModels[2];
+   S32 mSendModel;         ///< Model used for literals, or -1 for the default coder.
+   S32 mBuiltModel;        ///< Model waiting to be acknowledged, or -1.
+   bool mBuiltModelInFlight;
+
+   // receiving side
+   char *mRemoteStrings[EntryCount];
+   S32 mRemoteAssignment;
+   U8  mReceiveLevels[2][256];
+   HuffmanProcessor *mReceiveModels[2];
+   S32 mReceiveModel;      ///< Model the current packet's literals use, or -1.
+
+   static U32 hashString(const char *string, U32 length);
+   S32 findEntry(const char *string, U32 length, U32 hash);
+   S32 allocEntry();
+   void freeEntry(S32 index);
+
+   void buildModel();
+   U32 getModelBitSize();
+   HuffmanProcessor *createModel(const U8 *levels);
+
+public:
+   ConnectionStringDictionary();
+   ~ConnectionStringDictionary();
+
+   /// @name Sending
+   /// @{
+
+   /// Writes the per-packet header and starts a new packet record.
+   void writePacketHeader(BitStream *stream);
+
+   /// Writes the start of a string.  Returns true if the string was sent as a
+   /// dictionary index, otherwise the caller writes the literal with @a huffman.
+   bool writeString(BitStream *stream, const char *string, S32 maxLen, HuffmanProcessor **huffman);
+
+   void packetReceived();
+   void packetDropped();
+   /// @}
+
+   /// @name Receiving
+   /// @{
+
+   void readPacketHeader(BitStream *stream);
+
+   /// Reads the start of a string.  Returns true if the string was a
+   /// dictionary index and has been copied into @a buf, otherwise the caller
+   /// reads the literal with @a huffman and passes it to readStringDone().
+   bool readString(BitStream *stream, char buf[256], HuffmanProcessor **huffman);
+   void readStringDone(const char *buf);
+   /// @}
+
+   /// @name Demo functionality
+   /// @{
+
+   void readDemoStartBlock(BitStream *stream);
+   void writeDemoStartBlock(ResizeBitStream *stream);
+   /// @}
+};
+
+#endif // _CONNECTIONSTRINGDICTIONARY_H_
@@ -158,12 +158,14 @@ static U32 gPacketRateToServer = 32;
 static U32 gPacketUpdateDelayToServer = 32;
 static U32 gPacketRateToClient = 10;
 static U32 gPacketSize = 200;
+static bool gStringCompression = true;
 
 void NetConnection::consoleInit()
 {
    Con::addVariable("pref::Net::PacketRateToServer",  TypeS32, &gPacketRateToServer);
    Con::addVariable("pref::Net::PacketRateToClient",  TypeS32, &gPacketRateToClient);
    Con::addVariable("pref::Net::PacketSize",          TypeS32, &gPacketSize);
+   Con::addVariable("pref::Net::StringCompression",   TypeBool, &gStringCompression);
    Con::addVariable("Stats::netBitsSent",       TypeS32, &gNetBitsSent);
    Con::addVariable("Stats::netBitsReceived",   TypeS32, &gNetBitsReceived);
    Con::addVariable("Stats::netGhostUpdates",   TypeS32, &gGhostUpdates);
@@ -214,6 +216,17 @@ void NetConnection::setTranslatesStrings(bool xl)
       mStringTable = new ConnectionStringTable(this);
 }
 
+void NetConnection::setStringCompression(bool compress)
+{
+   if(compress && !mStringDictionary)
+      mStringDictionary = new ConnectionStringDictionary;
+   else if(!compress && mStringDictionary)
+   {
+      delete mStringDictionary;
+      mStringDictionary = NULL;
+   }
+}
+
 void NetConnection::setNetClassGroup(U32 grp)
 {
    AssertFatal(!mEstablished, "Error, cannot change net class group after a connection has been established.");
@@ -226,6 +239,7 @@ NetConnection::NetConnection()
    mConnectSequence = 0;
 
    mStringTable = NULL;
+   mStringDictionary = NULL;
    mSendingEvents = true;
    mNetClassGroup = NetClassGroupGame;
    AssertFatal(mNetClassGroup >= NetClassGroupGame && mNetClassGroup < NetClassGroupsCount,
@@ -278,6 +292,8 @@ NetConnection::NetConnection()
 
    mScopeObject = NULL;
    mGhostingSequence = 0;
+   mGhostUpdateSequence = 0;
+   mPackingGhostUpdate = 0;
    mGhosting = false;
    mScoping = false;
    mGhostArray = NULL;
@@ -316,6 +332,7 @@ NetConnection::~NetConnection()
    delete[] mGhostRefs;
    delete[] mGhostArray;
    delete mStringTable;
+   delete mStringDictionary;
    if(mDemoWriteStream)
       delete mDemoWriteStream;
    if(mDemoReadStream)
@@ -329,6 +346,7 @@ NetConnection::PacketNotify::PacketNotify()
    sendTime = 0;
    eventList = 0;
    ghostList = 0;
+   stringDictionaryWritten = false;
 }
 
 bool NetConnection::checkTimeout(U32 time)
@@ -664,24 +682,41 @@ Net::Error NetConnection::sendPacket(BitStream *stream)
 
 void NetConnection::readPacket(BitStream *bstream)
 {
+   if(mStringDictionary)
+   {
+      mStringDictionary->readPacketHeader(bstream);
+      bstream->setStringDictionary(mStringDictionary);
+   }
    eventReadPacket(bstream);
    ghostReadPacket(bstream);
+   bstream->setStringDictionary(NULL);
 }
 
 void NetConnection::writePacket(BitStream *bstream, PacketNotify *note)
 {
+   if(mStringDictionary)
+   {
+      mStringDictionary->writePacketHeader(bstream);
+      bstream->setStringDictionary(mStringDictionary);
+      note->stringDictionaryWritten = true;
+   }
    eventWritePacket(bstream, note);
    ghostWritePacket(bstream, note);
+   bstream->setStringDictionary(NULL);
 }
 
 void NetConnection::packetReceived(PacketNotify *note)
 {
+   if(mStringDictionary && note->stringDictionaryWritten)
+      mStringDictionary->packetReceived();
    eventPacketReceived(note);
    ghostPacketReceived(note);
 }
 
 void NetConnection::packetDropped(PacketNotify *note)
 {
+   if(mStringDictionary && note->stringDictionaryWritten)
+      mStringDictionary->packetDropped();
    eventPacketDropped(note);
    ghostPacketDropped(note);
 }
@@ -697,6 +732,8 @@ void NetConnection::writeDemoStartBlock(ResizeBitStream* stream)
    stream->write(mPacketLoss);
    stream->validate();
    mStringTable->writeDemoStartBlock(stream);
+   if(stream->writeFlag(mStringDictionary != NULL))
+      mStringDictionary->writeDemoStartBlock(stream);
 
    U32 start = 0;
    PacketNotify *note = mNotifyQueueHead;
@@ -720,6 +757,9 @@ bool NetConnection::readDemoStartBlock(BitStream* stream)
 
    // Read
    mStringTable->readDemoStartBlock(stream);
+   setStringCompression(stream->readFlag());
+   if(mStringDictionary)
+      mStringDictionary->readDemoStartBlock(stream);
    U32 pos;
    stream->read(&pos); // notify count
    for(U32 i = 0; i < pos; i++)
@@ -1084,6 +1124,27 @@ bool NetConnection::readConnectAccept(BitStream *stream, const char **errorStrin
    return true;
 }
 
+void NetConnection::writeStringCompressionRequest(BitStream *stream)
+{
+   stream->writeFlag(gStringCompression);
+}
+
+void NetConnection::readStringCompressionRequest(BitStream *stream)
+{
+   // compress strings only if both sides want to
+   setStringCompression(stream->readFlag() && gStringCompression);
+}
+
+void NetConnection::writeStringCompressionAccept(BitStream *stream)
+{
+   stream->writeFlag(mStringDictionary != NULL);
+}
+
+void NetConnection::readStringCompressionAccept(BitStream *stream)
+{
+   setStringCompression(stream->readFlag());
+}
+
 ConsoleMethod(NetConnection, resolveGhostID, S32, 3, 3, "( S32 ghostID ) Convert a ghost id from this connection to a real id."
               "@return The ID as an integer")
 {
@@ -42,6 +42,10 @@
 #ifndef _H_CONNECTIONSTRINGTABLE
 #include "network/connectionStringTable.h"
 #endif
+
+#ifndef _CONNECTIONSTRINGDICTIONARY_H_
+#include "network/connectionStringDictionary.h"
+#endif
 //----------------------------------------------------------------------------
 // the sim connection encapsulates the packet stream,
 // ghost manager, event manager and playerPSC of the old tribes net code
@@ -409,6 +413,7 @@ public:
       GhostInfo *ghost;          ///< Reference to the GhostInfo we're from.
       GhostRef *nextRef;         ///< Next GhostRef in this packet.
       GhostRef *nextUpdateChain; ///< Next update we sent for this ghost.
+      U32 updateSequence;        ///< Sequence number of the update, see getGhostUpdateSequence().
    };
 
    enum Constants
@@ -652,6 +657,8 @@ public:
       GhostRef *ghostList;    ///< Linked list of ghost updates we sent in this packet.
       SubPacketRef *subList;  ///< Defined by subclass - used as desired.
 
+      bool stringDictionaryWritten; ///< Did this packet carry a string dictionary header?
+
       PacketNotify *nextPacket;  ///< Next packet sent.
       PacketNotify();
    };
@@ -732,6 +739,27 @@ public:
 
    void           packNetStringHandleU(BitStream *stream, NetStringHandle &h);
    NetStringHandle unpackNetStringHandleU(BitStream *stream);
+
+private:
+   /// Compresses the strings written to this connection's packets, if both
+   /// sides agreed to it when connecting.
+   ConnectionStringDictionary *mStringDictionary;
+
+   void setStringCompression(bool compress);
+protected:
+   /// @name String Compression Handshake
+   ///
+   /// Negotiates string compression while connecting. These are not part of
+   /// the base connect request and accept, so subclasses only call them once
+   /// they know the other side's protocol understands them.
+   /// @{
+   void writeStringCompressionRequest(BitStream *stream);
+   void readStringCompressionRequest(BitStream *stream);
+   void writeStringCompressionAccept(BitStream *stream);
+   void readStringCompressionAccept(BitStream *stream);
+   /// @}
+public:
+   bool isStringCompressed() { return mStringDictionary != NULL; }
 /// @}
 
 //----------------------------------------------------------------
@@ -759,6 +787,8 @@ protected:
    bool mGhosting;             ///< Am I currently ghosting objects?
    bool mScoping;              ///< am I currently scoping objects?
    U32  mGhostingSequence;     ///< Sequence number describing this ghosting session.
+   U32  mGhostUpdateSequence;  ///< Sequence number of the last ghost update written.
+   U32  mPackingGhostUpdate;   ///< Sequence number of the ghost update being packed, or zero.
 
    NetObject **mLocalGhosts;  ///< Local ghost for remote object.
                               ///
@@ -798,6 +828,13 @@ public:
 
    U32 getGhostsActive() { return mGhostsActive;};
 
+   /// Returns the sequence number of the ghost update currently being packed.
+   ///
+   /// This is zero when the update is not part of a ghost packet (ghost always
+   /// events and demo start blocks).  Otherwise NetObject::onGhostUpdateNotify()
+   /// is called with the same number once the packet is received or dropped.
+   U32 getGhostUpdateSequence() { return mPackingGhostUpdate; }
+
    /// Are we ghosting to someone?
    bool isGhostingTo() { return mLocalGhosts != NULL; };
 
@@ -176,6 +176,9 @@ void NetConnection::ghostPacketDropped(PacketNotify *notify)
       U32 orFlags = 0;
       AssertFatal(packRef->nextUpdateChain == NULL, "Out of order notify!!");
 
+      if(packRef->updateSequence && packRef->ghost->obj)
+         packRef->ghost->obj->onGhostUpdateNotify(this, packRef->updateSequence, false);
+
       // clear out the ref for this object, plus or together all
       // flags from updates after this
 
@@ -238,6 +241,9 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
 
       AssertFatal(packRef->nextUpdateChain == NULL, "Out of order notify!!");
 
+      if(packRef->updateSequence && packRef->ghost->obj)
+         packRef->ghost->obj->onGhostUpdateNotify(this, packRef->updateSequence, true);
+
       // clear this notify from the end of the object's notify
       // chain
 
@@ -262,22 +268,74 @@ void NetConnection::ghostPacketReceived(PacketNotify *notify)
    }
 }
 
-struct UpdateQueueEntry
+//-----------------------------------------------------------------------------
+// Ghost update scheduling.
+//
+// Only the ghosts that fit in a packet are ever sent, so rather than sorting
+// every dirty ghost each packet the ghosts are kept in a binary max-heap on
+// priority and popped until the packet is full.  The queue is shared by all
+// connections since packets are written one at a time.
+
+static Vector<GhostInfo *> sGhostUpdateQueue(__FILE__, __LINE__);
+
+static void siftDownGhostUpdate(GhostInfo **heap, S32 count, S32 index)
 {
-   F32 priority;
-   GhostInfo *obj;
+   GhostInfo *ghost = heap[index];
+   for(;;)
+   {
+      S32 child = index * 2 + 1;
+      if(child >= count)
+         break;
+      if(child + 1 < count && heap[child + 1]->priority > heap[child]->priority)
+         child++;
+      if(heap[child]->priority <= ghost->priority)
+         break;
+      heap[index] = heap[child];
+      index = child;
+   }
+   heap[index] = ghost;
+}
 
-   UpdateQueueEntry(F32 in_priority, GhostInfo *in_obj)
-      { priority = in_priority; obj = in_obj; }
-};
+static void buildGhostUpdateQueue(Vector<GhostInfo *> &queue)
+{
+   for(S32 i = queue.size() / 2 - 1; i >= 0; i--)
+      siftDownGhostUpdate(queue.address(), queue.size(), i);
+}
+
+static GhostInfo *popGhostUpdateQueue(Vector<GhostInfo *> &queue)
+{
+   GhostInfo *top = queue[0];
+   queue[0] = queue.last();
+   queue.decrement();
+   if(queue.size() > 1)
+      siftDownGhostUpdate(queue.address(), queue.size(), 0);
+   return top;
+}
 
-static S32 QSORT_CALLBACK UQECompare(const void *a,const void *b)
+static inline U32 hashScopeValue(U32 key, F32 value)
 {
-   GhostInfo *ga = *((GhostInfo **) a);
-   GhostInfo *gb = *((GhostInfo **) b);
+   U32 bits;
+   dMemcpy(&bits, &value, sizeof(bits));
+   return (key ^ bits) * 16777619u;
+}
 
-   F32 ret = ga->priority - gb->priority;
-   return (ret < 0) ? -1 : ((ret > 0) ? 1 : 0);
+/// Connections with the same scope key share their update priorities.
+///
+/// The key only covers what the scope query describes, not which object
+/// answered it, so connections viewing from the same place share it even
+/// when each has its own camera object.
+static U32 getScopeKey(const CameraScopeQuery &camInfo)
+{
+   U32 key = 2166136261u;
+   key = hashScopeValue(key, camInfo.pos.x);
+   key = hashScopeValue(key, camInfo.pos.y);
+   key = hashScopeValue(key, camInfo.pos.z);
+   key = hashScopeValue(key, camInfo.orientation.x);
+   key = hashScopeValue(key, camInfo.orientation.y);
+   key = hashScopeValue(key, camInfo.orientation.z);
+   key = hashScopeValue(key, camInfo.fov);
+   key = hashScopeValue(key, camInfo.visibleDistance);
+   return key;
 }
 
 void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
@@ -338,6 +396,10 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          detachObject(mGhostArray[i]);
    }
 
+   const U32 scopeKey = getScopeKey(camInfo);
+   sGhostUpdateQueue.clear();
+   sGhostUpdateQueue.reserve(mGhostZeroUpdateIndex);
+
    for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
    {
       walk = mGhostArray[i];
@@ -351,23 +413,21 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          continue;
       }
       // don't do any ghost processing on objects that are being killed
-      // or in the process of ghosting
+      // or in the process of ghosting, they are not sent
       else if(!(walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting)))
       {
          if(walk->flags & GhostInfo::KillGhost)
             walk->priority = 10000;
          else
-            walk->priority = walk->obj->getUpdatePriority(&camInfo, walk->updateMask, walk->updateSkipCount);
+            walk->priority = walk->obj->getScheduledUpdatePriority(&camInfo, scopeKey, walk->updateMask, walk->updateSkipCount);
+
+         sGhostUpdateQueue.push_back(walk);
       }
       else
          walk->priority = 0;
    }
    GhostRef *updateList = NULL;
-   dQsort(mGhostArray, mGhostZeroUpdateIndex, sizeof(GhostInfo *), UQECompare);
-
-   // reset the array indices...
-   for(i = mGhostZeroUpdateIndex - 1; i >= 0; i--)
-      mGhostArray[i]->arrayIndex = i;
+   buildGhostUpdateQueue(sGhostUpdateQueue);
 
    S32 sendSize = 1;
    while(maxIndex >>= 1)
@@ -380,12 +440,10 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
    U32 count = 0;
    //
-   for(i = mGhostZeroUpdateIndex - 1; i >= 0 && !bstream->isFull(); i--)
+   while(sGhostUpdateQueue.size() && !bstream->isFull())
    {
-      GhostInfo *walk = mGhostArray[i];
-        if(walk->flags & (GhostInfo::KillingGhost | GhostInfo::Ghosting))
-           continue;
-        
+      GhostInfo *walk = popGhostUpdateQueue(sGhostUpdateQueue);
+
       bstream->writeFlag(true);
 
       bstream->writeInt(walk->index, sendSize);
@@ -400,6 +458,7 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
 
       upd->ghost = walk;
       upd->ghostInfoFlags = 0;
+      upd->updateSequence = 0;
 
       if(walk->flags & GhostInfo::KillGhost)
       {
@@ -434,7 +493,11 @@ void NetConnection::ghostWritePacket(BitStream *bstream, PacketNotify *notify)
          }
 #endif
          // update the object
+         if(!++mGhostUpdateSequence)
+            ++mGhostUpdateSequence;
+         upd->updateSequence = mPackingGhostUpdate = mGhostUpdateSequence;
          U32 retMask = walk->obj->packUpdate(this, updateMask, bstream);
+         mPackingGhostUpdate = 0;
          DEBUG_LOG(("PKLOG %d GHOST %d: %s", getId(), bstream->getCurPos() - 16 - startPos, walk->obj->getClassName()));
 
          AssertFatal((retMask & (~updateMask)) == 0, "Cannot set new bits in packUpdate return");
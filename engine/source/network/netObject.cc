@@ -40,6 +40,11 @@ NetObject::NetObject()
    mPrevDirtyList = NULL;
    mNextDirtyList = NULL;
    mDirtyMaskBits = 0;
+   mPriorityCache = 0.0f;
+   mPriorityCacheTime = SimTime(-1);
+   mPriorityCacheScope = 0;
+   mPriorityCacheMask = 0;
+   mPriorityCacheSkips = 0;
 }
 
 NetObject::~NetObject()
@@ -240,6 +245,25 @@ F32 NetObject::getUpdatePriority(CameraScopeQuery*, U32, S32 updateSkips)
    return F32(updateSkips) * 0.1f;
 }
 
+F32 NetObject::getScheduledUpdatePriority(CameraScopeQuery *focusObject, U32 scopeKey, U32 updateMask, S32 updateSkips)
+{
+   if(!mNetFlags.test(CachedPriority))
+      return getUpdatePriority(focusObject, updateMask, updateSkips);
+
+   // another connection with the same scope may have already asked this tick
+   const SimTime currentTime = Sim::getCurrentTime();
+   if(mPriorityCacheTime == currentTime && mPriorityCacheScope == scopeKey &&
+      mPriorityCacheMask == updateMask && mPriorityCacheSkips == updateSkips)
+      return mPriorityCache;
+
+   mPriorityCache = getUpdatePriority(focusObject, updateMask, updateSkips);
+   mPriorityCacheTime = currentTime;
+   mPriorityCacheScope = scopeKey;
+   mPriorityCacheMask = updateMask;
+   mPriorityCacheSkips = updateSkips;
+   return mPriorityCache;
+}
+
 U32 NetObject::packUpdate(NetConnection* conn, U32 mask, BitStream* stream)
 {
    return 0;
@@ -253,6 +253,20 @@ private:
    NetObject *mNextDirtyList;
 
    /// @}
+
+   /// @name Update Priority Cache
+   ///
+   /// The last priority returned by getUpdatePriority(), so that connections
+   /// with an identical scope can share it during a sim tick.
+   /// @{
+
+   F32 mPriorityCache;
+   SimTime mPriorityCacheTime;
+   U32 mPriorityCacheScope;
+   U32 mPriorityCacheMask;
+   S32 mPriorityCacheSkips;
+
+   /// @}
 protected:
 
    /// Pointer to the server object; used only when we are doing "short-circuited" networking.
@@ -275,6 +289,7 @@ protected:
       ScopeAlways       =  BIT(6),  ///< Object always ghosts to clients.
       ScopeLocal        =  BIT(7),  ///< Ghost only to local client.
       Ghostable         =  BIT(8),  ///< Set if this object CAN ghost.
+      CachedPriority    =  BIT(9),  ///< Set if getUpdatePriority() may be shared by connections with the same scope.
 
       MaxNetFlagBit     =  15
    };
@@ -327,7 +342,8 @@ public:
    /// updated objects are more likely to be updated.
    ///
    /// In subclasses, this can be adjusted. For instance, ShapeBase provides priority
-   /// based on proximity to the camera.
+   /// based on proximity to the camera. Subclasses whose priority only depends on the
+   /// connection's scope can set the CachedPriority net flag to share the result.
    ///
    /// @param  focusObject    Information from a previous call to onCameraScopeQuery.
    /// @param  updateMask     Current update mask.
@@ -335,6 +351,18 @@ public:
    /// @returns A floating point value indicating priority. These are typically < 5.0.
    virtual F32 getUpdatePriority(CameraScopeQuery *focusObject, U32 updateMask, S32 updateSkips);
 
+   /// Returns the update priority used by the ghost scheduler.
+   ///
+   /// This calls getUpdatePriority(). Objects with the CachedPriority flag instead cache
+   /// the result and share it between connections that have the same scope key during
+   /// the current sim tick.
+   ///
+   /// @param  focusObject    Information from a previous call to onCameraScopeQuery.
+   /// @param  scopeKey       Key identifying the connection's scope.
+   /// @param  updateMask     Current update mask.
+   /// @param  updateSkips    Number of ticks we haven't been updated for.
+   F32 getScheduledUpdatePriority(CameraScopeQuery *focusObject, U32 scopeKey, U32 updateMask, S32 updateSkips);
+
    /// Instructs this object to pack its state for transfer over the network.
    ///
    /// @param   conn    Net connection being used
@@ -351,6 +379,16 @@ public:
    /// @param   stream  stream to read from
    virtual void unpackUpdate(NetConnection * conn, BitStream *stream);
 
+   /// Called when a packet carrying an update of this object is received or dropped.
+   ///
+   /// Objects that delta-encode their updates use this to track the state the
+   /// remote ghost has acknowledged.
+   ///
+   /// @param   conn      Net connection the update was sent on.
+   /// @param   sequence  Value of NetConnection::getGhostUpdateSequence() during packUpdate.
+   /// @param   received  True if the packet was received, false if it was dropped.
+   virtual void onGhostUpdateNotify(NetConnection *conn, U32 sequence, bool received) {}
+
    /// Queries the object about information used to determine scope.
    ///
    /// Something that is 'in scope' is somehow interesting to the client.
@@ -23,8 +23,8 @@
 #ifndef _TAML_BINARYREADER_H_
 #define _TAML_BINARYREADER_H_
 
-#ifndef _HASHTABLE_H
-#include "collection/hashTable.h"
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
 #endif
 
 #ifndef _TAML_H_
@@ -50,7 +50,7 @@ private:
     Taml*               mpTaml;
     StringTableEntry    mTamlObjectName;
 
-    typedef HashMap<SimObjectId, SimObject*> typeObjectReferenceHash;
+    typedef FlatHashMap<SimObjectId, SimObject*> typeObjectReferenceHash;
 
     typeObjectReferenceHash mObjectReferenceMap;
 
@@ -23,8 +23,8 @@
 #ifndef _TAML_XMLREADER_H_
 #define _TAML_XMLREADER_H_
 
-#ifndef _HASHTABLE_H
-#include "collection/hashTable.h"
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
 #endif
 
 #ifndef _TAML_H_
@@ -61,7 +61,7 @@ private:
     StringTableEntry    mTamlObjectName;
     StringTableEntry    mTamlRefField;
 
-    typedef HashMap<SimObjectId, SimObject*> typeObjectReferenceHash;
+    typedef FlatHashMap<SimObjectId, SimObject*> typeObjectReferenceHash;
 
     typeObjectReferenceHash mObjectReferenceMap;
 
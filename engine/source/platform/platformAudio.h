@@ -85,7 +85,7 @@ class AudioEnvironment;
 class AudioSampleEnvironment;
 class AudioStreamSource;
 
-AUDIOHANDLE alxCreateSource(const Audio::Description *desc, const char *filename, const MatrixF *transform=NULL, AudioSampleEnvironment * sampleEnvironment = 0);
+AUDIOHANDLE alxCreateSource(const Audio::Description& desc, const char *filename, const MatrixF *transform=NULL, AudioSampleEnvironment * sampleEnvironment = 0);
 AUDIOHANDLE alxCreateSource(AudioDescription *descObject, const char *filename, const MatrixF *transform=NULL, AudioSampleEnvironment * sampleEnvironment = 0);
 AUDIOHANDLE alxCreateSource(const AudioAsset *profile, const MatrixF *transform=NULL);
 AudioStreamSource* alxFindAudioStreamSource(AUDIOHANDLE handle);
@@ -161,6 +161,7 @@ void alxUpdateTypeGain(U32 type);
 bool alxIsValidHandle(AUDIOHANDLE handle);
 bool alxIsPlaying(AUDIOHANDLE handle);
 void alxUpdate();
+void alxLoadingUpdate();
 F32 alxGetStreamPosition( AUDIOHANDLE handle );
 F32 alxGetStreamDuration( AUDIOHANDLE handle );
 
@@ -36,6 +36,7 @@ enum CPUFlags
    BIT_RDTSC   = BIT(4),
    BIT_MMX     = BIT(23),
    BIT_SSE     = BIT(25),
+   BIT_SSE2    = BIT(26),
    BIT_3DNOW   = BIT(31),
 };
 
@@ -50,6 +51,7 @@ void SetProcessorInfo(TorqueSystemInfo::Processor& pInfo,
    if (dStricmp(vendor, "GenuineIntel") == 0)
    {
       pInfo.properties |= (properties & BIT_SSE) ? CPU_PROP_SSE : 0;
+      pInfo.properties |= (properties & BIT_SSE2) ? CPU_PROP_SSE2 : 0;
       pInfo.type = CPU_Intel_Unknown;
       // switch on processor family code
       switch ((processor >> 8) & 0x0f)
@@ -131,6 +133,7 @@ void SetProcessorInfo(TorqueSystemInfo::Processor& pInfo,
       {
          // AthlonXP processors support SSE
          pInfo.properties |= (properties & BIT_SSE) ? CPU_PROP_SSE : 0;
+         pInfo.properties |= (properties & BIT_SSE2) ? CPU_PROP_SSE2 : 0;
          pInfo.properties |= (properties & BIT_3DNOW) ? CPU_PROP_3DNOW : 0;
          // switch on processor family code
          switch ((processor >> 8) & 0xf)
@@ -75,8 +75,8 @@ enum x86Properties
     CPU_PROP_MMX       = (1<<2),     // Integer-SIMD
     CPU_PROP_3DNOW     = (1<<3),     // AMD Float-SIMD
     CPU_PROP_SSE       = (1<<4),     // PentiumIII SIMD
-    CPU_PROP_RDTSC     = (1<<5)     // Read Time Stamp Counter
-    //   CPU_PROP_SSE2      = (1<<6),   // Pentium4 SIMD
+    CPU_PROP_RDTSC     = (1<<5),    // Read Time Stamp Counter
+    CPU_PROP_SSE2      = (1<<6)     // Pentium4 SIMD
     //   CPU_PROP_MP        = (1<<7)      // Multi-processor system
 };
 
@@ -107,6 +107,7 @@ struct TorqueSystemInfo
         const char *name;
         U32         mhz;
         U32         properties;      // CPU type specific enum
+        U32         numLogicalProcessors; // 0 when the platform could not tell
     } processor;
 };
 
@@ -25,26 +25,1335 @@
 #include "console/console.h"
 #include "debug/profiler.h"
 #include "platform/threads/mutex.h"
+#include "platform/threads/atomic.h"
 #include "math/mMath.h"
 #include <stdlib.h>
 
+#if defined(TORQUE_POOLED_ALLOCATOR)
+#if defined(TORQUE_OS_WIN32) || defined(TORQUE_OS_LINUX)
+#include <malloc.h>
+#elif defined(TORQUE_OS_MAC) || defined(TORQUE_OS_OSX) || defined(TORQUE_OS_IOS)
+#include <malloc/malloc.h>
+#endif
+#endif
+
+#if defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR)
+#include <new>
+#endif
+
+#if defined(TORQUE_TRACK_MEMORY)
+#if defined(TORQUE_COMPILER_VISUALC)
+#include <intrin.h>
+#pragma intrinsic(_ReturnAddress)
+#define MEMORY_RETURN_ADDRESS() _ReturnAddress()
+#else
+#define MEMORY_RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+#endif
+
+#if defined(TORQUE_TRACK_MEMORY) && (defined(TORQUE_OS_LINUX) || defined(TORQUE_OS_OSX) || defined(TORQUE_OS_MAC))
+#include <execinfo.h>
+#define TORQUE_MEMORY_STACK_SAMPLES
+#endif
+
+#if defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR)
+#if defined(TORQUE_COMPILER_VISUALC)
+#define MEMORY_THREAD_LOCAL __declspec(thread)
+#else
+#define MEMORY_THREAD_LOCAL __thread
+#endif
+#endif
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_POOLED_ALLOCATOR
+
+namespace MemoryPool
+{
+   enum PoolConstants
+   {
+      SlabSize          = 64 * 1024,
+      MaxBlockSize      = 256,
+      ClassCount        = MaxClassCount,
+      CacheLimit        = 64,       ///< Blocks a thread keeps per class before returning some.
+      TransferCount     = 32,       ///< Blocks moved between a thread and the central lists at once.
+      SlabTableSize     = 65536,
+      MaxThreads        = 64,
+   };
+
+   static const U32 smClassSizes[ClassCount] = { 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256 };
+
+   /// Size class for each 16 byte granule count.
+   static const U8 smGranuleClasses[MaxBlockSize / 16 + 1] = { 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11 };
+
+   struct FreeBlock
+   {
+      FreeBlock* next;
+   };
+
+   struct SizeClass
+   {
+      volatile U32 lock;
+      FreeBlock* freeList;
+      U8* bumpStart;
+      U8* bumpEnd;
+      U32 slabCount;
+      U32 uncachedAllocs;
+      U32 uncachedFrees;
+   };
+
+   struct ThreadCache
+   {
+      FreeBlock* freeList[ClassCount];
+      U32 freeCount[ClassCount];
+      U32 allocs[ClassCount];
+      U32 frees[ClassCount];
+   };
+
+   static bool            gEnabled = true;
+   static SizeClass       gClasses[ClassCount];
+
+   // Slab base addresses, tagged with their size class + 1 in the low bits.
+   // Entries are only ever added, so lookups need no lock.
+   static volatile size_t gSlabTable[SlabTableSize];
+   static U32             gSlabCount = 0;
+   static volatile U32    gSlabLock = 0;
+
+   static ThreadCache*    gCaches[MaxThreads];
+   static bool            gCacheFree[MaxThreads];
+   static volatile U32    gCacheCount = 0;
+   static volatile U32    gCacheLock = 0;
+
+   static MEMORY_THREAD_LOCAL ThreadCache* tCache = NULL;
+   static MEMORY_THREAD_LOCAL bool tCacheFailed = false;
+
+   //--------------------------------------------------------------------------
+
+   static void lock(volatile U32& ref)
+   {
+      while(!dCompareAndSwap(ref, 0, 1))
+         ;
+   }
+
+   static void unlock(volatile U32& ref)
+   {
+      dAtomicWrite(ref, 0);
+   }
+
+   static U32 hashSlab(size_t base)
+   {
+      return U32((base / SlabSize) * 2654435761u) & (SlabTableSize - 1);
+   }
+
+   /// The size class of a pooled block, or -1 for a block from the system allocator.
+   static S32 findClass(const void* ptr)
+   {
+      const size_t base = size_t(ptr) & ~size_t(SlabSize - 1);
+      for(U32 index = hashSlab(base); ; index = (index + 1) & (SlabTableSize - 1))
+      {
+         const size_t entry = gSlabTable[index];
+         if(!entry)
+            return -1;
+         if((entry & ~size_t(SlabSize - 1)) == base)
+            return S32(entry & (SlabSize - 1)) - 1;
+      }
+   }
+
+   /// Gets a new slab for a size class.  The class lock must be held.
+   static bool allocSlab(U32 sizeClass)
+   {
+      lock(gSlabLock);
+      if(gSlabCount >= SlabTableSize / 2)
+      {
+         unlock(gSlabLock);
+         return false;
+      }
+
+      void* slab = NULL;
+#if defined(TORQUE_OS_WIN32)
+      slab = _aligned_malloc(SlabSize, SlabSize);
+#else
+      if(posix_memalign(&slab, SlabSize, SlabSize))
+         slab = NULL;
+#endif
+      if(!slab)
+      {
+         unlock(gSlabLock);
+         return false;
+      }
+
+      U32 index = hashSlab(size_t(slab));
+      while(gSlabTable[index])
+         index = (index + 1) & (SlabTableSize - 1);
+      dMemoryBarrier();
+      gSlabTable[index] = size_t(slab) | (sizeClass + 1);
+      gSlabCount++;
+      unlock(gSlabLock);
+
+      SizeClass& sc = gClasses[sizeClass];
+      sc.bumpStart = (U8*)slab;
+      sc.bumpEnd = (U8*)slab + SlabSize;
+      sc.slabCount++;
+      return true;
+   }
+
+   /// Takes up to count blocks from a size class.  The class lock must be held.
+   static FreeBlock* takeBlocks(U32 sizeClass, U32 count, U32& taken)
+   {
+      SizeClass& sc = gClasses[sizeClass];
+      const U32 blockSize = smClassSizes[sizeClass];
+
+      FreeBlock* head = NULL;
+      taken = 0;
+      while(taken < count)
+      {
+         FreeBlock* block = sc.freeList;
+         if(block)
+         {
+            sc.freeList = block->next;
+         }
+         else
+         {
+            if(sc.bumpStart + blockSize > sc.bumpEnd && !allocSlab(sizeClass))
+               break;
+            block = (FreeBlock*)sc.bumpStart;
+            sc.bumpStart += blockSize;
+         }
+         block->next = head;
+         head = block;
+         taken++;
+      }
+      return head;
+   }
+
+   static ThreadCache* getThreadCache()
+   {
+      if(tCache || tCacheFailed)
+         return tCache;
+
+      ThreadCache* cache = NULL;
+      lock(gCacheLock);
+
+      // Reuse the cache of a thread that has exited.
+      for(U32 i = 0; i < gCacheCount && !cache; i++)
+      {
+         if(gCacheFree[i])
+         {
+            gCacheFree[i] = false;
+            cache = gCaches[i];
+         }
+      }
+
+      if(!cache && gCacheCount < MaxThreads)
+      {
+         cache = (ThreadCache*)calloc(1, sizeof(ThreadCache));
+         gCaches[gCacheCount] = cache;
+         dMemoryBarrier();
+         gCacheCount++;
+      }
+      unlock(gCacheLock);
+
+      // Threads beyond the limit go straight to the central lists.
+      if(!cache)
+      {
+         tCacheFailed = true;
+         return NULL;
+      }
+
+      tCache = cache;
+      return tCache;
+   }
+
+   /// Returns the blocks cached by the calling thread to the central lists and
+   /// frees its cache for the next thread.  Called as the thread exits.
+   static void releaseThreadCache()
+   {
+      ThreadCache* cache = tCache;
+      tCache = NULL;
+      tCacheFailed = false;
+      if(!cache)
+         return;
+
+      for(U32 sizeClass = 0; sizeClass < ClassCount; sizeClass++)
+      {
+         SizeClass& sc = gClasses[sizeClass];
+         FreeBlock* first = cache->freeList[sizeClass];
+
+         lock(sc.lock);
+         if(first)
+         {
+            FreeBlock* last = first;
+            while(last->next)
+               last = last->next;
+            last->next = sc.freeList;
+            sc.freeList = first;
+         }
+
+         // Keep the thread's counts in the stats.
+         sc.uncachedAllocs += cache->allocs[sizeClass];
+         sc.uncachedFrees += cache->frees[sizeClass];
+         unlock(sc.lock);
+      }
+      dMemset(cache, 0, sizeof(ThreadCache));
+
+      lock(gCacheLock);
+      for(U32 i = 0; i < gCacheCount; i++)
+      {
+         if(gCaches[i] == cache)
+            gCacheFree[i] = true;
+      }
+      unlock(gCacheLock);
+   }
+
+   /// The usable size of a block from the system allocator, or 0 if the system cannot tell.
+   static dsize_t getSystemBlockSize(void* ptr)
+   {
+#if defined(TORQUE_OS_WIN32)
+      return dsize_t(_msize(ptr));
+#elif defined(TORQUE_OS_MAC) || defined(TORQUE_OS_OSX) || defined(TORQUE_OS_IOS)
+      return dsize_t(malloc_size(ptr));
+#elif defined(TORQUE_OS_LINUX)
+      return dsize_t(malloc_usable_size(ptr));
+#else
+      return 0;
+#endif
+   }
+
+   //--------------------------------------------------------------------------
+
+   static void* alloc(dsize_t size)
+   {
+      if(size > MaxBlockSize || !gEnabled)
+         return malloc(size);
+
+      const U32 sizeClass = smGranuleClasses[(size + 15) >> 4];
+      ThreadCache* cache = getThreadCache();
+      if(!cache)
+      {
+         SizeClass& sc = gClasses[sizeClass];
+         U32 taken;
+         lock(sc.lock);
+         FreeBlock* block = takeBlocks(sizeClass, 1, taken);
+         if(block)
+            sc.uncachedAllocs++;
+         unlock(sc.lock);
+         return block;
+      }
+
+      FreeBlock* block = cache->freeList[sizeClass];
+      if(!block)
+      {
+         SizeClass& sc = gClasses[sizeClass];
+         U32 taken;
+         lock(sc.lock);
+         block = takeBlocks(sizeClass, TransferCount, taken);
+         unlock(sc.lock);
+         if(!block)
+            return NULL;
+         cache->freeCount[sizeClass] = taken;
+      }
+
+      cache->freeList[sizeClass] = block->next;
+      cache->freeCount[sizeClass]--;
+      cache->allocs[sizeClass]++;
+      return block;
+   }
+
+   static void free(void* ptr)
+   {
+      if(!ptr)
+         return;
+
+      const S32 sizeClass = findClass(ptr);
+      if(sizeClass < 0)
+      {
+         ::free(ptr);
+         return;
+      }
+
+      FreeBlock* block = (FreeBlock*)ptr;
+      SizeClass& sc = gClasses[sizeClass];
+      ThreadCache* cache = getThreadCache();
+      if(!cache)
+      {
+         lock(sc.lock);
+         block->next = sc.freeList;
+         sc.freeList = block;
+         sc.uncachedFrees++;
+         unlock(sc.lock);
+         return;
+      }
+
+      block->next = cache->freeList[sizeClass];
+      cache->freeList[sizeClass] = block;
+      cache->frees[sizeClass]++;
+      if(++cache->freeCount[sizeClass] <= CacheLimit)
+         return;
+
+      // Return a batch so memory freed by one thread can be reused by others.
+      FreeBlock* first = cache->freeList[sizeClass];
+      FreeBlock* last = first;
+      for(U32 i = 1; i < TransferCount; i++)
+         last = last->next;
+      cache->freeList[sizeClass] = last->next;
+      cache->freeCount[sizeClass] -= TransferCount;
+
+      lock(sc.lock);
+      last->next = sc.freeList;
+      sc.freeList = first;
+      unlock(sc.lock);
+   }
+
+   static void* realloc(void* ptr, dsize_t size)
+   {
+      if(!ptr)
+         return alloc(size);
+
+      const S32 sizeClass = findClass(ptr);
+      if(sizeClass < 0)
+      {
+         const dsize_t oldSize = size > MaxBlockSize || !gEnabled ? 0 : getSystemBlockSize(ptr);
+         if(!oldSize)
+            return ::realloc(ptr, size);
+
+         // Small system blocks allocated while the pools were disabled can be
+         // smaller than the new size, so only copy what the old block holds.
+         void* result = alloc(size);
+         if(result)
+         {
+            dMemcpy(result, ptr, oldSize < size ? oldSize : size);
+            ::free(ptr);
+         }
+         return result;
+      }
+
+      if(size <= smClassSizes[sizeClass])
+         return ptr;
+
+      void* result = alloc(size);
+      if(result)
+      {
+         dMemcpy(result, ptr, smClassSizes[sizeClass]);
+         free(ptr);
+      }
+      return result;
+   }
+
+   //--------------------------------------------------------------------------
+
+   void setEnabled(bool enabled)
+   {
+      gEnabled = enabled;
+   }
+
+   bool isEnabled()
+   {
+      return gEnabled;
+   }
+
+   bool isPooled(const void* ptr)
+   {
+      return ptr && findClass(ptr) >= 0;
+   }
+
+   void getStats(Stats* stats)
+   {
+      dMemset(stats, 0, sizeof(Stats) * ClassCount);
+
+      const U32 cacheCount = getMin(dAtomicRead(gCacheCount), U32(MaxThreads));
+      for(U32 sizeClass = 0; sizeClass < ClassCount; sizeClass++)
+      {
+         Stats& classStats = stats[sizeClass];
+         SizeClass& sc = gClasses[sizeClass];
+
+         lock(sc.lock);
+         classStats.blockSize = smClassSizes[sizeClass];
+         classStats.slabCount = sc.slabCount;
+         classStats.allocs = sc.uncachedAllocs;
+         classStats.frees = sc.uncachedFrees;
+         unlock(sc.lock);
+
+         for(U32 i = 0; i < cacheCount; i++)
+         {
+            const ThreadCache* cache = gCaches[i];
+            if(!cache)
+               continue;
+            classStats.allocs += cache->allocs[sizeClass];
+            classStats.frees += cache->frees[sizeClass];
+         }
+      }
+   }
+
+   U32 getClassCount()
+   {
+      return ClassCount;
+   }
+}
+
+#define MEMORY_BLOCK_ALLOC(size)          MemoryPool::alloc(size)
+#define MEMORY_BLOCK_REALLOC(ptr, size)   MemoryPool::realloc(ptr, size)
+#define MEMORY_BLOCK_FREE(ptr)            MemoryPool::free(ptr)
+
+#else
+
+#define MEMORY_BLOCK_ALLOC(size)          malloc(size)
+#define MEMORY_BLOCK_REALLOC(ptr, size)   realloc(ptr, size)
+#define MEMORY_BLOCK_FREE(ptr)            free(ptr)
+
+#endif // TORQUE_POOLED_ALLOCATOR
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TRACK_MEMORY
+
+namespace Memory
+{
+   enum Constants
+   {
+      MaxSites          = 4096,
+      SiteHashSize      = 8192,
+      SiteCacheSize     = 512,
+      MaxTags           = 64,
+      MaxThreads        = 64,
+      MaxStackSamples   = 256,
+      MaxStackDepth     = 16,
+
+      UntrackedSite     = 0xFFFF,
+      HeaderMagic       = 0x4D454D54,
+      HeaderSpace       = 16,       ///< Bytes reserved in front of every block for its Header.
+   };
+
+   /// Prepended to every block.  HeaderSpace bytes are reserved for it whatever
+   /// its size, which keeps the block aligned the way malloc aligns it.
+   struct Header
+   {
+      dsize_t size;
+      U16 site;
+      U16 tag;
+      U32 magic;
+   };
+
+   /// Call sites of the global new operator are only known by the address
+   /// they return to, which stands in for the line number.
+   static const char NewSiteFile[] = "<new>";
+
+   struct SiteCacheEntry
+   {
+      const char* file;
+      U32 line;
+      U32 site;
+   };
+
+   /// Counters owned by a single thread.  Frees are counted by the freeing thread,
+   /// so a thread's live counts can go negative; only the sum over all threads
+   /// is meaningful.
+   struct ThreadCounters
+   {
+      S64 siteBytes[MaxSites];
+      S32 siteCount[MaxSites];
+      U32 siteAllocs[MaxSites];
+      S64 tagBytes[MaxTags];
+      S64 tagCount[MaxTags];
+      U32 tagAllocs[MaxTags];
+      U32 sampleCountdown;
+      SiteCacheEntry siteCache[SiteCacheSize];
+   };
+
+   struct StackSample
+   {
+      dsize_t size;
+      U32 site;
+      U32 depth;
+      void* frames[MaxStackDepth];
+   };
+
+   static bool            gTrackingEnabled = true;
+   static U32             gStackSampleInterval = 0;
+
+   static volatile U32    gLock = 0;
+
+   static const char*     gSiteFiles[MaxSites];
+   static U32             gSiteLines[MaxSites];
+   static const void*     gSiteAddresses[MaxSites];
+   static U32             gSiteTags[MaxSites];
+   static U32             gSiteCount = 0;
+   static U16             gSiteHash[SiteHashSize];
+
+   static char*           gTagNames[MaxTags];
+   static U32             gTagCount = 0;
+
+   static ThreadCounters* gThreads[MaxThreads];
+   static bool            gThreadSlotFree[MaxThreads];
+   static U32             gThreadCount = 0;
+   static ThreadCounters* gSharedCounters = NULL;
+   static ThreadCounters  gRetiredCounters;        ///< Counts of the threads that have exited.
+
+   static StackSample     gStackSamples[MaxStackSamples];
+   static U32             gStackSampleCount = 0;
+
+   static MEMORY_THREAD_LOCAL ThreadCounters* tCounters = NULL;
+   static MEMORY_THREAD_LOCAL U32 tCurrentTag = 0;
+
+   //--------------------------------------------------------------------------
+
+   // The tracker runs underneath everything else, including the Mutex class, so
+   // it guards its rarely changed tables with a plain spin lock.
+   static void lock()
+   {
+      while(!dCompareAndSwap(gLock, 0, 1))
+         ;
+   }
+
+   static void unlock()
+   {
+      dAtomicWrite(gLock, 0);
+   }
+
+   //--------------------------------------------------------------------------
+
+   /// Finds a tag by name, creating it if needed.  The lock must be held.
+   static U32 findTag(const char* name, U32 length)
+   {
+      for(U32 i = 0; i < gTagCount; i++)
+      {
+         if(!dStrncmp(gTagNames[i], name, length) && gTagNames[i][length] == 0)
+            return i;
+      }
+      if(gTagCount == MaxTags)
+         return 0;
+
+      char* copy = (char*)malloc(length + 1);
+      dMemcpy(copy, name, length);
+      copy[length] = 0;
+      gTagNames[gTagCount] = copy;
+      return gTagCount++;
+   }
+
+   /// The path of a call site from the engine source directory on, so that
+   /// reports from different machines compare.
+   static const char* getSitePath(const char* file)
+   {
+      const char* path = file;
+      for(const char* walk = file; *walk; walk++)
+      {
+         if((walk[0] == '/' || walk[0] == '\\') && !dStrncmp(walk + 1, "source", 6) && (walk[7] == '/' || walk[7] == '\\'))
+            path = walk + 8;
+      }
+      return path;
+   }
+
+   /// Tags a call site by the top level engine directory it is in.
+   static U32 getSiteTag(const char* file)
+   {
+      const char* path = getSitePath(file);
+      U32 length = 0;
+      while(path[length] && path[length] != '/' && path[length] != '\\')
+         length++;
+      if(!path[length])
+         return findTag("other", 5);
+      return findTag(path, length);
+   }
+
+   static U32 hashSite(const char* file, U32 line)
+   {
+      U32 hash = 2166136261u ^ line;
+      for(const char* walk = file; *walk; walk++)
+         hash = (hash ^ U8(*walk)) * 16777619u;
+      return hash;
+   }
+
+   /// Finds a call site by name, creating it if needed.  The address is kept
+   /// for sites of the global new operator so the report can name them.
+   static U32 findSite(const char* file, U32 line, const void* address)
+   {
+      if(!file)
+         return 0;
+
+      lock();
+      U32 slot = hashSite(file, line) & (SiteHashSize - 1);
+      while(gSiteHash[slot])
+      {
+         U32 site = gSiteHash[slot] - 1;
+         if(gSiteLines[site] == line && !dStrcmp(gSiteFiles[site], file))
+         {
+            unlock();
+            return site;
+         }
+         slot = (slot + 1) & (SiteHashSize - 1);
+      }
+
+      U32 site = 0;
+      if(gSiteCount < MaxSites)
+      {
+         site = gSiteCount++;
+         gSiteFiles[site] = file;
+         gSiteLines[site] = line;
+         gSiteAddresses[site] = address;
+         gSiteTags[site] = file == NewSiteFile ? findTag("other", 5) : getSiteTag(file);
+         gSiteHash[slot] = U16(site + 1);
+      }
+      unlock();
+      return site;
+   }
+
+   //--------------------------------------------------------------------------
+
+   static ThreadCounters* getThreadCounters()
+   {
+      if(tCounters)
+         return tCounters;
+
+      ThreadCounters* counters = NULL;
+
+      lock();
+      if(gSiteCount == 0)
+      {
+         // site 0 collects allocations from unknown or overflowing call sites.
+         gSiteFiles[0] = "<unknown>";
+         gSiteLines[0] = 0;
+         gSiteTags[0] = findTag("other", 5);
+         gSiteCount = 1;
+      }
+
+      // Reuse the slot of a thread that has exited.
+      for(U32 i = 0; i < gThreadCount && !counters; i++)
+      {
+         if(gThreadSlotFree[i])
+         {
+            gThreadSlotFree[i] = false;
+            counters = gThreads[i];
+         }
+      }
+
+      if(!counters && gThreadCount < MaxThreads)
+      {
+         counters = (ThreadCounters*)calloc(1, sizeof(ThreadCounters));
+         gThreads[gThreadCount++] = counters;
+      }
+      else if(!counters)
+      {
+         // Too many threads; the rest share one block and may lose the odd count.
+         if(!gSharedCounters)
+            gSharedCounters = (ThreadCounters*)calloc(1, sizeof(ThreadCounters));
+         counters = gSharedCounters;
+      }
+      unlock();
+
+      tCounters = counters;
+      return counters;
+   }
+
+   /// Folds the counters of the calling thread into the retired counters and
+   /// frees its slot for the next thread.  Called as the thread exits.
+   static void releaseThreadCounters()
+   {
+      ThreadCounters* counters = tCounters;
+      tCounters = NULL;
+      if(!counters || counters == gSharedCounters)
+         return;
+
+      lock();
+      for(U32 site = 0; site < MaxSites; site++)
+      {
+         gRetiredCounters.siteBytes[site] += counters->siteBytes[site];
+         gRetiredCounters.siteCount[site] += counters->siteCount[site];
+         gRetiredCounters.siteAllocs[site] += counters->siteAllocs[site];
+      }
+      for(U32 tag = 0; tag < MaxTags; tag++)
+      {
+         gRetiredCounters.tagBytes[tag] += counters->tagBytes[tag];
+         gRetiredCounters.tagCount[tag] += counters->tagCount[tag];
+         gRetiredCounters.tagAllocs[tag] += counters->tagAllocs[tag];
+      }
+      dMemset(counters, 0, sizeof(ThreadCounters));
+
+      for(U32 i = 0; i < gThreadCount; i++)
+      {
+         if(gThreads[i] == counters)
+            gThreadSlotFree[i] = true;
+      }
+      unlock();
+   }
+
+   static U32 lookupSite(ThreadCounters* counters, const char* file, U32 line, const void* address)
+   {
+      U32 index = ((U32(size_t(file)) >> 3) ^ (line * 2654435761u)) & (SiteCacheSize - 1);
+      SiteCacheEntry& entry = counters->siteCache[index];
+      if(entry.file != file || entry.line != line)
+      {
+         entry.site = findSite(file, line, address);
+         entry.file = file;
+         entry.line = line;
+      }
+      return entry.site;
+   }
+
+   static void captureStackSample(dsize_t size, U32 site)
+   {
+#ifdef TORQUE_MEMORY_STACK_SAMPLES
+      void* frames[MaxStackDepth + 2];
+      S32 depth = backtrace(frames, MaxStackDepth + 2) - 2;
+      if(depth <= 0)
+         return;
+
+      lock();
+      StackSample& sample = gStackSamples[gStackSampleCount++ % MaxStackSamples];
+      sample.size = size;
+      sample.site = site;
+      sample.depth = depth;
+      // skip the tracker's own frames.
+      dMemcpy(sample.frames, frames + 2, depth * sizeof(void*));
+      unlock();
+#endif
+   }
+
+   //--------------------------------------------------------------------------
+
+   static void trackAlloc(Header* header, dsize_t size, const char* fileName, U32 line, const void* address = NULL)
+   {
+      header->size = size;
+      header->magic = HeaderMagic;
+
+      if(!gTrackingEnabled)
+      {
+         header->site = UntrackedSite;
+         header->tag = 0;
+         return;
+      }
+
+      ThreadCounters* counters = getThreadCounters();
+      const U32 site = lookupSite(counters, fileName, line, address);
+      const U32 tag = tCurrentTag ? tCurrentTag : gSiteTags[site];
+
+      header->site = U16(site);
+      header->tag = U16(tag);
+
+      counters->siteBytes[site] += size;
+      counters->siteCount[site]++;
+      counters->siteAllocs[site]++;
+      counters->tagBytes[tag] += size;
+      counters->tagCount[tag]++;
+      counters->tagAllocs[tag]++;
+
+      if(gStackSampleInterval && ++counters->sampleCountdown >= gStackSampleInterval)
+      {
+         counters->sampleCountdown = 0;
+         captureStackSample(size, site);
+      }
+   }
+
+   static void trackFree(Header* header)
+   {
+      AssertFatal(header->magic == HeaderMagic, "Memory::trackFree() - Block was not allocated with dMalloc.");
+
+      if(header->site == UntrackedSite)
+         return;
+
+      ThreadCounters* counters = getThreadCounters();
+      counters->siteBytes[header->site] -= header->size;
+      counters->siteCount[header->site]--;
+      counters->tagBytes[header->tag] -= header->size;
+      counters->tagCount[header->tag]--;
+   }
+
+   //--------------------------------------------------------------------------
+
+   U32 registerTag(const char* name)
+   {
+      lock();
+      const U32 tag = findTag(name, dStrlen(name));
+      unlock();
+      return tag;
+   }
+
+   U32 setCurrentTag(U32 tag)
+   {
+      const U32 previousTag = tCurrentTag;
+      tCurrentTag = tag;
+      return previousTag;
+   }
+
+   void setTrackingEnabled(bool enabled)
+   {
+      gTrackingEnabled = enabled;
+   }
+
+   bool isTrackingEnabled()
+   {
+      return gTrackingEnabled;
+   }
+
+   void setStackSampleInterval(U32 interval)
+   {
+      gStackSampleInterval = interval;
+   }
+
+   //--------------------------------------------------------------------------
+
+   struct Totals
+   {
+      S64 bytes;
+      S64 count;
+      U64 allocs;
+   };
+
+   /// Sums the per thread counters.  Other threads keep allocating while this
+   /// runs, so the result is a close snapshot rather than an exact one.
+   static void gatherTotals(Totals* siteTotals, Totals* tagTotals)
+   {
+      dMemset(siteTotals, 0, sizeof(Totals) * MaxSites);
+      dMemset(tagTotals, 0, sizeof(Totals) * MaxTags);
+
+      lock();
+      const U32 threadCount = gThreadCount;
+      unlock();
+
+      for(U32 thread = 0; thread < threadCount + 2; thread++)
+      {
+         const ThreadCounters* counters = thread < threadCount ? gThreads[thread] :
+            thread == threadCount ? gSharedCounters : &gRetiredCounters;
+         if(!counters)
+            continue;
+
+         for(U32 site = 0; site < MaxSites; site++)
+         {
+            siteTotals[site].bytes += counters->siteBytes[site];
+            siteTotals[site].count += counters->siteCount[site];
+            siteTotals[site].allocs += counters->siteAllocs[site];
+         }
+         for(U32 tag = 0; tag < MaxTags; tag++)
+         {
+            tagTotals[tag].bytes += counters->tagBytes[tag];
+            tagTotals[tag].count += counters->tagCount[tag];
+            tagTotals[tag].allocs += counters->tagAllocs[tag];
+         }
+      }
+   }
+
+   static S64 getLiveTotal(const char* tagName, bool bytes)
+   {
+      Totals* siteTotals = (Totals*)malloc(sizeof(Totals) * MaxSites);
+      Totals tagTotals[MaxTags];
+      gatherTotals(siteTotals, tagTotals);
+      free(siteTotals);
+
+      S64 total = 0;
+      for(U32 tag = 0; tag < gTagCount; tag++)
+      {
+         if(!tagName || !dStricmp(gTagNames[tag], tagName))
+            total += bytes ? tagTotals[tag].bytes : tagTotals[tag].count;
+      }
+      return total;
+   }
+
+   S64 getLiveBytes(const char* tag)
+   {
+      return getLiveTotal(tag, true);
+   }
+
+   S64 getLiveAllocations(const char* tag)
+   {
+      return getLiveTotal(tag, false);
+   }
+
+   //--------------------------------------------------------------------------
+
+   static S32 QSORT_CALLBACK compareTags(const void* a, const void* b)
+   {
+      return dStricmp(gTagNames[*(const U32*)a], gTagNames[*(const U32*)b]);
+   }
+
+   static S32 QSORT_CALLBACK compareSites(const void* a, const void* b)
+   {
+      const U32 siteA = *(const U32*)a;
+      const U32 siteB = *(const U32*)b;
+      const S32 result = dStricmp(getSitePath(gSiteFiles[siteA]), getSitePath(gSiteFiles[siteB]));
+      if(result)
+         return result;
+      return S32(gSiteLines[siteA]) - S32(gSiteLines[siteB]);
+   }
+
+   /// Names a call site for the report.  Sites of the global new operator
+   /// are named by their calling function where the platform can tell.
+   static void getSiteName(U32 site, char* buffer, U32 bufferSize)
+   {
+      if(gSiteFiles[site] != NewSiteFile)
+      {
+         dSprintf(buffer, bufferSize, "%s:%d", getSitePath(gSiteFiles[site]), gSiteLines[site]);
+         return;
+      }
+
+#ifdef TORQUE_MEMORY_STACK_SAMPLES
+      char** symbols = backtrace_symbols((void* const*)&gSiteAddresses[site], 1);
+      if(symbols)
+      {
+         dSprintf(buffer, bufferSize, "new at %s", symbols[0]);
+         free(symbols);
+         return;
+      }
+#endif
+      dSprintf(buffer, bufferSize, "new at %p", gSiteAddresses[site]);
+   }
+
+   bool dumpReport(const char* fileName)
+   {
+      // Take the snapshot before opening the file so the report does not count itself.
+      Totals* siteTotals = (Totals*)malloc(sizeof(Totals) * MaxSites);
+      Totals tagTotals[MaxTags];
+      gatherTotals(siteTotals, tagTotals);
+
+      lock();
+      const U32 siteCount = gSiteCount;
+      const U32 tagCount = gTagCount;
+      unlock();
+
+      U32* order = (U32*)malloc(sizeof(U32) * getMax(siteCount, tagCount));
+
+      FileStream stream;
+      if(!stream.open(fileName, FileStream::Write))
+      {
+         Con::warnf("Memory::dumpReport() - Could not open '%s' for writing.", fileName);
+         free(order);
+         free(siteTotals);
+         return false;
+      }
+
+      char buffer[1024];
+      S64 totalBytes = 0;
+      S64 totalCount = 0;
+      for(U32 tag = 0; tag < tagCount; tag++)
+      {
+         totalBytes += tagTotals[tag].bytes;
+         totalCount += tagTotals[tag].count;
+      }
+
+      dSprintf(buffer, sizeof(buffer), "Memory Report: %lld live bytes in %lld allocations.\n", totalBytes, totalCount);
+      stream.write(dStrlen(buffer), buffer);
+
+      // tags
+      dStrcpy(buffer, "\nLive Bytes\tLive Count\tTotal Count\tTag\n");
+      stream.write(dStrlen(buffer), buffer);
+
+      for(U32 tag = 0; tag < tagCount; tag++)
+         order[tag] = tag;
+      dQsort(order, tagCount, sizeof(U32), compareTags);
+
+      for(U32 i = 0; i < tagCount; i++)
+      {
+         const Totals& totals = tagTotals[order[i]];
+         if(!totals.allocs && !totals.count)
+            continue;
+         dSprintf(buffer, sizeof(buffer), "%lld\t%lld\t%llu\t%s\n", totals.bytes, totals.count, totals.allocs, gTagNames[order[i]]);
+         stream.write(dStrlen(buffer), buffer);
+      }
+
+      // call sites
+      dStrcpy(buffer, "\nLive Bytes\tLive Count\tTotal Count\tTag\tCall Site\n");
+      stream.write(dStrlen(buffer), buffer);
+
+      for(U32 site = 0; site < siteCount; site++)
+         order[site] = site;
+      dQsort(order, siteCount, sizeof(U32), compareSites);
+
+      for(U32 i = 0; i < siteCount; i++)
+      {
+         const U32 site = order[i];
+         const Totals& totals = siteTotals[site];
+         if(!totals.allocs)
+            continue;
+         char siteName[256];
+         getSiteName(site, siteName, sizeof(siteName));
+         dSprintf(buffer, sizeof(buffer), "%lld\t%lld\t%llu\t%s\t%s\n", totals.bytes, totals.count, totals.allocs,
+            gTagNames[gSiteTags[site]], siteName);
+         stream.write(dStrlen(buffer), buffer);
+      }
+
+#ifdef TORQUE_MEMORY_STACK_SAMPLES
+      // sampled stacks, oldest first
+      lock();
+      const U32 sampleCount = getMin(gStackSampleCount, U32(MaxStackSamples));
+      const U32 sampleStart = gStackSampleCount - sampleCount;
+      StackSample* samples = (StackSample*)malloc(sizeof(StackSample) * (sampleCount + 1));
+      for(U32 i = 0; i < sampleCount; i++)
+         samples[i] = gStackSamples[(sampleStart + i) % MaxStackSamples];
+      unlock();
+
+      if(sampleCount)
+      {
+         dStrcpy(buffer, "\nSampled Stacks\n");
+         stream.write(dStrlen(buffer), buffer);
+      }
+      for(U32 i = 0; i < sampleCount; i++)
+      {
+         const StackSample& sample = samples[i];
+         char siteName[256];
+         getSiteName(sample.site, siteName, sizeof(siteName));
+         dSprintf(buffer, sizeof(buffer), "%llu bytes at %s\n", U64(sample.size), siteName);
+         stream.write(dStrlen(buffer), buffer);
+
+         char** symbols = backtrace_symbols(sample.frames, sample.depth);
+         for(U32 frame = 0; symbols && frame < sample.depth; frame++)
+         {
+            dSprintf(buffer, sizeof(buffer), "   %s\n", symbols[frame]);
+            stream.write(dStrlen(buffer), buffer);
+         }
+         free(symbols);
+      }
+      free(samples);
+#endif
+
+      stream.close();
+
+      free(order);
+      free(siteTotals);
+      return true;
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+namespace Memory
+{
+   static inline Header* getBlockHeader(void* ptr)
+   {
+      return (Header*)((U8*)ptr - HeaderSpace);
+   }
+
+   static inline void* getBlockData(Header* header)
+   {
+      return (U8*)header + HeaderSpace;
+   }
+
+   static void* allocBlock(dsize_t size, const char* fileName, U32 line, const void* address)
+   {
+      Header* header = (Header*)MEMORY_BLOCK_ALLOC(size + HeaderSpace);
+      if(!header)
+         return NULL;
+
+      trackAlloc(header, size, fileName, line, address);
+      return getBlockData(header);
+   }
+}
+
 //-----------------------------------------------------------------------------
 
 void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
 {
-   return malloc(in_size);
+   return Memory::allocBlock(in_size, fileName, U32(line), NULL);
+}
+
+//-----------------------------------------------------------------------------
+
+/// Allocates for the global new operator, counted against the code that called it.
+static void* dMallocNew(dsize_t size, const void* address)
+{
+   return Memory::allocBlock(size, Memory::NewSiteFile, U32(size_t(address)), address);
 }
 
 //-----------------------------------------------------------------------------
 
 void dFree(void* in_pFree)
 {
-   free(in_pFree);
+   if(!in_pFree)
+      return;
+
+   Memory::Header* header = Memory::getBlockHeader(in_pFree);
+   Memory::trackFree(header);
+   MEMORY_BLOCK_FREE(header);
 }
 
 //-----------------------------------------------------------------------------
 
 void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
 {
-   return realloc(in_pResize,in_size);
+   Memory::Header* header = NULL;
+   Memory::Header previous;
+   if(in_pResize)
+   {
+      header = Memory::getBlockHeader(in_pResize);
+      previous = *header;
+   }
+
+   // The old block stays live if the resize fails, so only count the change once it succeeds.
+   header = (Memory::Header*)MEMORY_BLOCK_REALLOC(header, in_size + Memory::HeaderSpace);
+   if(!header)
+      return NULL;
+
+   if(in_pResize)
+      Memory::trackFree(&previous);
+   Memory::trackAlloc(header, in_size, fileName, U32(line));
+   return Memory::getBlockData(header);
+}
+
+//-----------------------------------------------------------------------------
+
+void dReleaseThreadMemory()
+{
+   Memory::releaseThreadCounters();
+#ifdef TORQUE_POOLED_ALLOCATOR
+   MemoryPool::releaseThreadCache();
+#endif
 }
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunctionGroupBegin( Memory, "Memory tracking functionality.");
+
+ConsoleFunction(dumpMemoryReport, bool, 2, 2, "(string fileName) Writes the live memory per subsystem tag and per call site to a file.\n"
+                "@param fileName The file to write the report to.\n"
+                "@return Whether the report was written.")
+{
+   char fileName[1024];
+   Con::expandPath(fileName, sizeof(fileName), argv[1]);
+   return Memory::dumpReport(fileName);
+}
+
+ConsoleFunction(getMemoryLiveBytes, const char*, 1, 2, "([string tag]) Gets the live memory allocated with a tag, or in total.\n"
+                "@param tag The subsystem tag, for instance \"2d\" or \"gui\".\n"
+                "@return The number of live bytes.")
+{
+   char* pBuffer = Con::getReturnBuffer(32);
+   dSprintf(pBuffer, 32, "%lld", Memory::getLiveBytes(argc > 1 ? argv[1] : NULL));
+   return pBuffer;
+}
+
+ConsoleFunction(setMemoryTracking, void, 2, 2, "(bool enabled) Enables or disables counting allocations.\n"
+                "@param enabled Whether new allocations are counted.\n"
+                "@return No return value.")
+{
+   Memory::setTrackingEnabled(dAtob(argv[1]));
+}
+
+ConsoleFunction(setMemoryStackSampling, void, 2, 2, "(int interval) Captures the stack of every Nth allocation on each thread.\n"
+                "@param interval The number of allocations between samples, 0 to disable sampling.\n"
+                "@return No return value.")
+{
+   Memory::setStackSampleInterval(getMax(dAtoi(argv[1]), 0));
+}
+
+ConsoleFunctionGroupEnd( Memory );
+
+#else
+
+//-----------------------------------------------------------------------------
+
+void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return MEMORY_BLOCK_ALLOC(in_size);
+}
+
+//-----------------------------------------------------------------------------
+
+void dFree(void* in_pFree)
+{
+   MEMORY_BLOCK_FREE(in_pFree);
+}
+
+//-----------------------------------------------------------------------------
+
+void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return MEMORY_BLOCK_REALLOC(in_pResize,in_size);
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_POOLED_ALLOCATOR
+static void* dMallocNew(dsize_t size, const void* address)
+{
+   return dMalloc_r(size, NULL, 0);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
+void dReleaseThreadMemory()
+{
+#ifdef TORQUE_POOLED_ALLOCATOR
+   MemoryPool::releaseThreadCache();
+#endif
+}
+
+#endif // TORQUE_TRACK_MEMORY
+
+//-----------------------------------------------------------------------------
+
+#if defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR)
+
+#ifdef TORQUE_TRACK_MEMORY
+#define MEMORY_NEW_ADDRESS() MEMORY_RETURN_ADDRESS()
+#else
+#define MEMORY_NEW_ADDRESS() NULL
+#endif
+
+// Route engine new and delete through the tracker and the pools as well.  Like
+// the operators they replace, these throw rather than return NULL when out of
+// memory.  The nothrow forms are replaced too so that every block the engine
+// deletes came from dMalloc_r().
+void* FN_CDECL operator new(size_t size)
+{
+   void* ptr = dMallocNew(dsize_t(size ? size : 1), MEMORY_NEW_ADDRESS());
+   if(!ptr)
+      throw std::bad_alloc();
+   return ptr;
+}
+
+void* FN_CDECL operator new[](size_t size)
+{
+   void* ptr = dMallocNew(dsize_t(size ? size : 1), MEMORY_NEW_ADDRESS());
+   if(!ptr)
+      throw std::bad_alloc();
+   return ptr;
+}
+
+void* FN_CDECL operator new(size_t size, const std::nothrow_t&) throw()
+{
+   return dMallocNew(dsize_t(size ? size : 1), MEMORY_NEW_ADDRESS());
+}
+
+void* FN_CDECL operator new[](size_t size, const std::nothrow_t&) throw()
+{
+   return dMallocNew(dsize_t(size ? size : 1), MEMORY_NEW_ADDRESS());
+}
+
+void FN_CDECL operator delete(void* ptr) throw()
+{
+   dFree(ptr);
+}
+
+void FN_CDECL operator delete[](void* ptr) throw()
+{
+   dFree(ptr);
+}
+
+void FN_CDECL operator delete(void* ptr, const std::nothrow_t&) throw()
+{
+   dFree(ptr);
+}
+
+void FN_CDECL operator delete[](void* ptr, const std::nothrow_t&) throw()
+{
+   dFree(ptr);
+}
+
+#endif
+
+#ifdef TORQUE_POOLED_ALLOCATOR
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction(dumpMemoryPools, void, 1, 1, "() Prints the statistics of each small object pool size class.\n"
+                "@return No return value.")
+{
+   MemoryPool::Stats stats[MemoryPool::MaxClassCount];
+   MemoryPool::getStats(stats);
+
+   Con::printf("Block Size  Slabs  Live Blocks  Allocations");
+   for(U32 sizeClass = 0; sizeClass < MemoryPool::getClassCount(); sizeClass++)
+   {
+      const MemoryPool::Stats& classStats = stats[sizeClass];
+      Con::printf("%10d  %5d  %11d  %11d", classStats.blockSize, classStats.slabCount,
+         classStats.allocs - classStats.frees, classStats.allocs);
+   }
+}
+
+#endif // TORQUE_POOLED_ALLOCATOR
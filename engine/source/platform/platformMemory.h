@@ -71,9 +71,114 @@ extern void* dRealloc_r(void* in_pResize, dsize_t in_size, const char*, const ds
 extern void* dRealMalloc(dsize_t);
 extern void  dRealFree(void*);
 
+/// Hands the calling thread's allocator state back for reuse.  The platform
+/// thread layer calls this as the last thing a thread does before it exits.
+extern void  dReleaseThreadMemory();
+
 extern void* dMemcpy(void *dst, const void *src, dsize_t size);
 extern void* dMemmove(void *dst, const void *src, dsize_t size);
 extern void* dMemset(void *dst, int c, dsize_t size);
 extern int   dMemcmp(const void *ptr1, const void *ptr2, dsize_t size);
 
+//------------------------------------------------------------------------------
+
+#ifdef TORQUE_TRACK_MEMORY
+
+/// Allocation tracking.
+///
+/// When TORQUE_TRACK_MEMORY is defined, every block from dMalloc_r(),
+/// dRealloc_r() and the global new operator records the call site that
+/// allocated it and a subsystem tag.  The global new operator has no file and
+/// line, so its call sites are the addresses it returns to and are named by
+/// their function in reports where the platform can look symbols up.
+/// The tag is the engine directory of the call site ("2d", "gui", ...) unless
+/// a MEMORY_TAG_SCOPE() is active on the allocating thread.  Counters are kept
+/// per thread so tracking does not add any locking to the allocation path.
+namespace Memory
+{
+   /// Finds or creates the tag with the given name.
+   U32  registerTag(const char* name);
+
+   /// Sets the tag used by allocations on this thread, or 0 to tag by call site.
+   /// @return The previous tag.
+   U32  setCurrentTag(U32 tag);
+
+   /// Enables or disables counting.  Blocks allocated while disabled are never counted.
+   void setTrackingEnabled(bool enabled);
+   bool isTrackingEnabled();
+
+   /// Captures a stack for every Nth tracked allocation on each thread, 0 to disable.
+   void setStackSampleInterval(U32 interval);
+
+   /// Live bytes for a tag, or for all tags if tag is NULL.
+   S64  getLiveBytes(const char* tag = NULL);
+
+   /// Live allocation count for a tag, or for all tags if tag is NULL.
+   S64  getLiveAllocations(const char* tag = NULL);
+
+   /// Writes the per tag and per call site counters, sorted by name so that
+   /// reports from different runs can be compared with a text diff.
+   bool dumpReport(const char* fileName);
+}
+
+/// Tags the allocations made on this thread for the lifetime of the scope.
+class MemoryTagScope
+{
+   U32 mPreviousTag;
+
+public:
+   MemoryTagScope(U32 tag) { mPreviousTag = Memory::setCurrentTag(tag); }
+   ~MemoryTagScope() { Memory::setCurrentTag(mPreviousTag); }
+};
+
+#define MEMORY_TAG_SCOPE(name) \
+   static const U32 memoryTag##name = Memory::registerTag(#name); \
+   MemoryTagScope memoryTagScope##name(memoryTag##name)
+
+#else
+
+#define MEMORY_TAG_SCOPE(name) TORQUE_UNUSED(#name)
+
+#endif // TORQUE_TRACK_MEMORY
+
+//------------------------------------------------------------------------------
+
+#ifdef TORQUE_POOLED_ALLOCATOR
+
+/// Small object pools.
+///
+/// When TORQUE_POOLED_ALLOCATOR is defined, blocks of up to 256 bytes from
+/// dMalloc_r(), dRealloc_r() and the global new operator come from per size
+/// class pools rather than the system allocator.  Each thread caches free
+/// blocks of each class and only locks the central lists to move blocks in
+/// batches.  Pools take 64KB slabs from the system and keep them.
+namespace MemoryPool
+{
+   enum Constants
+   {
+      MaxClassCount = 12,
+   };
+
+   struct Stats
+   {
+      U32 blockSize;
+      U32 slabCount;
+      U32 allocs;
+      U32 frees;
+   };
+
+   /// Enables or disables the pools for new allocations.  Pooled blocks can
+   /// still be freed while disabled.
+   void setEnabled(bool enabled);
+   bool isEnabled();
+
+   /// Was the block allocated from a pool?
+   bool isPooled(const void* ptr);
+
+   U32  getClassCount();
+   void getStats(Stats stats[MaxClassCount]);
+}
+
+#endif // TORQUE_POOLED_ALLOCATOR
+
 #endif // _PLATFORM_MEMORY_H_
@@ -28,6 +28,102 @@
 #include "platformNetwork.h"
 #endif
 
+#ifndef _EVENT_H_
+#include "platform/event.h"
+#endif
+
+#ifndef _PROFILER_H_
+#include "debug/profiler.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+/// A packet waiting in the batched send queue.
+struct QueuedPacket
+{
+   NetAddress mAddress;
+   S32 mSize;
+   U8 mData[MaxPacketDataSize];
+};
+
+enum
+{
+   MaxQueuedPackets = 256  ///< Packets queued before sendto() flushes by itself.
+};
+
+static QueuedPacket* sQueuedPackets = NULL;
+static U32 sQueuedPacketCount = 0;
+
+//-----------------------------------------------------------------------------
+
+void Net::setBatchedSends( bool batched )
+{
+   if ( batched == (sQueuedPackets != NULL) )
+      return;
+
+   if ( batched )
+   {
+      sQueuedPackets = new QueuedPacket[MaxQueuedPackets];
+      sQueuedPacketCount = 0;
+      return;
+   }
+
+   flush();
+   delete [] sQueuedPackets;
+   sQueuedPackets = NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Net::getBatchedSends()
+{
+   return sQueuedPackets != NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+U32 Net::getQueuedPacketCount()
+{
+   return sQueuedPacketCount;
+}
+
+//-----------------------------------------------------------------------------
+
+Net::Error Net::sendto( const NetAddress *address, const U8 *buffer, S32 bufferSize )
+{
+   if ( sQueuedPackets == NULL || bufferSize > MaxPacketDataSize )
+      return sendtoImmediate( address, buffer, bufferSize );
+
+   if ( sQueuedPacketCount == MaxQueuedPackets )
+      flush();
+
+   QueuedPacket& packet = sQueuedPackets[sQueuedPacketCount++];
+   packet.mAddress = *address;
+   packet.mSize = bufferSize;
+   dMemcpy( packet.mData, buffer, bufferSize );
+
+   return NoError;
+}
+
+//-----------------------------------------------------------------------------
+
+void Net::flush()
+{
+   if ( sQueuedPacketCount == 0 )
+      return;
+
+   PROFILE_SCOPE(Net_Flush);
+
+   // Errors are not reported for queued packets, just as a packet lost on the wire is not.
+   for ( U32 index = 0; index < sQueuedPacketCount; ++index )
+   {
+      const QueuedPacket& packet = sQueuedPackets[index];
+      sendtoImmediate( &packet.mAddress, packet.mData, packet.mSize );
+   }
+
+   sQueuedPacketCount = 0;
+}
+
 //-----------------------------------------------------------------------------
 
 ConsoleFunction( setNetPort, bool, 2, 2, "(int port)"
@@ -46,3 +142,13 @@ ConsoleFunction( closeNetPort, void, 1, 1, "()"
 {
    Net::closePort();
 }
+
+//-----------------------------------------------------------------------------
+
+ConsoleFunction( setNetBatchedSends, void, 2, 2, "(bool batched)"
+   "@brief Queues outgoing packets and sends them once per frame instead of immediately.\n\n"
+   "@param batched Whether outgoing packets are queued.\n"
+   "@ingroup Networking")
+{
+   Net::setBatchedSends( dAtob(argv[1]) );
+}
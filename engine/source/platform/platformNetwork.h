@@ -63,6 +63,17 @@ struct Net
    static bool openPort(S32 connectPort);
    static void closePort();
    static Error sendto(const NetAddress *address, const U8 *buffer, S32 bufferSize);
+   static Error sendtoImmediate(const NetAddress *address, const U8 *buffer, S32 bufferSize);
+
+   /// @name Batched Sends
+   /// When enabled, sendto() copies packets into a queue instead of sending
+   /// them, and flush() sends the queue once per frame. Off by default.
+   /// @{
+   static void setBatchedSends(bool batched);
+   static bool getBatchedSends();
+   static U32 getQueuedPacketCount();
+   static void flush();
+   /// @}
 
    // Reliable network functions (TCP)
    static NetSocket openListenPort(U16 port);
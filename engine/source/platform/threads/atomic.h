@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _PLATFORM_THREADS_ATOMIC_H_
+#define _PLATFORM_THREADS_ATOMIC_H_
+
+#ifndef _TORQUE_TYPES_H_
+#include "platform/types.h"
+#endif
+
+#if defined(TORQUE_COMPILER_VISUALC)
+#include <intrin.h>
+#pragma intrinsic(_InterlockedCompareExchange)
+#pragma intrinsic(_InterlockedExchangeAdd)
+#pragma intrinsic(_ReadWriteBarrier)
+#endif
+
+/// @defgroup platformAtomic Atomic Operations
+///
+/// Minimal set of atomic operations used by the lock-free containers in the engine.
+/// All operations act as full memory barriers.
+///
+/// @{
+
+//-----------------------------------------------------------------------------
+
+/// Issue a full memory barrier.
+inline void dMemoryBarrier( void )
+{
+#if defined(TORQUE_COMPILER_VISUALC)
+    _ReadWriteBarrier();
+    _mm_mfence();
+#else
+    __sync_synchronize();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+/// Read a value that is written by other threads.
+inline U32 dAtomicRead( volatile U32& ref )
+{
+    const U32 value = ref;
+    dMemoryBarrier();
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Write a value that is read by other threads.
+inline void dAtomicWrite( volatile U32& ref, const U32 value )
+{
+    dMemoryBarrier();
+    ref = value;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Replace the value with "newValue" if it is currently "oldValue".
+/// @return True if the value was replaced.
+inline bool dCompareAndSwap( volatile U32& ref, const U32 oldValue, const U32 newValue )
+{
+#if defined(TORQUE_COMPILER_VISUALC)
+    return (U32)_InterlockedCompareExchange( (volatile long*)&ref, (long)newValue, (long)oldValue ) == oldValue;
+#else
+    return __sync_bool_compare_and_swap( &ref, oldValue, newValue );
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+/// Add to the value.
+/// @return The value prior to the addition.
+inline U32 dFetchAndAdd( volatile U32& ref, const U32 value )
+{
+#if defined(TORQUE_COMPILER_VISUALC)
+    return (U32)_InterlockedExchangeAdd( (volatile long*)&ref, (long)value );
+#else
+    return __sync_fetch_and_add( &ref, value );
+#endif
+}
+
+/// @}
+
+#endif // _PLATFORM_THREADS_ATOMIC_H_
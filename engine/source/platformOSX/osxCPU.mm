@@ -21,6 +21,7 @@
 //-----------------------------------------------------------------------------
 #include "platformOSX/platformOSX.h"
 #include "console/console.h"
+#include "graphics/gBitmap.h"
 
 //-----------------------------------------------------------------------------
 void Processor::init()
@@ -30,4 +31,11 @@ void Processor::init()
     // Until Apple can provide an API, there is no way to initialize this
     Con::printf("CPU initialization:");
     Con::printf("   Not supported in OS X (Cocoa)");
+
+    PlatformSystemInfo.processor.numLogicalProcessors = (U32)[[NSProcessInfo processInfo] activeProcessorCount];
+    Con::printf("   %d logical processors", PlatformSystemInfo.processor.numLogicalProcessors);
+
+    // Every Intel Mac has SSE2; this is a no-op for other architectures.
+    if (bitmapInstallLibrary_SSE2())
+        Con::printf("   Installed SSE2 bitmap extensions");
 }
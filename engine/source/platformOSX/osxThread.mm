@@ -74,6 +74,9 @@ static void *ThreadRunHandler( void* arg )
         delete thread;
     }
     
+    // Hand back the allocator state of the thread.
+    dReleaseThreadMemory();
+    
     // This is for pthread.
     return NULL;
 }
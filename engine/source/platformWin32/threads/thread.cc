@@ -71,6 +71,8 @@ static void ThreadRunHandler(void * arg)
 
    // we could delete the Thread here, if it wants to be auto-deleted...
    mData->mGateway.release();
+
+   dReleaseThreadMemory();
    // the end of this function is where the created win32 thread will die.
 }
 
@@ -56,6 +56,10 @@ void Processor::init()
    PlatformSystemInfo.processor.mhz  = 0;
    PlatformSystemInfo.processor.properties = CPU_PROP_C;
 
+   SYSTEM_INFO systemInfo;
+   GetSystemInfo(&systemInfo);
+   PlatformSystemInfo.processor.numLogicalProcessors = systemInfo.dwNumberOfProcessors;
+
    char     vendor[13] = {0,};
    U32   properties = 0;
    U32   processor  = 0;
@@ -252,6 +256,9 @@ void Processor::init()
       Con::printf("   3DNow detected");
    if (PlatformSystemInfo.processor.properties & CPU_PROP_SSE)
       Con::printf("   SSE detected");
+   if (PlatformSystemInfo.processor.properties & CPU_PROP_SSE2)
+      Con::printf("   SSE2 detected");
+   Con::printf("   %d logical processors", PlatformSystemInfo.processor.numLogicalProcessors);
    Con::printf(" ");
 
    PlatformBlitInit();
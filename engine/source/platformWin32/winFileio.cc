@@ -283,7 +283,8 @@ File::~File()
 //-----------------------------------------------------------------------------
 File::Status File::open(const char *filename, const AccessMode openMode)
 {
-   static char filebuf[2048];
+   // Not static; files are also opened by the texture loader threads.
+   char filebuf[2048];
    dStrcpy(filebuf, filename);
    backslash(filebuf);
 #ifdef UNICODE
@@ -227,6 +227,7 @@ void Net::shutdown()
    }
    DestroyWindow(winsockWindow);
    closePort();
+   setBatchedSends(false);
    WSACleanup();
 }
 
@@ -506,13 +507,16 @@ bool Net::openPort(S32 port)
 
 void Net::closePort()
 {
+   // Send anything still queued before the sockets go away.
+   flush();
+
    if(ipxSocket != INVALID_SOCKET)
       closesocket(ipxSocket);
    if(udpSocket != INVALID_SOCKET)
       closesocket(udpSocket);
 }
 
-Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32 bufferSize)
+Net::Error Net::sendtoImmediate(const NetAddress *address, const U8 *buffer, S32 bufferSize)
 {
 #ifdef TORQUE_ALLOW_JOURNALING
    if(Game->isJournalReading())
@@ -27,6 +27,7 @@
 #include "console/console.h"
 #include "core/stringTable.h"
 #include <math.h>
+#include <unistd.h>
 
 Platform::SystemInfo_struct Platform::SystemInfo;
 
@@ -61,6 +62,9 @@ void Processor::init()
    Platform::SystemInfo.processor.mhz  = 0;
    Platform::SystemInfo.processor.properties = CPU_PROP_C;
 
+   const long onlineProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+   Platform::SystemInfo.processor.numLogicalProcessors = onlineProcessors > 0 ? (U32)onlineProcessors : 0;
+
    clockticks = properties = processor = time[0] = 0;
    dStrcpy(vendor, "");
 
@@ -151,6 +155,8 @@ void Processor::init()
       Con::printf("   3DNow detected");
    if (Platform::SystemInfo.processor.properties & CPU_PROP_SSE)
       Con::printf("   SSE detected");
+   if (Platform::SystemInfo.processor.properties & CPU_PROP_SSE2)
+      Con::printf("   SSE2 detected");
    Con::printf(" ");
 
    PlatformBlitInit();
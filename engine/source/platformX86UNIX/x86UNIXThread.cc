@@ -77,6 +77,7 @@ static int ThreadRunHandler(void * arg)
    x86UNIXThreadData * threadData = reinterpret_cast<x86UNIXThreadData*>(arg);
    threadData->mThread->run(threadData->mRunArg);
    Semaphore::releaseSemaphore(threadData->mSemaphore);
+   dReleaseThreadMemory();
    return 0;
 }
 
@@ -23,6 +23,7 @@
 #include "platformiOS/platformiOS.h"
 #include "console/console.h"
 #include "string/stringTable.h"
+#include "graphics/gBitmap.h"
 #include <math.h>
 
 
@@ -50,12 +51,17 @@ void Processor::init()
 
    PlatformSystemInfo.processor.properties = CPU_PROP_PPCMIN;
 
+   PlatformSystemInfo.processor.numLogicalProcessors = (U32)[[NSProcessInfo processInfo] activeProcessorCount];
+
 	Con::printf("   %s, %d Mhz", PlatformSystemInfo.processor.name, PlatformSystemInfo.processor.mhz);
    if (PlatformSystemInfo.processor.properties & CPU_PROP_PPCMIN)
       Con::printf("   FPU detected");
    if (PlatformSystemInfo.processor.properties & CPU_PROP_ALTIVEC)
       Con::printf("   AltiVec detected");
 
+   // The NEON bitmap kernels are left out until they have been built for ARM
+   // and BitmapKernelTests has shown them to match the C kernels on a device.
+
    Con::printf(" ");
 }
 
@@ -148,6 +148,7 @@ void Net::shutdown()
       closeConnectTo(gPolledSockets[0]->fd);
 
    closePort();
+   setBatchedSends(false);
    NetAsync::stopAsync();
 }
 
@@ -404,13 +405,16 @@ bool Net::openPort(S32 port)
 
 void Net::closePort()
 {
+   // Send anything still queued before the sockets go away.
+   flush();
+
    if(ipxSocket != InvalidSocket)
       close(ipxSocket);
    if(udpSocket != InvalidSocket)
       close(udpSocket);
 }
 
-Net::Error Net::sendto(const NetAddress *address, const U8 *buffer, S32  bufferSize)
+Net::Error Net::sendtoImmediate(const NetAddress *address, const U8 *buffer, S32  bufferSize)
 {
 #ifdef	TORQUE_ALLOW_JOURNALING
    if(Game->isJournalReading())
@@ -59,6 +59,7 @@ static void *ThreadRunHandler(void * arg)
       ThreadManager::removeThread(thread);
       delete thread;
    }
+   dReleaseThreadMemory();
    // return value for pthread lib's benefit
    return NULL;
    // the end of this function is where the created pthread will die.
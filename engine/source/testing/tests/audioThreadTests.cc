@@ -0,0 +1,333 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORMAUDIO_H_
+#include "platform/platformAudio.h"
+#endif
+
+#ifndef _AUDIO_THREAD_H_
+#include "audio/audioThread.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define AUDIOTHREAD_UNITTEST_BUFFER_FILE    "_unitTestAudioBuffer_RemoveMe.wav"
+#define AUDIOTHREAD_UNITTEST_STREAM_FILE    "_unitTestAudioStream_RemoveMe.wav"
+#define AUDIOTHREAD_UNITTEST_RATE           44100
+#define AUDIOTHREAD_UNITTEST_SECONDS        4
+#define AUDIOTHREAD_UNITTEST_FRAMES         10
+#define AUDIOTHREAD_UNITTEST_BENCHMARK_FRAMES 60
+#define AUDIOTHREAD_UNITTEST_FRAME_TIME     40
+#define AUDIOTHREAD_UNITTEST_STALL_FRAME    20
+#define AUDIOTHREAD_UNITTEST_STALL_TIME     3500
+#define AUDIOTHREAD_UNITTEST_UPDATE_PERIOD  125
+
+//-----------------------------------------------------------------------------
+
+static bool writeTestWave( const char* pFilename, const U16 channels )
+{
+    FileStream stream;
+    if ( !stream.open( pFilename, FileStream::Write ) )
+        return false;
+
+    const U16 blockAlign = channels * sizeof(S16);
+    const U32 dataSize = AUDIOTHREAD_UNITTEST_RATE * AUDIOTHREAD_UNITTEST_SECONDS * blockAlign;
+
+    stream.write( 4, "RIFF" );
+    stream.write( U32( 36 + dataSize ) );
+    stream.write( 4, "WAVE" );
+    stream.write( 4, "fmt " );
+    stream.write( U32( 16 ) );
+    stream.write( U16( 1 ) );
+    stream.write( channels );
+    stream.write( U32( AUDIOTHREAD_UNITTEST_RATE ) );
+    stream.write( U32( AUDIOTHREAD_UNITTEST_RATE * blockAlign ) );
+    stream.write( blockAlign );
+    stream.write( U16( 16 ) );
+    stream.write( 4, "data" );
+    stream.write( dataSize );
+
+    // A quiet square wave.
+    for ( U32 sample = 0; sample < AUDIOTHREAD_UNITTEST_RATE * AUDIOTHREAD_UNITTEST_SECONDS; ++sample )
+    {
+        const S16 value = ( ( sample / 50 ) & 1 ) ? 1024 : -1024;
+        for ( U16 channel = 0; channel < channels; ++channel )
+            stream.write( value );
+    }
+
+    stream.close();
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+static Audio::Description makeTestDescription( const bool streaming )
+{
+    Audio::Description desc;
+    desc.mVolume = 1.0f;
+    desc.mVolumeChannel = 0;
+    desc.mIsLooping = streaming;
+    desc.mIsStreaming = streaming;
+    desc.mIs3D = false;
+    desc.mReferenceDistance = 1.0f;
+    desc.mMaxDistance = 100.0f;
+    desc.mConeInsideAngle = 360;
+    desc.mConeOutsideAngle = 360;
+    desc.mConeOutsideVolume = 1.0f;
+    desc.mConeVector.set( 0.0f, 0.0f, 1.0f );
+    desc.mEnvironmentLevel = 0.0f;
+    return desc;
+}
+
+//-----------------------------------------------------------------------------
+
+static void busyWait( const U32 milliseconds )
+{
+    const U32 start = Platform::getRealMilliseconds();
+    while( Platform::getRealMilliseconds() - start < milliseconds )
+    {
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static bool restartAudioThread( const bool threaded )
+{
+    AudioThread::shutdown();
+    Con::setBoolVariable( "$pref::Audio::threaded", threaded );
+    AudioThread::startup();
+    return AudioThread::isRunning() == threaded;
+}
+
+//-----------------------------------------------------------------------------
+
+struct AudioFrameResult
+{
+    U32 mStartTime;
+    U32 mUpdateTime;
+    U32 mUnderruns;
+    bool mPlaying;
+};
+
+// Plays a looping stream through a run of heavy frames, one of which can stall the game
+// thread for longer than the queued audio lasts, and ticks the audio like the main loop.
+static AudioFrameResult runHeavyFrames( const U32 frames, const U32 stallTime )
+{
+    AudioFrameResult result;
+    result.mUpdateTime = 0;
+
+    const U32 underrunsBefore = AudioThread::getUnderrunCount();
+
+    U32 start = Platform::getRealMilliseconds();
+    AUDIOHANDLE handle = alxCreateSource( makeTestDescription( true ), AUDIOTHREAD_UNITTEST_STREAM_FILE );
+    alxPlay( handle );
+    result.mStartTime = Platform::getRealMilliseconds() - start;
+
+    U32 lastUpdate = Platform::getRealMilliseconds();
+    for ( U32 frame = 0; frame < frames; ++frame )
+    {
+        busyWait( frame == AUDIOTHREAD_UNITTEST_STALL_FRAME ? stallTime : AUDIOTHREAD_UNITTEST_FRAME_TIME );
+
+        start = Platform::getRealMilliseconds();
+        alxLoadingUpdate();
+        if ( start - lastUpdate >= AUDIOTHREAD_UNITTEST_UPDATE_PERIOD )
+        {
+            alxUpdate();
+            lastUpdate = start;
+        }
+        result.mUpdateTime += Platform::getRealMilliseconds() - start;
+    }
+
+    result.mPlaying = alxIsPlaying( handle );
+    result.mUnderruns = AudioThread::getUnderrunCount() - underrunsBefore;
+    alxStop( handle );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+// Runs the heavy frames refilling on the game thread and then on the audio thread.
+static bool runStreamingModes( const U32 frames, const U32 stallTime, AudioFrameResult results[2] )
+{
+    const bool wasThreaded = Con::getBoolVariable( "$pref::Audio::threaded", true );
+    const bool wasRunning = AudioThread::isRunning();
+
+    bool restarted = true;
+    for ( U32 pass = 0; pass < 2 && restarted; ++pass )
+    {
+        restarted = restartAudioThread( pass == 1 );
+        if ( restarted )
+            results[pass] = runHeavyFrames( frames, stallTime );
+    }
+
+    // Restore.
+    AudioThread::shutdown();
+    Con::setBoolVariable( "$pref::Audio::threaded", wasThreaded );
+    if ( wasRunning )
+        AudioThread::startup();
+
+    return restarted;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( AudioThreadTests, AudioRingTest )
+{
+    AudioRing<U32, 8> ring;
+    U32 value = 0;
+
+    // Nothing to pop yet.
+    ASSERT_FALSE( ring.pop( value ) );
+
+    // Fill to capacity.
+    for ( U32 index = 0; index < 8; ++index )
+    {
+        ASSERT_TRUE( ring.push( index ) );
+    }
+    ASSERT_EQ( 8U, ring.size() );
+    ASSERT_FALSE( ring.push( 8 ) );
+
+    // Wrap around several times keeping the order.
+    U32 expected = 0;
+    for ( U32 index = 8; index < 40; ++index )
+    {
+        ASSERT_TRUE( ring.pop( value ) );
+        ASSERT_EQ( expected++, value );
+        ASSERT_TRUE( ring.push( index ) );
+    }
+
+    while( ring.pop( value ) )
+    {
+        ASSERT_EQ( expected++, value );
+    }
+    ASSERT_EQ( 40U, expected );
+    ASSERT_EQ( 0U, ring.size() );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( AudioThreadTests, AsyncLoadTest )
+{
+    // Needs an open device.  Headless runs can use OpenAL Soft's null backend (ALSOFT_DRIVERS=null).
+    if ( alcGetCurrentContext() == NULL || !AudioThread::isRunning() )
+        return;
+
+    ASSERT_TRUE( writeTestWave( AUDIOTHREAD_UNITTEST_BUFFER_FILE, 1 ) );
+
+    // The load is handed to the audio thread and the play is deferred until it completes.
+    AUDIOHANDLE handle = alxCreateSource( makeTestDescription( false ), AUDIOTHREAD_UNITTEST_BUFFER_FILE );
+    ASSERT_NE( NULL_AUDIOHANDLE, handle );
+    ASSERT_EQ( handle, alxPlay( handle ) );
+    ASSERT_TRUE( alxIsValidHandle( handle ) );
+    ASSERT_TRUE( alxIsPlaying( handle ) );
+
+    AudioThread::finishLoads();
+    ASSERT_EQ( 0U, AudioThread::getPendingLoadCount() );
+
+    alxLoadingUpdate();
+    ASSERT_TRUE( alxIsPlaying( handle ) );
+
+    ALuint buffer = 0;
+    alxGetSourcei( handle, AL_BUFFER, (ALint*)&buffer );
+    ASSERT_NE( 0U, buffer );
+
+    alxStop( handle );
+
+    Platform::fileDelete( AUDIOTHREAD_UNITTEST_BUFFER_FILE );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( AudioThreadTests, StreamingTest )
+{
+    // Needs an open device.  Headless runs can use OpenAL Soft's null backend (ALSOFT_DRIVERS=null).
+    if ( alcGetCurrentContext() == NULL )
+        return;
+
+    ASSERT_TRUE( writeTestWave( AUDIOTHREAD_UNITTEST_STREAM_FILE, 2 ) );
+
+    // A few ordinary frames without a stall.
+    AudioFrameResult results[2];
+    const bool restarted = runStreamingModes( AUDIOTHREAD_UNITTEST_FRAMES, 0, results );
+
+    Platform::fileDelete( AUDIOTHREAD_UNITTEST_STREAM_FILE );
+
+    ASSERT_TRUE( restarted ) << "Could not switch the audio thread.";
+    ASSERT_TRUE( results[0].mPlaying ) << "Game thread refill stopped the stream.";
+    ASSERT_TRUE( results[1].mPlaying ) << "Audio thread refill stopped the stream.";
+    ASSERT_EQ( 0U, results[0].mUnderruns ) << "Game thread refill underran.";
+    ASSERT_EQ( 0U, results[1].mUnderruns ) << "Audio thread refill underran.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( AudioThreadTests, StreamingBenchmarkTest )
+{
+    // Needs an open device.  Headless runs can use OpenAL Soft's null backend (ALSOFT_DRIVERS=null).
+    if ( alcGetCurrentContext() == NULL )
+        return;
+
+    ASSERT_TRUE( writeTestWave( AUDIOTHREAD_UNITTEST_STREAM_FILE, 2 ) );
+
+    AudioFrameResult results[2];
+    const bool restarted = runStreamingModes( AUDIOTHREAD_UNITTEST_BENCHMARK_FRAMES, AUDIOTHREAD_UNITTEST_STALL_TIME, results );
+
+    Platform::fileDelete( AUDIOTHREAD_UNITTEST_STREAM_FILE );
+
+    ASSERT_TRUE( restarted ) << "Could not switch the audio thread.";
+
+    // Both keep playing through the stall, the game thread one by restarting after its underrun.
+    ASSERT_TRUE( results[0].mPlaying );
+    ASSERT_TRUE( results[1].mPlaying );
+
+    // The audio thread keeps refilling through the stall.
+    ASSERT_EQ( 0U, results[1].mUnderruns ) << "Audio thread refill underran.";
+
+    RecordProperty( "MainUnderruns", (S32)results[0].mUnderruns );
+    RecordProperty( "MainStartMilliseconds", (S32)results[0].mStartTime );
+    RecordProperty( "MainUpdateMilliseconds", (S32)results[0].mUpdateTime );
+    RecordProperty( "ThreadUnderruns", (S32)results[1].mUnderruns );
+    RecordProperty( "ThreadStartMilliseconds", (S32)results[1].mStartTime );
+    RecordProperty( "ThreadUpdateMilliseconds", (S32)results[1].mUpdateTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+#ifndef _CONNECTIONSTRINGDICTIONARY_H_
+#include "network/connectionStringDictionary.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define BITSTREAM_UNITTEST_PACKETS                    200
+#define BITSTREAM_UNITTEST_BENCHMARK_PACKETS          2000
+#define BITSTREAM_UNITTEST_STRINGS_PER_PACKET         12
+#define BITSTREAM_UNITTEST_DROP_INTERVAL              7
+#define BITSTREAM_UNITTEST_PACKET_SIZE                1200
+
+//-----------------------------------------------------------------------------
+
+static const char* bitStreamTestCommands[] =
+{
+    "serverCmdMoveTo", "serverCmdSetTarget", "serverCmdUseItem", "clientCmdSetHealth",
+    "clientCmdPlaySound", "clientCmdSyncClock", "serverCmdMessageSent", "clientCmdChatMessage",
+};
+
+static const char* bitStreamTestWords[] =
+{
+    "the", "enemy", "is", "behind", "the", "north", "gate", "follow", "me", "we", "need",
+    "healing", "over", "here", "nice", "shot", "regroup", "at", "base", "incoming",
+};
+
+//-----------------------------------------------------------------------------
+
+/// Builds the string the replayed traffic sends at a given position.
+static void buildTestString( const U32 index, char* pBuffer, const U32 bufferSize )
+{
+    // A skewed mix of repeated commands, object identifiers and free form chat.
+    const U32 kind = (index * 2654435761u) >> 29;
+
+    if ( kind < 4 )
+    {
+        dStrcpy( pBuffer, bitStreamTestCommands[(index * 7) % (sizeof(bitStreamTestCommands) / sizeof(const char*))] );
+    }
+    else if ( kind < 6 )
+    {
+        dSprintf( pBuffer, bufferSize, "SceneObject_%d", (index * 13) % 40 );
+    }
+    else
+    {
+        const U32 wordCount = sizeof(bitStreamTestWords) / sizeof(const char*);
+        dSprintf( pBuffer, bufferSize, "%s %s %s %s",
+            bitStreamTestWords[index % wordCount], bitStreamTestWords[(index / 3) % wordCount],
+            bitStreamTestWords[(index / 7) % wordCount], bitStreamTestWords[(index / 11) % wordCount] );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BitStreamTests, VarIntTest )
+{
+    static const U32 unsignedValues[] = { 0, 1, 127, 128, 300, 16383, 16384, 0x7FFFFFFF, 0xFFFFFFFF };
+    static const S32 signedValues[] = { 0, -1, 1, -64, 64, -65, 1000000, -1000000, 0x7FFFFFFF, (S32)0x80000000 };
+
+    U8 buffer[256];
+    BitStream stream( buffer, sizeof(buffer) );
+
+    for ( U32 index = 0; index < sizeof(unsignedValues) / sizeof(U32); ++index )
+        stream.writeVarU32( unsignedValues[index] );
+    for ( U32 index = 0; index < sizeof(signedValues) / sizeof(S32); ++index )
+        stream.writeVarS32( signedValues[index] );
+
+    // Small values should be small.
+    BitStream sizeStream( buffer + 128, 16 );
+    sizeStream.writeVarS32( -1 );
+    ASSERT_EQ( 8, sizeStream.getCurPos() ) << "Small signed values are not compact.";
+
+    stream.setPosition( 0 );
+
+    for ( U32 index = 0; index < sizeof(unsignedValues) / sizeof(U32); ++index )
+        ASSERT_EQ( unsignedValues[index], stream.readVarU32() ) << "Unsigned value did not round trip.";
+    for ( U32 index = 0; index < sizeof(signedValues) / sizeof(S32); ++index )
+        ASSERT_EQ( signedValues[index], stream.readVarS32() ) << "Signed value did not round trip.";
+}
+
+//-----------------------------------------------------------------------------
+
+/// Replays packets of strings through a connection string dictionary, dropping some of them.
+static void runStringDictionary( const U32 packetCount, U32& plainBits, U32& compressedBits, U32& stringBytes )
+{
+    ConnectionStringDictionary sender;
+    ConnectionStringDictionary receiver;
+
+    U8 buffer[BITSTREAM_UNITTEST_PACKET_SIZE + 256];
+    char sent[BITSTREAM_UNITTEST_STRINGS_PER_PACKET][256];
+    char received[256];
+
+    plainBits = 0;
+    compressedBits = 0;
+    stringBytes = 0;
+    U32 stringIndex = 0;
+
+    for ( U32 packet = 0; packet < packetCount; ++packet )
+    {
+        // Measure the same strings without compression.
+        BitStream plainStream( buffer, BITSTREAM_UNITTEST_PACKET_SIZE, sizeof(buffer) );
+        for ( U32 index = 0; index < BITSTREAM_UNITTEST_STRINGS_PER_PACKET; ++index )
+        {
+            buildTestString( stringIndex + index, sent[index], sizeof(sent[index]) );
+            plainStream.writeString( sent[index] );
+            stringBytes += dStrlen( sent[index] );
+        }
+        plainBits += plainStream.getCurPos();
+        stringIndex += BITSTREAM_UNITTEST_STRINGS_PER_PACKET;
+
+        // Write the packet.
+        BitStream stream( buffer, BITSTREAM_UNITTEST_PACKET_SIZE, sizeof(buffer) );
+        sender.writePacketHeader( &stream );
+        const U32 headerBits = stream.getCurPos();
+        stream.setStringDictionary( &sender );
+        for ( U32 index = 0; index < BITSTREAM_UNITTEST_STRINGS_PER_PACKET; ++index )
+            stream.writeString( sent[index] );
+        compressedBits += stream.getCurPos() - headerBits;
+
+        // Drop some packets; the receiver never sees those.
+        if ( (packet % BITSTREAM_UNITTEST_DROP_INTERVAL) == BITSTREAM_UNITTEST_DROP_INTERVAL - 1 )
+        {
+            sender.packetDropped();
+            continue;
+        }
+
+        stream.setPosition( 0 );
+        receiver.readPacketHeader( &stream );
+        stream.setStringDictionary( &receiver );
+        for ( U32 index = 0; index < BITSTREAM_UNITTEST_STRINGS_PER_PACKET; ++index )
+        {
+            stream.readString( received );
+            ASSERT_STREQ( sent[index], received ) << "String did not survive the dictionary.";
+        }
+        sender.packetReceived();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BitStreamTests, StringDictionaryTest )
+{
+    U32 plainBits, compressedBits, stringBytes;
+    runStringDictionary( BITSTREAM_UNITTEST_PACKETS, plainBits, compressedBits, stringBytes );
+
+    // Check.
+    ASSERT_LT( compressedBits, plainBits ) << "The dictionary did not compress the replayed traffic.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( BitStreamTests, StringDictionaryBenchmarkTest )
+{
+    U32 plainBits, compressedBits, stringBytes;
+
+    const U32 startTime = Platform::getRealMilliseconds();
+    runStringDictionary( BITSTREAM_UNITTEST_BENCHMARK_PACKETS, plainBits, compressedBits, stringBytes );
+    const U32 elapsedTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    RecordProperty( "Packets", BITSTREAM_UNITTEST_BENCHMARK_PACKETS );
+    RecordProperty( "CompressionRatioPercent", (S32)( 100.0f * F32(plainBits) / F32(getMax( compressedBits, (U32)1 )) ) );
+    RecordProperty( "EncodeDecodeKBPerSecond", (S32)( (F32(stringBytes) / 1024.0f) / (F32(elapsedTime) / 1000.0f) ) );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
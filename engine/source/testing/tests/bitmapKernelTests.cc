@@ -0,0 +1,334 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _GBITMAP_H_
+#include "graphics/gBitmap.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define BITMAPKERNEL_UNITTEST_MAX_SIZE          256
+#define BITMAPKERNEL_UNITTEST_MAX_PIXELS        100
+#define BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE    1024
+#define BITMAPKERNEL_UNITTEST_BENCHMARK_PASSES  16
+
+//-----------------------------------------------------------------------------
+
+typedef void (*BitmapExtrudeFn)(const void *srcMip, void *mip, U32 height, U32 width);
+typedef void (*BitmapConvertFn)(const U8 *src, U16 *dst, U32 pixels);
+
+struct BitmapKernels
+{
+    BitmapExtrudeFn mExtrude5551;
+    BitmapExtrudeFn mExtrudeRGB;
+    BitmapExtrudeFn mExtrudeRGBA;
+    void (*mConvertRGB_to_5551)(U8 *src, U32 pixels);
+    BitmapConvertFn mConvertRGBA_to_5551;
+    BitmapConvertFn mConvertRGBA_to_4444;
+    BitmapConvertFn mConvertRGB_to_565;
+
+    void capture( void )
+    {
+        mExtrude5551 = bitmapExtrude5551;
+        mExtrudeRGB = bitmapExtrudeRGB;
+        mExtrudeRGBA = bitmapExtrudeRGBA;
+        mConvertRGB_to_5551 = bitmapConvertRGB_to_5551;
+        mConvertRGBA_to_5551 = bitmapConvertRGBA_to_5551;
+        mConvertRGBA_to_4444 = bitmapConvertRGBA_to_4444;
+        mConvertRGB_to_565 = bitmapConvertRGB_to_565;
+    }
+
+    void install( void ) const
+    {
+        bitmapExtrude5551 = mExtrude5551;
+        bitmapExtrudeRGB = mExtrudeRGB;
+        bitmapExtrudeRGBA = mExtrudeRGBA;
+        bitmapConvertRGB_to_5551 = mConvertRGB_to_5551;
+        bitmapConvertRGBA_to_5551 = mConvertRGBA_to_5551;
+        bitmapConvertRGBA_to_4444 = mConvertRGBA_to_4444;
+        bitmapConvertRGB_to_565 = mConvertRGB_to_565;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+static void getReferenceKernels( BitmapKernels& kernels )
+{
+    kernels.mExtrude5551 = bitmapExtrude5551_c;
+    kernels.mExtrudeRGB = bitmapExtrudeRGB_c;
+    kernels.mExtrudeRGBA = bitmapExtrudeRGBA_c;
+    kernels.mConvertRGB_to_5551 = bitmapConvertRGB_to_5551_c;
+    kernels.mConvertRGBA_to_5551 = bitmapConvertRGBA_to_5551_c;
+    kernels.mConvertRGBA_to_4444 = bitmapConvertRGBA_to_4444_c;
+    kernels.mConvertRGB_to_565 = bitmapConvertRGB_to_565_c;
+}
+
+//-----------------------------------------------------------------------------
+
+static const char* getVectorKernels( BitmapKernels& kernels )
+{
+    // Install whichever vector library this build has, note it and put the current hooks back.
+    BitmapKernels current;
+    current.capture();
+
+    const char* pName = NULL;
+    if ( bitmapInstallLibrary_SSE2() )
+        pName = "SSE2";
+    else if ( bitmapInstallLibrary_NEON() )
+        pName = "NEON";
+
+    kernels.capture();
+    current.install();
+    return pName;
+}
+
+//-----------------------------------------------------------------------------
+
+static void fillTestPixels( U8* pBits, const U32 size, U32 seed )
+{
+    for ( U32 index = 0; index < size; ++index )
+    {
+        seed = seed * 1664525 + 1013904223;
+        pBits[index] = (U8)( seed >> 24 );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 getExtrudeSize( const U32 width, const U32 height, const U32 bytesPerPixel )
+{
+    return getMax( width >> 1, (U32)1 ) * getMax( height >> 1, (U32)1 ) * bytesPerPixel;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BitmapKernelTests, ExtrudeTest )
+{
+    BitmapKernels reference;
+    BitmapKernels vector;
+    getReferenceKernels( reference );
+    const char* pVectorName = getVectorKernels( vector );
+
+    // Nothing to compare without vector kernels in this build.
+    if ( pVectorName == NULL )
+        return;
+
+    const BitmapExtrudeFn referenceFns[3] = { reference.mExtrude5551, reference.mExtrudeRGB, reference.mExtrudeRGBA };
+    const BitmapExtrudeFn vectorFns[3] = { vector.mExtrude5551, vector.mExtrudeRGB, vector.mExtrudeRGBA };
+    const U32 bytesPerPixel[3] = { 2, 3, 4 };
+    const char* pFormatNames[3] = { "RGB5551", "RGB", "RGBA" };
+
+    const U32 maxBytes = BITMAPKERNEL_UNITTEST_MAX_SIZE * BITMAPKERNEL_UNITTEST_MAX_SIZE * 4;
+    U8* pSource = new U8[maxBytes];
+    U8* pReference = new U8[maxBytes];
+    U8* pVector = new U8[maxBytes];
+
+    // Every power-of-two shape, including the single row and column cases.
+    for ( U32 format = 0; format < 3; ++format )
+    {
+        for ( U32 height = 1; height <= BITMAPKERNEL_UNITTEST_MAX_SIZE; height <<= 1 )
+        {
+            for ( U32 width = 1; width <= BITMAPKERNEL_UNITTEST_MAX_SIZE; width <<= 1 )
+            {
+                fillTestPixels( pSource, width * height * bytesPerPixel[format], width * 31 + height );
+                const U32 mipSize = getExtrudeSize( width, height, bytesPerPixel[format] );
+
+                referenceFns[format]( pSource, pReference, height, width );
+                vectorFns[format]( pSource, pVector, height, width );
+
+                ASSERT_EQ( 0, dMemcmp( pReference, pVector, mipSize ) )
+                    << pVectorName << " " << pFormatNames[format] << " extrude of " << width << "x" << height << " does not match.";
+            }
+        }
+    }
+
+    delete [] pSource;
+    delete [] pReference;
+    delete [] pVector;
+
+    // The full mip chain through GBitmap picks up whatever hooks are installed.
+    BitmapKernels current;
+    current.capture();
+
+    const GBitmap::BitmapFormat formats[3] = { GBitmap::RGB5551, GBitmap::RGB, GBitmap::RGBA };
+    for ( U32 format = 0; format < 3; ++format )
+    {
+        GBitmap referenceBitmap( 128, 32, false, formats[format] );
+        fillTestPixels( referenceBitmap.getWritableBits(), 128 * 32 * referenceBitmap.bytesPerPixel, format + 7 );
+        GBitmap vectorBitmap( referenceBitmap );
+
+        reference.install();
+        referenceBitmap.extrudeMipLevels();
+        vector.install();
+        vectorBitmap.extrudeMipLevels();
+        current.install();
+
+        ASSERT_EQ( referenceBitmap.getNumMipLevels(), vectorBitmap.getNumMipLevels() );
+        for ( U32 level = 1; level < referenceBitmap.getNumMipLevels(); ++level )
+        {
+            const U32 levelSize = referenceBitmap.getWidth( level ) * referenceBitmap.getHeight( level ) * referenceBitmap.bytesPerPixel;
+            ASSERT_EQ( 0, dMemcmp( referenceBitmap.getBits( level ), vectorBitmap.getBits( level ), levelSize ) )
+                << pVectorName << " " << pFormatNames[format] << " mip level " << level << " does not match.";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BitmapKernelTests, ConvertTest )
+{
+    BitmapKernels reference;
+    BitmapKernels vector;
+    getReferenceKernels( reference );
+    const char* pVectorName = getVectorKernels( vector );
+
+    // Nothing to compare without vector kernels in this build.
+    if ( pVectorName == NULL )
+        return;
+
+    const BitmapConvertFn referenceFns[3] = { reference.mConvertRGBA_to_5551, reference.mConvertRGBA_to_4444, reference.mConvertRGB_to_565 };
+    const BitmapConvertFn vectorFns[3] = { vector.mConvertRGBA_to_5551, vector.mConvertRGBA_to_4444, vector.mConvertRGB_to_565 };
+    const U32 bytesPerPixel[3] = { 4, 4, 3 };
+    const char* pFormatNames[3] = { "RGBA to 5551", "RGBA to 4444", "RGB to 565" };
+
+    U8 source[BITMAPKERNEL_UNITTEST_MAX_PIXELS * 4];
+    U16 referenceTexels[BITMAPKERNEL_UNITTEST_MAX_PIXELS];
+    U16 vectorTexels[BITMAPKERNEL_UNITTEST_MAX_PIXELS];
+
+    // Every pixel count up to the limit exercises every vector tail.
+    for ( U32 pixels = 0; pixels <= BITMAPKERNEL_UNITTEST_MAX_PIXELS; ++pixels )
+    {
+        for ( U32 format = 0; format < 3; ++format )
+        {
+            fillTestPixels( source, pixels * bytesPerPixel[format], pixels + format );
+            referenceFns[format]( source, referenceTexels, pixels );
+            vectorFns[format]( source, vectorTexels, pixels );
+
+            ASSERT_EQ( 0, dMemcmp( referenceTexels, vectorTexels, pixels * sizeof(U16) ) )
+                << pVectorName << " " << pFormatNames[format] << " of " << pixels << " pixels does not match.";
+        }
+
+        // The RGB to 5551 conversion works in place.
+        U8 referenceInPlace[BITMAPKERNEL_UNITTEST_MAX_PIXELS * 3];
+        U8 vectorInPlace[BITMAPKERNEL_UNITTEST_MAX_PIXELS * 3];
+        fillTestPixels( referenceInPlace, pixels * 3, pixels * 5 );
+        dMemcpy( vectorInPlace, referenceInPlace, pixels * 3 );
+        reference.mConvertRGB_to_5551( referenceInPlace, pixels );
+        vector.mConvertRGB_to_5551( vectorInPlace, pixels );
+
+        ASSERT_EQ( 0, dMemcmp( referenceInPlace, vectorInPlace, pixels * sizeof(U16) ) )
+            << pVectorName << " in-place RGB to 5551 of " << pixels << " pixels does not match.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static F32 getMegapixelsPerSecond( const U32 pixels, const U32 elapsedTime )
+{
+    return ( (F32)pixels * BITMAPKERNEL_UNITTEST_BENCHMARK_PASSES / 1000000.0f ) / ( (F32)getMax( elapsedTime, (U32)1 ) / 1000.0f );
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 timeExtrude( BitmapExtrudeFn extrudeFn, const U8* pSource, U8* pDestination )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < BITMAPKERNEL_UNITTEST_BENCHMARK_PASSES; ++pass )
+        extrudeFn( pSource, pDestination, BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE, BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE );
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 timeConvert( BitmapConvertFn convertFn, const U8* pSource, U16* pDestination )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < BITMAPKERNEL_UNITTEST_BENCHMARK_PASSES; ++pass )
+        convertFn( pSource, pDestination, BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE * BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE );
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( BitmapKernelTests, BenchmarkTest )
+{
+    BitmapKernels reference;
+    BitmapKernels vector;
+    getReferenceKernels( reference );
+    const char* pVectorName = getVectorKernels( vector );
+    if ( pVectorName == NULL )
+        pVectorName = "none";
+
+    const U32 pixels = BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE * BITMAPKERNEL_UNITTEST_BENCHMARK_SIZE;
+    U8* pSource = new U8[pixels * 4];
+    U8* pDestination = new U8[pixels * 4];
+    fillTestPixels( pSource, pixels * 4, 11 );
+
+    const BitmapExtrudeFn referenceExtrudeFns[3] = { reference.mExtrude5551, reference.mExtrudeRGB, reference.mExtrudeRGBA };
+    const BitmapExtrudeFn vectorExtrudeFns[3] = { vector.mExtrude5551, vector.mExtrudeRGB, vector.mExtrudeRGBA };
+    const char* pExtrudeNames[3] = { "RGB5551", "RGB", "RGBA" };
+
+    RecordProperty( "VectorLibrary", pVectorName );
+
+    char propertyName[64];
+    for ( U32 format = 0; format < 3; ++format )
+    {
+        const U32 referenceTime = timeExtrude( referenceExtrudeFns[format], pSource, pDestination );
+        const U32 vectorTime = timeExtrude( vectorExtrudeFns[format], pSource, pDestination );
+
+        dSprintf( propertyName, sizeof(propertyName), "%sMipReferenceMPS", pExtrudeNames[format] );
+        RecordProperty( propertyName, (S32)getMegapixelsPerSecond( pixels, referenceTime ) );
+        dSprintf( propertyName, sizeof(propertyName), "%sMipVectorMPS", pExtrudeNames[format] );
+        RecordProperty( propertyName, (S32)getMegapixelsPerSecond( pixels, vectorTime ) );
+    }
+
+    const BitmapConvertFn referenceConvertFns[3] = { reference.mConvertRGBA_to_5551, reference.mConvertRGBA_to_4444, reference.mConvertRGB_to_565 };
+    const BitmapConvertFn vectorConvertFns[3] = { vector.mConvertRGBA_to_5551, vector.mConvertRGBA_to_4444, vector.mConvertRGB_to_565 };
+    const char* pConvertNames[3] = { "RGBAto5551", "RGBAto4444", "RGBto565" };
+
+    for ( U32 format = 0; format < 3; ++format )
+    {
+        const U32 referenceTime = timeConvert( referenceConvertFns[format], pSource, (U16*)pDestination );
+        const U32 vectorTime = timeConvert( vectorConvertFns[format], pSource, (U16*)pDestination );
+
+        dSprintf( propertyName, sizeof(propertyName), "%sReferenceMPS", pConvertNames[format] );
+        RecordProperty( propertyName, (S32)getMegapixelsPerSecond( pixels, referenceTime ) );
+        dSprintf( propertyName, sizeof(propertyName), "%sVectorMPS", pConvertNames[format] );
+        RecordProperty( propertyName, (S32)getMegapixelsPerSecond( pixels, vectorTime ) );
+    }
+
+    delete [] pSource;
+    delete [] pDestination;
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
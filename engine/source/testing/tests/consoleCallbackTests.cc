@@ -0,0 +1,161 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CONSOLE_CALLBACK_H_
+#include "console/consoleCallback.h"
+#endif
+
+#ifndef _SIMBASE_H_
+#include "sim/simBase.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define CONSOLE_UNITTEST_CALLBACK_BENCHMARK_COUNT     100000
+
+//-----------------------------------------------------------------------------
+
+static SimObject* createCallbackTestObject( void )
+{
+    Con::evaluate( "function ConsoleCallbackTestObject::onTestCallback( %this, %value ) { return %value + 1; }" );
+    Con::evaluate( "new ScriptObject( ConsoleCallbackTestObject );" );
+
+    return Sim::findObject( "ConsoleCallbackTestObject" );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ConsoleCallbackTests, ExecuteTest )
+{
+    SimObject* pObject = createCallbackTestObject();
+
+    // Check.
+    ASSERT_NE( (SimObject*)NULL, pObject ) << "Test object not created.";
+
+    ConsoleCallback callback( "onTestCallback" );
+    ConsoleCallback missingCallback( "onMissingTestCallback" );
+
+    // Check.
+    ASSERT_TRUE( callback.isDefined( pObject ) ) << "Callback not found.";
+    ASSERT_FALSE( missingCallback.isDefined( pObject ) ) << "Missing callback found.";
+    ASSERT_STREQ( "42", callback.executef( pObject, 1, "41" ) ) << "Callback result is incorrect.";
+    ASSERT_STREQ( "", missingCallback.executef( pObject, 1, "41" ) ) << "Missing callback result is incorrect.";
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ConsoleCallbackTests, RedefinitionTest )
+{
+    SimObject* pObject = createCallbackTestObject();
+
+    // Check.
+    ASSERT_NE( (SimObject*)NULL, pObject ) << "Test object not created.";
+
+    ConsoleCallback callback( "onTestCallback" );
+
+    // Check.
+    ASSERT_STREQ( "42", callback.executef( pObject, 1, "41" ) ) << "Callback result is incorrect.";
+
+    // Redefine the callback.
+    Con::evaluate( "function ConsoleCallbackTestObject::onTestCallback( %this, %value ) { return %value + 2; }" );
+
+    // Check.
+    ASSERT_STREQ( "43", callback.executef( pObject, 1, "41" ) ) << "Callback was not re-resolved after redefinition.";
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ConsoleCallbackTests, AlternatingNamespaceTest )
+{
+    SimObject* pObject = createCallbackTestObject();
+    Con::evaluate( "function ConsoleCallbackOtherTestObject::onTestCallback( %this, %value ) { return %value + 10; }" );
+    Con::evaluate( "new ScriptObject( ConsoleCallbackOtherTestObject );" );
+    SimObject* pOtherObject = Sim::findObject( "ConsoleCallbackOtherTestObject" );
+
+    // Check.
+    ASSERT_NE( (SimObject*)NULL, pObject ) << "Test object not created.";
+    ASSERT_NE( (SimObject*)NULL, pOtherObject ) << "Other test object not created.";
+
+    ConsoleCallback callback( "onTestCallback" );
+
+    // Alternate between the two namespaces.
+    for ( U32 index = 0; index < 4; ++index )
+    {
+        ASSERT_STREQ( "42", callback.executef( pObject, 1, "41" ) ) << "Callback result is incorrect.";
+        ASSERT_STREQ( "51", callback.executef( pOtherObject, 1, "41" ) ) << "Other callback result is incorrect.";
+    }
+
+    // Check.
+    ASSERT_EQ( 2u, callback.getResolvedCount() ) << "Each namespace should be resolved once.";
+
+    pObject->deleteObject();
+    pOtherObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( ConsoleCallbackTests, BenchmarkTest )
+{
+    SimObject* pObject = createCallbackTestObject();
+
+    // Check.
+    ASSERT_NE( (SimObject*)NULL, pObject ) << "Test object not created.";
+
+    ConsoleCallback callback( "onTestCallback" );
+
+    // Time Con::executef().
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < CONSOLE_UNITTEST_CALLBACK_BENCHMARK_COUNT; ++index )
+        Con::executef( pObject, 2, "onTestCallback", "1" );
+    const U32 executefTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    // Time the callback handle.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < CONSOLE_UNITTEST_CALLBACK_BENCHMARK_COUNT; ++index )
+        callback.executef( pObject, 1, "1" );
+    const U32 callbackTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    RecordProperty( "ExecutefCallbacksPerSecond", (S32)(CONSOLE_UNITTEST_CALLBACK_BENCHMARK_COUNT * 1000.0 / executefTime) );
+    RecordProperty( "ConsoleCallbackCallbacksPerSecond", (S32)(CONSOLE_UNITTEST_CALLBACK_BENCHMARK_COUNT * 1000.0 / callbackTime) );
+
+    // Check.
+    ASSERT_STREQ( "2", callback.executef( pObject, 1, "1" ) ) << "Callback result is incorrect.";
+
+    pObject->deleteObject();
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,326 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _DISPATCHER_H_
+#include "messaging/dispatcher.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#ifndef _PLATFORM_THREADS_ATOMIC_H_
+#include "platform/threads/atomic.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define DISPATCHER_UNITTEST_QUEUE                   "DispatcherTestQueue"
+#define DISPATCHER_UNITTEST_OTHER_QUEUE             "DispatcherTestOtherQueue"
+#define DISPATCHER_UNITTEST_PRODUCER_COUNT          4
+#define DISPATCHER_UNITTEST_PRODUCER_MESSAGES       10000
+#define DISPATCHER_UNITTEST_BENCHMARK_COUNT         100000
+
+//-----------------------------------------------------------------------------
+
+class DispatcherTestListener : public Dispatcher::IMessageListener
+{
+public:
+    DispatcherTestListener() : mReceivedCount( 0 ), mLastData( 0 ), mInOrder( true ) {}
+
+    virtual bool onMessageReceived( StringTableEntry queue, const char* msg, const char* data )
+    {
+        // Messages from a single producer must arrive in the order they were posted.
+        const U32 value = dAtoi( data );
+        if ( value < mLastData )
+            mInOrder = false;
+        mLastData = value;
+
+        mReceivedCount++;
+        return true;
+    }
+
+    virtual bool onMessageObjectReceived( StringTableEntry queue, Message* msg ) { return true; }
+
+    U32 mReceivedCount;
+    U32 mLastData;
+    bool mInOrder;
+};
+
+//-----------------------------------------------------------------------------
+
+class DispatcherReentrantTestListener : public Dispatcher::IMessageListener
+{
+public:
+    DispatcherReentrantTestListener() : mReceivedCount( 0 ) {}
+
+    virtual bool onMessageReceived( StringTableEntry queue, const char* msg, const char* data )
+    {
+        mReceivedCount++;
+
+        // Post, subscribe and unregister from inside a posted message dispatch.
+        if ( dStrcmp( msg, "repost" ) == 0 )
+        {
+            Dispatcher::postMessage( queue, "test", "0" );
+        }
+        else if ( dStrcmp( msg, "subscribe" ) == 0 )
+        {
+            Dispatcher::registerMessageListener( queue, &mSubscriber );
+        }
+        else if ( dStrcmp( msg, "unregister" ) == 0 )
+        {
+            Dispatcher::unregisterMessageListener( queue, &mSubscriber );
+            Dispatcher::unregisterMessageListener( queue, this );
+            Dispatcher::unregisterMessageQueue( queue );
+        }
+
+        return true;
+    }
+
+    virtual bool onMessageObjectReceived( StringTableEntry queue, Message* msg ) { return true; }
+
+    U32 mReceivedCount;
+    DispatcherTestListener mSubscriber;
+};
+
+//-----------------------------------------------------------------------------
+
+static volatile U32 sDispatcherTestFullCount;
+static U32 sDispatcherTestProducerMessages;
+
+static void dispatcherTestProducer( void* pQueue )
+{
+    Dispatcher::MessageQueue* pMessageQueue = static_cast<Dispatcher::MessageQueue*>( pQueue );
+
+    for ( U32 index = 0; index < sDispatcherTestProducerMessages; )
+    {
+        // Wait for the main thread to drain the queue if it is full.
+        if ( !Dispatcher::postMessage( pMessageQueue, "benchmark", "0" ) )
+        {
+            dFetchAndAdd( sDispatcherTestFullCount, 1 );
+            Platform::sleep( 0 );
+            continue;
+        }
+
+        index++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( DispatcherTests, PostTest )
+{
+    DispatcherTestListener listener;
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+
+    Dispatcher::MessageQueue* pQueue = Dispatcher::findMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+
+    // Check.
+    ASSERT_NE( (Dispatcher::MessageQueue*)NULL, pQueue ) << "Queue handle not found.";
+
+    char buffer[16];
+    for ( U32 index = 0; index < 100; ++index )
+    {
+        dSprintf( buffer, sizeof(buffer), "%d", index );
+        ASSERT_TRUE( Dispatcher::postMessage( pQueue, "test", buffer ) ) << "Message was not posted.";
+    }
+
+    // Check.
+    ASSERT_EQ( (U32)0, listener.mReceivedCount ) << "Posted messages were dispatched immediately.";
+    ASSERT_EQ( (U32)100, Dispatcher::processPostedMessages() ) << "Incorrect number of posted messages dispatched.";
+    ASSERT_EQ( (U32)100, listener.mReceivedCount ) << "Listener did not receive all posted messages.";
+    ASSERT_TRUE( listener.mInOrder ) << "Posted messages were dispatched out of order.";
+    ASSERT_EQ( (U32)0, Dispatcher::processPostedMessages() ) << "Posted messages were dispatched twice.";
+
+    // Fill the queue.
+    for ( U32 index = 0; index < Dispatcher::MessageQueue::PostedMessageCapacity; ++index )
+        Dispatcher::postMessage( pQueue, "test", "100" );
+
+    // Check.
+    ASSERT_FALSE( Dispatcher::postMessage( pQueue, "test", "100" ) ) << "Message was posted to a full queue.";
+    ASSERT_EQ( (U32)Dispatcher::MessageQueue::PostedMessageCapacity, Dispatcher::processPostedMessages() ) << "Full queue was not drained.";
+
+    Dispatcher::unregisterMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+    Dispatcher::unregisterMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 runDispatcherTestProducers( DispatcherTestListener& listener, Dispatcher::MessageQueue* pQueue, const U32 producerMessages )
+{
+    const U32 totalCount = DISPATCHER_UNITTEST_PRODUCER_COUNT * producerMessages;
+
+    listener.mReceivedCount = 0;
+    sDispatcherTestFullCount = 0;
+    sDispatcherTestProducerMessages = producerMessages;
+
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    Thread* producers[DISPATCHER_UNITTEST_PRODUCER_COUNT];
+    for ( U32 index = 0; index < DISPATCHER_UNITTEST_PRODUCER_COUNT; ++index )
+        producers[index] = new Thread( dispatcherTestProducer, pQueue, true );
+
+    while ( listener.mReceivedCount < totalCount )
+    {
+        if ( Dispatcher::processPostedMessages() == 0 )
+            Platform::sleep( 0 );
+    }
+
+    const U32 postTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    for ( U32 index = 0; index < DISPATCHER_UNITTEST_PRODUCER_COUNT; ++index )
+    {
+        producers[index]->join();
+        delete producers[index];
+    }
+
+    return postTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( DispatcherTests, MultipleProducerTest )
+{
+    DispatcherTestListener listener;
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+
+    Dispatcher::MessageQueue* pQueue = Dispatcher::findMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+
+    // Check.
+    ASSERT_NE( (Dispatcher::MessageQueue*)NULL, pQueue ) << "Queue handle not found.";
+
+    runDispatcherTestProducers( listener, pQueue, DISPATCHER_UNITTEST_PRODUCER_MESSAGES );
+
+    // Check.
+    ASSERT_EQ( (U32)(DISPATCHER_UNITTEST_PRODUCER_COUNT * DISPATCHER_UNITTEST_PRODUCER_MESSAGES), listener.mReceivedCount ) << "Listener did not receive all posted messages.";
+    ASSERT_EQ( (U32)0, Dispatcher::processPostedMessages() ) << "Unexpected posted messages remain.";
+
+    Dispatcher::unregisterMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+    Dispatcher::unregisterMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( DispatcherTests, UnregisterQueueTest )
+{
+    DispatcherTestListener listener;
+    DispatcherTestListener otherListener;
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_OTHER_QUEUE, &otherListener );
+
+    Dispatcher::MessageQueue* pOtherQueue = Dispatcher::findMessageQueue( DISPATCHER_UNITTEST_OTHER_QUEUE );
+
+    // Check.
+    ASSERT_NE( (Dispatcher::MessageQueue*)NULL, pOtherQueue ) << "Queue handle not found.";
+
+    // Unregister the first queue only.
+    Dispatcher::unregisterMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+    Dispatcher::unregisterMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+
+    // Check.
+    ASSERT_FALSE( Dispatcher::isQueueRegistered( DISPATCHER_UNITTEST_QUEUE ) ) << "Unregistered queue is still registered.";
+    ASSERT_EQ( pOtherQueue, Dispatcher::findMessageQueue( DISPATCHER_UNITTEST_OTHER_QUEUE ) ) << "Remaining queue handle changed.";
+    ASSERT_TRUE( Dispatcher::postMessage( pOtherQueue, "test", "1" ) ) << "Message was not posted to the remaining queue.";
+    ASSERT_EQ( (U32)1, Dispatcher::processPostedMessages() ) << "Remaining queue was not processed.";
+    ASSERT_EQ( (U32)1, otherListener.mReceivedCount ) << "Remaining queue listener did not receive the message.";
+
+    Dispatcher::unregisterMessageListener( DISPATCHER_UNITTEST_OTHER_QUEUE, &otherListener );
+    Dispatcher::unregisterMessageQueue( DISPATCHER_UNITTEST_OTHER_QUEUE );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( DispatcherTests, ReentrantListenerTest )
+{
+    DispatcherReentrantTestListener listener;
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+
+    // Messages posted by a listener are left for the next call.
+    ASSERT_TRUE( Dispatcher::postMessage( DISPATCHER_UNITTEST_QUEUE, "repost", "0" ) ) << "Message was not posted.";
+    ASSERT_EQ( (U32)1, Dispatcher::processPostedMessages() ) << "Listener posted message was dispatched in the same call.";
+    ASSERT_EQ( (U32)1, Dispatcher::processPostedMessages() ) << "Listener posted message was not dispatched.";
+    ASSERT_EQ( (U32)2, listener.mReceivedCount ) << "Listener did not receive all posted messages.";
+
+    // A listener subscribed by a listener receives the following messages.
+    Dispatcher::postMessage( DISPATCHER_UNITTEST_QUEUE, "subscribe", "0" );
+    Dispatcher::postMessage( DISPATCHER_UNITTEST_QUEUE, "test", "0" );
+    ASSERT_EQ( (U32)2, Dispatcher::processPostedMessages() ) << "Incorrect number of posted messages dispatched.";
+    ASSERT_EQ( (U32)1, listener.mSubscriber.mReceivedCount ) << "Subscribed listener did not receive the following message.";
+
+    // Messages behind one that unregisters the queue are discarded with it.
+    const U32 queueSequence = Dispatcher::getQueueSequence();
+    Dispatcher::postMessage( DISPATCHER_UNITTEST_QUEUE, "unregister", "0" );
+    Dispatcher::postMessage( DISPATCHER_UNITTEST_QUEUE, "test", "0" );
+    ASSERT_EQ( (U32)1, Dispatcher::processPostedMessages() ) << "Messages for an unregistered queue were dispatched.";
+    ASSERT_FALSE( Dispatcher::isQueueRegistered( DISPATCHER_UNITTEST_QUEUE ) ) << "Queue was not unregistered by the listener.";
+    ASSERT_NE( queueSequence, Dispatcher::getQueueSequence() ) << "Queue sequence did not change when the queue was unregistered.";
+    ASSERT_EQ( (U32)1, listener.mSubscriber.mReceivedCount ) << "Unregistered listener received a message.";
+    ASSERT_EQ( (U32)0, Dispatcher::processPostedMessages() ) << "Unexpected posted messages remain.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( DispatcherTests, BenchmarkTest )
+{
+    DispatcherTestListener listener;
+    Dispatcher::registerMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+
+    Dispatcher::MessageQueue* pQueue = Dispatcher::findMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+
+    // Check.
+    ASSERT_NE( (Dispatcher::MessageQueue*)NULL, pQueue ) << "Queue handle not found.";
+
+    const U32 totalCount = DISPATCHER_UNITTEST_PRODUCER_COUNT * DISPATCHER_UNITTEST_BENCHMARK_COUNT;
+
+    // Time dispatching by name.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < totalCount; ++index )
+        Dispatcher::dispatchMessage( DISPATCHER_UNITTEST_QUEUE, "benchmark", "0" );
+    const U32 dispatchTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    // Time posting from multiple producers.
+    const U32 postTime = runDispatcherTestProducers( listener, pQueue, DISPATCHER_UNITTEST_BENCHMARK_COUNT );
+
+    RecordProperty( "DispatchMessagesPerSecond", (S32)(totalCount * 1000.0 / dispatchTime) );
+    RecordProperty( "PostMessagesPerSecond", (S32)(totalCount * 1000.0 / postTime) );
+    RecordProperty( "PostQueueFullCount", (S32)dAtomicRead( sDispatcherTestFullCount ) );
+
+    // Check.
+    ASSERT_EQ( totalCount, listener.mReceivedCount ) << "Listener did not receive all posted messages.";
+    ASSERT_EQ( (U32)0, Dispatcher::processPostedMessages() ) << "Unexpected posted messages remain.";
+
+    Dispatcher::unregisterMessageListener( DISPATCHER_UNITTEST_QUEUE, &listener );
+    Dispatcher::unregisterMessageQueue( DISPATCHER_UNITTEST_QUEUE );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
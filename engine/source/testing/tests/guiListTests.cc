@@ -0,0 +1,294 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _DGL_H_
+#include "graphics/dgl.h"
+#endif
+
+#ifndef _GUICANVAS_H_
+#include "gui/guiCanvas.h"
+#endif
+
+#ifndef _GUISCROLLCTRL_H_
+#include "gui/containers/guiScrollCtrl.h"
+#endif
+
+#ifndef _GUITEXTLISTCTRL_H_
+#include "gui/guiTextListCtrl.h"
+#endif
+
+#ifndef _GUI_TREEVIEWCTRL_H
+#include "gui/guiTreeViewCtrl.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define GUILIST_UNITTEST_ROWS               1000
+#define GUILIST_UNITTEST_TREE_BRANCHES      10
+#define GUILIST_UNITTEST_BENCHMARK_ROWS     100000
+#define GUILIST_UNITTEST_BENCHMARK_BRANCHES 1000
+#define GUILIST_UNITTEST_SCROLL_STEPS       100
+#define GUILIST_UNITTEST_FRAMES             60
+
+//-----------------------------------------------------------------------------
+
+TEST( GuiListTests, TreeInsertOrderTest )
+{
+    GuiControlProfile* pProfile = NULL;
+    if ( !Sim::findObject( "GuiDefaultProfile", pProfile ) )
+        return;
+
+    GuiTreeViewCtrl* pTree = new GuiTreeViewCtrl();
+    pTree->setControlProfile( pProfile );
+    ASSERT_TRUE( pTree->registerObject() );
+
+    // Interleave inserts across branches so the cached tail is often wrong.
+    const S32 rootA = pTree->insertItem( 0, "A" );
+    const S32 rootB = pTree->insertItem( 0, "B" );
+    const S32 childA1 = pTree->insertItem( rootA, "A1" );
+    const S32 childB1 = pTree->insertItem( rootB, "B1" );
+    const S32 childA2 = pTree->insertItem( rootA, "A2" );
+    const S32 rootC = pTree->insertItem( 0, "C" );
+
+    ASSERT_EQ( rootA, pTree->getFirstRootItem() );
+    ASSERT_EQ( rootB, pTree->getNextSiblingItem( rootA ) );
+    ASSERT_EQ( rootC, pTree->getNextSiblingItem( rootB ) );
+    ASSERT_EQ( 0, pTree->getNextSiblingItem( rootC ) );
+    ASSERT_EQ( childA1, pTree->getChildItem( rootA ) );
+    ASSERT_EQ( childA2, pTree->getNextSiblingItem( childA1 ) );
+    ASSERT_EQ( childB1, pTree->getChildItem( rootB ) );
+
+    // Removing the last inserted item must not leave a stale tail behind,
+    // even when its id is recycled by the next insert.
+    ASSERT_TRUE( pTree->removeItem( rootC ) );
+    const S32 rootD = pTree->insertItem( 0, "D" );
+    ASSERT_EQ( rootD, pTree->getNextSiblingItem( rootB ) );
+    ASSERT_EQ( 0, pTree->getNextSiblingItem( rootD ) );
+
+    const S32 childA3 = pTree->insertItem( rootA, "A3" );
+    ASSERT_EQ( childA3, pTree->getNextSiblingItem( childA2 ) );
+    ASSERT_EQ( 7, pTree->getItemCount() );
+
+    pTree->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( GuiListTests, PopulateTest )
+{
+    GuiControlProfile* pProfile = NULL;
+    if ( !Sim::findObject( "GuiDefaultProfile", pProfile ) )
+        return;
+
+    char text[64];
+
+    // Text list.
+    GuiTextListCtrl* pList = new GuiTextListCtrl();
+    pList->setControlProfile( pProfile );
+    ASSERT_TRUE( pList->registerObject() );
+
+    for ( S32 row = 0; row < GUILIST_UNITTEST_ROWS; ++row )
+    {
+        dSprintf( text, sizeof(text), "Asset %d\tfolder/asset_%d.png", row, row );
+        pList->addEntry( row, text );
+    }
+    ASSERT_EQ( (U32)GUILIST_UNITTEST_ROWS, pList->getNumEntries() ) << "Text list lost rows.";
+
+    pList->clear();
+    ASSERT_EQ( 0u, pList->getNumEntries() ) << "Text list was not cleared.";
+
+    pList->deleteObject();
+
+    // Tree view.
+    GuiTreeViewCtrl* pTree = new GuiTreeViewCtrl();
+    pTree->setControlProfile( pProfile );
+    ASSERT_TRUE( pTree->registerObject() );
+
+    const S32 branchSize = GUILIST_UNITTEST_ROWS / GUILIST_UNITTEST_TREE_BRANCHES;
+    for ( S32 branch = 0; branch < GUILIST_UNITTEST_TREE_BRANCHES; ++branch )
+    {
+        dSprintf( text, sizeof(text), "Folder %d", branch );
+        const S32 branchItem = pTree->insertItem( 0, text );
+
+        for ( S32 row = 0; row < branchSize - 1; ++row )
+        {
+            dSprintf( text, sizeof(text), "asset_%d_%d.png", branch, row );
+            pTree->insertItem( branchItem, text );
+        }
+    }
+    ASSERT_EQ( GUILIST_UNITTEST_ROWS, pTree->getItemCount() ) << "Tree view lost items.";
+
+    pTree->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static GuiScrollCtrl* createTestScroll( GuiControlProfile* pScrollProfile, const Point2I& extent )
+{
+    GuiScrollCtrl* pScroll = new GuiScrollCtrl();
+    pScroll->setControlProfile( pScrollProfile );
+    pScroll->registerObject();
+    pScroll->resize( Point2I( 0, 0 ), extent );
+
+    return pScroll;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 scrollTestFrames( GuiScrollCtrl* pScroll, const S32 contentHeight )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( S32 step = 0; step < GUILIST_UNITTEST_SCROLL_STEPS; ++step )
+    {
+        pScroll->scrollTo( 0, ( contentHeight / GUILIST_UNITTEST_SCROLL_STEPS ) * step );
+        Canvas->renderFrame( false, false );
+    }
+    glFinish();
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 renderTestFrames()
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( S32 frame = 0; frame < GUILIST_UNITTEST_FRAMES; ++frame )
+        Canvas->renderFrame( false, false );
+    glFinish();
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( GuiListTests, BenchmarkTest )
+{
+    // Rendering needs a context.
+    if ( Canvas == NULL || !TextureManager::mDGLRender || TextureManager::getManagerState() != TextureManager::Alive )
+        return;
+
+    // The tree view needs a profile with a bitmap array to wake.
+    GuiControlProfile* pProfile = NULL;
+    GuiControlProfile* pScrollProfile = NULL;
+    if ( !Sim::findObject( "GuiDefaultProfile", pProfile ) || !Sim::findObject( "GuiScrollProfile", pScrollProfile ) )
+        return;
+
+    const Point2I extent = Platform::getWindowSize();
+    if ( extent.x <= 0 || extent.y <= 0 )
+        return;
+
+    char text[64];
+
+    // Text list.
+    GuiScrollCtrl* pListScroll = createTestScroll( pScrollProfile, extent );
+    GuiTextListCtrl* pList = new GuiTextListCtrl();
+    pList->setControlProfile( pProfile );
+    pList->registerObject();
+    pListScroll->addObject( pList );
+    Canvas->pushDialogControl( pListScroll, 99 );
+
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( S32 row = 0; row < GUILIST_UNITTEST_BENCHMARK_ROWS; ++row )
+    {
+        dSprintf( text, sizeof(text), "Asset %d\tfolder/asset_%d.png", row, row );
+        pList->addEntry( row, text );
+    }
+    const U32 listPopulateTime = Platform::getRealMilliseconds() - startTime;
+
+    ASSERT_EQ( (U32)GUILIST_UNITTEST_BENCHMARK_ROWS, pList->getNumEntries() ) << "Text list lost rows.";
+
+    const U32 listScrollTime = scrollTestFrames( pListScroll, pList->getExtent().y );
+    const U32 listRenderTime = renderTestFrames();
+
+    startTime = Platform::getRealMilliseconds();
+    pList->clear();
+    const U32 listClearTime = Platform::getRealMilliseconds() - startTime;
+
+    ASSERT_EQ( 0u, pList->getNumEntries() ) << "Text list was not cleared.";
+
+    Canvas->popDialogControl( pListScroll );
+    pListScroll->deleteObject();
+
+    // Tree view, populated after waking as it is cleared on wake.
+    GuiScrollCtrl* pTreeScroll = createTestScroll( pScrollProfile, extent );
+    GuiTreeViewCtrl* pTree = new GuiTreeViewCtrl();
+    pTree->setControlProfile( pScrollProfile );
+    pTree->registerObject();
+    pTreeScroll->addObject( pTree );
+    Canvas->pushDialogControl( pTreeScroll, 99 );
+
+    const S32 branchSize = GUILIST_UNITTEST_BENCHMARK_ROWS / GUILIST_UNITTEST_BENCHMARK_BRANCHES;
+    S32 lastItem = 0;
+
+    startTime = Platform::getRealMilliseconds();
+    for ( S32 branch = 0; branch < GUILIST_UNITTEST_BENCHMARK_BRANCHES; ++branch )
+    {
+        dSprintf( text, sizeof(text), "Folder %d", branch );
+        const S32 branchItem = pTree->insertItem( 0, text );
+        pTree->setItemExpanded( branchItem, true );
+
+        for ( S32 row = 0; row < branchSize - 1; ++row )
+        {
+            dSprintf( text, sizeof(text), "asset_%d_%d.png", branch, row );
+            lastItem = pTree->insertItem( branchItem, text );
+        }
+    }
+    pTree->buildVisibleTree();
+    const U32 treePopulateTime = Platform::getRealMilliseconds() - startTime;
+
+    ASSERT_EQ( GUILIST_UNITTEST_BENCHMARK_ROWS, pTree->getItemCount() ) << "Tree view lost items.";
+
+    startTime = Platform::getRealMilliseconds();
+    const bool scrolled = pTree->scrollVisible( lastItem );
+    const U32 treeScrollVisibleTime = Platform::getRealMilliseconds() - startTime;
+
+    ASSERT_TRUE( scrolled ) << "Tree view could not scroll to its last item.";
+
+    const U32 treeScrollTime = scrollTestFrames( pTreeScroll, pTree->getExtent().y );
+    const U32 treeRenderTime = renderTestFrames();
+
+    Canvas->popDialogControl( pTreeScroll );
+    pTreeScroll->deleteObject();
+
+    RecordProperty( "ListPopulateMilliseconds", (S32)listPopulateTime );
+    RecordProperty( "ListClearMilliseconds", (S32)listClearTime );
+    RecordProperty( "ListScrollMilliseconds", (S32)listScrollTime );
+    RecordProperty( "ListRenderMilliseconds", (S32)listRenderTime );
+    RecordProperty( "TreePopulateMilliseconds", (S32)treePopulateTime );
+    RecordProperty( "TreeScrollVisibleMilliseconds", (S32)treeScrollVisibleTime );
+    RecordProperty( "TreeScrollMilliseconds", (S32)treeScrollTime );
+    RecordProperty( "TreeRenderMilliseconds", (S32)treeRenderTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,373 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _DGL_DRAW_LIST_H_
+#include "graphics/dglDrawList.h"
+#endif
+
+#ifndef _DGL_H_
+#include "graphics/dgl.h"
+#endif
+
+#ifndef _GUICANVAS_H_
+#include "gui/guiCanvas.h"
+#endif
+
+#ifndef _GUITEXTCTRL_H_
+#include "gui/guiTextCtrl.h"
+#endif
+
+#ifndef _GUIBUTTONCTRL_H_
+#include "gui/buttons/guiButtonCtrl.h"
+#endif
+
+#ifndef _GUICHECKBOXCTRL_H_
+#include "gui/buttons/guiCheckBoxCtrl.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define GUIRENDER_UNITTEST_PANELS           48
+#define GUIRENDER_UNITTEST_PANEL_CHILDREN   12
+#define GUIRENDER_UNITTEST_FRAMES           2
+#define GUIRENDER_UNITTEST_BENCHMARK_FRAMES 60
+#define GUIRENDER_UNITTEST_PIXEL_TOLERANCE  8
+
+//-----------------------------------------------------------------------------
+
+TEST( GuiRenderTests, DrawListBatchTest )
+{
+    DGLDrawList drawList;
+    drawList.setClipRect( RectI( 0, 0, 100, 100 ) );
+
+    // Untextured fills with the same state share a batch.
+    drawList.addRectFill( Point2I( 0, 0 ), Point2I( 10, 10 ), ColorI( 255, 0, 0 ) );
+    drawList.addRectFill( Point2I( 20, 20 ), Point2I( 30, 30 ), ColorI( 0, 255, 0 ) );
+    ASSERT_EQ( 1u, drawList.getBatchCount() ) << "Matching fills were not merged.";
+    ASSERT_EQ( 12u, drawList.getVertexCount() ) << "Fills were not stored as triangles.";
+
+    // Axis-aligned lines are stored as fills.
+    drawList.addLine( Point2I( 0, 50 ), Point2I( 40, 50 ), ColorI( 0, 0, 255 ), 1.0f );
+    ASSERT_EQ( 1u, drawList.getBatchCount() ) << "Axis-aligned line started a new batch.";
+
+    // Other lines need their own primitive.
+    drawList.addLine( Point2I( 0, 0 ), Point2I( 40, 40 ), ColorI( 0, 0, 255 ), 1.0f );
+    ASSERT_EQ( 2u, drawList.getBatchCount() ) << "Diagonal line was merged with the fills.";
+
+    // Crossing the clip rectangle needs a clipped batch.
+    drawList.addRectFill( Point2I( 90, 90 ), Point2I( 110, 110 ), ColorI( 255, 255, 255 ) );
+    ASSERT_EQ( 3u, drawList.getBatchCount() ) << "Clipped fill was merged with the line.";
+
+    // Fills inside the clip rectangle can join a clipped batch.
+    drawList.addRectFill( Point2I( 95, 95 ), Point2I( 96, 96 ), ColorI( 255, 255, 255 ) );
+    ASSERT_EQ( 3u, drawList.getBatchCount() ) << "Fill inside the clip rectangle started a new batch.";
+
+    drawList.clear();
+    ASSERT_TRUE( drawList.isEmpty() ) << "Draw list was not cleared.";
+    ASSERT_EQ( 0u, drawList.getVertexCount() ) << "Vertices were not cleared.";
+}
+
+//-----------------------------------------------------------------------------
+
+static GuiControl* createTestLayout( GuiControlProfile* pProfile, const Point2I& extent )
+{
+    GuiControl* pRoot = new GuiControl();
+    pRoot->setControlProfile( pProfile );
+    pRoot->registerObject();
+    pRoot->resize( Point2I( 0, 0 ), extent );
+
+    const S32 columns = 8;
+    const S32 rows = ( GUIRENDER_UNITTEST_PANELS + columns - 1 ) / columns;
+    const Point2I panelExtent( extent.x / columns, extent.y / rows );
+    const S32 childHeight = getMax( panelExtent.y / GUIRENDER_UNITTEST_PANEL_CHILDREN, 1 );
+
+    char text[32];
+    for ( S32 panelIndex = 0; panelIndex < GUIRENDER_UNITTEST_PANELS; ++panelIndex )
+    {
+        GuiControl* pPanel = new GuiControl();
+        pPanel->setControlProfile( pProfile );
+        pPanel->registerObject();
+        pRoot->addObject( pPanel );
+        pPanel->resize( Point2I( ( panelIndex % columns ) * panelExtent.x, ( panelIndex / columns ) * panelExtent.y ), panelExtent );
+
+        for ( S32 childIndex = 0; childIndex < GUIRENDER_UNITTEST_PANEL_CHILDREN; ++childIndex )
+        {
+            dSprintf( text, sizeof(text), "Item %d.%d", panelIndex, childIndex );
+
+            GuiControl* pChild;
+            switch( childIndex % 3 )
+            {
+            case 0:
+                {
+                    GuiTextCtrl* pTextCtrl = new GuiTextCtrl();
+                    pTextCtrl->setText( text );
+                    pChild = pTextCtrl;
+                } break;
+
+            case 1:
+                {
+                    GuiButtonCtrl* pButton = new GuiButtonCtrl();
+                    pButton->setText( text );
+                    pChild = pButton;
+                } break;
+
+            default:
+                {
+                    GuiCheckBoxCtrl* pCheckBox = new GuiCheckBoxCtrl();
+                    pCheckBox->setText( text );
+                    pChild = pCheckBox;
+                } break;
+            }
+
+            pChild->setControlProfile( pProfile );
+            pChild->registerObject();
+            pPanel->addObject( pChild );
+            pChild->resize( Point2I( 0, childIndex * childHeight ), Point2I( panelExtent.x, childHeight ) );
+        }
+    }
+
+    return pRoot;
+}
+
+//-----------------------------------------------------------------------------
+
+static void readTestPixels( U8* pPixels, const Point2I& extent )
+{
+#ifndef TORQUE_OS_IOS
+    glReadBuffer( GL_BACK );
+#endif
+    glReadPixels( 0, 0, extent.x, extent.y, GL_RGB, GL_UNSIGNED_BYTE, pPixels );
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 renderTestFrames( const bool useDrawLists, const bool useDirtyRegions, const U32 frames, U8* pPixels, const Point2I& extent )
+{
+    Canvas->setUseDrawLists( useDrawLists );
+    Canvas->setUseDirtyRegions( useDirtyRegions );
+
+    // The first frame records and fills the frame copy.
+    Canvas->renderFrame( false, false );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 frame = 0; frame < frames; ++frame )
+        Canvas->renderFrame( false, false );
+    glFinish();
+    const U32 elapsedTime = Platform::getRealMilliseconds() - startTime;
+
+    readTestPixels( pPixels, extent );
+
+    return elapsedTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 countPixelDifferences( const U8* pExpected, const U8* pActual, const U32 byteCount )
+{
+    U32 differences = 0;
+    for ( U32 index = 0; index < byteCount; ++index )
+    {
+        if ( mAbs( (S32)pExpected[index] - (S32)pActual[index] ) > GUIRENDER_UNITTEST_PIXEL_TOLERANCE )
+            ++differences;
+    }
+
+    return differences;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns false when there is no rendering context to test with.
+static bool canRenderTestLayout( Point2I& extent )
+{
+    if ( Canvas == NULL || !TextureManager::mDGLRender || TextureManager::getManagerState() != TextureManager::Alive )
+        return false;
+
+    if ( Sim::findObject( "GuiDefaultProfile" ) == NULL )
+        return false;
+
+    extent = Platform::getWindowSize();
+    return extent.x > 0 && extent.y > 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Renders the test layout immediately, with draw lists and with dirty regions.
+/// Returns false when there is no rendering context to test with.
+static bool renderTestLayout( const U32 frames, U32 times[3], U32 differences[2], U32& byteCount )
+{
+    Point2I extent;
+    if ( !canRenderTestLayout( extent ) )
+        return false;
+
+    GuiControlProfile* pProfile = NULL;
+    Sim::findObject( "GuiDefaultProfile", pProfile );
+
+    const bool useDrawLists = Canvas->getUseDrawLists();
+    const bool useDirtyRegions = Canvas->getUseDirtyRegions();
+
+    GuiControl* pLayout = createTestLayout( pProfile, extent );
+    Canvas->pushDialogControl( pLayout, 99 );
+
+    byteCount = extent.x * extent.y * 3;
+    U8* pImmediatePixels = new U8[byteCount];
+    U8* pPixels = new U8[byteCount];
+
+    times[0] = renderTestFrames( false, false, frames, pImmediatePixels, extent );
+
+    times[1] = renderTestFrames( true, false, frames, pPixels, extent );
+    differences[0] = countPixelDifferences( pImmediatePixels, pPixels, byteCount );
+
+    times[2] = renderTestFrames( true, true, frames, pPixels, extent );
+    differences[1] = countPixelDifferences( pImmediatePixels, pPixels, byteCount );
+
+    Canvas->popDialogControl( pLayout );
+    pLayout->deleteObject();
+
+    Canvas->setUseDrawLists( useDrawLists );
+    Canvas->setUseDirtyRegions( useDirtyRegions );
+
+    delete [] pImmediatePixels;
+    delete [] pPixels;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Renders the test layout with draw lists, changes a control and the profile between
+/// frames and compares the next frame against a fresh immediate render.
+/// Returns false when there is no rendering context to test with.
+static bool renderChangedTestLayout( const bool useDirtyRegions, U32& changedDifferences, U32& differences, U32& byteCount )
+{
+    Point2I extent;
+    if ( !canRenderTestLayout( extent ) )
+        return false;
+
+    const bool useDrawLists = Canvas->getUseDrawLists();
+    const bool useDirtyRegionsState = Canvas->getUseDirtyRegions();
+
+    // A profile of our own that can be changed without affecting anything else.
+    GuiControlProfile* pProfile = new GuiControlProfile();
+    pProfile->registerObject();
+
+    GuiControl* pLayout = createTestLayout( pProfile, extent );
+    Canvas->pushDialogControl( pLayout, 99 );
+
+    byteCount = extent.x * extent.y * 3;
+    U8* pCachedPixels = new U8[byteCount];
+    U8* pPixels = new U8[byteCount];
+    U8* pFreshPixels = new U8[byteCount];
+
+    // Record the draw lists and the frame copy.
+    renderTestFrames( true, useDirtyRegions, GUIRENDER_UNITTEST_FRAMES, pCachedPixels, extent );
+
+    // The first child of the first panel is a text control.
+    GuiControl* pPanel = static_cast<GuiControl*>( pLayout->at( 0 ) );
+    GuiTextCtrl* pTextCtrl = dynamic_cast<GuiTextCtrl*>( pPanel->at( 0 ) );
+    AssertFatal( pTextCtrl != NULL, "renderChangedTestLayout() - Unexpected test layout." );
+    pTextCtrl->setText( "Changed between frames" );
+
+    // Profiles are changed from script, which does not mark any control dirty.
+    pProfile->setDataField( StringTable->insert( "fontColor" ), NULL, "255 0 0 255" );
+
+    // The next frame must pick up both changes without resetting the canvas.
+    Canvas->renderFrame( false, false );
+    glFinish();
+    readTestPixels( pPixels, extent );
+
+    // A fresh render of the changed layout.
+    Canvas->setUseDrawLists( false );
+    Canvas->setUseDirtyRegions( false );
+    Canvas->renderFrame( false, false );
+    glFinish();
+    readTestPixels( pFreshPixels, extent );
+
+    changedDifferences = countPixelDifferences( pCachedPixels, pFreshPixels, byteCount );
+    differences = countPixelDifferences( pPixels, pFreshPixels, byteCount );
+
+    Canvas->popDialogControl( pLayout );
+    pLayout->deleteObject();
+    pProfile->deleteObject();
+
+    Canvas->setUseDrawLists( useDrawLists );
+    Canvas->setUseDirtyRegions( useDirtyRegionsState );
+
+    delete [] pCachedPixels;
+    delete [] pPixels;
+    delete [] pFreshPixels;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( GuiRenderTests, RenderMatchTest )
+{
+    U32 times[3];
+    U32 differences[2];
+    U32 byteCount;
+    if ( !renderTestLayout( GUIRENDER_UNITTEST_FRAMES, times, differences, byteCount ) )
+        return;
+
+    // Allow for small rasterization differences at line ends.
+    ASSERT_LE( differences[0], byteCount / 100 ) << "Draw lists did not match immediate rendering.";
+    ASSERT_LE( differences[1], byteCount / 100 ) << "Dirty regions did not match immediate rendering.";
+
+    // Cached rendering must follow changes made between frames.
+    U32 changedDifferences;
+    ASSERT_TRUE( renderChangedTestLayout( false, changedDifferences, differences[0], byteCount ) ) << "Rendering context was lost.";
+    ASSERT_GT( changedDifferences, 0u ) << "Changing the layout did not change the rendering.";
+    ASSERT_LE( differences[0], byteCount / 100 ) << "Draw lists did not pick up the changes.";
+
+    ASSERT_TRUE( renderChangedTestLayout( true, changedDifferences, differences[1], byteCount ) ) << "Rendering context was lost.";
+    ASSERT_GT( changedDifferences, 0u ) << "Changing the layout did not change the rendering.";
+    ASSERT_LE( differences[1], byteCount / 100 ) << "Dirty regions did not pick up the changes.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( GuiRenderTests, BenchmarkTest )
+{
+    U32 times[3];
+    U32 differences[2];
+    U32 byteCount;
+    if ( !renderTestLayout( GUIRENDER_UNITTEST_BENCHMARK_FRAMES, times, differences, byteCount ) )
+        return;
+
+    RecordProperty( "Controls", GUIRENDER_UNITTEST_PANELS * ( GUIRENDER_UNITTEST_PANEL_CHILDREN + 1 ) );
+    RecordProperty( "ImmediateMilliseconds", (S32)times[0] );
+    RecordProperty( "DrawListMilliseconds", (S32)times[1] );
+    RecordProperty( "DirtyRegionMilliseconds", (S32)times[2] );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,196 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _FLATHASHMAP_H_
+#include "collection/flatHashMap.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define HASHMAP_UNITTEST_ELEMENTS               4096
+#define HASHMAP_UNITTEST_BENCHMARK_ELEMENTS     (1 << 16)
+#define HASHMAP_UNITTEST_BENCHMARK_PASSES       8
+
+//-----------------------------------------------------------------------------
+
+TEST( HashMapTests, FlatHashMapTest )
+{
+    FlatHashMap<U32, U32> map;
+    HashMap<U32, U32> reference;
+
+    // Insert a mixture of sequential and scattered keys.
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_ELEMENTS; ++index )
+    {
+        const U32 key = ( index & 1 ) ? index : index * 2654435761u;
+        ASSERT_NE( map.end(), map.insert( key, index ) ) << "Failed to insert a new key.";
+        reference.insert( key, index );
+    }
+
+    ASSERT_EQ( (U32)HASHMAP_UNITTEST_ELEMENTS, map.size() ) << "Map has the wrong size.";
+    ASSERT_EQ( map.end(), map.insert( 1, 0 ) ) << "Inserted a duplicate key.";
+
+    // Everything in the reference map must be found.
+    for ( HashMap<U32, U32>::iterator itr = reference.begin(); itr != reference.end(); ++itr )
+    {
+        FlatHashMap<U32, U32>::iterator found = map.find( itr->key );
+        ASSERT_NE( map.end(), found ) << "Key was not found.";
+        ASSERT_EQ( itr->value, found->value ) << "Key has the wrong value.";
+    }
+
+    // Erase every third key.
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_ELEMENTS; index += 3 )
+    {
+        const U32 key = ( index & 1 ) ? index : index * 2654435761u;
+        map.erase( key );
+        reference.erase( key );
+    }
+
+    ASSERT_EQ( reference.size(), map.size() ) << "Map has the wrong size after erasing.";
+
+    // Iteration must visit each remaining key exactly once.
+    U32 visited = 0;
+    for ( FlatHashMap<U32, U32>::iterator itr = map.begin(); itr != map.end(); ++itr )
+    {
+        HashMap<U32, U32>::iterator found = reference.find( itr->key );
+        ASSERT_NE( reference.end(), found ) << "Erased key was iterated.";
+        ASSERT_EQ( found->value, itr->value ) << "Iterated key has the wrong value.";
+        visited++;
+    }
+    ASSERT_EQ( reference.size(), visited ) << "Iteration visited the wrong number of keys.";
+
+    // Small ranges of ids iterate in order.
+    FlatHashMap<U32, U32> ids;
+    for ( U32 id = 1; id <= 100; ++id )
+        ids[id] = id;
+    U32 lastId = 0;
+    for ( FlatHashMap<U32, U32>::iterator itr = ids.begin(); itr != ids.end(); ++itr )
+    {
+        ASSERT_GT( itr->key, lastId ) << "Ids were not iterated in order.";
+        lastId = itr->key;
+    }
+
+    // Clearing keeps the storage; compacting releases it.
+    const U32 capacity = map.capacity();
+    map.clear();
+    ASSERT_TRUE( map.isEmpty() ) << "Map is not empty after clearing.";
+    ASSERT_EQ( map.end(), map.begin() ) << "Cleared map is not empty when iterated.";
+    ASSERT_EQ( capacity, map.capacity() ) << "Clearing released the storage.";
+    map.compact();
+    ASSERT_EQ( (U32)0, map.capacity() ) << "Compacting did not release the storage.";
+
+    // String keys compare like HashTable does.
+    FlatHashMap<StringTableEntry, U32> names;
+    names.insert( StringTable->insert( "Sprite" ), 1 );
+    ASSERT_NE( names.end(), names.find( StringTable->insert( "Sprite" ) ) ) << "String key was not found.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+template<class MapType> static void runHashMapBenchmark( const U32* pKeys, U32& insertTime, U32& findTime, U32& iterateTime, U32& eraseTime, U32& checksum )
+{
+    MapType map;
+
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        map.insert( pKeys[index], index );
+    insertTime += Platform::getRealMilliseconds() - startTime;
+
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < HASHMAP_UNITTEST_BENCHMARK_PASSES; ++pass )
+    {
+        for ( U32 index = 0; index < HASHMAP_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+            checksum += map.find( pKeys[index] )->value;
+    }
+    findTime += Platform::getRealMilliseconds() - startTime;
+
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < HASHMAP_UNITTEST_BENCHMARK_PASSES; ++pass )
+    {
+        for ( typename MapType::iterator itr = map.begin(); itr != map.end(); ++itr )
+            checksum += itr->value;
+    }
+    iterateTime += Platform::getRealMilliseconds() - startTime;
+
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        map.erase( pKeys[index] );
+    eraseTime += Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( HashMapTests, BenchmarkTest )
+{
+    // Object ids are mostly sequential whereas pointers are scattered.
+    U32* pKeys = new U32[HASHMAP_UNITTEST_BENCHMARK_ELEMENTS];
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        pKeys[index] = ( index & 3 ) ? index + 1 : ( index + 1 ) * 2654435761u;
+
+    U32 chainedInsertTime = 0, chainedFindTime = 0, chainedIterateTime = 0, chainedEraseTime = 0, chainedChecksum = 0;
+    U32 flatInsertTime = 0, flatFindTime = 0, flatIterateTime = 0, flatEraseTime = 0, flatChecksum = 0;
+
+    runHashMapBenchmark< HashMap<U32, U32> >( pKeys, chainedInsertTime, chainedFindTime, chainedIterateTime, chainedEraseTime, chainedChecksum );
+    runHashMapBenchmark< FlatHashMap<U32, U32> >( pKeys, flatInsertTime, flatFindTime, flatIterateTime, flatEraseTime, flatChecksum );
+    ASSERT_EQ( chainedChecksum, flatChecksum ) << "Maps hold different values.";
+
+    // Memory overhead: a chained table has a bucket pointer per slot plus a heap node per entry.
+    HashTable<U32, U32> chained;
+    FlatHashMap<U32, U32> flat;
+    for ( U32 index = 0; index < HASHMAP_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+    {
+        chained.insertUnique( pKeys[index], index );
+        flat.insert( pKeys[index], index );
+    }
+
+    const U32 chainedBytes = chained.tableSize() * sizeof(void*) + chained.size() * ( sizeof(void*) + sizeof(HashTable<U32, U32>::Pair) );
+
+    delete [] pKeys;
+
+    RecordProperty( "ChainedInsertMilliseconds", (S32)chainedInsertTime );
+    RecordProperty( "ChainedFindMilliseconds", (S32)chainedFindTime );
+    RecordProperty( "ChainedIterateMilliseconds", (S32)chainedIterateTime );
+    RecordProperty( "ChainedEraseMilliseconds", (S32)chainedEraseTime );
+    RecordProperty( "ChainedBytes", (S32)chainedBytes );
+    RecordProperty( "FlatInsertMilliseconds", (S32)flatInsertTime );
+    RecordProperty( "FlatFindMilliseconds", (S32)flatFindTime );
+    RecordProperty( "FlatIterateMilliseconds", (S32)flatIterateTime );
+    RecordProperty( "FlatEraseMilliseconds", (S32)flatEraseTime );
+    RecordProperty( "FlatBytes", (S32)flat.memSize() );
+    RecordProperty( "FlatProbeDistancePercent", (S32)( flat.averageProbeDistance() * 100.0f ) );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,142 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _GAMECONNECTION_H_
+#include "game/gameConnection.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define NETCONNECTION_UNITTEST_PACKET_SIZE          1024
+
+//-----------------------------------------------------------------------------
+
+class ConnectTestConnection : public GameConnection
+{
+public:
+    /// Write a connect request the way a peer that predates string compression does.
+    void writeOldConnectRequest( BitStream* stream )
+    {
+        NetConnection::writeConnectRequest( stream );
+        stream->writeString( GameString );
+        stream->write( GameConnection::MinRequiredProtocolVersion );
+        stream->write( GameConnection::MinRequiredProtocolVersion );
+        stream->writeString( "" );
+        stream->write( (U32)0 );
+    }
+
+    /// Read a connect accept the way a peer that predates string compression does.
+    bool readOldConnectAccept( BitStream* stream )
+    {
+        U32 protocolVersion;
+        stream->read( &protocolVersion );
+        return protocolVersion == GameConnection::MinRequiredProtocolVersion;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( NetConnectionTests, ConnectTest )
+{
+    ConnectTestConnection* pClient = new ConnectTestConnection();
+    ConnectTestConnection* pServer = new ConnectTestConnection();
+    pClient->registerObject();
+    pServer->registerObject();
+
+    U8 buffer[NETCONNECTION_UNITTEST_PACKET_SIZE];
+    const char* errorString = NULL;
+
+    // Request.
+    BitStream request( buffer, sizeof(buffer) );
+    pClient->writeConnectRequest( &request );
+    const S32 requestSize = request.getCurPos();
+    request.setCurPos( 0 );
+
+    // Check.
+    ASSERT_TRUE( pServer->readConnectRequest( &request, &errorString ) ) << "Connect request was rejected.";
+    ASSERT_EQ( requestSize, request.getCurPos() ) << "Connect request was not read completely.";
+    ASSERT_EQ( GameConnection::CurrentProtocolVersion, pServer->getProtocolVersion() ) << "Incorrect protocol version negotiated.";
+
+    // Accept.
+    BitStream accept( buffer, sizeof(buffer) );
+    pServer->writeConnectAccept( &accept );
+    const S32 acceptSize = accept.getCurPos();
+    accept.setCurPos( 0 );
+
+    // Check.
+    ASSERT_TRUE( pClient->readConnectAccept( &accept, &errorString ) ) << "Connect accept was rejected.";
+    ASSERT_EQ( acceptSize, accept.getCurPos() ) << "Connect accept was not read completely.";
+    ASSERT_EQ( pServer->isStringCompressed(), pClient->isStringCompressed() ) << "Connections disagree on string compression.";
+
+    pClient->deleteObject();
+    pServer->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetConnectionTests, OldPeerConnectTest )
+{
+    ConnectTestConnection* pClient = new ConnectTestConnection();
+    ConnectTestConnection* pServer = new ConnectTestConnection();
+    pClient->registerObject();
+    pServer->registerObject();
+
+    U8 buffer[NETCONNECTION_UNITTEST_PACKET_SIZE];
+    const char* errorString = NULL;
+
+    // An older client connecting to this server.
+    BitStream request( buffer, sizeof(buffer) );
+    pClient->writeOldConnectRequest( &request );
+    const S32 requestSize = request.getCurPos();
+    request.setCurPos( 0 );
+
+    // Check.
+    ASSERT_TRUE( pServer->readConnectRequest( &request, &errorString ) ) << "Older connect request was rejected.";
+    ASSERT_EQ( requestSize, request.getCurPos() ) << "Server read past the end of an older connect request.";
+    ASSERT_EQ( GameConnection::MinRequiredProtocolVersion, pServer->getProtocolVersion() ) << "Older protocol version was not negotiated.";
+    ASSERT_FALSE( pServer->isStringCompressed() ) << "String compression was enabled for an older client.";
+
+    BitStream accept( buffer, sizeof(buffer) );
+    pServer->writeConnectAccept( &accept );
+    const S32 acceptSize = accept.getCurPos();
+    accept.setCurPos( 0 );
+
+    // Check.
+    ASSERT_TRUE( pClient->readOldConnectAccept( &accept ) ) << "Older client could not read the connect accept.";
+    ASSERT_EQ( acceptSize, accept.getCurPos() ) << "Connect accept carries data an older client does not read.";
+
+    pClient->deleteObject();
+    pServer->deleteObject();
+}
+
+#endif // TORQUE_SHIPPING
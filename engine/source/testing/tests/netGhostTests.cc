@@ -0,0 +1,328 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _NETCONNECTION_H_
+#include "network/netConnection.h"
+#endif
+
+#ifndef _NETOBJECT_H_
+#include "network/netObject.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS       64
+#define NETGHOST_UNITTEST_BENCHMARK_GHOSTS            NetConnection::MaxGhostCount
+#define NETGHOST_UNITTEST_BENCHMARK_TICKS             32
+#define NETGHOST_UNITTEST_PACKET_SIZE                 1200
+
+//-----------------------------------------------------------------------------
+
+class GhostTestObject : public NetObject
+{
+public:
+    GhostTestObject( const F32 priority = -1.0f, const bool cached = false ) : mPriority( priority ), mPriorityCount( 0 )
+    {
+        mNetFlags.set( Ghostable );
+
+        if ( cached )
+            mNetFlags.set( CachedPriority );
+    }
+
+    // Use a fixed priority rather than the default if one is given.
+    virtual F32 getUpdatePriority( CameraScopeQuery* focusObject, U32 updateMask, S32 updateSkips )
+    {
+        mPriorityCount++;
+        return mPriority >= 0.0f ? mPriority : NetObject::getUpdatePriority( focusObject, updateMask, updateSkips );
+    }
+
+    virtual U32 packUpdate( NetConnection*, U32 mask, BitStream* stream )
+    {
+        stream->writeInt( getId(), 32 );
+        stream->writeInt( mask, 32 );
+        return 0;
+    }
+
+    F32 mPriority;
+    U32 mPriorityCount;
+};
+
+//-----------------------------------------------------------------------------
+
+class GhostTestCamera : public NetObject
+{
+public:
+    GhostTestCamera( const Point3F& position ) : mPosition( position ) {}
+
+    // Everything is scoped always so only describe the view.
+    virtual void onCameraScopeQuery( NetConnection* cr, CameraScopeQuery* camInfo )
+    {
+        camInfo->camera = this;
+        camInfo->pos = mPosition;
+        camInfo->visibleDistance = 100.0f;
+    }
+
+    Point3F mPosition;
+};
+
+//-----------------------------------------------------------------------------
+
+class GhostTestConnection : public NetConnection
+{
+public:
+    GhostTestConnection()
+    {
+        setGhostFrom( true );
+
+        // Normally done when ghosting is activated.
+        for ( S32 index = 0; index < MaxGhostCount; ++index )
+        {
+            mGhostArray[index] = mGhostRefs + index;
+            mGhostArray[index]->arrayIndex = index;
+        }
+
+        mScoping = true;
+        mGhosting = true;
+    }
+
+    virtual ~GhostTestConnection()
+    {
+        clearGhostInfo();
+    }
+
+    void scopeAlways( NetObject* pObject ) { objectLocalScopeAlways( pObject ); }
+
+    U32 getDirtyGhostCount( void ) const { return mGhostZeroUpdateIndex; }
+
+    /// Write a ghost packet and acknowledge it, returning the objects that were sent.
+    void writeGhostPacket( Vector<NetObject*>& sentObjects )
+    {
+        U8 buffer[MaxPacketDataSize];
+        BitStream stream( buffer, NETGHOST_UNITTEST_PACKET_SIZE, sizeof(buffer) );
+
+        PacketNotify* pNotify = allocNotify();
+        ghostWritePacket( &stream, pNotify );
+
+        sentObjects.clear();
+        for ( GhostRef* pRef = pNotify->ghostList; pRef != NULL; pRef = pRef->nextRef )
+            sentObjects.push_back( pRef->ghost->obj );
+
+        ghostPacketReceived( pNotify );
+        delete pNotify;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+static void checkPriorityOrder( const bool cached )
+{
+    const U32 objectCount = 1000;
+
+    GhostTestConnection* pConnection = new GhostTestConnection();
+
+    Vector<GhostTestObject*> objects;
+    for ( U32 index = 0; index < objectCount; ++index )
+    {
+        GhostTestObject* pObject = new GhostTestObject( F32( (index * 7919) % objectCount ), cached );
+        pObject->registerObject();
+        pConnection->scopeAlways( pObject );
+        objects.push_back( pObject );
+    }
+
+    // Ghost everything.
+    Vector<NetObject*> sentObjects;
+    for ( U32 packet = 0; packet < objectCount && pConnection->getDirtyGhostCount() > 0; ++packet )
+        pConnection->writeGhostPacket( sentObjects );
+
+    // Check.
+    ASSERT_EQ( (U32)0, pConnection->getDirtyGhostCount() ) << "Not all objects were ghosted.";
+
+    // Mark everything dirty.
+    for ( U32 index = 0; index < objectCount; ++index )
+        objects[index]->setMaskBits( BIT(0) );
+    NetObject::collapseDirtyList();
+
+    pConnection->writeGhostPacket( sentObjects );
+
+    // Check.
+    ASSERT_GT( sentObjects.size(), 0 ) << "No objects were sent.";
+    ASSERT_LT( (U32)sentObjects.size(), objectCount ) << "All objects fit in a single packet.";
+
+    // Every object sent must have a priority at least that of every object not sent.
+    F32 lowestSent = F32_MAX;
+    for ( S32 index = 0; index < sentObjects.size(); ++index )
+        lowestSent = getMin( lowestSent, static_cast<GhostTestObject*>( sentObjects[index] )->mPriority );
+
+    ASSERT_EQ( F32( objectCount - sentObjects.size() ), lowestSent ) << "Objects were not sent in priority order.";
+
+    delete pConnection;
+
+    for ( U32 index = 0; index < objectCount; ++index )
+        objects[index]->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetGhostTests, PriorityTest )
+{
+    // Overridden priorities are used without opting in.
+    checkPriorityOrder( false );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetGhostTests, CachedPriorityTest )
+{
+    checkPriorityOrder( true );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( NetGhostTests, SharedScopeTest )
+{
+    GhostTestConnection* pConnections[3];
+    GhostTestCamera* pCameras[3];
+
+    // Two cameras share a view and the third is elsewhere.
+    const Point3F positions[3] = { Point3F( 10.0f, 20.0f, 0.0f ), Point3F( 10.0f, 20.0f, 0.0f ), Point3F( -10.0f, 5.0f, 0.0f ) };
+
+    GhostTestObject* pObject = new GhostTestObject( 1.0f, true );
+    pObject->registerObject();
+
+    for ( U32 index = 0; index < 3; ++index )
+    {
+        pCameras[index] = new GhostTestCamera( positions[index] );
+        pCameras[index]->registerObject();
+
+        pConnections[index] = new GhostTestConnection();
+        pConnections[index]->setScopeObject( pCameras[index] );
+        pConnections[index]->scopeAlways( pObject );
+    }
+
+    // Ghost the object.
+    Vector<NetObject*> sentObjects;
+    for ( U32 index = 0; index < 3; ++index )
+        pConnections[index]->writeGhostPacket( sentObjects );
+
+    pObject->setMaskBits( BIT(0) );
+    NetObject::collapseDirtyList();
+    pObject->mPriorityCount = 0;
+
+    for ( U32 index = 0; index < 3; ++index )
+    {
+        pConnections[index]->writeGhostPacket( sentObjects );
+
+        // Check.
+        ASSERT_EQ( 1, sentObjects.size() ) << "Object update was not sent.";
+    }
+
+    // Check.
+    ASSERT_EQ( (U32)2, pObject->mPriorityCount ) << "Connections with the same view did not share the update priority.";
+
+    for ( U32 index = 0; index < 3; ++index )
+    {
+        delete pConnections[index];
+        pCameras[index]->deleteObject();
+    }
+
+    pObject->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( NetGhostTests, BenchmarkTest )
+{
+    Vector<GhostTestConnection*> connections;
+    for ( U32 index = 0; index < NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS; ++index )
+        connections.push_back( new GhostTestConnection() );
+
+    Vector<GhostTestObject*> objects;
+    for ( U32 index = 0; index < NETGHOST_UNITTEST_BENCHMARK_GHOSTS; ++index )
+    {
+        GhostTestObject* pObject = new GhostTestObject();
+        pObject->registerObject();
+        objects.push_back( pObject );
+
+        for ( U32 connection = 0; connection < NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS; ++connection )
+            connections[connection]->scopeAlways( pObject );
+    }
+
+    // Ghost everything.
+    Vector<NetObject*> sentObjects;
+    for ( U32 connection = 0; connection < NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS; ++connection )
+    {
+        while ( connections[connection]->getDirtyGhostCount() > 0 )
+            connections[connection]->writeGhostPacket( sentObjects );
+    }
+
+    // Each tick a quarter of the objects change and every connection sends a packet.
+    U32 packetCount = 0;
+    U32 ghostUpdateCount = 0;
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 tick = 0; tick < NETGHOST_UNITTEST_BENCHMARK_TICKS; ++tick )
+    {
+        for ( U32 index = tick % 4; index < NETGHOST_UNITTEST_BENCHMARK_GHOSTS; index += 4 )
+            objects[index]->setMaskBits( BIT(0) );
+        NetObject::collapseDirtyList();
+
+        for ( U32 connection = 0; connection < NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS; ++connection )
+        {
+            connections[connection]->writeGhostPacket( sentObjects );
+            ghostUpdateCount += sentObjects.size();
+            packetCount++;
+        }
+    }
+
+    const U32 elapsedTime = getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+
+    RecordProperty( "Connections", NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS );
+    RecordProperty( "Ghosts", NETGHOST_UNITTEST_BENCHMARK_GHOSTS );
+    RecordProperty( "NanosecondsPerPacket", (S32)( elapsedTime * 1000000.0 / packetCount ) );
+    RecordProperty( "GhostUpdatesPerPacket", (S32)( ghostUpdateCount / packetCount ) );
+
+    // Check.
+    ASSERT_GT( ghostUpdateCount, (U32)0 ) << "No ghosts were updated.";
+
+    for ( U32 connection = 0; connection < NETGHOST_UNITTEST_BENCHMARK_CONNECTIONS; ++connection )
+        delete connections[connection];
+
+    for ( U32 index = 0; index < NETGHOST_UNITTEST_BENCHMARK_GHOSTS; ++index )
+        objects[index]->deleteObject();
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
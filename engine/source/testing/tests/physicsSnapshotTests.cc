@@ -0,0 +1,289 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define PHYSICSSNAPSHOT_UNITTEST_PILES              100
+#define PHYSICSSNAPSHOT_UNITTEST_PILE_HEIGHT        10
+#define PHYSICSSNAPSHOT_UNITTEST_PILE_WIDTH         5
+#define PHYSICSSNAPSHOT_UNITTEST_SETTLE_STEPS       30
+#define PHYSICSSNAPSHOT_UNITTEST_REWIND_STEPS       5
+#define PHYSICSSNAPSHOT_UNITTEST_RESIMULATE_STEPS   120
+#define PHYSICSSNAPSHOT_UNITTEST_BENCHMARK_ROUNDS   100
+#define PHYSICSSNAPSHOT_UNITTEST_SCENE_OBJECTS      200
+
+//-----------------------------------------------------------------------------
+
+static b2World* createSnapshotWorld( void )
+{
+    b2World* pWorld = new b2World( b2Vec2( 0.0f, -10.0f ) );
+
+    b2PolygonShape boxShape;
+    boxShape.SetAsBox( 0.5f, 0.5f );
+
+    b2CircleShape circleShape;
+    circleShape.m_radius = 0.4f;
+
+    b2PolygonShape groundShape;
+    groundShape.SetAsBox( PHYSICSSNAPSHOT_UNITTEST_PILE_WIDTH * 1.5f, 0.5f );
+
+    for ( U32 pile = 0; pile < PHYSICSSNAPSHOT_UNITTEST_PILES; ++pile )
+    {
+        const F32 pileX = pile * PHYSICSSNAPSHOT_UNITTEST_PILE_WIDTH * 4.0f;
+
+        b2BodyDef groundDef;
+        groundDef.position.Set( pileX, 0.0f );
+        pWorld->CreateBody( &groundDef )->CreateFixture( &groundShape, 0.0f );
+
+        // Stagger the rows so the piles topple over and contacts come and go.
+        b2Body* pPreviousBody = NULL;
+        for ( U32 row = 0; row < PHYSICSSNAPSHOT_UNITTEST_PILE_HEIGHT; ++row )
+        {
+            for ( U32 column = 0; column < PHYSICSSNAPSHOT_UNITTEST_PILE_WIDTH; ++column )
+            {
+                b2BodyDef bodyDef;
+                bodyDef.type = b2_dynamicBody;
+                bodyDef.position.Set( pileX + column * 1.1f + (row % 2) * 0.3f, 1.0f + row * 1.05f );
+                bodyDef.angle = 0.05f * (F32)(column + row);
+
+                b2Body* pBody = pWorld->CreateBody( &bodyDef );
+                if ( (row + column) % 3 == 0 )
+                    pBody->CreateFixture( &circleShape, 1.0f );
+                else
+                    pBody->CreateFixture( &boxShape, 1.0f );
+
+                // Chain the top row together with limited revolute joints.
+                if ( row == PHYSICSSNAPSHOT_UNITTEST_PILE_HEIGHT - 1 && column > 0 )
+                {
+                    b2RevoluteJointDef jointDef;
+                    jointDef.Initialize( pPreviousBody, pBody, pPreviousBody->GetWorldCenter() );
+                    jointDef.enableLimit = true;
+                    jointDef.lowerAngle = -0.2f;
+                    jointDef.upperAngle = 0.2f;
+                    pWorld->CreateJoint( &jointDef );
+                }
+
+                pPreviousBody = pBody;
+            }
+        }
+    }
+
+    return pWorld;
+}
+
+//-----------------------------------------------------------------------------
+
+static void stepSnapshotWorld( b2World* pWorld, const U32 steps )
+{
+    for ( U32 step = 0; step < steps; ++step )
+        pWorld->Step( 1.0f / 60.0f, 8, 3 );
+}
+
+//-----------------------------------------------------------------------------
+
+static void saveBodyStates( b2World* pWorld, Vector<b2Transform>& transforms, Vector<b2Vec2>& velocities )
+{
+    transforms.clear();
+    velocities.clear();
+    for ( b2Body* pBody = pWorld->GetBodyList(); pBody != NULL; pBody = pBody->GetNext() )
+    {
+        transforms.push_back( pBody->GetTransform() );
+        velocities.push_back( pBody->GetLinearVelocity() );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void checkBodyStates( b2World* pWorld, const Vector<b2Transform>& transforms, const Vector<b2Vec2>& velocities )
+{
+    S32 index = 0;
+    for ( b2Body* pBody = pWorld->GetBodyList(); pBody != NULL; pBody = pBody->GetNext(), ++index )
+    {
+        const b2Vec2 velocity = pBody->GetLinearVelocity();
+        ASSERT_EQ( 0, dMemcmp( &pBody->GetTransform(), &transforms[index], sizeof(b2Transform) ) ) << "Resimulated body transform differs.";
+        ASSERT_EQ( 0, dMemcmp( &velocity, &velocities[index], sizeof(b2Vec2) ) ) << "Resimulated body velocity differs.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PhysicsSnapshotTests, ResimulationTest )
+{
+    b2World* pWorld = createSnapshotWorld();
+    stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_SETTLE_STEPS );
+
+    // Take a snapshot and simulate on.
+    b2WorldSnapshot snapshot;
+    pWorld->SaveSnapshot( &snapshot );
+    ASSERT_TRUE( snapshot.IsValid() ) << "Snapshot was not saved.";
+
+    const S32 contactCount = pWorld->GetContactCount();
+    stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_RESIMULATE_STEPS );
+
+    Vector<b2Transform> transforms;
+    Vector<b2Vec2> velocities;
+    saveBodyStates( pWorld, transforms, velocities );
+    const S32 awakeCount = pWorld->GetAwakeBodyCount();
+
+    // Rewind and resimulate a few times. The contacts change as the piles topple so
+    // this covers recreating destroyed contacts as well as freeing new ones.
+    for ( U32 round = 0; round < 3; ++round )
+    {
+        ASSERT_TRUE( pWorld->RestoreSnapshot( snapshot ) ) << "Snapshot was not restored.";
+        ASSERT_EQ( contactCount, pWorld->GetContactCount() ) << "Restored contact count is wrong.";
+
+        stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_RESIMULATE_STEPS );
+        checkBodyStates( pWorld, transforms, velocities );
+        ASSERT_EQ( awakeCount, pWorld->GetAwakeBodyCount() ) << "Resimulated awake count differs.";
+    }
+
+    // Changing the bodies invalidates the snapshot.
+    b2BodyDef bodyDef;
+    pWorld->CreateBody( &bodyDef );
+    ASSERT_FALSE( pWorld->RestoreSnapshot( snapshot ) ) << "Snapshot was restored after the bodies changed.";
+
+    delete pWorld;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PhysicsSnapshotTests, SceneRestoreTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+    pScene->setGravity( b2Vec2( 0.0f, -10.0f ) );
+
+    // A static floor with boxes dropping onto it.
+    SceneObject* pGround = new SceneObject();
+    pGround->setBodyType( b2_staticBody );
+    pGround->createPolygonBoxCollisionShape( 500.0f, 1.0f );
+    pGround->registerObject();
+    pScene->addToScene( pGround );
+
+    for ( U32 index = 0; index < PHYSICSSNAPSHOT_UNITTEST_SCENE_OBJECTS; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->setBodyType( b2_dynamicBody );
+        pSceneObject->setPosition( Vector2( (F32)(index % 100) * 2.0f - 100.0f, 2.0f + (F32)(index / 100) * 1.5f ) );
+        pSceneObject->createPolygonBoxCollisionShape( 1.0f, 1.0f );
+        pSceneObject->setGatherContacts( true );
+        pSceneObject->registerObject();
+        pScene->addToScene( pSceneObject );
+    }
+
+    // Rewind a few ticks and resimulate.
+    b2WorldSnapshot snapshot;
+    pScene->savePhysicsSnapshot( snapshot );
+    for ( U32 tick = 0; tick < PHYSICSSNAPSHOT_UNITTEST_REWIND_STEPS * 10; ++tick )
+        pScene->processTick();
+
+    Vector<b2Transform> transforms;
+    Vector<b2Vec2> velocities;
+    saveBodyStates( pScene->getWorld(), transforms, velocities );
+
+    ASSERT_TRUE( pScene->restorePhysicsSnapshot( snapshot ) ) << "Scene snapshot was not restored.";
+    for ( U32 tick = 0; tick < PHYSICSSNAPSHOT_UNITTEST_REWIND_STEPS * 10; ++tick )
+        pScene->processTick();
+
+    checkBodyStates( pScene->getWorld(), transforms, velocities );
+
+    // The gathered contacts should match the restored world.
+    const typeSceneObjectVector& sceneObjects = pScene->getSceneObjects();
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = sceneObjects[index];
+        if ( !pSceneObject->getGatherContacts() )
+            continue;
+
+        U32 touchingCount = 0;
+        for ( b2ContactEdge* pContactEdge = pSceneObject->getBody()->GetContactList(); pContactEdge != NULL; pContactEdge = pContactEdge->next )
+        {
+            if ( pContactEdge->contact->IsTouching() )
+                touchingCount++;
+        }
+        ASSERT_EQ( touchingCount, pSceneObject->getCurrentContactCount() ) << "Gathered contacts do not match the world.";
+    }
+
+    pScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( PhysicsSnapshotTests, BenchmarkTest )
+{
+    b2World* pWorld = createSnapshotWorld();
+    stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_SETTLE_STEPS );
+
+    b2WorldSnapshot snapshot;
+    U32 saveTime = 0;
+    U32 restoreTime = 0;
+    U32 rewindTime = 0;
+
+    for ( U32 round = 0; round < PHYSICSSNAPSHOT_UNITTEST_BENCHMARK_ROUNDS; ++round )
+    {
+        // Save every step as a server would.
+        U32 startTime = Platform::getRealMilliseconds();
+        pWorld->SaveSnapshot( &snapshot );
+        saveTime += Platform::getRealMilliseconds() - startTime;
+
+        // Restore with nothing changed.
+        startTime = Platform::getRealMilliseconds();
+        pWorld->RestoreSnapshot( snapshot );
+        restoreTime += Platform::getRealMilliseconds() - startTime;
+
+        // Restore after a few steps.
+        stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_REWIND_STEPS );
+        startTime = Platform::getRealMilliseconds();
+        pWorld->RestoreSnapshot( snapshot );
+        rewindTime += Platform::getRealMilliseconds() - startTime;
+
+        stepSnapshotWorld( pWorld, PHYSICSSNAPSHOT_UNITTEST_REWIND_STEPS );
+    }
+
+    RecordProperty( "SnapshotBytes", (S32)snapshot.GetSize() );
+    RecordProperty( "SaveMicroseconds", (S32)( saveTime * 1000 / PHYSICSSNAPSHOT_UNITTEST_BENCHMARK_ROUNDS ) );
+    RecordProperty( "RestoreMicroseconds", (S32)( restoreTime * 1000 / PHYSICSSNAPSHOT_UNITTEST_BENCHMARK_ROUNDS ) );
+    RecordProperty( "RewindMicroseconds", (S32)( rewindTime * 1000 / PHYSICSSNAPSHOT_UNITTEST_BENCHMARK_ROUNDS ) );
+
+    delete pWorld;
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,272 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PHYSICS_WORKER_POOL_H_
+#include "2d/scene/PhysicsWorkerPool.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define PHYSICSSOLVER_UNITTEST_PILES            64
+#define PHYSICSSOLVER_UNITTEST_PILE_HEIGHT      10
+#define PHYSICSSOLVER_UNITTEST_PILE_WIDTH       5
+#define PHYSICSSOLVER_UNITTEST_STEPS            120
+#define PHYSICSSOLVER_UNITTEST_MAX_THREADS      8
+
+//-----------------------------------------------------------------------------
+
+/// Records the order of contact begin and end callbacks by fixture number.
+class PhysicsSolverTestListener : public b2ContactListener
+{
+public:
+    virtual void BeginContact( b2Contact* pContact ) { record( 1, pContact ); }
+    virtual void EndContact( b2Contact* pContact ) { record( 0, pContact ); }
+
+    Vector<U32> mEvents;
+
+private:
+    void record( const U32 begin, b2Contact* pContact )
+    {
+        const U32 fixtureA = (U32)(dsize_t)pContact->GetFixtureA()->GetUserData();
+        const U32 fixtureB = (U32)(dsize_t)pContact->GetFixtureB()->GetUserData();
+        mEvents.push_back( (begin << 31) | (fixtureA << 15) | fixtureB );
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+static b2World* createPileWorld( PhysicsWorkerPool* pPool, const bool parallelCollide, b2ContactListener* pListener = NULL )
+{
+    b2World* pWorld = new b2World( b2Vec2( 0.0f, -10.0f ) );
+    pWorld->SetTaskExecutor( pPool );
+    pWorld->SetParallelNarrowPhase( parallelCollide );
+    pWorld->SetContactListener( pListener );
+
+    b2PolygonShape boxShape;
+    boxShape.SetAsBox( 0.5f, 0.5f );
+
+    // Fixtures are numbered so contacts can be told apart across worlds.
+    U32 fixtureCount = 0;
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &boxShape;
+    fixtureDef.density = 1.0f;
+
+    // Every pile stands on the one static ground body.  Islands are not joined
+    // through static bodies so the piles still form separate islands that are
+    // solved concurrently against the same ground.
+    b2BodyDef groundDef;
+    b2Body* pGround = pWorld->CreateBody( &groundDef );
+
+    for ( U32 pile = 0; pile < PHYSICSSOLVER_UNITTEST_PILES; ++pile )
+    {
+        const F32 pileX = pile * PHYSICSSOLVER_UNITTEST_PILE_WIDTH * 4.0f;
+
+        b2PolygonShape groundShape;
+        groundShape.SetAsBox( PHYSICSSOLVER_UNITTEST_PILE_WIDTH * 1.5f, 0.5f, b2Vec2( pileX, 0.0f ), 0.0f );
+        b2FixtureDef groundFixtureDef;
+        groundFixtureDef.shape = &groundShape;
+        groundFixtureDef.userData = (void*)(dsize_t)fixtureCount++;
+        pGround->CreateFixture( &groundFixtureDef );
+
+        // Stagger the rows so the piles topple over.
+        for ( U32 row = 0; row < PHYSICSSOLVER_UNITTEST_PILE_HEIGHT; ++row )
+        {
+            for ( U32 column = 0; column < PHYSICSSOLVER_UNITTEST_PILE_WIDTH; ++column )
+            {
+                b2BodyDef bodyDef;
+                bodyDef.type = b2_dynamicBody;
+                bodyDef.position.Set( pileX + column * 1.1f + (row % 2) * 0.3f, 1.0f + row * 1.05f );
+                bodyDef.angle = 0.05f * (F32)(column + row);
+                fixtureDef.userData = (void*)(dsize_t)fixtureCount++;
+                pWorld->CreateBody( &bodyDef )->CreateFixture( &fixtureDef );
+            }
+        }
+
+        // A pendulum hinged to the ground so joints also share the static body.
+        b2BodyDef pendulumDef;
+        pendulumDef.type = b2_dynamicBody;
+        pendulumDef.position.Set( pileX - PHYSICSSOLVER_UNITTEST_PILE_WIDTH * 1.5f, 4.0f );
+        b2Body* pPendulum = pWorld->CreateBody( &pendulumDef );
+        fixtureDef.userData = (void*)(dsize_t)fixtureCount++;
+        pPendulum->CreateFixture( &fixtureDef );
+
+        b2RevoluteJointDef jointDef;
+        jointDef.Initialize( pGround, pPendulum, b2Vec2( pileX - PHYSICSSOLVER_UNITTEST_PILE_WIDTH * 1.5f + 2.0f, 4.0f ) );
+        pWorld->CreateJoint( &jointDef );
+    }
+
+    return pWorld;
+}
+
+//-----------------------------------------------------------------------------
+
+static void stepPileWorld( b2World* pWorld )
+{
+    for ( U32 step = 0; step < PHYSICSSOLVER_UNITTEST_STEPS; ++step )
+        pWorld->Step( 1.0f / 60.0f, 8, 3 );
+}
+
+//-----------------------------------------------------------------------------
+
+static void checkWorldsMatch( b2World* pWorldA, b2World* pWorldB )
+{
+    ASSERT_EQ( pWorldA->GetBodyCount(), pWorldB->GetBodyCount() ) << "Body counts differ.";
+    ASSERT_EQ( pWorldA->GetContactCount(), pWorldB->GetContactCount() ) << "Contact counts differ.";
+
+    // The bodies are created in the same order so the lists line up.
+    for ( b2Body* pBodyA = pWorldA->GetBodyList(), *pBodyB = pWorldB->GetBodyList(); pBodyA != NULL; pBodyA = pBodyA->GetNext(), pBodyB = pBodyB->GetNext() )
+    {
+        const b2Transform& transformA = pBodyA->GetTransform();
+        const b2Transform& transformB = pBodyB->GetTransform();
+        ASSERT_EQ( 0, dMemcmp( &transformA, &transformB, sizeof(b2Transform) ) ) << "Body transforms differ.";
+
+        const b2Vec2 velocityA = pBodyA->GetLinearVelocity();
+        const b2Vec2 velocityB = pBodyB->GetLinearVelocity();
+        ASSERT_EQ( 0, dMemcmp( &velocityA, &velocityB, sizeof(b2Vec2) ) ) << "Body velocities differ.";
+        ASSERT_EQ( pBodyA->IsAwake(), pBodyB->IsAwake() ) << "Body sleep states differ.";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void checkDeterminism( const bool parallelCollide )
+{
+    // Step with a single thread as the reference.
+    PhysicsWorkerPool referencePool( 1 );
+    PhysicsSolverTestListener referenceListener;
+    b2World* pReferenceWorld = createPileWorld( &referencePool, parallelCollide, &referenceListener );
+    stepPileWorld( pReferenceWorld );
+    ASSERT_GT( referenceListener.mEvents.size(), 0 ) << "No contacts were reported.";
+
+    for ( U32 threadCount = 2; threadCount <= PHYSICSSOLVER_UNITTEST_MAX_THREADS; threadCount *= 2 )
+    {
+        PhysicsWorkerPool pool( threadCount );
+        PhysicsSolverTestListener listener;
+        b2World* pWorld = createPileWorld( &pool, parallelCollide, &listener );
+        stepPileWorld( pWorld );
+
+        checkWorldsMatch( pReferenceWorld, pWorld );
+
+        // Contacts must begin and end in the same order whatever the thread count.
+        ASSERT_EQ( referenceListener.mEvents.size(), listener.mEvents.size() ) << "Contact event counts differ.";
+        for ( S32 index = 0; index < listener.mEvents.size(); ++index )
+            ASSERT_EQ( referenceListener.mEvents[index], listener.mEvents[index] ) << "Contact events differ in order at " << index << ".";
+
+        delete pWorld;
+    }
+
+    delete pReferenceWorld;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PhysicsSolverTests, DeterminismTest )
+{
+    checkDeterminism( false );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PhysicsSolverTests, ParallelCollideDeterminismTest )
+{
+    checkDeterminism( true );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PhysicsSolverTests, ThreadCountClampTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    pScene->setPhysicsThreadCount( 0 );
+    ASSERT_EQ( 0, pScene->getPhysicsThreadCount() ) << "Zero should select the serial solver.";
+
+    // Asking for far more threads than processors should be clamped.
+    const U32 processorCount = PlatformSystemInfo.processor.numLogicalProcessors;
+    pScene->setPhysicsThreadCount( 1024 );
+    if ( processorCount > 0 )
+    {
+        ASSERT_EQ( processorCount, pScene->getPhysicsThreadCount() ) << "Thread count was not clamped to the processor count.";
+    }
+    else
+    {
+        ASSERT_EQ( 1024, pScene->getPhysicsThreadCount() ) << "Thread count should be left alone when the processor count is unknown.";
+    }
+
+    pScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( PhysicsSolverTests, BenchmarkTest )
+{
+    // Serial solver.
+    b2World* pWorld = createPileWorld( NULL, false );
+    U32 startTime = Platform::getRealMilliseconds();
+    stepPileWorld( pWorld );
+    U32 stepTime = Platform::getRealMilliseconds() - startTime;
+    delete pWorld;
+
+    RecordProperty( "SerialStepMicroseconds", (S32)( stepTime * 1000 / PHYSICSSOLVER_UNITTEST_STEPS ) );
+
+    // Island solver.
+    for ( U32 threadCount = 1; threadCount <= PHYSICSSOLVER_UNITTEST_MAX_THREADS; threadCount *= 2 )
+    {
+        PhysicsWorkerPool pool( threadCount );
+
+        pWorld = createPileWorld( &pool, false );
+        startTime = Platform::getRealMilliseconds();
+        stepPileWorld( pWorld );
+        stepTime = Platform::getRealMilliseconds() - startTime;
+        delete pWorld;
+
+        pWorld = createPileWorld( &pool, true );
+        startTime = Platform::getRealMilliseconds();
+        stepPileWorld( pWorld );
+        const U32 collideStepTime = Platform::getRealMilliseconds() - startTime;
+        delete pWorld;
+
+        char propertyName[64];
+        dSprintf( propertyName, sizeof(propertyName), "Threads%dStepMicroseconds", threadCount );
+        RecordProperty( propertyName, (S32)( stepTime * 1000 / PHYSICSSOLVER_UNITTEST_STEPS ) );
+        dSprintf( propertyName, sizeof(propertyName), "Threads%dCollideStepMicroseconds", threadCount );
+        RecordProperty( propertyName, (S32)( collideStepTime * 1000 / PHYSICSSOLVER_UNITTEST_STEPS ) );
+    }
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
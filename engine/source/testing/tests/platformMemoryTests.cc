@@ -31,9 +31,34 @@
 #include "platform/platform.h"
 #endif
 
+#if defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR)
+
+#ifndef _PLATFORM_THREADS_THREAD_H_
+#include "platform/threads/thread.h"
+#endif
+
+#endif
+
+#if defined(TORQUE_BENCHMARK_TESTS) && (defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR))
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#endif
+
 //-----------------------------------------------------------------------------
 
 #define PLATFORM_UNITTEST_MEMORY_BUFFERSIZE     16384
+#define PLATFORM_UNITTEST_MEMORY_SCENEOBJECTS   2000
+#define PLATFORM_UNITTEST_MEMORY_SCENELOADS     8
+#define PLATFORM_UNITTEST_MEMORY_SCRIPTLOOPS    4
+#define PLATFORM_UNITTEST_MEMORY_THREADS        80
+#define PLATFORM_UNITTEST_MEMORY_THREADBLOCKS   100
 
 //-----------------------------------------------------------------------------
 
@@ -166,5 +191,318 @@ TEST( PlatformMemoryTests, dMemcmpTest )
     ASSERT_GT( 0, result3 ) << "Memory compare is incorrect.";
 }
 
+#if defined(TORQUE_BENCHMARK_TESTS) && (defined(TORQUE_TRACK_MEMORY) || defined(TORQUE_POOLED_ALLOCATOR))
+
+//-----------------------------------------------------------------------------
+
+static U32 loadTestScene( void )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_SCENEOBJECTS; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->registerObject();
+        pSceneObject->setPosition( Vector2( F32(index % 64), F32(index / 64) ) );
+        pSceneObject->setSize( Vector2( 1.0f, 1.0f ) );
+        pSceneObject->createPolygonBoxCollisionShape( 1.0f, 1.0f );
+        pScene->addToScene( pSceneObject );
+    }
+
+    pScene->deleteObject();
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+#endif
+
+#ifdef TORQUE_TRACK_MEMORY
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, TrackingTest )
+{
+    const S64 liveBytes = Memory::getLiveBytes();
+    const S64 liveAllocations = Memory::getLiveAllocations();
+
+    void* pFirst = dMalloc_r( PLATFORM_UNITTEST_MEMORY_BUFFERSIZE, __FILE__, __LINE__ );
+    void* pSecond = NULL;
+
+    {
+        MEMORY_TAG_SCOPE( PlatformMemoryTests );
+        pSecond = dMalloc_r( PLATFORM_UNITTEST_MEMORY_BUFFERSIZE, __FILE__, __LINE__ );
+        pSecond = dRealloc_r( pSecond, PLATFORM_UNITTEST_MEMORY_BUFFERSIZE * 2, __FILE__, __LINE__ );
+    }
+
+    // Check.
+    ASSERT_EQ( liveBytes + PLATFORM_UNITTEST_MEMORY_BUFFERSIZE * 3, Memory::getLiveBytes() ) << "Live bytes are incorrect.";
+    ASSERT_EQ( liveAllocations + 2, Memory::getLiveAllocations() ) << "Live allocations are incorrect.";
+    ASSERT_EQ( PLATFORM_UNITTEST_MEMORY_BUFFERSIZE * 2, Memory::getLiveBytes( "PlatformMemoryTests" ) ) << "Tagged bytes are incorrect.";
+    ASSERT_EQ( PLATFORM_UNITTEST_MEMORY_BUFFERSIZE, Memory::getLiveBytes( "testing" ) ) << "Call site bytes are incorrect.";
+
+    dFree( pFirst );
+    dFree( pSecond );
+
+    // Check.
+    ASSERT_EQ( liveBytes, Memory::getLiveBytes() ) << "Freed bytes were not released.";
+    ASSERT_EQ( 0, Memory::getLiveBytes( "PlatformMemoryTests" ) ) << "Freed tagged bytes were not released.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, NewTrackingTest )
+{
+    const S64 liveAllocations = Memory::getLiveAllocations();
+
+    U8* pArray = NULL;
+    U32* pValue = NULL;
+
+    {
+        MEMORY_TAG_SCOPE( PlatformMemoryNewTests );
+        pArray = new U8[PLATFORM_UNITTEST_MEMORY_BUFFERSIZE];
+        pValue = new U32( 42 );
+    }
+
+    // Check.
+    ASSERT_EQ( liveAllocations + 2, Memory::getLiveAllocations() ) << "Allocations made with new were not counted.";
+    ASSERT_EQ( S64(PLATFORM_UNITTEST_MEMORY_BUFFERSIZE + sizeof(U32)), Memory::getLiveBytes( "PlatformMemoryNewTests" ) ) << "Tagged bytes allocated with new are incorrect.";
+
+    delete [] pArray;
+    delete pValue;
+
+    // Check.
+    ASSERT_EQ( liveAllocations, Memory::getLiveAllocations() ) << "Allocations freed with delete were not released.";
+    ASSERT_EQ( 0, Memory::getLiveBytes( "PlatformMemoryNewTests" ) ) << "Tagged bytes freed with delete were not released.";
+}
+
+//-----------------------------------------------------------------------------
+
+static void allocateTrackedBlock( void* pBlock )
+{
+    MEMORY_TAG_SCOPE( PlatformMemoryThreadTests );
+    *(void**)pBlock = dMalloc_r( PLATFORM_UNITTEST_MEMORY_BUFFERSIZE, __FILE__, __LINE__ );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, TrackingThreadTest )
+{
+    // Run more threads than the tracker has counter slots, one after another.
+    void* blocks[PLATFORM_UNITTEST_MEMORY_THREADS];
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_THREADS; ++index )
+    {
+        Thread thread( allocateTrackedBlock, &blocks[index] );
+        thread.join();
+    }
+
+    // Check.
+    ASSERT_EQ( S64(PLATFORM_UNITTEST_MEMORY_THREADS * PLATFORM_UNITTEST_MEMORY_BUFFERSIZE), Memory::getLiveBytes( "PlatformMemoryThreadTests" ) ) << "Bytes allocated by exited threads are incorrect.";
+
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_THREADS; ++index )
+        dFree( blocks[index] );
+
+    // Check.
+    ASSERT_EQ( 0, Memory::getLiveBytes( "PlatformMemoryThreadTests" ) ) << "Freed bytes of exited threads were not released.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( PlatformMemoryTests, TrackingBenchmarkTest )
+{
+    const bool trackingEnabled = Memory::isTrackingEnabled();
+
+    U32 untrackedTime = 0;
+    U32 trackedTime = 0;
+    S64 allocationCount = 0;
+
+    // Alternate so that cache and allocator warm up affects both equally.
+    for ( U32 load = 0; load < PLATFORM_UNITTEST_MEMORY_SCENELOADS; ++load )
+    {
+        Memory::setTrackingEnabled( false );
+        untrackedTime += loadTestScene();
+
+        Memory::setTrackingEnabled( true );
+        const S64 startAllocations = Memory::getLiveAllocations();
+        trackedTime += loadTestScene();
+        allocationCount = Memory::getLiveAllocations() - startAllocations;
+    }
+
+    Memory::setTrackingEnabled( trackingEnabled );
+
+    RecordProperty( "UntrackedLoadMilliseconds", (S32)(untrackedTime / PLATFORM_UNITTEST_MEMORY_SCENELOADS) );
+    RecordProperty( "TrackedLoadMilliseconds", (S32)(trackedTime / PLATFORM_UNITTEST_MEMORY_SCENELOADS) );
+    RecordProperty( "LiveAllocationsAfterLoad", (S32)allocationCount );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_TRACK_MEMORY
+
+#ifdef TORQUE_POOLED_ALLOCATOR
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, PoolTest )
+{
+    // Allocate one block of each size up to the largest pooled size.
+    void* blocks[257];
+    for ( U32 size = 1; size <= 256; ++size )
+    {
+        blocks[size] = dMalloc_r( size, __FILE__, __LINE__ );
+        ASSERT_NE( (void*)0, blocks[size] ) << "Memory not allocated.";
+        ASSERT_EQ( (U32)0, U32(size_t(blocks[size]) & 15) ) << "Pooled memory is not aligned.";
+        dMemset( blocks[size], size, size );
+    }
+
+    // Check nothing overlaps.
+    for ( U32 size = 1; size <= 256; ++size )
+    {
+        for ( U32 index = 0; index < size; ++index )
+            ASSERT_EQ( (U8)size, ((U8*)blocks[size])[index] ) << "Pooled blocks overlap.";
+    }
+
+    // Grow a block out of the pools and back into them.
+    U8* pBlock = (U8*)blocks[64];
+    pBlock = (U8*)dRealloc_r( pBlock, PLATFORM_UNITTEST_MEMORY_BUFFERSIZE, __FILE__, __LINE__ );
+    ASSERT_FALSE( MemoryPool::isPooled( pBlock ) ) << "Large block was pooled.";
+    pBlock = (U8*)dRealloc_r( pBlock, 32, __FILE__, __LINE__ );
+    for ( U32 index = 0; index < 32; ++index )
+        ASSERT_EQ( 64, pBlock[index] ) << "Reallocated memory value is incorrect.";
+    blocks[64] = pBlock;
+
+    // Grow a small system block into the pools.
+    MemoryPool::setEnabled( false );
+    U8* pSystemBlock = (U8*)dMalloc_r( 8, __FILE__, __LINE__ );
+    MemoryPool::setEnabled( true );
+    dMemset( pSystemBlock, 8, 8 );
+    pSystemBlock = (U8*)dRealloc_r( pSystemBlock, 200, __FILE__, __LINE__ );
+    ASSERT_NE( (U8*)0, pSystemBlock ) << "Memory not reallocated.";
+    for ( U32 index = 0; index < 8; ++index )
+        ASSERT_EQ( 8, pSystemBlock[index] ) << "Reallocated memory value is incorrect.";
+    dFree( pSystemBlock );
+
+    for ( U32 size = 1; size <= 256; ++size )
+        dFree( blocks[size] );
+
+    MemoryPool::Stats stats[MemoryPool::MaxClassCount];
+    MemoryPool::getStats( stats );
+
+    U32 allocationCount = 0;
+    for ( U32 sizeClass = 0; sizeClass < MemoryPool::getClassCount(); ++sizeClass )
+        allocationCount += stats[sizeClass].allocs;
+
+    // Check.
+    ASSERT_GT( allocationCount, (U32)0 ) << "No allocations came from the pools.";
+}
+
+//-----------------------------------------------------------------------------
+
+static void allocatePooledBlocks( void* )
+{
+    void* blocks[PLATFORM_UNITTEST_MEMORY_THREADBLOCKS];
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_THREADBLOCKS; ++index )
+        blocks[index] = dMalloc_r( 32, __FILE__, __LINE__ );
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_THREADBLOCKS; ++index )
+        dFree( blocks[index] );
+}
+
+//-----------------------------------------------------------------------------
+
+static void getPooledCounts( U32& allocs, U32& frees )
+{
+    MemoryPool::Stats stats[MemoryPool::MaxClassCount];
+    MemoryPool::getStats( stats );
+
+    allocs = 0;
+    frees = 0;
+    for ( U32 sizeClass = 0; sizeClass < MemoryPool::getClassCount(); ++sizeClass )
+    {
+        allocs += stats[sizeClass].allocs;
+        frees += stats[sizeClass].frees;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, PoolThreadTest )
+{
+    U32 startAllocs, startFrees;
+    getPooledCounts( startAllocs, startFrees );
+
+    // Run more threads than the pools have thread caches, one after another.
+    for ( U32 index = 0; index < PLATFORM_UNITTEST_MEMORY_THREADS; ++index )
+    {
+        Thread thread( allocatePooledBlocks );
+        thread.join();
+    }
+
+    U32 allocs, frees;
+    getPooledCounts( allocs, frees );
+
+    // Check.
+    ASSERT_GE( allocs - startAllocs, (U32)(PLATFORM_UNITTEST_MEMORY_THREADS * PLATFORM_UNITTEST_MEMORY_THREADBLOCKS) ) << "Exited threads lost their pool allocations.";
+    ASSERT_GE( frees - startFrees, (U32)(PLATFORM_UNITTEST_MEMORY_THREADS * PLATFORM_UNITTEST_MEMORY_THREADBLOCKS) ) << "Exited threads lost their pool frees.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static U32 runTestScript( void )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    Con::evaluate( "for ( %i = 0; %i < 5000; %i++ ) { %object = new ScriptObject(); %object.name = \"Object\" @ %i; %object.value = %i * 2; %object.delete(); }" );
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformMemoryTests, PoolBenchmarkTest )
+{
+    const bool poolEnabled = MemoryPool::isEnabled();
+
+    U32 systemSceneTime = 0;
+    U32 pooledSceneTime = 0;
+    U32 systemScriptTime = 0;
+    U32 pooledScriptTime = 0;
+
+    // Alternate so that cache and allocator warm up affects both equally.
+    for ( U32 load = 0; load < PLATFORM_UNITTEST_MEMORY_SCENELOADS; ++load )
+    {
+        MemoryPool::setEnabled( false );
+        systemSceneTime += loadTestScene();
+
+        MemoryPool::setEnabled( true );
+        pooledSceneTime += loadTestScene();
+    }
+
+    for ( U32 loop = 0; loop < PLATFORM_UNITTEST_MEMORY_SCRIPTLOOPS; ++loop )
+    {
+        MemoryPool::setEnabled( false );
+        systemScriptTime += runTestScript();
+
+        MemoryPool::setEnabled( true );
+        pooledScriptTime += runTestScript();
+    }
+
+    MemoryPool::setEnabled( poolEnabled );
+
+    RecordProperty( "SystemSceneMilliseconds", (S32)(systemSceneTime / PLATFORM_UNITTEST_MEMORY_SCENELOADS) );
+    RecordProperty( "PooledSceneMilliseconds", (S32)(pooledSceneTime / PLATFORM_UNITTEST_MEMORY_SCENELOADS) );
+    RecordProperty( "SystemScriptMilliseconds", (S32)(systemScriptTime / PLATFORM_UNITTEST_MEMORY_SCRIPTLOOPS) );
+    RecordProperty( "PooledScriptMilliseconds", (S32)(pooledScriptTime / PLATFORM_UNITTEST_MEMORY_SCRIPTLOOPS) );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_POOLED_ALLOCATOR
+
 
 #endif // TORQUE_SHIPPING
\ No newline at end of file
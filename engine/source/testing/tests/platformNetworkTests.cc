@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _PLATFORM_NETWORK_H_
+#include "platform/platformNetwork.h"
+#endif
+
+#ifndef _EVENT_H_
+#include "platform/event.h"
+#endif
+
+#ifndef _MMATHFN_H_
+#include "math/mMathFn.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define PLATFORMNETWORK_UNITTEST_ADDRESS            "IP:127.0.0.1:28999"
+#define PLATFORMNETWORK_UNITTEST_PACKET_COUNT       16
+#define PLATFORMNETWORK_UNITTEST_BENCHMARK_COUNT    100000
+#define PLATFORMNETWORK_UNITTEST_BENCHMARK_SIZE     200
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformNetworkTests, BatchedSendTest )
+{
+    NetAddress address;
+    const bool batched = Net::getBatchedSends();
+
+    // Check.
+    ASSERT_TRUE( Net::stringToAddress( PLATFORMNETWORK_UNITTEST_ADDRESS, &address ) ) << "Test address could not be resolved.";
+
+    U8 buffer[MaxPacketDataSize];
+    dMemset( buffer, 0xAB, sizeof(buffer) );
+
+    // Packets are sent immediately by default.
+    Net::setBatchedSends( false );
+    Net::sendto( &address, buffer, 64 );
+
+    // Check.
+    ASSERT_EQ( (U32)0, Net::getQueuedPacketCount() ) << "Packet was queued with batched sends disabled.";
+
+    // Packets are queued until flushed.
+    Net::setBatchedSends( true );
+    for ( U32 index = 0; index < PLATFORMNETWORK_UNITTEST_PACKET_COUNT; ++index )
+    {
+        ASSERT_EQ( Net::NoError, Net::sendto( &address, buffer, 64 + index ) ) << "Packet was not queued.";
+    }
+
+    // Check.
+    ASSERT_EQ( (U32)PLATFORMNETWORK_UNITTEST_PACKET_COUNT, Net::getQueuedPacketCount() ) << "Incorrect number of packets queued.";
+
+    Net::flush();
+
+    // Check.
+    ASSERT_EQ( (U32)0, Net::getQueuedPacketCount() ) << "Flush did not send the queued packets.";
+
+    // A full queue is sent by the next send rather than dropping packets.
+    U32 sendCount = 0;
+    while ( Net::getQueuedPacketCount() == sendCount )
+    {
+        Net::sendto( &address, buffer, sizeof(buffer) );
+        sendCount++;
+    }
+
+    // Check.
+    ASSERT_EQ( (U32)1, Net::getQueuedPacketCount() ) << "Full queue was not flushed by the next send.";
+
+    // Disabling batched sends sends whatever is still queued.
+    Net::setBatchedSends( false );
+
+    // Check.
+    ASSERT_EQ( (U32)0, Net::getQueuedPacketCount() ) << "Queued packets remain after disabling batched sends.";
+
+    Net::setBatchedSends( batched );
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static U32 runPlatformNetworkSends( const NetAddress& address, const bool batched )
+{
+    U8 buffer[PLATFORMNETWORK_UNITTEST_BENCHMARK_SIZE];
+    dMemset( buffer, 0xAB, sizeof(buffer) );
+
+    Net::setBatchedSends( batched );
+
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < PLATFORMNETWORK_UNITTEST_BENCHMARK_COUNT; ++index )
+        Net::sendto( &address, buffer, sizeof(buffer) );
+    Net::flush();
+
+    return getMax( Platform::getRealMilliseconds() - startTime, (U32)1 );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( PlatformNetworkTests, LoopbackBenchmarkTest )
+{
+    NetAddress address;
+    const bool batched = Net::getBatchedSends();
+
+    // Check.
+    ASSERT_TRUE( Net::stringToAddress( PLATFORMNETWORK_UNITTEST_ADDRESS, &address ) ) << "Test address could not be resolved.";
+
+    const U32 immediateTime = runPlatformNetworkSends( address, false );
+    const U32 batchedTime = runPlatformNetworkSends( address, true );
+
+    RecordProperty( "ImmediatePacketsPerSecond", (S32)(PLATFORMNETWORK_UNITTEST_BENCHMARK_COUNT * 1000.0 / immediateTime) );
+    RecordProperty( "BatchedPacketsPerSecond", (S32)(PLATFORMNETWORK_UNITTEST_BENCHMARK_COUNT * 1000.0 / batchedTime) );
+
+    Net::setBatchedSends( batched );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,206 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _STRINGUNIT_H_
+#include "string/stringUnit.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENECONTACT_UNITTEST_SCENE                 "SceneContactTestScene"
+#define SCENECONTACT_UNITTEST_OBJECTS               100
+#define SCENECONTACT_UNITTEST_TICKS                 120
+#define SCENECONTACT_UNITTEST_BENCHMARK_OBJECTS     2000
+
+//-----------------------------------------------------------------------------
+
+class SceneContactTestListener : public SceneContactListener
+{
+public:
+    SceneContactTestListener() : mBeginContacts( 0 ), mEndContacts( 0 ), mInvalidContacts( 0 ) {}
+
+    virtual void onSceneContacts( Scene* pScene, const Vector<BatchedContact>& beginContacts, const Vector<BatchedContact>& endContacts )
+    {
+        mBeginContacts += beginContacts.size();
+        mEndContacts += endContacts.size();
+
+        for ( S32 index = 0; index < beginContacts.size(); ++index )
+        {
+            const BatchedContact& contact = beginContacts[index];
+            if ( contact.mpSceneObjectA->getId() != contact.mSceneObjectIdA || contact.mpSceneObjectB->getId() != contact.mSceneObjectIdB ||
+                 contact.mpSceneObjectA->getScene() != pScene || contact.mpSceneObjectB->getScene() != pScene ||
+                 contact.mPointCount > b2_maxManifoldPoints )
+                mInvalidContacts++;
+        }
+    }
+
+    U32 mBeginContacts;
+    U32 mEndContacts;
+    U32 mInvalidContacts;
+};
+
+//-----------------------------------------------------------------------------
+
+static Scene* createContactScene( const U32 objectCount, const bool batch, const bool callbacks )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject( SCENECONTACT_UNITTEST_SCENE );
+    pScene->setGravity( b2Vec2( 0.0f, -10.0f ) );
+    pScene->setBatchCollisionCallbacks( batch );
+
+    // A static floor with boxes dropping onto it.
+    SceneObject* pGround = new SceneObject();
+    pGround->setBodyType( b2_staticBody );
+    pGround->createPolygonBoxCollisionShape( 500.0f, 1.0f );
+    pGround->setCollisionCallback( callbacks );
+    pGround->registerObject();
+    pScene->addToScene( pGround );
+
+    for ( U32 index = 0; index < objectCount; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->setBodyType( b2_dynamicBody );
+        pSceneObject->setPosition( Vector2( (F32)(index % 100) * 2.0f - 100.0f, 2.0f + (F32)(index / 100) * 1.5f ) );
+        pSceneObject->createPolygonBoxCollisionShape( 1.0f, 1.0f );
+        pSceneObject->setCollisionCallback( callbacks );
+        pSceneObject->registerObject();
+        pScene->addToScene( pSceneObject );
+    }
+
+    return pScene;
+}
+
+//-----------------------------------------------------------------------------
+
+static void defineContactCallbacks( void )
+{
+    Con::evaluate( "function " SCENECONTACT_UNITTEST_SCENE "::onSceneCollision( %this, %objectA, %objectB, %info ) { $SceneContactTest::Contacts++; }" );
+    Con::evaluate( "function " SCENECONTACT_UNITTEST_SCENE "::onSceneCollisions( %this, %beginCount, %endCount ) { "
+                   "for ( %i = 0; %i < %beginCount; %i++ ) $SceneContactTest::LastContact = %this.getBeginContact( %i ); "
+                   "$SceneContactTest::Contacts += %beginCount; $SceneContactTest::EndContacts += %endCount; }" );
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 tickContactScene( Scene* pScene, const U32 ticks )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 tick = 0; tick < ticks; ++tick )
+        pScene->processTick();
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneContactTests, BatchedDispatchTest )
+{
+    defineContactCallbacks();
+
+    // Per-contact dispatch.
+    Con::setIntVariable( "$SceneContactTest::Contacts", 0 );
+    Scene* pScene = createContactScene( SCENECONTACT_UNITTEST_OBJECTS, false, true );
+    tickContactScene( pScene, SCENECONTACT_UNITTEST_TICKS );
+    pScene->deleteObject();
+    const S32 unbatchedContacts = Con::getIntVariable( "$SceneContactTest::Contacts" );
+
+    // Check.
+    ASSERT_GT( unbatchedContacts, 0 ) << "No contacts were dispatched.";
+
+    // Batched dispatch of the same simulation.
+    Con::setIntVariable( "$SceneContactTest::Contacts", 0 );
+    Con::setIntVariable( "$SceneContactTest::EndContacts", 0 );
+    Con::setVariable( "$SceneContactTest::LastContact", "" );
+    SceneContactTestListener listener;
+    pScene = createContactScene( SCENECONTACT_UNITTEST_OBJECTS, true, true );
+    pScene->addContactListener( &listener );
+    tickContactScene( pScene, SCENECONTACT_UNITTEST_TICKS );
+    pScene->removeContactListener( &listener );
+    pScene->deleteObject();
+
+    // Check.
+    ASSERT_EQ( unbatchedContacts, Con::getIntVariable( "$SceneContactTest::Contacts" ) ) << "Batched dispatch reported a different number of contacts.";
+    ASSERT_EQ( (U32)unbatchedContacts, listener.mBeginContacts ) << "Contact listener saw a different number of contacts.";
+    ASSERT_EQ( listener.mEndContacts, (U32)Con::getIntVariable( "$SceneContactTest::EndContacts" ) ) << "Contact listener saw a different number of end contacts.";
+    ASSERT_EQ( 0U, listener.mInvalidContacts ) << "Contact listener saw invalid contacts.";
+
+    // Check the formatted contact.
+    const char* pLastContact = Con::getVariable( "$SceneContactTest::LastContact" );
+    ASSERT_GE( StringUnit::getUnitCount( pLastContact, " " ), 6U ) << "Formatted contact is incomplete.";
+    ASSERT_NE( (SimObject*)NULL, Sim::findObject( dAtoi( StringUnit::getUnit( pLastContact, 0, " " ) ) ) ) << "Formatted contact object is incorrect.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( SceneContactTests, BenchmarkTest )
+{
+    defineContactCallbacks();
+
+    // The same simulation without any callbacks gives the cost of the physics alone.
+    Scene* pScene = createContactScene( SCENECONTACT_UNITTEST_BENCHMARK_OBJECTS, false, false );
+    const U32 physicsTime = tickContactScene( pScene, SCENECONTACT_UNITTEST_TICKS );
+    pScene->deleteObject();
+
+    Con::setIntVariable( "$SceneContactTest::Contacts", 0 );
+    pScene = createContactScene( SCENECONTACT_UNITTEST_BENCHMARK_OBJECTS, false, true );
+    const U32 unbatchedTime = tickContactScene( pScene, SCENECONTACT_UNITTEST_TICKS );
+    pScene->deleteObject();
+    const S32 unbatchedContacts = Con::getIntVariable( "$SceneContactTest::Contacts" );
+
+    Con::setIntVariable( "$SceneContactTest::Contacts", 0 );
+    pScene = createContactScene( SCENECONTACT_UNITTEST_BENCHMARK_OBJECTS, true, true );
+    const U32 batchedTime = tickContactScene( pScene, SCENECONTACT_UNITTEST_TICKS );
+    pScene->deleteObject();
+    const S32 batchedContacts = Con::getIntVariable( "$SceneContactTest::Contacts" );
+
+    // Check.
+    ASSERT_EQ( unbatchedContacts, batchedContacts ) << "Batched dispatch reported a different number of contacts.";
+
+    RecordProperty( "Contacts", unbatchedContacts );
+    RecordProperty( "PerContactContactsPerSecond", (S32)( unbatchedContacts * 1000.0 / getMax( (S32)unbatchedTime - (S32)physicsTime, 1 ) ) );
+    RecordProperty( "BatchedContactsPerSecond", (S32)( batchedContacts * 1000.0 / getMax( (S32)batchedTime - (S32)physicsTime, 1 ) ) );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
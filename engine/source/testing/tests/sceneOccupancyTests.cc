@@ -0,0 +1,330 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SPRITE_H_
+#include "2d/sceneobject/Sprite.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENEOCCUPANCY_UNITTEST_OBJECTS             1000
+#define SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS   100000
+#define SCENEOCCUPANCY_UNITTEST_LAYER_QUERIES       100
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneOccupancyTests, MembershipTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create the objects.
+    typeSceneObjectVector objects;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+    {
+        Sprite* pSprite = new Sprite();
+        pSprite->registerObject();
+        objects.push_back( pSprite );
+    }
+
+    // Add them all at once.
+    pScene->addToScene( objects );
+    ASSERT_EQ( SCENEOCCUPANCY_UNITTEST_OBJECTS, pScene->getSceneObjectCount() ) << "Bulk add did not add all the objects.";
+
+    // Adding them again should be ignored.
+    pScene->addToScene( objects );
+    ASSERT_EQ( SCENEOCCUPANCY_UNITTEST_OBJECTS, pScene->getSceneObjectCount() ) << "Bulk add added objects twice.";
+
+    // Remove some individually and some in bulk.
+    typeSceneObjectVector removeObjects;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+    {
+        if ( index % 3 == 0 )
+            pScene->removeFromScene( objects[index] );
+        else if ( index % 3 == 1 )
+            removeObjects.push_back( objects[index] );
+    }
+    pScene->removeFromScene( removeObjects );
+
+    // Check the membership.
+    U32 expectedCount = 0;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+    {
+        if ( index % 3 == 2 )
+        {
+            ASSERT_EQ( pScene, objects[index]->getScene() ) << "Object was removed from the scene.";
+            expectedCount++;
+        }
+        else
+        {
+            ASSERT_TRUE( objects[index]->getScene() == NULL ) << "Object was not removed from the scene.";
+        }
+    }
+    ASSERT_EQ( expectedCount, pScene->getSceneObjectCount() ) << "Scene object count is wrong.";
+
+    // Removing through another scene must leave the object where it is.
+    Scene* pOtherScene = new Scene();
+    pOtherScene->registerObject();
+    SceneObject* pRemainingObject = pScene->getSceneObject( 0 );
+    pOtherScene->removeFromScene( pRemainingObject );
+    ASSERT_EQ( pScene, pRemainingObject->getScene() ) << "Object was removed through another scene.";
+    ASSERT_EQ( expectedCount, pScene->getSceneObjectCount() ) << "Removing through another scene changed the count.";
+    pOtherScene->deleteObject();
+
+    // Every remaining object should be found at its slot.
+    for ( U32 index = 0; index < pScene->getSceneObjectCount(); ++index )
+    {
+        SceneObject* pSceneObject = pScene->getSceneObject( index );
+        pScene->removeFromScene( pSceneObject );
+        pScene->addToScene( pSceneObject );
+        ASSERT_EQ( pScene, pSceneObject->getScene() ) << "Object was not re-added to the scene.";
+    }
+    ASSERT_EQ( expectedCount, pScene->getSceneObjectCount() ) << "Scene object count changed when re-adding.";
+
+    // Clear the scene and delete everything.
+    pScene->clearScene( false );
+    ASSERT_EQ( 0, pScene->getSceneObjectCount() ) << "Scene was not cleared.";
+    pScene->deleteObject();
+
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+        objects[index]->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( SceneOccupancyTests, BenchmarkTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create the sprites.
+    typeSceneObjectVector objects;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS; ++index )
+    {
+        Sprite* pSprite = new Sprite();
+        pSprite->registerObject();
+        pSprite->setPosition( Vector2( F32(index % 1000), F32(index / 1000) ) );
+        objects.push_back( pSprite );
+    }
+
+    // Time adding them individually.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS; ++index )
+        pScene->addToScene( objects[index] );
+    const U32 addTime = Platform::getRealMilliseconds() - startTime;
+
+    // Time clearing them.
+    startTime = Platform::getRealMilliseconds();
+    pScene->clearScene( false );
+    const U32 clearTime = Platform::getRealMilliseconds() - startTime;
+
+    // Time adding them in bulk.
+    startTime = Platform::getRealMilliseconds();
+    pScene->addToScene( objects );
+    const U32 bulkAddTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS, pScene->getSceneObjectCount() ) << "Bulk add did not add all the objects.";
+
+    // Time removing them in bulk.
+    startTime = Platform::getRealMilliseconds();
+    pScene->removeFromScene( objects );
+    const U32 bulkRemoveTime = Platform::getRealMilliseconds() - startTime;
+    ASSERT_EQ( 0, pScene->getSceneObjectCount() ) << "Bulk remove did not remove all the objects.";
+
+    RecordProperty( "AddMilliseconds", (S32)addTime );
+    RecordProperty( "ClearMilliseconds", (S32)clearTime );
+    RecordProperty( "BulkAddMilliseconds", (S32)bulkAddTime );
+    RecordProperty( "BulkRemoveMilliseconds", (S32)bulkRemoveTime );
+
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS; ++index )
+        objects[index]->deleteObject();
+
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+//-----------------------------------------------------------------------------
+
+static void checkLayerIndexes( Scene* pScene )
+{
+    typeSceneObjectVectorConstRef sceneObjects = pScene->getSceneObjects();
+
+    for ( U32 layer = 0; layer < MAX_LAYERS_SUPPORTED; ++layer )
+    {
+        // Count the layer the slow way.
+        U32 layerCount = 0;
+        for ( S32 index = 0; index < sceneObjects.size(); ++index )
+        {
+            if ( sceneObjects[index]->getSceneLayer() == layer )
+                layerCount++;
+        }
+
+        typeSceneObjectVectorConstRef layerObjects = pScene->getLayerSceneObjects( layer );
+        ASSERT_EQ( layerCount, (U32)layerObjects.size() ) << "Layer object count is wrong.";
+        for ( S32 index = 0; index < layerObjects.size(); ++index )
+        {
+            ASSERT_EQ( layer, layerObjects[index]->getSceneLayer() ) << "Object is indexed in the wrong layer.";
+        }
+    }
+
+    for ( U32 group = 0; group < MAX_GROUPS_SUPPORTED; ++group )
+    {
+        // Count the group the slow way.
+        U32 groupCount = 0;
+        for ( S32 index = 0; index < sceneObjects.size(); ++index )
+        {
+            if ( sceneObjects[index]->getSceneGroup() == group )
+                groupCount++;
+        }
+
+        typeSceneObjectVectorConstRef groupObjects = pScene->getGroupSceneObjects( group );
+        ASSERT_EQ( groupCount, (U32)groupObjects.size() ) << "Group object count is wrong.";
+        for ( S32 index = 0; index < groupObjects.size(); ++index )
+        {
+            ASSERT_EQ( group, groupObjects[index]->getSceneGroup() ) << "Object is indexed in the wrong group.";
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneOccupancyTests, LayerIndexTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create objects with layers and groups set before and after adding to the scene.
+    typeSceneObjectVector objects;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+    {
+        Sprite* pSprite = new Sprite();
+        pSprite->registerObject();
+        pSprite->setSceneLayer( index % MAX_LAYERS_SUPPORTED );
+        pScene->addToScene( pSprite );
+        pSprite->setSceneGroup( index % 7 );
+        objects.push_back( pSprite );
+    }
+    checkLayerIndexes( pScene );
+
+    // Move objects between layers and groups.
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; index += 3 )
+    {
+        objects[index]->setSceneLayer( (index * 13) % MAX_LAYERS_SUPPORTED );
+        objects[index]->setSceneGroup( (index * 5) % MAX_GROUPS_SUPPORTED );
+    }
+    checkLayerIndexes( pScene );
+
+    // Remove some objects.
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; index += 4 )
+        pScene->removeFromScene( objects[index] );
+    checkLayerIndexes( pScene );
+
+    // Changing layers outside a scene should be picked up when re-added.
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; index += 4 )
+    {
+        objects[index]->setSceneLayer( 31 );
+        objects[index]->setSceneGroup( 31 );
+        pScene->addToScene( objects[index] );
+    }
+    checkLayerIndexes( pScene );
+
+    pScene->clearScene( false );
+    checkLayerIndexes( pScene );
+    pScene->deleteObject();
+
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_OBJECTS; ++index )
+        objects[index]->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( SceneOccupancyTests, LayerBenchmarkTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create the sprites spread over all the layers.
+    typeSceneObjectVector objects;
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS; ++index )
+    {
+        Sprite* pSprite = new Sprite();
+        pSprite->registerObject();
+        pSprite->setSceneLayer( index % MAX_LAYERS_SUPPORTED );
+        objects.push_back( pSprite );
+    }
+    pScene->addToScene( objects );
+
+    // Time enumerating a single layer repeatedly.
+    typeSceneObjectVector layerObjects;
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 query = 0; query < SCENEOCCUPANCY_UNITTEST_LAYER_QUERIES; ++query )
+    {
+        layerObjects.clear();
+        pScene->getSceneObjects( layerObjects, query % MAX_LAYERS_SUPPORTED );
+    }
+    const U32 indexedTime = Platform::getRealMilliseconds() - startTime;
+
+    // Time filtering the whole scene for comparison.
+    typeSceneObjectVectorConstRef sceneObjects = pScene->getSceneObjects();
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 query = 0; query < SCENEOCCUPANCY_UNITTEST_LAYER_QUERIES; ++query )
+    {
+        layerObjects.clear();
+        const U32 sceneLayer = query % MAX_LAYERS_SUPPORTED;
+        for ( S32 index = 0; index < sceneObjects.size(); ++index )
+        {
+            if ( sceneObjects[index]->getSceneLayer() == sceneLayer )
+                layerObjects.push_back( sceneObjects[index] );
+        }
+    }
+    const U32 scanTime = Platform::getRealMilliseconds() - startTime;
+
+    ASSERT_EQ( SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS / MAX_LAYERS_SUPPORTED, layerObjects.size() ) << "Unexpected layer object count.";
+
+    RecordProperty( "IndexedQueryMilliseconds", (S32)indexedTime );
+    RecordProperty( "ScannedQueryMilliseconds", (S32)scanTime );
+
+    pScene->clearScene( false );
+    pScene->deleteObject();
+
+    for ( U32 index = 0; index < SCENEOCCUPANCY_UNITTEST_BENCHMARK_OBJECTS; ++index )
+        objects[index]->deleteObject();
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
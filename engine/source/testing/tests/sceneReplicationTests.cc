@@ -0,0 +1,320 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _NETCONNECTION_H_
+#include "network/netConnection.h"
+#endif
+
+#ifndef _BITSTREAM_H_
+#include "io/bitStream.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+#ifndef _SCENE_OBJECT_GHOST_H_
+#include "2d/sceneobject/SceneObjectGhost.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENEREPLICATION_UNITTEST_OBJECTS         200
+#define SCENEREPLICATION_UNITTEST_BENCHMARK_OBJECTS   1000
+#define SCENEREPLICATION_UNITTEST_TICKS           64
+#define SCENEREPLICATION_UNITTEST_PACKET_SIZE     1200
+#define SCENEREPLICATION_UNITTEST_DROP_PERIOD     10
+
+//-----------------------------------------------------------------------------
+
+class ReplicationClientConnection : public NetConnection
+{
+public:
+    ReplicationClientConnection()
+    {
+        setGhostTo( true );
+    }
+
+    virtual ~ReplicationClientConnection()
+    {
+        for ( S32 index = 0; index < MaxGhostCount; ++index )
+        {
+            if ( mLocalGhosts[index] != NULL )
+                mLocalGhosts[index]->deleteObject();
+        }
+    }
+
+    void readGhostPacket( BitStream* pStream ) { ghostReadPacket( pStream ); }
+};
+
+//-----------------------------------------------------------------------------
+
+class ReplicationServerConnection : public NetConnection
+{
+public:
+    ReplicationServerConnection()
+    {
+        setGhostFrom( true );
+
+        // Normally done when ghosting is activated.
+        for ( S32 index = 0; index < MaxGhostCount; ++index )
+        {
+            mGhostArray[index] = mGhostRefs + index;
+            mGhostArray[index]->arrayIndex = index;
+        }
+
+        mScoping = true;
+        mGhosting = true;
+    }
+
+    virtual ~ReplicationServerConnection()
+    {
+        clearGhostInfo();
+    }
+
+    void scopeAlways( NetObject* pObject ) { objectLocalScopeAlways( pObject ); }
+
+    U32 getDirtyGhostCount( void ) const { return mGhostZeroUpdateIndex; }
+
+    /// A ghost packet that has been written but not delivered yet.
+    struct GhostPacket
+    {
+        U8              mBuffer[MaxPacketDataSize];
+        U32             mSize;
+        PacketNotify*   mpNotify;
+    };
+
+    void writeGhostPacket( GhostPacket& packet )
+    {
+        BitStream stream( packet.mBuffer, SCENEREPLICATION_UNITTEST_PACKET_SIZE, sizeof(packet.mBuffer) );
+
+        packet.mpNotify = allocNotify();
+        ghostWritePacket( &stream, packet.mpNotify );
+        packet.mSize = stream.getPosition();
+    }
+
+    /// Deliver a written ghost packet to the client unless it's dropped.
+    void deliverGhostPacket( ReplicationClientConnection* pClient, GhostPacket& packet, const bool drop )
+    {
+        if ( drop )
+        {
+            ghostPacketDropped( packet.mpNotify );
+        }
+        else
+        {
+            BitStream readStream( packet.mBuffer, packet.mSize );
+            pClient->readGhostPacket( &readStream );
+            ghostPacketReceived( packet.mpNotify );
+        }
+
+        delete packet.mpNotify;
+        packet.mpNotify = NULL;
+    }
+
+    /// Write a ghost packet and deliver it to the client unless it's dropped, returning the packet size.
+    U32 sendGhostPacket( ReplicationClientConnection* pClient, const bool drop )
+    {
+        GhostPacket packet;
+        writeGhostPacket( packet );
+        deliverGhostPacket( pClient, packet, drop );
+        return packet.mSize;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+static SceneObjectGhost* getClientGhost( ReplicationServerConnection* pServer, ReplicationClientConnection* pClient, SceneObject* pSceneObject )
+{
+    return dynamic_cast<SceneObjectGhost*>( pClient->resolveGhost( pServer->getGhostIndex( pSceneObject->getReplicationGhost() ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Replicates moving objects with every tenth packet dropped and checks the client converges.
+/// @return The number of bytes sent after the objects were ghosted.
+static U32 runLoopback( const U32 objectCount )
+{
+    // Create the scenes.
+    Scene* pServerScene = new Scene();
+    Scene* pClientScene = new Scene();
+    pServerScene->registerObject();
+    pClientScene->registerObject();
+    pServerScene->setGravity( b2Vec2( 0.0f, 0.0f ) );
+    SceneObjectGhost::setClientScene( pClientScene );
+
+    ReplicationServerConnection* pServer = new ReplicationServerConnection();
+    ReplicationClientConnection* pClient = new ReplicationClientConnection();
+
+    // Create the moving objects.
+    Vector<SceneObject*> objects;
+    for ( U32 index = 0; index < objectCount; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->registerObject();
+        pServerScene->addToScene( pSceneObject );
+
+        pSceneObject->setPosition( Vector2( F32(index % 40), F32(index / 40) ) );
+        pSceneObject->setLinearVelocity( Vector2( F32( (S32)(index * 37 % 21) - 10 ) * 0.5f, F32( (S32)(index * 11 % 13) - 6 ) ) );
+        pSceneObject->setAngularVelocity( F32( (S32)(index % 7) - 3 ) );
+        pSceneObject->setReplicated( true );
+
+        pServer->scopeAlways( pSceneObject->getReplicationGhost() );
+        objects.push_back( pSceneObject );
+    }
+
+    // Ghost everything.
+    U32 packetCount = 0;
+    while ( pServer->getDirtyGhostCount() > 0 )
+        pServer->sendGhostPacket( pClient, false );
+
+    // Tick and send everything that changed, dropping some packets.
+    U32 totalBytes = 0;
+    for ( U32 tick = 0; tick < SCENEREPLICATION_UNITTEST_TICKS; ++tick )
+    {
+        pServerScene->processTick();
+        NetObject::collapseDirtyList();
+
+        while ( pServer->getDirtyGhostCount() > 0 )
+            totalBytes += pServer->sendGhostPacket( pClient, ++packetCount % SCENEREPLICATION_UNITTEST_DROP_PERIOD == 0 );
+    }
+
+    // Check that the client matches the server.
+    const F32 tolerance = 1.0f / SceneObjectGhost::PositionScale;
+    bool matched = true;
+    for ( U32 index = 0; index < objectCount && matched; ++index )
+    {
+        SceneObject* pSceneObject = objects[index];
+
+        SceneObjectGhost* pGhost = getClientGhost( pServer, pClient, pSceneObject );
+        EXPECT_TRUE( pGhost != NULL && pGhost->getSceneObject() != NULL ) << "Object was not ghosted.";
+        if ( pGhost == NULL || pGhost->getSceneObject() == NULL )
+        {
+            matched = false;
+            continue;
+        }
+
+        const Vector2 serverPosition = pSceneObject->getPosition();
+        const Vector2 clientPosition = pGhost->getSceneObject()->getPosition();
+        matched = mFabs( serverPosition.x - clientPosition.x ) <= tolerance && mFabs( serverPosition.y - clientPosition.y ) <= tolerance;
+        EXPECT_TRUE( matched ) << "Client position does not match the server.";
+    }
+
+    SceneObjectGhost::setClientScene( NULL );
+
+    delete pServer;
+    delete pClient;
+
+    for ( U32 index = 0; index < objectCount; ++index )
+        objects[index]->deleteObject();
+
+    pServerScene->deleteObject();
+    pClientScene->deleteObject();
+
+    return totalBytes;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneReplicationTests, LoopbackTest )
+{
+    runLoopback( SCENEREPLICATION_UNITTEST_OBJECTS );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneReplicationTests, InFlightUpdateTest )
+{
+    Scene* pServerScene = new Scene();
+    Scene* pClientScene = new Scene();
+    pServerScene->registerObject();
+    pClientScene->registerObject();
+    SceneObjectGhost::setClientScene( pClientScene );
+
+    ReplicationServerConnection* pServer = new ReplicationServerConnection();
+    ReplicationClientConnection* pClient = new ReplicationClientConnection();
+
+    SceneObject* pSceneObject = new SceneObject();
+    pSceneObject->registerObject();
+    pServerScene->addToScene( pSceneObject );
+    pSceneObject->setReplicated( true );
+    pServer->scopeAlways( pSceneObject->getReplicationGhost() );
+
+    // Ghost it.
+    while ( pServer->getDirtyGhostCount() > 0 )
+        pServer->sendGhostPacket( pClient, false );
+
+    // Hide it and send the update, but don't deliver it yet.
+    ReplicationServerConnection::GhostPacket hidePacket;
+    pSceneObject->setVisible( false );
+    pSceneObject->getReplicationGhost()->updateState();
+    NetObject::collapseDirtyList();
+    pServer->writeGhostPacket( hidePacket );
+
+    // Turn it, which is delta-encoded against the state before it was hidden.
+    ReplicationServerConnection::GhostPacket turnPacket;
+    pSceneObject->setAngle( 1.0f );
+    pSceneObject->getReplicationGhost()->updateState();
+    NetObject::collapseDirtyList();
+    pServer->writeGhostPacket( turnPacket );
+
+    pServer->deliverGhostPacket( pClient, hidePacket, false );
+    pServer->deliverGhostPacket( pClient, turnPacket, false );
+
+    // Check.
+    SceneObjectGhost* pGhost = getClientGhost( pServer, pClient, pSceneObject );
+    ASSERT_TRUE( pGhost != NULL && pGhost->getSceneObject() != NULL ) << "Object was not ghosted.";
+    ASSERT_FALSE( pGhost->getSceneObject()->getVisible() ) << "Change in an unacknowledged update was lost.";
+    ASSERT_NEAR( 1.0f, pGhost->getSceneObject()->getAngle(), 0.01f ) << "Client angle does not match the server.";
+
+    SceneObjectGhost::setClientScene( NULL );
+
+    delete pServer;
+    delete pClient;
+
+    pSceneObject->deleteObject();
+    pServerScene->deleteObject();
+    pClientScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( SceneReplicationTests, BenchmarkTest )
+{
+    const U32 totalBytes = runLoopback( SCENEREPLICATION_UNITTEST_BENCHMARK_OBJECTS );
+    const F32 seconds = SCENEREPLICATION_UNITTEST_TICKS * Tickable::smTickSec;
+
+    RecordProperty( "Objects", SCENEREPLICATION_UNITTEST_BENCHMARK_OBJECTS );
+    RecordProperty( "BytesPerSecondPer1000Objects", (S32)( totalBytes / seconds * 1000.0f / SCENEREPLICATION_UNITTEST_BENCHMARK_OBJECTS ) );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCENE_H_
+#include "2d/scene/Scene.h"
+#endif
+
+#ifndef _SCENE_OBJECT_H_
+#include "2d/sceneobject/SceneObject.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCENETICK_UNITTEST_OBJECTS            1000
+#define SCENETICK_UNITTEST_BENCHMARK_OBJECTS  200000
+#define SCENETICK_UNITTEST_BENCHMARK_ACTIVE   5000
+#define SCENETICK_UNITTEST_BENCHMARK_TICKS    100
+
+//-----------------------------------------------------------------------------
+
+static void checkSceneCounts( Scene* pScene )
+{
+    // Remove any objects pending deletion so the tick doesn't remove them after counting.
+    pScene->processDeleteRequests( true );
+
+    // Count the objects the slow way.
+    U32 enabledCount = 0;
+    U32 visibleCount = 0;
+    U32 awakeCount = 0;
+    U32 activeCount = 0;
+    const typeSceneObjectVector& sceneObjects = pScene->getSceneObjects();
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = sceneObjects[index];
+
+        if ( pSceneObject->isEnabled() )
+            enabledCount++;
+
+        if ( pSceneObject->getVisible() )
+            visibleCount++;
+
+        if ( pSceneObject->getAwake() )
+            awakeCount++;
+
+        if ( pSceneObject->isEnabled() && !pSceneObject->isBeingDeleted() )
+            activeCount++;
+    }
+
+    // Tick to refresh the debug stats.
+    pScene->processTick();
+
+    const DebugStats& debugStats = pScene->getDebugStats();
+    ASSERT_EQ( enabledCount, debugStats.objectsEnabled ) << "Enabled object count is wrong.";
+    ASSERT_EQ( visibleCount, debugStats.objectsVisible ) << "Visible object count is wrong.";
+    ASSERT_EQ( awakeCount, debugStats.objectsAwake ) << "Awake object count is wrong.";
+    ASSERT_EQ( activeCount, (U32)pScene->getActiveSceneObjects().size() ) << "Active object count is wrong.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneTickTests, ActiveObjectTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create the objects.
+    for ( U32 index = 0; index < SCENETICK_UNITTEST_OBJECTS; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->setBodyType( index % 3 == 0 ? b2_staticBody : b2_dynamicBody );
+        pSceneObject->registerObject();
+        pScene->addToScene( pSceneObject );
+    }
+    checkSceneCounts( pScene );
+
+    // Change object states.
+    const typeSceneObjectVector& sceneObjects = pScene->getSceneObjects();
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = sceneObjects[index];
+
+        if ( index % 2 == 0 )
+            pSceneObject->setEnabled( false );
+
+        if ( index % 5 == 0 )
+            pSceneObject->setVisible( false );
+
+        if ( index % 7 == 0 )
+            pSceneObject->setAwake( false );
+    }
+    checkSceneCounts( pScene );
+
+    // Change them back again and set some redundantly.
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = sceneObjects[index];
+
+        if ( index % 4 == 0 )
+            pSceneObject->setEnabled( true );
+
+        pSceneObject->setVisible( index % 3 != 0 );
+    }
+    checkSceneCounts( pScene );
+
+    // Delete some objects.
+    for ( S32 index = 0; index < sceneObjects.size(); index += 11 )
+        sceneObjects[index]->safeDelete();
+
+    // Objects pending deletion should no longer be active.
+    const typeSceneObjectVector& activeObjects = pScene->getActiveSceneObjects();
+    for ( S32 index = 0; index < activeObjects.size(); ++index )
+    {
+        ASSERT_TRUE( activeObjects[index]->isEnabled() ) << "Active object is not enabled.";
+        ASSERT_FALSE( activeObjects[index]->isBeingDeleted() ) << "Active object is being deleted.";
+    }
+    checkSceneCounts( pScene );
+
+    // Removing objects should stop tracking them.
+    pScene->clearScene( true );
+    checkSceneCounts( pScene );
+    ASSERT_EQ( 0, pScene->getActiveSceneObjects().size() ) << "Active objects remain after clearing the scene.";
+
+    pScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( SceneTickTests, TickOrderTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create the objects.
+    for ( U32 index = 0; index < SCENETICK_UNITTEST_OBJECTS; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->registerObject();
+        pScene->addToScene( pSceneObject );
+    }
+
+    // Disable and delete objects from all over the active list.
+    const typeSceneObjectVector& sceneObjects = pScene->getSceneObjects();
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        if ( index % 3 == 0 )
+            sceneObjects[index]->setEnabled( false );
+        else if ( index % 5 == 0 )
+            sceneObjects[index]->safeDelete();
+    }
+    pScene->processTick();
+
+    // The remaining objects must still tick in the order they were added.
+    const typeSceneObjectVector& activeObjects = pScene->getActiveSceneObjects();
+    S32 activeIndex = 0;
+    for ( S32 index = 0; index < sceneObjects.size(); ++index )
+    {
+        SceneObject* pSceneObject = sceneObjects[index];
+        if ( !pSceneObject->isEnabled() || pSceneObject->isBeingDeleted() )
+            continue;
+
+        ASSERT_LT( activeIndex, activeObjects.size() ) << "Active object is missing.";
+        ASSERT_EQ( pSceneObject, activeObjects[activeIndex++] ) << "Active objects are out of order.";
+    }
+    ASSERT_EQ( activeIndex, activeObjects.size() ) << "Active object count is wrong.";
+
+    pScene->clearScene( true );
+    pScene->deleteObject();
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( SceneTickTests, BenchmarkTest )
+{
+    Scene* pScene = new Scene();
+    pScene->registerObject();
+
+    // Create mostly disabled objects.
+    for ( U32 index = 0; index < SCENETICK_UNITTEST_BENCHMARK_OBJECTS; ++index )
+    {
+        SceneObject* pSceneObject = new SceneObject();
+        pSceneObject->registerObject();
+        pScene->addToScene( pSceneObject );
+
+        if ( index % (SCENETICK_UNITTEST_BENCHMARK_OBJECTS / SCENETICK_UNITTEST_BENCHMARK_ACTIVE) != 0 )
+            pSceneObject->setEnabled( false );
+    }
+
+    ASSERT_EQ( SCENETICK_UNITTEST_BENCHMARK_ACTIVE, pScene->getActiveSceneObjects().size() ) << "Unexpected active object count.";
+
+    // Time the ticks.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 tick = 0; tick < SCENETICK_UNITTEST_BENCHMARK_TICKS; ++tick )
+        pScene->processTick();
+    const U32 tickTime = Platform::getRealMilliseconds() - startTime;
+
+    // Time the interpolation.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 tick = 0; tick < SCENETICK_UNITTEST_BENCHMARK_TICKS; ++tick )
+        pScene->interpolateTick( 0.5f );
+    const U32 interpolateTime = Platform::getRealMilliseconds() - startTime;
+
+    RecordProperty( "ProcessTickMicroseconds", (S32)( tickTime * 1000 / SCENETICK_UNITTEST_BENCHMARK_TICKS ) );
+    RecordProperty( "InterpolateTickMicroseconds", (S32)( interpolateTime * 1000 / SCENETICK_UNITTEST_BENCHMARK_TICKS ) );
+
+    pScene->clearScene( true );
+    pScene->deleteObject();
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,325 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _SCRIPT_BUNDLE_H_
+#include "console/scriptBundle.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _RESMANAGER_H_
+#include "io/resource/resourceManager.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define SCRIPTBUNDLE_UNITTEST_SCRIPT                "_unitTestScript_RemoveMe"
+#define SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION     "*/_unitTestScript_RemoveMe*.cs"
+#define SCRIPTBUNDLE_UNITTEST_BUNDLE                "_unitTestBundle_RemoveMe.bundle"
+#define SCRIPTBUNDLE_UNITTEST_OLD_BUNDLE            "_unitTestOldBundle_RemoveMe.bundle"
+#define SCRIPTBUNDLE_UNITTEST_SCRIPTS               4
+#define SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS     200
+#define SCRIPTBUNDLE_UNITTEST_BENCHMARK_FUNCTIONS   20
+
+//-----------------------------------------------------------------------------
+
+static const char* getTestScriptPath( char* pBuffer, const U32 bufferSize, const U32 index )
+{
+    char fileName[64];
+    dSprintf( fileName, sizeof(fileName), "%s%d.cs", SCRIPTBUNDLE_UNITTEST_SCRIPT, index );
+    return Platform::makeFullPathName( fileName, pBuffer, bufferSize );
+}
+
+//-----------------------------------------------------------------------------
+
+static const char* getTestBundlePath( char* pBuffer, const U32 bufferSize, const char* pBundleName = SCRIPTBUNDLE_UNITTEST_BUNDLE )
+{
+    return Platform::makeFullPathName( pBundleName, pBuffer, bufferSize );
+}
+
+//-----------------------------------------------------------------------------
+
+static bool writeTestScript( const U32 index, const U32 value, const U32 functionCount )
+{
+    char scriptFile[1024];
+    getTestScriptPath( scriptFile, sizeof(scriptFile), index );
+
+    FileStream stream;
+    if ( !stream.open( scriptFile, FileStream::Write ) )
+        return false;
+
+    char line[256];
+    dSprintf( line, sizeof(line), "$ScriptBundleTest::Value%d = %d;\n", index, value );
+    stream.write( dStrlen(line), line );
+
+    for ( U32 function = 0; function < functionCount; ++function )
+    {
+        dSprintf( line, sizeof(line), "function ScriptBundleTest%d_%d( %%a, %%b ) { %%c = %%a * %%b; if ( %%c > 10 ) return %%c - %%a; return %%b @ \"x\"; }\n", index, function );
+        stream.write( dStrlen(line), line );
+    }
+
+    stream.close();
+
+    // Make the script visible to the resource manager's expression matching.
+    return ResourceManager->find( scriptFile ) != NULL;
+}
+
+//-----------------------------------------------------------------------------
+
+static void deleteTestFiles( const U32 scriptCount )
+{
+    char path[1024];
+    char dsoFile[1024];
+
+    ScriptBundle::unload( getTestBundlePath( path, sizeof(path) ) );
+    Platform::fileDelete( path );
+
+    for ( U32 index = 0; index < scriptCount; ++index )
+    {
+        getTestScriptPath( path, sizeof(path), index );
+        dSprintf( dsoFile, sizeof(dsoFile), "%s.dso", path );
+        Platform::fileDelete( path );
+        Platform::fileDelete( dsoFile );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static bool execTestScript( const U32 index )
+{
+    char scriptFile[1024];
+    return dAtob( Con::executef( 2, "exec", getTestScriptPath( scriptFile, sizeof(scriptFile), index ) ) );
+}
+
+//-----------------------------------------------------------------------------
+
+static S32 getTestScriptValue( const U32 index )
+{
+    char variable[64];
+    dSprintf( variable, sizeof(variable), "$ScriptBundleTest::Value%d", index );
+    return Con::getIntVariable( variable );
+}
+
+//-----------------------------------------------------------------------------
+
+static void clearTestScriptValue( const U32 index )
+{
+    char variable[64];
+    dSprintf( variable, sizeof(variable), "$ScriptBundleTest::Value%d", index );
+    Con::setIntVariable( variable, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScriptBundleTests, RoundTripTest )
+{
+    const bool ignoreDSOs = Con::getBoolVariable( "Scripts::ignoreDSOs" );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", false );
+
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_SCRIPTS; ++index )
+    {
+        ASSERT_TRUE( writeTestScript( index, index + 1, 1 ) ) << "Could not write test script.";
+    }
+
+    char bundleFile[1024];
+    getTestBundlePath( bundleFile, sizeof(bundleFile) );
+
+    U32 totalScripts;
+    const S32 failedScripts = ScriptBundle::build( bundleFile, SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION, totalScripts );
+
+    // Check.
+    ASSERT_EQ( 0, failedScripts ) << "Scripts failed to compile into the bundle.";
+    ASSERT_EQ( (U32)SCRIPTBUNDLE_UNITTEST_SCRIPTS, totalScripts ) << "Bundle script count is incorrect.";
+
+    // Remove the sources so that only the bundle can serve the scripts.
+    char scriptFile[1024];
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_SCRIPTS; ++index )
+        Platform::fileDelete( getTestScriptPath( scriptFile, sizeof(scriptFile), index ) );
+
+    ASSERT_TRUE( ScriptBundle::load( bundleFile ) ) << "Bundle did not load.";
+
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_SCRIPTS; ++index )
+    {
+        clearTestScriptValue( index );
+
+        // Check.
+        ASSERT_TRUE( execTestScript( index ) ) << "Bundled script did not execute.";
+        ASSERT_EQ( (S32)index + 1, getTestScriptValue( index ) ) << "Bundled script result is incorrect.";
+    }
+
+    deleteTestFiles( SCRIPTBUNDLE_UNITTEST_SCRIPTS );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", ignoreDSOs );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScriptBundleTests, StaleBundleTest )
+{
+    const bool ignoreDSOs = Con::getBoolVariable( "Scripts::ignoreDSOs" );
+    const bool checkBundleTimes = Con::getBoolVariable( "Scripts::checkBundleTimes" );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", false );
+
+    ASSERT_TRUE( writeTestScript( 0, 1, 1 ) ) << "Could not write test script.";
+
+    char bundleFile[1024];
+    getTestBundlePath( bundleFile, sizeof(bundleFile) );
+
+    U32 totalScripts;
+    ASSERT_EQ( 0, ScriptBundle::build( bundleFile, SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION, totalScripts ) ) << "Script failed to compile into the bundle.";
+
+    // Edit the script after the bundle was built.  File times may only have a one second resolution.
+    Platform::sleep( 1100 );
+    ASSERT_TRUE( writeTestScript( 0, 2, 1 ) ) << "Could not rewrite test script.";
+
+    // Without time checks the bundle is trusted.
+    Con::setBoolVariable( "Scripts::checkBundleTimes", false );
+    ASSERT_TRUE( ScriptBundle::load( bundleFile ) ) << "Bundle did not load.";
+    clearTestScriptValue( 0 );
+    ASSERT_TRUE( execTestScript( 0 ) ) << "Bundled script did not execute.";
+    ASSERT_EQ( 1, getTestScriptValue( 0 ) ) << "Bundle was not used without time checks.";
+
+    // With time checks the edited script wins.
+    Con::setBoolVariable( "Scripts::checkBundleTimes", true );
+    ASSERT_TRUE( ScriptBundle::load( bundleFile ) ) << "Bundle did not reload.";
+    clearTestScriptValue( 0 );
+    ASSERT_TRUE( execTestScript( 0 ) ) << "Edited script did not execute.";
+    ASSERT_EQ( 2, getTestScriptValue( 0 ) ) << "Stale bundle overrode the edited script.";
+
+    deleteTestFiles( 1 );
+    Con::setBoolVariable( "Scripts::checkBundleTimes", checkBundleTimes );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", ignoreDSOs );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ScriptBundleTests, VersionFallbackTest )
+{
+    const bool ignoreDSOs = Con::getBoolVariable( "Scripts::ignoreDSOs" );
+    const bool checkBundleTimes = Con::getBoolVariable( "Scripts::checkBundleTimes" );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", false );
+    Con::setBoolVariable( "Scripts::checkBundleTimes", false );
+
+    char oldBundleFile[1024];
+    char bundleFile[1024];
+    getTestBundlePath( oldBundleFile, sizeof(oldBundleFile), SCRIPTBUNDLE_UNITTEST_OLD_BUNDLE );
+    getTestBundlePath( bundleFile, sizeof(bundleFile) );
+
+    U32 totalScripts;
+    ASSERT_TRUE( writeTestScript( 0, 1, 1 ) ) << "Could not write test script.";
+    ASSERT_EQ( 0, ScriptBundle::build( oldBundleFile, SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION, totalScripts ) ) << "Script failed to compile into the old bundle.";
+    ASSERT_TRUE( writeTestScript( 0, 2, 1 ) ) << "Could not rewrite test script.";
+    ASSERT_EQ( 0, ScriptBundle::build( bundleFile, SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION, totalScripts ) ) << "Script failed to compile into the bundle.";
+
+    // Stamp the newer bundle's copy of the script with a foreign DSO version.
+    FileStream stream;
+    ASSERT_TRUE( stream.open( bundleFile, FileStream::ReadWrite ) ) << "Could not open the bundle.";
+    U32 header[4];
+    for ( U32 index = 0; index < 4; ++index )
+        stream.read( &header[index] );
+    char scriptKey[1024];
+    U32 scriptOffset;
+    stream.setPosition( header[3] );
+    stream.readLongString( sizeof(scriptKey)-1, scriptKey );
+    stream.read( &scriptOffset );
+    stream.setPosition( scriptOffset );
+    stream.write( (U32)0 );
+    stream.close();
+
+    // The newest bundle is searched first and should hand over to the old one.
+    ASSERT_TRUE( ScriptBundle::load( oldBundleFile ) ) << "Old bundle did not load.";
+    ASSERT_TRUE( ScriptBundle::load( bundleFile ) ) << "Bundle did not load.";
+    clearTestScriptValue( 0 );
+    ASSERT_TRUE( execTestScript( 0 ) ) << "Bundled script did not execute.";
+    ASSERT_EQ( 1, getTestScriptValue( 0 ) ) << "A stale DSO version stopped the search of older bundles.";
+
+    ScriptBundle::unload( oldBundleFile );
+    Platform::fileDelete( oldBundleFile );
+    deleteTestFiles( 1 );
+    Con::setBoolVariable( "Scripts::checkBundleTimes", checkBundleTimes );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", ignoreDSOs );
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( ScriptBundleTests, BootBenchmarkTest )
+{
+    const bool ignoreDSOs = Con::getBoolVariable( "Scripts::ignoreDSOs" );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", false );
+
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS; ++index )
+    {
+        ASSERT_TRUE( writeTestScript( index, index + 1, SCRIPTBUNDLE_UNITTEST_BENCHMARK_FUNCTIONS ) ) << "Could not write test script.";
+    }
+
+    // Boot from source, which also writes the DSOs.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS; ++index )
+        execTestScript( index );
+    const U32 sourceTime = Platform::getRealMilliseconds() - startTime;
+
+    // Boot from the DSOs.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS; ++index )
+        execTestScript( index );
+    const U32 dsoTime = Platform::getRealMilliseconds() - startTime;
+
+    char bundleFile[1024];
+    getTestBundlePath( bundleFile, sizeof(bundleFile) );
+
+    U32 totalScripts;
+    ASSERT_EQ( 0, ScriptBundle::build( bundleFile, SCRIPTBUNDLE_UNITTEST_SCRIPT_EXPRESSION, totalScripts ) ) << "Scripts failed to compile into the bundle.";
+
+    // Boot from the bundle, including loading it.
+    startTime = Platform::getRealMilliseconds();
+    ASSERT_TRUE( ScriptBundle::load( bundleFile ) ) << "Bundle did not load.";
+    for ( U32 index = 0; index < SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS; ++index )
+        execTestScript( index );
+    const U32 bundleTime = Platform::getRealMilliseconds() - startTime;
+
+    deleteTestFiles( SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS );
+    Con::setBoolVariable( "Scripts::ignoreDSOs", ignoreDSOs );
+
+    RecordProperty( "Scripts", SCRIPTBUNDLE_UNITTEST_BENCHMARK_SCRIPTS );
+    RecordProperty( "SourceBootMs", sourceTime );
+    RecordProperty( "DsoBootMs", dsoTime );
+    RecordProperty( "BundleBootMs", bundleTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
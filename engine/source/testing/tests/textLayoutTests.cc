@@ -0,0 +1,254 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _DGL_TEXT_LAYOUT_H_
+#include "graphics/dglTextLayout.h"
+#endif
+
+#ifndef _DGL_H_
+#include "graphics/dgl.h"
+#endif
+
+#ifndef _GFONT_H_
+#include "graphics/gFont.h"
+#endif
+
+#ifndef _GUICANVAS_H_
+#include "gui/guiCanvas.h"
+#endif
+
+#ifndef _GUITYPES_H_
+#include "gui/guiTypes.h"
+#endif
+
+#ifndef _GUIMLTEXTCTRL_H_
+#include "gui/guiMLTextCtrl.h"
+#endif
+
+#ifndef _UNICODE_H_
+#include "string/unicode.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TEXTLAYOUT_UNITTEST_FONT            "Arial"
+#define TEXTLAYOUT_UNITTEST_FONT_SIZE       14
+#define TEXTLAYOUT_UNITTEST_LINES           4000
+#define TEXTLAYOUT_UNITTEST_FRAMES          10
+
+//-----------------------------------------------------------------------------
+
+static bool textLayoutTestsCanRun( void )
+{
+    // Fonts need a rendering context for their sheets.
+    return Canvas != NULL && TextureManager::mDGLRender && TextureManager::getManagerState() == TextureManager::Alive;
+}
+
+//-----------------------------------------------------------------------------
+
+static DGLTextLayout::ColorState getTestColors( const ColorI& modulation )
+{
+    DGLTextLayout::ColorState colors;
+    colors.mModulation = modulation;
+    colors.mAnchor = modulation;
+    colors.mStack = modulation;
+    return colors;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextLayoutTests, LayoutTest )
+{
+    if ( !textLayoutTestsCanRun() )
+        return;
+
+    Resource<GFont> font = GFont::create( TEXTLAYOUT_UNITTEST_FONT, TEXTLAYOUT_UNITTEST_FONT_SIZE, GuiControlProfile::sFontCacheDirectory );
+    if ( font.isNull() )
+        return;
+
+    const bool enabled = DGLTextLayoutCache::getEnabled();
+    DGLTextLayoutCache::setEnabled( true );
+    DGLTextLayoutCache::clear();
+
+    const ColorI white( 255, 255, 255, 255 );
+    const ColorI red( 255, 0, 0, 255 );
+    const char* pText = "HelloWorld";
+
+    // The advance matches the measured width.
+    const DGLTextLayout& layout = DGLTextLayoutCache::getLayout( font, pText, dStrlen(pText), NULL, 9, getTestColors( white ) );
+    ASSERT_EQ( (S32)font->getStrWidth( pText ), layout.getAdvance() ) << "Advance does not match the string width.";
+    ASSERT_GT( layout.getRuns().size(), 0 ) << "No glyphs were laid out.";
+    ASSERT_EQ( 0, layout.getVertices().size() % 4 ) << "Glyphs are not quads.";
+
+    U32 runVertices = 0;
+    for ( S32 index = 0; index < layout.getRuns().size(); ++index )
+        runVertices += layout.getRuns()[index].mCount;
+    ASSERT_EQ( (U32)layout.getVertices().size(), runVertices ) << "Runs do not cover the vertices.";
+
+    // The same text is a hit.
+    const U32 hitCount = DGLTextLayoutCache::getHitCount();
+    DGLTextLayoutCache::getLayout( font, pText, dStrlen(pText), NULL, 9, getTestColors( white ) );
+    ASSERT_EQ( hitCount + 1, DGLTextLayoutCache::getHitCount() ) << "Identical text was not a hit.";
+    ASSERT_EQ( 1u, DGLTextLayoutCache::getLayoutCount() ) << "Identical text was cached twice.";
+
+    // So is identical UTF16 text, but as its own layout.
+    UTF16 text16[32];
+    convertUTF8toUTF16( pText, text16, 32 );
+    DGLTextLayoutCache::getLayout( font, text16, dStrlen(text16), NULL, 9, getTestColors( white ) );
+    ASSERT_EQ( 2u, DGLTextLayoutCache::getLayoutCount() ) << "UTF16 text was not cached.";
+
+    // Other colors are a miss.
+    const U32 missCount = DGLTextLayoutCache::getMissCount();
+    DGLTextLayoutCache::getLayout( font, pText, dStrlen(pText), NULL, 9, getTestColors( red ) );
+    ASSERT_EQ( missCount + 1, DGLTextLayoutCache::getMissCount() ) << "Different colors were a hit.";
+
+    // Color codes are resolved into the vertices and the end colors.
+    ColorI colorTable[10];
+    for ( U32 index = 0; index < 10; ++index )
+        colorTable[index].set( (U8)( index * 20 ), 0, 0, 255 );
+
+    const char pColored[] = { 'A', 2, 'B', 16, 3, 'C', 17, 0 };
+    const DGLTextLayout& coloredLayout = DGLTextLayoutCache::getLayout( font, pColored, dStrlen(pColored), colorTable, 9, getTestColors( white ) );
+    ASSERT_EQ( 12, coloredLayout.getVertices().size() ) << "Color codes produced glyphs.";
+    ASSERT_TRUE( coloredLayout.getEndColors().mModulation == colorTable[1] ) << "Pop did not restore the pushed color.";
+    ASSERT_TRUE( coloredLayout.getEndColors().mStack == colorTable[1] ) << "Push did not store the color.";
+
+    // Changing a color the text uses is a miss.
+    const U32 coloredMissCount = DGLTextLayoutCache::getMissCount();
+    colorTable[2].set( 0, 255, 0, 255 );
+    DGLTextLayoutCache::getLayout( font, pColored, dStrlen(pColored), colorTable, 9, getTestColors( white ) );
+    ASSERT_EQ( coloredMissCount + 1, DGLTextLayoutCache::getMissCount() ) << "Changed color table was a hit.";
+
+    // Dropping the font drops its layouts.
+    DGLTextLayoutCache::purgeFont( font );
+    ASSERT_EQ( 0u, DGLTextLayoutCache::getLayoutCount() ) << "Font layouts were not purged.";
+
+    DGLTextLayoutCache::setEnabled( enabled );
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static U32 drawTestLines( GFont* pFont, char lines[][64], const U32 lineCount )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 frame = 0; frame < TEXTLAYOUT_UNITTEST_FRAMES; ++frame )
+    {
+        for ( U32 line = 0; line < lineCount; ++line )
+        {
+            dglSetBitmapModulation( ColorI( 255, 255, 255, 255 ) );
+            dglDrawText( pFont, Point2I( 0, ( line % 64 ) * pFont->getHeight() ), lines[line] );
+        }
+    }
+    glFinish();
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextLayoutTests, BenchmarkTest )
+{
+    if ( !textLayoutTestsCanRun() )
+        return;
+
+    Resource<GFont> font = GFont::create( TEXTLAYOUT_UNITTEST_FONT, TEXTLAYOUT_UNITTEST_FONT_SIZE, GuiControlProfile::sFontCacheDirectory );
+    if ( font.isNull() )
+        return;
+
+    const bool enabled = DGLTextLayoutCache::getEnabled();
+
+    // Console style lines.
+    char (*pLines)[64] = new char[TEXTLAYOUT_UNITTEST_LINES][64];
+    for ( U32 line = 0; line < TEXTLAYOUT_UNITTEST_LINES; ++line )
+        dSprintf( pLines[line], 64, "%d: Loading module 'Sandbox' from path 'modules/%d'", line, line % 17 );
+
+    dglSetClipRect( RectI( Point2I( 0, 0 ), Platform::getWindowSize() ) );
+
+    DGLTextLayoutCache::setEnabled( false );
+    const U32 uncachedTime = drawTestLines( font, pLines, TEXTLAYOUT_UNITTEST_LINES );
+
+    // The first frame fills the cache.
+    DGLTextLayoutCache::setEnabled( true );
+    drawTestLines( font, pLines, 1 );
+    const U32 cachedTime = drawTestLines( font, pLines, TEXTLAYOUT_UNITTEST_LINES );
+
+    delete [] pLines;
+
+    RecordProperty( "UncachedLinesMilliseconds", (S32)uncachedTime );
+    RecordProperty( "CachedLinesMilliseconds", (S32)cachedTime );
+    RecordProperty( "Layouts", (S32)DGLTextLayoutCache::getLayoutCount() );
+
+    // Multi-line text through the canvas.
+    GuiControlProfile* pProfile = NULL;
+    if ( Sim::findObject( "GuiDefaultProfile", pProfile ) )
+    {
+        GuiMLTextCtrl* pText = new GuiMLTextCtrl();
+        pText->setControlProfile( pProfile );
+        pText->registerObject();
+        pText->setExtent( Platform::getWindowSize() );
+
+        // Enough text to fill the screen many times over.
+        const U32 bufferSize = TEXTLAYOUT_UNITTEST_LINES * 64;
+        char* pBuffer = new char[bufferSize];
+        U32 length = 0;
+        for ( U32 line = 0; line < TEXTLAYOUT_UNITTEST_LINES && length + 64 < bufferSize; ++line )
+            length += dSprintf( pBuffer + length, bufferSize - length, "Line %d of the multi-line text benchmark.\n", line );
+        pText->setText( pBuffer, length );
+        delete [] pBuffer;
+
+        Canvas->pushDialogControl( pText, 99 );
+
+        U32 times[2];
+        for ( U32 pass = 0; pass < 2; ++pass )
+        {
+            DGLTextLayoutCache::setEnabled( pass == 1 );
+            Canvas->renderFrame( false, false );
+
+            const U32 startTime = Platform::getRealMilliseconds();
+            for ( U32 frame = 0; frame < TEXTLAYOUT_UNITTEST_FRAMES; ++frame )
+                Canvas->renderFrame( false, false );
+            glFinish();
+            times[pass] = Platform::getRealMilliseconds() - startTime;
+        }
+
+        Canvas->popDialogControl( pText );
+        pText->deleteObject();
+
+        RecordProperty( "UncachedMLTextMilliseconds", (S32)times[0] );
+        RecordProperty( "CachedMLTextMilliseconds", (S32)times[1] );
+    }
+
+    DGLTextLayoutCache::setEnabled( enabled );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
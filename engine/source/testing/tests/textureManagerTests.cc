@@ -0,0 +1,488 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _TEXTURE_MANAGER_H_
+#include "graphics/TextureManager.h"
+#endif
+
+#ifndef _GBITMAP_H_
+#include "graphics/gBitmap.h"
+#endif
+
+#ifndef _TEXTURE_CACHE_H_
+#include "graphics/TextureCache.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "io/fileStream.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+#ifndef _GUICANVAS_H_
+#include "gui/guiCanvas.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define TEXTURE_UNITTEST_FILE                   "_unitTestTexture_RemoveMe"
+#define TEXTURE_UNITTEST_WIDTH                  173
+#define TEXTURE_UNITTEST_HEIGHT                 61
+#define TEXTURE_UNITTEST_BENCHMARK_TEXTURES     64
+#define TEXTURE_UNITTEST_BENCHMARK_SIZE         512
+#define TEXTURE_UNITTEST_CACHE_BENCHMARK_PASSES  16
+#define TEXTURE_UNITTEST_CACHE_DIRECTORY        "_unitTestTextureCache_RemoveMe"
+#define TEXTURE_UNITTEST_CACHE_EVICTION_SIZE    512
+#define TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES 3
+
+//-----------------------------------------------------------------------------
+
+static GBitmap* createTestBitmap( const U32 width, const U32 height, const GBitmap::BitmapFormat format, const U32 seed )
+{
+    GBitmap* pBitmap = new GBitmap( width, height, false, format );
+
+    // Noise so that compression does not make the bitmaps trivially small.
+    U32 state = seed * 2654435761u + 1;
+    U8* pBits = pBitmap->getWritableBits();
+    for ( U32 index = 0; index < pBitmap->byteSize; ++index )
+    {
+        state = state * 1664525u + 1013904223u;
+        pBits[index] = (U8)( state >> 24 );
+    }
+
+    return pBitmap;
+}
+
+//-----------------------------------------------------------------------------
+
+static bool writeTestBitmap( const char* pFileName, const GBitmap* pBitmap, const bool jpeg )
+{
+    FileStream stream;
+    if ( !stream.open( pFileName, FileStream::Write ) )
+        return false;
+
+    const bool written = jpeg ? pBitmap->writeJPEG( stream ) : pBitmap->writePNG( stream );
+    stream.close();
+    return written;
+}
+
+//-----------------------------------------------------------------------------
+
+static void deleteTestBitmap( const char* pFileName )
+{
+    // Remove any cache entry along with the file.
+    if ( TextureCache::isEnabled() )
+    {
+        char sourcePath[1024];
+        Platform::makeFullPathName( pFileName, sourcePath, sizeof(sourcePath) );
+        TextureCache::remove( sourcePath );
+    }
+
+    Platform::fileDelete( pFileName );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, ReadDimensionsTest )
+{
+    GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_WIDTH, TEXTURE_UNITTEST_HEIGHT, GBitmap::RGB, 1 );
+
+    // PNG.
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".png", pBitmap, false ) ) << "Failed to write PNG.";
+
+    FileStream stream;
+    U32 width = 0;
+    U32 height = 0;
+    ASSERT_TRUE( stream.open( TEXTURE_UNITTEST_FILE ".png", FileStream::Read ) ) << "Failed to open PNG.";
+    ASSERT_TRUE( GBitmap::readPNGDimensions( stream, width, height ) ) << "Failed to read PNG dimensions.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_WIDTH, width ) << "PNG width is wrong.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_HEIGHT, height ) << "PNG height is wrong.";
+
+    // The reentrant reader must still decode the same pixels.
+    GBitmap decoded;
+    ASSERT_TRUE( stream.setPosition( 0 ) ) << "Failed to rewind PNG.";
+    ASSERT_TRUE( decoded.readPNG( stream ) ) << "Failed to decode PNG.";
+    ASSERT_EQ( pBitmap->byteSize, decoded.byteSize ) << "Decoded PNG has the wrong size.";
+    ASSERT_EQ( 0, dMemcmp( pBitmap->getBits(), decoded.getBits(), pBitmap->byteSize ) ) << "Decoded PNG has the wrong pixels.";
+
+    // A truncated PNG must fail rather than abort.
+    const U32 truncatedSize = stream.getStreamSize() / 2;
+    U8* pTruncated = new U8[truncatedSize];
+    ASSERT_TRUE( stream.setPosition( 0 ) ) << "Failed to rewind PNG.";
+    ASSERT_TRUE( stream.read( truncatedSize, pTruncated ) ) << "Failed to read PNG.";
+    MemStream truncatedStream( truncatedSize, pTruncated, true, false );
+    GBitmap truncated;
+    ASSERT_FALSE( truncated.readPNG( truncatedStream ) ) << "Decoded a truncated PNG.";
+    delete [] pTruncated;
+    stream.close();
+
+    // JPEG.
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".jpg", pBitmap, true ) ) << "Failed to write JPEG.";
+
+    width = height = 0;
+    ASSERT_TRUE( stream.open( TEXTURE_UNITTEST_FILE ".jpg", FileStream::Read ) ) << "Failed to open JPEG.";
+    ASSERT_TRUE( GBitmap::readJPEGDimensions( stream, width, height ) ) << "Failed to read JPEG dimensions.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_WIDTH, width ) << "JPEG width is wrong.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_HEIGHT, height ) << "JPEG height is wrong.";
+    stream.close();
+
+    // Neither reader should accept the other format.
+    ASSERT_TRUE( stream.open( TEXTURE_UNITTEST_FILE ".jpg", FileStream::Read ) ) << "Failed to open JPEG.";
+    ASSERT_FALSE( GBitmap::readPNGDimensions( stream, width, height ) ) << "Read PNG dimensions from a JPEG.";
+    stream.close();
+
+    delete pBitmap;
+    Platform::fileDelete( TEXTURE_UNITTEST_FILE ".png" );
+    Platform::fileDelete( TEXTURE_UNITTEST_FILE ".jpg" );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Points the texture cache at a scratch directory for the lifetime of the scope.
+class TextureCacheTestScope
+{
+public:
+    TextureCacheTestScope( const S32 maxMB )
+    {
+        mWasEnabled = Con::getBoolVariable( "$pref::OpenGL::textureCache" );
+        mMaxMB = Con::getIntVariable( "$pref::OpenGL::textureCacheMaxMB" );
+        dStrcpy( mCachePath, Con::getVariable( "$pref::OpenGL::textureCachePath" ) );
+
+        TextureCache::destroy();
+        Con::setBoolVariable( "$pref::OpenGL::textureCache", true );
+        Con::setIntVariable( "$pref::OpenGL::textureCacheMaxMB", maxMB );
+        Con::setVariable( "$pref::OpenGL::textureCachePath", TEXTURE_UNITTEST_CACHE_DIRECTORY );
+    }
+
+    ~TextureCacheTestScope()
+    {
+        if ( TextureCache::isEnabled() )
+            TextureCache::purge();
+        TextureCache::destroy();
+
+        Con::setBoolVariable( "$pref::OpenGL::textureCache", mWasEnabled );
+        Con::setIntVariable( "$pref::OpenGL::textureCacheMaxMB", mMaxMB );
+        Con::setVariable( "$pref::OpenGL::textureCachePath", mCachePath );
+    }
+
+private:
+    bool mWasEnabled;
+    S32 mMaxMB;
+    char mCachePath[1024];
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, TextureCacheTest )
+{
+    TextureCacheTestScope cacheScope( 256 );
+    if ( !TextureCache::isEnabled() )
+        return;
+
+    GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_WIDTH, TEXTURE_UNITTEST_HEIGHT, GBitmap::RGBA, 3 );
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".png", pBitmap, false ) ) << "Failed to write PNG.";
+    GBitmap* pPaddedBitmap = pBitmap->createPowerOfTwoBitmap();
+    ASSERT_TRUE( pPaddedBitmap != NULL ) << "Test bitmap should need padding.";
+
+    char sourcePath[1024];
+    Platform::makeFullPathName( TEXTURE_UNITTEST_FILE ".png", sourcePath, sizeof(sourcePath) );
+
+    // Nothing cached yet.
+    U32 bitmapWidth = 0;
+    U32 bitmapHeight = 0;
+    TextureCache::remove( sourcePath );
+    ASSERT_TRUE( TextureCache::load( sourcePath, bitmapWidth, bitmapHeight ) == NULL ) << "Loaded an entry that was never stored.";
+
+    // Round trip, the padded texels come back as stored along with the source dimensions.
+    TextureCache::store( sourcePath, pPaddedBitmap, pBitmap->getWidth(), pBitmap->getHeight(), 0 );
+    TextureCache::flush();
+    GBitmap* pCachedBitmap = TextureCache::load( sourcePath, bitmapWidth, bitmapHeight );
+    ASSERT_TRUE( pCachedBitmap != NULL ) << "Failed to load a stored entry.";
+    ASSERT_EQ( pBitmap->getWidth(), bitmapWidth ) << "Cached entry has the wrong source width.";
+    ASSERT_EQ( pBitmap->getHeight(), bitmapHeight ) << "Cached entry has the wrong source height.";
+    ASSERT_EQ( pPaddedBitmap->getFormat(), pCachedBitmap->getFormat() ) << "Cached bitmap has the wrong format.";
+    ASSERT_EQ( pPaddedBitmap->getWidth(), pCachedBitmap->getWidth() ) << "Cached bitmap has the wrong width.";
+    ASSERT_EQ( pPaddedBitmap->getHeight(), pCachedBitmap->getHeight() ) << "Cached bitmap has the wrong height.";
+    ASSERT_EQ( pPaddedBitmap->byteSize, pCachedBitmap->byteSize ) << "Cached bitmap has the wrong size.";
+    ASSERT_EQ( 0, dMemcmp( pPaddedBitmap->getBits(), pCachedBitmap->getBits(), pPaddedBitmap->byteSize ) ) << "Cached bitmap has the wrong texels.";
+    delete pCachedBitmap;
+
+    // Changing the source invalidates the entry.
+    GBitmap* pChangedBitmap = createTestBitmap( TEXTURE_UNITTEST_WIDTH * 2, TEXTURE_UNITTEST_HEIGHT, GBitmap::RGBA, 4 );
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".png", pChangedBitmap, false ) ) << "Failed to rewrite PNG.";
+    ASSERT_TRUE( TextureCache::load( sourcePath, bitmapWidth, bitmapHeight ) == NULL ) << "Loaded a stale entry.";
+    delete pChangedBitmap;
+
+    delete pPaddedBitmap;
+    delete pBitmap;
+    TextureCache::remove( sourcePath );
+    Platform::fileDelete( TEXTURE_UNITTEST_FILE ".png" );
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, TextureCacheDisabledTest )
+{
+    // Switch the cache off without ever resolving it.
+    TextureCacheTestScope cacheScope( 1 );
+    Con::setBoolVariable( "$pref::OpenGL::textureCache", false );
+    ASSERT_FALSE( TextureCache::isEnabled() ) << "Cache is still enabled.";
+
+    char sourcePath[1024];
+    Platform::makeFullPathName( TEXTURE_UNITTEST_FILE ".png", sourcePath, sizeof(sourcePath) );
+
+    // Nothing must touch the index.
+    U32 bitmapWidth, bitmapHeight;
+    TextureCache::remove( sourcePath );
+    ASSERT_TRUE( TextureCache::load( sourcePath, bitmapWidth, bitmapHeight ) == NULL ) << "Loaded from a disabled cache.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, TextureCacheEvictionTest )
+{
+    // Each entry is just over a megabyte so only the newest fits.
+    TextureCacheTestScope cacheScope( 1 );
+    if ( !TextureCache::isEnabled() )
+        return;
+
+    GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_CACHE_EVICTION_SIZE, TEXTURE_UNITTEST_CACHE_EVICTION_SIZE, GBitmap::RGBA, 6 );
+
+    char fileNames[TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES][64];
+    char sourcePaths[TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES][1024];
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES; ++index )
+    {
+        dSprintf( fileNames[index], sizeof(fileNames[index]), TEXTURE_UNITTEST_FILE "_%d.png", index );
+        ASSERT_TRUE( writeTestBitmap( fileNames[index], pBitmap, false ) ) << "Failed to write PNG.";
+        Platform::makeFullPathName( fileNames[index], sourcePaths[index], sizeof(sourcePaths[index]) );
+
+        TextureCache::store( sourcePaths[index], pBitmap, pBitmap->getWidth(), pBitmap->getHeight(), 0 );
+        TextureCache::flush();
+    }
+
+    delete pBitmap;
+
+    // Check.
+    U32 bitmapWidth, bitmapHeight;
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES - 1; ++index )
+        ASSERT_TRUE( TextureCache::load( sourcePaths[index], bitmapWidth, bitmapHeight ) == NULL ) << "Older entry was not evicted.";
+
+    GBitmap* pCachedBitmap = TextureCache::load( sourcePaths[TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES - 1], bitmapWidth, bitmapHeight );
+    ASSERT_TRUE( pCachedBitmap != NULL ) << "Newest entry was evicted.";
+    delete pCachedBitmap;
+
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_CACHE_EVICTION_ENTRIES; ++index )
+        Platform::fileDelete( fileNames[index] );
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( TextureManagerTests, TextureCacheBenchmarkTest )
+{
+    TextureCacheTestScope cacheScope( 256 );
+    if ( !TextureCache::isEnabled() )
+        return;
+
+    GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_BENCHMARK_SIZE, TEXTURE_UNITTEST_BENCHMARK_SIZE, GBitmap::RGBA, 5 );
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".png", pBitmap, false ) ) << "Failed to write PNG.";
+
+    char sourcePath[1024];
+    Platform::makeFullPathName( TEXTURE_UNITTEST_FILE ".png", sourcePath, sizeof(sourcePath) );
+    TextureCache::store( sourcePath, pBitmap, pBitmap->getWidth(), pBitmap->getHeight(), 0 );
+    TextureCache::flush();
+    delete pBitmap;
+
+    // Decode the source.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < TEXTURE_UNITTEST_CACHE_BENCHMARK_PASSES; ++pass )
+    {
+        FileStream stream;
+        ASSERT_TRUE( stream.open( sourcePath, FileStream::Read ) ) << "Failed to open PNG.";
+        GBitmap decoded;
+        ASSERT_TRUE( decoded.readPNG( stream ) ) << "Failed to decode PNG.";
+    }
+    const U32 decodeTime = Platform::getRealMilliseconds() - startTime;
+
+    // Read the cached texels.
+    U32 bitmapWidth, bitmapHeight;
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 pass = 0; pass < TEXTURE_UNITTEST_CACHE_BENCHMARK_PASSES; ++pass )
+    {
+        GBitmap* pCachedBitmap = TextureCache::load( sourcePath, bitmapWidth, bitmapHeight );
+        ASSERT_TRUE( pCachedBitmap != NULL ) << "Failed to load a stored entry.";
+        delete pCachedBitmap;
+    }
+    const U32 cacheTime = Platform::getRealMilliseconds() - startTime;
+
+    TextureCache::remove( sourcePath );
+    Platform::fileDelete( TEXTURE_UNITTEST_FILE ".png" );
+
+    RecordProperty( "DecodeMilliseconds", (S32)decodeTime );
+    RecordProperty( "CacheReadMilliseconds", (S32)cacheTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+//-----------------------------------------------------------------------------
+
+TEST( TextureManagerTests, AsyncLoadTest )
+{
+    // Uploading needs a rendering context.
+    if ( Canvas == NULL || !TextureManager::mDGLRender || TextureManager::getManagerState() != TextureManager::Alive )
+        return;
+
+    GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_WIDTH, TEXTURE_UNITTEST_HEIGHT, GBitmap::RGBA, 2 );
+    ASSERT_TRUE( writeTestBitmap( TEXTURE_UNITTEST_FILE ".png", pBitmap, false ) ) << "Failed to write PNG.";
+    delete pBitmap;
+
+    const S32 startQueueDepth = TextureManager::getAsyncQueueDepth();
+
+    // The dimensions are known before the pixels arrive.
+    TextureHandle handle;
+    ASSERT_TRUE( handle.setAsync( TEXTURE_UNITTEST_FILE ".png", TextureHandle::BitmapTexture, true ) ) << "Failed to request texture.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_WIDTH, handle.getWidth() ) << "Texture width is wrong.";
+    ASSERT_EQ( (U32)TEXTURE_UNITTEST_HEIGHT, handle.getHeight() ) << "Texture height is wrong.";
+    ASSERT_EQ( 256u, ((TextureObject*)handle)->getTextureWidth() ) << "Texture was not padded to a power-of-two.";
+    ASSERT_EQ( 64u, ((TextureObject*)handle)->getTextureHeight() ) << "Texture was not padded to a power-of-two.";
+
+    if ( handle.isLoadPending() )
+    {
+        ASSERT_EQ( startQueueDepth + 1, TextureManager::getAsyncQueueDepth() ) << "Queue depth was not raised.";
+        ASSERT_NE( 0u, handle.getGLName() ) << "Pending texture has no placeholder.";
+    }
+
+    // A second request shares the pending texture.
+    TextureHandle sharedHandle;
+    sharedHandle.setAsync( TEXTURE_UNITTEST_FILE ".png", TextureHandle::BitmapTexture, true );
+    ASSERT_TRUE( handle == sharedHandle ) << "Second request did not share the texture.";
+
+    // Finish the upload.
+    TextureManager::finishAsyncLoads();
+    ASSERT_FALSE( handle.isLoadPending() ) << "Texture is still pending.";
+    ASSERT_EQ( 0, TextureManager::getAsyncQueueDepth() ) << "Queue was not drained.";
+    ASSERT_NE( 0u, handle.getGLName() ) << "Texture was not uploaded.";
+
+    // A synchronous request never hands back a pending texture.
+    handle.clear();
+    sharedHandle.clear();
+    handle.setAsync( TEXTURE_UNITTEST_FILE ".png", TextureHandle::BitmapTexture, true );
+    ASSERT_TRUE( sharedHandle.set( TEXTURE_UNITTEST_FILE ".png", TextureHandle::BitmapTexture, true ) ) << "Failed to load texture.";
+    ASSERT_FALSE( sharedHandle.isLoadPending() ) << "Synchronous request returned a pending texture.";
+    ASSERT_NE( 0u, sharedHandle.getGLName() ) << "Synchronous request returned a texture that was not uploaded.";
+
+    // Releasing a pending texture must be safe.
+    handle.clear();
+    sharedHandle.clear();
+    handle.setAsync( TEXTURE_UNITTEST_FILE ".png", TextureHandle::BitmapTexture, true );
+    handle.clear();
+    TextureManager::finishAsyncLoads();
+    ASSERT_EQ( 0, TextureManager::getAsyncQueueDepth() ) << "Cancelled load was not collected.";
+
+    deleteTestBitmap( TEXTURE_UNITTEST_FILE ".png" );
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+TEST( TextureManagerTests, BenchmarkTest )
+{
+    // Uploading needs a rendering context.
+    if ( Canvas == NULL || !TextureManager::mDGLRender || TextureManager::getManagerState() != TextureManager::Alive )
+        return;
+
+    // Write a texture-heavy module's worth of bitmaps.
+    char fileNames[TEXTURE_UNITTEST_BENCHMARK_TEXTURES][64];
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+    {
+        dSprintf( fileNames[index], sizeof(fileNames[index]), TEXTURE_UNITTEST_FILE "_%d.png", index );
+
+        // Odd sizes so that padding is exercised too.
+        GBitmap* pBitmap = createTestBitmap( TEXTURE_UNITTEST_BENCHMARK_SIZE - 12, TEXTURE_UNITTEST_BENCHMARK_SIZE - 12, GBitmap::RGBA, index );
+        ASSERT_TRUE( writeTestBitmap( fileNames[index], pBitmap, false ) ) << "Failed to write benchmark PNG.";
+        delete pBitmap;
+    }
+
+    TextureHandle* pHandles = new TextureHandle[TEXTURE_UNITTEST_BENCHMARK_TEXTURES];
+
+    // Warm the file and texture caches so that both passes read the same way.
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        pHandles[index].set( fileNames[index], TextureHandle::BitmapTexture, true );
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        pHandles[index].clear();
+
+    // Synchronous: nothing can be drawn until every texture is loaded.
+    U32 startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        pHandles[index].set( fileNames[index], TextureHandle::BitmapTexture, true );
+    const U32 syncTime = Platform::getRealMilliseconds() - startTime;
+
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        pHandles[index].clear();
+
+    // Asynchronous: the first frame only waits for the requests and one budgeted upload step.
+    startTime = Platform::getRealMilliseconds();
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        pHandles[index].setAsync( fileNames[index], TextureHandle::BitmapTexture, true );
+    TextureManager::processAsyncLoads();
+    const U32 asyncFirstFrameTime = Platform::getRealMilliseconds() - startTime;
+    const S32 queueDepth = TextureManager::getAsyncQueueDepth();
+
+    TextureManager::finishAsyncLoads();
+    const U32 asyncTotalTime = Platform::getRealMilliseconds() - startTime;
+
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+    {
+        ASSERT_FALSE( pHandles[index].isLoadPending() ) << "Texture is still pending.";
+        ASSERT_NE( 0u, pHandles[index].getGLName() ) << "Texture was not uploaded.";
+        pHandles[index].clear();
+    }
+
+    delete [] pHandles;
+
+    for ( U32 index = 0; index < TEXTURE_UNITTEST_BENCHMARK_TEXTURES; ++index )
+        deleteTestBitmap( fileNames[index] );
+
+    RecordProperty( "SynchronousFirstFrameMilliseconds", (S32)syncTime );
+    RecordProperty( "AsynchronousFirstFrameMilliseconds", (S32)asyncFirstFrameTime );
+    RecordProperty( "AsynchronousQueueDepth", (S32)queueDepth );
+    RecordProperty( "AsynchronousTotalMilliseconds", (S32)asyncTotalTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
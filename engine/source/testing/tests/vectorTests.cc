@@ -0,0 +1,348 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _INLINEVECTOR_H_
+#include "collection/inlineVector.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+//-----------------------------------------------------------------------------
+
+#define VECTOR_UNITTEST_ELEMENTS                256
+#define VECTOR_UNITTEST_BENCHMARK_ELEMENTS      (1 << 16)
+#define VECTOR_UNITTEST_BENCHMARK_LISTS         64
+#define VECTOR_UNITTEST_BENCHMARK_PASSES        16
+#define VECTOR_UNITTEST_INLINE_COUNT            8
+
+//-----------------------------------------------------------------------------
+
+struct VectorTestElement
+{
+    U32 mKey;
+    F32 mValue[3];
+};
+
+//-----------------------------------------------------------------------------
+
+static S32 gVectorTestLiveCount = 0;
+
+struct VectorTestCountedElement
+{
+    VectorTestCountedElement() : mValue( 0.0 ) { gVectorTestLiveCount++; }
+    VectorTestCountedElement( const VectorTestCountedElement& other ) : mValue( other.mValue ) { gVectorTestLiveCount++; }
+    ~VectorTestCountedElement() { gVectorTestLiveCount--; }
+
+    F64 mValue;
+};
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, GrowthTest )
+{
+    Vector<U32> vector;
+    U32 reallocations = 0;
+    U32 lastCapacity = vector.capacity();
+
+    for ( U32 index = 0; index < VECTOR_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+    {
+        vector.push_back( index );
+
+        if ( vector.capacity() != lastCapacity )
+        {
+            ASSERT_EQ( (U32)0, vector.capacity() % VectorBlockSize ) << "Capacity is not a whole number of blocks.";
+            lastCapacity = vector.capacity();
+            reallocations++;
+        }
+    }
+
+    // Geometric growth needs far fewer reallocations than one per block.
+    ASSERT_LT( reallocations, (U32)32 ) << "Vector is not growing geometrically.";
+
+    for ( U32 index = 0; index < VECTOR_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        ASSERT_EQ( index, vector[index] ) << "Element lost while growing.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, ShrinkTest )
+{
+    Vector<U32> vector;
+    for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+        vector.push_back( index );
+
+    const U32 capacity = vector.capacity();
+
+    // Removing elements must not give storage back.
+    while ( vector.size() > 1 )
+        vector.erase_fast( U32(0) );
+    ASSERT_EQ( capacity, vector.capacity() ) << "Capacity shrank without a compaction.";
+
+    vector.setSize( VECTOR_UNITTEST_ELEMENTS / 2 );
+    ASSERT_EQ( capacity, vector.capacity() ) << "Capacity changed when growing within it.";
+
+    // Compaction trims to the nearest block.
+    vector.setSize( 3 );
+    vector.compact();
+    ASSERT_EQ( (U32)VectorBlockSize, vector.capacity() ) << "Compaction did not trim the storage.";
+
+    vector.clear();
+    vector.compact();
+    ASSERT_EQ( (U32)0, vector.capacity() ) << "Compaction of an empty vector did not free the storage.";
+
+    // Reserve is exact.
+    vector.reserve( VectorBlockSize * 5 + 1 );
+    ASSERT_EQ( (U32)(VectorBlockSize * 6), vector.capacity() ) << "Reserve did not allocate exactly.";
+
+    // Copies only take what they need.
+    vector.setSize( 2 );
+    Vector<U32> copy( vector );
+    ASSERT_EQ( (U32)VectorBlockSize, copy.capacity() ) << "Copy did not fit its storage.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, InlineVectorTest )
+{
+    InlineVector<VectorTestElement, VECTOR_UNITTEST_INLINE_COUNT> vector;
+    ASSERT_TRUE( vector.isInline() ) << "Vector did not start in inline storage.";
+
+    for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+    {
+        VectorTestElement element;
+        element.mKey = index;
+        element.mValue[0] = element.mValue[1] = element.mValue[2] = F32(index);
+        vector.push_back( element );
+
+        ASSERT_EQ( index < VECTOR_UNITTEST_INLINE_COUNT, vector.isInline() ) << "Vector spilled at the wrong size.";
+    }
+
+    for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+        ASSERT_EQ( index, vector[index].mKey ) << "Element lost while spilling.";
+
+    // Copies keep their own storage.
+    InlineVector<VectorTestElement, VECTOR_UNITTEST_INLINE_COUNT> copy( vector );
+    ASSERT_EQ( vector.size(), copy.size() ) << "Copy has the wrong size.";
+    ASSERT_NE( vector.address(), copy.address() ) << "Copy shares storage.";
+
+    // Compaction moves back into the inline storage.
+    vector.setSize( VECTOR_UNITTEST_INLINE_COUNT );
+    vector.compact();
+    ASSERT_TRUE( vector.isInline() ) << "Compaction did not return to inline storage.";
+    for ( U32 index = 0; index < VECTOR_UNITTEST_INLINE_COUNT; ++index )
+        ASSERT_EQ( index, vector[index].mKey ) << "Element lost while compacting.";
+
+    copy = vector;
+    ASSERT_EQ( (S32)VECTOR_UNITTEST_INLINE_COUNT, copy.size() ) << "Assignment has the wrong size.";
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, InlineVectorLifetimeTest )
+{
+    gVectorTestLiveCount = 0;
+
+    {
+        InlineVector<VectorTestCountedElement, VECTOR_UNITTEST_INLINE_COUNT> vector;
+        ASSERT_EQ( (dsize_t)0, (dsize_t)vector.address() % sizeof(F64) ) << "Inline storage is misaligned.";
+
+        VectorTestCountedElement element;
+        for ( U32 index = 0; index < VECTOR_UNITTEST_ELEMENTS; ++index )
+        {
+            element.mValue = F64(index);
+            vector.push_back( element );
+        }
+        ASSERT_EQ( (S32)VECTOR_UNITTEST_ELEMENTS + 1, gVectorTestLiveCount ) << "Push back did not construct.";
+
+        vector.erase( U32(0) );
+        vector.erase_fast( U32(0) );
+        ASSERT_EQ( (S32)VECTOR_UNITTEST_ELEMENTS - 1, gVectorTestLiveCount ) << "Erase did not destruct.";
+        ASSERT_EQ( F64(VECTOR_UNITTEST_ELEMENTS - 1), vector[0].mValue ) << "Erase fast did not move the last element.";
+
+        vector.setSize( VECTOR_UNITTEST_INLINE_COUNT );
+        ASSERT_EQ( (S32)VECTOR_UNITTEST_INLINE_COUNT + 1, gVectorTestLiveCount ) << "Shrinking did not destruct.";
+
+        InlineVector<VectorTestCountedElement, VECTOR_UNITTEST_INLINE_COUNT> copy( vector );
+        copy = vector;
+        ASSERT_EQ( (S32)VECTOR_UNITTEST_INLINE_COUNT * 2 + 1, gVectorTestLiveCount ) << "Assignment leaked elements.";
+
+        copy.clear();
+        ASSERT_EQ( (S32)VECTOR_UNITTEST_INLINE_COUNT + 1, gVectorTestLiveCount ) << "Clear did not destruct.";
+    }
+
+    ASSERT_EQ( 0, gVectorTestLiveCount ) << "Destruction leaked elements.";
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+static U32 runFixedStepPushBack( Vector<VectorTestElement>* pLists )
+{
+    // Reserving one past the capacity each time reproduces the previous fixed block growth.
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 list = 0; list < VECTOR_UNITTEST_BENCHMARK_LISTS; ++list )
+    {
+        Vector<VectorTestElement>& vector = pLists[list];
+        for ( U32 index = 0; index < VECTOR_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        {
+            if ( (U32)vector.size() == vector.capacity() )
+                vector.reserve( vector.capacity() + 1 );
+
+            VectorTestElement element = { index, { 0.0f, 0.0f, 0.0f } };
+            vector.push_back( element );
+        }
+    }
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 runGeometricPushBack( Vector<VectorTestElement>* pLists )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 list = 0; list < VECTOR_UNITTEST_BENCHMARK_LISTS; ++list )
+    {
+        Vector<VectorTestElement>& vector = pLists[list];
+        for ( U32 index = 0; index < VECTOR_UNITTEST_BENCHMARK_ELEMENTS; ++index )
+        {
+            VectorTestElement element = { index, { 0.0f, 0.0f, 0.0f } };
+            vector.push_back( element );
+        }
+    }
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 runIterate( Vector<VectorTestElement>* pLists, U32& checksum )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 pass = 0; pass < VECTOR_UNITTEST_BENCHMARK_PASSES; ++pass )
+    {
+        for ( U32 list = 0; list < VECTOR_UNITTEST_BENCHMARK_LISTS; ++list )
+        {
+            for ( Vector<VectorTestElement>::iterator itr = pLists[list].begin(); itr != pLists[list].end(); ++itr )
+                checksum += itr->mKey;
+        }
+    }
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+static U32 runEraseFast( Vector<VectorTestElement>* pLists )
+{
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 list = 0; list < VECTOR_UNITTEST_BENCHMARK_LISTS; ++list )
+    {
+        Vector<VectorTestElement>& vector = pLists[list];
+        U32 index = 0;
+        while ( vector.size() > 0 )
+        {
+            index = ( index + 7919 ) % vector.size();
+            vector.erase_fast( index );
+        }
+    }
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+template<class VectorType> static U32 runSmallLists( U32& checksum )
+{
+    // Many short-lived lists of a few elements, e.g. per-contact or per-pick results.
+    const U32 startTime = Platform::getRealMilliseconds();
+
+    for ( U32 list = 0; list < VECTOR_UNITTEST_BENCHMARK_ELEMENTS * 4; ++list )
+    {
+        VectorType vector;
+        for ( U32 index = 0; index < (list % VECTOR_UNITTEST_INLINE_COUNT) + 1; ++index )
+        {
+            VectorTestElement element = { index, { 0.0f, 0.0f, 0.0f } };
+            vector.push_back( element );
+        }
+
+        checksum += vector.size();
+    }
+
+    return Platform::getRealMilliseconds() - startTime;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( VectorTests, BenchmarkTest )
+{
+    Vector<VectorTestElement>* pFixedLists = new Vector<VectorTestElement>[VECTOR_UNITTEST_BENCHMARK_LISTS];
+    Vector<VectorTestElement>* pGeometricLists = new Vector<VectorTestElement>[VECTOR_UNITTEST_BENCHMARK_LISTS];
+
+    const U32 fixedPushTime = runFixedStepPushBack( pFixedLists );
+    const U32 geometricPushTime = runGeometricPushBack( pGeometricLists );
+
+    U32 fixedChecksum = 0;
+    U32 geometricChecksum = 0;
+    const U32 fixedIterateTime = runIterate( pFixedLists, fixedChecksum );
+    const U32 geometricIterateTime = runIterate( pGeometricLists, geometricChecksum );
+    ASSERT_EQ( fixedChecksum, geometricChecksum ) << "Vectors hold different elements.";
+
+    const U32 fixedEraseTime = runEraseFast( pFixedLists );
+    const U32 geometricEraseTime = runEraseFast( pGeometricLists );
+
+    U32 heapChecksum = 0;
+    U32 inlineChecksum = 0;
+    const U32 heapSmallTime = runSmallLists< Vector<VectorTestElement> >( heapChecksum );
+    const U32 inlineSmallTime = runSmallLists< InlineVector<VectorTestElement, VECTOR_UNITTEST_INLINE_COUNT> >( inlineChecksum );
+    ASSERT_EQ( heapChecksum, inlineChecksum ) << "Small lists hold different elements.";
+
+    delete [] pFixedLists;
+    delete [] pGeometricLists;
+
+    RecordProperty( "FixedStepPushBackMilliseconds", (S32)fixedPushTime );
+    RecordProperty( "GeometricPushBackMilliseconds", (S32)geometricPushTime );
+    RecordProperty( "FixedStepIterateMilliseconds", (S32)fixedIterateTime );
+    RecordProperty( "GeometricIterateMilliseconds", (S32)geometricIterateTime );
+    RecordProperty( "FixedStepEraseFastMilliseconds", (S32)fixedEraseTime );
+    RecordProperty( "GeometricEraseFastMilliseconds", (S32)geometricEraseTime );
+    RecordProperty( "HeapSmallListMilliseconds", (S32)heapSmallTime );
+    RecordProperty( "InlineSmallListMilliseconds", (S32)inlineSmallTime );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2013 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+// We don't want tests in a shipping version.
+#ifndef TORQUE_SHIPPING
+
+#ifndef _UNIT_TESTING_H_
+#include "testing/unitTesting.h"
+#endif
+
+#ifndef _PLATFORM_H_
+#include "platform/platform.h"
+#endif
+
+#ifndef _ZIPARCHIVE_H_
+#include "io/zip/zipArchive.h"
+#endif
+
+#ifndef _MEMSTREAM_H_
+#include "io/memstream.h"
+#endif
+
+#ifndef _CONSOLE_H_
+#include "console/console.h"
+#endif
+
+#include "algorithm/crc.h"
+#include "zlib.h"
+
+//-----------------------------------------------------------------------------
+
+#define ZIPARCHIVE_UNITTEST_FILES           20000
+#define ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE   1024
+#define ZIPARCHIVE_UNITTEST_BUFFER_SIZE     ( 32 * 1024 * 1024 )
+
+//-----------------------------------------------------------------------------
+
+static U32 fillTestFile( U8* pBuffer, const U32 index )
+{
+    // Text-like content so that deflate has something to work with.
+    const U32 size = 64 + ( index * 37 ) % ( ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE - 64 );
+    for ( U32 offset = 0; offset < size; ++offset )
+        pBuffer[offset] = (U8)( 'a' + ( ( offset / 7 + index ) % 26 ) );
+
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+
+static void setTestHeader( Zip::FileHeader& header, const char* pPath, const U16 method, const U8* pData, const U32 size, const U32 compressedSize )
+{
+    header.mExtractVer = 20;
+    header.mFlags = 0;
+    header.mCompressMethod = method;
+    header.mModTime = 0;
+    header.mModDate = 0;
+    header.mCRC32 = calculateCRC( pData, size ) ^ CRC_POSTCOND_VALUE;
+    header.mCompressedSize = compressedSize;
+    header.mUncompressedSize = size;
+    header.setFilename( pPath );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Writes a zip of the given paths, alternating stored and deflated files.
+static U32 writeTestArchive( U8* pArchive, const U32 archiveSize, const char** pPaths, const U32 pathCount )
+{
+    MemStream stream( archiveSize, pArchive, true, true );
+
+    U8 data[ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE];
+    U8 compressed[ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE * 2];
+
+    Vector<Zip::CentralDir*> directory;
+    for ( U32 index = 0; index < pathCount; ++index )
+    {
+        const U32 size = fillTestFile( data, index );
+
+        U16 method = Zip::Stored;
+        const U8* pStoredData = data;
+        U32 storedSize = size;
+
+        if ( index % 2 )
+        {
+            z_stream_s zipStream;
+            dMemset( &zipStream, 0, sizeof(zipStream) );
+            deflateInit2( &zipStream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY );
+            zipStream.next_in = data;
+            zipStream.avail_in = size;
+            zipStream.next_out = compressed;
+            zipStream.avail_out = sizeof(compressed);
+            deflate( &zipStream, Z_FINISH );
+            deflateEnd( &zipStream );
+
+            method = Zip::Deflated;
+            pStoredData = compressed;
+            storedSize = zipStream.total_out;
+        }
+
+        Zip::CentralDir* pCD = new Zip::CentralDir;
+        setTestHeader( *pCD, pPaths[index], method, data, size, storedSize );
+        pCD->mLocalHeadOffset = stream.getPosition();
+        directory.push_back( pCD );
+
+        Zip::FileHeader localHeader;
+        setTestHeader( localHeader, pPaths[index], method, data, size, storedSize );
+        localHeader.write( &stream );
+        stream.write( storedSize, pStoredData );
+    }
+
+    Zip::EndOfCentralDir eocd;
+    eocd.mCDOffset = stream.getPosition();
+    eocd.mNumEntriesInThisCD = directory.size();
+    eocd.mTotalEntriesInCD = directory.size();
+    eocd.mDiskNum = 0;
+    eocd.mStartCDDiskNum = 0;
+
+    for ( S32 index = 0; index < directory.size(); ++index )
+    {
+        directory[index]->write( &stream );
+        delete directory[index];
+    }
+
+    eocd.mCDSize = stream.getPosition() - eocd.mCDOffset;
+    eocd.write( &stream );
+
+    return stream.getPosition();
+}
+
+//-----------------------------------------------------------------------------
+
+static bool readTestFile( Zip::ZipArchive& archive, const char* pPath, const U32 index )
+{
+    U8 expected[ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE];
+    U8 actual[ZIPARCHIVE_UNITTEST_MAX_FILE_SIZE];
+    const U32 size = fillTestFile( expected, index );
+
+    Stream* pStream = archive.openFile( pPath );
+    if ( pStream == NULL )
+        return false;
+
+    const bool result = pStream->getStreamSize() == size && pStream->read( size, actual ) && dMemcmp( expected, actual, size ) == 0;
+    archive.closeFile( pStream );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ZipArchiveTests, PathIndexTest )
+{
+    const char* paths[] = { "top.txt", "dir/sub/stored.txt", "dir\\sub\\deflated.txt", "dir/other.txt" };
+    const U32 pathCount = sizeof(paths) / sizeof(paths[0]);
+
+    const U32 bufferSize = 64 * 1024;
+    U8* pBuffer = new U8[bufferSize];
+    const U32 archiveSize = writeTestArchive( pBuffer, bufferSize, paths, pathCount );
+
+    const char* pMaxImageSize = Con::getVariable( "$Pref::Zip::MaxImageSize" );
+    char maxImageSize[32];
+    dStrncpy( maxImageSize, pMaxImageSize, sizeof(maxImageSize) );
+    maxImageSize[sizeof(maxImageSize) - 1] = 0;
+
+    // Check both resident and streamed archives.
+    for ( U32 pass = 0; pass < 2; ++pass )
+    {
+        Con::setIntVariable( "$Pref::Zip::MaxImageSize", pass ? 0 : bufferSize );
+
+        MemStream stream( archiveSize, pBuffer, true, false );
+        Zip::ZipArchive archive;
+        ASSERT_TRUE( archive.openArchive( &stream, Zip::ZipArchive::Read ) ) << "Could not open the archive.";
+        ASSERT_EQ( pass == 0, archive.isResident() );
+        ASSERT_EQ( pathCount, archive.numEntries() );
+
+        // Either separator finds the file, and directories are indexed too.
+        ASSERT_TRUE( archive.findFileInfo( "dir/sub/deflated.txt" ) != NULL );
+        ASSERT_TRUE( archive.findFileInfo( "dir\\sub\\stored.txt" ) != NULL );
+        ASSERT_TRUE( archive.findFileInfo( "dir/sub" ) != NULL );
+        ASSERT_TRUE( archive.findFileInfo( "dir" ) != NULL );
+        ASSERT_TRUE( archive.findFileInfo( "stored.txt" ) == NULL );
+        ASSERT_TRUE( archive.findFileInfo( "dir/sub/stored" ) == NULL );
+        ASSERT_TRUE( archive.findFileInfo( "dir/sub/stored.txt/" ) == NULL );
+
+        for ( U32 index = 0; index < pathCount; ++index )
+            ASSERT_TRUE( readTestFile( archive, paths[index], index ) ) << "Could not read " << paths[index];
+
+        archive.closeArchive();
+    }
+
+    Con::setVariable( "$Pref::Zip::MaxImageSize", maxImageSize );
+    delete [] pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+TEST( ZipArchiveTests, ResidentDefaultTest )
+{
+    const char* paths[] = { "default.txt" };
+
+    const U32 bufferSize = 16 * 1024;
+    U8* pBuffer = new U8[bufferSize];
+    const U32 archiveSize = writeTestArchive( pBuffer, bufferSize, paths, 1 );
+
+    const char* pMaxImageSize = Con::getVariable( "$Pref::Zip::MaxImageSize" );
+    char maxImageSize[32];
+    dStrncpy( maxImageSize, pMaxImageSize, sizeof(maxImageSize) );
+    maxImageSize[sizeof(maxImageSize) - 1] = 0;
+
+    // Without the preference even a tiny archive stays on disk.
+    Con::setVariable( "$Pref::Zip::MaxImageSize", "" );
+
+    MemStream stream( archiveSize, pBuffer, true, false );
+    Zip::ZipArchive archive;
+    ASSERT_TRUE( archive.openArchive( &stream, Zip::ZipArchive::Read ) ) << "Could not open the archive.";
+    ASSERT_FALSE( archive.isResident() ) << "Archive was kept in memory without opting in.";
+    ASSERT_TRUE( readTestFile( archive, paths[0], 0 ) ) << "Could not read " << paths[0];
+    archive.closeArchive();
+
+    Con::setVariable( "$Pref::Zip::MaxImageSize", maxImageSize );
+    delete [] pBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_BENCHMARK_TESTS
+
+//-----------------------------------------------------------------------------
+
+TEST( ZipArchiveTests, BenchmarkTest )
+{
+    char* pPathBuffer = new char[ZIPARCHIVE_UNITTEST_FILES * 48];
+    const char** pPaths = new const char*[ZIPARCHIVE_UNITTEST_FILES];
+    for ( U32 index = 0; index < ZIPARCHIVE_UNITTEST_FILES; ++index )
+    {
+        char* pPath = pPathBuffer + index * 48;
+        dSprintf( pPath, 48, "assets/group%d/set%d/file%d.dat", index % 16, index % 64, index );
+        pPaths[index] = pPath;
+    }
+
+    U8* pBuffer = new U8[ZIPARCHIVE_UNITTEST_BUFFER_SIZE];
+    const U32 archiveSize = writeTestArchive( pBuffer, ZIPARCHIVE_UNITTEST_BUFFER_SIZE, pPaths, ZIPARCHIVE_UNITTEST_FILES );
+
+    const char* pMaxImageSize = Con::getVariable( "$Pref::Zip::MaxImageSize" );
+    char maxImageSize[32];
+    dStrncpy( maxImageSize, pMaxImageSize, sizeof(maxImageSize) );
+    maxImageSize[sizeof(maxImageSize) - 1] = 0;
+
+    U32 openTime[2];
+    U32 lookupTime[2];
+    U32 readTime[2];
+    U32 failures = 0;
+
+    for ( U32 pass = 0; pass < 2; ++pass )
+    {
+        Con::setIntVariable( "$Pref::Zip::MaxImageSize", pass ? 0 : ZIPARCHIVE_UNITTEST_BUFFER_SIZE );
+
+        MemStream stream( archiveSize, pBuffer, true, false );
+        Zip::ZipArchive archive;
+
+        U32 startTime = Platform::getRealMilliseconds();
+        const bool opened = archive.openArchive( &stream, Zip::ZipArchive::Read );
+        openTime[pass] = Platform::getRealMilliseconds() - startTime;
+
+        ASSERT_TRUE( opened ) << "Could not open the archive.";
+        ASSERT_EQ( (U32)ZIPARCHIVE_UNITTEST_FILES, archive.numEntries() );
+
+        startTime = Platform::getRealMilliseconds();
+        for ( U32 index = 0; index < ZIPARCHIVE_UNITTEST_FILES; ++index )
+        {
+            if ( archive.findFileInfo( pPaths[index] ) == NULL )
+                ++failures;
+        }
+        lookupTime[pass] = Platform::getRealMilliseconds() - startTime;
+
+        startTime = Platform::getRealMilliseconds();
+        for ( U32 index = 0; index < ZIPARCHIVE_UNITTEST_FILES; ++index )
+        {
+            if ( !readTestFile( archive, pPaths[index], index ) )
+                ++failures;
+        }
+        readTime[pass] = Platform::getRealMilliseconds() - startTime;
+
+        archive.closeArchive();
+    }
+
+    Con::setVariable( "$Pref::Zip::MaxImageSize", maxImageSize );
+
+    delete [] pBuffer;
+    delete [] pPaths;
+    delete [] pPathBuffer;
+
+    ASSERT_EQ( 0u, failures ) << "Files were missing or did not match.";
+
+    RecordProperty( "ArchiveBytes", (S32)archiveSize );
+    RecordProperty( "ResidentOpenMilliseconds", (S32)openTime[0] );
+    RecordProperty( "ResidentLookupMilliseconds", (S32)lookupTime[0] );
+    RecordProperty( "ResidentReadMilliseconds", (S32)readTime[0] );
+    RecordProperty( "StreamedOpenMilliseconds", (S32)openTime[1] );
+    RecordProperty( "StreamedLookupMilliseconds", (S32)lookupTime[1] );
+    RecordProperty( "StreamedReadMilliseconds", (S32)readTime[1] );
+}
+
+#endif // TORQUE_BENCHMARK_TESTS
+
+#endif // TORQUE_SHIPPING
@@ -83,6 +83,19 @@
 /// 'TORQUE_GATHER_METRICS'
 /// When defined, Torque will gather additional performance metrics.
 ///
+/// 'TORQUE_TRACK_MEMORY'
+/// When defined, Torque will count the live memory allocated by each call site and
+/// subsystem.  Use the dumpMemoryReport() console function to see the results.
+///
+/// 'TORQUE_POOLED_ALLOCATOR'
+/// When defined, Torque will serve small allocations, including the global new operator,
+/// from thread-caching size-class pools instead of the system allocator.
+///
+/// 'TORQUE_BENCHMARK_TESTS'
+/// When defined, the unit tests also include the timed benchmarks.  These are slow and
+/// record their timings as test properties rather than printing them, so they are left
+/// out of the default test run.
+///
 /// 'TORQUE_MULTITHREAD'
 /// When defined, Torque will attempt to make select systems thread-safe.  This does not
 /// make the entire engine thread-safe nor is it a magic bullet that will make the engine